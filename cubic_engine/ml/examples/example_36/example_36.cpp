@@ -0,0 +1,127 @@
+/**
+ * Benchmark the KNN search index. For several data set sizes N and
+ * dimensions d the k nearest neighbors of a number of query points are
+ * computed by scanning all the points (brute force), with a KD-tree
+ * and with a ball tree. The trees should be much faster for low d and
+ * approach the brute force cost as d grows.
+ */
+
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "cubic_engine/ml/instance_learning/knn_control.h"
+#include "cubic_engine/ml/instance_learning/details/knn_spatial_index.h"
+#include "cubic_engine/ml/instance_learning/details/knn_top_k.h"
+#include "kernel/maths/lp_metric.h"
+
+#include <chrono>
+#include <random>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+
+namespace  {
+
+using cengine::uint_t;
+using cengine::real_t;
+using cengine::DynMat;
+using cengine::DynVec;
+using cengine::ml::KnnIndexType;
+using cengine::ml::details::KnnSpatialIndex;
+using cengine::ml::details::KnnTopK;
+
+typedef kernel::LpMetric<2> similarity_t;
+
+const uint_t K = 5;
+const uint_t N_QUERIES = 200;
+const std::vector<uint_t> N_POINTS = {1000, 10000, 100000};
+const std::vector<uint_t> DIMENSIONS = {2, 4, 8, 16, 32};
+
+DynMat<real_t> random_points(uint_t n, uint_t d, std::mt19937& generator){
+
+    std::uniform_real_distribution<real_t> distribution(0.0, 1.0);
+
+    DynMat<real_t> points(n, d);
+    for(uint_t r=0; r<n; ++r){
+        for(uint_t c=0; c<d; ++c){
+            points(r, c) = distribution(generator);
+        }
+    }
+
+    return points;
+}
+
+/// \brief Build the index of the given type and return
+/// the time in ms per query and the sum of the found distances
+std::pair<real_t, real_t>
+measure(const DynMat<real_t>& points, const std::vector<DynVec<real_t>>& queries, KnnIndexType type){
+
+    KnnSpatialIndex<similarity_t> index;
+    index.build(points, type);
+
+    KnnTopK top_k(K);
+    real_t checksum = 0.0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for(const auto& query : queries){
+
+        top_k.clear();
+        index.query(query, top_k);
+
+        for(const auto& pair : top_k.sort()){
+            checksum += pair.second;
+        }
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<real_t, std::milli> dur = end - start;
+    return {dur.count()/queries.size(), checksum};
+}
+
+}
+
+int main(){
+
+    std::mt19937 generator(42);
+
+    std::cout<<std::setw(10)<<"N"
+             <<std::setw(6)<<"d"
+             <<std::setw(16)<<"brute (ms)"
+             <<std::setw(16)<<"kd-tree (ms)"
+             <<std::setw(16)<<"ball-tree (ms)"
+             <<std::setw(12)<<"kd speedup"
+             <<std::setw(14)<<"ball speedup"<<std::endl;
+
+    for(auto n : N_POINTS){
+        for(auto d : DIMENSIONS){
+
+            auto points = random_points(n, d, generator);
+            auto query_matrix = random_points(N_QUERIES, d, generator);
+
+            std::vector<DynVec<real_t>> queries(N_QUERIES, DynVec<real_t>(d));
+            for(uint_t q=0; q<N_QUERIES; ++q){
+                for(uint_t c=0; c<d; ++c){
+                    queries[q][c] = query_matrix(q, c);
+                }
+            }
+
+            auto brute = measure(points, queries, KnnIndexType::BRUTE_FORCE);
+            auto kd = measure(points, queries, KnnIndexType::KD_TREE);
+            auto ball = measure(points, queries, KnnIndexType::BALL_TREE);
+
+            // all the searches are exact so the distances must agree
+            if(brute.second != kd.second || brute.second != ball.second){
+                std::cout<<"The search index and the brute force search do not agree"<<std::endl;
+            }
+
+            std::cout<<std::setw(10)<<n
+                     <<std::setw(6)<<d
+                     <<std::setw(16)<<brute.first
+                     <<std::setw(16)<<kd.first
+                     <<std::setw(16)<<ball.first
+                     <<std::setw(12)<<brute.first/kd.first
+                     <<std::setw(14)<<brute.first/ball.first<<std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+/**
+ * Benchmark the blocked KNN search. The k nearest neighbors of a batch of
+ * query points are computed by scanning the data set for every point and
+ * with KnnBlockedSearch that computes the distances of blocks of queries
+ * and blocks of points as a matrix product. Both return the same neighbors.
+ */
+
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "cubic_engine/ml/instance_learning/knn_control.h"
+#include "cubic_engine/ml/instance_learning/details/knn_spatial_index.h"
+#include "cubic_engine/ml/instance_learning/details/knn_blocked_search.h"
+#include "cubic_engine/ml/instance_learning/details/knn_top_k.h"
+#include "kernel/maths/lp_metric.h"
+
+#include <chrono>
+#include <random>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+
+namespace  {
+
+using cengine::uint_t;
+using cengine::real_t;
+using cengine::DynMat;
+using cengine::DynVec;
+using cengine::ml::KnnIndexType;
+using cengine::ml::details::KnnSpatialIndex;
+using cengine::ml::details::KnnBlockedSearch;
+using cengine::ml::details::KnnTopK;
+
+typedef kernel::LpMetric<2> similarity_t;
+typedef std::pair<uint_t, real_t> Pair;
+
+const uint_t K = 5;
+const uint_t N_POINTS = 20000;
+const uint_t N_QUERIES = 10000;
+const std::vector<uint_t> DIMENSIONS = {8, 32, 128};
+
+DynMat<real_t> random_points(uint_t n, uint_t d, std::mt19937& generator){
+
+    std::uniform_real_distribution<real_t> distribution(0.0, 1.0);
+
+    DynMat<real_t> points(n, d);
+    for(uint_t r=0; r<n; ++r){
+        for(uint_t c=0; c<d; ++c){
+            points(r, c) = distribution(generator);
+        }
+    }
+
+    return points;
+}
+
+}
+
+int main(){
+
+    std::mt19937 generator(42);
+
+    std::cout<<std::setw(6)<<"d"
+             <<std::setw(16)<<"scan (s)"
+             <<std::setw(16)<<"blocked (s)"
+             <<std::setw(12)<<"speed up"<<std::endl;
+
+    for(auto d : DIMENSIONS){
+
+        auto points = random_points(N_POINTS, d, generator);
+        auto queries = random_points(N_QUERIES, d, generator);
+
+        std::vector<std::vector<Pair>> scan_neighbors(N_QUERIES);
+        std::vector<std::vector<Pair>> blocked_neighbors(N_QUERIES);
+
+        KnnSpatialIndex<similarity_t> scan;
+        scan.build(points, KnnIndexType::BRUTE_FORCE);
+
+        auto start = std::chrono::steady_clock::now();
+
+        for(uint_t q=0; q<N_QUERIES; ++q){
+
+            DynVec<real_t> point(d);
+            for(uint_t c=0; c<d; ++c){
+                point[c] = queries(q, c);
+            }
+
+            scan.query(point, K, scan_neighbors[q]);
+        }
+
+        auto end = std::chrono::steady_clock::now();
+        std::chrono::duration<real_t> scan_time = end - start;
+
+        KnnBlockedSearch<similarity_t> blocked;
+        blocked.build(points);
+
+        start = std::chrono::steady_clock::now();
+
+        blocked.query(queries, kernel::range1d<uint_t>(0, N_QUERIES), K,
+                      [&blocked_neighbors](uint_t q, std::vector<Pair>& neighbors){
+            blocked_neighbors[q] = std::move(neighbors);
+        });
+
+        end = std::chrono::steady_clock::now();
+        std::chrono::duration<real_t> blocked_time = end - start;
+
+        if(scan_neighbors != blocked_neighbors){
+            std::cout<<"The blocked search and the scan do not agree"<<std::endl;
+        }
+
+        std::cout<<std::setw(6)<<d
+                 <<std::setw(16)<<scan_time.count()
+                 <<std::setw(16)<<blocked_time.count()
+                 <<std::setw(12)<<scan_time.count()/blocked_time.count()<<std::endl;
+    }
+
+    return 0;
+}
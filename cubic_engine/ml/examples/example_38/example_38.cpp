@@ -0,0 +1,139 @@
+/**
+ * Benchmark ThreadedKMeans against the serial KMeans. The k-means test
+ * data set is replicated with a small jitter to get a larger data set which
+ * is clustered with the serial KMeans, with ThreadedKMeans with and without
+ * the distance bounds and with mini-batch k-means.
+ */
+
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "cubic_engine/ml/unsupervised_learning/serial_kmeans.h"
+#include "cubic_engine/ml/unsupervised_learning/threaded_kmeans.h"
+#include "cubic_engine/ml/unsupervised_learning/utils/kmeans_control.h"
+#include "cubic_engine/ml/unsupervised_learning/utils/cluster.h"
+#include "cubic_engine/ml/datasets/data_set_loaders.h"
+#include "kernel/parallel/threading/thread_pool.h"
+#include "kernel/data_structs/data_set_wrapper.hpp"
+#include "kernel/maths/lp_metric.h"
+
+#include <chrono>
+#include <random>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <iomanip>
+
+namespace  {
+
+using cengine::uint_t;
+using cengine::real_t;
+using cengine::DynMat;
+using cengine::DynVec;
+using cengine::Null;
+using cengine::Cluster;
+using cengine::KMeansConfig;
+using cengine::KMeansInfo;
+using cengine::ml::KMeans;
+using cengine::ml::ThreadedKMeans;
+
+typedef DynVec<real_t> point_t;
+typedef kernel::data_structs::DataSetWrapper<DynMat<real_t>> dataset_t;
+typedef kernel::LpMetric<2> similarity_t;
+
+const uint_t K = 8;
+const uint_t N_COPIES = 200;
+const uint_t N_THREADS = 4;
+const uint_t MAX_ITRS = 100;
+const uint_t BATCH_SIZE = 1024;
+
+void replicate(const DynMat<real_t>& data, dataset_t& dataset){
+
+    std::mt19937 generator(42);
+    std::normal_distribution<real_t> jitter(0.0, 0.1);
+
+    DynMat<real_t> result(data.rows()*N_COPIES, data.columns());
+
+    for(uint_t copy=0; copy<N_COPIES; ++copy){
+        for(uint_t r=0; r<data.rows(); ++r){
+            for(uint_t c=0; c<data.columns(); ++c){
+                result(copy*data.rows() + r, c) = data(r, c) + jitter(generator);
+            }
+        }
+    }
+
+    dataset.load_from(result);
+}
+
+/// \brief All the runs start from the same centroids
+void init(const dataset_t& data, uint_t k, std::vector<point_t>& centroids){
+
+    const uint_t stride = data.n_rows()/k;
+    for(uint_t c=0; c<k; ++c){
+        centroids.push_back(data.get_row(c*stride));
+    }
+}
+
+void print(const std::string& name, const KMeansInfo& info, uint_t n_distances){
+
+    std::cout<<std::setw(24)<<name
+             <<std::setw(14)<<info.runtime.count()
+             <<std::setw(12)<<info.niterations
+             <<std::setw(18)<<n_distances<<std::endl;
+}
+
+}
+
+int main(){
+
+    try{
+
+        dataset_t dataset;
+        replicate(cengine::ml::load_kmeans_test_data(), dataset);
+
+        std::cout<<"Number of points: "<<dataset.n_rows()<<std::endl;
+        std::cout<<std::setw(24)<<"algorithm"
+                 <<std::setw(14)<<"time (s)"
+                 <<std::setw(12)<<"iterations"
+                 <<std::setw(18)<<"distances"<<std::endl;
+
+        KMeansConfig control(K, MAX_ITRS);
+
+        {
+            KMeans<Cluster<point_t>> kmeans(control);
+            auto info = kmeans.cluster(dataset, similarity_t(), init);
+            print("serial", info, info.niterations*K*dataset.n_rows());
+        }
+
+        kernel::ThreadPool pool(N_THREADS);
+
+        {
+            control.use_distance_bounds = false;
+            ThreadedKMeans<Cluster<point_t>> kmeans(control);
+            auto info = kmeans.cluster(dataset, similarity_t(), init, pool, Null());
+            print("threaded", info, kmeans.n_distance_computations());
+        }
+
+        {
+            control.use_distance_bounds = true;
+            ThreadedKMeans<Cluster<point_t>> kmeans(control);
+            auto info = kmeans.cluster(dataset, similarity_t(), init, pool, Null());
+            print("threaded with bounds", info, kmeans.n_distance_computations());
+        }
+
+        {
+            control.batch_size = BATCH_SIZE;
+            ThreadedKMeans<Cluster<point_t>> kmeans(control);
+            auto info = kmeans.cluster(dataset, similarity_t(), init, pool, Null());
+            print("mini-batch", info, kmeans.n_distance_computations());
+        }
+    }
+    catch(std::exception& e){
+
+        std::cerr<<e.what()<<std::endl;
+    }
+    catch(...){
+
+        std::cerr<<"Unknown exception occured"<<std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,123 @@
+/**
+ * Binary memory-mapped datasets. A CSV dataset is written and converted
+ * to the binary columnar format. The time to load the dataset by parsing
+ * the CSV file into a BlazeRegressionDataset is compared with the time
+ * to open the binary file as a MappedRegressionDataset. The SSE of a
+ * linear model over both datasets is computed to show that the mapped
+ * dataset can be used where a BlazeRegressionDataset is used.
+ */
+
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "cubic_engine/ml/datasets/blaze_regression_dataset.h"
+#include "cubic_engine/ml/datasets/mapped_regression_dataset.h"
+#include "cubic_engine/ml/datasets/columnar_dataset_format.h"
+#include "kernel/utilities/csv_data_reader.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <iostream>
+#include <iomanip>
+
+namespace  {
+
+using cengine::uint_t;
+using cengine::real_t;
+using cengine::DynVec;
+using cengine::ml::BlazeRegressionDataset;
+using cengine::ml::MappedRegressionDataset;
+
+const std::string CSV_FILE = "example_39.csv";
+const std::string BINARY_FILE = "example_39.bin";
+const uint_t N_ROWS = 200000;
+const uint_t N_FEATURES = 20;
+
+void write_csv(){
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<real_t> distribution(-1.0, 1.0);
+
+    std::ofstream file(CSV_FILE);
+    file<<std::setprecision(10);
+
+    for(uint_t c=0; c<N_FEATURES; ++c){
+        file<<"x"<<c<<",";
+    }
+
+    file<<"y\n";
+
+    for(uint_t r=0; r<N_ROWS; ++r){
+
+        real_t y = 0.0;
+        for(uint_t c=0; c<N_FEATURES; ++c){
+            const real_t x = distribution(generator);
+            y += (c + 1)*x;
+            file<<x<<",";
+        }
+
+        file<<y<<"\n";
+    }
+}
+
+template<typename DatasetTp>
+real_t sse(const DatasetTp& dataset){
+
+    real_t result = 0.0;
+
+    dataset.iterate([&result](const auto& row, const auto& label){
+
+        real_t value = 0.0;
+        for(uint_t c=0; c<row.size(); ++c){
+            value += (c + 1)*row[c];
+        }
+
+        result += (label - value)*(label - value);
+    });
+
+    return result;
+}
+
+real_t seconds_since(std::chrono::steady_clock::time_point start){
+    return std::chrono::duration<real_t>(std::chrono::steady_clock::now() - start).count();
+}
+
+}
+
+int main(){
+
+    try{
+
+        write_csv();
+        cengine::ml::convert_csv_to_columnar(CSV_FILE, BINARY_FILE);
+
+        auto start = std::chrono::steady_clock::now();
+        BlazeRegressionDataset csv_dataset;
+        kernel::CSVDataReader reader(CSV_FILE);
+        csv_dataset.load_from_file(reader);
+        const real_t csv_time = seconds_since(start);
+
+        start = std::chrono::steady_clock::now();
+        MappedRegressionDataset mapped_dataset(BINARY_FILE);
+        const real_t mapped_time = seconds_since(start);
+
+        std::cout<<"Rows: "<<mapped_dataset.n_examples()<<" features: "<<mapped_dataset.n_features()<<std::endl;
+        std::cout<<std::setw(12)<<"dataset"<<std::setw(14)<<"load (s)"<<std::setw(14)<<"SSE"<<std::endl;
+        std::cout<<std::setw(12)<<"CSV"<<std::setw(14)<<csv_time<<std::setw(14)<<sse(csv_dataset)<<std::endl;
+        std::cout<<std::setw(12)<<"mapped"<<std::setw(14)<<mapped_time<<std::setw(14)<<sse(mapped_dataset)<<std::endl;
+
+        std::remove(CSV_FILE.c_str());
+        std::remove(BINARY_FILE.c_str());
+    }
+    catch(std::exception& e){
+
+        std::cerr<<e.what()<<std::endl;
+    }
+    catch(...){
+
+        std::cerr<<"Unknown exception occured"<<std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,139 @@
+/**
+ * Out-of-core streaming datasets. A binary dataset is written and a
+ * linear model is fitted with a stochastic gradient descent loop over
+ * n_examples() rows. The loop is run on a MappedRegressionDataset and on
+ * a StreamingRegressionDataset that holds only two chunks of rows in
+ * memory, reads the next chunk in the background and shuffles the chunk
+ * order in every epoch. The time per epoch and the final SSE are printed.
+ */
+
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "cubic_engine/ml/datasets/mapped_regression_dataset.h"
+#include "cubic_engine/ml/datasets/streaming_regression_dataset.h"
+#include "cubic_engine/ml/datasets/columnar_dataset_format.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <iostream>
+#include <iomanip>
+
+namespace  {
+
+using cengine::uint_t;
+using cengine::real_t;
+using cengine::DynMat;
+using cengine::DynVec;
+using cengine::ml::MappedRegressionDataset;
+using cengine::ml::StreamingRegressionDataset;
+using cengine::ml::StreamingDatasetConfig;
+
+const std::string BINARY_FILE = "example_40.bin";
+const uint_t N_ROWS = 400000;
+const uint_t N_FEATURES = 20;
+const uint_t N_EPOCHS = 3;
+const real_t LEARNING_RATE = 0.005;
+
+void write_dataset(){
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<real_t> distribution(-1.0, 1.0);
+
+    DynMat<real_t> features(N_ROWS, N_FEATURES);
+    DynVec<real_t> labels(N_ROWS);
+
+    for(uint_t r=0; r<N_ROWS; ++r){
+
+        labels[r] = 0.0;
+        for(uint_t c=0; c<N_FEATURES; ++c){
+            features(r, c) = distribution(generator);
+            labels[r] += (c + 1)*features(r, c);
+        }
+    }
+
+    cengine::ml::write_columnar_dataset(BINARY_FILE, features, labels, {});
+}
+
+template<typename DatasetTp>
+real_t fit(const DatasetTp& dataset){
+
+    DynVec<real_t> weights(dataset.n_features(), 0.0);
+
+    for(uint_t epoch=0; epoch<N_EPOCHS; ++epoch){
+        for(uint_t i=0; i<dataset.n_examples(); ++i){
+
+            auto [row, label] = dataset[i];
+
+            real_t error = -label;
+            for(uint_t c=0; c<row.size(); ++c){
+                error += weights[c]*row[c];
+            }
+
+            for(uint_t c=0; c<row.size(); ++c){
+                weights[c] -= LEARNING_RATE*error*row[c];
+            }
+        }
+    }
+
+    real_t sse = 0.0;
+    dataset.iterate([&sse, &weights](const auto& row, const auto& label){
+
+        real_t error = -label;
+        for(uint_t c=0; c<row.size(); ++c){
+            error += weights[c]*row[c];
+        }
+
+        sse += error*error;
+    });
+
+    return sse;
+}
+
+real_t seconds_since(std::chrono::steady_clock::time_point start){
+    return std::chrono::duration<real_t>(std::chrono::steady_clock::now() - start).count();
+}
+
+}
+
+int main(){
+
+    try{
+
+        write_dataset();
+
+        auto start = std::chrono::steady_clock::now();
+        MappedRegressionDataset mapped_dataset(BINARY_FILE);
+        const real_t mapped_sse = fit(mapped_dataset);
+        const real_t mapped_time = seconds_since(start)/N_EPOCHS;
+
+        StreamingDatasetConfig config;
+        config.chunk_rows = 8192;
+        config.shuffle_chunks = true;
+
+        start = std::chrono::steady_clock::now();
+        StreamingRegressionDataset streaming_dataset(BINARY_FILE, config);
+        const real_t streaming_sse = fit(streaming_dataset);
+        const real_t streaming_time = seconds_since(start)/N_EPOCHS;
+
+        std::cout<<"Rows: "<<streaming_dataset.n_examples()<<" features: "<<streaming_dataset.n_features()
+                 <<" chunks: "<<streaming_dataset.n_chunks()<<std::endl;
+        std::cout<<"Chunks read: "<<streaming_dataset.n_chunk_reads()
+                 <<" epochs reshuffled: "<<streaming_dataset.epoch()<<std::endl;
+        std::cout<<std::setw(12)<<"dataset"<<std::setw(14)<<"epoch (s)"<<std::setw(14)<<"SSE"<<std::endl;
+        std::cout<<std::setw(12)<<"mapped"<<std::setw(14)<<mapped_time<<std::setw(14)<<mapped_sse<<std::endl;
+        std::cout<<std::setw(12)<<"streaming"<<std::setw(14)<<streaming_time<<std::setw(14)<<streaming_sse<<std::endl;
+
+        std::remove(BINARY_FILE.c_str());
+    }
+    catch(std::exception& e){
+
+        std::cerr<<e.what()<<std::endl;
+    }
+    catch(...){
+
+        std::cerr<<"Unknown exception occured"<<std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,189 @@
+/**
+ * Allocation-free row access. The global operator new is replaced by one
+ * that counts the heap allocations. An epoch of the loops that visit every
+ * row of a BlazeRegressionDataset (an SSELoss evaluation, a pass of
+ * iterate() with the model value and a KNN distance scan) is run twice:
+ * once copying every row with matrix_row_trait::get_row as the datasets
+ * did before and once with the row views returned by operator[]. The
+ * allocations and the time per epoch are printed.
+ */
+
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "cubic_engine/ml/datasets/blaze_regression_dataset.h"
+#include "cubic_engine/ml/loss_functions/sse_loss.h"
+#include "kernel/maths/functions/real_vector_polynomial.h"
+#include "kernel/maths/matrix_traits.h"
+#include "kernel/maths/lp_metric.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <iostream>
+#include <iomanip>
+
+namespace{
+
+std::atomic<std::size_t> n_allocations{0};
+
+}
+
+void* operator new(std::size_t size){
+
+    n_allocations.fetch_add(1, std::memory_order_relaxed);
+
+    if(void* ptr = std::malloc(size == 0 ? 1 : size)){
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr)noexcept{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t)noexcept{
+    std::free(ptr);
+}
+
+namespace  {
+
+using cengine::uint_t;
+using cengine::real_t;
+using cengine::DynMat;
+using cengine::DynVec;
+using cengine::ml::BlazeRegressionDataset;
+using cengine::ml::SSELoss;
+using kernel::PolynomialFunction;
+
+const uint_t N_ROWS = 200000;
+const uint_t N_FEATURES = 16;
+
+struct Measurement
+{
+    std::size_t allocations;
+    real_t seconds;
+    real_t value;
+};
+
+template<typename EpochTp>
+Measurement measure(const EpochTp& epoch){
+
+    const auto allocations = n_allocations.load();
+    const auto start = std::chrono::steady_clock::now();
+    const real_t value = epoch();
+    const auto end = std::chrono::steady_clock::now();
+
+    return {n_allocations.load() - allocations, std::chrono::duration<real_t>(end - start).count(), value};
+}
+
+void print(const std::string& name, const Measurement& copy, const Measurement& view){
+
+    std::cout<<std::setw(12)<<name
+             <<std::setw(14)<<copy.allocations<<std::setw(14)<<copy.seconds
+             <<std::setw(14)<<view.allocations<<std::setw(14)<<view.seconds
+             <<std::setw(16)<<copy.value - view.value<<std::endl;
+}
+
+}
+
+int main(){
+
+    try{
+
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<real_t> distribution(-1.0, 1.0);
+
+        DynMat<real_t> features(N_ROWS, N_FEATURES);
+        DynVec<real_t> labels(N_ROWS);
+
+        for(uint_t r=0; r<N_ROWS; ++r){
+
+            features(r, 0) = 1.0;
+            labels[r] = 0.0;
+
+            for(uint_t c=1; c<N_FEATURES; ++c){
+                features(r, c) = distribution(generator);
+                labels[r] += c*features(r, c);
+            }
+        }
+
+        BlazeRegressionDataset dataset;
+        dataset.load_from_data(features, labels);
+
+        PolynomialFunction model(std::vector<real_t>(N_FEATURES, 0.5));
+        SSELoss<PolynomialFunction, BlazeRegressionDataset> loss(model);
+
+        const auto& matrix = dataset.feature_matrix();
+        const DynVec<real_t> query(N_FEATURES, 0.1);
+        const kernel::LpMetric<2> metric;
+
+        typedef kernel::matrix_row_trait<DynMat<real_t>> trait_t;
+
+        // the SSE with a copy of every row
+        auto sse_copy = measure([&](){
+            real_t result = 0.0;
+            for(uint_t r=0; r<dataset.n_examples(); ++r){
+                const auto row = trait_t::get_row(matrix, r);
+                result += loss.error_at(row, labels[r]);
+            }
+            return result;
+        });
+
+        // SSELoss::evaluate visits the views of the rows
+        auto sse_view = measure([&](){return loss.evaluate(dataset);});
+
+        auto iterate_copy = measure([&](){
+            real_t result = 0.0;
+            for(uint_t r=0; r<dataset.n_examples(); ++r){
+                result += model.value_at(trait_t::get_row(matrix, r));
+            }
+            return result;
+        });
+
+        auto iterate_view = measure([&](){
+            real_t result = 0.0;
+            dataset.iterate([&](const auto& row, const auto&){result += model.value_at(row);});
+            return result;
+        });
+
+        auto knn_copy = measure([&](){
+            real_t result = 0.0;
+            for(uint_t r=0; r<dataset.n_examples(); ++r){
+                result += metric(trait_t::get_row(matrix, r), query);
+            }
+            return result;
+        });
+
+        auto knn_view = measure([&](){
+            real_t result = 0.0;
+            for(uint_t r=0; r<dataset.n_examples(); ++r){
+                auto [row, label] = dataset[r];
+                result += metric(row, query);
+            }
+            return result;
+        });
+
+        std::cout<<"Rows: "<<N_ROWS<<" features: "<<N_FEATURES<<std::endl;
+        std::cout<<std::setw(12)<<"epoch"
+                 <<std::setw(14)<<"copy allocs"<<std::setw(14)<<"copy (s)"
+                 <<std::setw(14)<<"view allocs"<<std::setw(14)<<"view (s)"
+                 <<std::setw(16)<<"difference"<<std::endl;
+
+        print("SSE", sse_copy, sse_view);
+        print("iterate", iterate_copy, iterate_view);
+        print("KNN scan", knn_copy, knn_view);
+    }
+    catch(std::exception& e){
+
+        std::cerr<<e.what()<<std::endl;
+    }
+    catch(...){
+
+        std::cerr<<"Unknown exception occured"<<std::endl;
+    }
+
+    return 0;
+}
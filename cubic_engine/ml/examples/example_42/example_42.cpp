@@ -0,0 +1,130 @@
+/**
+ * Mini-batch gradients. A linear model is fitted on a wide dataset with
+ * SGD. The first run updates the coefficients after every example using
+ * MSELoss::param_gradient_at. The second run sets GDConfig::batch_size so
+ * that SGD calls MSELoss::batch_gradients. The predictions and the gradients
+ * of a mini-batch are then two matrix-vector products. Finally the gradients
+ * of the full dataset are computed serially and with the rows partitioned
+ * among the threads of a ThreadPool. The time per epoch and the MSE of
+ * both fits are printed.
+ */
+
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "cubic_engine/ml/datasets/blaze_regression_dataset.h"
+#include "cubic_engine/ml/loss_functions/mse_loss.h"
+#include "kernel/maths/functions/real_vector_polynomial.h"
+#include "kernel/numerics/optimization/stochastic_gradient_descent.h"
+#include "kernel/numerics/optimization/gd_control.h"
+#include "kernel/parallel/threading/thread_pool.h"
+
+#include <chrono>
+#include <random>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+
+namespace  {
+
+using cengine::uint_t;
+using cengine::real_t;
+using cengine::DynMat;
+using cengine::DynVec;
+using cengine::Null;
+using cengine::ml::BlazeRegressionDataset;
+using cengine::ml::MSELoss;
+using kernel::PolynomialFunction;
+using kernel::numerics::opt::GDConfig;
+using kernel::numerics::opt::SGD;
+
+typedef MSELoss<PolynomialFunction, BlazeRegressionDataset> loss_t;
+
+const uint_t N_ROWS = 20000;
+const uint_t N_FEATURES = 256;
+const uint_t N_EPOCHS = 5;
+const uint_t BATCH_SIZE = 256;
+const uint_t N_THREADS = 4;
+
+real_t seconds_since(std::chrono::steady_clock::time_point start){
+    return std::chrono::duration<real_t>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// Fit the model with SGD for N_EPOCHS and return the time per epoch
+real_t fit(const BlazeRegressionDataset& dataset, PolynomialFunction& model, real_t eta, uint_t batch_size){
+
+    model.set_coeffs(std::vector<real_t>(N_FEATURES, 0.0));
+    loss_t loss(model);
+
+    GDConfig config(N_EPOCHS, 0.0, eta, batch_size);
+    SGD<BlazeRegressionDataset, loss_t> sgd(config);
+
+    auto start = std::chrono::steady_clock::now();
+    sgd.solve(dataset, loss);
+    return seconds_since(start)/N_EPOCHS;
+}
+
+}
+
+int main(){
+
+    try{
+
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<real_t> distribution(-1.0, 1.0);
+
+        DynMat<real_t> features(N_ROWS, N_FEATURES);
+        DynVec<real_t> labels(N_ROWS);
+
+        for(uint_t r=0; r<N_ROWS; ++r){
+
+            features(r, 0) = 1.0;
+            labels[r] = 1.0;
+
+            for(uint_t c=1; c<N_FEATURES; ++c){
+                features(r, c) = distribution(generator);
+                labels[r] += features(r, c)/c;
+            }
+        }
+
+        BlazeRegressionDataset dataset;
+        dataset.load_from_data(features, labels);
+
+        PolynomialFunction model(std::vector<real_t>(N_FEATURES, 0.0));
+        loss_t loss(model);
+
+        const real_t per_example_time = fit(dataset, model, 0.001, 1);
+        const real_t per_example_mse = loss.evaluate(dataset);
+        const real_t mini_batch_time = fit(dataset, model, 0.5, BATCH_SIZE);
+        const real_t mini_batch_mse = loss.evaluate(dataset);
+
+        DynVec<real_t> gradients;
+
+        auto start = std::chrono::steady_clock::now();
+        loss.batch_gradients(dataset, 0, dataset.n_examples(), gradients);
+        const real_t serial_time = seconds_since(start);
+
+        kernel::ThreadPool pool(N_THREADS);
+
+        start = std::chrono::steady_clock::now();
+        loss.batch_gradients(dataset, 0, dataset.n_examples(), gradients, pool, Null());
+        const real_t threaded_time = seconds_since(start);
+
+        std::cout<<"Rows: "<<N_ROWS<<" features: "<<N_FEATURES<<" batch size: "<<BATCH_SIZE<<std::endl;
+        std::cout<<"Per example MSE: "<<per_example_mse<<std::endl;
+        std::cout<<"Mini-batch MSE: "<<mini_batch_mse<<std::endl;
+        std::cout<<std::setw(24)<<"run"<<std::setw(14)<<"epoch (s)"<<std::endl;
+        std::cout<<std::setw(24)<<"SGD per example"<<std::setw(14)<<per_example_time<<std::endl;
+        std::cout<<std::setw(24)<<"SGD mini-batch"<<std::setw(14)<<mini_batch_time<<std::endl;
+        std::cout<<std::setw(24)<<"full gradient"<<std::setw(14)<<serial_time<<std::endl;
+        std::cout<<std::setw(24)<<"threaded full gradient"<<std::setw(14)<<threaded_time<<std::endl;
+    }
+    catch(std::exception& e){
+
+        std::cerr<<e.what()<<std::endl;
+    }
+    catch(...){
+
+        std::cerr<<"Unknown exception occured"<<std::endl;
+    }
+
+    return 0;
+}
@@ -49,7 +49,17 @@ BlazeRegressionDataset::operator[](uint_t i)const{
     assert( i < examples_.rows() && "Invalid row index specified.");
 #endif
 
-    return {kernel::matrix_row_trait<DynMat<real_t>>::get_row(examples_, i), labels_[i]};
+    return {kernel::matrix_row_trait<DynMat<real_t>>::get_row_view(examples_, i), labels_[i]};
+}
+
+DynVec<real_t>
+BlazeRegressionDataset::get_row(uint_t idx)const{
+
+#ifdef KERNEL_DEBUG
+    assert( idx < examples_.rows() && "Invalid row index specified.");
+#endif
+
+    return kernel::matrix_row_trait<DynMat<real_t>>::get_row(examples_, idx);
 }
 
 }
@@ -4,6 +4,7 @@
 #include "cubic_engine/base/cubic_engine_types.h"
 #include "cubic_engine/ml/datasets/regression_dataset_base.h"
 #include "cubic_engine/ml/datasets/dataset_point_type.h"
+#include "kernel/maths/matrix_traits.h"
 
 #include <boost/noncopyable.hpp>
 #include <string>
@@ -42,9 +43,10 @@ public:
     typedef real_t label_value_t;
 
     ///
-    /// \brief row_t
+    /// \brief row_t. A non-owning view of a row of the feature
+    /// matrix. It is valid as long as the dataset is not reloaded
     ///
-    typedef DynVec<real_t> row_t;
+    typedef kernel::matrix_row_trait<DynMat<real_t>>::row_view_t row_t;
 
     ///
     /// \brief RegressionDataset
@@ -52,9 +54,8 @@ public:
     BlazeRegressionDataset();
 
     ///
-    /// \brief operator []
-    /// \param i
-    /// \return
+    /// \brief operator []. Returns a view of the i-th row
+    /// and the i-th label. The row is not copied
     ///
     std::tuple<row_t, label_value_t> operator[](uint_t i)const;
 
@@ -88,11 +89,9 @@ public:
     const storage_engine_t& feature_matrix()const noexcept{return examples_;}
 
     ///
-    /// \brief get_row
-    /// \param idx
-    /// \return
+    /// \brief get_row. Returns a copy of the row with index idx
     ///
-    row_t get_row(uint_t idx)const{return row_t();}
+    DynVec<real_t> get_row(uint_t idx)const;
 
     ///
     /// \brief get_label
@@ -247,10 +246,9 @@ accumulate_tail(const BlazeRegressionDataset& dataset, const OperatorTp& op, uin
     }
 
     DynVec<real_t> result(limit, 0.0);
-    auto start = dataset.n_rows() - 1;
-    auto end = dataset.n_rows() - limit;
-    for(uint_t i=0; start< end;  --start, i++){
-        auto[row, label] = dataset[start];
+
+    for(uint_t i=0; i < limit; ++i){
+        auto[row, label] = dataset[dataset.n_rows() - 1 - i];
         result[i] = op(row, label);
     }
     return result;
@@ -0,0 +1,180 @@
+#include "cubic_engine/ml/datasets/columnar_dataset_format.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace cengine {
+namespace ml {
+
+namespace{
+
+std::uint64_t align(std::uint64_t offset){
+
+    const auto alignment = ColumnarDatasetHeader::ALIGNMENT;
+    return ((offset + alignment - 1)/alignment)*alignment;
+}
+
+void pad_to(std::ofstream& file, std::uint64_t offset){
+
+    const std::uint64_t position = file.tellp();
+    const std::vector<char> zeros(offset - position, '\0');
+    file.write(zeros.data(), zeros.size());
+}
+
+}
+
+void
+validate_columnar_dataset_header(const ColumnarDatasetHeader& header, uint_t file_size){
+
+    if(std::memcmp(header.magic, ColumnarDatasetHeader::MAGIC, sizeof(header.magic)) != 0){
+        throw std::logic_error("Invalid binary dataset: wrong magic bytes");
+    }
+
+    if(header.version != ColumnarDatasetHeader::VERSION){
+        throw std::logic_error("Invalid binary dataset: unsupported version " + std::to_string(header.version));
+    }
+
+    if(header.dtype != ColumnarDType::FLOAT64 || sizeof(real_t) != sizeof(double)){
+        throw std::logic_error("Invalid binary dataset: the values are not of type real_t");
+    }
+
+    const auto alignment = ColumnarDatasetHeader::ALIGNMENT;
+
+    if(header.file_size != file_size ||
+       header.names_offset + header.names_size > header.features_offset ||
+       header.features_offset % alignment != 0 || header.labels_offset % alignment != 0 ||
+       header.features_offset + header.n_rows*header.n_features*sizeof(real_t) > header.labels_offset ||
+       header.labels_offset + header.n_rows*sizeof(real_t) > file_size){
+        throw std::logic_error("Invalid binary dataset: the blocks do not fit in the file");
+    }
+}
+
+void
+parse_columnar_dataset_names(const ColumnarDatasetHeader& header, const char* names,
+                             std::map<std::string, uint_t>& columns, std::string& label_name){
+
+    columns.clear();
+    label_name.clear();
+
+    if(header.names_size == 0){
+        return;
+    }
+
+    const char* names_end = names + header.names_size;
+
+    if(names_end[-1] != '\0'){
+        throw std::logic_error("Invalid binary dataset: the names are not terminated");
+    }
+
+    std::vector<std::string> ordered;
+    for(; names < names_end; names += ordered.back().size() + 1){
+        ordered.emplace_back(names);
+    }
+
+    if(ordered.size() != header.n_features + 1){
+        throw std::logic_error("Invalid binary dataset: the number of names is not equal to the number of columns");
+    }
+
+    for(uint_t c=0; c<header.n_features; ++c){
+        columns[ordered[c]] = c;
+    }
+
+    label_name = ordered.back();
+}
+
+void
+write_columnar_dataset(const std::string& file_name, const DynMat<real_t>& features,
+                       const DynVec<real_t>& labels, const std::map<std::string, uint_t>& columns,
+                       const std::string& label_name){
+
+    if(features.rows() != labels.size()){
+        throw std::logic_error("The number of rows " + std::to_string(features.rows()) +
+                               " is not equal to the number of labels " + std::to_string(labels.size()));
+    }
+
+    // the names in column order
+    std::string names;
+
+    if(!columns.empty()){
+
+        if(columns.size() != features.columns()){
+            throw std::logic_error("The number of column names is not equal to the number of features");
+        }
+
+        std::vector<const std::string*> ordered(features.columns(), nullptr);
+
+        for(const auto& [name, idx] : columns){
+
+            if(idx >= ordered.size() || ordered[idx]){
+                throw std::logic_error("Invalid column index " + std::to_string(idx) + " for column " + name);
+            }
+
+            ordered[idx] = &name;
+        }
+
+        for(const auto* name : ordered){
+            names += *name;
+            names += '\0';
+        }
+
+        names += label_name;
+        names += '\0';
+    }
+
+    ColumnarDatasetHeader header;
+    std::memcpy(header.magic, ColumnarDatasetHeader::MAGIC, sizeof(header.magic));
+    header.version = ColumnarDatasetHeader::VERSION;
+    header.dtype = ColumnarDType::FLOAT64;
+    header.n_rows = features.rows();
+    header.n_features = features.columns();
+    header.names_offset = align(sizeof(ColumnarDatasetHeader));
+    header.names_size = names.size();
+    header.features_offset = align(header.names_offset + header.names_size);
+    header.labels_offset = align(header.features_offset + header.n_rows*header.n_features*sizeof(real_t));
+    header.file_size = header.labels_offset + header.n_rows*sizeof(real_t);
+
+    std::ofstream file(file_name, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+    if(!file.good()){
+        throw std::logic_error("Failed to open file: " + file_name);
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    pad_to(file, header.names_offset);
+    file.write(names.data(), names.size());
+
+    // the rows of DynMat may be padded so
+    // they are written one by one
+    pad_to(file, header.features_offset);
+    for(uint_t r=0; r<features.rows(); ++r){
+        file.write(reinterpret_cast<const char*>(features.data(r)), features.columns()*sizeof(real_t));
+    }
+
+    pad_to(file, header.labels_offset);
+    file.write(reinterpret_cast<const char*>(labels.data()), labels.size()*sizeof(real_t));
+
+    if(!file.good()){
+        throw std::logic_error("Failed to write file: " + file_name);
+    }
+}
+
+void
+convert_csv_to_columnar(const std::string& csv_file, const std::string& file_name,
+                        const kernel::CSVDataReaderConfig& config){
+
+    DynMat<real_t> features;
+    DynVec<real_t> labels;
+    std::map<std::string, uint_t> columns;
+
+    kernel::CSVDataReader reader(csv_file, config);
+    reader.read(features, labels, columns);
+
+    write_columnar_dataset(file_name, features, labels, columns);
+}
+
+}
+}
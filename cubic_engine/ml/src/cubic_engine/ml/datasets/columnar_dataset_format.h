@@ -0,0 +1,96 @@
+#ifndef COLUMNAR_DATASET_FORMAT_H
+#define COLUMNAR_DATASET_FORMAT_H
+
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "kernel/utilities/csv_data_reader.h"
+
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <map>
+
+namespace cengine {
+namespace ml {
+
+///
+/// \brief The ColumnarDType enum. The type of the values
+/// stored in the feature and label blocks
+///
+enum class ColumnarDType: std::uint32_t {FLOAT64=0};
+
+///
+/// \brief The ColumnarDatasetHeader struct. The header at the start
+/// of a binary dataset file. The file layout is
+///
+/// - the header
+/// - the names block: the feature names in column order followed by the
+///   label name, every name terminated by '\0'. Empty if there are no names
+/// - the feature block: n_rows x n_features values stored row by row
+/// - the label block: n_rows values
+///
+/// The blocks start at offsets that are multiples of ALIGNMENT. The values
+/// are in the byte order of the machine that wrote the file
+///
+struct ColumnarDatasetHeader
+{
+    ///
+    /// \brief The magic bytes of the format
+    ///
+    static constexpr char MAGIC[8] = {'C', 'E', 'D', 'S', 'E', 'T', '\0', '\0'};
+
+    ///
+    /// \brief The version of the format
+    ///
+    static constexpr std::uint32_t VERSION = 1;
+
+    ///
+    /// \brief The alignment of the blocks in bytes
+    ///
+    static constexpr std::uint64_t ALIGNMENT = 64;
+
+    char magic[8];
+    std::uint32_t version;
+    ColumnarDType dtype;
+    std::uint64_t n_rows;
+    std::uint64_t n_features;
+    std::uint64_t names_offset;
+    std::uint64_t names_size;
+    std::uint64_t features_offset;
+    std::uint64_t labels_offset;
+    std::uint64_t file_size;
+};
+
+///
+/// \brief Check that the header describes a valid dataset
+/// file of the given size. Throws std::logic_error otherwise
+///
+void validate_columnar_dataset_header(const ColumnarDatasetHeader& header, uint_t file_size);
+
+///
+/// \brief Split the names block of the given header into the
+/// feature names and the label name. names is the start of the block
+///
+void parse_columnar_dataset_names(const ColumnarDatasetHeader& header, const char* names,
+                                  std::map<std::string, uint_t>& columns, std::string& label_name);
+
+///
+/// \brief Write the features and the labels in the binary format.
+/// columns maps the feature names to their column index and may be
+/// empty. Throws std::logic_error if the sizes do not match or the
+/// file cannot be written
+///
+void write_columnar_dataset(const std::string& file_name, const DynMat<real_t>& features,
+                            const DynVec<real_t>& labels, const std::map<std::string, uint_t>& columns,
+                            const std::string& label_name="label");
+
+///
+/// \brief Convert the given CSV file to the binary format. The CSV file
+/// is read with kernel::CSVDataReader and the given configuration
+///
+void convert_csv_to_columnar(const std::string& csv_file, const std::string& file_name,
+                             const kernel::CSVDataReaderConfig& config=kernel::CSVDataReaderConfig());
+
+}
+}
+
+#endif // COLUMNAR_DATASET_FORMAT_H
@@ -53,9 +53,8 @@ public:
     uint_t n_examples()const{return dataset_ptr_ ->n_examples();}
 
     ///
-    /// \brief operator []
-    /// \param i
-    /// \return
+    /// \brief operator []. Returns the row of the viewed dataset
+    /// so a dataset that returns row views is not copied
     ///
     std::tuple<row_t, label_value_t> operator[](uint_t i)const;
 
@@ -65,7 +64,7 @@ private:
     ///
     /// \brief dataset_ptr_
     ///
-    const DatasetView* dataset_ptr_;
+    const DatasetType* dataset_ptr_;
 
     ///
     /// \brief view_idices_
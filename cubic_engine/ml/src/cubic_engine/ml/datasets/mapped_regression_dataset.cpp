@@ -0,0 +1,141 @@
+#include "cubic_engine/ml/datasets/mapped_regression_dataset.h"
+#include "cubic_engine/ml/datasets/columnar_dataset_format.h"
+#include "kernel/base/config.h"
+
+#ifdef KERNEL_DEBUG
+#include <cassert>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace cengine{
+namespace ml{
+
+MappedRegressionDataset::MappedRegressionDataset()
+    :
+      data_(nullptr),
+      size_(0),
+      examples_(),
+      labels_(),
+      columns_(),
+      label_name_()
+{}
+
+MappedRegressionDataset::MappedRegressionDataset(const std::string& file_name)
+    :
+      MappedRegressionDataset()
+{
+    open(file_name);
+}
+
+MappedRegressionDataset::~MappedRegressionDataset(){
+    close();
+}
+
+void
+MappedRegressionDataset::open(const std::string& file_name){
+
+    close();
+
+    const int fd = ::open(file_name.c_str(), O_RDONLY);
+
+    if(fd < 0){
+        throw std::logic_error("Failed to open file: " + file_name);
+    }
+
+    struct stat info;
+    if(::fstat(fd, &info) != 0 || static_cast<uint_t>(info.st_size) < sizeof(ColumnarDatasetHeader)){
+        ::close(fd);
+        throw std::logic_error("The file " + file_name + " is not a binary dataset");
+    }
+
+    size_ = info.st_size;
+    void* data = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if(data == MAP_FAILED){
+        size_ = 0;
+        throw std::logic_error("Failed to map file: " + file_name);
+    }
+
+    data_ = data;
+
+    ColumnarDatasetHeader header;
+    std::memcpy(&header, data_, sizeof(header));
+
+    const char* bytes = static_cast<const char*>(data_);
+
+    try{
+        validate_columnar_dataset_header(header, size_);
+        parse_columnar_dataset_names(header, bytes + header.names_offset, columns_, label_name_);
+    }
+    catch(std::logic_error& error){
+        close();
+        throw std::logic_error(std::string(error.what()) + " in file " + file_name);
+    }
+
+    examples_ = storage_engine_t(reinterpret_cast<const real_t*>(bytes + header.features_offset),
+                                 header.n_rows, header.n_features);
+
+    labels_ = labels_t(reinterpret_cast<const real_t*>(bytes + header.labels_offset), header.n_rows);
+}
+
+void
+MappedRegressionDataset::close(){
+
+    examples_.reset();
+    labels_.reset();
+    columns_.clear();
+    label_name_.clear();
+
+    if(data_){
+        ::munmap(data_, size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
+
+std::tuple<MappedRegressionDataset::row_t, MappedRegressionDataset::label_value_t>
+MappedRegressionDataset::operator[](uint_t i)const{
+
+#ifdef KERNEL_DEBUG
+    assert( i < examples_.rows() && "Invalid row index specified.");
+#endif
+
+    return {row_t(examples_.data(i), examples_.columns()), labels_[i]};
+}
+
+DynVec<real_t>
+MappedRegressionDataset::get_row(uint_t idx)const{
+
+#ifdef KERNEL_DEBUG
+    assert( idx < examples_.rows() && "Invalid row index specified.");
+#endif
+
+    DynVec<real_t> row(examples_.columns());
+    std::copy(examples_.begin(idx), examples_.end(idx), row.begin());
+    return row;
+}
+
+std::vector<std::string>
+MappedRegressionDataset::get_columns()const{
+
+    std::vector<std::string> keys;
+    keys.reserve(columns_.size());
+
+    for(const auto& column : columns_){
+        keys.push_back(column.first);
+    }
+
+    return keys;
+}
+
+}
+}
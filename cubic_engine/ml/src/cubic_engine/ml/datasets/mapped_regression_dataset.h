@@ -0,0 +1,214 @@
+#ifndef MAPPED_REGRESSION_DATASET_H
+#define MAPPED_REGRESSION_DATASET_H
+
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "cubic_engine/ml/datasets/dataset_point_type.h"
+
+#include <boost/noncopyable.hpp>
+#include <string>
+#include <vector>
+#include <map>
+#include <tuple>
+
+namespace cengine {
+namespace ml{
+
+///
+/// \brief The MappedRegressionDataset class. A read-only regression
+/// dataset stored in the binary format of columnar_dataset_format.h.
+/// The file is memory mapped and the feature and label blocks are
+/// exposed as blaze::CustomMatrix and blaze::CustomVector views so
+/// opening a dataset does not parse or copy the data. Processes that
+/// open the same file share the pages. It has the interface of
+/// BlazeRegressionDataset so it can be used with the loss functions
+/// and the optimizers
+///
+class MappedRegressionDataset: private boost::noncopyable
+{
+public:
+
+    ///
+    /// \brief storage_engine_t
+    ///
+    typedef blaze::CustomMatrix<const real_t, blaze::unaligned, blaze::unpadded, blaze::rowMajor> storage_engine_t;
+
+    ///
+    /// \brief features_t
+    ///
+    typedef storage_engine_t features_t;
+
+    ///
+    /// \brief labels_t
+    ///
+    typedef blaze::CustomVector<const real_t, blaze::unaligned, blaze::unpadded> labels_t;
+
+    ///
+    /// \brief label_value_t
+    ///
+    typedef real_t label_value_t;
+
+    ///
+    /// \brief row_t. A non-owning view of a row of the
+    /// mapped file. It is valid until the file is closed
+    ///
+    typedef blaze::CustomVector<const real_t, blaze::unaligned, blaze::unpadded> row_t;
+
+    ///
+    /// \brief Constructor. Creates an empty dataset
+    ///
+    MappedRegressionDataset();
+
+    ///
+    /// \brief Constructor. Open the given file
+    ///
+    explicit MappedRegressionDataset(const std::string& file_name);
+
+    ///
+    /// \brief Destructor. Unmap the file
+    ///
+    ~MappedRegressionDataset();
+
+    ///
+    /// \brief Map the given file. A file already mapped is closed. Throws
+    /// std::logic_error if the file cannot be mapped or is not a valid dataset
+    ///
+    void open(const std::string& file_name);
+
+    ///
+    /// \brief Unmap the file. The dataset becomes empty
+    ///
+    void close();
+
+    ///
+    /// \brief operator []. Returns a view of the i-th row
+    /// and the i-th label. The row is not copied
+    ///
+    std::tuple<row_t, label_value_t> operator[](uint_t i)const;
+
+    ///
+    /// \brief empty
+    ///
+    bool empty()const noexcept{return examples_.rows() == 0;}
+
+    ///
+    /// \brief n_rows
+    ///
+    uint_t n_rows()const noexcept{return examples_.rows();}
+
+    ///
+    /// \brief n_features
+    ///
+    uint_t n_features()const{return examples_.columns();}
+
+    ///
+    /// \brief n_examples
+    ///
+    uint_t n_examples()const{return examples_.rows();}
+
+    ///
+    /// \brief feature_matrix
+    ///
+    const storage_engine_t& feature_matrix()const noexcept{return examples_;}
+
+    ///
+    /// \brief get_row. Returns a copy of the row with index idx
+    ///
+    DynVec<real_t> get_row(uint_t idx)const;
+
+    ///
+    /// \brief get_label
+    ///
+    label_value_t get_label(uint_t i)const{return labels_[i];}
+
+    ///
+    /// \brief labels
+    ///
+    const labels_t& labels()const noexcept{return labels_;}
+
+    ///
+    /// \brief get_columns
+    ///
+    std::vector<std::string> get_columns()const;
+
+    ///
+    /// \brief columns
+    ///
+    const std::map<std::string, uint_t>& columns()const noexcept {return columns_;}
+
+    ///
+    /// \brief label_name. The name of the label column
+    ///
+    const std::string& label_name()const noexcept{return label_name_;}
+
+    ///
+    /// \brief Apply op on the first or the last limit rows
+    ///
+    template<typename OperatorTp>
+    DynVec<real_t> accumulate(const OperatorTp& op, uint_t limit, PointTp type=PointTp::START)const;
+
+    ///
+    /// \brief Apply op on every row
+    ///
+    template<typename OpTp>
+    void iterate(const OpTp& op)const;
+
+private:
+
+    ///
+    /// \brief The mapped file
+    ///
+    void* data_;
+    uint_t size_;
+
+    ///
+    /// \brief The views of the feature and label blocks
+    ///
+    storage_engine_t examples_;
+    labels_t labels_;
+
+    ///
+    /// \brief The names of the feature columns
+    ///
+    std::map<std::string, uint_t> columns_;
+
+    ///
+    /// \brief The name of the label column
+    ///
+    std::string label_name_;
+
+};
+
+template<typename OperatorTp>
+DynVec<real_t>
+MappedRegressionDataset::accumulate(const OperatorTp& op, uint_t limit, PointTp type)const{
+
+    if(empty()){
+        return DynVec<real_t>();
+    }
+
+    DynVec<real_t> result(limit, 0.0);
+
+    for(uint_t i=0; i<limit; ++i){
+
+        const uint_t r = type == PointTp::END ? n_rows() - 1 - i : i;
+        auto [row, label] = (*this)[r];
+        result[i] = op(row, label);
+    }
+
+    return result;
+}
+
+template<typename OpTp>
+void
+MappedRegressionDataset::iterate(const OpTp& op)const{
+
+    for(uint_t i=0; i < n_rows(); ++i){
+        auto [row, label] = (*this)[i];
+        op(row, label);
+    }
+}
+
+}
+}
+
+#endif // MAPPED_REGRESSION_DATASET_H
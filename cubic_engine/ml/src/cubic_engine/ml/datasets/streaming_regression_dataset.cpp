@@ -0,0 +1,388 @@
+#include "cubic_engine/ml/datasets/streaming_regression_dataset.h"
+#include "cubic_engine/ml/datasets/columnar_dataset_format.h"
+#include "kernel/base/config.h"
+#include "kernel/base/kernel_consts.h"
+
+#ifdef KERNEL_DEBUG
+#include <cassert>
+#endif
+
+#include <numeric>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace cengine{
+namespace ml{
+
+namespace{
+
+///
+/// \brief Read count bytes at the given offset. Throws
+/// std::logic_error if the file is shorter
+///
+void read_at(int fd, void* data, uint_t count, uint_t offset){
+
+    char* bytes = static_cast<char*>(data);
+
+    while(count != 0){
+
+        const auto n_read = ::pread(fd, bytes, count, offset);
+
+        if(n_read <= 0){
+            throw std::logic_error("Failed to read the binary dataset at offset " + std::to_string(offset));
+        }
+
+        bytes += n_read;
+        offset += n_read;
+        count -= n_read;
+    }
+}
+
+}
+
+StreamingRegressionDataset::StreamingRegressionDataset(const StreamingDatasetConfig& config)
+    :
+      config_(config),
+      fd_(-1),
+      n_rows_(0),
+      n_features_(0),
+      features_offset_(0),
+      labels_(),
+      columns_(),
+      label_name_(),
+      order_(),
+      next_order_(),
+      has_next_order_(false),
+      generator_(config.seed),
+      epoch_(0),
+      current_position_(kernel::KernelConsts::invalid_size_type()),
+      current_(),
+      next_(),
+      n_chunk_reads_(0),
+      worker_(),
+      mutex_(),
+      condition_(),
+      requested_(kernel::KernelConsts::invalid_size_type()),
+      loaded_(false),
+      error_(),
+      stop_(false)
+{
+    if(config_.chunk_rows == 0){
+        throw std::logic_error("The number of rows in a chunk should be positive");
+    }
+}
+
+StreamingRegressionDataset::StreamingRegressionDataset(const std::string& file_name,
+                                                       const StreamingDatasetConfig& config)
+    :
+      StreamingRegressionDataset(config)
+{
+    open(file_name);
+}
+
+StreamingRegressionDataset::~StreamingRegressionDataset(){
+    close();
+}
+
+void
+StreamingRegressionDataset::open(const std::string& file_name){
+
+    close();
+
+    fd_ = ::open(file_name.c_str(), O_RDONLY);
+
+    if(fd_ < 0){
+        throw std::logic_error("Failed to open file: " + file_name);
+    }
+
+    try{
+
+        struct stat info;
+        if(::fstat(fd_, &info) != 0 || static_cast<uint_t>(info.st_size) < sizeof(ColumnarDatasetHeader)){
+            throw std::logic_error("Not a binary dataset");
+        }
+
+        ColumnarDatasetHeader header;
+        read_at(fd_, &header, sizeof(header), 0);
+        validate_columnar_dataset_header(header, info.st_size);
+
+        std::vector<char> names(header.names_size);
+        read_at(fd_, names.data(), names.size(), header.names_offset);
+        parse_columnar_dataset_names(header, names.data(), columns_, label_name_);
+
+        labels_.resize(header.n_rows);
+        read_at(fd_, labels_.data(), header.n_rows*sizeof(real_t), header.labels_offset);
+
+        n_rows_ = header.n_rows;
+        n_features_ = header.n_features;
+        features_offset_ = header.features_offset;
+    }
+    catch(std::logic_error& error){
+        close();
+        throw std::logic_error(std::string(error.what()) + " in file " + file_name);
+    }
+
+    order_.resize((n_rows_ + config_.chunk_rows - 1)/config_.chunk_rows);
+    std::iota(order_.begin(), order_.end(), 0);
+
+    if(config_.shuffle_chunks){
+        shuffle_(order_);
+    }
+
+    stop_ = false;
+    worker_ = std::thread(&StreamingRegressionDataset::prefetch_loop_, this);
+}
+
+void
+StreamingRegressionDataset::close(){
+
+    if(worker_.joinable()){
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+
+        condition_.notify_all();
+        worker_.join();
+    }
+
+    if(fd_ >= 0){
+        ::close(fd_);
+        fd_ = -1;
+    }
+
+    n_rows_ = 0;
+    n_features_ = 0;
+    features_offset_ = 0;
+    labels_.clear();
+    columns_.clear();
+    label_name_.clear();
+    order_.clear();
+    next_order_.clear();
+    has_next_order_ = false;
+    epoch_ = 0;
+    current_position_ = kernel::KernelConsts::invalid_size_type();
+    current_ = Chunk();
+    next_ = Chunk();
+    n_chunk_reads_ = 0;
+    requested_ = kernel::KernelConsts::invalid_size_type();
+    loaded_ = false;
+    error_ = nullptr;
+}
+
+std::tuple<StreamingRegressionDataset::row_t, StreamingRegressionDataset::label_value_t>
+StreamingRegressionDataset::operator[](uint_t i)const{
+
+#ifdef KERNEL_DEBUG
+    assert( i < n_rows_ && "Invalid row index specified.");
+#endif
+
+    const auto& chunk = chunk_at_(i/config_.chunk_rows);
+    const uint_t offset = i % config_.chunk_rows;
+    const auto* values = chunk.values.data() + offset*n_features_;
+
+    row_t row(n_features_);
+    std::copy(values, values + n_features_, row.begin());
+    return {row, labels_[chunk.index*config_.chunk_rows + offset]};
+}
+
+StreamingRegressionDataset::row_t
+StreamingRegressionDataset::get_row(uint_t idx)const{
+
+#ifdef KERNEL_DEBUG
+    assert( idx < n_rows_ && "Invalid row index specified.");
+#endif
+
+    row_t row(n_features_);
+    read_at(fd_, row.data(), n_features_*sizeof(real_t), features_offset_ + idx*n_features_*sizeof(real_t));
+    return row;
+}
+
+std::vector<std::string>
+StreamingRegressionDataset::get_columns()const{
+
+    std::vector<std::string> keys;
+    keys.reserve(columns_.size());
+
+    for(const auto& column : columns_){
+        keys.push_back(column.first);
+    }
+
+    return keys;
+}
+
+uint_t
+StreamingRegressionDataset::chunk_size_(uint_t chunk)const{
+
+    const uint_t begin = chunk*config_.chunk_rows;
+    return std::min(config_.chunk_rows, n_rows_ - begin);
+}
+
+void
+StreamingRegressionDataset::read_chunk_(uint_t chunk, std::vector<real_t>& values)const{
+
+    const uint_t row_bytes = n_features_*sizeof(real_t);
+    values.resize(chunk_size_(chunk)*n_features_);
+    read_at(fd_, values.data(), values.size()*sizeof(real_t), features_offset_ + chunk*config_.chunk_rows*row_bytes);
+}
+
+void
+StreamingRegressionDataset::prefetch_loop_(){
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while(true){
+
+        condition_.wait(lock, [this](){
+            return stop_ || (requested_ != kernel::KernelConsts::invalid_size_type() && !loaded_);
+        });
+
+        if(stop_){
+            return;
+        }
+
+        const uint_t chunk = requested_;
+        lock.unlock();
+
+        // next_ is only touched by this thread
+        // until loaded_ is set
+        std::exception_ptr error;
+        try{
+            read_chunk_(chunk, next_.values);
+            next_.index = chunk;
+        }
+        catch(...){
+            error = std::current_exception();
+        }
+
+        lock.lock();
+        error_ = error;
+        loaded_ = true;
+        ++n_chunk_reads_;
+        condition_.notify_all();
+    }
+}
+
+void
+StreamingRegressionDataset::prefetch_(uint_t chunk)const{
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    // wait for a read in progress
+    condition_.wait(lock, [this](){
+        return requested_ == kernel::KernelConsts::invalid_size_type() || loaded_;
+    });
+
+    if(requested_ == chunk){
+        return;
+    }
+
+    requested_ = chunk;
+    loaded_ = false;
+    lock.unlock();
+    condition_.notify_all();
+}
+
+void
+StreamingRegressionDataset::acquire_(uint_t chunk)const{
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    condition_.wait(lock, [this](){
+        return requested_ == kernel::KernelConsts::invalid_size_type() || loaded_;
+    });
+
+    const bool prefetched = requested_ == chunk;
+    requested_ = kernel::KernelConsts::invalid_size_type();
+    loaded_ = false;
+
+    if(prefetched){
+
+        if(error_){
+            auto error = error_;
+            error_ = nullptr;
+            std::rethrow_exception(error);
+        }
+
+        std::swap(current_, next_);
+        return;
+    }
+
+    // the prefetch thread is idle so the
+    // chunk is read in this thread
+    lock.unlock();
+    read_chunk_(chunk, current_.values);
+    current_.index = chunk;
+    lock.lock();
+    ++n_chunk_reads_;
+}
+
+void
+StreamingRegressionDataset::shuffle_(std::vector<uint_t>& order)const{
+
+    // a last chunk with less rows stays last so that
+    // the position of a row is i/chunk_rows
+    const uint_t n_full_chunks = n_rows_/config_.chunk_rows;
+    std::shuffle(order.begin(), order.begin() + n_full_chunks, generator_);
+}
+
+void
+StreamingRegressionDataset::start_epoch_()const{
+
+    if(has_next_order_){
+        order_.swap(next_order_);
+        has_next_order_ = false;
+        ++epoch_;
+
+        // the positions refer to the previous order
+        current_position_ = kernel::KernelConsts::invalid_size_type();
+    }
+}
+
+const StreamingRegressionDataset::Chunk&
+StreamingRegressionDataset::chunk_at_(uint_t position)const{
+
+    if(position == 0){
+        start_epoch_();
+    }
+
+    if(position == current_position_){
+        return current_;
+    }
+
+    // the chunk may already be in memory
+    // if only the position changed
+    if(current_position_ == kernel::KernelConsts::invalid_size_type() || current_.index != order_[position]){
+        acquire_(order_[position]);
+    }
+
+    current_position_ = position;
+
+    uint_t next = order_[0];
+
+    if(position + 1 < order_.size()){
+        next = order_[position + 1];
+    }
+    else if(config_.shuffle_chunks){
+
+        // draw the order of the next epoch now so
+        // that its first chunk can be prefetched
+        next_order_ = order_;
+        shuffle_(next_order_);
+        has_next_order_ = true;
+        next = next_order_[0];
+    }
+
+    if(next != current_.index){
+        prefetch_(next);
+    }
+
+    return current_;
+}
+
+}
+}
@@ -0,0 +1,383 @@
+#ifndef STREAMING_REGRESSION_DATASET_H
+#define STREAMING_REGRESSION_DATASET_H
+
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "cubic_engine/ml/datasets/dataset_point_type.h"
+
+#include <boost/noncopyable.hpp>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace cengine {
+namespace ml{
+
+///
+/// \brief The StreamingDatasetConfig struct. The options
+/// of StreamingRegressionDataset
+///
+struct StreamingDatasetConfig
+{
+    ///
+    /// \brief The number of rows in a chunk
+    ///
+    uint_t chunk_rows{4096};
+
+    ///
+    /// \brief Visit the chunks in a random order that
+    /// changes in every epoch
+    ///
+    bool shuffle_chunks{false};
+
+    ///
+    /// \brief The seed of the chunk shuffling
+    ///
+    uint_t seed{42};
+};
+
+///
+/// \brief The StreamingRegressionDataset class. An out-of-core regression
+/// dataset stored in the binary format of columnar_dataset_format.h.
+/// Only two chunks of chunk_rows rows are held in memory. While the rows
+/// of one chunk are used, a background thread reads the next chunk into
+/// the second buffer. The labels are small compared to the features
+/// and are kept in memory.
+///
+/// The rows are visited in the order of the chunks. If shuffle_chunks is
+/// set, the chunk order is permuted every time the first chunk is visited
+/// again i.e. once per epoch. A last chunk with less rows is not moved.
+/// operator[] indexes the rows in the current chunk order so the optimizers
+/// that loop over n_examples() stream the file. Random access is correct
+/// but reads a chunk per access.
+/// accumulate returns the values in file order so they match labels().
+///
+/// It has the interface of BlazeRegressionDataset so it can be used
+/// with the loss functions and the optimizers. The chunk buffers are
+/// shared by all the calls so the class is not thread safe
+///
+class StreamingRegressionDataset: private boost::noncopyable
+{
+public:
+
+    ///
+    /// \brief labels_t
+    ///
+    typedef DynVec<real_t> labels_t;
+
+    ///
+    /// \brief label_value_t
+    ///
+    typedef real_t label_value_t;
+
+    ///
+    /// \brief row_t
+    ///
+    typedef DynVec<real_t> row_t;
+
+    ///
+    /// \brief Constructor. Creates an empty dataset
+    ///
+    explicit StreamingRegressionDataset(const StreamingDatasetConfig& config=StreamingDatasetConfig());
+
+    ///
+    /// \brief Constructor. Open the given file
+    ///
+    StreamingRegressionDataset(const std::string& file_name,
+                               const StreamingDatasetConfig& config=StreamingDatasetConfig());
+
+    ///
+    /// \brief Destructor. Stop the prefetch thread and close the file
+    ///
+    ~StreamingRegressionDataset();
+
+    ///
+    /// \brief Open the given file. A file already open is closed. Throws
+    /// std::logic_error if the file cannot be read or is not a valid dataset
+    ///
+    void open(const std::string& file_name);
+
+    ///
+    /// \brief Close the file. The dataset becomes empty
+    ///
+    void close();
+
+    ///
+    /// \brief operator []. The i-th row in the current chunk order
+    ///
+    std::tuple<row_t, label_value_t> operator[](uint_t i)const;
+
+    ///
+    /// \brief empty
+    ///
+    bool empty()const noexcept{return n_rows_ == 0;}
+
+    ///
+    /// \brief n_rows
+    ///
+    uint_t n_rows()const noexcept{return n_rows_;}
+
+    ///
+    /// \brief n_features
+    ///
+    uint_t n_features()const noexcept{return n_features_;}
+
+    ///
+    /// \brief n_examples
+    ///
+    uint_t n_examples()const noexcept{return n_rows_;}
+
+    ///
+    /// \brief n_chunks
+    ///
+    uint_t n_chunks()const noexcept{return order_.size();}
+
+    ///
+    /// \brief epoch. The number of times the chunk order was reshuffled
+    ///
+    uint_t epoch()const noexcept{return epoch_;}
+
+    ///
+    /// \brief n_chunk_reads. The number of chunks read from the file
+    ///
+    uint_t n_chunk_reads()const noexcept{return n_chunk_reads_;}
+
+    ///
+    /// \brief get_row. The row at the given position in the file
+    ///
+    row_t get_row(uint_t idx)const;
+
+    ///
+    /// \brief get_label. The label at the given position in the file
+    ///
+    label_value_t get_label(uint_t i)const{return labels_[i];}
+
+    ///
+    /// \brief labels. The labels in file order
+    ///
+    const labels_t& labels()const noexcept{return labels_;}
+
+    ///
+    /// \brief get_columns
+    ///
+    std::vector<std::string> get_columns()const;
+
+    ///
+    /// \brief columns
+    ///
+    const std::map<std::string, uint_t>& columns()const noexcept {return columns_;}
+
+    ///
+    /// \brief label_name. The name of the label column
+    ///
+    const std::string& label_name()const noexcept{return label_name_;}
+
+    ///
+    /// \brief Apply op on the first or the last limit rows of the file.
+    /// The i-th entry of the result is the value of the i-th row counting
+    /// from the start or the end of the file
+    ///
+    template<typename OperatorTp>
+    DynVec<real_t> accumulate(const OperatorTp& op, uint_t limit, PointTp type=PointTp::START)const;
+
+    ///
+    /// \brief Apply op on every row in the current chunk order
+    ///
+    template<typename OpTp>
+    void iterate(const OpTp& op)const;
+
+private:
+
+    ///
+    /// \brief The Chunk struct. A buffer with the rows of a chunk
+    ///
+    struct Chunk
+    {
+        uint_t index;
+        std::vector<real_t> values;
+    };
+
+    ///
+    /// \brief The configuration
+    ///
+    StreamingDatasetConfig config_;
+
+    ///
+    /// \brief The file descriptor of the open file
+    ///
+    int fd_;
+
+    ///
+    /// \brief The sizes and the offset of the feature block
+    ///
+    uint_t n_rows_;
+    uint_t n_features_;
+    uint_t features_offset_;
+
+    ///
+    /// \brief The labels in file order
+    ///
+    labels_t labels_;
+
+    ///
+    /// \brief The names of the feature columns
+    ///
+    std::map<std::string, uint_t> columns_;
+
+    ///
+    /// \brief The name of the label column
+    ///
+    std::string label_name_;
+
+    ///
+    /// \brief The chunk order of the current and of the next epoch
+    ///
+    mutable std::vector<uint_t> order_;
+    mutable std::vector<uint_t> next_order_;
+    mutable bool has_next_order_;
+    mutable std::mt19937_64 generator_;
+    mutable uint_t epoch_;
+
+    ///
+    /// \brief The position in order_ of the chunk in current_
+    ///
+    mutable uint_t current_position_;
+
+    ///
+    /// \brief The chunk in use and the chunk read in the background
+    ///
+    mutable Chunk current_;
+    mutable Chunk next_;
+    mutable std::atomic<uint_t> n_chunk_reads_;
+
+    ///
+    /// \brief The prefetch thread and its state. requested_ is the
+    /// chunk the thread reads into next_ and loaded_ is set once
+    /// the read is done
+    ///
+    std::thread worker_;
+    mutable std::mutex mutex_;
+    mutable std::condition_variable condition_;
+    mutable uint_t requested_;
+    mutable bool loaded_;
+    mutable std::exception_ptr error_;
+    bool stop_;
+
+    ///
+    /// \brief The number of rows in the given chunk
+    ///
+    uint_t chunk_size_(uint_t chunk)const;
+
+    ///
+    /// \brief Read the given chunk from the file
+    ///
+    void read_chunk_(uint_t chunk, std::vector<real_t>& values)const;
+
+    ///
+    /// \brief The loop of the prefetch thread
+    ///
+    void prefetch_loop_();
+
+    ///
+    /// \brief Ask the prefetch thread to read the given chunk
+    ///
+    void prefetch_(uint_t chunk)const;
+
+    ///
+    /// \brief Make the given chunk the current one. Uses the
+    /// prefetched chunk if it is the requested one
+    ///
+    void acquire_(uint_t chunk)const;
+
+    ///
+    /// \brief Shuffle the given chunk order
+    ///
+    void shuffle_(std::vector<uint_t>& order)const;
+
+    ///
+    /// \brief Switch to the chunk order of the next epoch
+    /// if it was already drawn
+    ///
+    void start_epoch_()const;
+
+    ///
+    /// \brief Make the chunk at the given position of the chunk order
+    /// the current one and prefetch the chunk that follows it
+    ///
+    const Chunk& chunk_at_(uint_t position)const;
+
+};
+
+template<typename OperatorTp>
+DynVec<real_t>
+StreamingRegressionDataset::accumulate(const OperatorTp& op, uint_t limit, PointTp type)const{
+
+    if(empty()){
+        return DynVec<real_t>();
+    }
+
+    DynVec<real_t> result(limit, 0.0);
+
+    // the rows of the file that are requested
+    const uint_t first = type == PointTp::END ? n_rows_ - limit : 0;
+    const uint_t last = type == PointTp::END ? n_rows_ : limit;
+
+    row_t row(n_features_);
+
+    start_epoch_();
+
+    for(uint_t position=0; position<n_chunks(); ++position){
+
+        const uint_t begin = order_[position]*config_.chunk_rows;
+        const uint_t end = begin + chunk_size_(order_[position]);
+
+        if(end <= first || begin >= last){
+            continue;
+        }
+
+        const auto& chunk = chunk_at_(position);
+
+        for(uint_t r=std::max(begin, first); r<std::min(end, last); ++r){
+
+            const auto* values = chunk.values.data() + (r - begin)*n_features_;
+            std::copy(values, values + n_features_, row.begin());
+
+            const uint_t i = type == PointTp::END ? n_rows_ - 1 - r : r;
+            result[i] = op(row, labels_[r]);
+        }
+    }
+
+    return result;
+}
+
+template<typename OpTp>
+void
+StreamingRegressionDataset::iterate(const OpTp& op)const{
+
+    row_t row(n_features_);
+
+    for(uint_t position=0; position<n_chunks(); ++position){
+
+        const auto& chunk = chunk_at_(position);
+        const uint_t begin = chunk.index*config_.chunk_rows;
+
+        for(uint_t r=0; r<chunk_size_(chunk.index); ++r){
+
+            const auto* values = chunk.values.data() + r*n_features_;
+            std::copy(values, values + n_features_, row.begin());
+            op(row, labels_[begin + r]);
+        }
+    }
+}
+
+}
+}
+
+#endif // STREAMING_REGRESSION_DATASET_H
@@ -0,0 +1,266 @@
+#ifndef KNN_BLOCKED_SEARCH_H
+#define KNN_BLOCKED_SEARCH_H
+
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "cubic_engine/ml/instance_learning/details/knn_top_k.h"
+
+#include "kernel/utilities/range_1d.h"
+#include "kernel/maths/matrix_traits.h"
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace kernel{
+template<int P, bool TTakeRoot> class LpMetric;
+}
+
+namespace cengine{
+namespace ml{
+namespace details{
+
+///
+/// \brief Describes whether a similarity orders the points in the same way
+/// as the squared Euclidean distance so that KnnBlockedSearch can be used
+///
+template<typename SimilarityTp>
+struct knn_blocked_metric_trait
+{
+    static constexpr bool is_supported = false;
+};
+
+///
+/// \brief Both LpMetric<2, true> and LpMetric<2, false> return the Euclidean distance
+///
+template<bool TTakeRoot>
+struct knn_blocked_metric_trait<kernel::LpMetric<2, TTakeRoot>>
+{
+    static constexpr bool is_supported = true;
+};
+
+///
+/// \brief Exact k-nearest neighbors search for many query points at once.
+/// The queries and the points are split in blocks and for every pair of
+/// blocks the squared distances are computed as
+/// \f$\|q\|^2 + \|x\|^2 - 2 Q X^T\f$ so that the bulk of the work is a matrix
+/// product. The rounding error of this formula is bounded and every point
+/// whose distance interval can still reach the k best is kept as a candidate.
+/// The candidates are pruned after every block of points so at most the k
+/// best and the points within the rounding tolerance of the k-th are held.
+/// They are finally ranked using the given metric so the
+/// neighbors and distances are exactly the ones a scan with the metric finds
+///
+template<typename MetricTp>
+class KnnBlockedSearch
+{
+
+public:
+
+    typedef MetricTp metric_type;
+    typedef KnnTopK::Pair Pair;
+
+    ///
+    /// \brief Constructor. The block sizes are the number of queries
+    /// and the number of points multiplied at once
+    ///
+    explicit KnnBlockedSearch(uint_t query_block=64, uint_t point_block=256);
+
+    ///
+    /// \brief Set the points to search. The matrix is not copied and
+    /// should outlive this object. The squared norms of the rows are cached
+    ///
+    void build(const DynMat<real_t>& points);
+
+    ///
+    /// \brief Find the k nearest neighbors of the rows of the queries matrix in the
+    /// given range. For every query row r op(r, neighbors) is called with the neighbors
+    /// sorted in ascending distance. The neighbors vector may be moved from
+    ///
+    template<typename OpTp>
+    void query(const DynMat<real_t>& queries, kernel::range1d<uint_t> range,
+               uint_t k, OpTp&& op)const;
+
+    ///
+    /// \brief Remove the points
+    ///
+    void clear(){points_ = nullptr; norms_.clear();}
+
+    ///
+    /// \brief Returns true if build() has not been called
+    ///
+    bool empty()const{return points_ == nullptr;}
+
+private:
+
+    uint_t query_block_;
+    uint_t point_block_;
+    metric_type metric_;
+
+    const DynMat<real_t>* points_;
+
+    /// \brief The squared norm of every point
+    std::vector<real_t> norms_;
+
+    /// \brief Bound of the rounding error of the distance
+    /// computed from the norms and the dot product
+    real_t tolerance_(real_t qnorm, real_t pnorm)const;
+
+    static real_t sqr_norm_(const DynMat<real_t>& matrix, uint_t row);
+};
+
+template<typename MetricTp>
+KnnBlockedSearch<MetricTp>::KnnBlockedSearch(uint_t query_block, uint_t point_block)
+    :
+    query_block_(query_block == 0 ? 1 : query_block),
+    point_block_(point_block == 0 ? 1 : point_block),
+    metric_(),
+    points_(nullptr),
+    norms_()
+{}
+
+template<typename MetricTp>
+real_t
+KnnBlockedSearch<MetricTp>::sqr_norm_(const DynMat<real_t>& matrix, uint_t row){
+
+    real_t norm = 0.0;
+    for(uint_t c=0; c<matrix.columns(); ++c){
+        norm += matrix(row, c)*matrix(row, c);
+    }
+
+    return norm;
+}
+
+template<typename MetricTp>
+void
+KnnBlockedSearch<MetricTp>::build(const DynMat<real_t>& points){
+
+    static_assert (knn_blocked_metric_trait<MetricTp>::is_supported, "The metric is not supported by KnnBlockedSearch");
+
+    if(points.rows() == 0){
+        throw std::logic_error("Cannot search in a matrix with zero rows");
+    }
+
+    points_ = &points;
+    norms_.resize(points.rows());
+
+    for(uint_t r=0; r<points.rows(); ++r){
+        norms_[r] = sqr_norm_(points, r);
+    }
+}
+
+template<typename MetricTp>
+real_t
+KnnBlockedSearch<MetricTp>::tolerance_(real_t qnorm, real_t pnorm)const{
+
+    // the error of a dot product of length d is bounded by d*eps*|q||x| and
+    // 2|q||x| <= |q|^2 + |x|^2. The factor leaves room for the additions
+    // and for the different summation orders of the matrix product
+    const real_t eps = std::numeric_limits<real_t>::epsilon();
+    return 2.0*(points_->columns() + 3)*eps*(qnorm + pnorm);
+}
+
+template<typename MetricTp>
+template<typename OpTp>
+void
+KnnBlockedSearch<MetricTp>::query(const DynMat<real_t>& queries, kernel::range1d<uint_t> range,
+                                  uint_t k, OpTp&& op)const{
+
+    if(empty()){
+        throw std::logic_error("KnnBlockedSearch has no points");
+    }
+
+    if(queries.columns() != points_->columns()){
+        throw std::logic_error("Queries dimension: "+std::to_string(queries.columns())+
+                               " does not match the points dimension: "+std::to_string(points_->columns()));
+    }
+
+    const uint_t n_points = points_->rows();
+    const uint_t dim = points_->columns();
+
+    // the work space is allocated once per call
+    DynMat<real_t> products(query_block_, point_block_);
+    std::vector<real_t> qnorms(query_block_);
+    std::vector<KnnTopK> upper(query_block_, KnnTopK(k));
+    std::vector<std::vector<Pair>> candidates(query_block_);
+    std::vector<Pair> neighbors;
+    KnnTopK exact(k);
+
+    for(uint_t q_begin=range.begin(); q_begin<range.end(); q_begin += query_block_){
+
+        const uint_t nq = std::min(query_block_, range.end() - q_begin);
+
+        for(uint_t i=0; i<nq; ++i){
+            qnorms[i] = sqr_norm_(queries, q_begin + i);
+            upper[i].reset(k);
+            candidates[i].clear();
+        }
+
+        auto qblock = blaze::submatrix(queries, q_begin, 0, nq, dim);
+
+        for(uint_t p_begin=0; p_begin<n_points; p_begin += point_block_){
+
+            const uint_t np = std::min(point_block_, n_points - p_begin);
+
+            auto pblock = blaze::submatrix(*points_, p_begin, 0, np, dim);
+            auto pblock_products = blaze::submatrix(products, 0, 0, nq, np);
+            pblock_products = qblock * blaze::trans(pblock);
+
+            for(uint_t i=0; i<nq; ++i){
+
+                KnnTopK& best = upper[i];
+
+                for(uint_t j=0; j<np; ++j){
+
+                    const uint_t p = p_begin + j;
+                    const real_t distance = qnorms[i] + norms_[p] - 2.0*products(i, j);
+                    const real_t tolerance = tolerance_(qnorms[i], norms_[p]);
+
+                    // the k-th best upper bound only decreases so a point
+                    // rejected here can never be among the k nearest
+                    if(distance - tolerance <= best.worst_distance()){
+                        best.push(p, distance + tolerance);
+                        candidates[i].push_back(Pair(p, distance - tolerance));
+                    }
+                }
+
+                // drop the candidates the tightened bound excludes so that only
+                // the k best and the points tied with them within the tolerance
+                // are kept between the blocks
+                const real_t threshold = best.worst_distance();
+                auto& kept = candidates[i];
+                kept.erase(std::remove_if(kept.begin(), kept.end(),
+                                          [threshold](const Pair& candidate){return candidate.second > threshold;}),
+                           kept.end());
+            }
+        }
+
+        // rank the candidates with the metric
+        for(uint_t i=0; i<nq; ++i){
+
+            const uint_t q = q_begin + i;
+            const real_t threshold = upper[i].worst_distance();
+            const auto point = kernel::matrix_row_trait<DynMat<real_t>>::get_row_view(queries, q);
+
+            exact.reset(k);
+            for(const auto& candidate : candidates[i]){
+
+                if(candidate.second > threshold){
+                    continue;
+                }
+
+                const auto row = kernel::matrix_row_trait<DynMat<real_t>>::get_row_view(*points_, candidate.first);
+                exact.push(candidate.first, metric_(row, point));
+            }
+
+            exact.sorted(neighbors);
+            op(q, neighbors);
+        }
+    }
+}
+
+}
+}
+}
+
+#endif // KNN_BLOCKED_SEARCH_H
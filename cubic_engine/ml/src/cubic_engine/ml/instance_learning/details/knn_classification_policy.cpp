@@ -15,30 +15,21 @@ knn_policy_base<false>(k)
 KnnClassificationPolicy::return_type
 KnnClassificationPolicy::get_result()const{
 
-    if(this->data_handler_.majority_vote.empty()){
-        return kernel::KernelConsts::invalid_size_type();
-    }
-
-    auto voteitr  = this->data_handler_.majority_vote.begin();
-    auto voteitre = this->data_handler_.majority_vote.end();
+    const auto& votes = this->data_handler_.majority_vote;
 
     //the class index
-    uint_t rslt = voteitr->first;
+    uint_t rslt = kernel::KernelConsts::invalid_size_type();
 
     //the class counter
-    uint_t ctr  = voteitr->second;
+    uint_t ctr  = 0;
 
-    while(voteitr != voteitre){
+    // on ties the class with the smallest index wins
+    for(uint_t cls=0; cls<votes.size(); ++cls){
 
-      uint_t rslttmp = voteitr->first;
-      uint_t ctrtmp  = voteitr->second;
-
-      if(ctrtmp > ctr){
-          ctr = ctrtmp;
-          rslt = rslttmp;
+      if(votes[cls] > ctr){
+          ctr = votes[cls];
+          rslt = cls;
       }
-
-      voteitr++;
     }
 
      return rslt;
@@ -11,7 +11,8 @@ knn_policy_base_data_handler<true>::knn_policy_base_data_handler(uint_t k_)
 :
 k(k_),
 k_distances(),
-majority_vote()
+majority_vote(),
+top_k(k_)
 {}
 
 void
@@ -50,7 +51,8 @@ knn_policy_base_data_handler<false>::knn_policy_base_data_handler(uint_t k_)
 :
 k(k_),
 k_distances(),
-majority_vote()
+majority_vote(),
+top_k(k_)
 {}
 
 void
@@ -90,7 +92,8 @@ knn_policy_base_data_handler<false>::get_top_k_results(boost::scoped_array<knn_p
 template<bool is_regressor>
 knn_policy_base<is_regressor>::knn_policy_base(uint_t k)
 :
-data_handler_(k)
+data_handler_(k),
+merge_buffer_()
 {}
 
 template<bool is_regressor>
@@ -109,6 +112,14 @@ knn_policy_base<is_regressor>::resume(uint_t k){
        data_handler_.k_distances.clear();
    }
 
+template<bool is_regressor>
+void
+knn_policy_base<is_regressor>::merge_distances(const distances_container_type& distances){
+
+    merge_top_k(data_handler_.k_distances, distances, data_handler_.k, merge_buffer_);
+    data_handler_.k_distances.swap(merge_buffer_);
+}
+
 //explicit instantiations
 template class knn_policy_base<true>;
 template class knn_policy_base<false>;
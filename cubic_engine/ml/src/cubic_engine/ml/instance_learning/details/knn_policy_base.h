@@ -3,17 +3,18 @@
 #define	KNN_POLICY_BASE_H
 
 #include "cubic_engine/base/cubic_engine_types.h"
+#include "cubic_engine/ml/instance_learning/details/knn_top_k.h"
 
 //#include "kernel/utilities/range_1d.h"
-#include "kernel/utilities/map_utilities.h"
 //#include "kernel/maths/matrix_utilities.h"
 #include "kernel/parallel/utilities/result_holder.h"
 
 
 #include <vector>
 #include <utility>
-#include <map>
-#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
 
 namespace cengine{
 namespace ml{
@@ -72,6 +73,12 @@ struct knn_policy_base_data_handler<true>
       */
     std::vector<real_t> majority_vote;
 
+    /**
+     * @brief Bounded heap used to select the k smallest
+     * distances without sorting all of them
+     */
+    KnnTopK top_k;
+
     /// \brief The result of the policy
     //result_t result;
      
@@ -100,7 +107,7 @@ template<typename DataVec>
 void 
 knn_policy_base_data_handler<true>::fillin_majority_vote(const DataVec& labels){
      
-    if( k <= k_distances.size()){
+    if( k > k_distances.size()){
         throw std::logic_error("Incompatible number of neighbors: "+
                                std::to_string(k)+
                                " and k_distances size: "+
@@ -108,6 +115,8 @@ knn_policy_base_data_handler<true>::fillin_majority_vote(const DataVec& labels){
     }
 
 
+    majority_vote.clear();
+
     //we loop ove all the k-distances as we want
     //the average
     for(uint_t d=0; d<k; ++d){
@@ -139,9 +148,9 @@ struct knn_policy_base_data_handler<false>
     
     /**
      * @brief The type of the container that holds
-     * the majority vote
+     * the majority vote. The votes of class c are at index c
      */
-    typedef std::map<uint_t, uint_t> majority_vote_container_type;
+    typedef std::vector<uint_t> majority_vote_container_type;
     
     /**
      * @brief The type of the pair used for storing row-distance values
@@ -163,10 +172,17 @@ struct knn_policy_base_data_handler<false>
      
      
      /**
-      * @brief The vector that holds the values of the labels
-      * vector for the k-top neighbors
+      * @brief The number of votes every class received from
+      * the k-top neighbors. It grows to the number of classes
+      * and is only zeroed between queries
       */
-    std::map<uint_t, uint_t> majority_vote;
+    std::vector<uint_t> majority_vote;
+
+    /**
+     * @brief Bounded heap used to select the k smallest
+     * distances without sorting all of them
+     */
+    KnnTopK top_k;
 
     /// \brief The result of the policy
     //result_t result;
@@ -196,22 +212,25 @@ void
 knn_policy_base_data_handler<false>::fillin_majority_vote(const DataVec& labels){
     
 
-    if(k < k_distances.size()){
+    if(k > k_distances.size()){
         throw std::logic_error("Number of neighbors: "+
                                std::to_string(k)+
                                " not compatible with: "+
                                std::to_string(k_distances.size()));
     }
-    
-   typedef std::map<uint_t, uint_t>::iterator iterator;
-    
+
+   std::fill(majority_vote.begin(), majority_vote.end(), 0);
+
    for(uint_t i=0; i<k; ++i){
         
        uint_t idx = k_distances[i].first;
        uint_t cls = labels[idx];
 
-       kernel::add_or_update_map(majority_vote, cls, static_cast<uint_t>(1),
-                                [](iterator itr){itr->second += 1;});
+       if(cls >= majority_vote.size()){
+           majority_vote.resize(cls + 1, 0);
+       }
+
+       majority_vote[cls] += 1;
    }
 }
 
@@ -301,6 +320,22 @@ public:
     template<typename DataVec>
     void fillin_majority_vote(const DataVec& labels, 
                               std::vector<std::pair<uint_t,real_t> >&& distances);
+
+    /**
+     * @brief Same as above but the distances are copied into
+     * the storage of the object so no allocation takes place once
+     * the object has been used
+     */
+    template<typename DataVec>
+    void fillin_majority_vote(const DataVec& labels,
+                              const std::vector<std::pair<uint_t,real_t> >& distances);
+
+    /**
+     * @brief Merge the sorted distances computed by another policy, e.g. by
+     * another thread, with the distances of this object keeping the k smallest.
+     * This takes O(k). The majority vote should be filled in afterwards
+     */
+    void merge_distances(const distances_container_type& distances);
     
     
     /**
@@ -333,6 +368,11 @@ protected:
      * @brief The data handler
      */
     knn_policy_base_data_handler<is_regressor> data_handler_;
+
+    /**
+     * @brief Scratch storage for merging distances
+     */
+    distances_container_type merge_buffer_;
     
 };
 
@@ -341,12 +381,11 @@ template<typename DataSetTp, typename DataVec,typename Similarity>
 void 
 knn_policy_base<is_regressor>::operator()(const DataSetTp& data,  const DataVec& point, const Similarity& sim){
     
-    typedef typename knn_policy_base<is_regressor>::Pair Pair;
-     
-    //we will calculating as many distances as
-    //the size of the range
-    std::vector<Pair> distances;
-    distances.reserve(data.n_examples());
+    auto& top_k = data_handler_.top_k;
+
+    // the heap storage is reserved once for k pairs
+    // so the scan does not allocate
+    top_k.reset(data_handler_.k);
     
     for(uint_t r = 0; r <data.n_examples();  ++r){
         
@@ -355,29 +394,11 @@ knn_policy_base<is_regressor>::operator()(const DataSetTp& data,  const DataVec&
         
         //compute the distance between the data point and the 
         //input point
-        real_t dis = sim(features, point);
-
-        //compute the similarity and append it to distances
-        distances.push_back(std::make_pair(r,dis));  
+        top_k.push(r, sim(features, point));
     }
     
-    //sort the computed pairs based on the distances
-    std::sort(distances.begin(),distances.end(),
-             [](const Pair& p1,const Pair& p2){return p1.second < p2.second;});
-    
-    {
-        //empty what has been already computed 
-        std::vector<Pair> empty;
-        data_handler_.k_distances.swap(empty);
-        data_handler_.majority_vote.clear();
-    }
-               
-    data_handler_.k_distances.reserve(data_handler_.k);
-    
-
-    for(uint_t i=0; i<data_handler_.k; ++i){
-       data_handler_.k_distances.push_back(distances[i]);
-    }   
+    //the k smallest pairs sorted in ascending distance
+    top_k.sorted(data_handler_.k_distances);
     
     //fill in the majority vote
     fillin_majority_vote(data.labels());
@@ -402,6 +423,16 @@ knn_policy_base<is_regressor>::fillin_majority_vote(const DataVec& labels,
     fillin_majority_vote(labels);   
 }
 
+template<bool is_regressor>
+template<typename DataVec>
+void
+knn_policy_base<is_regressor>::fillin_majority_vote(const DataVec& labels,
+                                                    const std::vector<std::pair<uint_t,real_t> >& distances){
+
+    data_handler_.k_distances.assign(distances.begin(), distances.end());
+    fillin_majority_vote(labels);
+}
+
     
 }
 
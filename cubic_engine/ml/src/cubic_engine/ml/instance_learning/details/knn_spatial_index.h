@@ -0,0 +1,461 @@
+#ifndef KNN_SPATIAL_INDEX_H
+#define KNN_SPATIAL_INDEX_H
+
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "cubic_engine/ml/instance_learning/knn_control.h"
+#include "cubic_engine/ml/instance_learning/details/knn_top_k.h"
+
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include <limits>
+
+namespace kernel{
+template<int P, bool TTakeRoot> class LpMetric;
+}
+
+namespace cengine{
+namespace ml{
+namespace details{
+
+///
+/// \brief Describes whether a similarity can be used with
+/// KnnSpatialIndex. The KD-tree requires that the distance from
+/// a point to a box is the distance to the closest point of the box. The
+/// ball-tree additionally requires the triangle inequality
+///
+template<typename SimilarityTp>
+struct knn_index_metric_trait
+{
+    static constexpr bool is_supported = false;
+    static constexpr bool satisfies_triangle_inequality = false;
+};
+
+///
+/// \brief All the kernel::LpMetric distances are supported. LpMetric<P, false>
+/// for P > 3 returns the sum of the powers which is not a metric
+///
+template<int P, bool TTakeRoot>
+struct knn_index_metric_trait<kernel::LpMetric<P, TTakeRoot>>
+{
+    static constexpr bool is_supported = true;
+    static constexpr bool satisfies_triangle_inequality = TTakeRoot || P <= 3;
+};
+
+///
+/// \brief Index over the rows of a feature matrix that answers exact
+/// k-nearest neighbors queries. Depending on the type the index is a KD-tree,
+/// where every node holds the bounding box of its points, or a ball-tree, where
+/// every node holds a center and a radius, or a plain list of the points that
+/// is scanned for every query. In the trees a node is visited only if the distance
+/// of the query point to its bounds is not larger than the k-th best distance
+/// found so far. The distances are computed with the given metric in exactly
+/// the same way as the brute force policies so the same neighbors are returned
+///
+template<typename MetricTp>
+class KnnSpatialIndex
+{
+
+public:
+
+    typedef MetricTp metric_type;
+    typedef DynVec<real_t> point_type;
+    typedef KnnTopK::Pair Pair;
+
+    ///
+    /// \brief Dimension up to which AUTO selects a KD-tree
+    ///
+    static const uint_t MAX_KD_TREE_DIMENSION = 16;
+
+    ///
+    /// \brief Constructor
+    ///
+    explicit KnnSpatialIndex(uint_t leaf_size=32);
+
+    ///
+    /// \brief Build the index over the rows of the given matrix. The rows are copied
+    ///
+    template<typename MatrixTp>
+    void build(const MatrixTp& points, KnnIndexType type);
+
+    ///
+    /// \brief Find the result.k() nearest neighbors of the given point. The
+    /// result is not cleared so it may already hold candidates
+    ///
+    void query(const point_type& point, KnnTopK& result)const;
+
+    ///
+    /// \brief Find the k nearest neighbors of the given point sorted
+    /// in ascending distance
+    ///
+    void query(const point_type& point, uint_t k, std::vector<Pair>& neighbors)const;
+
+    ///
+    /// \brief Remove all the points
+    ///
+    void clear();
+
+    ///
+    /// \brief Returns true if the index has not been built
+    ///
+    bool empty()const{return points_.empty();}
+
+    ///
+    /// \brief The type of the index. AUTO is resolved in build()
+    ///
+    KnnIndexType type()const{return type_;}
+
+    ///
+    /// \brief The number of points indexed
+    ///
+    uint_t n_points()const{return points_.size();}
+
+    ///
+    /// \brief The number of nodes of the tree
+    ///
+    uint_t n_nodes()const{return nodes_.size();}
+
+    ///
+    /// \brief The dimension of the points
+    ///
+    uint_t dimension()const{return dimension_;}
+
+private:
+
+    static const uint_t INVALID_NODE = std::numeric_limits<uint_t>::max();
+
+    struct Node
+    {
+        uint_t begin;
+        uint_t end;
+        uint_t left;
+        uint_t right;
+
+        /// \brief Bounding box for the KD-tree
+        point_type lower;
+        point_type upper;
+
+        /// \brief Bounding ball for the ball-tree
+        point_type center;
+        real_t radius;
+
+        bool is_leaf()const{return left == INVALID_NODE;}
+    };
+
+    uint_t leaf_size_;
+    uint_t dimension_;
+    KnnIndexType type_;
+    metric_type metric_;
+
+    /// \brief The original row index of every point
+    std::vector<uint_t> indices_;
+
+    /// \brief The points in the order of the tree leaves
+    std::vector<point_type> points_;
+
+    std::vector<Node> nodes_;
+
+    /// \brief Build the node for the points [begin, end) and return its id
+    uint_t build_(uint_t begin, uint_t end);
+
+    /// \brief Set the bounds of the given node
+    void set_bounds_(Node& node)const;
+
+    /// \brief The dimension with the largest spread in [begin, end)
+    uint_t split_dimension_(uint_t begin, uint_t end)const;
+
+    /// \brief A lower bound of the distance between the
+    /// given point and any point in the node
+    real_t min_distance_(const Node& node, const point_type& point, point_type& work)const;
+
+    void query_(uint_t node, const point_type& point, point_type& work, KnnTopK& result)const;
+};
+
+template<typename MetricTp>
+KnnSpatialIndex<MetricTp>::KnnSpatialIndex(uint_t leaf_size)
+    :
+    leaf_size_(leaf_size == 0 ? 1 : leaf_size),
+    dimension_(0),
+    type_(KnnIndexType::AUTO),
+    metric_(),
+    indices_(),
+    points_(),
+    nodes_()
+{}
+
+template<typename MetricTp>
+void
+KnnSpatialIndex<MetricTp>::clear(){
+
+    indices_.clear();
+    points_.clear();
+    nodes_.clear();
+    dimension_ = 0;
+}
+
+template<typename MetricTp>
+template<typename MatrixTp>
+void
+KnnSpatialIndex<MetricTp>::build(const MatrixTp& points, KnnIndexType type){
+
+    static_assert (knn_index_metric_trait<MetricTp>::is_supported, "The metric is not supported by KnnSpatialIndex");
+
+    clear();
+
+    if(points.rows() == 0){
+        throw std::logic_error("Cannot build a KNN index with zero points");
+    }
+
+    dimension_ = points.columns();
+
+    if(type == KnnIndexType::AUTO){
+
+        if(dimension_ <= MAX_KD_TREE_DIMENSION || !knn_index_metric_trait<MetricTp>::satisfies_triangle_inequality){
+            type = KnnIndexType::KD_TREE;
+        }
+        else{
+            type = KnnIndexType::BALL_TREE;
+        }
+    }
+
+    if(type == KnnIndexType::BALL_TREE && !knn_index_metric_trait<MetricTp>::satisfies_triangle_inequality){
+        throw std::logic_error("A ball tree requires a metric that satisfies the triangle inequality");
+    }
+
+    type_ = type;
+
+    indices_.resize(points.rows());
+    std::iota(indices_.begin(), indices_.end(), 0);
+
+    points_.reserve(points.rows());
+    for(uint_t r=0; r<points.rows(); ++r){
+
+        point_type point(dimension_);
+        for(uint_t c=0; c<dimension_; ++c){
+            point[c] = points(r, c);
+        }
+
+        points_.push_back(std::move(point));
+    }
+
+    if(type_ == KnnIndexType::BRUTE_FORCE){
+        return;
+    }
+
+    build_(0, points_.size());
+
+    // store the points in the order of the leaves
+    // so that the points of a leaf are contiguous
+    std::vector<point_type> ordered;
+    ordered.reserve(points_.size());
+
+    for(auto idx: indices_){
+        ordered.push_back(std::move(points_[idx]));
+    }
+
+    points_.swap(ordered);
+}
+
+template<typename MetricTp>
+uint_t
+KnnSpatialIndex<MetricTp>::split_dimension_(uint_t begin, uint_t end)const{
+
+    uint_t split = 0;
+    real_t max_spread = -1.0;
+
+    for(uint_t c=0; c<dimension_; ++c){
+
+        real_t min = std::numeric_limits<real_t>::max();
+        real_t max = std::numeric_limits<real_t>::lowest();
+
+        for(uint_t i=begin; i<end; ++i){
+            const real_t value = points_[indices_[i]][c];
+            min = std::min(min, value);
+            max = std::max(max, value);
+        }
+
+        if(max - min > max_spread){
+            max_spread = max - min;
+            split = c;
+        }
+    }
+
+    return split;
+}
+
+template<typename MetricTp>
+void
+KnnSpatialIndex<MetricTp>::set_bounds_(Node& node)const{
+
+    if(type_ == KnnIndexType::KD_TREE){
+
+        node.lower = point_type(dimension_, std::numeric_limits<real_t>::max());
+        node.upper = point_type(dimension_, std::numeric_limits<real_t>::lowest());
+
+        for(uint_t i=node.begin; i<node.end; ++i){
+
+            const auto& point = points_[indices_[i]];
+            for(uint_t c=0; c<dimension_; ++c){
+                node.lower[c] = std::min(node.lower[c], point[c]);
+                node.upper[c] = std::max(node.upper[c], point[c]);
+            }
+        }
+    }
+    else{
+
+        node.center = point_type(dimension_, 0.0);
+
+        for(uint_t i=node.begin; i<node.end; ++i){
+
+            const auto& point = points_[indices_[i]];
+            for(uint_t c=0; c<dimension_; ++c){
+                node.center[c] += point[c];
+            }
+        }
+
+        const real_t n = static_cast<real_t>(node.end - node.begin);
+        for(uint_t c=0; c<dimension_; ++c){
+            node.center[c] /= n;
+        }
+
+        node.radius = 0.0;
+        for(uint_t i=node.begin; i<node.end; ++i){
+            node.radius = std::max(node.radius, metric_(points_[indices_[i]], node.center));
+        }
+    }
+}
+
+template<typename MetricTp>
+uint_t
+KnnSpatialIndex<MetricTp>::build_(uint_t begin, uint_t end){
+
+    const uint_t id = nodes_.size();
+
+    {
+        Node node;
+        node.begin = begin;
+        node.end = end;
+        node.left = INVALID_NODE;
+        node.right = INVALID_NODE;
+        node.radius = 0.0;
+        set_bounds_(node);
+        nodes_.push_back(std::move(node));
+    }
+
+    if(end - begin <= leaf_size_){
+        return id;
+    }
+
+    // split at the median of the dimension with the largest spread
+    const uint_t split = split_dimension_(begin, end);
+    const uint_t middle = begin + (end - begin)/2;
+
+    std::nth_element(indices_.begin() + begin, indices_.begin() + middle, indices_.begin() + end,
+                     [this, split](uint_t i1, uint_t i2){return points_[i1][split] < points_[i2][split];});
+
+    // nodes_ may be reallocated so do
+    // not hold references across the calls
+    const uint_t left = build_(begin, middle);
+    const uint_t right = build_(middle, end);
+
+    nodes_[id].left = left;
+    nodes_[id].right = right;
+    return id;
+}
+
+template<typename MetricTp>
+real_t
+KnnSpatialIndex<MetricTp>::min_distance_(const Node& node, const point_type& point, point_type& work)const{
+
+    if(type_ == KnnIndexType::KD_TREE){
+
+        // the closest point of the box
+        for(uint_t c=0; c<dimension_; ++c){
+            work[c] = std::min(std::max(point[c], node.lower[c]), node.upper[c]);
+        }
+
+        return metric_(work, point);
+    }
+
+    return std::max(real_t(0), metric_(node.center, point) - node.radius);
+}
+
+template<typename MetricTp>
+void
+KnnSpatialIndex<MetricTp>::query_(uint_t id, const point_type& point, point_type& work, KnnTopK& result)const{
+
+    const Node& node = nodes_[id];
+
+    if(node.is_leaf()){
+
+        for(uint_t i=node.begin; i<node.end; ++i){
+            result.push(indices_[i], metric_(points_[i], point));
+        }
+
+        return;
+    }
+
+    real_t left_distance = min_distance_(nodes_[node.left], point, work);
+    real_t right_distance = min_distance_(nodes_[node.right], point, work);
+
+    uint_t first = node.left;
+    uint_t second = node.right;
+
+    // visit the closest child first
+    if(right_distance < left_distance){
+        std::swap(first, second);
+        std::swap(left_distance, right_distance);
+    }
+
+    // nodes at equal distance are not pruned so
+    // that ties are resolved as in the brute force search
+    if(left_distance <= result.worst_distance()){
+        query_(first, point, work, result);
+    }
+
+    if(right_distance <= result.worst_distance()){
+        query_(second, point, work, result);
+    }
+}
+
+template<typename MetricTp>
+void
+KnnSpatialIndex<MetricTp>::query(const point_type& point, KnnTopK& result)const{
+
+    if(empty()){
+        throw std::logic_error("KNN index has not been built");
+    }
+
+    if(point.size() != dimension_){
+        throw std::logic_error("Point dimension: "+std::to_string(point.size())+
+                               " does not match the index dimension: "+std::to_string(dimension_));
+    }
+
+    if(type_ == KnnIndexType::BRUTE_FORCE){
+
+        for(uint_t i=0; i<points_.size(); ++i){
+            result.push(indices_[i], metric_(points_[i], point));
+        }
+
+        return;
+    }
+
+    point_type work(dimension_);
+    query_(0, point, work, result);
+}
+
+template<typename MetricTp>
+void
+KnnSpatialIndex<MetricTp>::query(const point_type& point, uint_t k, std::vector<Pair>& neighbors)const{
+
+    KnnTopK result(k);
+    query(point, result);
+    result.sorted(neighbors);
+}
+
+}
+}
+}
+
+#endif // KNN_SPATIAL_INDEX_H
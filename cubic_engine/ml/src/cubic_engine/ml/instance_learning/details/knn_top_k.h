@@ -0,0 +1,217 @@
+#ifndef KNN_TOP_K_H
+#define KNN_TOP_K_H
+
+#include "cubic_engine/base/cubic_engine_types.h"
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <limits>
+
+namespace cengine{
+namespace ml{
+namespace details{
+
+///
+/// \brief Holds the k (row index, distance) pairs with the
+/// smallest distances seen so far. The pairs are kept in a max-heap
+/// of at most k elements so that a new candidate is compared against
+/// the worst kept distance in O(1) and inserted in O(log k).
+/// Pairs with equal distances are ordered by the row index. The storage is
+/// allocated once so reusing the object for many queries does not allocate
+///
+class KnnTopK
+{
+
+public:
+
+    ///
+    /// \brief The type of the pair used for storing row-distance values
+    ///
+    typedef std::pair<uint_t, real_t> Pair;
+
+    ///
+    /// \brief Constructor
+    ///
+    explicit KnnTopK(uint_t k=0);
+
+    ///
+    /// \brief Remove all the pairs and set the number of neighbors
+    ///
+    void reset(uint_t k);
+
+    ///
+    /// \brief Remove all the pairs
+    ///
+    void clear(){heap_.clear();}
+
+    ///
+    /// \brief The number of neighbors to keep
+    ///
+    uint_t k()const{return k_;}
+
+    ///
+    /// \brief The number of pairs kept
+    ///
+    uint_t size()const{return heap_.size();}
+
+    ///
+    /// \brief Returns true if k pairs are kept
+    ///
+    bool full()const{return heap_.size() == k_;}
+
+    ///
+    /// \brief The largest distance kept. This is infinity
+    /// as long as less than k pairs are kept
+    ///
+    real_t worst_distance()const;
+
+    ///
+    /// \brief Offer the given pair. It is kept if it is
+    /// better than the worst pair kept
+    ///
+    void push(uint_t row, real_t distance);
+
+    ///
+    /// \brief Merge the pairs of the other object into this one
+    ///
+    void merge(const KnnTopK& other);
+
+    ///
+    /// \brief Sort the kept pairs in ascending distance. After this
+    /// call the object should be reset before pushing new pairs
+    ///
+    const std::vector<Pair>& sort();
+
+    ///
+    /// \brief Copy the kept pairs sorted in ascending distance
+    ///
+    void sorted(std::vector<Pair>& pairs)const;
+
+    ///
+    /// \brief Access the kept pairs. These are in heap order
+    ///
+    const std::vector<Pair>& pairs()const{return heap_;}
+
+    ///
+    /// \brief The ordering of the pairs. Smaller distance first
+    /// and for equal distances smaller row index first
+    ///
+    static bool less(const Pair& p1, const Pair& p2){
+        return p1.second < p2.second || (p1.second == p2.second && p1.first < p2.first);
+    }
+
+private:
+
+    uint_t k_;
+    std::vector<Pair> heap_;
+};
+
+inline
+KnnTopK::KnnTopK(uint_t k)
+    :
+    k_(k),
+    heap_()
+{
+    heap_.reserve(k);
+}
+
+inline
+void
+KnnTopK::reset(uint_t k){
+
+    k_ = k;
+    heap_.clear();
+    heap_.reserve(k);
+}
+
+inline
+real_t
+KnnTopK::worst_distance()const{
+
+    if(!full() || heap_.empty()){
+        return std::numeric_limits<real_t>::max();
+    }
+
+    return heap_.front().second;
+}
+
+inline
+void
+KnnTopK::push(uint_t row, real_t distance){
+
+    if(k_ == 0){
+        return;
+    }
+
+    const Pair candidate(row, distance);
+
+    if(!full()){
+        heap_.push_back(candidate);
+        std::push_heap(heap_.begin(), heap_.end(), &KnnTopK::less);
+        return;
+    }
+
+    if(less(candidate, heap_.front())){
+        std::pop_heap(heap_.begin(), heap_.end(), &KnnTopK::less);
+        heap_.back() = candidate;
+        std::push_heap(heap_.begin(), heap_.end(), &KnnTopK::less);
+    }
+}
+
+inline
+void
+KnnTopK::merge(const KnnTopK& other){
+
+    for(const auto& pair: other.heap_){
+        push(pair.first, pair.second);
+    }
+}
+
+inline
+const std::vector<KnnTopK::Pair>&
+KnnTopK::sort(){
+
+    std::sort_heap(heap_.begin(), heap_.end(), &KnnTopK::less);
+    return heap_;
+}
+
+inline
+void
+KnnTopK::sorted(std::vector<Pair>& pairs)const{
+
+    pairs.assign(heap_.begin(), heap_.end());
+    std::sort_heap(pairs.begin(), pairs.end(), &KnnTopK::less);
+}
+
+///
+/// \brief Merge the pairs of two vectors that are sorted with KnnTopK::less
+/// keeping at most the k smallest. The result is written in out which
+/// should not alias the inputs. This takes O(k)
+///
+inline
+void
+merge_top_k(const std::vector<KnnTopK::Pair>& first, const std::vector<KnnTopK::Pair>& second,
+            uint_t k, std::vector<KnnTopK::Pair>& out){
+
+    out.clear();
+
+    auto itr1 = first.begin();
+    auto itr2 = second.begin();
+
+    while(out.size() < k && (itr1 != first.end() || itr2 != second.end())){
+
+        if(itr2 == second.end() || (itr1 != first.end() && !KnnTopK::less(*itr2, *itr1))){
+            out.push_back(*itr1++);
+        }
+        else{
+            out.push_back(*itr2++);
+        }
+    }
+}
+
+}
+}
+}
+
+#endif // KNN_TOP_K_H
@@ -2,6 +2,7 @@
 #define	SERIAL_KNN_H
 
 #include "cubic_engine/ml/instance_learning/knn_control.h"
+#include "cubic_engine/ml/instance_learning/details/knn_spatial_index.h"
 #include "cubic_engine/ml/instance_learning/details/knn_classification_policy.h"
 
 #include "kernel/base/config.h"
@@ -34,7 +35,8 @@ public:
      explicit KnnClassifier(const KnnControl& control);
 
 	 ///
-     /// \brief Train the model
+     /// \brief Train the model. Unless KnnControl::index_type is BRUTE_FORCE
+     /// a search index is built over the features if the Similarity supports it
 	 ///
      void fit(const DataSetType& data_set);
 
@@ -66,20 +68,66 @@ private:
      /// \brief data_ptr_. Pointer to the data
      ///
      const DataSetType* data_ptr_;
+
+     ///
+     /// \brief The search index built in fit()
+     ///
+     details::KnnSpatialIndex<Similarity> index_;
+
+     ///
+     /// \brief Find the neighbors of the given point using the
+     /// index if it has been built or scanning the data set otherwise
+     ///
+     template<typename DataVec>
+     void find_neighbors_(const DataVec& point, KnnClassificationPolicy& actor)const;
 };
 
 template<typename DataSetType, typename Similarity>
 KnnClassifier<DataSetType, Similarity>::KnnClassifier(const KnnControl& control)
     :
    input_(control),
-   data_ptr_(nullptr)
+   data_ptr_(nullptr),
+   index_(control.leaf_size)
 {}
 
 
 template<typename DataSetType, typename Similarity>
 void
 KnnClassifier<DataSetType, Similarity>::fit(const DataSetType& data_set){
+
     data_ptr_ = &data_set;
+    index_.clear();
+
+    if constexpr(details::knn_index_metric_trait<Similarity>::is_supported){
+
+        if(input_.index_type != KnnIndexType::BRUTE_FORCE){
+            index_.build(data_set.feature_matrix(), input_.index_type);
+        }
+    }
+}
+
+template<typename DataSetType, typename Similarity>
+template<typename DataVec>
+void
+KnnClassifier<DataSetType, Similarity>::find_neighbors_(const DataVec& point, KnnClassificationPolicy& actor)const{
+
+    if constexpr(details::knn_index_metric_trait<Similarity>::is_supported){
+
+        if(!index_.empty()){
+
+            std::vector<std::pair<uint_t, real_t>> neighbors;
+            index_.query(point, input_.k, neighbors);
+            actor.fillin_majority_vote(data_ptr_->labels(), std::move(neighbors));
+            return;
+        }
+    }
+
+    // the metric used for classification
+    Similarity sim;
+
+    //find the k smallest distances of
+    //the given point from the given data set
+    actor(*this->data_ptr_, point, sim);
 }
 
 template<typename DataSetType, typename Similarity>
@@ -99,12 +147,9 @@ KnnClassifier<DataSetType, Similarity>::predict_one(const DataVec& point)const{
     // the type that will do the classification
     KnnClassificationPolicy actor(k);
 
-    // the metric used for classification
-    Similarity sim;
-    
     //find the k smallest distances of
     //the given point from the given data set
-    actor(*this->data_ptr_, point, sim);
+    find_neighbors_(point, actor);
     
     //get the result
     auto rslt = actor.get_result();
@@ -127,9 +172,6 @@ KnnClassifier<DataSetType, Similarity>::predict_many(const DataSetType& data)con
     // the type that will do the classification
     KnnClassificationPolicy actor(k);
 
-    // the metric used for classification
-    Similarity sim;
-
     DynVec<uint_t> result(data.n_examples());
 
     //find the k smallest distances of
@@ -139,7 +181,7 @@ KnnClassifier<DataSetType, Similarity>::predict_many(const DataSetType& data)con
 
         auto point = data.get_row(row_idx);
 
-        actor(*this->data_ptr_, point, sim);
+        find_neighbors_(point, actor);
 
         //get the result
         auto rslt = actor.get_result();
@@ -6,15 +6,30 @@
 namespace cengine{
 namespace ml{
 
+/// \brief The data structure used to search for the nearest neighbors.
+/// BRUTE_FORCE scans every row of the data set for every query. AUTO uses
+/// a KD_TREE for data with at most KnnSpatialIndex::MAX_KD_TREE_DIMENSION
+/// columns. Above that the Euclidean distance uses the blocked search of
+/// details::KnnBlockedSearch and any other supported metric a BALL_TREE
+enum class KnnIndexType{BRUTE_FORCE, KD_TREE, BALL_TREE, AUTO};
+
 struct KnnControl
 {
     /// \brief k: The number of neighbors to consider
     uint_t k;
 
+    /// \brief The search structure built when the model is trained
+    KnnIndexType index_type;
+
+    /// \brief The maximum number of points in a leaf of the search tree
+    uint_t leaf_size;
+
     /// \brief Constructor
-    KnnControl(uint_t k_)
+    KnnControl(uint_t k_, KnnIndexType index_type_=KnnIndexType::AUTO, uint_t leaf_size_=32)
         :
-        k(k_)
+        k(k_),
+        index_type(index_type_),
+        leaf_size(leaf_size_)
     {}
 
 };
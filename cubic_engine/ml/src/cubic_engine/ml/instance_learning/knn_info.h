@@ -0,0 +1,54 @@
+#ifndef KNN_INFO_H
+#define KNN_INFO_H
+
+#include "cubic_engine/base/cubic_engine_types.h"
+
+#include <chrono>
+#include <ostream>
+
+namespace cengine{
+namespace ml{
+
+/// \brief Information about a KNN prediction
+struct KnnInfo
+{
+    /// \brief The number of neighbors used
+    uint_t n_neighbors{0};
+
+    /// \brief The number of points predicted
+    uint_t n_pts_predicted{0};
+
+    /// \brief The number of processes used
+    uint_t nprocs{1};
+
+    /// \brief The number of threads used
+    uint_t nthreads{1};
+
+    /// \brief The total time the prediction took
+    std::chrono::duration<real_t> runtime{0};
+
+    /// \brief Print the information to the given stream
+    std::ostream& print(std::ostream& out)const;
+};
+
+inline
+std::ostream&
+KnnInfo::print(std::ostream& out)const{
+
+    out<<"# neighbors: "<<n_neighbors<<std::endl;
+    out<<"# points predicted: "<<n_pts_predicted<<std::endl;
+    out<<"# processes: "<<nprocs<<std::endl;
+    out<<"# threads: "<<nthreads<<std::endl;
+    out<<"Runtime: "<<runtime.count()<<std::endl;
+    return out;
+}
+
+inline
+std::ostream& operator<<(std::ostream& out, const KnnInfo& info){
+    return info.print(out);
+}
+
+}
+}
+
+#endif // KNN_INFO_H
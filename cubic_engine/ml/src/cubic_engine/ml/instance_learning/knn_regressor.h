@@ -3,6 +3,7 @@
 
 #include "cubic_engine/base/cubic_engine_types.h"
 #include "cubic_engine/ml/instance_learning/knn_control.h"
+#include "cubic_engine/ml/instance_learning/details/knn_spatial_index.h"
 #include "cubic_engine/ml/instance_learning/details/knn_average_regression_policy.h"
 
 #include "kernel/base/config.h"
@@ -31,7 +32,8 @@ public:
      explicit KnnRegressor(const KnnControl& control);
 
      ///
-     /// \brief Train the model
+     /// \brief Train the model. Unless KnnControl::index_type is BRUTE_FORCE
+     /// a search index is built over the features if the Similarity supports it
      ///
      void fit(const DataSetType& data_set);
 
@@ -57,20 +59,66 @@ private:
      /// \brief data_ptr_. Pointer to the data
      ///
      const DataSetType* data_ptr_;
+
+     ///
+     /// \brief The search index built in fit()
+     ///
+     details::KnnSpatialIndex<Similarity> index_;
+
+     ///
+     /// \brief Find the neighbors of the given point using the
+     /// index if it has been built or scanning the data set otherwise
+     ///
+     template<typename DataVec>
+     void find_neighbors_(const DataVec& point, KnnAvgRegressionPolicy& actor)const;
 };
 
 template<typename DataSetType, typename Similarity>
 KnnRegressor<DataSetType, Similarity>::KnnRegressor(const KnnControl& control)
     :
    input_(control),
-   data_ptr_(nullptr)
+   data_ptr_(nullptr),
+   index_(control.leaf_size)
 {}
 
 
 template<typename DataSetType, typename Similarity>
 void
 KnnRegressor<DataSetType, Similarity>::fit(const DataSetType& data_set){
+
     data_ptr_ = &data_set;
+    index_.clear();
+
+    if constexpr(details::knn_index_metric_trait<Similarity>::is_supported){
+
+        if(input_.index_type != KnnIndexType::BRUTE_FORCE){
+            index_.build(data_set.feature_matrix(), input_.index_type);
+        }
+    }
+}
+
+template<typename DataSetType, typename Similarity>
+template<typename DataVec>
+void
+KnnRegressor<DataSetType, Similarity>::find_neighbors_(const DataVec& point, KnnAvgRegressionPolicy& actor)const{
+
+    if constexpr(details::knn_index_metric_trait<Similarity>::is_supported){
+
+        if(!index_.empty()){
+
+            std::vector<std::pair<uint_t, real_t>> neighbors;
+            index_.query(point, input_.k, neighbors);
+            actor.fillin_majority_vote(data_ptr_->labels(), std::move(neighbors));
+            return;
+        }
+    }
+
+    // the metric used for classification
+    Similarity sim;
+
+    //find the k smallest distances of
+    //the given point from the given data set
+    actor(*this->data_ptr_, point, sim);
 }
 
 template<typename DataSetType, typename Similarity>
@@ -90,12 +138,9 @@ KnnRegressor<DataSetType, Similarity>::predict_one(const DataVec& point)const{
     // the type that will do the classification
     KnnAvgRegressionPolicy actor(k);
 
-    // the metric used for classification
-    Similarity sim;
-
     //find the k smallest distances of
     //the given point from the given data set
-    actor(*this->data_ptr_, point, sim);
+    find_neighbors_(point, actor);
 
     //get the result
     auto rslt = actor.get_result();
@@ -118,10 +163,7 @@ KnnRegressor<DataSetType, Similarity>::predict_many(const DataSetType& data)cons
     // the type that will do the classification
     KnnAvgRegressionPolicy actor(k);
 
-    // the metric used for classification
-    Similarity sim;
-
-    DynVec<uint_t> result(data.n_examples());
+    DynVec<real_t> result(data.n_examples());
 
     //find the k smallest distances of
     //the given point from the given data set
@@ -130,7 +172,7 @@ KnnRegressor<DataSetType, Similarity>::predict_many(const DataSetType& data)cons
 
         auto point = data.get_row(row_idx);
 
-        actor(*this->data_ptr_, point, sim);
+        find_neighbors_(point, actor);
 
         //get the result
         auto rslt = actor.get_result();
@@ -2,31 +2,43 @@
 #define	THREADED_KNN_H
 
 #include "cubic_engine/base/cubic_engine_types.h"
-#include "cubic_engine/ml/instance_learning/utils/knn_control.h"
-#include "cubic_engine/ml/instance_learning/utils/knn_info.h"
+#include "cubic_engine/ml/instance_learning/knn_control.h"
+#include "cubic_engine/ml/instance_learning/knn_info.h"
+#include "cubic_engine/ml/instance_learning/details/knn_top_k.h"
+#include "cubic_engine/ml/instance_learning/details/knn_spatial_index.h"
+#include "cubic_engine/ml/instance_learning/details/knn_blocked_search.h"
 
 #include "kernel/utilities/range_1d.h"
-#include "kernel/maths/matrix_utilities.h"
 #include "kernel/parallel/threading/simple_task.h"
-#include "kernel/utilities/range_1d.h"
+#include "kernel/parallel/utilities/array_partitioner.h"
 #include "kernel/maths/matrix_traits.h"
 
 #include <utility>
 #include <chrono>
 #include <memory>
+#include <vector>
+#include <stdexcept>
 
 
-namespace cengine
-{
-    
+namespace cengine{
+namespace ml{
 
-/// \brief Threaded implementation
-/// of K-nearest neighbors algorithm
 
+/// \brief Threaded implementation
+/// of K-nearest neighbors algorithm. When the model is trained
+/// a search index is built over the data set unless KnnControl::index_type
+/// is BRUTE_FORCE or the Similarity is not supported by the index. Without
+/// an index every thread scans its partition of the data set and keeps
+/// its k best rows. The per-thread results are then merged. With an index
+/// the query points are distributed to the threads. For the Euclidean distance
+/// and high dimensional data AUTO does not build a tree. Instead the batch
+/// predict multiplies blocks of query points with blocks of data points
+/// (see details::KnnBlockedSearch) which is much faster than scanning the data
+/// set for every point and returns exactly the same neighbors
 template<typename DataSetType, typename LabelType, typename Similarity, typename Actor>
 class ThreadedKnn
 {
-    
+
 public:
 
     /// \brief
@@ -34,7 +46,7 @@ public:
 
     /// \brief The return type
     typedef typename Actor::return_t return_t;
-        
+
     /// \brief Constructor
     ThreadedKnn(const KnnControl& control);
 
@@ -50,19 +62,54 @@ public:
     template<typename Executor, typename Options>
     std::pair<std::vector<return_t>, output_t> predict(const DataSetType& data, Executor& execuotor, const Options& options);
 
+    /// \brief Returns true if a search index has been built in train()
+    bool has_index()const{return !index_.empty();}
+
 private:
 
+     typedef DynVec<real_t> point_t;
+
      const KnnControl input_;
      const DataSetType* data_ptr_;
      const LabelType* labels_ptr_;
 
-     /// \brief Inner class that wraps the task to be executed
-     template<typename DataPoint>
+     /// \brief The search index built in train()
+     details::KnnSpatialIndex<Similarity> index_;
+
+     /// \brief The blocked search used by the batch predict when no index is built
+     details::KnnBlockedSearch<Similarity> blocked_;
+
+     /// \brief Inner class that computes the k nearest
+     /// rows of one partition of the data set
      struct Task;
 
+     /// \brief Inner class that predicts a range of
+     /// query points using the search index
+     struct QueryTask;
+
      /// \brief list of tasks
-     std::vector<std::unique_ptr<kernel::SimpleTaskBase<typename Actor::return_t>>> tasks_;
-       
+     std::vector<std::unique_ptr<Task>> tasks_;
+
+     /// \brief The merged neighbors of the partition tasks
+     std::vector<typename Actor::Pair> neighbors_;
+
+     /// \brief Scratch storage for merging the neighbors
+     std::vector<typename Actor::Pair> merge_buffer_;
+
+     /// \brief The policy used by the single point predict
+     Actor actor_;
+
+     /// \brief Check that the model can be used for prediction
+     void check_()const;
+
+     /// \brief Predict the given point using the partition tasks
+     template<typename Executor, typename Options>
+     return_t predict_point_(const point_t& point, Executor& executor, const Options& options);
+
+     /// \brief Predict the query points in the given range using
+     /// the index or the blocked search. This is called concurrently
+     void predict_range_(const DataSetType& data, kernel::range1d<uint_t> range,
+                         std::vector<return_t>& result)const;
 };
 
 template<typename DataSetType, typename LabelType, typename Similarity, typename Actor>
@@ -70,191 +117,302 @@ ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::ThreadedKnn(const KnnCon
     :
    input_(control),
    data_ptr_(nullptr),
-   labels_ptr_(nullptr)
+   labels_ptr_(nullptr),
+   index_(control.leaf_size),
+   blocked_(),
+   tasks_(),
+   neighbors_(),
+   merge_buffer_(),
+   actor_(control.k)
 {}
 
 
 template<typename DataSetType, typename LabelType, typename Similarity, typename Actor>
 void
 ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::train(const DataSetType& data_set, const LabelType& labels){
+
     data_ptr_ = &data_set;
     labels_ptr_ = &labels;
+    tasks_.clear();
+    index_.clear();
+    blocked_.clear();
+
+    bool use_index = input_.index_type != KnnIndexType::BRUTE_FORCE;
+
+    if constexpr(details::knn_blocked_metric_trait<Similarity>::is_supported){
+
+        // in high dimensions the trees prune little and
+        // the blocked search is the better choice
+        if(input_.index_type == KnnIndexType::AUTO &&
+           data_set.columns() > details::KnnSpatialIndex<Similarity>::MAX_KD_TREE_DIMENSION){
+            use_index = false;
+        }
+
+        if(!use_index){
+            blocked_.build(data_set);
+        }
+    }
+
+    if constexpr(details::knn_index_metric_trait<Similarity>::is_supported){
+
+        if(use_index){
+            index_.build(data_set, input_.index_type);
+        }
+    }
+}
+
+template<typename DataSetType, typename LabelType, typename Similarity, typename Actor>
+void
+ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::check_()const{
+
+    if(data_ptr_ == nullptr){
+        throw std::logic_error("Dataset pointer in null");
+    }
+
+    if(labels_ptr_ == nullptr){
+        throw std::logic_error("Labels pointer in null");
+    }
+
+    uint_t k = input_.k;
+    uint_t nrows = data_ptr_->rows();
+    uint_t labels_size = labels_ptr_->size();
+
+    if(labels_size != nrows){
+        throw std::logic_error("Labels size: " +
+                               std::to_string(labels_size) +
+                               " does not match dataset rows: " +
+                               std::to_string(nrows));
+    }
+
+    if(k == 0 || k>= nrows){
+        throw std::logic_error("Number of neighbors: "+std::to_string(k)+
+                               " not in [1,"+std::to_string(nrows)+")");
+    }
 }
 
 
 /// \brief Inner class definition
 template<typename DataSetType, typename LabelType, typename Similarity, typename Actor>
-template<typename DataPoint>
-struct 
-ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::Task: public kernel::SimpleTaskBase<typename Actor::return_t>
+struct
+ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::Task: public kernel::SimpleTaskBase<Null>
 {
 public:
 
    /// \brief Constructor
-   Task(uint_t id, uint_t k);
-
-   /// \brief Constructor
-   Task(uint_t id, uint_t k, const DataSetType& data,
-        const LabelType& labels, const DataPoint& point);
+   Task(uint_t id, uint_t k, const DataSetType& data);
 
    /// \brief Reset the point to work on
-   void reset_point(const DataPoint& point){point_ = &point;}
+   void reset_point(const point_t& point){point_ = &point;}
+
+   /// \brief The k best rows of the partition sorted in ascending distance
+   const std::vector<typename Actor::Pair>& neighbors()const{return top_k_.pairs();}
 
-   /// \brief Reset the DataSet and labels
-   void reset_data(const DataSetType& data,
-                   const LabelType& labels);
-                            
 protected:
-                
+
    /// \brief Implements the workings of the task
    virtual void run()override final;
 
    /// \brief Pointer to the input data matrix
    const DataSetType* data_;
 
-   /// \brief The query point
-   const LabelType* labels_;
-
    /// \brief The point to consider
-   const DataPoint* point_;
+   const point_t* point_;
 
-   /// \brief The object that implements the knn
-   /// algorithm classification or regression.
-   Actor actor_;
+   /// \brief The k best rows found by this task
+   details::KnnTopK top_k_;
 
-   /// \brief Pointer to the similarity object
+   /// \brief The similarity object
    Similarity sim_;
 
 };
 
 
-template<typename DataSetType, typename LabelType,
-         typename Similarity, typename Actor>
-template<typename DataPoint>
-ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::Task<DataPoint>::Task(uint_t id, uint_t k)
+template<typename DataSetType, typename LabelType, typename Similarity, typename Actor>
+ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::Task::Task(uint_t id, uint_t k, const DataSetType& data)
  :
-kernel::SimpleTaskBase<typename Actor::return_t>(id),
-data_(nullptr),
-labels_(nullptr),
+kernel::SimpleTaskBase<Null>(id),
+data_(&data),
 point_(nullptr),
-actor_(k),
+top_k_(k),
 sim_()
 {}
 
-template<typename DataSetType, typename LabelType,
-         typename Similarity, typename Actor>
-template<typename DataPoint>
-ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::Task<DataPoint>::Task(uint_t id, uint_t k, const DataSetType& data,
-                                                                              const LabelType& labels, const DataPoint& point)
- :
+template<typename DataSetType, typename LabelType, typename Similarity, typename Actor>
+void
+ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::Task::run(){
+
+    top_k_.clear();
+    auto range = data_->get_partition(this->get_id());
+
+    for(uint_t r=range.begin(); r<range.end(); ++r){
+        const auto row = kernel::matrix_row_trait<DataSetType>::get_row_view(*data_, r);
+        top_k_.push(r, sim_(row, *point_));
+    }
+
+    // sort here so that the results of
+    // the tasks can be merged in O(k)
+    top_k_.sort();
+    this->result_.validate_result();
+}
+
+/// \brief Inner class definition
+template<typename DataSetType, typename LabelType, typename Similarity, typename Actor>
+struct
+ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::QueryTask: public kernel::SimpleTaskBase<Null>
+{
+public:
+
+   /// \brief Constructor
+   QueryTask(uint_t id, const ThreadedKnn& knn, const DataSetType& queries,
+             kernel::range1d<uint_t> range, std::vector<return_t>& result);
+
+protected:
+
+   /// \brief Implements the workings of the task
+   virtual void run()override final;
+
+   const ThreadedKnn* knn_;
+   const DataSetType* queries_;
+   kernel::range1d<uint_t> range_;
+   std::vector<return_t>* predictions_;
+};
+
+template<typename DataSetType, typename LabelType, typename Similarity, typename Actor>
+ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::QueryTask::QueryTask(uint_t id, const ThreadedKnn& knn,
+                                                                             const DataSetType& queries,
+                                                                             kernel::range1d<uint_t> range,
+                                                                             std::vector<return_t>& result)
+    :
 kernel::SimpleTaskBase<Null>(id),
-data_(&data),
-labels_(&labels),
-point_(&point),
-actor_(k),
-sim_()
+knn_(&knn),
+queries_(&queries),
+range_(range),
+predictions_(&result)
 {}
 
-
 template<typename DataSetType, typename LabelType, typename Similarity, typename Actor>
-template<typename DataPoint>
 void
-ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::Task<DataPoint>::reset_data(const DataSetType& data,
-                                                                                     const LabelType& labels){
+ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::QueryTask::run(){
 
-   data_ = &data;
-   labels_ = &labels;
+    knn_->predict_range_(*queries_, range_, *predictions_);
+    this->result_.validate_result();
 }
 
 template<typename DataSetType, typename LabelType, typename Similarity, typename Actor>
-template<typename DataPoint>
 void
-ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::Task<DataPoint>::run(){
-    
-    actor_.resume();
-    auto& range = data_->get_partition(this->get_id());
-    actor_(*data_, *labels_, *point_, sim_, range);
+ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::predict_range_(const DataSetType& data,
+                                                                       kernel::range1d<uint_t> range,
+                                                                       std::vector<return_t>& result)const{
 
-    //get the result
-    auto rslt = actor_.get_result();
+    Actor actor(input_.k);
+    std::vector<typename Actor::Pair> neighbors;
 
-    // set the result for this task
-    this->result_.get_resource() = rslt;
-    this->result_.validate_result();
-}
+    if(!index_.empty()){
 
+        details::KnnTopK top_k(input_.k);
 
+        for(uint_t r=range.begin(); r<range.end(); ++r){
 
-template<typename DataSetType, typename LabelType, typename Similarity, typename Actor>
-template<typename DataPoint, typename Executor, typename Options>
-std::pair<typename ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::return_t,
-          typename ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::output_t>
-ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::predict(const DataPoint& point,
-                                                                Executor& executor, const Options& options){
-    
-    std::chrono::time_point<std::chrono::system_clock> start, end;
-    start = std::chrono::system_clock::now();
+            auto point = kernel::matrix_row_trait<DataSetType>::get_row(data, r);
 
-    if(data_ptr_ == nullptr){
-        throw std::logic_error("Dataset pointer in null");
-    }
+            top_k.clear();
+            index_.query(point, top_k);
+            top_k.sorted(neighbors);
 
-    if(labels_ptr_ == nullptr){
-        throw std::logic_error("Labels pointer in null");
-    }
-    
-    uint_t k = input_.k;
-    uint_t nrows = data_ptr_->rows();
-    uint_t labels_size = labels_ptr_->size();
+            actor.resume();
+            actor.fillin_majority_vote(*labels_ptr_, neighbors);
+            result[r] = actor.get_result();
+        }
 
-    if(labels_size != nrows){
-        throw std::logic_error("Labels size: " +
-                               std::to_string(labels_size) +
-                               " does not match dataset rows: " +
-                               std::to_string(nrows));
+        return;
     }
 
-    if(k == 0 || k>= nrows){
-        throw std::logic_error("Number of neighbors: "+std::to_string(k)+
-                               " not in [1,"+std::to_string(nrows)+")");
+    if constexpr(details::knn_blocked_metric_trait<Similarity>::is_supported){
+
+        blocked_.query(data, range, input_.k, [this, &actor, &result](uint_t r, std::vector<typename Actor::Pair>& pairs){
+            actor.resume();
+            actor.fillin_majority_vote(*labels_ptr_, pairs);
+            result[r] = actor.get_result();
+        });
     }
+}
 
-    KnnInfo info;
-    info.n_neighbors = k;
-    info.n_pts_predicted = 1;
-    info.nprocs = 1;
-    info.nthreads = executor.get_n_threads();
+template<typename DataSetType, typename LabelType, typename Similarity, typename Actor>
+template<typename Executor, typename Options>
+typename ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::return_t
+ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::predict_point_(const point_t& point,
+                                                                       Executor& executor, const Options& options){
 
-    typedef ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::Task<DataPoint> task_t;
+    if(!index_.empty()){
+
+        details::KnnTopK top_k(input_.k);
+        index_.query(point, top_k);
+        top_k.sorted(neighbors_);
+    }
+    else{
 
-    if(tasks_.empty()){
+        if(tasks_.size() != executor.get_n_threads()){
 
-        // we don't have tasks so we create them
-        tasks_.reserve(executor.get_n_threads());
+            // we don't have tasks so we create them
+            tasks_.clear();
+            tasks_.reserve(executor.get_n_threads());
 
-        for(uint_t t=0; t<executor.get_n_threads(); ++t){
-            tasks_.push_back(std::make_unique<task_t>(t, k, *data_ptr_, *labels_ptr_, point));
+            for(uint_t t=0; t<executor.get_n_threads(); ++t){
+                tasks_.push_back(std::make_unique<Task>(t, input_.k, *data_ptr_));
+            }
         }
 
-    }
-    else{
+        for(auto& task : tasks_){
+            task->reset_point(point);
+            task->reschedule();
+        }
+
+        // this should block
+        executor.execute(tasks_, options);
 
-        for(uint_t t=0; t<executor.get_n_threads(); ++t){
-            dynamic_cast<task_t*>(tasks_[t].get())->reset_point(point);
+        // now reduce the result. Every task holds at most
+        // k sorted rows so every merge takes O(k)
+        neighbors_.clear();
+        for(const auto& task : tasks_){
+            details::merge_top_k(neighbors_, task->neighbors(), input_.k, merge_buffer_);
+            neighbors_.swap(merge_buffer_);
         }
     }
 
-    // this should block
-    executor.execute(tasks_, options);
+    actor_.resume();
+    actor_.fillin_majority_vote(*labels_ptr_, neighbors_);
+    return actor_.get_result();
+}
+
+template<typename DataSetType, typename LabelType, typename Similarity, typename Actor>
+template<typename DataPoint, typename Executor, typename Options>
+std::pair<typename ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::return_t,
+          typename ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::output_t>
+ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::predict(const DataPoint& point,
+                                                                Executor& executor, const Options& options){
+
+    std::chrono::time_point<std::chrono::system_clock> start, end;
+    start = std::chrono::system_clock::now();
 
-    // now reduce the result
+    check_();
+
+    KnnInfo info;
+    info.n_neighbors = input_.k;
+    info.n_pts_predicted = 1;
+    info.nprocs = 1;
+    info.nthreads = executor.get_n_threads();
+
+    point_t query(point.size());
+    for(uint_t c=0; c<point.size(); ++c){
+        query[c] = point[c];
+    }
+
+    auto result = predict_point_(query, executor, options);
 
     end = std::chrono::system_clock::now();
     info.runtime = end-start;
 
-    typename ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::return_t result;
     return {result, info};
-      
 }
 
 template<typename DataSetType, typename LabelType, typename Similarity, typename Actor>
@@ -266,76 +424,49 @@ ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::predict(const DataSetTyp
     std::chrono::time_point<std::chrono::system_clock> start, end;
     start = std::chrono::system_clock::now();
 
-    if(data_ptr_ == nullptr){
-        throw std::logic_error("Dataset pointer in null");
-    }
-
-    if(labels_ptr_ == nullptr){
-        throw std::logic_error("Labels pointer in null");
-    }
-
-    uint_t k = input_.k;
-    uint_t nrows = data_ptr_->rows();
-    uint_t labels_size = labels_ptr_->size();
-
-    if(labels_size != nrows){
-        throw std::logic_error("Labels size: " +
-                               std::to_string(labels_size) +
-                               " does not match dataset rows: " +
-                               std::to_string(nrows));
-    }
-
-    if(k == 0 || k>= nrows){
-        throw std::logic_error("Number of neighbors: "+std::to_string(k)+
-                               " not in [1,"+std::to_string(nrows)+")");
-    }
+    check_();
 
     KnnInfo info;
-    info.n_neighbors = k;
-    info.n_pts_predicted = 1;
+    info.n_neighbors = input_.k;
+    info.n_pts_predicted = data.rows();
     info.nprocs = 1;
     info.nthreads = executor.get_n_threads();
 
-    typedef typename kernel::matrix_row_trait<DataSetType>::row_t row_t;
-    typedef ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::Task<row_t> task_t;
+    std::vector<return_t> result(data.rows());
 
-    if(tasks_.empty()){
+    if(!index_.empty() || !blocked_.empty()){
 
-        // we don't have tasks so we create them
-        tasks_.reserve(executor.get_n_threads());
+        // the index and the blocked search are read-only during
+        // the queries so every thread predicts its own range of points
+        std::vector<kernel::range1d<uint_t>> ranges;
+        kernel::partition_range(static_cast<uint_t>(0), static_cast<uint_t>(data.rows()),
+                                ranges, executor.get_n_threads());
 
-        for(uint_t t=0; t<executor.get_n_threads(); ++t){
-            tasks_.push_back(std::make_unique<task_t>(t, k));
-        }
+        std::vector<std::unique_ptr<QueryTask>> tasks;
+        tasks.reserve(ranges.size());
 
-    }
+        for(uint_t t=0; t<ranges.size(); ++t){
+            tasks.push_back(std::make_unique<QueryTask>(t, *this, data, ranges[t], result));
+        }
 
-    for(uint_t t=0; t<executor.get_n_threads(); ++t){
-        dynamic_cast<task_t*>(tasks_[t].get())->reset_data(*data_ptr_, *labels_ptr_);
+        executor.execute(tasks, options);
     }
+    else{
 
-    std::vector<typename ThreadedKnn<DataSetType, LabelType, Similarity, Actor>::return_t> result(data.rows());
-    for(uint_t r=0; r<data.rows(); ++r){
-
-        auto point = kernel::matrix_row_trait<DataSetType>::get_row(data, r);
-
-        for(uint_t t=0; t<executor.get_n_threads(); ++t){
-            dynamic_cast<task_t*>(tasks_[t].get())->reset_point(point);
+        for(uint_t r=0; r<data.rows(); ++r){
+            auto point = kernel::matrix_row_trait<DataSetType>::get_row(data, r);
+            result[r] = predict_point_(point, executor, options);
         }
-
-        // this should block
-        executor.execute(tasks_, options);
-
-        //collect the results from this point
     }
 
+    end = std::chrono::system_clock::now();
+    info.runtime = end-start;
+
     return {std::move(result), info};
 
 }
-    
-}
-
 
+}
+}
 
-#endif	/* CPUT_C11_KNN_H */
-
+#endif	/* THREADED_KNN_H */
@@ -3,6 +3,7 @@
 
 #include "cubic_engine/ml/loss_functions/model_evaluator_base.h"
 #include "cubic_engine/ml/loss_functions/mse_loss.h" // for calculating gradients
+#include "cubic_engine/ml/loss_functions/details/batch_gradient_kernels.h"
 #include "kernel/base/kernel_consts.h"
 #include <cmath>
 
@@ -52,7 +53,14 @@ public:
     ///
     /// \brief
     ///
-    virtual real_t error_at(const row_t& p, const label_value_t& val)const override final;
+    virtual real_t error_at(const row_t& p, const label_value_t& val)const override final
+    {return error_at<row_t>(p, val);}
+
+    ///
+    /// \brief error_at. Overload for points of other vector types e.g. DynVec
+    ///
+    template<typename VecTp>
+    real_t error_at(const VecTp& p, const label_value_t& val)const;
 
     ///
     /// \brief params_gradients. Compute the parameter gradients of the
@@ -63,7 +71,30 @@ public:
     ///
     /// \brief param_gradient_at
     ///
-    virtual DynVec<real_t> param_gradient_at(const row_t& p, const label_value_t& label)const override final;
+    virtual DynVec<real_t> param_gradient_at(const row_t& p, const label_value_t& label)const override final
+    {return param_gradient_at<row_t>(p, label);}
+
+    ///
+    /// \brief param_gradient_at. Overload for points of other vector types
+    ///
+    template<typename VecTp>
+    DynVec<real_t> param_gradient_at(const VecTp& p, const label_value_t& label)const;
+
+    ///
+    /// \brief batch_gradients. Compute the loss on the rows [begin, end) of the
+    /// dataset and its gradients. Returns the loss. For a sigmoid of a linear
+    /// model the predictions are one matrix-vector product and the gradients
+    /// are X^T(h - y)/n. Other models use the MSE gradients as params_gradients
+    ///
+    real_t batch_gradients(const DatasetTp& dataset, uint_t begin, uint_t end, DynVec<real_t>& gradients)const;
+
+    ///
+    /// \brief batch_gradients. As above but the rows are partitioned
+    /// among the threads of the given executor
+    ///
+    template<typename Executor, typename Options>
+    real_t batch_gradients(const DatasetTp& dataset, uint_t begin, uint_t end, DynVec<real_t>& gradients,
+                           Executor& executor, const Options& options)const;
 
 
 private:
@@ -80,6 +111,12 @@ private:
     ///
     real_t two_class_error_value_(const DatasetTp& dataset)const;
 
+    ///
+    /// \brief The contribution of a point with the given
+    /// prediction and label. See error_at
+    ///
+    static real_t point_error_(real_t prediction, const label_value_t& label);
+
 };
 
 template<typename Model, typename DatasetTp>
@@ -151,11 +188,28 @@ CategoricalCrossEntropy<Model, DatasetTp>::params_gradients(const DatasetTp& dat
 }
 
 template<typename Model, typename DatasetTp>
+template<typename VecTp>
 real_t
-CategoricalCrossEntropy<Model, DatasetTp>::error_at(const row_t& p, const label_value_t& label)const{
+CategoricalCrossEntropy<Model, DatasetTp>::error_at(const VecTp& p, const label_value_t& label)const{
+
+    return point_error_(this->model_ref_().value_at(p), label);
+}
+
+template<typename Model, typename DatasetTp>
+template<typename VecTp>
+DynVec<real_t>
+CategoricalCrossEntropy<Model, DatasetTp>::param_gradient_at(const VecTp& p, const label_value_t& label)const{
+
+    MSELoss<Model, DatasetTp> mse_loss(const_cast<Model&>(this->model_ref_()));
+    return mse_loss.param_gradient_at(p, label);
+
+}
+
+template<typename Model, typename DatasetTp>
+real_t
+CategoricalCrossEntropy<Model, DatasetTp>::point_error_(real_t prediction, const label_value_t& label){
 
     auto result = 0.0;
-    auto prediction = this->model_ref_().value_at(p);
 
     //h is close to one
     if(std::fabs(1 - prediction) < kernel::KernelConsts::tolerance()){
@@ -187,12 +241,105 @@ CategoricalCrossEntropy<Model, DatasetTp>::error_at(const row_t& p, const label_
 }
 
 template<typename Model, typename DatasetTp>
-DynVec<real_t>
-CategoricalCrossEntropy<Model, DatasetTp>::param_gradient_at(const row_t& p, const label_value_t& label)const{
+real_t
+CategoricalCrossEntropy<Model, DatasetTp>::batch_gradients(const DatasetTp& dataset, uint_t begin, uint_t end,
+                                                           DynVec<real_t>& gradients)const{
 
-    MSELoss<Model, DatasetTp> mse_loss(const_cast<Model&>(this->model_ref_()));
-    return mse_loss.param_gradient_at(p, label);
+    details::check_batch_range(begin, end, dataset.n_examples());
+    const auto& model = this->model_ref_();
+
+    if(begin == end){
+        gradients = DynVec<real_t>(model.n_coeffs(), 0.0);
+        return 0.0;
+    }
+
+    if constexpr(details::has_batch_link<Model>(details::BatchLinkType::SIGMOID)){
+
+        if constexpr(!details::has_feature_matrix<DatasetTp>::value){
+
+            // the gradient of the cross entropy of the
+            // sigmoid of g is (h - y)dg/dw for every row
+            gradients = DynVec<real_t>(model.n_coeffs(), 0.0);
+
+            real_t result = 0.0;
+            for(uint_t i=begin; i<end; ++i){
+
+                auto [row, label] = dataset[i];
+                const auto prediction = model.value_at(row);
+                const auto function_grads = model.function().param_grads_at(row);
+
+                for(uint_t coeff=0; coeff<gradients.size(); ++coeff){
+                    gradients[coeff] += (prediction - label)*function_grads[coeff];
+                }
+
+                result += point_error_(prediction, label);
+            }
+
+            gradients /= static_cast<real_t>(end - begin);
+            return -result / (end - begin);
+        }
+        else{
+
+            if(!details::batch_model_trait<Model>::is_linear(model)){
+                throw std::logic_error("The batched cross entropy requires a sigmoid of a linear model");
+            }
+
+            DynVec<real_t> residuals;
+            details::block_residuals(dataset, model.coeffs(), details::BatchLinkType::SIGMOID, begin, end, residuals);
+            details::block_gradients(dataset, residuals, begin, end, gradients);
+            gradients /= static_cast<real_t>(end - begin);
+
+            const auto& labels = dataset.labels();
+
+            real_t result = 0.0;
+            for(uint_t r=0; r<residuals.size(); ++r){
+                const auto label = labels[begin + r];
+                result += point_error_(residuals[r] + label, label);
+            }
+
+            return -result / (end - begin);
+        }
+    }
+    else{
+
+        MSELoss<Model, DatasetTp> mse_loss(const_cast<Model&>(model));
+        mse_loss.batch_gradients(dataset, begin, end, gradients);
+
+        real_t result = 0.0;
+        for(uint_t i=begin; i<end; ++i){
+            auto [row, label] = dataset[i];
+            result += error_at(row, label);
+        }
+
+        return -result / (end - begin);
+    }
+}
+
+template<typename Model, typename DatasetTp>
+template<typename Executor, typename Options>
+real_t
+CategoricalCrossEntropy<Model, DatasetTp>::batch_gradients(const DatasetTp& dataset, uint_t begin, uint_t end,
+                                                           DynVec<real_t>& gradients,
+                                                           Executor& executor, const Options& options)const{
+
+    details::check_batch_range(begin, end, dataset.n_examples());
+
+    // the partitions return means so scale
+    // them back to sums before adding them up
+    auto block_fn = [this, &dataset](uint_t b, uint_t e, DynVec<real_t>& grads){
+        auto result = this->batch_gradients(dataset, b, e, grads);
+        grads *= static_cast<real_t>(e - b);
+        return result*(e - b);
+    };
+
+    auto result = details::threaded_batch_gradients(this->n_parameters(), begin, end, block_fn, gradients, executor, options);
+
+    if(begin == end){
+        return result;
+    }
 
+    gradients /= static_cast<real_t>(end - begin);
+    return result / (end - begin);
 }
 
 }
@@ -0,0 +1,243 @@
+#ifndef BATCH_GRADIENT_KERNELS_H
+#define BATCH_GRADIENT_KERNELS_H
+
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "kernel/maths/functions/real_vector_polynomial.h"
+#include "kernel/maths/functions/sigmoid_function.h"
+#include "kernel/parallel/threading/simple_task.h"
+#include "kernel/parallel/utilities/array_partitioner.h"
+#include "kernel/utilities/range_1d.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <type_traits>
+
+namespace cengine{
+namespace ml{
+namespace details{
+
+///
+/// \brief The link applied to the linear predictions Xw of a block
+///
+enum class BatchLinkType{IDENTITY, SIGMOID};
+
+///
+/// \brief batch_model_trait. Tells the losses whether the value of a model
+/// at a row x can be computed as link(w^T x) so that the predictions of a
+/// block of rows are one matrix-vector product. Models without a
+/// specialization use the row by row path
+///
+template<typename Model>
+struct batch_model_trait
+{
+    static constexpr bool is_supported = false;
+};
+
+template<>
+struct batch_model_trait<kernel::PolynomialFunction>
+{
+    static constexpr bool is_supported = true;
+    static constexpr BatchLinkType link = BatchLinkType::IDENTITY;
+
+    /// \brief Only polynomials of order one are linear in the features
+    static bool is_linear(const kernel::PolynomialFunction& model){return model.is_linear();}
+};
+
+template<>
+struct batch_model_trait<kernel::SigmoidFunction<kernel::PolynomialFunction>>
+{
+    static constexpr bool is_supported = true;
+    static constexpr BatchLinkType link = BatchLinkType::SIGMOID;
+
+    /// \brief The wrapped polynomial should be of order one
+    static bool is_linear(const kernel::SigmoidFunction<kernel::PolynomialFunction>& model){return model.function().is_linear();}
+};
+
+///
+/// \brief Returns true if the model is supported by
+/// batch_model_trait with the given link
+///
+template<typename Model>
+constexpr bool
+has_batch_link(BatchLinkType link){
+
+    if constexpr(batch_model_trait<Model>::is_supported){
+        return batch_model_trait<Model>::link == link;
+    }
+    else{
+        return false;
+    }
+}
+
+///
+/// \brief has_feature_matrix. True if the dataset holds its features in memory
+/// and exposes them with feature_matrix() and its labels with labels() so that
+/// a block of rows can be multiplied at once. Datasets without it e.g.
+/// StreamingRegressionDataset use the row by row path of the losses
+///
+template<typename DatasetTp, typename = void>
+struct has_feature_matrix: std::false_type
+{};
+
+template<typename DatasetTp>
+struct has_feature_matrix<DatasetTp, std::void_t<decltype(std::declval<const DatasetTp&>().feature_matrix()),
+                                                 decltype(std::declval<const DatasetTp&>().labels())>>: std::true_type
+{};
+
+///
+/// \brief Returns true if the losses can compute the gradients of the rows
+/// of the dataset with matrix-vector products for the given model and link
+///
+template<typename Model, typename DatasetTp>
+constexpr bool
+has_block_path(BatchLinkType link){
+    return has_feature_matrix<DatasetTp>::value && has_batch_link<Model>(link);
+}
+
+///
+/// \brief Compute the residuals link(X_b w) - y_b of the rows [begin, end)
+/// where X_b is the block of the feature matrix. The predictions are one
+/// matrix-vector product. DatasetTp should expose a row major blaze
+/// feature_matrix() and labels() e.g. BlazeRegressionDataset
+///
+template<typename DatasetTp>
+void
+block_residuals(const DatasetTp& dataset, const DynVec<real_t>& weights,
+                BatchLinkType link, uint_t begin, uint_t end, DynVec<real_t>& residuals){
+
+    if(weights.size() != dataset.n_features()){
+        throw std::logic_error("Number of coefficients: " + std::to_string(weights.size()) +
+                               " not equal to number of features: " + std::to_string(dataset.n_features()));
+    }
+
+    const auto block = blaze::submatrix(dataset.feature_matrix(), begin, 0, end - begin, dataset.n_features());
+    residuals = block*weights;
+
+    if(link == BatchLinkType::SIGMOID){
+        for(uint_t r=0; r<residuals.size(); ++r){
+            residuals[r] = 1.0/(1.0 + std::exp(-residuals[r]));
+        }
+    }
+
+    const auto& labels = dataset.labels();
+    for(uint_t r=0; r<residuals.size(); ++r){
+        residuals[r] -= labels[begin + r];
+    }
+}
+
+///
+/// \brief Compute X_b^T r for the rows [begin, end). The residuals
+/// r are the ones computed by block_residuals for the same rows
+///
+template<typename DatasetTp>
+void
+block_gradients(const DatasetTp& dataset, const DynVec<real_t>& residuals,
+                uint_t begin, uint_t end, DynVec<real_t>& gradients){
+
+    const auto block = blaze::submatrix(dataset.feature_matrix(), begin, 0, end - begin, dataset.n_features());
+    gradients = blaze::trans(block)*residuals;
+}
+
+///
+/// \brief The BatchGradientTask class. Computes the loss and the
+/// gradients of a partition of the rows of a batch
+///
+template<typename BlockFnTp>
+class BatchGradientTask: public kernel::SimpleTaskBase<Null>
+{
+public:
+
+    /// \brief Constructor
+    BatchGradientTask(uint_t id, const BlockFnTp& block_fn, kernel::range1d<uint_t> range)
+        :
+        kernel::SimpleTaskBase<Null>(id),
+        block_fn_(&block_fn),
+        range_(range),
+        value_(0.0),
+        gradients_()
+    {}
+
+    /// \brief The loss computed by the task
+    real_t value()const{return value_;}
+
+    /// \brief The gradients computed by the task
+    const DynVec<real_t>& gradients()const{return gradients_;}
+
+protected:
+
+    /// \brief Implements the workings of the task
+    virtual void run()override final{
+        value_ = (*block_fn_)(range_.begin(), range_.end(), gradients_);
+        this->result_.validate_result();
+    }
+
+    const BlockFnTp* block_fn_;
+    kernel::range1d<uint_t> range_;
+    real_t value_;
+    DynVec<real_t> gradients_;
+};
+
+///
+/// \brief Throw std::logic_error if [begin, end) is not a range of rows of the dataset
+///
+inline
+void
+check_batch_range(uint_t begin, uint_t end, uint_t n_examples){
+
+    if(begin > end || end > n_examples){
+        throw std::logic_error("Invalid batch range: [" + std::to_string(begin) + ", " +
+                               std::to_string(end) + ") for " + std::to_string(n_examples) + " examples");
+    }
+}
+
+///
+/// \brief Partition the rows [begin, end) into one range per thread of the executor,
+/// call block_fn(b, e, gradients) on every range concurrently and add up the returned
+/// losses and the gradients. The block function should only read shared state
+///
+template<typename BlockFnTp, typename Executor, typename Options>
+real_t
+threaded_batch_gradients(uint_t n_params, uint_t begin, uint_t end, const BlockFnTp& block_fn,
+                         DynVec<real_t>& gradients, Executor& executor, const Options& options){
+
+    gradients = DynVec<real_t>(n_params, 0.0);
+
+    if(begin == end){
+        return 0.0;
+    }
+
+    std::vector<kernel::range1d<uint_t>> ranges;
+    kernel::partition_range(begin, end, ranges, std::min(executor.get_n_threads(), end - begin));
+
+    std::vector<std::unique_ptr<BatchGradientTask<BlockFnTp>>> tasks;
+    tasks.reserve(ranges.size());
+
+    for(uint_t t=0; t<ranges.size(); ++t){
+        tasks.push_back(std::make_unique<BatchGradientTask<BlockFnTp>>(t, block_fn, ranges[t]));
+    }
+
+    executor.execute(tasks, options);
+
+    real_t result = 0.0;
+    for(const auto& task : tasks){
+
+        if(!task->get_result().is_result_valid()){
+            throw std::logic_error("Batch gradient task: " + std::to_string(task->get_id()) + " did not finish");
+        }
+
+        result += task->value();
+        gradients += task->gradients();
+    }
+
+    return result;
+}
+
+}
+}
+}
+
+#endif // BATCH_GRADIENT_KERNELS_H
@@ -48,6 +48,12 @@ public:
     ///
     virtual real_t error_at(const row_t& p, const label_value_t& val)const override final{return sse_loss_.error_at(p, val);};
 
+    ///
+    /// \brief error_at. Overload for points of other vector types e.g. DynVec
+    ///
+    template<typename VecTp>
+    real_t error_at(const VecTp& p, const label_value_t& val)const{return sse_loss_.error_at(p, val);}
+
     ///
     /// \brief params_gradients. Compute the parameter gradients of the
     /// error metric on the given dataset
@@ -62,6 +68,26 @@ public:
     ///
     virtual DynVec<real_t> param_gradient_at(const row_t& p, const label_value_t& label)const override final{return sse_loss_.param_gradient_at(p, label);}
 
+    ///
+    /// \brief param_gradient_at. Overload for points of other vector types
+    ///
+    template<typename VecTp>
+    DynVec<real_t> param_gradient_at(const VecTp& p, const label_value_t& label)const{return sse_loss_.param_gradient_at(p, label);}
+
+    ///
+    /// \brief batch_gradients. Compute the MSE on the rows [begin, end)
+    /// of the dataset and its gradients. Returns the MSE. See SSELoss::batch_gradients
+    ///
+    real_t batch_gradients(const DatasetTp& dataset, uint_t begin, uint_t end, DynVec<real_t>& gradients)const;
+
+    ///
+    /// \brief batch_gradients. As above but the rows are partitioned
+    /// among the threads of the given executor
+    ///
+    template<typename Executor, typename Options>
+    real_t batch_gradients(const DatasetTp& dataset, uint_t begin, uint_t end, DynVec<real_t>& gradients,
+                           Executor& executor, const Options& options)const;
+
 private:
 
     SSELoss<model_t, dataset_t> sse_loss_;
@@ -89,6 +115,38 @@ MSELoss<Model, DatasetTp>::params_gradients(const DatasetTp& dataset)const{
     return sse_loss_.params_gradients(dataset) / dataset.n_examples();
 }
 
+template<typename Model, typename DatasetTp>
+real_t
+MSELoss<Model, DatasetTp>::batch_gradients(const DatasetTp& dataset, uint_t begin, uint_t end,
+                                           DynVec<real_t>& gradients)const{
+
+    auto result = sse_loss_.batch_gradients(dataset, begin, end, gradients);
+
+    if(begin == end){
+        return result;
+    }
+
+    gradients /= static_cast<real_t>(end - begin);
+    return result / (end - begin);
+}
+
+template<typename Model, typename DatasetTp>
+template<typename Executor, typename Options>
+real_t
+MSELoss<Model, DatasetTp>::batch_gradients(const DatasetTp& dataset, uint_t begin, uint_t end,
+                                           DynVec<real_t>& gradients,
+                                           Executor& executor, const Options& options)const{
+
+    auto result = sse_loss_.batch_gradients(dataset, begin, end, gradients, executor, options);
+
+    if(begin == end){
+        return result;
+    }
+
+    gradients /= static_cast<real_t>(end - begin);
+    return result / (end - begin);
+}
+
 }
 
 }
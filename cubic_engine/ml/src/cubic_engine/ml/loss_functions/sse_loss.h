@@ -3,6 +3,7 @@
 
 #include "cubic_engine/ml/loss_functions/model_evaluator_base.h"
 #include "cubic_engine/ml/loss_functions/squared_sum.h"
+#include "cubic_engine/ml/loss_functions/details/batch_gradient_kernels.h"
 #include "kernel/maths/functions/dummy_function.h"
 
 namespace cengine{
@@ -47,7 +48,14 @@ public:
     ///
     /// \brief
     ///
-    virtual real_t error_at(const row_t& p, const label_value_t& val)const override final;
+    virtual real_t error_at(const row_t& p, const label_value_t& val)const override final
+    {return error_at<row_t>(p, val);}
+
+    ///
+    /// \brief error_at. Overload for points of other vector types e.g. DynVec
+    ///
+    template<typename VecTp>
+    real_t error_at(const VecTp& p, const label_value_t& val)const;
 
     ///
     /// \brief params_gradients. Compute the parameter gradients of the
@@ -61,7 +69,34 @@ public:
     /// \param label
     /// \return
     ///
-    virtual DynVec<real_t> param_gradient_at(const row_t& p, const label_value_t& label)const override final;
+    virtual DynVec<real_t> param_gradient_at(const row_t& p, const label_value_t& label)const override final
+    {return param_gradient_at<row_t>(p, label);}
+
+    ///
+    /// \brief param_gradient_at. Overload for points of other vector types
+    ///
+    template<typename VecTp>
+    DynVec<real_t> param_gradient_at(const VecTp& p, const label_value_t& label)const;
+
+    ///
+    /// \brief batch_gradients. Compute the SSE on the rows [begin, end) of the
+    /// dataset and its gradients 2X^T(Xw - y). Returns the SSE. The gradients
+    /// are the sum of param_gradient_at() over the rows, not the mean. When the
+    /// model is linear (see details::batch_model_trait) and the dataset exposes
+    /// a feature_matrix() the predictions and the gradients of the rows are two
+    /// matrix-vector products. Otherwise the terms -2(y - f(x))df/dw are added
+    /// up row by row
+    ///
+    real_t batch_gradients(const DatasetTp& dataset, uint_t begin, uint_t end, DynVec<real_t>& gradients)const;
+
+    ///
+    /// \brief batch_gradients. As above but the rows are partitioned
+    /// among the threads of the given executor. The dataset is read
+    /// concurrently so it should support concurrent reads
+    ///
+    template<typename Executor, typename Options>
+    real_t batch_gradients(const DatasetTp& dataset, uint_t begin, uint_t end, DynVec<real_t>& gradients,
+                           Executor& executor, const Options& options)const;
 
 };
 
@@ -88,8 +123,9 @@ SSELoss<Model, DatasetTp, RegularizerFn>::evaluate(const DatasetTp& dataset)cons
 }
 
 template<typename Model, typename DatasetTp, typename RegularizerFn>
+template<typename VecTp>
 real_t
-SSELoss<Model, DatasetTp, RegularizerFn>::error_at(const row_t& p, const label_value_t& val)const{
+SSELoss<Model, DatasetTp, RegularizerFn>::error_at(const VecTp& p, const label_value_t& val)const{
 
     auto model_val = this->model_ref_().value_at(p);
     return (val - model_val)*(val - model_val);
@@ -111,21 +147,77 @@ SSELoss<Model, DatasetTp, RegularizerFn>::params_gradients(const DatasetTp& data
 }
 
 template<typename Model, typename DatasetTp, typename RegularizerFn>
+template<typename VecTp>
 DynVec<real_t>
-SSELoss<Model, DatasetTp, RegularizerFn>::param_gradient_at(const row_t& p, const label_value_t& label)const{
+SSELoss<Model, DatasetTp, RegularizerFn>::param_gradient_at(const VecTp& p, const label_value_t& label)const{
 
     DynVec<real_t> grad(this->model_ref_().n_coeffs(), 0.0);
 
-    auto errorat = error_at(p, label);
+    // d(y - f)^2/dw = -2(y - f)df/dw
+    auto residual = label - this->model_ref_().value_at(p);
     auto model_grads = this->model_ref_().param_grads_at(p);
 
     for(int coeff=0; coeff<this->model_ref_().n_coeffs(); ++coeff){
-         grad[coeff] = -2.0*errorat*model_grads[coeff];
+         grad[coeff] = -2.0*residual*model_grads[coeff];
     }
 
     return grad;
 }
 
+template<typename Model, typename DatasetTp, typename RegularizerFn>
+real_t
+SSELoss<Model, DatasetTp, RegularizerFn>::batch_gradients(const DatasetTp& dataset, uint_t begin, uint_t end,
+                                                          DynVec<real_t>& gradients)const{
+
+    details::check_batch_range(begin, end, dataset.n_examples());
+    const auto& model = this->model_ref_();
+
+    if constexpr(details::has_block_path<Model, DatasetTp>(details::BatchLinkType::IDENTITY)){
+
+        if(details::batch_model_trait<Model>::is_linear(model)){
+
+            DynVec<real_t> residuals;
+            details::block_residuals(dataset, model.coeffs(), details::BatchLinkType::IDENTITY, begin, end, residuals);
+            details::block_gradients(dataset, residuals, begin, end, gradients);
+            gradients *= 2.0;
+            return blaze::sqrNorm(residuals);
+        }
+    }
+
+    gradients = DynVec<real_t>(model.n_coeffs(), 0.0);
+
+    real_t result = 0.0;
+    for(uint_t i=begin; i<end; ++i){
+
+        auto [row, label] = dataset[i];
+        const auto error = label - model.value_at(row);
+        const auto model_grads = model.param_grads_at(row);
+
+        for(uint_t coeff=0; coeff<gradients.size(); ++coeff){
+            gradients[coeff] += -2.0*error*model_grads[coeff];
+        }
+
+        result += error*error;
+    }
+
+    return result;
+}
+
+template<typename Model, typename DatasetTp, typename RegularizerFn>
+template<typename Executor, typename Options>
+real_t
+SSELoss<Model, DatasetTp, RegularizerFn>::batch_gradients(const DatasetTp& dataset, uint_t begin, uint_t end,
+                                                          DynVec<real_t>& gradients,
+                                                          Executor& executor, const Options& options)const{
+
+    details::check_batch_range(begin, end, dataset.n_examples());
+
+    auto block_fn = [this, &dataset](uint_t b, uint_t e, DynVec<real_t>& grads){
+        return this->batch_gradients(dataset, b, e, grads);
+    };
+
+    return details::threaded_batch_gradients(this->n_parameters(), begin, end, block_fn, gradients, executor, options);
+}
 
 }
 }
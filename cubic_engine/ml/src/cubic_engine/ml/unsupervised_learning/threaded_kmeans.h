@@ -0,0 +1,866 @@
+#ifndef THREADED_KMEANS_H
+#define THREADED_KMEANS_H
+
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "cubic_engine/ml/unsupervised_learning/utils/kmeans_info.h"
+#include "cubic_engine/ml/unsupervised_learning/utils/kmeans_control.h"
+#include "cubic_engine/ml/unsupervised_learning/utils/cluster.h"
+
+#include "kernel/base/kernel_consts.h"
+#include "kernel/utilities/range_1d.h"
+#include "kernel/parallel/threading/simple_task.h"
+#include "kernel/parallel/utilities/array_partitioner.h"
+#include "kernel/parallel/parallel_algos/execution_plan.h"
+
+#include <vector>
+#include <memory>
+#include <random>
+#include <limits>
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+namespace cengine{
+namespace ml{
+
+///
+/// \brief Threaded implementation of the KMeans algorithm. The points are
+/// assigned to the clusters by the tasks of an executor (ThreadPool, OMPExecutor)
+/// and every point stores the id of its cluster in a flat labels array.
+///
+/// When KMeansConfig::use_distance_bounds is true the bounds of Hamerly's
+/// algorithm are used. Every point keeps an upper bound of the distance to
+/// its centroid and a lower bound of the distance to any other centroid. When the
+/// upper bound is not larger than the lower bound, or than half the distance
+/// of its centroid to the closest centroid, the point cannot change cluster and
+/// no distance is computed. This requires that the Similarity is a metric.
+///
+/// The sums of the points of every cluster are updated only with the points
+/// that changed cluster. Every task accumulates the changes of its points and
+/// these are merged once the tasks finish.
+///
+/// When KMeansConfig::batch_size is not zero mini-batch k-means is used instead.
+/// In every iteration batch_size points are sampled, assigned to the closest
+/// centroid and every centroid moves towards its points with a learning rate
+/// that is the inverse of the number of points it has received so far.
+/// At the end all the points are assigned to the final centroids
+///
+template<typename ClusterType>
+class ThreadedKMeans
+{
+
+public:
+
+    ///
+    /// \brief The output type returned upon completion
+    /// of the algorithm
+    ///
+    typedef KMeansInfo output_t;
+
+    ///
+    /// \brief The input to the algorithm
+    ///
+    typedef KMeansConfig config_t;
+
+    ///
+    /// \brief The cluster type used
+    ///
+    typedef ClusterType cluster_t;
+
+    ///
+    /// \brief The centroid type
+    ///
+    typedef typename ClusterType::point_t point_t;
+
+    ///
+    /// \brief The result after computing
+    ///
+    typedef std::vector<cluster_t> result_t;
+
+    ///
+    /// \brief Constructor
+    ///
+    ThreadedKMeans(const config_t& config);
+
+    ///
+    /// \brief Cluster the given data set using the given executor
+    ///
+    template<typename DataIn, typename Similarity, typename Initializer, typename Executor, typename Options>
+    output_t cluster(const DataIn& data, const Similarity& similarity, const Initializer& init,
+                     Executor& executor, const Options& options);
+
+    ///
+    /// \brief The cluster id of every point
+    ///
+    const std::vector<uint_t>& get_labels()const{return labels_;}
+
+    ///
+    /// \brief Return the clusters container. The clusters
+    /// are built from the labels when the clustering finishes
+    ///
+    result_t& get_clusters(){return clusters_;}
+
+    ///
+    /// \brief Return the clusters container
+    ///
+    const result_t& get_clusters()const{return clusters_;}
+
+    ///
+    /// \brief The number of point to centroid distances computed
+    /// by the last call to cluster()
+    ///
+    uint_t n_distance_computations()const{return n_distances_;}
+
+private:
+
+    ///
+    /// \brief What the tasks do when executed
+    ///
+    enum class Mode{ASSIGN, BOUNDED_ASSIGN, ASSIGN_BATCH};
+
+    ///
+    /// \brief The task that works on a range of points
+    ///
+    template<typename DataIn, typename Similarity>
+    class AssignTask;
+
+    ///
+    /// \brief The algorithm control
+    ///
+    config_t control_;
+
+    ///
+    /// \brief The clusters
+    ///
+    std::vector<cluster_t> clusters_;
+
+    ///
+    /// \brief The current centroids
+    ///
+    std::vector<point_t> centroids_;
+
+    ///
+    /// \brief The cluster of every point
+    ///
+    std::vector<uint_t> labels_;
+
+    ///
+    /// \brief Upper bound of the distance of every point to its centroid
+    ///
+    std::vector<real_t> upper_;
+
+    ///
+    /// \brief Lower bound of the distance of every point to any other centroid
+    ///
+    std::vector<real_t> lower_;
+
+    ///
+    /// \brief Half the distance of every centroid to the closest other centroid
+    ///
+    std::vector<real_t> half_separation_;
+
+    ///
+    /// \brief The distance every centroid moved in the last iteration
+    ///
+    std::vector<real_t> movement_;
+
+    ///
+    /// \brief The largest movement of the last iteration
+    ///
+    real_t max_movement_;
+
+    ///
+    /// \brief The sum of the points of every cluster stored row-wise
+    ///
+    std::vector<real_t> sums_;
+
+    ///
+    /// \brief The number of points of every cluster
+    ///
+    std::vector<uint_t> counts_;
+
+    ///
+    /// \brief The points sampled in the current mini-batch
+    ///
+    std::vector<uint_t> batch_;
+
+    ///
+    /// \brief The cluster of every point of the mini-batch
+    ///
+    std::vector<uint_t> batch_labels_;
+
+    ///
+    /// \brief What the tasks do in the current execution
+    ///
+    Mode mode_;
+
+    ///
+    /// \brief The number of distances computed
+    ///
+    uint_t n_distances_;
+
+    ///
+    /// \brief Initialize the state for clustering n points
+    ///
+    template<typename DataIn, typename Initializer>
+    void initialize_(const DataIn& data, const Initializer& init);
+
+    ///
+    /// \brief Merge the changes of the tasks into the cluster sums and counts
+    ///
+    template<typename PlanTp>
+    uint_t merge_changes_(const PlanTp& plan);
+
+    ///
+    /// \brief Compute the centroids from the sums. Returns the
+    /// id of an empty cluster or invalid_size_type()
+    ///
+    template<typename Similarity>
+    uint_t update_centroids_(const Similarity& similarity);
+
+    ///
+    /// \brief Compute half the distance of every centroid to the closest one
+    ///
+    template<typename Similarity>
+    void compute_separation_(const Similarity& similarity);
+
+    ///
+    /// \brief Run Lloyd iterations with all the points
+    ///
+    template<typename DataIn, typename Similarity, typename Initializer, typename Executor, typename Options>
+    void full_batch_(const DataIn& data, const Similarity& similarity, const Initializer& init,
+                     Executor& executor, const Options& options);
+
+    ///
+    /// \brief Run mini-batch iterations
+    ///
+    template<typename DataIn, typename Similarity, typename Executor, typename Options>
+    void mini_batch_(const DataIn& data, const Similarity& similarity,
+                     Executor& executor, const Options& options);
+
+    ///
+    /// \brief Build the clusters from the labels
+    ///
+    void build_clusters_();
+};
+
+template<typename ClusterType>
+template<typename DataIn, typename Similarity>
+class ThreadedKMeans<ClusterType>::AssignTask: public kernel::SimpleTaskBase<Null>
+{
+public:
+
+    ///
+    /// \brief Constructor
+    ///
+    AssignTask(uint_t id, ThreadedKMeans& kmeans, const DataIn& data,
+               const Similarity& similarity, kernel::range1d<uint_t> range);
+
+    ///
+    /// \brief The change of the cluster sums caused by the points of this task
+    ///
+    const std::vector<real_t>& delta_sums()const{return delta_sums_;}
+
+    ///
+    /// \brief The change of the cluster counts caused by the points of this task
+    ///
+    const std::vector<long long>& delta_counts()const{return delta_counts_;}
+
+    ///
+    /// \brief The number of points that changed cluster
+    ///
+    uint_t n_changed()const{return n_changed_;}
+
+    ///
+    /// \brief The number of distances computed
+    ///
+    uint_t n_distances()const{return n_distances_;}
+
+protected:
+
+    ///
+    /// \brief Implements the workings of the task
+    ///
+    virtual void run()override final;
+
+private:
+
+    ThreadedKMeans* kmeans_;
+    const DataIn* data_;
+    const Similarity* similarity_;
+    kernel::range1d<uint_t> range_;
+
+    std::vector<real_t> delta_sums_;
+    std::vector<long long> delta_counts_;
+    uint_t n_changed_;
+    uint_t n_distances_;
+
+    ///
+    /// \brief Find the closest centroid of the given point and
+    /// the distances to the closest and second closest centroids
+    ///
+    template<typename RowTp>
+    uint_t closest_(const RowTp& row, real_t& first, real_t& second);
+
+    ///
+    /// \brief Record that point moved from cluster from to cluster to
+    ///
+    template<typename RowTp>
+    void move_(const RowTp& row, uint_t from, uint_t to);
+};
+
+template<typename ClusterType>
+template<typename DataIn, typename Similarity>
+ThreadedKMeans<ClusterType>::AssignTask<DataIn, Similarity>::AssignTask(uint_t id, ThreadedKMeans& kmeans, const DataIn& data,
+                                                                         const Similarity& similarity, kernel::range1d<uint_t> range)
+    :
+    kernel::SimpleTaskBase<Null>(id),
+    kmeans_(&kmeans),
+    data_(&data),
+    similarity_(&similarity),
+    range_(range),
+    delta_sums_(),
+    delta_counts_(),
+    n_changed_(0),
+    n_distances_(0)
+{}
+
+template<typename ClusterType>
+template<typename DataIn, typename Similarity>
+template<typename RowTp>
+uint_t
+ThreadedKMeans<ClusterType>::AssignTask<DataIn, Similarity>::closest_(const RowTp& row, real_t& first, real_t& second){
+
+    const auto& centroids = kmeans_->centroids_;
+
+    uint_t cluster = 0;
+    first = std::numeric_limits<real_t>::max();
+    second = std::numeric_limits<real_t>::max();
+
+    for(uint_t c=0; c<centroids.size(); ++c){
+
+        const real_t dis = (*similarity_)(row, centroids[c]);
+
+        if(dis < first){
+            second = first;
+            first = dis;
+            cluster = c;
+        }
+        else if(dis < second){
+            second = dis;
+        }
+    }
+
+    n_distances_ += centroids.size();
+    return cluster;
+}
+
+template<typename ClusterType>
+template<typename DataIn, typename Similarity>
+template<typename RowTp>
+void
+ThreadedKMeans<ClusterType>::AssignTask<DataIn, Similarity>::move_(const RowTp& row, uint_t from, uint_t to){
+
+    const uint_t dim = row.size();
+
+    if(from != kernel::KernelConsts::invalid_size_type()){
+
+        for(uint_t c=0; c<dim; ++c){
+            delta_sums_[from*dim + c] -= row[c];
+        }
+
+        delta_counts_[from] -= 1;
+    }
+
+    for(uint_t c=0; c<dim; ++c){
+        delta_sums_[to*dim + c] += row[c];
+    }
+
+    delta_counts_[to] += 1;
+    n_changed_ += 1;
+}
+
+template<typename ClusterType>
+template<typename DataIn, typename Similarity>
+void
+ThreadedKMeans<ClusterType>::AssignTask<DataIn, Similarity>::run(){
+
+    const uint_t k = kmeans_->centroids_.size();
+    const uint_t dim = data_->n_columns();
+
+    delta_sums_.assign(k*dim, 0.0);
+    delta_counts_.assign(k, 0);
+    n_changed_ = 0;
+    n_distances_ = 0;
+
+    auto& labels = kmeans_->labels_;
+    auto& upper = kmeans_->upper_;
+    auto& lower = kmeans_->lower_;
+
+    real_t first = 0.0;
+    real_t second = 0.0;
+
+    switch(kmeans_->mode_){
+
+        case Mode::ASSIGN:
+        {
+            for(uint_t p=range_.begin(); p<range_.end(); ++p){
+
+                const auto row = data_->get_row(p);
+                const uint_t cluster = closest_(row, first, second);
+
+                upper[p] = first;
+                lower[p] = second;
+
+                if(cluster != labels[p]){
+                    move_(row, labels[p], cluster);
+                    labels[p] = cluster;
+                }
+            }
+
+            break;
+        }
+        case Mode::BOUNDED_ASSIGN:
+        {
+            const auto& movement = kmeans_->movement_;
+            const auto& half_separation = kmeans_->half_separation_;
+            const real_t max_movement = kmeans_->max_movement_;
+
+            for(uint_t p=range_.begin(); p<range_.end(); ++p){
+
+                const uint_t current = labels[p];
+
+                // account for the movement of the centroids
+                upper[p] += movement[current];
+                lower[p] -= max_movement;
+
+                const real_t bound = std::max(half_separation[current], lower[p]);
+
+                if(upper[p] <= bound){
+                    continue;
+                }
+
+                // tighten the upper bound and try again
+                const auto row = data_->get_row(p);
+                upper[p] = (*similarity_)(row, kmeans_->centroids_[current]);
+                n_distances_ += 1;
+
+                if(upper[p] <= bound){
+                    continue;
+                }
+
+                const uint_t cluster = closest_(row, first, second);
+
+                upper[p] = first;
+                lower[p] = second;
+
+                if(cluster != current){
+                    move_(row, current, cluster);
+                    labels[p] = cluster;
+                }
+            }
+
+            break;
+        }
+        case Mode::ASSIGN_BATCH:
+        {
+            const auto& batch = kmeans_->batch_;
+            auto& batch_labels = kmeans_->batch_labels_;
+
+            for(uint_t b=range_.begin(); b<range_.end(); ++b){
+
+                const auto row = data_->get_row(batch[b]);
+                batch_labels[b] = closest_(row, first, second);
+            }
+
+            break;
+        }
+    }
+
+    this->result_.validate_result();
+}
+
+template<typename ClusterType>
+ThreadedKMeans<ClusterType>::ThreadedKMeans(const config_t& config)
+    :
+    control_(config),
+    clusters_(),
+    centroids_(),
+    labels_(),
+    upper_(),
+    lower_(),
+    half_separation_(),
+    movement_(),
+    max_movement_(0.0),
+    sums_(),
+    counts_(),
+    batch_(),
+    batch_labels_(),
+    mode_(Mode::ASSIGN),
+    n_distances_(0)
+{}
+
+template<typename ClusterType>
+template<typename DataIn, typename Initializer>
+void
+ThreadedKMeans<ClusterType>::initialize_(const DataIn& data, const Initializer& init){
+
+    const uint_t k = control_.k;
+    const uint_t n = data.n_rows();
+
+    centroids_.clear();
+    init(data, k, centroids_);
+
+    if(centroids_.size() != k){
+        throw std::logic_error("Incorrect centroid initialization: "+
+                               std::to_string(centroids_.size()) +
+                               " not equal to: "+
+                               std::to_string(k));
+    }
+
+    labels_.assign(n, kernel::KernelConsts::invalid_size_type());
+    upper_.assign(n, std::numeric_limits<real_t>::max());
+    lower_.assign(n, 0.0);
+    half_separation_.assign(k, 0.0);
+    movement_.assign(k, 0.0);
+    max_movement_ = 0.0;
+    sums_.assign(k*data.n_columns(), 0.0);
+    counts_.assign(k, 0);
+    mode_ = Mode::ASSIGN;
+}
+
+template<typename ClusterType>
+template<typename PlanTp>
+uint_t
+ThreadedKMeans<ClusterType>::merge_changes_(const PlanTp& plan){
+
+    uint_t n_changed = 0;
+
+    for(uint_t t=0; t<plan.n_tasks(); ++t){
+
+        const auto& task = plan.get_task(t);
+
+        const auto& delta_sums = task.delta_sums();
+        for(uint_t i=0; i<delta_sums.size(); ++i){
+            sums_[i] += delta_sums[i];
+        }
+
+        const auto& delta_counts = task.delta_counts();
+        for(uint_t c=0; c<delta_counts.size(); ++c){
+            counts_[c] = static_cast<uint_t>(static_cast<long long>(counts_[c]) + delta_counts[c]);
+        }
+
+        n_changed += task.n_changed();
+        n_distances_ += task.n_distances();
+    }
+
+    return n_changed;
+}
+
+template<typename ClusterType>
+template<typename Similarity>
+uint_t
+ThreadedKMeans<ClusterType>::update_centroids_(const Similarity& similarity){
+
+    const uint_t dim = centroids_.empty() ? 0 : centroids_[0].size();
+    uint_t empty_cluster = kernel::KernelConsts::invalid_size_type();
+
+    max_movement_ = 0.0;
+
+    for(uint_t c=0; c<centroids_.size(); ++c){
+
+        if(counts_[c] == 0){
+
+            // the centroid of an empty cluster does not move
+            movement_[c] = 0.0;
+
+            if(empty_cluster == kernel::KernelConsts::invalid_size_type()){
+                empty_cluster = c;
+            }
+
+            continue;
+        }
+
+        point_t centroid(dim);
+        for(uint_t i=0; i<dim; ++i){
+            centroid[i] = sums_[c*dim + i]/counts_[c];
+        }
+
+        movement_[c] = similarity(centroid, centroids_[c]);
+        n_distances_ += 1;
+        max_movement_ = std::max(max_movement_, movement_[c]);
+        centroids_[c] = centroid;
+    }
+
+    return empty_cluster;
+}
+
+template<typename ClusterType>
+template<typename Similarity>
+void
+ThreadedKMeans<ClusterType>::compute_separation_(const Similarity& similarity){
+
+    const uint_t k = centroids_.size();
+    std::fill(half_separation_.begin(), half_separation_.end(), std::numeric_limits<real_t>::max());
+
+    for(uint_t c1=0; c1<k; ++c1){
+        for(uint_t c2=c1+1; c2<k; ++c2){
+
+            const real_t dis = 0.5*similarity(centroids_[c1], centroids_[c2]);
+            half_separation_[c1] = std::min(half_separation_[c1], dis);
+            half_separation_[c2] = std::min(half_separation_[c2], dis);
+        }
+    }
+
+    n_distances_ += (k*(k - 1))/2;
+}
+
+template<typename ClusterType>
+void
+ThreadedKMeans<ClusterType>::build_clusters_(){
+
+    clusters_.clear();
+    clusters_.resize(centroids_.size());
+
+    for(uint_t c=0; c<clusters_.size(); ++c){
+        clusters_[c].id = c;
+        clusters_[c].centroid = centroids_[c];
+        clusters_[c].changed = false;
+        clusters_[c].points.reserve(counts_[c]);
+    }
+
+    for(uint_t p=0; p<labels_.size(); ++p){
+        clusters_[labels_[p]].points.push_back(p);
+    }
+}
+
+template<typename ClusterType>
+template<typename DataIn, typename Similarity, typename Initializer, typename Executor, typename Options>
+void
+ThreadedKMeans<ClusterType>::full_batch_(const DataIn& data, const Similarity& similarity, const Initializer& init,
+                                         Executor& executor, const Options& options){
+
+    typedef AssignTask<DataIn, Similarity> task_t;
+
+    std::vector<kernel::range1d<uint_t>> partitions;
+    kernel::partition_range(static_cast<uint_t>(0), static_cast<uint_t>(data.n_rows()),
+                            partitions, executor.n_processing_elements());
+
+    kernel::ExecutionPlan<task_t, Executor> plan(executor, [&](uint_t t){
+        return std::make_unique<task_t>(t, *this, data, similarity, partitions[t]);
+    });
+
+    bool restart = true;
+
+    while(restart){
+
+        restart = false;
+        initialize_(data, init);
+
+        while(control_.continue_iterations()){
+
+            if(control_.show_iterations()){
+                std::cout<<"\tK-means iteration: "<<control_.get_current_iteration()<<std::endl;
+            }
+
+            if(control_.use_distance_bounds && mode_ != Mode::ASSIGN){
+                compute_separation_(similarity);
+            }
+
+            plan.execute(options);
+
+            const uint_t n_changed = merge_changes_(plan);
+            const uint_t empty_cluster = update_centroids_(similarity);
+
+            if(empty_cluster != kernel::KernelConsts::invalid_size_type()){
+
+                if(control_.show_iterations()){
+                    std::cout<<"\t\tEmpty cluster detected..."<<std::endl;
+                }
+
+                if(!control_.continue_on_empty_cluster && control_.random_restart_on_empty_cluster){
+
+                    if(control_.show_iterations()){
+                        std::cout<<"\t\tRestarting..."<<std::endl;
+                    }
+
+                    restart = true;
+                    break;
+                }
+                else if(!control_.continue_on_empty_cluster){
+                    break;
+                }
+                else if(control_.show_iterations()){
+                    std::cout<<"\t\tContinue with empty cluster detected..."<<std::endl;
+                }
+            }
+
+            // no point moved so the centroids did not change
+            const real_t residual = n_changed == 0 ? 0.0 : max_movement_;
+            control_.update_residual(residual);
+
+            if(control_.show_iterations()){
+               std::cout<<"\t\t Residual at teration: "<<residual<<std::endl;
+            }
+
+            if(control_.use_distance_bounds){
+                mode_ = Mode::BOUNDED_ASSIGN;
+            }
+        }
+    }
+}
+
+template<typename ClusterType>
+template<typename DataIn, typename Similarity, typename Executor, typename Options>
+void
+ThreadedKMeans<ClusterType>::mini_batch_(const DataIn& data, const Similarity& similarity,
+                                         Executor& executor, const Options& options){
+
+    typedef AssignTask<DataIn, Similarity> task_t;
+
+    const uint_t batch_size = std::min(control_.batch_size, static_cast<uint_t>(data.n_rows()));
+    const uint_t dim = data.n_columns();
+
+    batch_.resize(batch_size);
+    batch_labels_.resize(batch_size);
+
+    std::vector<kernel::range1d<uint_t>> partitions;
+    kernel::partition_range(static_cast<uint_t>(0), batch_size,
+                            partitions, executor.n_processing_elements());
+
+    kernel::ExecutionPlan<task_t, Executor> plan(executor, [&](uint_t t){
+        return std::make_unique<task_t>(t, *this, data, similarity, partitions[t]);
+    });
+
+    std::mt19937 generator(control_.seed);
+    std::uniform_int_distribution<uint_t> distribution(0, data.n_rows() - 1);
+
+    // the number of points every centroid received so far
+    std::vector<uint_t> n_received(centroids_.size(), 0);
+    std::vector<point_t> old_centroids;
+
+    mode_ = Mode::ASSIGN_BATCH;
+
+    while(control_.continue_iterations()){
+
+        if(control_.show_iterations()){
+            std::cout<<"\tMini-batch K-means iteration: "<<control_.get_current_iteration()<<std::endl;
+        }
+
+        for(auto& point : batch_){
+            point = distribution(generator);
+        }
+
+        plan.execute(options);
+
+        for(uint_t t=0; t<plan.n_tasks(); ++t){
+            n_distances_ += plan.get_task(t).n_distances();
+        }
+
+        old_centroids = centroids_;
+
+        // the updates depend on the order of
+        // the points so they are done serially
+        for(uint_t b=0; b<batch_size; ++b){
+
+            const uint_t c = batch_labels_[b];
+            const auto row = data.get_row(batch_[b]);
+
+            n_received[c] += 1;
+            const real_t rate = 1.0/n_received[c];
+
+            for(uint_t i=0; i<dim; ++i){
+                centroids_[c][i] = (1.0 - rate)*centroids_[c][i] + rate*row[i];
+            }
+        }
+
+        real_t residual = 0.0;
+        for(uint_t c=0; c<centroids_.size(); ++c){
+            residual = std::max(residual, similarity(centroids_[c], old_centroids[c]));
+        }
+
+        n_distances_ += centroids_.size();
+        control_.update_residual(residual);
+
+        if(control_.show_iterations()){
+           std::cout<<"\t\t Residual at teration: "<<residual<<std::endl;
+        }
+    }
+}
+
+template<typename ClusterType>
+template<typename DataIn, typename Similarity, typename Initializer, typename Executor, typename Options>
+typename ThreadedKMeans<ClusterType>::output_t
+ThreadedKMeans<ClusterType>::cluster(const DataIn& data, const Similarity& similarity, const Initializer& init,
+                                     Executor& executor, const Options& options){
+
+    output_t info;
+    auto k = control_.k;
+    auto rows = data.n_rows();
+
+    if( k == 0){
+        throw std::logic_error("Number of clusters cannot be zero");
+    }
+
+    // more clusters than data does not make
+    // sense
+    if(k > rows){
+        throw std::logic_error("Number of clusters cannot be larger than number of rows");
+    }
+
+    //start timing
+    std::chrono::time_point<std::chrono::system_clock> start, end;
+    start = std::chrono::system_clock::now();
+
+    n_distances_ = 0;
+
+    if(control_.batch_size == 0){
+        full_batch_(data, similarity, init, executor, options);
+    }
+    else{
+
+        initialize_(data, init);
+        mini_batch_(data, similarity, executor, options);
+
+        // assign all the points to the final centroids
+        typedef AssignTask<DataIn, Similarity> task_t;
+
+        std::vector<kernel::range1d<uint_t>> partitions;
+        kernel::partition_range(static_cast<uint_t>(0), static_cast<uint_t>(rows),
+                                partitions, executor.n_processing_elements());
+
+        kernel::ExecutionPlan<task_t, Executor> plan(executor, [&](uint_t t){
+            return std::make_unique<task_t>(t, *this, data, similarity, partitions[t]);
+        });
+
+        mode_ = Mode::ASSIGN;
+        plan.execute(options);
+        merge_changes_(plan);
+    }
+
+    build_clusters_();
+
+    auto state = control_.get_state();
+    end = std::chrono::system_clock::now();
+
+    info.runtime = end-start;
+    info.nprocs = 1;
+    info.nthreads = executor.get_n_threads();
+    info.converged = state.converged;
+    info.residual = state.residual;
+    info.tolerance = state.tolerance;
+    info.niterations = state.num_iterations;
+    info.n_clustering_points = rows;
+
+    for(const auto& cluster : clusters_){
+        info.clusters.push_back({cluster.id, cluster.n_points()});
+    }
+
+    return info;
+}
+
+}
+}
+
+#endif // THREADED_KMEANS_H
@@ -31,6 +31,25 @@ struct KMeansConfig: public kernel::IterativeAlgorithmController
     /// continue its execution when an empty cluster is detected
 	///
     bool continue_on_empty_cluster;
+
+	///
+    /// \brief Flag indicating whether triangle inequality bounds are
+    /// used to skip distance computations. Only used by ThreadedKMeans
+    /// and requires that the similarity is a metric
+	///
+    bool use_distance_bounds;
+
+	///
+    /// \brief The number of points sampled in every iteration of
+    /// mini-batch k-means. Zero means that all the points are used in
+    /// every iteration. Only used by ThreadedKMeans
+	///
+    uint_t batch_size;
+
+	///
+    /// \brief The seed used for sampling the mini-batches
+	///
+    uint_t seed;
     
 	///
     /// \brief Constructor
@@ -45,7 +64,10 @@ KMeansConfig::KMeansConfig(uint_t k_, uint_t itrs)
             kernel::IterativeAlgorithmController(itrs, kernel::KernelConsts::tolerance()),
             k(k_),
             random_restart_on_empty_cluster(true),
-            continue_on_empty_cluster(false)
+            continue_on_empty_cluster(false),
+            use_distance_bounds(true),
+            batch_size(0),
+            seed(42)
 {}
 
 }
@@ -1,7 +1,10 @@
 #include "cubic_engine/base/cubic_engine_types.h"
 #include "cubic_engine/ml/datasets/blaze_regression_dataset.h"
 #include "cubic_engine/ml/datasets/data_set_loaders.h"
+#include "kernel/utilities/csv_data_reader.h"
 
+#include <cstdio>
+#include <fstream>
 #include <vector>
 #include <stdexcept>
 #include <gtest/gtest.h>
@@ -154,3 +157,71 @@ TEST(TestBlazeRegressionDataset, Accumulate) {
 
 
 
+
+
+TEST(TestBlazeRegressionDataset, LoadFromFile) {
+
+    try{
+
+        {
+            std::ofstream file("test_blaze_regression_dataset.csv");
+            file<<"x1,x2,y\n1.0,2.0,3.0\n4.0,5.0,6.0\n";
+        }
+
+        BlazeRegressionDataset dataset;
+
+        kernel::CSVDataReader reader("test_blaze_regression_dataset.csv");
+        dataset.load_from_file(reader);
+
+        ASSERT_EQ(dataset.n_features(), 2);
+        ASSERT_EQ(dataset.n_examples(), 2);
+        ASSERT_DOUBLE_EQ(dataset.feature_matrix()(1, 1), 5.0);
+        ASSERT_DOUBLE_EQ(dataset.get_label(1), 6.0);
+        ASSERT_EQ(dataset.columns().at("x2"), 1);
+
+        std::remove("test_blaze_regression_dataset.csv");
+    }
+    catch(std::logic_error& exception){
+        ASSERT_FALSE(exception.what());
+    }
+    catch(...){
+
+        ASSERT_FALSE("A non expected exception was thrown");
+    }
+}
+
+TEST(TestBlazeRegressionDataset, RowViews) {
+
+    /***
+       * Test Scenario:    The application accesses the rows and accumulates the last rows
+       * Expected Output:  The rows point into the feature matrix and the tail
+       *                   is accumulated from the last row backwards
+     **/
+
+    BlazeRegressionDataset dataset;
+
+    DynMat<real_t> mat(4, 2);
+    DynVec<real_t> vec(4);
+
+    for(uint_t r=0; r<4; ++r){
+        mat(r, 0) = r;
+        mat(r, 1) = 10.0*r;
+        vec[r] = -1.0*r;
+    }
+
+    dataset.load_from_data(mat, vec);
+
+    auto [row, label] = dataset[2];
+    ASSERT_EQ(row.size(), 2);
+    ASSERT_EQ(row.data(), dataset.feature_matrix().data(2));
+    ASSERT_DOUBLE_EQ(row[1], 20.0);
+    ASSERT_DOUBLE_EQ(label, -2.0);
+
+    auto copy = dataset.get_row(3);
+    ASSERT_DOUBLE_EQ(copy[0], 3.0);
+
+    auto tail = dataset.accumulate([](const auto& row, const auto&){return row[0];}, 2, cengine::ml::PointTp::END);
+    ASSERT_EQ(tail.size(), 2);
+    ASSERT_DOUBLE_EQ(tail[0], 3.0);
+    ASSERT_DOUBLE_EQ(tail[1], 2.0);
+}
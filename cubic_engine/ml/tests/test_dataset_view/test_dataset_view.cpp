@@ -1,6 +1,7 @@
 #include "cubic_engine/base/cubic_engine_types.h"
 #include "cubic_engine/ml/datasets/blaze_regression_dataset.h"
 #include "cubic_engine/ml/datasets/data_set_loaders.h"
+#include "cubic_engine/ml/datasets/dataset_view.h"
 
 #include <vector>
 #include <stdexcept>
@@ -10,7 +11,9 @@ namespace {
 using cengine::DynMat;
 using cengine::DynVec;
 using cengine::real_t;
+using cengine::uint_t;
 using cengine::ml::BlazeRegressionDataset;
+using cengine::ml::DatasetView;
 
 struct TestSetLoader{
 
@@ -71,13 +74,32 @@ TEST(TestBlazeRegressionDataset, LoadFromLoader) {
     }
 }
 
+TEST(TestDatasetView, RowAccess) {
 
+    /***
+       * Test Scenario:    The application creates a view of a dataset with some of its rows
+       * Expected Output:  The i-th row of the view is the row of the dataset at the i-th index
+     **/
 
+    BlazeRegressionDataset dataset;
 
+    DynMat<real_t> mat(5, 1);
+    DynVec<real_t> vec(5);
 
+    for(uint_t r=0; r<5; ++r){
+        mat(r, 0) = r;
+        vec[r] = 2.0*r;
+    }
 
+    dataset.load_from_data(mat, vec);
 
+    DatasetView<BlazeRegressionDataset> view(dataset, {4, 1});
 
+    auto [row, label] = view[0];
+    ASSERT_DOUBLE_EQ(row[0], 4.0);
+    ASSERT_DOUBLE_EQ(label, 8.0);
 
-
-
+    auto [row1, label1] = view[1];
+    ASSERT_EQ(row1.data(), dataset.feature_matrix().data(1));
+    ASSERT_DOUBLE_EQ(label1, 2.0);
+}
@@ -0,0 +1,162 @@
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "cubic_engine/ml/instance_learning/details/knn_classification_policy.h"
+#include "cubic_engine/ml/instance_learning/details/knn_average_regression_policy.h"
+#include "cubic_engine/ml/instance_learning/details/knn_top_k.h"
+
+#include <vector>
+#include <tuple>
+#include <cmath>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+namespace {
+
+using cengine::real_t;
+using cengine::uint_t;
+using cengine::ml::KnnClassificationPolicy;
+using cengine::ml::KnnAvgRegressionPolicy;
+
+typedef std::pair<uint_t, real_t> Pair;
+
+/// \brief Data set of points on the real line
+template<typename LabelTp>
+struct LineDataSet
+{
+    std::vector<real_t> points;
+    std::vector<LabelTp> labels_;
+
+    uint_t n_examples()const{return points.size();}
+    std::tuple<real_t, LabelTp> operator[](uint_t i)const{return {points[i], labels_[i]};}
+    const std::vector<LabelTp>& labels()const{return labels_;}
+};
+
+struct LineMetric
+{
+    real_t operator()(real_t p1, real_t p2)const{return std::fabs(p1 - p2);}
+};
+
+}
+
+/***
+ * Test Scenario:   The application classifies a point whose nearest neighbors vote for two classes
+ * Expected Output:	The class with the most votes is returned
+ **/
+
+TEST(TestKnnClassificationPolicy, MajorityVote) {
+
+    LineDataSet<uint_t> data;
+    data.points = {0.0, 1.0, 2.0, 3.0, 10.0, 11.0};
+    data.labels_ = {4, 1, 4, 1, 1, 1};
+
+    KnnClassificationPolicy policy(3);
+    policy(data, 0.5, LineMetric());
+
+    ASSERT_EQ(policy.get_distances().size(), 3);
+    ASSERT_EQ(policy.get_distances()[0].first, 0);
+    ASSERT_EQ(policy.get_distances()[1].first, 1);
+    ASSERT_EQ(policy.get_distances()[2].first, 2);
+    ASSERT_EQ(policy.get_result(), 4);
+
+    // reusing the policy does not keep the old votes
+    policy(data, 10.5, LineMetric());
+    ASSERT_EQ(policy.get_result(), 1);
+}
+
+/***
+ * Test Scenario:   The application classifies a point whose nearest neighbors vote equally for two classes
+ * Expected Output:	The class with the smallest index is returned
+ **/
+
+TEST(TestKnnClassificationPolicy, TieReturnsSmallestClass) {
+
+    std::vector<uint_t> labels = {3, 2};
+    std::vector<Pair> distances = {{0, 0.5}, {1, 1.0}};
+
+    KnnClassificationPolicy policy(2);
+    policy.fillin_majority_vote(labels, distances);
+
+    ASSERT_EQ(policy.get_result(), 2);
+}
+
+/***
+ * Test Scenario:   The application fills in the majority vote with less distances than neighbors
+ * Expected Output:	std::logic_error is thrown
+ **/
+
+TEST(TestKnnClassificationPolicy, TooFewDistances) {
+
+    std::vector<uint_t> labels = {3, 2};
+    std::vector<Pair> distances = {{0, 0.5}};
+
+    KnnClassificationPolicy policy(2);
+    ASSERT_THROW(policy.fillin_majority_vote(labels, distances), std::logic_error);
+}
+
+/***
+ * Test Scenario:   The application predicts a value with the average regression policy
+ * Expected Output:	The average of the labels of the k nearest neighbors is returned
+ **/
+
+TEST(TestKnnAvgRegressionPolicy, Average) {
+
+    LineDataSet<real_t> data;
+    data.points = {5.0, 0.0, 1.0, 2.0, 3.0};
+    data.labels_ = {100.0, 1.0, 2.0, 3.0, 4.0};
+
+    KnnAvgRegressionPolicy policy(3);
+    policy(data, 1.1, LineMetric());
+
+    ASSERT_DOUBLE_EQ(policy.get_result(), 2.0);
+}
+
+/***
+ * Test Scenario:   The application merges the distances computed by two policies as two threads would do
+ * Expected Output:	The k smallest distances of both are kept in ascending order
+ **/
+
+TEST(TestKnnAvgRegressionPolicy, MergeDistances) {
+
+    LineDataSet<real_t> data;
+    data.points = {0.0, 2.0, 4.0, 1.0, 3.0, 5.0};
+    data.labels_ = {0.0, 2.0, 4.0, 1.0, 3.0, 5.0};
+
+    // each policy sees half of the data set
+    LineDataSet<real_t> first;
+    first.points = {0.0, 2.0, 4.0};
+    first.labels_ = {0.0, 2.0, 4.0};
+
+    KnnAvgRegressionPolicy policy(3);
+    policy(first, 0.0, LineMetric());
+
+    std::vector<Pair> other = {{3, 1.0}, {4, 3.0}, {5, 5.0}};
+    policy.merge_distances(other);
+
+    const auto& distances = policy.get_distances();
+    ASSERT_EQ(distances.size(), 3);
+    ASSERT_EQ(distances[0].first, 0);
+    ASSERT_EQ(distances[1].first, 3);
+    ASSERT_EQ(distances[2].first, 1);
+
+    policy.fillin_majority_vote(data.labels());
+    ASSERT_DOUBLE_EQ(policy.get_result(), 1.0);
+}
+
+/***
+ * Test Scenario:   The application merges two sorted lists of pairs
+ * Expected Output:	The k smallest pairs are returned sorted and equal distances are ordered by row
+ **/
+
+TEST(TestKnnTopK, MergeSorted) {
+
+    std::vector<Pair> first = {{4, 1.0}, {0, 2.0}, {1, 6.0}};
+    std::vector<Pair> second = {{2, 1.0}, {3, 5.0}};
+    std::vector<Pair> result;
+
+    cengine::ml::details::merge_top_k(first, second, 4, result);
+
+    ASSERT_EQ(result.size(), 4);
+    ASSERT_EQ(result[0].first, 2);
+    ASSERT_EQ(result[1].first, 4);
+    ASSERT_EQ(result[2].first, 0);
+    ASSERT_EQ(result[3].first, 3);
+}
@@ -0,0 +1,154 @@
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "cubic_engine/ml/instance_learning/knn_control.h"
+#include "cubic_engine/ml/instance_learning/details/knn_spatial_index.h"
+#include "cubic_engine/ml/instance_learning/details/knn_top_k.h"
+#include "kernel/maths/lp_metric.h"
+
+#include <vector>
+#include <random>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+namespace {
+
+using cengine::DynMat;
+using cengine::DynVec;
+using cengine::real_t;
+using cengine::uint_t;
+using cengine::ml::KnnIndexType;
+using cengine::ml::details::KnnSpatialIndex;
+using cengine::ml::details::KnnTopK;
+
+typedef std::pair<uint_t, real_t> Pair;
+
+DynMat<real_t> random_points(uint_t n, uint_t d, uint_t seed){
+
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<real_t> distribution(-1.0, 1.0);
+
+    DynMat<real_t> points(n, d);
+    for(uint_t r=0; r<n; ++r){
+        for(uint_t c=0; c<d; ++c){
+            points(r, c) = distribution(generator);
+        }
+    }
+
+    return points;
+}
+
+template<typename MetricTp>
+void compare_with_brute_force(KnnIndexType type, uint_t n, uint_t d, uint_t k){
+
+    auto points = random_points(n, d, 42);
+    auto queries = random_points(20, d, 7);
+
+    KnnSpatialIndex<MetricTp> brute(8);
+    brute.build(points, KnnIndexType::BRUTE_FORCE);
+
+    KnnSpatialIndex<MetricTp> index(8);
+    index.build(points, type);
+
+    ASSERT_EQ(index.type(), type);
+    ASSERT_EQ(index.n_points(), n);
+
+    std::vector<Pair> expected;
+    std::vector<Pair> result;
+
+    for(uint_t q=0; q<queries.rows(); ++q){
+
+        DynVec<real_t> point(d);
+        for(uint_t c=0; c<d; ++c){
+            point[c] = queries(q, c);
+        }
+
+        brute.query(point, k, expected);
+        index.query(point, k, result);
+
+        ASSERT_EQ(result.size(), k);
+
+        for(uint_t i=0; i<k; ++i){
+            ASSERT_EQ(result[i].first, expected[i].first);
+            ASSERT_DOUBLE_EQ(result[i].second, expected[i].second);
+        }
+    }
+}
+
+}
+
+/***
+ * Test Scenario:   The application pushes more than k pairs to KnnTopK
+ * Expected Output:	Only the k pairs with the smallest distances are kept sorted
+ **/
+
+TEST(TestKnnTopK, KeepKSmallest) {
+
+    KnnTopK top_k(3);
+
+    top_k.push(0, 5.0);
+    top_k.push(1, 1.0);
+    top_k.push(2, 4.0);
+    top_k.push(3, 0.5);
+    top_k.push(4, 3.0);
+
+    ASSERT_TRUE(top_k.full());
+    ASSERT_DOUBLE_EQ(top_k.worst_distance(), 3.0);
+
+    std::vector<Pair> pairs;
+    top_k.sorted(pairs);
+
+    ASSERT_EQ(pairs.size(), 3);
+    ASSERT_EQ(pairs[0].first, 3);
+    ASSERT_EQ(pairs[1].first, 1);
+    ASSERT_EQ(pairs[2].first, 4);
+}
+
+/***
+ * Test Scenario:   The application queries an index that has not been built
+ * Expected Output:	std::logic_error is thrown
+ **/
+
+TEST(TestKnnSpatialIndex, QueryWithoutBuild) {
+
+    KnnSpatialIndex<kernel::LpMetric<2>> index;
+    DynVec<real_t> point(2, 0.0);
+    std::vector<Pair> result;
+
+    ASSERT_THROW(index.query(point, 1, result), std::logic_error);
+}
+
+/***
+ * Test Scenario:   The application builds a ball tree with a similarity that is not a metric
+ * Expected Output:	std::logic_error is thrown
+ **/
+
+TEST(TestKnnSpatialIndex, BallTreeWithNonMetric) {
+
+    KnnSpatialIndex<kernel::LpMetric<4, false>> index;
+    auto points = random_points(10, 2, 1);
+
+    ASSERT_THROW(index.build(points, KnnIndexType::BALL_TREE), std::logic_error);
+}
+
+/***
+ * Test Scenario:   The application builds a KD-tree and queries random points with the L1, L2 and Linf metrics
+ * Expected Output:	The neighbors are the same as the ones found with brute force
+ **/
+
+TEST(TestKnnSpatialIndex, KDTreeMatchesBruteForce) {
+
+    compare_with_brute_force<kernel::LpMetric<1>>(KnnIndexType::KD_TREE, 500, 3, 5);
+    compare_with_brute_force<kernel::LpMetric<2>>(KnnIndexType::KD_TREE, 500, 3, 5);
+    compare_with_brute_force<kernel::LpMetric<2, false>>(KnnIndexType::KD_TREE, 500, 3, 5);
+    compare_with_brute_force<kernel::LpMetric<4, false>>(KnnIndexType::KD_TREE, 500, 3, 5);
+}
+
+/***
+ * Test Scenario:   The application builds a ball tree and queries random points in higher dimension
+ * Expected Output:	The neighbors are the same as the ones found with brute force
+ **/
+
+TEST(TestKnnSpatialIndex, BallTreeMatchesBruteForce) {
+
+    compare_with_brute_force<kernel::LpMetric<1>>(KnnIndexType::BALL_TREE, 500, 20, 7);
+    compare_with_brute_force<kernel::LpMetric<2>>(KnnIndexType::BALL_TREE, 500, 20, 7);
+}
@@ -3,8 +3,17 @@
 #include "cubic_engine/ml/loss_functions/mse_loss.h"
 #include "cubic_engine/ml/loss_functions/categorical_cross_entropy.h"
 #include "kernel/maths/functions/real_vector_polynomial.h"
+#include "kernel/maths/functions/sigmoid_function.h"
+#include "kernel/numerics/optimization/stochastic_gradient_descent.h"
+#include "kernel/numerics/optimization/gd_control.h"
+#include "kernel/parallel/threading/thread_pool.h"
 #include "cubic_engine/ml/datasets/blaze_regression_dataset.h"
+#include "cubic_engine/ml/datasets/streaming_regression_dataset.h"
+#include "cubic_engine/ml/datasets/columnar_dataset_format.h"
 
+#include <cmath>
+#include <cstdio>
+#include <random>
 #include <vector>
 #include <map>
 #include <string>
@@ -17,11 +26,69 @@ namespace {
 using cengine::DynMat;
 using cengine::DynVec;
 using cengine::real_t;
+using cengine::uint_t;
+using cengine::Null;
 using kernel::PolynomialFunction;
+using kernel::SigmoidFunction;
 using cengine::ml::SSELoss;
 using cengine::ml::MSELoss;
 using cengine::ml::CategoricalCrossEntropy;
 using cengine::ml::BlazeRegressionDataset;
+using cengine::ml::StreamingRegressionDataset;
+using cengine::ml::StreamingDatasetConfig;
+
+/// Fill a dataset with an intercept column and labels 1 + sum_c c*x_c
+void random_dataset(BlazeRegressionDataset& dataset, uint_t n_rows, uint_t n_features){
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<real_t> distribution(-1.0, 1.0);
+
+    DynMat<real_t> features(n_rows, n_features);
+    DynVec<real_t> labels(n_rows);
+
+    for(uint_t r=0; r<n_rows; ++r){
+
+        features(r, 0) = 1.0;
+        labels[r] = 1.0;
+
+        for(uint_t c=1; c<n_features; ++c){
+            features(r, c) = distribution(generator);
+            labels[r] += c*features(r, c);
+        }
+    }
+
+    dataset.load_from_data(features, labels);
+}
+
+/// The residuals link(w^T x) - y of the rows [begin, end) and the gradients X^T r
+real_t reference_gradients(const BlazeRegressionDataset& dataset, const std::vector<real_t>& w,
+                           uint_t begin, uint_t end, bool sigmoid, DynVec<real_t>& gradients){
+
+    gradients = DynVec<real_t>(w.size(), 0.0);
+    real_t sse = 0.0;
+
+    for(uint_t r=begin; r<end; ++r){
+
+        auto [row, label] = dataset[r];
+
+        real_t prediction = 0.0;
+        for(uint_t c=0; c<w.size(); ++c){
+            prediction += w[c]*row[c];
+        }
+
+        if(sigmoid){
+            prediction = 1.0/(1.0 + std::exp(-prediction));
+        }
+
+        for(uint_t c=0; c<w.size(); ++c){
+            gradients[c] += (prediction - label)*row[c];
+        }
+
+        sse += (prediction - label)*(prediction - label);
+    }
+
+    return sse;
+}
 
 /*struct TestSetLoader{
 
@@ -97,9 +164,12 @@ TEST(TestSSELoss, Param_Gradient_At) {
 
         auto grads = loss.param_gradient_at(p, val);
 
+        // the derivative of (y - f)^2 is -2(y - f)df/dw
+        const auto residual = val - model.value_at(p);
+
         ASSERT_EQ(grads.size(), 2);
-        ASSERT_DOUBLE_EQ(grads[0], -2.0 * err * p[0]);
-        ASSERT_DOUBLE_EQ(grads[1], -2.0 * err * p[1]);
+        ASSERT_DOUBLE_EQ(grads[0], -2.0 * residual * p[0]);
+        ASSERT_DOUBLE_EQ(grads[1], -2.0 * residual * p[1]);
     }
     catch(...){
         FAIL()<<"A non expected exception was thrown";
@@ -107,6 +177,117 @@ TEST(TestSSELoss, Param_Gradient_At) {
 }
 
 
+TEST(TestSSELoss, BatchGradients) {
+
+    /***
+       * Test Scenario:    The application computes the SSE and its gradients on a block of
+       *                   rows of a dataset with a linear and a second order model
+       * Expected Output:  The linear model gives 2X^T(Xw - y) and the SSE of the block. The
+       *                   second order model adds up the row gradients. An invalid block throws
+     **/
+
+    BlazeRegressionDataset dataset;
+    random_dataset(dataset, 50, 4);
+
+    std::vector<real_t> coeffs = {0.5, -1.0, 0.25, 2.0};
+    PolynomialFunction model(coeffs);
+    SSELoss<PolynomialFunction, BlazeRegressionDataset> loss(model);
+
+    DynVec<real_t> expected;
+    const auto expected_sse = reference_gradients(dataset, coeffs, 10, 35, false, expected);
+
+    DynVec<real_t> gradients;
+    const auto sse = loss.batch_gradients(dataset, 10, 35, gradients);
+
+    ASSERT_NEAR(sse, expected_sse, 1.0e-10);
+    ASSERT_EQ(gradients.size(), coeffs.size());
+
+    for(uint_t c=0; c<coeffs.size(); ++c){
+        ASSERT_NEAR(gradients[c], 2.0*expected[c], 1.0e-10);
+    }
+
+    // the batch gradients are the sum of the per example gradients
+    // SGD uses with a batch size of one
+    const auto row_sum = loss.params_gradients(dataset);
+    loss.batch_gradients(dataset, 0, dataset.n_examples(), gradients);
+
+    for(uint_t c=0; c<coeffs.size(); ++c){
+        ASSERT_NEAR(gradients[c], row_sum[c], 1.0e-10);
+    }
+
+    // a polynomial with a second order term uses the row path
+    DynVec<real_t> quad_coeffs(coeffs.size());
+    for(uint_t c=0; c<coeffs.size(); ++c){
+        quad_coeffs[c] = coeffs[c];
+    }
+
+    PolynomialFunction quad_model(quad_coeffs, {1, 1, 2, 1});
+    SSELoss<PolynomialFunction, BlazeRegressionDataset> quad_loss(quad_model);
+
+    real_t quad_sse = 0.0;
+    DynVec<real_t> quad_expected(coeffs.size(), 0.0);
+    for(uint_t r=0; r<dataset.n_examples(); ++r){
+
+        auto [row, label] = dataset[r];
+        const auto error = label - quad_model.value_at(row);
+        const auto grads = quad_model.param_grads_at(row);
+
+        for(uint_t c=0; c<coeffs.size(); ++c){
+            quad_expected[c] += -2.0*error*grads[c];
+        }
+
+        quad_sse += error*error;
+    }
+
+    ASSERT_NEAR(quad_loss.batch_gradients(dataset, 0, dataset.n_examples(), gradients), quad_sse, 1.0e-10);
+    ASSERT_NEAR(quad_sse, quad_loss.evaluate(dataset), 1.0e-10);
+
+    for(uint_t c=0; c<coeffs.size(); ++c){
+        ASSERT_NEAR(gradients[c], quad_expected[c], 1.0e-10);
+    }
+
+    ASSERT_THROW(loss.batch_gradients(dataset, 10, 51, gradients), std::logic_error);
+    ASSERT_THROW(loss.batch_gradients(dataset, 20, 10, gradients), std::logic_error);
+}
+
+TEST(TestSSELoss, ThreadedBatchGradients) {
+
+    /***
+       * Test Scenario:    The application computes the gradients of a batch with the rows
+       *                   partitioned among the threads of a ThreadPool
+       * Expected Output:  The SSE and the gradients are the ones of the serial computation
+     **/
+
+    BlazeRegressionDataset dataset;
+    random_dataset(dataset, 103, 5);
+
+    PolynomialFunction model(std::vector<real_t>(5, 0.3));
+    SSELoss<PolynomialFunction, BlazeRegressionDataset> loss(model);
+
+    kernel::ThreadPool pool(4);
+
+    DynVec<real_t> serial;
+    DynVec<real_t> threaded;
+
+    const auto serial_sse = loss.batch_gradients(dataset, 0, dataset.n_examples(), serial);
+    const auto threaded_sse = loss.batch_gradients(dataset, 0, dataset.n_examples(), threaded, pool, Null());
+
+    ASSERT_NEAR(serial_sse, threaded_sse, 1.0e-10);
+    ASSERT_EQ(serial.size(), threaded.size());
+
+    for(uint_t c=0; c<serial.size(); ++c){
+        ASSERT_NEAR(serial[c], threaded[c], 1.0e-10);
+    }
+
+    // a batch with fewer rows than threads
+    loss.batch_gradients(dataset, 7, 9, serial);
+    loss.batch_gradients(dataset, 7, 9, threaded, pool, Null());
+
+    for(uint_t c=0; c<serial.size(); ++c){
+        ASSERT_NEAR(serial[c], threaded[c], 1.0e-10);
+    }
+}
+
 TEST(TestMSELoss, Constructor) {
 
     try{
@@ -121,6 +302,156 @@ TEST(TestMSELoss, Constructor) {
 }
 
 
+TEST(TestMSELoss, BatchGradients) {
+
+    /***
+       * Test Scenario:    The application computes the MSE and its gradients on a block of rows
+       * Expected Output:  The values are the ones of SSELoss divided by the number of rows
+     **/
+
+    BlazeRegressionDataset dataset;
+    random_dataset(dataset, 40, 3);
+
+    PolynomialFunction model(std::vector<real_t>({1.0, 0.5, -0.5}));
+    SSELoss<PolynomialFunction, BlazeRegressionDataset> sse_loss(model);
+    MSELoss<PolynomialFunction, BlazeRegressionDataset> mse_loss(model);
+
+    DynVec<real_t> sse_grads;
+    DynVec<real_t> mse_grads;
+
+    const auto sse = sse_loss.batch_gradients(dataset, 5, 25, sse_grads);
+    const auto mse = mse_loss.batch_gradients(dataset, 5, 25, mse_grads);
+
+    ASSERT_NEAR(mse, sse/20.0, 1.0e-10);
+
+    for(uint_t c=0; c<sse_grads.size(); ++c){
+        ASSERT_NEAR(mse_grads[c], sse_grads[c]/20.0, 1.0e-10);
+    }
+
+    kernel::ThreadPool pool(3);
+    DynVec<real_t> threaded;
+    ASSERT_NEAR(mse_loss.batch_gradients(dataset, 5, 25, threaded, pool, Null()), mse, 1.0e-10);
+
+    for(uint_t c=0; c<sse_grads.size(); ++c){
+        ASSERT_NEAR(threaded[c], mse_grads[c], 1.0e-10);
+    }
+}
+
+TEST(TestMSELoss, MiniBatchSGD) {
+
+    /***
+       * Test Scenario:    The application fits a linear model with SGD in mini-batch mode
+       *                   using the batched gradients of MSELoss
+       * Expected Output:  The coefficients of the labels are recovered
+     **/
+
+    BlazeRegressionDataset dataset;
+    random_dataset(dataset, 500, 4);
+
+    PolynomialFunction model(std::vector<real_t>(4, 0.0));
+    MSELoss<PolynomialFunction, BlazeRegressionDataset> loss(model);
+
+    kernel::numerics::opt::GDConfig config(500, 1.0e-10, 0.5, 20);
+    kernel::numerics::opt::SGD<BlazeRegressionDataset, MSELoss<PolynomialFunction, BlazeRegressionDataset>> sgd(config);
+
+    sgd.solve(dataset, loss);
+
+    const auto result = model.coeffs();
+    ASSERT_NEAR(result[0], 1.0, 1.0e-4);
+
+    for(uint_t c=1; c<result.size(); ++c){
+        ASSERT_NEAR(result[c], static_cast<real_t>(c), 1.0e-4);
+    }
+}
+
+TEST(TestMSELoss, PerExampleSGD) {
+
+    /***
+       * Test Scenario:    The application fits a linear model with SGD updating
+       *                   the coefficients after every example
+       * Expected Output:  The coefficients of the labels are recovered
+     **/
+
+    BlazeRegressionDataset dataset;
+    random_dataset(dataset, 500, 4);
+
+    PolynomialFunction model(std::vector<real_t>(4, 0.0));
+    MSELoss<PolynomialFunction, BlazeRegressionDataset> loss(model);
+
+    kernel::numerics::opt::GDConfig config(100, 1.0e-10, 0.05, 1);
+    kernel::numerics::opt::SGD<BlazeRegressionDataset, MSELoss<PolynomialFunction, BlazeRegressionDataset>> sgd(config);
+
+    sgd.solve(dataset, loss);
+
+    const auto result = model.coeffs();
+    ASSERT_NEAR(result[0], 1.0, 1.0e-4);
+
+    for(uint_t c=1; c<result.size(); ++c){
+        ASSERT_NEAR(result[c], static_cast<real_t>(c), 1.0e-4);
+    }
+}
+
+TEST(TestSSELoss, StreamingDatasetSGD) {
+
+    /***
+       * Test Scenario:    The application fits a linear model with SGD on a dataset streamed from
+       *                   a file, once per example and once in mini-batch mode. The streamed
+       *                   dataset has no feature matrix so the batch gradients are added up row by row
+       * Expected Output:  Both runs recover the coefficients and the mini-batch run gives the
+       *                   coefficients of the same run on the in-memory dataset
+     **/
+
+    const std::string file_name = "test_loss_functions_streaming.bin";
+
+    BlazeRegressionDataset dataset;
+    random_dataset(dataset, 200, 4);
+
+    DynMat<real_t> features = dataset.feature_matrix();
+    DynVec<real_t> labels = dataset.labels();
+    cengine::ml::write_columnar_dataset(file_name, features, labels, {{"x0", 0}, {"x1", 1}, {"x2", 2}, {"x3", 3}}, "y");
+
+    StreamingDatasetConfig stream_config;
+    stream_config.chunk_rows = 64;
+    StreamingRegressionDataset stream(file_name, stream_config);
+
+    typedef SSELoss<PolynomialFunction, StreamingRegressionDataset> stream_loss_t;
+    typedef SSELoss<PolynomialFunction, BlazeRegressionDataset> memory_loss_t;
+
+    PolynomialFunction per_example_model(std::vector<real_t>(4, 0.0));
+    stream_loss_t per_example_loss(per_example_model);
+
+    kernel::numerics::opt::SGD<StreamingRegressionDataset, stream_loss_t> per_example_sgd(kernel::numerics::opt::GDConfig(100, 1.0e-10, 0.02, 1));
+    per_example_sgd.solve(stream, per_example_loss);
+
+    // the SSE gradients of a batch are summed so the learning rate is smaller
+    PolynomialFunction stream_model(std::vector<real_t>(4, 0.0));
+    stream_loss_t stream_loss(stream_model);
+
+    kernel::numerics::opt::SGD<StreamingRegressionDataset, stream_loss_t> stream_sgd(kernel::numerics::opt::GDConfig(100, 1.0e-10, 0.01, 16));
+    stream_sgd.solve(stream, stream_loss);
+
+    PolynomialFunction memory_model(std::vector<real_t>(4, 0.0));
+    memory_loss_t memory_loss(memory_model);
+
+    kernel::numerics::opt::SGD<BlazeRegressionDataset, memory_loss_t> memory_sgd(kernel::numerics::opt::GDConfig(100, 1.0e-10, 0.01, 16));
+    memory_sgd.solve(dataset, memory_loss);
+
+    const auto per_example = per_example_model.coeffs();
+    const auto streamed = stream_model.coeffs();
+    const auto in_memory = memory_model.coeffs();
+
+    for(uint_t c=0; c<streamed.size(); ++c){
+
+        const real_t expected = c == 0 ? 1.0 : static_cast<real_t>(c);
+        ASSERT_NEAR(per_example[c], expected, 1.0e-4);
+        ASSERT_NEAR(streamed[c], expected, 1.0e-4);
+        ASSERT_NEAR(streamed[c], in_memory[c], 1.0e-8);
+    }
+
+    stream.close();
+    std::remove(file_name.c_str());
+}
+
 TEST(TestCategoricalCrossEntropy, Constructor) {
 
     try{
@@ -134,17 +465,92 @@ TEST(TestCategoricalCrossEntropy, Constructor) {
     }
 }
 
+TEST(TestCategoricalCrossEntropy, BatchGradients) {
 
+    /***
+       * Test Scenario:    The application computes the cross entropy and its gradients on a
+       *                   block of rows for a sigmoid of a linear model
+       * Expected Output:  The gradients are X^T(h - y)/n and the loss is the mean cross entropy
+       *                   of the rows. The threaded computation gives the same values
+     **/
 
+    BlazeRegressionDataset dataset;
+    random_dataset(dataset, 60, 3);
 
+    // binary labels
+    auto& labels = dataset.labels();
+    for(uint_t r=0; r<labels.size(); ++r){
+        labels[r] = labels[r] > 1.0 ? 1.0 : 0.0;
+    }
+
+    std::vector<real_t> coeffs = {0.1, 0.8, -0.4};
+    PolynomialFunction polynomial(coeffs);
+    SigmoidFunction<PolynomialFunction> model(polynomial);
+    CategoricalCrossEntropy<SigmoidFunction<PolynomialFunction>, BlazeRegressionDataset> loss(model);
+
+    DynVec<real_t> expected;
+    reference_gradients(dataset, coeffs, 0, 60, true, expected);
+
+    DynVec<real_t> gradients;
+    const auto value = loss.batch_gradients(dataset, 0, 60, gradients);
+
+    for(uint_t c=0; c<coeffs.size(); ++c){
+        ASSERT_NEAR(gradients[c], expected[c]/60.0, 1.0e-10);
+    }
+
+    ASSERT_NEAR(value, loss.evaluate(dataset), 1.0e-10);
+
+    kernel::ThreadPool pool(4);
+    DynVec<real_t> threaded;
+    ASSERT_NEAR(loss.batch_gradients(dataset, 0, 60, threaded, pool, Null()), value, 1.0e-10);
 
+    for(uint_t c=0; c<coeffs.size(); ++c){
+        ASSERT_NEAR(threaded[c], gradients[c], 1.0e-10);
+    }
+}
+
+TEST(TestCategoricalCrossEntropy, StreamingBatchGradients) {
+
+    /***
+       * Test Scenario:    The application computes the cross entropy and its gradients for a
+       *                   sigmoid of a linear model on a dataset streamed from a file
+       * Expected Output:  The row by row path gives the values of the in-memory dataset
+     **/
 
+    const std::string file_name = "test_loss_functions_cce_streaming.bin";
 
+    BlazeRegressionDataset dataset;
+    random_dataset(dataset, 60, 3);
 
+    auto& labels = dataset.labels();
+    for(uint_t r=0; r<labels.size(); ++r){
+        labels[r] = labels[r] > 1.0 ? 1.0 : 0.0;
+    }
+
+    DynMat<real_t> features = dataset.feature_matrix();
+    cengine::ml::write_columnar_dataset(file_name, features, labels, {{"x0", 0}, {"x1", 1}, {"x2", 2}}, "y");
 
+    StreamingDatasetConfig stream_config;
+    stream_config.chunk_rows = 16;
+    StreamingRegressionDataset stream(file_name, stream_config);
 
+    std::vector<real_t> coeffs = {0.1, 0.8, -0.4};
+    PolynomialFunction polynomial(coeffs);
+    SigmoidFunction<PolynomialFunction> model(polynomial);
 
+    CategoricalCrossEntropy<SigmoidFunction<PolynomialFunction>, BlazeRegressionDataset> memory_loss(model);
+    CategoricalCrossEntropy<SigmoidFunction<PolynomialFunction>, StreamingRegressionDataset> stream_loss(model);
 
+    DynVec<real_t> expected;
+    const auto expected_value = memory_loss.batch_gradients(dataset, 10, 50, expected);
 
+    DynVec<real_t> gradients;
+    ASSERT_NEAR(stream_loss.batch_gradients(stream, 10, 50, gradients), expected_value, 1.0e-10);
 
+    for(uint_t c=0; c<coeffs.size(); ++c){
+        ASSERT_NEAR(gradients[c], expected[c], 1.0e-10);
+    }
 
+    stream.close();
+    std::remove(file_name.c_str());
+}
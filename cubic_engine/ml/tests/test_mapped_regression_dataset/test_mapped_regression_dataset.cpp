@@ -0,0 +1,124 @@
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "cubic_engine/ml/datasets/mapped_regression_dataset.h"
+#include "cubic_engine/ml/datasets/columnar_dataset_format.h"
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+namespace {
+using cengine::DynMat;
+using cengine::DynVec;
+using cengine::real_t;
+using cengine::uint_t;
+using cengine::ml::MappedRegressionDataset;
+
+const std::string FILE_NAME = "test_mapped_regression_dataset.bin";
+const std::string CSV_FILE_NAME = "test_mapped_regression_dataset.csv";
+
+}
+
+TEST(TestMappedRegressionDataset, Empty) {
+
+    MappedRegressionDataset dataset;
+
+    ASSERT_TRUE(dataset.empty());
+    ASSERT_EQ(dataset.n_features(), 0);
+    ASSERT_EQ(dataset.n_examples(), 0);
+}
+
+TEST(TestMappedRegressionDataset, WriteAndOpen) {
+
+    /***
+       * Test Scenario:    The application writes a dataset in the binary format and maps it
+       * Expected Output:  The mapped features, labels and columns are the ones written
+     **/
+
+    DynMat<real_t> features(5, 3);
+    DynVec<real_t> labels(5);
+
+    for(uint_t r=0; r<5; ++r){
+        for(uint_t c=0; c<3; ++c){
+            features(r, c) = 10.0*r + c;
+        }
+
+        labels[r] = -1.0*r;
+    }
+
+    std::map<std::string, uint_t> columns = {{"a", 0}, {"b", 1}, {"c", 2}};
+    cengine::ml::write_columnar_dataset(FILE_NAME, features, labels, columns, "y");
+
+    MappedRegressionDataset dataset(FILE_NAME);
+
+    ASSERT_EQ(dataset.n_examples(), 5);
+    ASSERT_EQ(dataset.n_features(), 3);
+    ASSERT_EQ(dataset.columns().at("c"), 2);
+    ASSERT_EQ(dataset.label_name(), "y");
+    ASSERT_DOUBLE_EQ(dataset.feature_matrix()(3, 2), 32.0);
+    ASSERT_DOUBLE_EQ(dataset.get_label(4), -4.0);
+
+    auto [row, label] = dataset[2];
+    ASSERT_DOUBLE_EQ(row[1], 21.0);
+    ASSERT_DOUBLE_EQ(label, -2.0);
+
+    real_t sum = 0.0;
+    dataset.iterate([&sum](const auto& row, const auto& label){sum += row[0] + label;});
+    ASSERT_DOUBLE_EQ(sum, 90.0);
+
+    auto tail = dataset.accumulate([](const auto& row, const auto&){return row[0];}, 2, cengine::ml::PointTp::END);
+    ASSERT_DOUBLE_EQ(tail[0], 40.0);
+    ASSERT_DOUBLE_EQ(tail[1], 30.0);
+
+    dataset.close();
+    ASSERT_TRUE(dataset.empty());
+
+    std::remove(FILE_NAME.c_str());
+}
+
+TEST(TestMappedRegressionDataset, ConvertFromCSV) {
+
+    /***
+       * Test Scenario:    The application converts a CSV file to the binary format
+       * Expected Output:  The mapped dataset has the data and the header names of the CSV file
+     **/
+
+    {
+        std::ofstream file(CSV_FILE_NAME);
+        file<<"x1,x2,y\n1.0,2.0,3.0\n4.0,5.0,6.0\n";
+    }
+
+    cengine::ml::convert_csv_to_columnar(CSV_FILE_NAME, FILE_NAME);
+
+    MappedRegressionDataset dataset(FILE_NAME);
+
+    ASSERT_EQ(dataset.n_examples(), 2);
+    ASSERT_EQ(dataset.n_features(), 2);
+    ASSERT_EQ(dataset.columns().at("x2"), 1);
+    ASSERT_DOUBLE_EQ(dataset.feature_matrix()(1, 0), 4.0);
+    ASSERT_DOUBLE_EQ(dataset.labels()[1], 6.0);
+
+    std::remove(CSV_FILE_NAME.c_str());
+    std::remove(FILE_NAME.c_str());
+}
+
+TEST(TestMappedRegressionDataset, InvalidFile) {
+
+    /***
+       * Test Scenario:    The application opens a missing file and a file that is not a binary dataset
+       * Expected Output:  std::logic_error is thrown
+     **/
+
+    std::remove(FILE_NAME.c_str());
+    ASSERT_THROW(MappedRegressionDataset dataset(FILE_NAME), std::logic_error);
+
+    {
+        std::ofstream file(FILE_NAME);
+        file<<std::string(256, 'x');
+    }
+
+    ASSERT_THROW(MappedRegressionDataset dataset(FILE_NAME), std::logic_error);
+    std::remove(FILE_NAME.c_str());
+}
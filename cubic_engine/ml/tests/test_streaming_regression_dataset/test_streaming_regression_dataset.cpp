@@ -0,0 +1,178 @@
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "cubic_engine/ml/datasets/streaming_regression_dataset.h"
+#include "cubic_engine/ml/datasets/columnar_dataset_format.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+namespace {
+using cengine::DynMat;
+using cengine::DynVec;
+using cengine::real_t;
+using cengine::uint_t;
+using cengine::ml::StreamingRegressionDataset;
+using cengine::ml::StreamingDatasetConfig;
+
+const std::string FILE_NAME = "test_streaming_regression_dataset.bin";
+
+/// Write n_rows rows with features (r, 10*r) and label -r
+void write_dataset(uint_t n_rows){
+
+    DynMat<real_t> features(n_rows, 2);
+    DynVec<real_t> labels(n_rows);
+
+    for(uint_t r=0; r<n_rows; ++r){
+        features(r, 0) = r;
+        features(r, 1) = 10.0*r;
+        labels[r] = -1.0*r;
+    }
+
+    cengine::ml::write_columnar_dataset(FILE_NAME, features, labels, {{"a", 0}, {"b", 1}}, "y");
+}
+
+}
+
+TEST(TestStreamingRegressionDataset, Empty) {
+
+    StreamingRegressionDataset dataset;
+
+    ASSERT_TRUE(dataset.empty());
+    ASSERT_EQ(dataset.n_features(), 0);
+    ASSERT_EQ(dataset.n_examples(), 0);
+    ASSERT_EQ(dataset.n_chunks(), 0);
+}
+
+TEST(TestStreamingRegressionDataset, StreamInFileOrder) {
+
+    /***
+       * Test Scenario:    The application streams a dataset of 10 rows in chunks of 3 rows
+       * Expected Output:  The rows, labels and columns are the ones written and a
+       *                   sequential pass reads every chunk once
+     **/
+
+    write_dataset(10);
+
+    StreamingDatasetConfig config;
+    config.chunk_rows = 3;
+
+    StreamingRegressionDataset dataset(FILE_NAME, config);
+
+    ASSERT_EQ(dataset.n_examples(), 10);
+    ASSERT_EQ(dataset.n_features(), 2);
+    ASSERT_EQ(dataset.n_chunks(), 4);
+    ASSERT_EQ(dataset.columns().at("b"), 1);
+    ASSERT_EQ(dataset.label_name(), "y");
+
+    for(uint_t i=0; i<dataset.n_examples(); ++i){
+        auto [row, label] = dataset[i];
+        ASSERT_DOUBLE_EQ(row[0], i);
+        ASSERT_DOUBLE_EQ(row[1], 10.0*i);
+        ASSERT_DOUBLE_EQ(label, -1.0*i);
+    }
+
+    // the last chunk may already have
+    // prefetched the first one
+    ASSERT_GE(dataset.n_chunk_reads(), 4);
+    ASSERT_LE(dataset.n_chunk_reads(), 5);
+
+    real_t sum = 0.0;
+    dataset.iterate([&sum](const auto& row, const auto& label){sum += row[0] + label;});
+    ASSERT_DOUBLE_EQ(sum, 0.0);
+
+    auto head = dataset.accumulate([](const auto& row, const auto&){return row[1];}, 4);
+    ASSERT_DOUBLE_EQ(head[3], 30.0);
+
+    auto tail = dataset.accumulate([](const auto& row, const auto&){return row[0];}, 2, cengine::ml::PointTp::END);
+    ASSERT_DOUBLE_EQ(tail[0], 9.0);
+    ASSERT_DOUBLE_EQ(tail[1], 8.0);
+
+    ASSERT_DOUBLE_EQ(dataset.get_row(7)[1], 70.0);
+
+    dataset.close();
+    ASSERT_TRUE(dataset.empty());
+
+    std::remove(FILE_NAME.c_str());
+}
+
+TEST(TestStreamingRegressionDataset, ShuffledEpochs) {
+
+    /***
+       * Test Scenario:    The application streams a dataset with shuffled chunks for several epochs
+       * Expected Output:  Every epoch visits every row once with its own label, the chunk
+       *                   order changes between the epochs and accumulate follows the file order
+     **/
+
+    const uint_t n_rows = 100;
+    write_dataset(n_rows);
+
+    StreamingDatasetConfig config;
+    config.chunk_rows = 7;
+    config.shuffle_chunks = true;
+
+    StreamingRegressionDataset dataset(FILE_NAME, config);
+
+    std::vector<std::vector<uint_t>> orders;
+
+    for(uint_t epoch=0; epoch<3; ++epoch){
+
+        std::vector<uint_t> visited(n_rows, 0);
+        std::vector<uint_t> order;
+
+        for(uint_t i=0; i<dataset.n_examples(); ++i){
+
+            auto [row, label] = dataset[i];
+            const auto r = static_cast<uint_t>(row[0]);
+
+            ASSERT_DOUBLE_EQ(label, -row[0]);
+            visited[r] += 1;
+            order.push_back(r);
+        }
+
+        ASSERT_EQ(dataset.epoch(), epoch);
+        ASSERT_EQ(std::count(visited.begin(), visited.end(), 1), n_rows);
+        orders.push_back(order);
+    }
+
+    ASSERT_NE(orders[0], orders[1]);
+    ASSERT_NE(orders[1], orders[2]);
+
+    auto values = dataset.accumulate([](const auto& row, const auto& label){return row[0] - label;}, n_rows);
+
+    for(uint_t r=0; r<n_rows; ++r){
+        ASSERT_DOUBLE_EQ(values[r], 2.0*r);
+        ASSERT_DOUBLE_EQ(dataset.labels()[r], -1.0*r);
+    }
+
+    std::remove(FILE_NAME.c_str());
+}
+
+TEST(TestStreamingRegressionDataset, InvalidFile) {
+
+    /***
+       * Test Scenario:    The application opens a missing file, a file that is not a
+       *                   binary dataset and uses chunks without rows
+       * Expected Output:  std::logic_error is thrown
+     **/
+
+    std::remove(FILE_NAME.c_str());
+    ASSERT_THROW(StreamingRegressionDataset dataset(FILE_NAME), std::logic_error);
+
+    {
+        std::ofstream file(FILE_NAME);
+        file<<std::string(256, 'x');
+    }
+
+    ASSERT_THROW(StreamingRegressionDataset dataset(FILE_NAME), std::logic_error);
+
+    StreamingDatasetConfig config;
+    config.chunk_rows = 0;
+    ASSERT_THROW(StreamingRegressionDataset dataset(config), std::logic_error);
+
+    std::remove(FILE_NAME.c_str());
+}
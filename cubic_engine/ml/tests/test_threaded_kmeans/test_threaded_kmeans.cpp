@@ -0,0 +1,171 @@
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "cubic_engine/ml/unsupervised_learning/threaded_kmeans.h"
+#include "cubic_engine/ml/unsupervised_learning/utils/kmeans_control.h"
+#include "cubic_engine/ml/unsupervised_learning/utils/cluster.h"
+#include "kernel/parallel/threading/thread_pool.h"
+#include "kernel/data_structs/data_set_wrapper.hpp"
+#include "kernel/maths/lp_metric.h"
+
+#include <vector>
+#include <random>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+namespace {
+
+using cengine::DynMat;
+using cengine::DynVec;
+using cengine::real_t;
+using cengine::uint_t;
+using cengine::Null;
+using cengine::Cluster;
+using cengine::KMeansConfig;
+using cengine::ml::ThreadedKMeans;
+
+typedef DynVec<real_t> point_t;
+typedef kernel::data_structs::DataSetWrapper<DynMat<real_t>> dataset_t;
+typedef ThreadedKMeans<Cluster<point_t>> kmeans_t;
+typedef kernel::LpMetric<2> similarity_t;
+
+const uint_t N_THREADS = 3;
+const uint_t N_BLOBS = 4;
+const uint_t N_POINTS = 2000;
+
+/// \brief Points around N_BLOBS centers far from each other.
+/// Point r belongs to blob r % N_BLOBS
+void blobs(dataset_t& dataset){
+
+    std::mt19937 generator(1);
+    std::normal_distribution<real_t> distribution(0.0, 1.0);
+
+    DynMat<real_t> data(N_POINTS, 2);
+    for(uint_t r=0; r<N_POINTS; ++r){
+        data(r, 0) = 20.0*(r % N_BLOBS) + distribution(generator);
+        data(r, 1) = -10.0*(r % N_BLOBS) + distribution(generator);
+    }
+
+    dataset.load_from(data);
+}
+
+/// \brief Start from the first points. They belong to different blobs
+void init(const dataset_t& data, uint_t k, std::vector<point_t>& centroids){
+
+    for(uint_t c=0; c<k; ++c){
+        centroids.push_back(data.get_row(c));
+    }
+}
+
+}
+
+/***
+ * Test Scenario:   The application clusters well separated blobs with ThreadedKMeans
+ * Expected Output:	Every blob is one cluster and the labels agree with the clusters
+ **/
+
+TEST(TestThreadedKMeans, ClusterBlobs) {
+
+    dataset_t data;
+    blobs(data);
+    kernel::ThreadPool pool(N_THREADS);
+
+    KMeansConfig control(N_BLOBS, 100);
+    control.use_distance_bounds = false;
+
+    kmeans_t kmeans(control);
+    auto info = kmeans.cluster(data, similarity_t(), init, pool, Null());
+
+    ASSERT_TRUE(info.converged);
+    ASSERT_EQ(info.n_clustering_points, N_POINTS);
+
+    const auto& labels = kmeans.get_labels();
+    const auto& clusters = kmeans.get_clusters();
+
+    ASSERT_EQ(labels.size(), N_POINTS);
+    ASSERT_EQ(clusters.size(), N_BLOBS);
+
+    for(uint_t r=0; r<N_POINTS; ++r){
+        ASSERT_EQ(labels[r], r % N_BLOBS);
+    }
+
+    for(const auto& cluster : clusters){
+        ASSERT_EQ(cluster.n_points(), N_POINTS/N_BLOBS);
+
+        for(auto p : cluster.points){
+            ASSERT_EQ(labels[p], cluster.id);
+        }
+    }
+}
+
+/***
+ * Test Scenario:   The application clusters the same data with and without the distance bounds
+ * Expected Output:	The labels and centroids are equal and less distances are computed with the bounds
+ **/
+
+TEST(TestThreadedKMeans, BoundsGiveSameClusters) {
+
+    dataset_t data;
+    blobs(data);
+    kernel::ThreadPool pool(N_THREADS);
+
+    // a wrong number of clusters so that the points move
+    KMeansConfig control(N_BLOBS + 2, 100);
+
+    control.use_distance_bounds = false;
+    kmeans_t lloyd(control);
+    lloyd.cluster(data, similarity_t(), init, pool, Null());
+
+    control.use_distance_bounds = true;
+    kmeans_t bounded(control);
+    bounded.cluster(data, similarity_t(), init, pool, Null());
+
+    ASSERT_EQ(lloyd.get_labels(), bounded.get_labels());
+    ASSERT_LT(bounded.n_distance_computations(), lloyd.n_distance_computations());
+
+    for(uint_t c=0; c<control.k; ++c){
+        for(uint_t i=0; i<2; ++i){
+            ASSERT_NEAR(lloyd.get_clusters()[c].centroid[i], bounded.get_clusters()[c].centroid[i], 1.0e-8);
+        }
+    }
+}
+
+/***
+ * Test Scenario:   The application clusters well separated blobs with mini-batch k-means
+ * Expected Output:	Every blob is one cluster
+ **/
+
+TEST(TestThreadedKMeans, MiniBatch) {
+
+    dataset_t data;
+    blobs(data);
+    kernel::ThreadPool pool(N_THREADS);
+
+    KMeansConfig control(N_BLOBS, 50);
+    control.batch_size = 100;
+
+    kmeans_t kmeans(control);
+    auto info = kmeans.cluster(data, similarity_t(), init, pool, Null());
+
+    ASSERT_EQ(info.n_clustering_points, N_POINTS);
+
+    const auto& labels = kmeans.get_labels();
+    for(uint_t r=0; r<N_POINTS; ++r){
+        ASSERT_EQ(labels[r], r % N_BLOBS);
+    }
+}
+
+/***
+ * Test Scenario:   The application asks for more clusters than points
+ * Expected Output:	std::logic_error is thrown
+ **/
+
+TEST(TestThreadedKMeans, TooManyClusters) {
+
+    DynMat<real_t> matrix(2, 2, 0.0);
+    dataset_t data;
+    data.load_from(matrix);
+
+    kernel::ThreadPool pool(N_THREADS);
+    kmeans_t kmeans(KMeansConfig(3));
+
+    ASSERT_THROW(kmeans.cluster(data, similarity_t(), init, pool, Null()), std::logic_error);
+}
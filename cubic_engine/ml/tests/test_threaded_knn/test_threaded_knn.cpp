@@ -0,0 +1,242 @@
+#include "cubic_engine/base/cubic_engine_types.h"
+#include "cubic_engine/ml/instance_learning/threaded_knn.h"
+#include "cubic_engine/ml/instance_learning/knn_control.h"
+#include "cubic_engine/ml/instance_learning/details/knn_blocked_search.h"
+#include "cubic_engine/ml/instance_learning/details/knn_spatial_index.h"
+#include "cubic_engine/ml/instance_learning/details/knn_classification_policy.h"
+#include "cubic_engine/ml/instance_learning/details/knn_average_regression_policy.h"
+#include "kernel/parallel/threading/thread_pool.h"
+#include "kernel/parallel/utilities/partitioned_type.h"
+#include "kernel/parallel/utilities/array_partitioner.h"
+#include "kernel/maths/lp_metric.h"
+
+#include <vector>
+#include <random>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+namespace {
+
+using cengine::DynMat;
+using cengine::DynVec;
+using cengine::real_t;
+using cengine::uint_t;
+using cengine::Null;
+using cengine::ml::KnnControl;
+using cengine::ml::KnnIndexType;
+using cengine::ml::ThreadedKnn;
+using cengine::ml::KnnClassificationPolicy;
+using cengine::ml::KnnAvgRegressionPolicy;
+using cengine::ml::details::KnnBlockedSearch;
+using cengine::ml::details::KnnSpatialIndex;
+
+typedef kernel::PartitionedType<DynMat<real_t>> Matrix;
+typedef kernel::LpMetric<2> similarity_t;
+typedef std::pair<uint_t, real_t> Pair;
+
+const uint_t N_THREADS = 4;
+
+Matrix random_points(uint_t n, uint_t d, uint_t seed){
+
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<real_t> distribution(0.0, 1.0);
+
+    Matrix points(n, d);
+    for(uint_t r=0; r<n; ++r){
+        for(uint_t c=0; c<d; ++c){
+            points(r, c) = distribution(generator);
+        }
+    }
+
+    std::vector<kernel::range1d<uint_t>> partitions;
+    kernel::partition_range(static_cast<uint_t>(0), n, partitions, N_THREADS);
+    points.set_partitions(partitions);
+    return points;
+}
+
+}
+
+/***
+ * Test Scenario:   The application searches the neighbors of query points far from the origin
+ *                  with the blocked search
+ * Expected Output:	The neighbors and distances are equal to the ones found by scanning the points
+ **/
+
+TEST(TestKnnBlockedSearch, MatchesBruteForce) {
+
+    const uint_t d = 20;
+    const uint_t k = 5;
+
+    auto points = random_points(1000, d, 1);
+    auto queries = random_points(100, d, 2);
+
+    // the distances are small compared to the norms
+    for(uint_t r=0; r<points.rows(); ++r){
+        for(uint_t c=0; c<d; ++c){
+            points(r, c) += 100.0;
+        }
+    }
+
+    for(uint_t r=0; r<queries.rows(); ++r){
+        for(uint_t c=0; c<d; ++c){
+            queries(r, c) += 100.0;
+        }
+    }
+
+    KnnSpatialIndex<similarity_t> brute;
+    brute.build(points, KnnIndexType::BRUTE_FORCE);
+
+    KnnBlockedSearch<similarity_t> blocked(16, 128);
+    blocked.build(points);
+
+    uint_t n_queries = 0;
+    std::vector<Pair> expected;
+
+    blocked.query(queries, kernel::range1d<uint_t>(0, queries.rows()), k,
+                  [&](uint_t q, std::vector<Pair>& neighbors){
+
+        DynVec<real_t> point(d);
+        for(uint_t c=0; c<d; ++c){
+            point[c] = queries(q, c);
+        }
+
+        brute.query(point, k, expected);
+
+        ASSERT_EQ(neighbors.size(), k);
+        for(uint_t i=0; i<k; ++i){
+            ASSERT_EQ(neighbors[i].first, expected[i].first);
+            ASSERT_DOUBLE_EQ(neighbors[i].second, expected[i].second);
+        }
+
+        ++n_queries;
+    });
+
+    ASSERT_EQ(n_queries, queries.rows());
+}
+
+/***
+ * Test Scenario:   The application searches the neighbors with the blocked search when the points
+ *                  repeat a few rows so that many points are tied with the k-th neighbor
+ * Expected Output:	The neighbors and distances are equal to the ones found by scanning the points
+ **/
+
+TEST(TestKnnBlockedSearch, MatchesBruteForceWithTies) {
+
+    const uint_t d = 20;
+    const uint_t k = 3;
+    const uint_t n_distinct = 4;
+
+    auto distinct = random_points(n_distinct, d, 3);
+    auto points = random_points(2000, d, 1);
+    auto queries = random_points(50, d, 2);
+
+    for(uint_t r=0; r<points.rows(); ++r){
+        for(uint_t c=0; c<d; ++c){
+            points(r, c) = distinct(r % n_distinct, c);
+        }
+    }
+
+    KnnSpatialIndex<similarity_t> brute;
+    brute.build(points, KnnIndexType::BRUTE_FORCE);
+
+    KnnBlockedSearch<similarity_t> blocked(8, 64);
+    blocked.build(points);
+
+    std::vector<Pair> expected;
+
+    blocked.query(queries, kernel::range1d<uint_t>(0, queries.rows()), k,
+                  [&](uint_t q, std::vector<Pair>& neighbors){
+
+        DynVec<real_t> point(d);
+        for(uint_t c=0; c<d; ++c){
+            point[c] = queries(q, c);
+        }
+
+        brute.query(point, k, expected);
+
+        ASSERT_EQ(neighbors.size(), k);
+        for(uint_t i=0; i<k; ++i){
+            ASSERT_EQ(neighbors[i].first, expected[i].first);
+            ASSERT_DOUBLE_EQ(neighbors[i].second, expected[i].second);
+        }
+    });
+}
+
+/***
+ * Test Scenario:   The application predicts a batch of points with ThreadedKnn using a KD-tree,
+ *                  the blocked search and the per point scan
+ * Expected Output:	All the predictions are equal
+ **/
+
+TEST(TestThreadedKnn, BatchClassificationMatchesSinglePoint) {
+
+    typedef DynVec<uint_t> labels_t;
+    typedef ThreadedKnn<Matrix, labels_t, similarity_t, KnnClassificationPolicy> knn_t;
+
+    kernel::ThreadPool pool(N_THREADS);
+
+    auto points = random_points(500, 3, 1);
+    auto queries = random_points(50, 3, 2);
+
+    labels_t labels(points.rows());
+    for(uint_t r=0; r<points.rows(); ++r){
+        labels[r] = points(r, 0) < 0.5 ? 0 : 1;
+    }
+
+    knn_t tree(KnnControl(5, KnnIndexType::KD_TREE));
+    tree.train(points, labels);
+    ASSERT_TRUE(tree.has_index());
+
+    knn_t blocked(KnnControl(5, KnnIndexType::BRUTE_FORCE));
+    blocked.train(points, labels);
+    ASSERT_FALSE(blocked.has_index());
+
+    auto tree_result = tree.predict(queries, pool, Null());
+    auto blocked_result = blocked.predict(queries, pool, Null());
+
+    ASSERT_EQ(tree_result.first.size(), queries.rows());
+    ASSERT_EQ(blocked_result.second.n_pts_predicted, queries.rows());
+
+    for(uint_t r=0; r<queries.rows(); ++r){
+
+        auto point = kernel::matrix_row_trait<Matrix>::get_row(queries, r);
+        auto single = blocked.predict(point, pool, Null());
+
+        ASSERT_EQ(tree_result.first[r], single.first);
+        ASSERT_EQ(blocked_result.first[r], single.first);
+    }
+}
+
+/***
+ * Test Scenario:   The application predicts a batch of high dimensional points with ThreadedKnn
+ *                  and the average regression policy
+ * Expected Output:	AUTO does not build a tree and the predictions are equal to the single point predictions
+ **/
+
+TEST(TestThreadedKnn, BatchRegressionMatchesSinglePoint) {
+
+    typedef DynVec<real_t> labels_t;
+    typedef ThreadedKnn<Matrix, labels_t, similarity_t, KnnAvgRegressionPolicy> knn_t;
+
+    kernel::ThreadPool pool(N_THREADS);
+
+    auto points = random_points(500, 32, 1);
+    auto queries = random_points(50, 32, 2);
+
+    labels_t labels(points.rows());
+    for(uint_t r=0; r<points.rows(); ++r){
+        labels[r] = points(r, 0) + points(r, 1);
+    }
+
+    knn_t knn(KnnControl(7));
+    knn.train(points, labels);
+    ASSERT_FALSE(knn.has_index());
+
+    auto result = knn.predict(queries, pool, Null());
+
+    for(uint_t r=0; r<queries.rows(); ++r){
+
+        auto point = kernel::matrix_row_trait<Matrix>::get_row(queries, r);
+        ASSERT_EQ(result.first[r], knn.predict(point, pool, Null()).first);
+    }
+}
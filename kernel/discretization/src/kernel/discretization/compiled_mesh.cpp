@@ -0,0 +1,236 @@
+#include "kernel/discretization/compiled_mesh.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/face_element.h"
+#include "kernel/discretization/node.h"
+#include "kernel/discretization/dof.h"
+#include "kernel/discretization/dof_manager.h"
+#include "kernel/geometry/geom_point.h"
+
+#include <unordered_map>
+#include <exception>
+#include <string>
+#include <cmath>
+
+namespace kernel{
+namespace numerics{
+
+CompiledMesh<2>::CompiledMesh()
+    :
+    n_nodes_(0),
+    n_elements_(0),
+    n_faces_(0)
+{}
+
+CompiledMesh<2>::CompiledMesh(const Mesh<2>& mesh)
+    :
+    CompiledMesh()
+{
+    compile(mesh);
+}
+
+CompiledMesh<2>::CompiledMesh(const Mesh<2>& mesh, const FVDoFManager<2>& dof_manager)
+    :
+    CompiledMesh()
+{
+    compile(mesh, dof_manager);
+}
+
+void
+CompiledMesh<2>::clear(){
+
+    n_nodes_ = 0;
+    n_elements_ = 0;
+    n_faces_ = 0;
+
+    node_coords_.clear();
+    element_node_offsets_.clear();
+    element_nodes_.clear();
+    element_face_offsets_.clear();
+    element_faces_.clear();
+    element_neighbors_.clear();
+    element_volumes_.clear();
+    element_centroids_.clear();
+    element_dofs_.clear();
+    face_owners_.clear();
+    face_neighbors_.clear();
+    face_boundary_indicators_.clear();
+    face_areas_.clear();
+    face_normals_.clear();
+    face_centroids_.clear();
+    face_distances_.clear();
+}
+
+void
+CompiledMesh<2>::compile(const Mesh<2>& mesh, const FVDoFManager<2>& dof_manager){
+
+    compile(mesh);
+    compile_dofs(mesh, dof_manager);
+}
+
+void
+CompiledMesh<2>::compile(const Mesh<2>& mesh){
+
+    clear();
+
+    n_nodes_ = mesh.n_nodes();
+    n_elements_ = mesh.n_elements();
+    n_faces_ = mesh.n_faces();
+
+    // the entities are identified by their position
+    // in the mesh storage and not by their global id
+    std::unordered_map<const Node<2>*, uint_t> node_idx;
+    node_idx.reserve(n_nodes_);
+
+    std::unordered_map<const Element<2>*, uint_t> element_idx;
+    element_idx.reserve(n_elements_);
+
+    std::unordered_map<const FaceElement<2,1>*, uint_t> face_idx;
+    face_idx.reserve(n_faces_);
+
+    node_coords_.reserve(dimension*n_nodes_);
+
+    uint_t counter = 0;
+    for(auto itr = mesh.nodes_begin(); itr != mesh.nodes_end(); ++itr){
+
+        const Node<2>* node = *itr;
+        node_idx[node] = counter++;
+
+        for(uint_t i=0; i<dimension; ++i){
+            node_coords_.push_back((*node)[i]);
+        }
+    }
+
+    counter = 0;
+    for(auto itr = mesh.elements_begin(); itr != mesh.elements_end(); ++itr){
+        element_idx[*itr] = counter++;
+    }
+
+    counter = 0;
+    for(auto itr = mesh.topology()->edges_begin(); itr != mesh.topology()->edges_end(); ++itr){
+        face_idx[*itr] = counter++;
+    }
+
+    face_owners_.resize(n_faces_, KernelConsts::invalid_size_type());
+    face_neighbors_.resize(n_faces_, KernelConsts::invalid_size_type());
+    face_boundary_indicators_.resize(n_faces_, KernelConsts::invalid_size_type());
+    face_areas_.resize(n_faces_, 0.0);
+    face_normals_.resize(dimension*n_faces_, 0.0);
+    face_centroids_.resize(dimension*n_faces_, 0.0);
+    face_distances_.resize(n_faces_, 0.0);
+
+    element_node_offsets_.reserve(n_elements_ + 1);
+    element_face_offsets_.reserve(n_elements_ + 1);
+    element_volumes_.reserve(n_elements_);
+    element_centroids_.reserve(dimension*n_elements_);
+
+    element_node_offsets_.push_back(0);
+    element_face_offsets_.push_back(0);
+
+    for(auto itr = mesh.elements_begin(); itr != mesh.elements_end(); ++itr){
+
+        const Element<2>* element = *itr;
+
+        // in 2D the nodes of the supported elements are vertices
+        auto vertices = element->get_vertices();
+        for(const auto* vertex : vertices){
+            element_nodes_.push_back(node_idx.at(vertex));
+        }
+
+        element_node_offsets_.push_back(element_nodes_.size());
+        element_volumes_.push_back(element->volume());
+
+        auto centroid = element->centroid();
+        for(uint_t i=0; i<dimension; ++i){
+            element_centroids_.push_back(centroid[i]);
+        }
+
+        for(uint_t f=0; f<element->n_faces(); ++f){
+
+            const auto& face = element->get_face(f);
+            const uint_t fidx = face_idx.at(&face);
+
+            element_faces_.push_back(fidx);
+
+            if(&face.get_owner() == element){
+
+                // the owner fills in the face data so that the
+                // normal is computed in the local numbering of the owner
+                face_owners_[fidx] = element_idx.at(element);
+                face_boundary_indicators_[fidx] = face.boundary_indicator();
+                face_areas_[fidx] = face.volume();
+
+                auto normal = element->face_normal_vector(f);
+                const real_t length = std::sqrt(normal[0]*normal[0] + normal[1]*normal[1]);
+
+                auto face_centroid = face.centroid();
+
+                for(uint_t i=0; i<dimension; ++i){
+                    face_normals_[dimension*fidx + i] = normal[i]/length;
+                    face_centroids_[dimension*fidx + i] = face_centroid[i];
+                }
+
+                if(!face.on_boundary()){
+                    face_neighbors_[fidx] = element_idx.at(&face.get_neighbor());
+                }
+
+                element_neighbors_.push_back(face_neighbors_[fidx]);
+            }
+            else{
+                element_neighbors_.push_back(element_idx.at(&face.get_owner()));
+            }
+        }
+
+        element_face_offsets_.push_back(element_faces_.size());
+    }
+
+    for(uint_t f=0; f<n_faces_; ++f){
+
+        if(face_owners_[f] == KernelConsts::invalid_size_type()){
+            throw std::logic_error("Face: "+std::to_string(f)+" is not a face of its owner");
+        }
+
+        const uint_t owner = face_owners_[f];
+        const uint_t neighbor = face_neighbors_[f];
+
+        real_t distance = 0.0;
+        for(uint_t i=0; i<dimension; ++i){
+
+            const real_t other = neighbor == KernelConsts::invalid_size_type() ? face_centroids_[dimension*f + i]
+                                                                               : element_centroids_[dimension*neighbor + i];
+
+            const real_t diff = element_centroids_[dimension*owner + i] - other;
+            distance += diff*diff;
+        }
+
+        face_distances_[f] = std::sqrt(distance);
+    }
+}
+
+void
+CompiledMesh<2>::compile_dofs(const Mesh<2>& mesh, const FVDoFManager<2>& dof_manager){
+
+    if(mesh.n_elements() != n_elements_){
+        throw std::logic_error("The mesh has: "+std::to_string(mesh.n_elements())+
+                               " elements but the compiled mesh has: "+std::to_string(n_elements_));
+    }
+
+    element_dofs_.clear();
+    element_dofs_.reserve(n_elements_);
+
+    std::vector<DoF> dofs;
+    for(auto itr = mesh.elements_begin(); itr != mesh.elements_end(); ++itr){
+
+        dofs.clear();
+        dof_manager.get_dofs(**itr, dofs);
+
+        if(dofs.empty()){
+            throw std::logic_error("Cell without dofs is used");
+        }
+
+        element_dofs_.push_back(dofs[0].id);
+    }
+}
+
+}
+}
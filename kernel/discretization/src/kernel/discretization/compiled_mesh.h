@@ -0,0 +1,178 @@
+#ifndef COMPILED_MESH_H
+#define COMPILED_MESH_H
+
+#include "kernel/base/types.h"
+#include "kernel/base/kernel_consts.h"
+
+#include <vector>
+
+namespace kernel{
+namespace numerics{
+
+// forward declarations
+template<int dim> class Mesh;
+template<int dim> class FVDoFManager;
+
+/// \brief A flat, read-only view of a Mesh. The connectivity
+/// and the geometric quantities are copied into contiguous arrays
+/// so that kernels can loop over indices instead of following
+/// Element and FaceElement pointers. The view does not track the
+/// Mesh so it must be compiled again when the Mesh changes.
+/// Only dim = 2 is currently supported
+template<int dim> class CompiledMesh;
+
+/// \brief Compiled view of a Mesh<2>. Elements, faces and nodes
+/// are identified by their position in the storage of the Mesh.
+/// The faces of element e are given in the local order of the
+/// element, element_faces()[element_face_offsets()[e] + f] is
+/// the global index of the f-th face of e. Face normals point
+/// outwards from the owner of the face.
+template<>
+class CompiledMesh<2>
+{
+
+public:
+
+    static const int dimension = 2;
+
+    /// \brief Constructor. Creates an empty view
+    CompiledMesh();
+
+    /// \brief Constructor. Compile the given mesh
+    explicit CompiledMesh(const Mesh<2>& mesh);
+
+    /// \brief Constructor. Compile the given mesh and
+    /// the DoFs distributed by the given manager
+    CompiledMesh(const Mesh<2>& mesh, const FVDoFManager<2>& dof_manager);
+
+    /// \brief Compile the given mesh. Any previous
+    /// data including the DoFs is discarded
+    void compile(const Mesh<2>& mesh);
+
+    /// \brief Compile the given mesh and the DoFs
+    /// distributed by the given manager
+    void compile(const Mesh<2>& mesh, const FVDoFManager<2>& dof_manager);
+
+    /// \brief Copy the DoF of every element. The mesh should be the
+    /// one that was compiled. Throws std::logic_error if an element has no DoF
+    void compile_dofs(const Mesh<2>& mesh, const FVDoFManager<2>& dof_manager);
+
+    /// \brief Remove all the data
+    void clear();
+
+    /// \brief Returns true if no mesh has been compiled
+    bool empty()const{return n_elements_ == 0;}
+
+    /// \brief Returns true if the DoFs have been compiled
+    bool has_dofs()const{return !element_dofs_.empty();}
+
+    uint_t n_nodes()const{return n_nodes_;}
+    uint_t n_elements()const{return n_elements_;}
+    uint_t n_faces()const{return n_faces_;}
+
+    /// \brief The number of faces of the given element
+    uint_t n_element_faces(uint_t e)const
+    {return element_face_offsets_[e + 1] - element_face_offsets_[e];}
+
+    /// \brief The global index of the f-th face of element e
+    uint_t element_face(uint_t e, uint_t f)const
+    {return element_faces_[element_face_offsets_[e] + f];}
+
+    /// \brief The element across the f-th face of element e. It is
+    /// KernelConsts::invalid_size_type() for boundary faces
+    uint_t element_neighbor(uint_t e, uint_t f)const
+    {return element_neighbors_[element_face_offsets_[e] + f];}
+
+    /// \brief The i-th coordinate of node n
+    real_t node_coordinate(uint_t n, uint_t i)const{return node_coords_[dimension*n + i];}
+
+    /// \brief The volume of element e
+    real_t element_volume(uint_t e)const{return element_volumes_[e];}
+
+    /// \brief The i-th coordinate of the centroid of element e
+    real_t element_centroid(uint_t e, uint_t i)const{return element_centroids_[dimension*e + i];}
+
+    /// \brief The DoF index of element e
+    uint_t element_dof(uint_t e)const{return element_dofs_[e];}
+
+    /// \brief The element that owns face f
+    uint_t face_owner(uint_t f)const{return face_owners_[f];}
+
+    /// \brief The element that shares face f. It is
+    /// KernelConsts::invalid_size_type() for boundary faces
+    uint_t face_neighbor(uint_t f)const{return face_neighbors_[f];}
+
+    /// \brief Returns true if face f is on the boundary
+    bool face_on_boundary(uint_t f)const
+    {return face_boundary_indicators_[f] != KernelConsts::invalid_size_type();}
+
+    /// \brief The boundary indicator of face f
+    uint_t face_boundary_indicator(uint_t f)const{return face_boundary_indicators_[f];}
+
+    /// \brief The area (length in 2D) of face f
+    real_t face_area(uint_t f)const{return face_areas_[f];}
+
+    /// \brief The i-th component of the unit normal of face f
+    real_t face_normal(uint_t f, uint_t i)const{return face_normals_[dimension*f + i];}
+
+    /// \brief The i-th coordinate of the centroid of face f
+    real_t face_centroid(uint_t f, uint_t i)const{return face_centroids_[dimension*f + i];}
+
+    /// \brief The distance between the centroids of the owner and the neighbor
+    /// of face f or between the owner and the face centroid on the boundary.
+    /// This is FaceElement::owner_neighbor_distance()
+    real_t face_owner_neighbor_distance(uint_t f)const{return face_distances_[f];}
+
+    /// \brief Raw access to the arrays
+    const std::vector<real_t>& node_coordinates()const{return node_coords_;}
+    const std::vector<uint_t>& element_node_offsets()const{return element_node_offsets_;}
+    const std::vector<uint_t>& element_nodes()const{return element_nodes_;}
+    const std::vector<uint_t>& element_face_offsets()const{return element_face_offsets_;}
+    const std::vector<uint_t>& element_faces()const{return element_faces_;}
+    const std::vector<uint_t>& element_neighbors()const{return element_neighbors_;}
+    const std::vector<real_t>& element_volumes()const{return element_volumes_;}
+    const std::vector<real_t>& element_centroids()const{return element_centroids_;}
+    const std::vector<uint_t>& element_dofs()const{return element_dofs_;}
+    const std::vector<uint_t>& face_owners()const{return face_owners_;}
+    const std::vector<uint_t>& face_neighbors()const{return face_neighbors_;}
+    const std::vector<uint_t>& face_boundary_indicators()const{return face_boundary_indicators_;}
+    const std::vector<real_t>& face_areas()const{return face_areas_;}
+    const std::vector<real_t>& face_normals()const{return face_normals_;}
+    const std::vector<real_t>& face_centroids()const{return face_centroids_;}
+    const std::vector<real_t>& face_owner_neighbor_distances()const{return face_distances_;}
+
+private:
+
+    uint_t n_nodes_;
+    uint_t n_elements_;
+    uint_t n_faces_;
+
+    /// \brief Node data
+    std::vector<real_t> node_coords_;
+
+    /// \brief Element data. The nodes, faces and neighbors
+    /// of the elements are stored in CSR format
+    std::vector<uint_t> element_node_offsets_;
+    std::vector<uint_t> element_nodes_;
+    std::vector<uint_t> element_face_offsets_;
+    std::vector<uint_t> element_faces_;
+    std::vector<uint_t> element_neighbors_;
+    std::vector<real_t> element_volumes_;
+    std::vector<real_t> element_centroids_;
+    std::vector<uint_t> element_dofs_;
+
+    /// \brief Face data
+    std::vector<uint_t> face_owners_;
+    std::vector<uint_t> face_neighbors_;
+    std::vector<uint_t> face_boundary_indicators_;
+    std::vector<real_t> face_areas_;
+    std::vector<real_t> face_normals_;
+    std::vector<real_t> face_centroids_;
+    std::vector<real_t> face_distances_;
+};
+
+}
+
+}
+
+#endif // COMPILED_MESH_H
@@ -3,6 +3,10 @@
 #include "kernel/discretization/mesh_predicates.h"
 #include "kernel/discretization/element.h"
 #include "kernel/discretization/mesh.h"
+#include "kernel/discretization/dof.h"
+
+#include <algorithm>
+#include <stdexcept>
 
 namespace kernel{
 namespace numerics {
@@ -62,6 +66,47 @@ FVDoFManager<dim>::get_dofs(const Element<dim>& elem, std::vector<DoF>& dofs)con
     elem.get_dofs(var_name_, dofs);
 }
 
+template<int dim>
+void
+FVDoFManager<dim>::sparsity_pattern(const Mesh<dim>& mesh, std::vector<std::vector<uint_t>>& pattern)const{
+
+    pattern.clear();
+    pattern.resize(n_dofs_);
+
+    std::vector<DoF> dofs;
+
+    ConstElementMeshIterator<Active, Mesh<dim>> filter(mesh);
+    auto begin = filter.begin();
+    auto end = filter.end();
+
+    for(; begin != end; begin++){
+
+        auto* elem = *begin;
+        get_dofs(*elem, dofs);
+
+        if(dofs.empty() || dofs[0].id >= n_dofs_){
+            throw std::logic_error("Element without a valid DoF. Distribute the dofs first");
+        }
+
+        auto& row = pattern[dofs[0].id];
+        row.reserve(elem->n_neighbors() + 1);
+        row.push_back(dofs[0].id);
+
+        for(uint_t n=0; n<elem->n_neighbors(); ++n){
+
+            auto* neighbor = elem->neighbor_ptr(n);
+
+            if(neighbor){
+                get_dofs(*neighbor, dofs);
+                row.push_back(dofs[0].id);
+            }
+        }
+
+        std::sort(row.begin(), row.end());
+        row.erase(std::unique(row.begin(), row.end()), row.end());
+    }
+}
+
 template class FVDoFManager<1>;
 template class FVDoFManager<2>;
 template class FVDoFManager<3>;
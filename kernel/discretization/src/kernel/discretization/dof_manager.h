@@ -4,6 +4,7 @@
 #include "kernel/base/types.h"
 
 #include <string>
+#include <vector>
 
 namespace kernel{
 namespace numerics {
@@ -31,6 +32,12 @@ public:
     /// \brief Get the dofs on the given elem
     void get_dofs(const Element<dim>& elem, std::vector<DoF>& dofs)const;
 
+    /// \brief Compute the sparsity pattern of the FV matrix. Row r
+    /// holds the sorted dofs of the element with dof r and of its
+    /// face neighbors. The pattern depends only on the mesh so it
+    /// can be computed once after the dofs are distributed
+    void sparsity_pattern(const Mesh<dim>& mesh, std::vector<std::vector<uint_t>>& pattern)const;
+
     /// returns the number of dofs
     uint_t n_dofs()const{return n_dofs_;}
 
@@ -156,6 +156,14 @@ public:
      */
     uint_t n_active_faces()const;
 
+    /// \brief The version of the mesh. It changes whenever the
+    /// topology changes. See MeshTopology::version()
+    uint_t version()const{return topology_.version();}
+
+    /// \brief Signal a change of the mesh that the topology
+    /// cannot detect e.g. moved nodes
+    void mark_modified(){topology_.mark_modified();}
+
     /// \brief Return read/write access to the topology of the mesh
     MeshTopology<spacedim>* topology(){return &topology_;}
 
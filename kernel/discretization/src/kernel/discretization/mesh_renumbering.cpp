@@ -0,0 +1,395 @@
+#include "kernel/discretization/mesh_renumbering.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/face_element.h"
+#include "kernel/discretization/node.h"
+#include "kernel/geometry/geom_point.h"
+
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <utility>
+#include <exception>
+#include <string>
+#include <cstdint>
+
+namespace kernel{
+namespace numerics{
+
+namespace{
+
+/// \brief The number of bits per coordinate used
+/// to place the centroids on the space-filling curves
+const uint_t CURVE_BITS = 16;
+
+/// \brief The element adjacency in CSR format
+struct ElementGraph
+{
+    std::vector<uint_t> offsets;
+    std::vector<uint_t> neighbors;
+
+    uint_t degree(uint_t e)const{return offsets[e + 1] - offsets[e];}
+};
+
+template<int dim>
+void
+build_element_graph(const Mesh<dim>& mesh, ElementGraph& graph){
+
+    graph.offsets.clear();
+    graph.neighbors.clear();
+    graph.offsets.reserve(mesh.n_elements() + 1);
+    graph.offsets.push_back(0);
+
+    uint_t counter = 0;
+    for(auto itr = mesh.elements_begin(); itr != mesh.elements_end(); ++itr, ++counter){
+
+        const Element<dim>* element = *itr;
+
+        // the position of an element is its id
+        if(element->get_id() != counter){
+            throw std::logic_error("Element id: "+std::to_string(element->get_id())+
+                                   " does not match its position: "+std::to_string(counter));
+        }
+
+        for(uint_t n=0; n<element->n_neighbors(); ++n){
+
+            const Element<dim>* neighbor = element->neighbor_ptr(n);
+
+            if(neighbor){
+                graph.neighbors.push_back(neighbor->get_id());
+            }
+        }
+
+        graph.offsets.push_back(graph.neighbors.size());
+    }
+}
+
+/// \brief Breadth first search over the elements not yet numbered
+/// that are reachable from start. Returns the number of levels and
+/// sets last to the element of the last level with the smallest degree
+uint_t
+bfs_levels(const ElementGraph& graph, uint_t start, const std::vector<bool>& numbered,
+           std::vector<uint_t>& level, uint_t& last){
+
+    std::vector<uint_t> current(1, start);
+    std::vector<uint_t> next;
+
+    level[start] = 0;
+    uint_t n_levels = 0;
+    std::vector<uint_t> touched(1, start);
+
+    while(!current.empty()){
+
+        n_levels++;
+        last = *std::min_element(current.begin(), current.end(),
+                                 [&graph](uint_t a, uint_t b){return graph.degree(a) < graph.degree(b);});
+
+        next.clear();
+        for(auto v : current){
+            for(uint_t i=graph.offsets[v]; i<graph.offsets[v + 1]; ++i){
+
+                const uint_t w = graph.neighbors[i];
+                if(!numbered[w] && level[w] == std::numeric_limits<uint_t>::max()){
+                    level[w] = n_levels;
+                    next.push_back(w);
+                    touched.push_back(w);
+                }
+            }
+        }
+
+        current.swap(next);
+    }
+
+    // leave the levels clean for the next search
+    for(auto v : touched){
+        level[v] = std::numeric_limits<uint_t>::max();
+    }
+
+    return n_levels;
+}
+
+void
+rcm(const ElementGraph& graph, std::vector<uint_t>& order){
+
+    const uint_t n = graph.offsets.size() - 1;
+
+    order.clear();
+    order.reserve(n);
+
+    std::vector<bool> numbered(n, false);
+    std::vector<uint_t> level(n, std::numeric_limits<uint_t>::max());
+    std::vector<uint_t> candidates;
+
+    // visit the elements by increasing degree so that
+    // every component starts from a low degree element
+    std::vector<uint_t> by_degree(n);
+    std::iota(by_degree.begin(), by_degree.end(), 0);
+    std::stable_sort(by_degree.begin(), by_degree.end(),
+                     [&graph](uint_t a, uint_t b){return graph.degree(a) < graph.degree(b);});
+
+    for(auto seed : by_degree){
+
+        if(numbered[seed]){
+            continue;
+        }
+
+        // pseudo-peripheral element: move to the far end of
+        // the level structure as long as it gets deeper
+        uint_t start = seed;
+        uint_t last = seed;
+        uint_t depth = bfs_levels(graph, start, numbered, level, last);
+
+        while(last != start){
+
+            uint_t candidate_last = last;
+            const uint_t candidate_depth = bfs_levels(graph, last, numbered, level, candidate_last);
+
+            if(candidate_depth <= depth){
+                break;
+            }
+
+            start = last;
+            last = candidate_last;
+            depth = candidate_depth;
+        }
+
+        // Cuthill-McKee from start
+        uint_t head = order.size();
+        order.push_back(start);
+        numbered[start] = true;
+
+        while(head < order.size()){
+
+            const uint_t v = order[head++];
+
+            candidates.clear();
+            for(uint_t i=graph.offsets[v]; i<graph.offsets[v + 1]; ++i){
+
+                const uint_t w = graph.neighbors[i];
+                if(!numbered[w]){
+                    numbered[w] = true;
+                    candidates.push_back(w);
+                }
+            }
+
+            std::stable_sort(candidates.begin(), candidates.end(),
+                             [&graph](uint_t a, uint_t b){return graph.degree(a) < graph.degree(b);});
+
+            order.insert(order.end(), candidates.begin(), candidates.end());
+        }
+    }
+
+    std::reverse(order.begin(), order.end());
+}
+
+/// \brief Distance of (x, y) along the Hilbert curve that
+/// fills a 2^CURVE_BITS x 2^CURVE_BITS grid
+std::uint64_t
+hilbert_index(std::uint64_t x, std::uint64_t y){
+
+    const std::uint64_t n = std::uint64_t(1) << CURVE_BITS;
+    std::uint64_t d = 0;
+
+    for(std::uint64_t s = n/2; s > 0; s /= 2){
+
+        const std::uint64_t rx = (x & s) > 0;
+        const std::uint64_t ry = (y & s) > 0;
+
+        d += s*s*((3*rx)^ry);
+
+        // rotate the quadrant
+        if(ry == 0){
+
+            if(rx == 1){
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+
+            std::swap(x, y);
+        }
+    }
+
+    return d;
+}
+
+/// \brief Interleave the bits of x and y
+std::uint64_t
+morton_index(std::uint64_t x, std::uint64_t y){
+
+    std::uint64_t d = 0;
+
+    for(uint_t b=0; b<CURVE_BITS; ++b){
+        d |= ((x >> b) & 1) << (2*b);
+        d |= ((y >> b) & 1) << (2*b + 1);
+    }
+
+    return d;
+}
+
+void
+curve_order(const Mesh<2>& mesh, MeshRenumberingType type, std::vector<uint_t>& order){
+
+    const uint_t n = mesh.n_elements();
+
+    std::vector<real_t> xs;
+    std::vector<real_t> ys;
+    xs.reserve(n);
+    ys.reserve(n);
+
+    for(auto itr = mesh.elements_begin(); itr != mesh.elements_end(); ++itr){
+
+        auto centroid = (*itr)->centroid();
+        xs.push_back(centroid[0]);
+        ys.push_back(centroid[1]);
+    }
+
+    const auto [xmin, xmax] = std::minmax_element(xs.begin(), xs.end());
+    const auto [ymin, ymax] = std::minmax_element(ys.begin(), ys.end());
+
+    // use the same scale in both directions
+    // so that the curve is not distorted
+    const real_t extent = std::max(*xmax - *xmin, *ymax - *ymin);
+    const real_t max_cell = static_cast<real_t>((std::uint64_t(1) << CURVE_BITS) - 1);
+    const real_t scale = extent > 0.0 ? max_cell/extent : 0.0;
+
+    std::vector<std::uint64_t> keys(n);
+
+    for(uint_t e=0; e<n; ++e){
+
+        const auto x = static_cast<std::uint64_t>((xs[e] - *xmin)*scale);
+        const auto y = static_cast<std::uint64_t>((ys[e] - *ymin)*scale);
+
+        keys[e] = type == MeshRenumberingType::HILBERT ? hilbert_index(x, y) : morton_index(x, y);
+    }
+
+    order.resize(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&keys](uint_t a, uint_t b){return keys[a] < keys[b];});
+}
+
+}
+
+template<int dim>
+void
+element_renumbering(const Mesh<dim>& mesh, MeshRenumberingType type, std::vector<uint_t>& order){
+
+    order.clear();
+
+    if(mesh.n_elements() == 0){
+        return;
+    }
+
+    switch(type){
+
+    case MeshRenumberingType::RCM:
+    {
+        ElementGraph graph;
+        build_element_graph(mesh, graph);
+        rcm(graph, order);
+        break;
+    }
+    case MeshRenumberingType::HILBERT:
+    case MeshRenumberingType::MORTON:
+    {
+        curve_order(mesh, type, order);
+        break;
+    }
+    default:
+    {
+        throw std::logic_error("Invalid mesh renumbering type");
+    }
+    }
+}
+
+template<int dim>
+void
+renumber_mesh(Mesh<dim>& mesh, MeshRenumberingType type){
+
+    std::vector<uint_t> element_order;
+    element_renumbering(mesh, type, element_order);
+    mesh.topology()->renumber_elements(element_order);
+
+    // number nodes and faces as the elements visit them
+    std::vector<bool> node_visited(mesh.n_nodes(), false);
+    std::vector<bool> face_visited(mesh.n_faces(), false);
+
+    std::vector<uint_t> node_order;
+    node_order.reserve(mesh.n_nodes());
+
+    std::vector<uint_t> face_order;
+    face_order.reserve(mesh.n_faces());
+
+    for(auto itr = mesh.elements_begin(); itr != mesh.elements_end(); ++itr){
+
+        const Element<dim>* element = *itr;
+
+        auto vertices = element->get_vertices();
+        for(const auto* vertex : vertices){
+
+            if(!node_visited[vertex->get_id()]){
+                node_visited[vertex->get_id()] = true;
+                node_order.push_back(vertex->get_id());
+            }
+        }
+
+        for(uint_t f=0; f<element->n_faces(); ++f){
+
+            const uint_t face = element->get_face(f).get_id();
+
+            if(!face_visited[face]){
+                face_visited[face] = true;
+                face_order.push_back(face);
+            }
+        }
+    }
+
+    // entities that no element uses keep their relative order
+    for(uint_t n=0; n<node_visited.size(); ++n){
+        if(!node_visited[n]){
+            node_order.push_back(n);
+        }
+    }
+
+    for(uint_t f=0; f<face_visited.size(); ++f){
+        if(!face_visited[f]){
+            face_order.push_back(f);
+        }
+    }
+
+    mesh.topology()->renumber_nodes(node_order);
+    mesh.topology()->renumber_faces(face_order);
+}
+
+template<int dim>
+uint_t
+element_bandwidth(const Mesh<dim>& mesh){
+
+    uint_t bandwidth = 0;
+
+    for(auto itr = mesh.elements_begin(); itr != mesh.elements_end(); ++itr){
+
+        const Element<dim>* element = *itr;
+
+        for(uint_t n=0; n<element->n_neighbors(); ++n){
+
+            const Element<dim>* neighbor = element->neighbor_ptr(n);
+
+            if(neighbor){
+
+                const uint_t i = element->get_id();
+                const uint_t j = neighbor->get_id();
+                bandwidth = std::max(bandwidth, i > j ? i - j : j - i);
+            }
+        }
+    }
+
+    return bandwidth;
+}
+
+template void element_renumbering(const Mesh<2>& mesh, MeshRenumberingType type, std::vector<uint_t>& order);
+template void renumber_mesh(Mesh<2>& mesh, MeshRenumberingType type);
+template uint_t element_bandwidth(const Mesh<2>& mesh);
+
+}
+}
@@ -0,0 +1,48 @@
+#ifndef MESH_RENUMBERING_H
+#define MESH_RENUMBERING_H
+
+#include "kernel/base/types.h"
+
+#include <vector>
+
+namespace kernel{
+namespace numerics{
+
+// forward declarations
+template<int dim> class Mesh;
+
+/// \brief The orderings supported by renumber_mesh
+enum class MeshRenumberingType {RCM, HILBERT, MORTON};
+
+/// \brief Compute a new order for the elements of the mesh. On return
+/// order[i] is the current position of the element that should be stored
+/// at position i.
+/// RCM applies reverse Cuthill-McKee to the element adjacency graph. It
+/// starts every connected component from a pseudo-peripheral element.
+/// HILBERT and MORTON sort the elements by the index of their centroid
+/// on the corresponding space-filling curve.
+/// Only dim = 2 is currently supported
+template<int dim>
+void element_renumbering(const Mesh<dim>& mesh, MeshRenumberingType type,
+                         std::vector<uint_t>& order);
+
+/// \brief Reorder the elements of the mesh with element_renumbering().
+/// Nodes and faces are then numbered in the order that the renumbered
+/// elements first visit them. The ids of all entities are set to their
+/// new position.
+/// The connectivity is pointer based and stays valid. Any DoFs already
+/// distributed keep their old indices. Call FVDoFManager::distribute_dofs
+/// again to number the DoFs in the new element order
+template<int dim>
+void renumber_mesh(Mesh<dim>& mesh, MeshRenumberingType type);
+
+/// \brief The bandwidth of the element adjacency. This is the largest
+/// |i - j| over all pairs of neighboring elements i and j. With one DoF
+/// per element it is the bandwidth of the FV matrix
+template<int dim>
+uint_t element_bandwidth(const Mesh<dim>& mesh);
+
+}
+}
+
+#endif // MESH_RENUMBERING_H
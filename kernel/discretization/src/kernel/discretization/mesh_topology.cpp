@@ -4,6 +4,8 @@
 #include "kernel/discretization/node.h"
 
 #include <exception>
+#include <string>
+#include <atomic>
 
 namespace kernel
 {
@@ -45,6 +47,7 @@ MeshTopology<spacedim>::add_entity(T* t, C& c)
     }
 
   c[id] = t;
+  version_ = next_version_();
   
   return t;
 
@@ -52,6 +55,71 @@ MeshTopology<spacedim>::add_entity(T* t, C& c)
 }
 
 
+template<int spacedim>
+template<typename C>
+void
+MeshTopology<spacedim>::renumber_entities(const std::vector<uint_t>& order, C& c){
+
+  if(order.size() != c.size()){
+      throw std::logic_error("Invalid permutation size: "+std::to_string(order.size())+
+                             " not equal to: "+std::to_string(c.size()));
+  }
+
+  std::vector<bool> visited(c.size(), false);
+
+  for(uint_t i=0; i<order.size(); ++i){
+
+      if(order[i] >= c.size() || visited[order[i]] || c[order[i]] == nullptr){
+          throw std::logic_error("Invalid permutation index: "+std::to_string(order[i]));
+      }
+
+      visited[order[i]] = true;
+  }
+
+  C renumbered(c.size(), nullptr);
+
+  for(uint_t i=0; i<order.size(); ++i){
+
+      renumbered[i] = c[order[i]];
+      renumbered[i]->set_id(i);
+  }
+
+  c.swap(renumbered);
+  version_ = next_version_();
+}
+
+template<int spacedim>
+void
+MeshTopology<spacedim>::renumber_nodes(const std::vector<uint_t>& order){
+  renumber_entities(order, nodes_);
+}
+
+template<int spacedim>
+void
+MeshTopology<spacedim>::renumber_elements(const std::vector<uint_t>& order){
+  renumber_entities(order, elements_);
+}
+
+template<int spacedim>
+void
+MeshTopology<spacedim>::renumber_faces(const std::vector<uint_t>& order){
+  renumber_entities(order, faces_);
+}
+
+template<>
+void
+MeshTopology<1>::renumber_faces(const std::vector<uint_t>& order){
+
+  // in 1D the faces are the nodes
+  renumber_entities(order, nodes_);
+}
+
+template<>
+void
+MeshTopology<2>::renumber_faces(const std::vector<uint_t>& order){
+  renumber_entities(order, edges_);
+}
+
 template<int spacedim>
 MeshTopology<spacedim>::~MeshTopology(){
  clear_topology();
@@ -85,6 +153,7 @@ MeshTopology<spacedim>::clear_topology_nodes()
    } 
    
    nodes_.clear();
+   version_ = next_version_();
 }
 
 
@@ -103,6 +172,7 @@ MeshTopology<spacedim>::clear_topology_elements()
    } 
    
    elements_.clear();
+   version_ = next_version_();
 }
 
 template<int spacedim>
@@ -211,6 +281,7 @@ MeshTopology<2>::clear_topology_edges()
    } 
    
    edges_.clear();
+   version_ = next_version_();
 
 }
 
@@ -300,6 +371,7 @@ MeshTopology<3>::clear_topology_edges()
    } 
    
    edges_.clear();
+   version_ = next_version_();
 
 }
 
@@ -319,6 +391,7 @@ MeshTopology<3>::clear_topology_faces()
    } 
    
    faces_.clear();
+   version_ = next_version_();
 
 }
 
@@ -380,6 +453,14 @@ MeshTopology<3>::faces(const MeshConnectivity& faces_idx,std::vector<MeshTopolog
 
 }
 
+template<int spacedim>
+uint_t
+MeshTopology<spacedim>::next_version_(){
+
+    static std::atomic<uint_t> counter(0);
+    return ++counter;
+}
+
 template class MeshTopology<1>;
 template class MeshTopology<2>;
 template class MeshTopology<3>;
@@ -131,7 +131,44 @@ public:
       *\detailed clear the topology
       */
     void clear_topology();
+
+    /**
+      *\detailed reorder the nodes so that the i-th node becomes
+      *the node previously stored at order[i]. The ids of the nodes
+      *are set to their new position. order must be a permutation
+      */
+    void renumber_nodes(const std::vector<uint_t>& order);
+
+    /**
+      *\detailed reorder the elements so that the i-th element becomes
+      *the element previously stored at order[i]. The ids of the elements
+      *are set to their new position. order must be a permutation
+      */
+    void renumber_elements(const std::vector<uint_t>& order);
+
+    /**
+      *\detailed reorder the faces so that the i-th face becomes
+      *the face previously stored at order[i]. The ids of the faces
+      *are set to their new position. order must be a permutation
+      */
+    void renumber_faces(const std::vector<uint_t>& order);
     
+    /**
+      *\detailed the version of the topology. It changes whenever
+      *entities are added, removed or renumbered. The versions are drawn
+      *from a counter shared by all topologies so two meshes never report
+      *the same version, even when one is created at the address of a
+      *destroyed one. Objects that cache mesh data compare it to know
+      *if the cache is stale
+      */
+    uint_t version()const{return version_;}
+
+    /**
+      *\detailed signal a change that the topology cannot detect
+      *e.g. moved nodes. Assigns a new version
+      */
+    void mark_modified(){version_ = next_version_();}
+
     /**
       *\detailed get the number of nodes in the mesh
       */
@@ -228,6 +265,16 @@ private:
     std::vector<edge_ptr_t> edges_;
     std::vector<face_ptr_t> faces_;
     std::vector<Element<spacedim>* > elements_;
+
+    /**
+      *\detailed the version of the topology
+      */
+    uint_t version_;
+
+    /**
+      *\detailed returns a version no topology has used before
+      */
+    static uint_t next_version_();
     
     /**
       *\detailed add to the container C the entity T
@@ -235,6 +282,13 @@ private:
       */
     template<typename T,typename C>
     T* add_entity(T* t, C& c);
+
+    /**
+      *\detailed reorder the entities in container c
+      *according to order and reset their ids
+      */
+    template<typename C>
+    void renumber_entities(const std::vector<uint_t>& order, C& c);
   
 };
   
@@ -246,7 +300,8 @@ MeshTopology<spacedim>::MeshTopology()
                        nodes_(),
                        elements_(),
                        edges_(),
-                       faces_()
+                       faces_(),
+                       version_(next_version_())
                        {}
 
 template<int spacedim>
@@ -357,42 +412,42 @@ template<int spacedim>
 inline
 typename MeshTopology<spacedim>::face_iterator 
 MeshTopology<spacedim>::faces_end(){
-  faces_.end();
+  return faces_.end();
 }
 
 template<>
 inline
 MeshTopology<2>::face_iterator 
 MeshTopology<2>::faces_end(){
-  edges_.end();
+  return edges_.end();
 }
   
 template<int spacedim>
 inline
 typename MeshTopology<spacedim>::const_face_iterator 
 MeshTopology<spacedim>::faces_begin()const{
-  faces_.begin();
+  return faces_.begin();
 }
 
 template<>
 inline
 MeshTopology<2>::const_face_iterator 
 MeshTopology<2>::faces_begin()const{
-  edges_.begin();
+  return edges_.begin();
 }
   
 template<int spacedim>
 inline
 typename MeshTopology<spacedim>::const_face_iterator 
 MeshTopology<spacedim>::faces_end()const{
-  faces_.end();
+  return faces_.end();
 }
 
 template<>
 inline
 MeshTopology<2>::const_face_iterator 
 MeshTopology<2>::faces_end()const{
-  edges_.end();
+  return edges_.end();
 }
 
 template<int spacedim>
@@ -0,0 +1,179 @@
+#include "kernel/base/types.h"
+#include "kernel/base/kernel_consts.h"
+#include "kernel/discretization/compiled_mesh.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/quad_mesh_generation.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/face_element.h"
+#include "kernel/discretization/node.h"
+#include "kernel/discretization/dof.h"
+#include "kernel/discretization/dof_manager.h"
+#include "kernel/geometry/geom_point.h"
+
+#include <vector>
+#include <string>
+#include <cmath>
+#include <gtest/gtest.h>
+
+namespace{
+
+using kernel::real_t;
+using kernel::uint_t;
+using kernel::GeomPoint;
+using kernel::KernelConsts;
+using kernel::numerics::Mesh;
+using kernel::numerics::CompiledMesh;
+using kernel::numerics::FVDoFManager;
+
+/// \brief Minimal variable to distribute DoFs
+struct Variable
+{
+    std::string_view name()const{return "u";}
+};
+
+const uint_t NX = 4;
+const uint_t NY = 3;
+
+void build_mesh(Mesh<2>& mesh){
+    kernel::numerics::build_quad_mesh(mesh, NX, NY, GeomPoint<2>(0.0), GeomPoint<2>({2.0, 1.5}));
+}
+
+}
+
+TEST(TestCompiledMesh, TestDefaultConstruction) {
+
+    /***
+       * Test Scenario:    The application creates an empty CompiledMesh
+       * Expected Output:  The view has no entities and no DoFs
+     **/
+
+    CompiledMesh<2> compiled;
+
+    ASSERT_TRUE(compiled.empty());
+    ASSERT_FALSE(compiled.has_dofs());
+    ASSERT_EQ(compiled.n_nodes(), 0);
+    ASSERT_EQ(compiled.n_elements(), 0);
+    ASSERT_EQ(compiled.n_faces(), 0);
+}
+
+TEST(TestCompiledMesh, TestConnectivity) {
+
+    /***
+       * Test Scenario:    The application compiles a quad mesh
+       * Expected Output:  The sizes match the mesh and every face of an element
+       *                   points back to the element as its owner or its neighbor
+     **/
+
+    Mesh<2> mesh;
+    build_mesh(mesh);
+
+    CompiledMesh<2> compiled(mesh);
+
+    ASSERT_EQ(compiled.n_nodes(), (NX + 1)*(NY + 1));
+    ASSERT_EQ(compiled.n_elements(), NX*NY);
+    ASSERT_EQ(compiled.n_faces(), mesh.n_faces());
+    ASSERT_EQ(compiled.element_nodes().size(), 4*NX*NY);
+
+    uint_t n_boundary_faces = 0;
+    for(uint_t f=0; f<compiled.n_faces(); ++f){
+        if(compiled.face_on_boundary(f)){
+            ASSERT_EQ(compiled.face_neighbor(f), KernelConsts::invalid_size_type());
+            n_boundary_faces++;
+        }
+    }
+
+    ASSERT_EQ(n_boundary_faces, 2*(NX + NY));
+
+    for(uint_t e=0; e<compiled.n_elements(); ++e){
+
+        ASSERT_EQ(compiled.n_element_faces(e), 4);
+
+        for(uint_t f=0; f<compiled.n_element_faces(e); ++f){
+
+            const uint_t face = compiled.element_face(e, f);
+            const uint_t neighbor = compiled.element_neighbor(e, f);
+
+            if(compiled.face_owner(face) == e){
+                ASSERT_EQ(neighbor, compiled.face_neighbor(face));
+            }
+            else{
+                ASSERT_EQ(compiled.face_neighbor(face), e);
+                ASSERT_EQ(neighbor, compiled.face_owner(face));
+            }
+        }
+    }
+}
+
+TEST(TestCompiledMesh, TestGeometry) {
+
+    /***
+       * Test Scenario:    The application compiles a quad mesh
+       * Expected Output:  The geometric quantities are equal to the ones computed by the mesh
+     **/
+
+    Mesh<2> mesh;
+    build_mesh(mesh);
+
+    CompiledMesh<2> compiled(mesh);
+
+    const real_t tol = 1.0e-12;
+    real_t total_volume = 0.0;
+
+    for(uint_t e=0; e<compiled.n_elements(); ++e){
+
+        const auto* element = mesh.element(e);
+        auto centroid = element->centroid();
+
+        ASSERT_NEAR(compiled.element_volume(e), element->volume(), tol);
+        ASSERT_NEAR(compiled.element_centroid(e, 0), centroid[0], tol);
+        ASSERT_NEAR(compiled.element_centroid(e, 1), centroid[1], tol);
+
+        total_volume += compiled.element_volume(e);
+
+        for(uint_t f=0; f<element->n_faces(); ++f){
+
+            const auto& face = element->get_face(f);
+            const uint_t idx = compiled.element_face(e, f);
+
+            ASSERT_NEAR(compiled.face_area(idx), face.volume(), tol);
+            ASSERT_NEAR(compiled.face_owner_neighbor_distance(idx), face.owner_neighbor_distance(), tol);
+
+            // the normal is a unit vector
+            const real_t nx = compiled.face_normal(idx, 0);
+            const real_t ny = compiled.face_normal(idx, 1);
+            ASSERT_NEAR(nx*nx + ny*ny, 1.0, tol);
+
+            // and points away from the owner
+            const uint_t owner = compiled.face_owner(idx);
+            const real_t dx = compiled.face_centroid(idx, 0) - compiled.element_centroid(owner, 0);
+            const real_t dy = compiled.face_centroid(idx, 1) - compiled.element_centroid(owner, 1);
+            ASSERT_GT(nx*dx + ny*dy, 0.0);
+        }
+    }
+
+    ASSERT_NEAR(total_volume, 2.0*1.5, tol);
+}
+
+TEST(TestCompiledMesh, TestDoFs) {
+
+    /***
+       * Test Scenario:    The application compiles a quad mesh with the DoFs of a variable
+       * Expected Output:  The DoF of every element is the one the FVDoFManager assigned
+     **/
+
+    Mesh<2> mesh;
+    build_mesh(mesh);
+
+    FVDoFManager<2> dof_manager;
+    dof_manager.distribute_dofs(mesh, Variable());
+
+    CompiledMesh<2> compiled(mesh, dof_manager);
+    ASSERT_TRUE(compiled.has_dofs());
+
+    std::vector<kernel::numerics::DoF> dofs;
+    for(uint_t e=0; e<compiled.n_elements(); ++e){
+
+        dof_manager.get_dofs(*mesh.element(e), dofs);
+        ASSERT_EQ(compiled.element_dof(e), dofs[0].id);
+    }
+}
@@ -0,0 +1,191 @@
+#include "kernel/base/types.h"
+#include "kernel/geometry/geom_point.h"
+#include "kernel/parallel/utilities/graph_mesh_partitioner.h"
+#include "kernel/parallel/utilities/graph_partitioner.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/element_mesh_iterator.h"
+#include "kernel/discretization/mesh_predicates.h"
+#include "kernel/discretization/quad_mesh_generation.h"
+
+#include <vector>
+#include <random>
+#include <numeric>
+#include <algorithm>
+#include <gtest/gtest.h>
+
+namespace{
+
+using kernel::uint_t;
+using kernel::real_t;
+using kernel::GeomPoint;
+using kernel::GraphPartitionInfo;
+using kernel::GraphPartitionerConfig;
+using kernel::numerics::Mesh;
+using kernel::numerics::ElementMeshIterator;
+using kernel::numerics::Active;
+
+const uint_t N = 32;
+
+void build_mesh(Mesh<2>& mesh){
+    kernel::numerics::build_quad_mesh(mesh, N, N, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+}
+
+/// \brief Count the faces between elements of different pids
+/// and the number of elements in every part
+uint_t count_cut(Mesh<2>& mesh, uint_t n_parts, std::vector<uint_t>& sizes){
+
+    sizes.assign(n_parts, 0);
+    uint_t cut = 0;
+
+    ElementMeshIterator<Active, Mesh<2>> filter(mesh);
+    for(auto itr = filter.begin(); itr != filter.end(); ++itr){
+
+        auto* element = *itr;
+        sizes[element->get_pid()]++;
+
+        for(uint_t n=0; n<element->n_neighbors(); ++n){
+            auto* neighbor = element->neighbor_ptr(n);
+            if(neighbor && neighbor->get_pid() != element->get_pid()){
+                cut++;
+            }
+        }
+    }
+
+    return cut/2;
+}
+
+void check_partition(Mesh<2>& mesh, uint_t n_parts, const GraphPartitionInfo& info){
+
+    std::vector<uint_t> sizes;
+    const uint_t cut = count_cut(mesh, n_parts, sizes);
+
+    ASSERT_EQ(info.n_parts, n_parts);
+    ASSERT_EQ(info.edge_cut, cut);
+    ASSERT_EQ(info.part_weights, sizes);
+
+    const real_t average = static_cast<real_t>(N*N)/n_parts;
+    for(auto size : sizes){
+        ASSERT_GT(size, 0);
+        ASSERT_LE(static_cast<real_t>(size), 1.05*average + 1.0);
+    }
+
+    ASSERT_LE(info.imbalance, 1.05 + n_parts/average);
+}
+
+}
+
+TEST(TestGraphMeshPartitioner, TestZeroPartitions) {
+
+    /***
+       * Test Scenario:    The application attempts to partition a quad mesh into zero parts
+       * Expected Output:  std::invalid_argument is thrown
+     **/
+
+    Mesh<2> mesh;
+    build_mesh(mesh);
+
+    ASSERT_THROW(kernel::numerics::graph_mesh_partition(mesh, 0), std::invalid_argument);
+}
+
+TEST(TestGraphMeshPartitioner, TestOnePartition) {
+
+    /***
+       * Test Scenario:    The application partitions a quad mesh with only one partition
+       * Expected Output:  All elements are assigned to PE zero and the edge cut is zero
+     **/
+
+    Mesh<2> mesh;
+    build_mesh(mesh);
+
+    auto info = kernel::numerics::graph_mesh_partition(mesh, 1);
+
+    ASSERT_EQ(info.edge_cut, 0);
+    ASSERT_DOUBLE_EQ(info.imbalance, 1.0);
+
+    ElementMeshIterator<Active, Mesh<2>> filter(mesh);
+    for(auto itr = filter.begin(); itr != filter.end(); ++itr){
+        ASSERT_EQ((*itr)->get_pid(), 0);
+    }
+}
+
+TEST(TestGraphMeshPartitioner, TestFourPartitions) {
+
+    /***
+       * Test Scenario:    The application partitions an N x N quad mesh into four parts
+       * Expected Output:  The parts are balanced and the edge cut is close to the
+       *                   2N faces of the partition into four squares
+     **/
+
+    Mesh<2> mesh;
+    build_mesh(mesh);
+
+    auto info = kernel::numerics::graph_mesh_partition(mesh, 4);
+    check_partition(mesh, 4, info);
+
+    ASSERT_LE(info.edge_cut, 3*N);
+}
+
+TEST(TestGraphMeshPartitioner, TestUnevenPartitions) {
+
+    /***
+       * Test Scenario:    The application partitions a quad mesh into a number
+       *                   of parts that is not a power of two
+       * Expected Output:  The parts are balanced
+     **/
+
+    Mesh<2> mesh;
+    build_mesh(mesh);
+
+    for(uint_t n_parts : {3, 5, 7}){
+        auto info = kernel::numerics::graph_mesh_partition(mesh, n_parts);
+        check_partition(mesh, n_parts, info);
+    }
+}
+
+TEST(TestGraphMeshPartitioner, TestShuffledMesh) {
+
+    /***
+       * Test Scenario:    The application partitions a quad mesh whose elements are
+       *                   stored in random order as in an imported mesh
+       * Expected Output:  The quality of the partition does not depend on the order and
+       *                   is much better than the linear partition of the shuffled mesh
+     **/
+
+    Mesh<2> mesh;
+    build_mesh(mesh);
+
+    std::vector<uint_t> order(mesh.n_elements());
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), std::mt19937(42));
+    mesh.topology()->renumber_elements(order);
+
+    auto info = kernel::numerics::graph_mesh_partition(mesh, 8);
+    check_partition(mesh, 8, info);
+
+    // the straight cuts of 8 strips
+    ASSERT_LE(info.edge_cut, 7*N);
+}
+
+TEST(TestGraphPartitioner, TestDisconnectedGraph) {
+
+    /***
+       * Test Scenario:    The application partitions a graph of two disconnected paths
+       * Expected Output:  The paths are the two parts and the edge cut is zero
+     **/
+
+    // 0-1-2-3  4-5-6-7
+    std::vector<uint_t> xadj = {0, 1, 3, 5, 6, 7, 9, 11, 12};
+    std::vector<uint_t> adjncy = {1, 0, 2, 1, 3, 2, 5, 4, 6, 5, 7, 6};
+
+    GraphPartitionerConfig config;
+    config.coarsest_graph_size = 2;
+    config.imbalance_tolerance = 0.0;
+
+    std::vector<uint_t> parts;
+    auto info = kernel::GraphPartitioner(config).partition(xadj, adjncy, 2, parts);
+
+    ASSERT_EQ(info.edge_cut, 0);
+    ASSERT_EQ(info.part_weights[0], 4);
+    ASSERT_EQ(info.part_weights[1], 4);
+}
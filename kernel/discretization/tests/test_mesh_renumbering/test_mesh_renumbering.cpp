@@ -0,0 +1,212 @@
+#include "kernel/base/types.h"
+#include "kernel/discretization/mesh_renumbering.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/quad_mesh_generation.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/face_element.h"
+#include "kernel/discretization/node.h"
+#include "kernel/discretization/dof.h"
+#include "kernel/discretization/dof_manager.h"
+#include "kernel/geometry/geom_point.h"
+
+#include <vector>
+#include <string>
+#include <random>
+#include <numeric>
+#include <algorithm>
+#include <gtest/gtest.h>
+
+namespace{
+
+using kernel::real_t;
+using kernel::uint_t;
+using kernel::GeomPoint;
+using kernel::numerics::Mesh;
+using kernel::numerics::MeshRenumberingType;
+using kernel::numerics::FVDoFManager;
+
+/// \brief Minimal variable to distribute DoFs
+struct Variable
+{
+    std::string_view name()const{return "u";}
+};
+
+const uint_t NX = 20;
+const uint_t NY = 10;
+
+/// \brief Build a quad mesh and shuffle its elements to
+/// mimic the arbitrary order of an imported mesh
+void build_shuffled_mesh(Mesh<2>& mesh){
+
+    kernel::numerics::build_quad_mesh(mesh, NX, NY, GeomPoint<2>(0.0), GeomPoint<2>({2.0, 1.0}));
+
+    std::vector<uint_t> order(mesh.n_elements());
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), std::mt19937(42));
+
+    mesh.topology()->renumber_elements(order);
+}
+
+/// \brief The sum of the neighbor centroids for every element
+/// in storage order. It does not depend on the numbering of the
+/// neighbors and checks that the connectivity is unchanged
+std::vector<real_t> element_signatures(const Mesh<2>& mesh){
+
+    std::vector<real_t> signatures;
+    for(auto itr = mesh.elements_begin(); itr != mesh.elements_end(); ++itr){
+
+        const auto* element = *itr;
+        auto centroid = element->centroid();
+        real_t signature = 1000.0*centroid[0] + centroid[1];
+
+        for(uint_t n=0; n<element->n_neighbors(); ++n){
+            if(element->neighbor_ptr(n)){
+                auto neighbor = element->neighbor_ptr(n)->centroid();
+                signature += neighbor[0] + 10.0*neighbor[1];
+            }
+        }
+
+        signatures.push_back(signature);
+    }
+
+    return signatures;
+}
+
+void check_renumbering(MeshRenumberingType type){
+
+    Mesh<2> mesh;
+    build_shuffled_mesh(mesh);
+
+    std::vector<real_t> before = element_signatures(mesh);
+    std::vector<uint_t> order;
+    kernel::numerics::element_renumbering(mesh, type, order);
+
+    // the order is a permutation
+    std::vector<uint_t> sorted(order);
+    std::sort(sorted.begin(), sorted.end());
+    for(uint_t i=0; i<sorted.size(); ++i){
+        ASSERT_EQ(sorted[i], i);
+    }
+
+    const uint_t shuffled_bandwidth = kernel::numerics::element_bandwidth(mesh);
+    kernel::numerics::renumber_mesh(mesh, type);
+
+    // the ids are the new positions
+    for(uint_t e=0; e<mesh.n_elements(); ++e){
+        ASSERT_EQ(mesh.element(e)->get_id(), e);
+    }
+
+    for(uint_t n=0; n<mesh.n_nodes(); ++n){
+        ASSERT_EQ(mesh.node(n)->get_id(), n);
+    }
+
+    // the i-th element is the one stored at order[i]
+    std::vector<real_t> after = element_signatures(mesh);
+    for(uint_t e=0; e<after.size(); ++e){
+        ASSERT_DOUBLE_EQ(after[e], before[order[e]]);
+    }
+
+    ASSERT_LT(kernel::numerics::element_bandwidth(mesh), shuffled_bandwidth);
+}
+
+}
+
+TEST(TestMeshRenumbering, TestRenumberEntitiesInvalidPermutation) {
+
+    /***
+       * Test Scenario:    The application renumbers the elements with an invalid permutation
+       * Expected Output:  std::logic_error is thrown and the mesh is unchanged
+     **/
+
+    Mesh<2> mesh;
+    kernel::numerics::build_quad_mesh(mesh, 2, 2, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+
+    std::vector<uint_t> order = {0, 1, 1, 3};
+    ASSERT_THROW(mesh.topology()->renumber_elements(order), std::logic_error);
+
+    order = {0, 1, 2};
+    ASSERT_THROW(mesh.topology()->renumber_elements(order), std::logic_error);
+
+    for(uint_t e=0; e<mesh.n_elements(); ++e){
+        ASSERT_EQ(mesh.element(e)->get_id(), e);
+    }
+}
+
+TEST(TestMeshRenumbering, TestRCM) {
+
+    /***
+       * Test Scenario:    The application renumbers a shuffled quad mesh with RCM
+       * Expected Output:  The connectivity is unchanged and the bandwidth
+       *                   is at most that of the generated mesh
+     **/
+
+    check_renumbering(MeshRenumberingType::RCM);
+
+    Mesh<2> mesh;
+    build_shuffled_mesh(mesh);
+    kernel::numerics::renumber_mesh(mesh, MeshRenumberingType::RCM);
+
+    // level sets of a structured grid are its anti-diagonals
+    ASSERT_LE(kernel::numerics::element_bandwidth(mesh), std::min(NX, NY) + 1);
+}
+
+TEST(TestMeshRenumbering, TestHilbert) {
+
+    /***
+       * Test Scenario:    The application renumbers a shuffled quad mesh along the Hilbert curve
+       * Expected Output:  The connectivity is unchanged and consecutive
+       *                   elements of a 2^k x 2^k grid are neighbors
+     **/
+
+    check_renumbering(MeshRenumberingType::HILBERT);
+
+    Mesh<2> mesh;
+    kernel::numerics::build_quad_mesh(mesh, 16, 16, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+    kernel::numerics::renumber_mesh(mesh, MeshRenumberingType::HILBERT);
+
+    for(uint_t e=0; e + 1<mesh.n_elements(); ++e){
+
+        const auto* element = mesh.element(e);
+        bool is_neighbor = false;
+
+        for(uint_t n=0; n<element->n_neighbors(); ++n){
+            if(element->neighbor_ptr(n) && element->neighbor_ptr(n)->get_id() == e + 1){
+                is_neighbor = true;
+            }
+        }
+
+        ASSERT_TRUE(is_neighbor);
+    }
+}
+
+TEST(TestMeshRenumbering, TestMorton) {
+
+    /***
+       * Test Scenario:    The application renumbers a shuffled quad mesh along the Morton curve
+       * Expected Output:  The connectivity is unchanged and the bandwidth is reduced
+     **/
+
+    check_renumbering(MeshRenumberingType::MORTON);
+}
+
+TEST(TestMeshRenumbering, TestDoFsFollowElements) {
+
+    /***
+       * Test Scenario:    The application renumbers a mesh and distributes the DoFs
+       * Expected Output:  The DoF of every element is its new position
+     **/
+
+    Mesh<2> mesh;
+    build_shuffled_mesh(mesh);
+    kernel::numerics::renumber_mesh(mesh, MeshRenumberingType::RCM);
+
+    FVDoFManager<2> dof_manager;
+    dof_manager.distribute_dofs(mesh, Variable());
+
+    std::vector<kernel::numerics::DoF> dofs;
+    for(uint_t e=0; e<mesh.n_elements(); ++e){
+
+        dof_manager.get_dofs(*mesh.element(e), dofs);
+        ASSERT_EQ(dofs[0].id, e);
+    }
+}
@@ -0,0 +1,114 @@
+/**
+ * Benchmark the idle behaviour of ThreadPool. It reports
+ * the CPU time consumed by an idle pool and the latency
+ * of waking up a parked worker to execute a single task.
+ * A pool that never parks its workers (spinning) is compared
+ * against the default pool that blocks after spinning briefly.
+ */
+
+#include "kernel/base/types.h"
+#include "kernel/parallel/threading/thread_pool.h"
+#include "kernel/parallel/threading/simple_task.h"
+
+#include <ctime>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <limits>
+#include <algorithm>
+#include <iostream>
+
+namespace  {
+
+using kernel::uint_t;
+using kernel::real_t;
+using kernel::ThreadPool;
+using kernel::ThreadPoolOptions;
+
+class EmptyTask: public kernel::SimpleTaskBase<kernel::Null>
+{
+public:
+
+    EmptyTask()
+        :
+    kernel::SimpleTaskBase<kernel::Null>()
+    {}
+
+protected:
+
+    virtual void run()final{}
+
+};
+
+const uint_t N_THREADS = 4;
+const uint_t IDLE_MILLISECONDS = 1000;
+const uint_t N_WAKE_UPS = 200;
+
+void
+benchmark(const std::string& name, uint_t n_idle_spins){
+
+    ThreadPoolOptions options;
+    options.n_threads = N_THREADS;
+    options.n_idle_spins = n_idle_spins;
+
+    ThreadPool pool(options);
+
+    // CPU time used by all the threads of the process
+    // whilst the pool has no work to do
+    auto cpu_start = std::clock();
+    std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_MILLISECONDS));
+    auto cpu_end = std::clock();
+
+    real_t cpu_seconds = static_cast<real_t>(cpu_end - cpu_start)/CLOCKS_PER_SEC;
+    real_t idle_cores = cpu_seconds/(static_cast<real_t>(IDLE_MILLISECONDS)/1000.0);
+
+    // wake up latency. Let the workers go idle
+    // and then submit a single task
+    std::vector<std::unique_ptr<EmptyTask>> tasks;
+    tasks.push_back(std::make_unique<EmptyTask>());
+
+    real_t total = 0.0;
+    real_t max_latency = 0.0;
+    real_t min_latency = std::numeric_limits<real_t>::max();
+
+    for(uint_t i=0; i<N_WAKE_UPS; ++i){
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        tasks[0]->reschedule();
+
+        auto start = std::chrono::steady_clock::now();
+        pool.execute(tasks, kernel::Null());
+        auto end = std::chrono::steady_clock::now();
+
+        std::chrono::duration<real_t, std::micro> dur = end - start;
+        total += dur.count();
+        max_latency = std::max(max_latency, dur.count());
+        min_latency = std::min(min_latency, dur.count());
+    }
+
+    std::cout<<name<<std::endl;
+    std::cout<<"\tIdle CPU time (s):          "<<cpu_seconds<<" over "<<IDLE_MILLISECONDS<<" ms"<<std::endl;
+    std::cout<<"\tIdle cores busy:            "<<idle_cores<<std::endl;
+    std::cout<<"\tWake up latency mean (us):  "<<total/N_WAKE_UPS<<std::endl;
+    std::cout<<"\tWake up latency min (us):   "<<min_latency<<std::endl;
+    std::cout<<"\tWake up latency max (us):   "<<max_latency<<std::endl;
+}
+
+}
+
+int main(){
+
+    std::cout<<"Threads used: "<<N_THREADS<<std::endl;
+
+    // never park the workers
+    benchmark("Spinning workers", std::numeric_limits<uint_t>::max());
+
+    // spin briefly and then park
+    benchmark("Parking workers (default)", ThreadPoolOptions().n_idle_spins);
+
+    // park immediately
+    benchmark("Parking workers (no spin)", 0);
+
+    return 0;
+}
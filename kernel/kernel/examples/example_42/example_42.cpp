@@ -0,0 +1,122 @@
+/**
+ * Benchmark the throughput of TaskQueue using the mutex based
+ * implementation against the lock-free implementation. Two scenarios are
+ * examined. In the first the queue is almost empty; every thread pushes a task
+ * and then pops a task. In the second the queue is saturated; it is filled up
+ * before the threads start and every thread pops a task and then pushes it back.
+ */
+
+#include "kernel/base/types.h"
+#include "kernel/parallel/data_structs/task_queue.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+
+namespace  {
+
+using kernel::uint_t;
+using kernel::real_t;
+using kernel::TaskQueue;
+using kernel::MutexQueueImpl;
+using kernel::LockFreeQueueImpl;
+
+/// dummy task type. The queues only hold pointers
+struct Task{};
+
+const uint_t QUEUE_CAPACITY = 1024;
+const uint_t TOTAL_OPERATIONS = 2000000;
+const std::vector<uint_t> N_THREADS = {1, 2, 4, 8, 16, 32, 64};
+
+template<typename QueueTp>
+QueueTp* make_queue(){return new QueueTp();}
+
+template<>
+TaskQueue<Task, LockFreeQueueImpl>* make_queue<TaskQueue<Task, LockFreeQueueImpl>>(){
+    return new TaskQueue<Task, LockFreeQueueImpl>(QUEUE_CAPACITY);
+}
+
+/// returns millions of push/pop pairs per second
+template<typename QueueTp>
+real_t
+run(uint_t n_threads, bool saturated){
+
+    std::unique_ptr<QueueTp> queue(make_queue<QueueTp>());
+    std::vector<Task> tasks(QUEUE_CAPACITY);
+
+    if(saturated){
+
+        // leave room for each thread to push
+        // back the task it popped
+        for(uint_t t=0; t<QUEUE_CAPACITY - n_threads; ++t){
+            queue->push_task(&tasks[t]);
+        }
+    }
+
+    const uint_t n_ops = TOTAL_OPERATIONS/n_threads;
+    std::vector<std::thread> threads;
+    threads.reserve(n_threads);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for(uint_t t=0; t<n_threads; ++t){
+
+        threads.emplace_back([&queue, &tasks, n_ops, t, saturated](){
+
+            Task* task = &tasks[t];
+            for(uint_t i=0; i<n_ops; ++i){
+
+                if(saturated){
+
+                    // only push back what we popped otherwise
+                    // the queue overflows and push_task blocks
+                    if(queue->pop(task)){
+                        queue->push_task(task);
+                    }
+                }
+                else{
+                    queue->push_task(task);
+                    queue->pop(task);
+                }
+            }
+        });
+    }
+
+    for(auto& thread: threads){
+        thread.join();
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<real_t> dur = end - start;
+
+    return static_cast<real_t>(n_ops*n_threads)/dur.count()/1.0e6;
+}
+
+void
+benchmark(bool saturated){
+
+    std::cout<<(saturated ? "Saturated queue" : "Empty queue")<<" (Mops/s)"<<std::endl;
+    std::cout<<std::setw(10)<<"threads"<<std::setw(15)<<"mutex"<<std::setw(15)<<"lock-free"<<std::endl;
+
+    for(auto n_threads: N_THREADS){
+
+        real_t mutex = run<TaskQueue<Task, MutexQueueImpl>>(n_threads, saturated);
+        real_t lock_free = run<TaskQueue<Task, LockFreeQueueImpl>>(n_threads, saturated);
+
+        std::cout<<std::setw(10)<<n_threads
+                 <<std::setw(15)<<mutex
+                 <<std::setw(15)<<lock_free<<std::endl;
+    }
+}
+
+}
+
+int main(){
+
+    std::cout<<"Hardware threads: "<<std::thread::hardware_concurrency()<<std::endl;
+    benchmark(false);
+    benchmark(true);
+    return 0;
+}
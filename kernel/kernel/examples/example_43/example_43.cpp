@@ -0,0 +1,140 @@
+/**
+ * Benchmark the threaded matrix-vector product MatVecProduct.
+ * A dense matrix and a sparse matrix that corresponds to the five point
+ * Laplacian on a structured grid are multiplied with a vector. MatVecProduct
+ * partitions the rows by the work per row using partition_matrix_rows(). The benchmark
+ * reports the achieved GFLOP/s and the effective memory bandwidth in GB/s.
+ * The product is memory bound so the bandwidth is the figure to compare
+ * against the STREAM bandwidth of the machine.
+ */
+
+#include "kernel/base/types.h"
+#include "kernel/parallel/threading/thread_pool.h"
+#include "kernel/parallel/utilities/partitioned_type.h"
+#include "kernel/parallel/parallel_algos/linear_algebra/matrix_vector_product.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+
+namespace  {
+
+using kernel::uint_t;
+using kernel::real_t;
+using kernel::ThreadPool;
+using DenseMatrix = kernel::PartitionedType<kernel::DynMat<real_t>>;
+using SparseMatrix = kernel::PartitionedType<kernel::SparseMatrix<real_t>>;
+using Vector = kernel::DynVec<real_t>;
+
+const uint_t DENSE_N = 4000;
+const uint_t GRID_N = 1000;
+const uint_t N_REPETITIONS = 20;
+const std::vector<uint_t> N_THREADS = {1, 2, 4, 8};
+
+void
+build_laplacian(SparseMatrix& mat){
+
+    const uint_t n = GRID_N*GRID_N;
+    mat.resize(n, n, false);
+    mat.reserve(5*n);
+
+    for(uint_t i=0; i<GRID_N; ++i){
+        for(uint_t j=0; j<GRID_N; ++j){
+
+            const uint_t r = i*GRID_N + j;
+
+            // columns must be appended in increasing order
+            if(i > 0) mat.append(r, r - GRID_N, -1.0);
+            if(j > 0) mat.append(r, r - 1, -1.0);
+            mat.append(r, r, 4.0);
+            if(j + 1 < GRID_N) mat.append(r, r + 1, -1.0);
+            if(i + 1 < GRID_N) mat.append(r, r + GRID_N, -1.0);
+
+            mat.finalize(r);
+        }
+    }
+}
+
+/// returns the average time in seconds for one product
+template<typename MatTp>
+real_t
+run(MatTp& mat, const Vector& x, uint_t n_threads){
+
+    ThreadPool pool(n_threads);
+    kernel::MatVecProduct<MatTp, Vector> product(mat, x);
+
+    // warm up and create the tasks
+    product.execute(pool, kernel::Null());
+
+    auto start = std::chrono::steady_clock::now();
+
+    for(uint_t i=0; i<N_REPETITIONS; ++i){
+        product.reexecute(pool, kernel::Null());
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<real_t> dur = end - start;
+    return dur.count()/N_REPETITIONS;
+}
+
+void
+print(uint_t n_threads, real_t time, real_t flops, real_t bytes){
+
+    std::cout<<std::setw(10)<<n_threads
+             <<std::setw(15)<<time*1.0e3
+             <<std::setw(15)<<flops/time/1.0e9
+             <<std::setw(15)<<bytes/time/1.0e9<<std::endl;
+}
+
+void
+header(const std::string& name){
+
+    std::cout<<name<<std::endl;
+    std::cout<<std::setw(10)<<"threads"
+             <<std::setw(15)<<"time (ms)"
+             <<std::setw(15)<<"GFLOP/s"
+             <<std::setw(15)<<"GB/s"<<std::endl;
+}
+
+}
+
+int main(){
+
+    std::cout<<"Hardware threads: "<<std::thread::hardware_concurrency()<<std::endl;
+
+    {
+        DenseMatrix mat(DENSE_N, DENSE_N, 1.0);
+        Vector x(DENSE_N, 1.0);
+
+        // every entry is read once plus the x and y vectors
+        const real_t flops = 2.0*DENSE_N*DENSE_N;
+        const real_t bytes = sizeof(real_t)*(static_cast<real_t>(DENSE_N)*DENSE_N + 2.0*DENSE_N);
+
+        header("Dense "+std::to_string(DENSE_N)+"x"+std::to_string(DENSE_N));
+        for(auto n_threads: N_THREADS){
+            print(n_threads, run(mat, x, n_threads), flops, bytes);
+        }
+    }
+
+    {
+        SparseMatrix mat;
+        build_laplacian(mat);
+        Vector x(mat.columns(), 1.0);
+
+        // every nonzero reads a value and a column index. The
+        // row offsets, x and y are read or written once
+        const real_t nnz = mat.nonZeros();
+        const real_t rows = mat.rows();
+        const real_t flops = 2.0*nnz;
+        const real_t bytes = nnz*(sizeof(real_t) + sizeof(uint_t)) + rows*(sizeof(uint_t) + 2.0*sizeof(real_t));
+
+        header("Sparse five point Laplacian "+std::to_string(mat.rows())+" rows");
+        for(auto n_threads: N_THREADS){
+            print(n_threads, run(mat, x, n_threads), flops, bytes);
+        }
+    }
+
+    return 0;
+}
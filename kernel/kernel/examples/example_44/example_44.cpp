@@ -0,0 +1,156 @@
+/**
+ * Benchmark the per-iteration overhead of launching a parallel loop.
+ * For a small vector parallel_for() creates a new set of tasks on every call
+ * whilst an execution plan, see make_parallel_for_plan(), creates the tasks once
+ * and only reschedules them. The same comparison is made for MatVecProduct
+ * between execute() and reexecute(). The benchmark reports the average time
+ * per iteration and the number of heap allocations per iteration.
+ */
+
+#include "kernel/base/config.h"
+#include "kernel/base/types.h"
+#include "kernel/parallel/threading/thread_pool.h"
+#include "kernel/parallel/utilities/partitioned_type.h"
+#include "kernel/parallel/utilities/array_partitioner.h"
+#include "kernel/parallel/parallel_algos/parallel_for.h"
+#include "kernel/parallel/parallel_algos/linear_algebra/matrix_vector_product.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+
+namespace  {
+
+/// number of calls to operator new
+std::atomic<std::size_t> n_allocations(0);
+
+}
+
+void* operator new(std::size_t size){
+
+    n_allocations++;
+    if(void* ptr = std::malloc(size)){
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr)noexcept{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t)noexcept{
+    std::free(ptr);
+}
+
+namespace  {
+
+using kernel::uint_t;
+using kernel::real_t;
+using kernel::ThreadPool;
+using Matrix = kernel::PartitionedType<kernel::DynMat<real_t>>;
+using Vector = kernel::DynVec<real_t>;
+
+const uint_t N_THREADS = 4;
+const uint_t N = 1000;
+const uint_t MAT_N = 64;
+const uint_t N_ITERATIONS = 10000;
+
+struct Measurement
+{
+    real_t micro_seconds;
+    real_t allocations;
+};
+
+template<typename FunctionTp>
+Measurement
+measure(const FunctionTp& function){
+
+    // warm up
+    function();
+
+    const auto allocations = n_allocations.load();
+    auto start = std::chrono::steady_clock::now();
+
+    for(uint_t i=0; i<N_ITERATIONS; ++i){
+        function();
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<real_t, std::micro> dur = end - start;
+
+    return {dur.count()/N_ITERATIONS,
+            static_cast<real_t>(n_allocations.load() - allocations)/N_ITERATIONS};
+}
+
+void
+print(const std::string& name, const Measurement& m){
+
+    std::cout<<std::setw(35)<<name
+             <<std::setw(20)<<m.micro_seconds
+             <<std::setw(20)<<m.allocations<<std::endl;
+}
+
+template<typename ExecutorTp, typename Options>
+void
+benchmark(const std::string& name, ExecutorTp& executor, const Options& options){
+
+    std::vector<kernel::range1d<uint_t>> partitions;
+    kernel::partition_range(0, N, partitions, executor.n_processing_elements());
+
+    kernel::PartitionedType<std::vector<real_t>> values(N, 0.0);
+    values.set_partitions(partitions);
+
+    auto body = [](real_t& value){value += 1.0;};
+
+    std::cout<<name<<std::endl;
+    std::cout<<std::setw(35)<<"operation"
+             <<std::setw(20)<<"time/itr (us)"
+             <<std::setw(20)<<"allocations/itr"<<std::endl;
+
+    print("parallel_for", measure([&](){
+        kernel::parallel_for(values, body, executor, options);
+    }));
+
+    auto plan = kernel::make_parallel_for_plan(values, body, executor);
+    print("parallel_for plan", measure([&](){
+        plan.execute(options);
+    }));
+}
+
+}
+
+int main(){
+
+    {
+        ThreadPool pool(N_THREADS);
+        benchmark("ThreadPool", pool, kernel::Null());
+
+        Matrix mat(MAT_N, MAT_N, 1.0);
+        Vector x(MAT_N, 1.0);
+
+        kernel::MatVecProduct<Matrix, Vector> product(mat, x);
+
+        print("MatVecProduct::execute", measure([&](){
+            product.execute(pool, kernel::Null());
+        }));
+
+        print("MatVecProduct::reexecute", measure([&](){
+            product.reexecute(pool, kernel::Null());
+        }));
+    }
+
+#ifdef USE_OPENMP
+    {
+        kernel::OMPExecutor executor(N_THREADS);
+        benchmark("OMPExecutor", executor, kernel::OMPOptions());
+    }
+#endif
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+/**
+ * Benchmark fused reductions. CG-like solvers need the dot product (r, z)
+ * and the squared norm (r, r) in every iteration. Computing them with two
+ * DotProduct calls reads r twice. Using parallel_reduce with FusedReduction
+ * both are computed in one pass so r is read once.
+ */
+
+#include "kernel/base/types.h"
+#include "kernel/parallel/threading/thread_pool.h"
+#include "kernel/parallel/utilities/partitioned_type.h"
+#include "kernel/parallel/utilities/array_partitioner.h"
+#include "kernel/parallel/utilities/reduction_operations.h"
+#include "kernel/parallel/parallel_algos/parallel_reduce.h"
+#include "kernel/parallel/parallel_algos/linear_algebra/dot_product.h"
+
+#include <chrono>
+#include <tuple>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+
+namespace  {
+
+using kernel::uint_t;
+using kernel::real_t;
+using kernel::ThreadPool;
+using Vector = kernel::PartitionedType<kernel::DynVec<real_t>>;
+
+const uint_t N = 4000000;
+const uint_t N_REPETITIONS = 50;
+const std::vector<uint_t> N_THREADS = {1, 2, 4, 8};
+
+template<typename FunctionTp>
+real_t
+measure(const FunctionTp& function){
+
+    // warm up
+    function();
+
+    auto start = std::chrono::steady_clock::now();
+
+    for(uint_t i=0; i<N_REPETITIONS; ++i){
+        function();
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<real_t, std::milli> dur = end - start;
+    return dur.count()/N_REPETITIONS;
+}
+
+}
+
+int main(){
+
+    std::cout<<"Hardware threads: "<<std::thread::hardware_concurrency()<<std::endl;
+    std::cout<<std::setw(10)<<"threads"
+             <<std::setw(20)<<"two dots (ms)"
+             <<std::setw(20)<<"fused (ms)"
+             <<std::setw(15)<<"speed up"<<std::endl;
+
+    typedef kernel::FusedReduction<kernel::Sum<real_t>, kernel::Sum<real_t>> reduction_type;
+
+    for(auto n_threads: N_THREADS){
+
+        ThreadPool pool(n_threads);
+
+        std::vector<kernel::range1d<uint_t>> partitions;
+        kernel::partition_range(0, N, partitions, n_threads);
+
+        Vector r(N, 1.0);
+        r.set_partitions(partitions);
+
+        Vector z(N, 2.0);
+        z.set_partitions(partitions);
+
+        kernel::DotProduct<Vector, real_t> r_dot_z(r, z);
+        kernel::DotProduct<Vector, real_t> r_dot_r(r, r);
+
+        real_t separate = measure([&](){
+            r_dot_z.reexecute(pool, kernel::Null());
+            r_dot_r.reexecute(pool, kernel::Null());
+        });
+
+        auto map = [&r, &z](uint_t i){
+            const real_t ri = r[i];
+            return std::make_tuple(ri*z[i], ri*ri);
+        };
+
+        real_t fused = measure([&](){
+            kernel::parallel_reduce(r, map, reduction_type(), pool, kernel::Null());
+        });
+
+        // make sure both approaches agree
+        auto result = kernel::parallel_reduce(r, map, reduction_type(), pool, kernel::Null());
+        if(std::get<0>(result.get_resource()) != r_dot_z.get().get_resource() ||
+           std::get<1>(result.get_resource()) != r_dot_r.get().get_resource()){
+            std::cout<<"Fused and separate reductions do not agree"<<std::endl;
+        }
+
+        std::cout<<std::setw(10)<<n_threads
+                 <<std::setw(20)<<separate
+                 <<std::setw(20)<<fused
+                 <<std::setw(15)<<separate/fused<<std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,156 @@
+/**
+ * CSV ingestion throughput. A numeric CSV file with a header is written
+ * and then read into a feature matrix and a label vector with the
+ * line-based CSVFileReader, which splits every line into strings, and
+ * with the memory-mapped CSVDataReader using one and several threads.
+ * The MB/s of every reader are reported.
+ */
+
+#include "kernel/base/types.h"
+#include "kernel/base/kernel_consts.h"
+#include "kernel/utilities/csv_file_reader.h"
+#include "kernel/utilities/csv_data_reader.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+
+namespace  {
+
+using kernel::uint_t;
+using kernel::real_t;
+using kernel::DynMat;
+using kernel::DynVec;
+using kernel::CSVFileReader;
+using kernel::CSVDataReader;
+using kernel::CSVDataReaderConfig;
+using kernel::KernelConsts;
+
+const std::string FILE_NAME = "example_55.csv";
+const uint_t N_ROWS = 500000;
+const uint_t N_FEATURES = 10;
+
+void write_file(){
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<real_t> distribution(-100.0, 100.0);
+
+    std::ofstream file(FILE_NAME);
+    file<<std::setprecision(10);
+
+    for(uint_t c=0; c<N_FEATURES; ++c){
+        file<<"x"<<c<<",";
+    }
+
+    file<<"label\n";
+
+    for(uint_t r=0; r<N_ROWS; ++r){
+        for(uint_t c=0; c<N_FEATURES; ++c){
+            file<<distribution(generator)<<",";
+        }
+
+        file<<distribution(generator)<<"\n";
+    }
+}
+
+/// \brief Read the file as BlazeRegressionDataset would
+/// with the line-based reader
+void read_line_based(DynMat<real_t>& features, DynVec<real_t>& labels){
+
+    CSVFileReader reader(FILE_NAME);
+
+    // the header
+    auto line = reader.read_line();
+
+    std::vector<std::vector<real_t>> rows;
+
+    while(true){
+
+        line = reader.read_line();
+
+        if(line.size() == 1 && (line[0] == KernelConsts::eof_string() || line[0].empty())){
+            break;
+        }
+
+        std::vector<real_t> row(line.size());
+        for(uint_t c=0; c<line.size(); ++c){
+            row[c] = std::stod(line[c]);
+        }
+
+        rows.push_back(std::move(row));
+    }
+
+    features.resize(rows.size(), N_FEATURES);
+    labels.resize(rows.size());
+
+    for(uint_t r=0; r<rows.size(); ++r){
+
+        for(uint_t c=0; c<N_FEATURES; ++c){
+            features(r, c) = rows[r][c];
+        }
+
+        labels[r] = rows[r][N_FEATURES];
+    }
+}
+
+real_t mb_per_second(uint_t n_bytes, std::chrono::steady_clock::time_point start){
+
+    const real_t seconds = std::chrono::duration<real_t>(std::chrono::steady_clock::now() - start).count();
+    return n_bytes/(1024.0*1024.0)/seconds;
+}
+
+}
+
+int main(){
+
+    try{
+
+        write_file();
+
+        DynMat<real_t> features;
+        DynVec<real_t> labels;
+
+        auto start = std::chrono::steady_clock::now();
+        read_line_based(features, labels);
+
+        std::ifstream file(FILE_NAME, std::ios::binary | std::ios::ate);
+        const uint_t n_bytes = file.tellg();
+
+        std::cout<<"File size (MB): "<<n_bytes/(1024.0*1024.0)<<" rows: "<<features.rows()<<std::endl;
+        std::cout<<std::setw(24)<<"reader"<<std::setw(12)<<"MB/s"<<std::endl;
+        std::cout<<std::setw(24)<<"CSVFileReader"<<std::setw(12)<<mb_per_second(n_bytes, start)<<std::endl;
+
+        for(uint_t n_threads : {1, 2, 4, 8}){
+
+            CSVDataReaderConfig config;
+            config.n_threads = n_threads;
+
+            std::map<std::string, uint_t> columns;
+            CSVDataReader reader(FILE_NAME, config);
+
+            start = std::chrono::steady_clock::now();
+            reader.read(features, labels, columns);
+
+            std::cout<<std::setw(24)<<"CSVDataReader threads "+std::to_string(n_threads)
+                     <<std::setw(12)<<mb_per_second(reader.n_bytes(), start)<<std::endl;
+        }
+
+        std::remove(FILE_NAME.c_str());
+    }
+    catch(std::exception& e){
+
+        std::cerr<<e.what()<<std::endl;
+    }
+    catch(...){
+
+        std::cerr<<"Unknown exception occured"<<std::endl;
+    }
+
+    return 0;
+}
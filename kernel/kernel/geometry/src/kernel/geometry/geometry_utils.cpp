@@ -3,10 +3,19 @@
 namespace kernel{
 
 const GeomPoint<3>
-cross_product(const GeomPoint<3>& o1, const GeomPoint<3>& o2){return GeomPoint<3>();}
+cross_product(const GeomPoint<3>& o1, const GeomPoint<3>& o2){
+
+    return GeomPoint<3>({o1[1]*o2[2] - o1[2]*o2[1],
+                         o1[2]*o2[0] - o1[0]*o2[2],
+                         o1[0]*o2[1] - o1[1]*o2[0]});
+}
 
 const GeomPoint<3>
-cross_product(const GeomPoint<2>& o1, const GeomPoint<2>& o2){return GeomPoint<3>();}
+cross_product(const GeomPoint<2>& o1, const GeomPoint<2>& o2){
+
+    // the points lie on the z = 0 plane
+    return GeomPoint<3>({0.0, 0.0, o1[0]*o2[1] - o1[1]*o2[0]});
+}
 
 
 }
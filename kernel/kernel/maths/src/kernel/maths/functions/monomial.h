@@ -75,6 +75,11 @@ public:
     ///
     real_t coeff()const{return coeff_;}
 
+    ///
+    /// \brief Returns the order
+    ///
+    int order()const{return order_;}
+
     ///
     /// \brief Set the coefficient
     ///
@@ -49,20 +49,7 @@ PolynomialFunction::coeffs()const{
 
 PolynomialFunction::output_t
 PolynomialFunction::value(const input_t& input)const{
-
-    if(input.size() != monomials_.size()){
-        throw std::invalid_argument("input size: " + std::to_string(input.size())+
-                                    " not equal to monomials size: " + std::to_string(monomials_.size()) );
-    }
-
-    PolynomialFunction::output_t result = 0.0;
-    uint_t i=0;
-    for(auto item : input){
-
-        result += monomials_[i++].value(item);
-    }
-
-    return result;
+    return value_at(input);
 }
 
 
@@ -90,14 +77,7 @@ PolynomialFunction::coeff_grad(uint_t i, const DynVec<real_t>& point)const{
 
 DynVec<real_t>
 PolynomialFunction::coeff_grads(const DynVec<real_t>& point)const{
-
-    DynVec<real_t> result(monomials_.size(), 0.0);
-
-    for(uint_t c=0; c<result.size(); ++c){
-        result[c] = coeff_grad(c, point);
-    }
-
-    return result;
+    return param_grads_at(point);
 }
 
 real_t
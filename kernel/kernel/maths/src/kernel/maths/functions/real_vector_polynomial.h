@@ -6,6 +6,8 @@
 #include "kernel/maths/functions/monomial.h"
 
 #include <vector>
+#include <stdexcept>
+#include <string>
 
 #ifdef KERNEL_DEBUG
 #include <cassert>
@@ -52,7 +54,13 @@ public:
     ///
     virtual output_t value(const input_t& input)const override final;
 
-    output_t value_at(const input_t& input)const{return value(input);}
+    ///
+    /// \brief Returns the value of the function at the given vector.
+    /// VecTp can be any vector with size() and operator[] e.g. a
+    /// view of a matrix row so that the row is not copied
+    ///
+    template<typename VecTp>
+    output_t value_at(const VecTp& input)const;
 
     ///
     /// \brief value
@@ -64,6 +72,12 @@ public:
     ///
     virtual uint_t n_coeffs()const final{return monomials_.size();}
 
+    ///
+    /// \brief Returns true if every variable has order 1. The value
+    /// at a vector x is then the dot product of the coefficients and x
+    ///
+    bool is_linear()const;
+
     ///
     /// \brief Returns the gradient of the function for the i-th coefficient
     ///
@@ -74,8 +88,12 @@ public:
     ///
     DynVec<real_t> coeff_grads(const DynVec<real_t>& point)const;
 
-
-    DynVec<real_t> param_grads_at(const DynVec<real_t>& point)const{return coeff_grads(point);}
+    ///
+    /// \brief Returns the gradients of the function for the coefficients
+    /// at the given vector. VecTp is as in value_at
+    ///
+    template<typename VecTp>
+    DynVec<real_t> param_grads_at(const VecTp& point)const;
 
     ///
     /// \brief Returns the gradient of the function for the i-th variable
@@ -139,6 +157,49 @@ PolynomialFunction::create_from(const ContainerTp& coeffs, const std::vector<int
     }
 }
 
+template<typename VecTp>
+PolynomialFunction::output_t
+PolynomialFunction::value_at(const VecTp& input)const{
+
+    if(input.size() != monomials_.size()){
+        throw std::invalid_argument("input size: " + std::to_string(input.size())+
+                                    " not equal to monomials size: " + std::to_string(monomials_.size()) );
+    }
+
+    output_t result = 0.0;
+    for(uint_t i=0; i<monomials_.size(); ++i){
+        result += monomials_[i].value(input[i]);
+    }
+
+    return result;
+}
+
+template<typename VecTp>
+DynVec<real_t>
+PolynomialFunction::param_grads_at(const VecTp& point)const{
+
+    DynVec<real_t> result(monomials_.size(), 0.0);
+
+    for(uint_t c=0; c<result.size(); ++c){
+        result[c] = c == 0 ? 1.0 : monomials_[c].coeff_grad(point[c]);
+    }
+
+    return result;
+}
+
+inline
+bool
+PolynomialFunction::is_linear()const{
+
+    for(const auto& monomial : monomials_){
+        if(monomial.order() != 1){
+            return false;
+        }
+    }
+
+    return true;
+}
+
 template<typename ContainerTp>
 void
 PolynomialFunction::set_coeffs(const ContainerTp& coeffs){
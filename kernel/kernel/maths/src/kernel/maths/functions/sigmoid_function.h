@@ -31,11 +31,30 @@ public:
     ///
     virtual output_t value(uint_t i, const input_t&  input)const final override;
 
+    ///
+    /// \brief Returns the value of the function at the given vector.
+    /// VecTp can be any vector supported by the value_at of the wrapped function
+    ///
+    template<typename VecTp>
+    output_t value_at(const VecTp& input)const;
+
+    ///
+    /// \brief Returns the gradients of the function for the coefficients
+    /// of the wrapped function at the given vector
+    ///
+    template<typename VecTp>
+    DynVec<real_t> param_grads_at(const VecTp& input)const;
+
     ///
     /// \breif Returns the raw value of the function it wraps
     ///
     output_t raw_value(const input_t&  input)const{return function_ptr_->value(input);}
 
+    ///
+    /// \brief Returns the function it wraps
+    ///
+    const function_t& function()const{return *function_ptr_;}
+
     ///
     /// \brief Returns the gradients of the function
     ///
@@ -98,6 +117,30 @@ SigmoidFunction<FunctionType>::value(uint_t i, const input_t&  input)const{
     return 1.0/(1.0 + std::exp(-result));
 }
 
+template<typename FunctionType>
+template<typename VecTp>
+typename SigmoidFunction<FunctionType>::output_t
+SigmoidFunction<FunctionType>::value_at(const VecTp& input)const{
+
+    auto result = function_ptr_->value_at(input);
+    return 1.0/(1.0 + std::exp(-result));
+}
+
+template<typename FunctionType>
+template<typename VecTp>
+DynVec<real_t>
+SigmoidFunction<FunctionType>::param_grads_at(const VecTp& input)const{
+
+    auto val = value_at(input);
+    auto result = function_ptr_->param_grads_at(input);
+
+    for(uint_t c=0; c<result.size(); ++c){
+        result[c] *= val*(1.0 - val);
+    }
+
+    return result;
+}
+
 template<typename FunctionType>
 DynVec<real_t>
 SigmoidFunction<FunctionType>::gradients(const input_t&  input)const{
@@ -4,6 +4,8 @@
 #include "kernel/base/types.h"
 #include "kernel/geometry/geom_point.h"
 
+#include <cmath>
+
 namespace kernel
 {
 
@@ -36,6 +38,13 @@ public:
    template<int dim>
    real_t operator()(const GeomPoint<dim>& v1, const GeomPoint<dim>& v2  )const;
 
+   /// \brief Overload operator() for vectors of other types e.g. views
+   /// of matrix rows. The vectors are not copied. The result is the same
+   /// as the one of evaluate() for DynVec; for P = 1, 2, 3 the root
+   /// is taken regardless of TTakeRoot
+   template<typename VecTp1, typename VecTp2>
+   real_t operator()(const VecTp1& v1, const VecTp2& v2)const;
+
    /// \brief evaluate
    static real_t evaluate(const DynVec<real_t>& v1, const DynVec<real_t>& v2);
 
@@ -51,6 +60,35 @@ LpMetric<P,TTakeRoot>::operator()(const GeomPoint<dim>& v1, const GeomPoint<dim>
     return LpMetric<P,TTakeRoot>::evaluate(v1, v2);
 }
 
+template<int P, bool TTakeRoot>
+template<typename VecTp1, typename VecTp2>
+real_t
+LpMetric<P,TTakeRoot>::operator()(const VecTp1& v1, const VecTp2& v2)const{
+
+    // follow the specializations of evaluate()
+    if constexpr(P == 1){
+        return blaze::l1Norm(v1 - v2);
+    }
+    else if constexpr(P == 2){
+        return std::sqrt(blaze::sqrNorm(v1 - v2));
+    }
+    else if constexpr(P == 3){
+        return std::pow(blaze::reduce(blaze::pow(blaze::abs(v1 - v2), 3.0), blaze::Add()), 1.0 / 3.0);
+    }
+    else{
+
+        real_t sum = 0.0;
+        for (uint_t i = 0; i < v1.size(); i++){
+            sum += std::pow(std::fabs(v1[i] - v2[i]), P);
+        }
+
+        if (!TTakeRoot)
+           return sum;
+
+        return std::pow(sum, (1.0 / P));
+    }
+}
+
 /// \brief some useful shortcuts
 using ManhattanMetric = LpMetric<1, false> ;
 using SqrEuclidean_metric =  LpMetric<2, false> ;
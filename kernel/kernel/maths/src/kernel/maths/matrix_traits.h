@@ -17,10 +17,24 @@ struct matrix_row_trait<DynMat<T>>
     typedef T value_t;
     typedef DynVec<T> row_t;
 
+    ///
+    /// \brief row_view_t A non-owning column vector over the
+    /// elements of a row. The rows of a row-major DynMat are
+    /// contiguous so no copy is needed
+    ///
+    typedef blaze::CustomVector<const T, blaze::unaligned, blaze::unpadded> row_view_t;
+
     ///
     /// \brief get_row Returns the row with index row_idx
     ///
     static row_t get_row(const DynMat<T>& matrix, uint_t row_idx);
+
+    ///
+    /// \brief get_row_view Returns a view of the row with index row_idx.
+    /// The view is valid as long as the matrix is not resized or destroyed
+    ///
+    static row_view_t get_row_view(const DynMat<T>& matrix, uint_t row_idx)
+    {return row_view_t(matrix.data(row_idx), matrix.columns());}
 };
 
 template<typename T>
@@ -48,11 +62,18 @@ struct matrix_row_trait<PartitionedType<DynMat<T>>>
 
     typedef T value_t;
     typedef DynVec<T> row_t;
+    typedef typename matrix_row_trait<DynMat<T>>::row_view_t row_view_t;
 
     ///
     /// \brief get_row Returns the row with index row_idx
     ///
     static row_t get_row(const PartitionedType<DynMat<T>>& matrix, uint_t row_idx);
+
+    ///
+    /// \brief get_row_view Returns a view of the row with index row_idx
+    ///
+    static row_view_t get_row_view(const PartitionedType<DynMat<T>>& matrix, uint_t row_idx)
+    {return matrix_row_trait<DynMat<T>>::get_row_view(matrix, row_idx);}
 };
 
 
@@ -4,9 +4,12 @@
 
 #include <Epetra_RowMatrixTransposer.h>
 
+#include "kernel/base/kernel_consts.h"
+
 #include <exception>
 #include <algorithm>
 #include <iostream>
+#include <string>
 
 namespace kernel{
 namespace numerics{
@@ -15,14 +18,24 @@ TrilinosEpetraMatrix::TrilinosEpetraMatrix()
                            :
                            mat_(),
                            comm_(),
-                           epetra_map_()
+                           epetra_map_(),
+                           graph_(),
+                           row_offsets_(nullptr),
+                           local_columns_(nullptr),
+                           values_(nullptr),
+                           diagonal_slots_()
 {}
 
 TrilinosEpetraMatrix::TrilinosEpetraMatrix(uint m, uint nnz)
     :
       mat_(),
       comm_(),
-      epetra_map_()
+      epetra_map_(),
+      graph_(),
+      row_offsets_(nullptr),
+      local_columns_(nullptr),
+      values_(nullptr),
+      diagonal_slots_()
 {
   init(m, m, nnz);
   zero();
@@ -160,6 +173,12 @@ TrilinosEpetraMatrix::set_entry(uint_t i,uint_t j, real_t val){
         throw std::logic_error("Matrix has not been initialized");
     }
 
+    // the pattern is fixed so write in place
+    if(values_){
+        values_[entry_slot_(i, j)] = val;
+        return;
+    }
+
     trilinos_int_t epetra_i = static_cast<trilinos_int_t>(i);
     trilinos_int_t epetra_j = static_cast<trilinos_int_t>(j);
     real_t epetra_value = val;
@@ -295,6 +314,12 @@ TrilinosEpetraMatrix::add_entry(uint_t i, uint_t j, real_t val){
         throw std::logic_error("Matrix has not been initialized");
     }
 
+    // the pattern is fixed so add in place
+    if(values_){
+        values_[entry_slot_(i, j)] += val;
+        return;
+    }
+
     trilinos_int_t epetra_i = static_cast<trilinos_int_t>(i);
     trilinos_int_t epetra_j = static_cast<trilinos_int_t>(j);
 
@@ -434,6 +459,8 @@ TrilinosEpetraMatrix::add_row_entries(TrilinosEpetraMatrix::row_indices_t& indic
 
 void TrilinosEpetraMatrix::init(uint_t m , uint_t n, uint_t nz){
 
+    reset_fixed_pattern_();
+
     // Epetra_Map constructor for a user-defined linear distribution of elements.
     // Creates a map that puts NumMyElements on the calling processor. If
     // NumGlobalElements=-1, the number of global elements will be
@@ -457,11 +484,132 @@ void
 TrilinosEpetraMatrix::init(const Epetra_CrsGraph& graph)
 {
 
+  reset_fixed_pattern_();
+
   //create the matrix by passing in the Epetra_CrsGraph
   mat_.reset(new Epetra_CrsMatrix(Copy, graph));
 
 }
 
+void
+TrilinosEpetraMatrix::init(uint_t m, uint_t n, const std::vector<std::vector<uint_t>>& pattern){
+
+    if(m != n){
+        throw std::logic_error("A fixed sparsity pattern requires a square matrix");
+    }
+
+    if(pattern.size() != m){
+        throw std::logic_error("The sparsity pattern should have one entry per row");
+    }
+
+    reset_fixed_pattern_();
+
+    auto n_rows = static_cast<trilinos_int_t>(m);
+    epetra_map_.reset(new Epetra_Map(n_rows, n_rows, 0, comm_));
+
+    std::vector<int> n_entries(m);
+    for(uint_t r=0; r<m; ++r){
+        n_entries[r] = static_cast<int>(pattern[r].size());
+    }
+
+    // the symbolic phase. The graph is built once
+    // and the matrix values are stored in its CSR arrays
+    graph_.reset(new Epetra_CrsGraph(Copy, *epetra_map_, n_entries.data(), true));
+
+    std::vector<trilinos_int_t> columns;
+    for(uint_t r=0; r<m; ++r){
+
+        columns.assign(pattern[r].begin(), pattern[r].end());
+
+        const int success = graph_->InsertGlobalIndices(static_cast<trilinos_int_t>(r), n_entries[r], columns.data());
+
+        if(success < 0){
+            throw std::logic_error("An error occured whilst inserting the sparsity pattern. Error code is: " + std::to_string(success));
+        }
+    }
+
+    graph_->FillComplete();
+
+    mat_.reset(new Epetra_CrsMatrix(Copy, *graph_));
+    mat_->FillComplete();
+
+    const int success = mat_->ExtractCrsDataPointers(row_offsets_, local_columns_, values_);
+
+    if(success != 0 || !values_){
+        reset_fixed_pattern_();
+        throw std::logic_error("The storage of the matrix is not optimized. Error code is: " + std::to_string(success));
+    }
+
+    diagonal_slots_.resize(m);
+    for(uint_t r=0; r<m; ++r){
+
+        // an empty row has no diagonal slot
+        diagonal_slots_[r] = pattern[r].empty() ? KernelConsts::invalid_size_type() : slot(r, r);
+    }
+}
+
+uint_t
+TrilinosEpetraMatrix::slot(uint_t i, uint_t j)const{
+
+    if(!values_){
+        throw std::logic_error("The matrix does not have a fixed sparsity pattern");
+    }
+
+    const int row = mat_->LRID(static_cast<trilinos_int_t>(i));
+    const int col = mat_->LCID(static_cast<trilinos_int_t>(j));
+
+    if(row >= 0 && col >= 0){
+
+        // the FV rows have a few entries so a linear search is enough
+        for(int p=row_offsets_[row]; p<row_offsets_[row + 1]; ++p){
+            if(local_columns_[p] == col){
+                return static_cast<uint_t>(p);
+            }
+        }
+    }
+
+    throw std::logic_error("Entry (" + std::to_string(i) + ", " + std::to_string(j) +
+                           ") is not in the sparsity pattern");
+}
+
+uint_t
+TrilinosEpetraMatrix::entry_slot_(uint_t i, uint_t j)const{
+
+    // an empty row holds the invalid slot. slot()
+    // then reports that (i, i) is not in the pattern
+    if(i == j && i < diagonal_slots_.size() &&
+       diagonal_slots_[i] != KernelConsts::invalid_size_type()){
+        return diagonal_slots_[i];
+    }
+
+    return slot(i, j);
+}
+
+void
+TrilinosEpetraMatrix::fill_completed(){
+
+    if(!mat_){
+        throw std::logic_error("Matrix pointer has not been initialized");
+    }
+
+    // a matrix with fixed pattern is fill-completed
+    // once when the pattern is set
+    if(has_fixed_pattern()){
+        return;
+    }
+
+    mat_->FillComplete();
+}
+
+void
+TrilinosEpetraMatrix::reset_fixed_pattern_(){
+
+    row_offsets_ = nullptr;
+    local_columns_ = nullptr;
+    values_ = nullptr;
+    diagonal_slots_.clear();
+}
+
 void
 TrilinosEpetraMatrix::zero(){
 
@@ -121,6 +121,37 @@ public:
     ///
     void init(const Epetra_CrsGraph& graph);
 
+    ///
+    /// \brief Initialize a matrix with m global rows and n global columns
+    /// with the fixed sparsity pattern. pattern[r] holds the columns of row r.
+    /// The matrix is fill-completed so set_entry() and add_entry() write the
+    /// values in place and throw for entries outside the pattern
+    ///
+    void init(uint_t m, uint_t n, const std::vector<std::vector<uint_t>>& pattern);
+
+    ///
+    /// \brief Returns true if the matrix was initialized
+    /// with a fixed sparsity pattern
+    ///
+    bool has_fixed_pattern()const{return values_ != nullptr;}
+
+    ///
+    /// \brief The position of the (i,j) entry in the values of
+    /// a matrix with fixed pattern. Throws std::logic_error if the
+    /// entry is not in the pattern
+    ///
+    uint_t slot(uint_t i, uint_t j)const;
+
+    ///
+    /// \brief Add val to the value at the given slot
+    ///
+    void add_to_slot(uint_t s, real_t val){values_[s] += val;}
+
+    ///
+    /// \brief Set the value at the given slot to val
+    ///
+    void set_slot(uint_t s, real_t val){values_[s] = val;}
+
     ///
     /// \brief Zero the entries of the matrix
     ///
@@ -161,7 +192,7 @@ public:
     /// \brief Signal the underlying Epetra_FECrsMatrix that filling
     ///of the matrix is completed
     ///
-    void fill_completed(){mat_->FillComplete();}
+    void fill_completed();
 
 
 private:
@@ -183,6 +214,37 @@ private:
    ///
    std::unique_ptr<Epetra_Map> epetra_map_;
 
+   ///
+   /// \brief The graph of a matrix with fixed pattern
+   ///
+   std::unique_ptr<Epetra_CrsGraph> graph_;
+
+   ///
+   /// \brief The CSR arrays of a matrix with fixed pattern. Epetra
+   /// uses int for local indices. values_ is nullptr if the pattern is not fixed
+   ///
+   int* row_offsets_;
+   int* local_columns_;
+   real_t* values_;
+
+   ///
+   /// \brief The precomputed slots of the diagonal entries.
+   /// The FV assembly updates the diagonal most often
+   ///
+   std::vector<uint_t> diagonal_slots_;
+
+   ///
+   /// \brief Reset the fixed pattern data
+   ///
+   void reset_fixed_pattern_();
+
+   ///
+   /// \brief The slot of the (i,j) entry. Uses the precomputed
+   /// diagonal slot when the row has one. Throws std::logic_error
+   /// if the entry is not in the pattern
+   ///
+   uint_t entry_slot_(uint_t i, uint_t j)const;
+
 };
 
 }
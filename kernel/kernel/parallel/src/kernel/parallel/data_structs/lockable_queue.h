@@ -2,16 +2,27 @@
 #define LOCKABLE_QUEUE_H
 
 #include "kernel/base/types.h"
+#include "kernel/parallel/data_structs/mpmc_ring_buffer.h"
 #include <boost/core/noncopyable.hpp>
 
 #include <iostream>
 #include <queue>
 #include <mutex>
 #include <condition_variable>
+#include <thread>
 
 namespace kernel
 {
 
+/***
+ * A thread safe queue of values. The type of the value held is specified
+ * by the first template argument. The second template argument selects the
+ * implementation. MutexQueueImpl selects an unbounded queue protected by a mutex
+ * and LockFreeQueueImpl selects a bounded lock-free ring buffer
+ **/
+template<typename T, typename ImplTp=MutexQueueImpl>
+class LockableQueue;
+
 /***
  * A simple implementation of a thread safe queue.
  * The implementation uses simple lock mechanism.
@@ -21,7 +32,7 @@ namespace kernel
  **/
 
 template<typename T>
-class LockableQueue: private boost::noncopyable
+class LockableQueue<T, MutexQueueImpl>: private boost::noncopyable
 {
 
  public:
@@ -238,5 +249,116 @@ LockableQueue<T>::push_items(Iterator begin,Iterator end){
     cond_.notify_one();
 }
 
+/***
+ * Lock-free implementation of the thread safe queue. The queue is bounded
+ * and does not allocate after construction. Pushing to a full queue yields
+ * the calling thread until space becomes available. Similarly the pop_wait
+ * functions yield the calling thread until an element becomes available
+ **/
+
+template<typename T>
+class LockableQueue<T, LockFreeQueueImpl>: private boost::noncopyable
+{
+
+ public:
+
+    typedef T value_t;
+
+    /// \brief Constructor. Construct an empty queue that
+    /// can hold at least capacity items
+    explicit LockableQueue(uint_t capacity=1024);
+
+    /// \brief Destructor
+    ~LockableQueue()
+    {}
+
+    //pop an element from the queue. The thread
+    //that calls this waits until the queue has
+    //at least one element
+    value_t pop_wait();
+
+    //pop an element from the queue. Same as above
+    bool pop_wait(value_t& element);
+
+    //pop an element from the queue. If the queue is empty
+    //then return false. This function does not cause the
+    //calling thread to wait
+    bool pop(value_t& element){return queue_.try_pop(element);}
+
+    //push an element to the queue
+    void push_item(const value_t& element);
+
+    //push an element to the queue. If the queue is full
+    //then return false. This function does not cause the
+    //calling thread to wait
+    bool try_push_item(const value_t& element){return queue_.try_push(element);}
+
+    template<typename Iterator>
+    void push_items(Iterator begin,Iterator end);
+
+    //get the size of the queue
+    uint_t size()const{return queue_.size();}
+
+    //is the queue empty
+    bool empty()const{return queue_.empty();}
+
+    //the maximum number of items the queue can hold
+    uint_t capacity()const{return queue_.capacity();}
+
+ private:
+
+     MPMCRingBuffer<value_t> queue_;
+
+};
+
+template<typename T>
+LockableQueue<T, LockFreeQueueImpl>::LockableQueue(uint_t capacity)
+:
+queue_(capacity)
+{}
+
+template<typename T>
+inline
+T
+LockableQueue<T, LockFreeQueueImpl>::pop_wait(){
+
+    value_t element;
+    pop_wait(element);
+    return element;
+}
+
+template<typename T>
+inline
+bool
+LockableQueue<T, LockFreeQueueImpl>::pop_wait(value_t& ele){
+
+    while(!queue_.try_pop(ele)){
+        std::this_thread::yield();
+    }
+
+    return true;
+}
+
+template<typename T>
+inline
+void
+LockableQueue<T, LockFreeQueueImpl>::push_item(const T& element){
+
+    while(!queue_.try_push(element)){
+        std::this_thread::yield();
+    }
+}
+
+template<typename T>
+template<typename Iterator>
+void
+LockableQueue<T, LockFreeQueueImpl>::push_items(Iterator begin,Iterator end){
+
+    while(begin != end){
+        push_item(*begin);
+        begin++;
+    }
+}
+
 }//kernelpp
 #endif
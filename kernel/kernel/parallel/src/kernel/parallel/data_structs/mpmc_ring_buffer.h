@@ -0,0 +1,202 @@
+#ifndef MPMC_RING_BUFFER_H
+#define MPMC_RING_BUFFER_H
+
+#include "kernel/base/types.h"
+#include <boost/core/noncopyable.hpp>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+
+namespace kernel
+{
+
+/// \brief Tag to select the mutex based implementation of
+/// TaskQueue and LockableQueue. This is the default
+struct MutexQueueImpl{};
+
+/// \brief Tag to select the lock-free bounded implementation of
+/// TaskQueue and LockableQueue. See MPMCRingBuffer
+struct LockFreeQueueImpl{};
+
+/***
+ * A bounded lock-free multi-producer multi-consumer queue.
+ * Every slot of the ring carries a sequence number that tells producers
+ * and consumers whether the slot is ready to be written or read. Producers and
+ * consumers claim slots with a compare-and-swap on the enqueue and dequeue positions
+ * respectively so no locks and no allocations take place after construction.
+ * The capacity is rounded up to the next power of two.
+ * See: D. Vyukov, Bounded MPMC queue, http://www.1024cores.net
+ **/
+
+template<typename T>
+class MPMCRingBuffer: private boost::noncopyable
+{
+
+public:
+
+    typedef T value_type;
+
+    /// \brief Constructor. Construct an empty queue able
+    /// to hold at least capacity elements
+    explicit MPMCRingBuffer(uint_t capacity);
+
+    /// \brief Attempt to push an element. Returns false if the queue is full
+    bool try_push(const value_type& element);
+
+    /// \brief Attempt to pop an element. Returns false if the queue is empty
+    bool try_pop(value_type& element);
+
+    /// \brief The maximum number of elements the queue can hold
+    uint_t capacity()const{return mask_ + 1;}
+
+    /// \brief Get the size of the queue. This is only a
+    /// snapshot as other threads may modify the queue
+    uint_t size()const;
+
+    /// \brief Is the queue empty. This is only a snapshot
+    bool empty()const{return size() == 0;}
+
+private:
+
+    /// \brief Assumed size of the cache line. Used to keep
+    /// the positions below in different cache lines
+    static constexpr uint_t CACHE_LINE_SIZE = 64;
+
+    struct alignas(CACHE_LINE_SIZE) Cell
+    {
+        std::atomic<uint_t> sequence;
+        value_type data;
+    };
+
+    /// \brief Returns the smallest power of two that is not less than n
+    static uint_t next_power_of_two_(uint_t n);
+
+    std::unique_ptr<Cell[]> buffer_;
+    const uint_t mask_;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint_t> enqueue_pos_;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint_t> dequeue_pos_;
+};
+
+template<typename T>
+uint_t
+MPMCRingBuffer<T>::next_power_of_two_(uint_t n){
+
+    uint_t power = 2;
+    while(power < n){
+        power <<= 1;
+    }
+
+    return power;
+}
+
+template<typename T>
+MPMCRingBuffer<T>::MPMCRingBuffer(uint_t capacity)
+    :
+buffer_(),
+mask_(next_power_of_two_(capacity) - 1),
+enqueue_pos_(0),
+dequeue_pos_(0)
+{
+    if(capacity == 0){
+        throw std::invalid_argument("Cannot create a queue with zero capacity");
+    }
+
+    buffer_.reset(new Cell[mask_ + 1]);
+
+    for(uint_t i=0; i <= mask_; ++i){
+        buffer_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template<typename T>
+bool
+MPMCRingBuffer<T>::try_push(const T& element){
+
+    Cell* cell = nullptr;
+    uint_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+
+    while(true){
+
+        cell = &buffer_[pos & mask_];
+        const uint_t seq = cell->sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+
+        if(diff == 0){
+
+            // the slot is free try to claim it
+            if(enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+                break;
+            }
+        }
+        else if(diff < 0){
+
+            // the slot has not been consumed yet
+            // so the queue is full
+            return false;
+        }
+        else{
+
+            // another producer claimed the slot
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->data = element;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+bool
+MPMCRingBuffer<T>::try_pop(T& element){
+
+    Cell* cell = nullptr;
+    uint_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+
+    while(true){
+
+        cell = &buffer_[pos & mask_];
+        const uint_t seq = cell->sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+
+        if(diff == 0){
+
+            // the slot is filled try to claim it
+            if(dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+                break;
+            }
+        }
+        else if(diff < 0){
+
+            // the slot has not been written yet
+            // so the queue is empty
+            return false;
+        }
+        else{
+
+            // another consumer claimed the slot
+            pos = dequeue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    element = cell->data;
+
+    // mark the slot free for the producer
+    // that wraps around the ring
+    cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+uint_t
+MPMCRingBuffer<T>::size()const{
+
+    const uint_t enqueued = enqueue_pos_.load(std::memory_order_relaxed);
+    const uint_t dequeued = dequeue_pos_.load(std::memory_order_relaxed);
+    return enqueued > dequeued ? enqueued - dequeued : 0;
+}
+
+}//kernel
+#endif // MPMC_RING_BUFFER_H
@@ -2,16 +2,27 @@
 #define TASK_QUEUE_H
 
 #include "kernel/base/types.h"
+#include "kernel/parallel/data_structs/mpmc_ring_buffer.h"
 #include <boost/core/noncopyable.hpp>
 
 #include <iostream>
 #include <queue>
 #include <mutex>
 #include <condition_variable>
+#include <thread>
 
 namespace kernel
 {
 
+/***
+ * A thread safe queue of tasks. The type of the task held is specified
+ * by the first template argument. The second template argument selects the
+ * implementation. MutexQueueImpl selects an unbounded queue protected by a mutex
+ * and LockFreeQueueImpl selects a bounded lock-free ring buffer
+ **/
+template<typename T, typename ImplTp=MutexQueueImpl>
+class TaskQueue;
+
 /***
  * A simple implementation of a thread safe queue.
  * The implementation uses simple lock mechanism.
@@ -21,7 +32,7 @@ namespace kernel
  **/
 
 template<typename T>
-class TaskQueue: private boost::noncopyable
+class TaskQueue<T, MutexQueueImpl>: private boost::noncopyable
 {
 
  public:
@@ -285,5 +296,165 @@ TaskQueue<T>::push_tasks(Iterator begin,Iterator end){
     cond_.notify_one();
 }
 
+/***
+ * Lock-free implementation of the thread safe queue. The queue is bounded
+ * and does not allocate after construction. Pushing to a full queue yields
+ * the calling thread until space becomes available. Similarly the pop_wait
+ * functions yield the calling thread until an element becomes available
+ **/
+
+template<typename T>
+class TaskQueue<T, LockFreeQueueImpl>: private boost::noncopyable
+{
+
+ public:
+
+    typedef T value_type;
+
+    /// \brief Constructor. Construct an empty queue that
+    /// can hold at least capacity tasks
+    explicit TaskQueue(uint_t capacity=1024);
+
+    /// \brief Destructor
+    ~TaskQueue()
+    {}
+
+    //pop an element from the queue. The thread
+    //that calls this waits until the queue has
+    //at least one element
+    value_type* pop_wait();
+
+    //pop an element from the queue. Same as above
+    bool pop_wait(value_type*& element);
+
+    //pop an element from the queue. If the queue is empty
+    //then return nullptr. This function does not cause the
+    //calling thread to wait
+    value_type* pop();
+
+    //pop an element from the queue. If the queue is empty
+    //then return false. This function does not cause the
+    //calling thread to wait
+    bool pop(value_type*& element);
+
+    //push an element to the queue
+    void push_task(value_type& element);
+
+    //push an element to the queue
+    void push_task(value_type* element);
+
+    //push an element to the queue. If the queue is full
+    //then return false. This function does not cause the
+    //calling thread to wait
+    bool try_push_task(value_type* element){return queue_.try_push(element);}
+
+    //push the given list of tasks into the queue
+    template<typename C>
+    void push_tasks(const C& tasks);
+
+    //push the tasks in [begin, end) into the queue.
+    //std::iterator_traits<Iterator>::value_type
+    //should resolve to T*
+    template<typename Iterator>
+    void push_tasks(Iterator begin,Iterator end);
+
+    //get the size of the queue
+    uint_t size()const{return queue_.size();}
+
+    //is the queue empty
+    bool empty()const{return queue_.empty();}
+
+    //the maximum number of tasks the queue can hold
+    uint_t capacity()const{return queue_.capacity();}
+
+ private:
+
+     MPMCRingBuffer<value_type*> queue_;
+
+};
+
+template<typename T>
+TaskQueue<T, LockFreeQueueImpl>::TaskQueue(uint_t capacity)
+:
+queue_(capacity)
+{}
+
+template<typename T>
+inline
+T*
+TaskQueue<T, LockFreeQueueImpl>::pop_wait(){
+
+    value_type* element = nullptr;
+    while(!queue_.try_pop(element)){
+        std::this_thread::yield();
+    }
+
+    return element;
+}
+
+template<typename T>
+inline
+bool
+TaskQueue<T, LockFreeQueueImpl>::pop_wait(T*& ele){
+
+    ele = pop_wait();
+    return true;
+}
+
+template<typename T>
+inline
+T*
+TaskQueue<T, LockFreeQueueImpl>::pop(){
+
+    value_type* element = nullptr;
+    if(!queue_.try_pop(element)) return nullptr;
+    return element;
+}
+
+template<typename T>
+inline
+bool
+TaskQueue<T, LockFreeQueueImpl>::pop(T*& ele){
+    return queue_.try_pop(ele);
+}
+
+template<typename T>
+inline
+void
+TaskQueue<T, LockFreeQueueImpl>::push_task(T& element){
+    push_task(&element);
+}
+
+template<typename T>
+inline
+void
+TaskQueue<T, LockFreeQueueImpl>::push_task(T* element){
+
+    while(!queue_.try_push(element)){
+        std::this_thread::yield();
+    }
+}
+
+template<typename T>
+template<typename C>
+void
+TaskQueue<T, LockFreeQueueImpl>::push_tasks(const C& tasks){
+
+    for(auto task : tasks){
+        push_task(task);
+    }
+}
+
+template<typename T>
+template<typename Iterator>
+void
+TaskQueue<T, LockFreeQueueImpl>::push_tasks(Iterator begin,Iterator end){
+
+    while(begin != end){
+        push_task(*begin);
+        begin++;
+    }
+}
+
 }//kernelpp
 #endif
@@ -0,0 +1,193 @@
+#ifndef WORK_STEALING_QUEUE_H
+#define WORK_STEALING_QUEUE_H
+
+#include "kernel/base/types.h"
+#include <boost/core/noncopyable.hpp>
+
+#include <vector>
+#include <mutex>
+
+namespace kernel
+{
+
+/***
+ * A thread safe double ended queue of tasks to be used for work stealing.
+ * push_task() appends tasks at the back of the queue. The owning thread
+ * pops tasks from the front so it executes its tasks in the order they were
+ * pushed (FIFO). Other threads steal from the back i.e. they take the most
+ * recently pushed task. Thus the owner and the thieves work at opposite
+ * ends of the queue. The type of the task held
+ * is specified by the template argument. The tasks are held in a circular buffer
+ * that only grows when it is full so that, once the buffer has reached the
+ * number of tasks in flight, pushing and popping does not allocate memory
+ **/
+
+template<typename T>
+class WorkStealingQueue: private boost::noncopyable
+{
+
+public:
+
+    typedef T value_type;
+
+    /// \brief Constructor. Construct an empty queue with
+    /// room for capacity tasks. The capacity is rounded up
+    /// to the next power of two
+    explicit WorkStealingQueue(uint_t capacity=64);
+
+    /// \brief Destructor
+    ~WorkStealingQueue()
+    {}
+
+    /// \brief Pop an element from the front of the queue. If the queue is empty
+    /// then return false. This function does not cause the calling thread to wait.
+    /// It should be called by the thread that owns the queue
+    bool pop(value_type*& element);
+
+    /// \brief Pop an element from the back of the queue. If the queue is empty
+    /// then return false. This function does not cause the calling thread to wait.
+    /// It should be called by threads that do not own the queue
+    bool steal(value_type*& element);
+
+    /// \brief Push an element to the back of the queue
+    void push_task(value_type& element);
+
+    /// \brief Push an element to the back of the queue
+    void push_task(value_type* element);
+
+    /// \brief Get the size of the queue
+    uint_t size()const;
+
+    /// \brief Is the queue empty
+    bool empty()const;
+
+    /// \brief The number of tasks the queue can hold before it grows
+    uint_t capacity()const;
+
+private:
+
+    /// \brief Double the size of the buffer. The lock must be held
+    void grow_();
+
+    std::vector<value_type*> buffer_;
+
+    /// \brief The position of the front of the queue in the buffer
+    uint_t head_;
+
+    /// \brief The number of tasks in the queue
+    uint_t size_;
+
+    mutable std::mutex mutex_;
+};
+
+template<typename T>
+WorkStealingQueue<T>::WorkStealingQueue(uint_t capacity)
+:
+buffer_(),
+head_(0),
+size_(0)
+{
+    uint_t n = 2;
+    while(n < capacity){
+        n <<= 1;
+    }
+
+    buffer_.resize(n, nullptr);
+}
+
+template<typename T>
+inline
+uint_t
+WorkStealingQueue<T>::capacity()const{
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    return static_cast<uint_t>(buffer_.size());
+}
+
+template<typename T>
+void
+WorkStealingQueue<T>::grow_(){
+
+    // unroll the queue at the beginning of the new buffer
+    std::vector<value_type*> buffer(2*buffer_.size(), nullptr);
+    const uint_t mask = buffer_.size() - 1;
+
+    for(uint_t i=0; i<size_; ++i){
+        buffer[i] = buffer_[(head_ + i) & mask];
+    }
+
+    buffer_.swap(buffer);
+    head_ = 0;
+}
+
+template<typename T>
+inline
+uint_t
+WorkStealingQueue<T>::size()const{
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    return size_;
+}
+
+template<typename T>
+inline
+bool
+WorkStealingQueue<T>::empty()const{
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    return size_ == 0;
+}
+
+template<typename T>
+inline
+bool
+WorkStealingQueue<T>::pop(T*& ele){
+
+    std::lock_guard<std::mutex> lk(mutex_);
+
+    if(size_ == 0) return false;
+
+    ele = buffer_[head_];
+    head_ = (head_ + 1) & (buffer_.size() - 1);
+    --size_;
+    return true;
+}
+
+template<typename T>
+inline
+bool
+WorkStealingQueue<T>::steal(T*& ele){
+
+    std::lock_guard<std::mutex> lk(mutex_);
+
+    if(size_ == 0) return false;
+
+    --size_;
+    ele = buffer_[(head_ + size_) & (buffer_.size() - 1)];
+    return true;
+}
+
+template<typename T>
+inline
+void
+WorkStealingQueue<T>::push_task(T& element){
+    push_task(&element);
+}
+
+template<typename T>
+inline
+void
+WorkStealingQueue<T>::push_task(T* element){
+
+    std::lock_guard<std::mutex> lk(mutex_);
+
+    if(size_ == buffer_.size()){
+        grow_();
+    }
+
+    buffer_[(head_ + size_) & (buffer_.size() - 1)] = element;
+    ++size_;
+}
+
+}//kernel
+#endif // WORK_STEALING_QUEUE_H
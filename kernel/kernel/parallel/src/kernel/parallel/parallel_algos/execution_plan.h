@@ -0,0 +1,128 @@
+#ifndef EXECUTION_PLAN_H
+#define EXECUTION_PLAN_H
+
+#include "kernel/base/types.h"
+#include "kernel/parallel/threading/task_base.h"
+#include "kernel/parallel/threading/task_uitilities.h"
+#include "kernel/parallel/utilities/result_holder.h"
+
+#include <boost/noncopyable.hpp>
+
+#include <vector>
+#include <memory>
+#include <stdexcept>
+
+namespace kernel
+{
+
+/**
+ * A set of tasks that is created once and executed many times
+ * with the same executor. The tasks are created when the plan is constructed,
+ * one for every processing element of the executor, by calling factory(t).
+ * execute() simply reschedules the existing tasks and hands them to the executor
+ * so no memory is allocated after construction. This is useful for iterative
+ * algorithms that apply the same parallel operation in every iteration.
+ */
+template<typename TaskTp, typename ExecutorTp>
+class ExecutionPlan: private boost::noncopyable
+{
+
+public:
+
+    typedef TaskTp task_type;
+    typedef ExecutorTp executor_type;
+
+    /// \brief Constructor. The factory is called as factory(t) for every
+    /// processing element t of the executor and should return a
+    /// std::unique_ptr<task_type>
+    template<typename FactoryTp>
+    ExecutionPlan(executor_type& executor, const FactoryTp& factory);
+
+    /// \brief Execute the tasks of the plan. This blocks until all
+    /// the tasks have finished. The returned result is valid if
+    /// all the tasks finished without errors
+    template<typename Options>
+    const ResultHolder<void>& execute(const Options& options);
+
+    /// \brief Returns the number of tasks in the plan
+    uint_t n_tasks()const{return tasks_.size();}
+
+    /// \brief Returns how many times the plan has been executed
+    uint_t n_executions()const{return n_executions_;}
+
+    /// \brief Access the t-th task
+    task_type& get_task(uint_t t){return *tasks_[t];}
+
+    /// \brief Access the t-th task
+    const task_type& get_task(uint_t t)const{return *tasks_[t];}
+
+    /// \brief Returns true if the tasks have finished
+    bool tasks_finished()const{return taskutils::tasks_finished(tasks_);}
+
+private:
+
+    /// \brief The executor the plan is executed with
+    executor_type* executor_;
+
+    /// \brief The tasks of the plan
+    std::vector<std::unique_ptr<task_type>> tasks_;
+
+    /// \brief The result of the last execution
+    ResultHolder<void> result_;
+
+    /// \brief Number of times the plan has been executed
+    uint_t n_executions_;
+};
+
+template<typename TaskTp, typename ExecutorTp>
+template<typename FactoryTp>
+ExecutionPlan<TaskTp, ExecutorTp>::ExecutionPlan(executor_type& executor, const FactoryTp& factory)
+    :
+    executor_(&executor),
+    tasks_(),
+    result_(),
+    n_executions_(0)
+{
+    const uint_t n_tasks = executor.n_processing_elements();
+    tasks_.reserve(n_tasks);
+
+    for(uint_t t=0; t<n_tasks; ++t){
+
+        tasks_.push_back(factory(t));
+
+        if(!tasks_.back()){
+            throw std::invalid_argument("Null Task Pointer in ExecutionPlan");
+        }
+    }
+}
+
+template<typename TaskTp, typename ExecutorTp>
+template<typename Options>
+const ResultHolder<void>&
+ExecutionPlan<TaskTp, ExecutorTp>::execute(const Options& options){
+
+    for(auto& task: tasks_){
+        task->reschedule();
+    }
+
+    // this blocks until the tasks are finished
+    executor_->execute(tasks_, options);
+    ++n_executions_;
+
+    result_.validate_result();
+
+    for(uint_t t=0; t < tasks_.size(); ++t){
+
+        // if we reached here but for some reason the
+        // task has not finished properly invalidate the result
+       if(tasks_[t]->get_state() != TaskBase::TaskState::FINISHED){
+           result_.invalidate_result();
+       }
+    }
+
+    return result_;
+}
+
+}
+
+#endif // EXECUTION_PLAN_H
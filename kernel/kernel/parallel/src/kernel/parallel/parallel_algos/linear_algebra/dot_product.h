@@ -283,6 +283,10 @@ DotProduct<VectorTp, ResultTp>::clear_tasks_memory_(){
     for(auto& task: tasks_){
         task.reset(nullptr);
     }
+
+    // remove the null entries so that execute()
+    // can be called more than once
+    tasks_.clear();
 }
 
 template<typename VectorTp, typename ResultTp>
@@ -305,12 +309,17 @@ DotProduct<VectorTp, ResultTp>::dot_product::run(){
     auto begin = parts.begin();
     auto end   = parts.end();
 
-    ResultTp& result = this->result_.get_resource();
+    // accumulate locally and write the result once. This
+    // avoids writing to memory shared with other tasks in the loop
+    // and discards the result of any previous execution
+    ResultTp result = ResultTp();
 
     for(uint_t r  = begin; r < end; ++r){
         result += (*v1_ptr)[r]*(*v2_ptr)[r];
     }
 
+    this->result_.get_resource() = result;
+
     // this is a valid result
     this->result_.validate_result();
 }
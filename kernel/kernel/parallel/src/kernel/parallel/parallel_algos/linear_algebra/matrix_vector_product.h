@@ -5,6 +5,7 @@
 #include "kernel/parallel/threading/simple_task.h"
 #include "kernel/parallel/threading/task_uitilities.h"
 #include "kernel/parallel/utilities/result_holder.h"
+#include "kernel/parallel/utilities/matrix_row_partitioner.h"
 #include "kernel/utilities/range_1d.h"
 
 #include <boost/noncopyable.hpp>
@@ -12,8 +13,55 @@
 namespace kernel
 {
 
+/// \brief Compute the rows [begin, end) of y = A*x. For sparse matrices
+/// only the stored entries of every row are visited. For dense matrices the
+/// row storage is contiguous and the inner loop is vectorized. This is the
+/// kernel every MatVecProduct task runs on its row range and it can be
+/// called directly by algorithms that schedule the rows themselves
+template<typename MatTp, typename VecTp>
+void
+mat_vec_product_rows(const MatTp& mat, const VecTp& x, VecTp& y, uint_t begin, uint_t end){
+
+    typedef typename VecTp::ElementType value_type;
+
+    const auto* x_data = x.data();
+
+    for(uint_t r = begin; r < end; ++r){
+
+        value_type sum = value_type(0);
+
+        if constexpr(blaze::IsSparseMatrix_v<MatTp>){
+
+            for(auto it = mat.cbegin(r); it != mat.cend(r); ++it){
+                sum += it->value()*x_data[it->index()];
+            }
+        }
+        else{
+
+            // the rows of a row major dense matrix
+            // are stored contiguously
+            const auto* row = mat.data(r);
+            const uint_t n_cols = mat.columns();
+
+#pragma omp simd reduction(+:sum)
+            for(uint_t c = 0; c < n_cols; ++c){
+                sum += row[c]*x_data[c];
+            }
+        }
+
+        y[r] = sum;
+    }
+}
+
 /**
- * \brief Matrix-vector product
+ * \brief Matrix-vector product y = A*x. The rows of A are partitioned
+ * with partition_matrix_rows() into one range per executor thread so that
+ * every task carries about the same work. For sparse matrices this is the
+ * number of nonzeros of the rows rather than the row count; a few dense
+ * rows do not end up on the same thread. Every task computes the rows of
+ * y in its range. For sparse matrices the task works on the compressed rows directly i.e.
+ * only the nonzero entries are touched. For dense matrices the task
+ * works on the contiguous row storage and the inner loop is vectorized
  */
 
 template<typename MatTp, typename VecTp>
@@ -26,6 +74,8 @@ public:
     typedef VecTp vector_type;
     typedef ResultHolder<vector_type> result_type;
 
+    static_assert (blaze::IsRowMajorMatrix_v<matrix_type>, "MatVecProduct requires a row major matrix");
+
     /// \brief Constructor
     MatVecProduct(const matrix_type& mat, const vector_type& x);
 
@@ -46,6 +96,9 @@ public:
     /// \brief Returns the result
     const result_type& get()const{return result_;}
 
+    /// \brief Returns the row ranges the tasks worked on in the last execution
+    const std::vector<range1d<uint_t>>& row_partitions()const{return partitions_;}
+
     /// \brief Get a copy of the held result
     void get_copy(result_type& copy)const;
 
@@ -69,6 +122,9 @@ private:
     /// \brief The spaned tasks
     std::vector<std::unique_ptr<mat_vec_product>> tasks_;
 
+    /// \brief The rows each task works on balanced by the row work
+    std::vector<range1d<uint_t>> partitions_;
+
     /// \brief Pointers to vectors that product is to be computed
     const matrix_type* M_;
     const vector_type* x_;
@@ -83,12 +139,13 @@ private:
 template<typename MatTp, typename VecTp>
 struct MatVecProduct<MatTp, VecTp>::mat_vec_product:  public kernel::SimpleTaskBase<Null>
 {
-   mat_vec_product(uint_t id, const MatTp& mat, const VecTp& x, VecTp& rslt)
+   mat_vec_product(uint_t id, const MatTp& mat, const VecTp& x, VecTp& rslt, range1d<uint_t> rows)
        :
    kernel::SimpleTaskBase<Null>(id),
    mat_ptr(&mat),
    x_ptr(&x),
-   rslt_ptr(&rslt)
+   rslt_ptr(&rslt),
+   rows_(rows)
    {}
 
 protected:
@@ -97,6 +154,9 @@ protected:
    const VecTp* x_ptr;
    VecTp* rslt_ptr;
 
+   // the rows of y this task computes
+   range1d<uint_t> rows_;
+
 
    // execute the matrix-vector product
    virtual void run()override final;
@@ -107,7 +167,7 @@ MatVecProduct<MatTp, VecTp>::MatVecProduct(const matrix_type& mat, const vector_
     :
    M_(&mat),
    x_(&x),
-   result_(std::move(VecTp(x.size(), 0.0)))
+   result_(std::move(VecTp(mat.rows(), 0.0)))
 {}
 
 template<typename MatTp, typename VecTp>
@@ -127,14 +187,18 @@ MatVecProduct<MatTp, VecTp>::execute(ExecutorTp& executor, const Options& option
     // clear any memory it may have been allocated
     clear_tasks_memory_();
 
+    // balance the rows among the threads by their work. For sparse
+    // matrices this accounts for the nonzeros of every row
+    partition_matrix_rows(*M_, partitions_, executor.get_n_threads());
+
     // create the dot product tasks
-    tasks_.reserve(executor.get_n_threads());
+    tasks_.reserve(partitions_.size());
 
     typedef MatVecProduct<MatTp, VecTp>::mat_vec_product task_type;
 
-    for(uint_t t=0; t<executor.get_n_threads(); ++t){
+    for(uint_t t=0; t<partitions_.size(); ++t){
 
-        tasks_.push_back(std::make_unique<task_type>(t, *M_, *x_, result_.get_resource()));
+        tasks_.push_back(std::make_unique<task_type>(t, *M_, *x_, result_.get_resource(), partitions_[t]));
         //executor.add_task(*(tasks_[t].get()));
     }
 
@@ -164,12 +228,12 @@ template<typename ExecutorTp, typename Options>
 void
 MatVecProduct<MatTp, VecTp>::reexecute(ExecutorTp& executor, const Options& options){
 
-    if(tasks_.empty()){
+    if(tasks_.empty() || tasks_.size() != executor.get_n_threads()){
         execute(executor, options);
     }
     else{
 
-        for(uint_t t=0; t<executor.get_n_threads(); ++t){
+        for(uint_t t=0; t<tasks_.size(); ++t){
 
             tasks_[t]->set_state(kernel::TaskBase::TaskState::PENDING);
             //executor.add_task(*(tasks_[t].get()));
@@ -237,25 +301,16 @@ MatVecProduct<MatTp, VecTp>::clear_tasks_memory_(){
     for(auto& task: tasks_){
         task.reset(nullptr);
     }
+
+    // remove the null entries so that execute()
+    // can be called more than once
+    tasks_.clear();
 }
 
 template<typename MatTp, typename VecTp>
 void
 MatVecProduct<MatTp, VecTp>::mat_vec_product::run(){
-
-    // get the rows partiton indeces corresponding to this task
-    const auto parts = mat_ptr->get_partition(this->get_id());
-
-    auto begin = parts.begin();
-    auto end   = parts.end();
-
-    for(uint_t r  = begin; r < end; ++r){
-        auto& rslt = rslt_ptr->operator[](r);
-
-        for(auto it = mat_ptr->begin(r); it != mat_ptr->end(r); ++it )  {
-           rslt += *it*x_ptr->operator[](r);
-        }
-    }
+    mat_vec_product_rows(*mat_ptr, *x_ptr, *rslt_ptr, rows_.begin(), rows_.end());
 }
 
 }
@@ -144,14 +144,10 @@ VectorUpdater<VectorTp, OpTp, FactorTp>::execute(ExecutorTp& executor){
     for(uint_t t=0; t<executor.get_n_threads(); ++t){
 
         tasks_.push_back(std::make_unique<task_type>(t, result_->get_resource(), *y_, *z_, *a_, *b_));
-        executor.add_task(*(tasks_[t].get()));
     }
 
-    // if the tasks have not finished yet
-    // then the calling thread waits here
-    while(!tasks_finished()){
-       std::this_thread::yield();
-    }
+    // this should block
+    executor.execute(tasks_, Null());
 
     //validate the result
     result_->validate_result();
@@ -179,14 +175,10 @@ VectorUpdater<VectorTp, OpTp, FactorTp>::reexecute(ExecutorTp& executor){
 
         for(uint_t t=0; t<executor.get_n_threads(); ++t){
             tasks_[t]->set_state(kernel::TaskBase::TaskState::PENDING);
-            executor.add_task(*(tasks_[t].get()));
         }
 
-        // if the tasks have not finished yet
-        // then the calling thread waits here
-        while(!tasks_finished()){
-           std::this_thread::yield();
-        }
+        // this should block
+        executor.execute(tasks_, Null());
 
         //validate the result
         result_->validate_result();
@@ -227,6 +219,10 @@ VectorUpdater<VectorTp, OpTp, FactorTp>::clear_tasks_memory_(){
     for(auto& task: tasks_){
         task.reset(nullptr);
     }
+
+    // remove the null entries so that execute()
+    // can be called more than once
+    tasks_.clear();
 }
 
 template<typename VectorTp, typename OpTp, typename FactorTp>
@@ -10,6 +10,7 @@
 #include "kernel/base/exceptions.h"
 #include "kernel/parallel/threading/iterate_task.h"
 #include "kernel/parallel/threading/task_uitilities.h"
+#include "kernel/parallel/parallel_algos/execution_plan.h"
 #include "kernel/parallel/utilities/result_holder.h"
 
 #include "boost/noncopyable.hpp"
@@ -199,6 +200,35 @@ parallel_for(Range& range, const Body& op, Executor& executor, const Options& op
     return result;
 }
 
+/// \brief The type of the execution plan returned by make_parallel_for_plan
+template<typename Range, typename Body, typename Executor>
+using ParallelForPlan = ExecutionPlan<IterateTask<typename Range::partition_type, Body, Range>, Executor>;
+
+/// \brief Create an execution plan that applies Body on the elements of Range.
+/// The tasks are created once using the partitions of the range. Calling execute()
+/// on the returned plan is equivalent to calling parallel_for() but does not
+/// allocate any tasks. The range and the body should outlive the plan
+template<typename Range, typename Body, typename Executor>
+ParallelForPlan<Range, Body, Executor>
+make_parallel_for_plan(Range& range, const Body& op, Executor& executor){
+
+    if(!range.has_partitions()){
+        throw InvalidPartitionedObject("The given range does not have partitions");
+    }
+
+    if(range.n_partitions() != executor.n_processing_elements()){
+        throw InvalidPartitionedObject("Invalid number of partitions: "+
+                                       std::to_string(range.n_partitions())+" should be: "+
+                                       std::to_string(executor.n_processing_elements()));
+    }
+
+    typedef typename ParallelForPlan<Range, Body, Executor>::task_type task_type;
+
+    return ParallelForPlan<Range, Body, Executor>(executor, [&range, &op](uint_t t){
+        return std::make_unique<task_type>(t, range.get_partition(t), op, range);
+    });
+}
+
 }
 
 #endif // PARALLEL_FOR_H
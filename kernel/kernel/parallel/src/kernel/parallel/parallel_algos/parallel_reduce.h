@@ -9,6 +9,7 @@
 #include "kernel/parallel/threading/simple_task.h"
 #include "kernel/parallel/threading/task_uitilities.h"
 #include "kernel/parallel/utilities/result_holder.h"
+#include "kernel/parallel/parallel_algos/execution_plan.h"
 
 
 #include <vector>
@@ -127,9 +128,100 @@ void reduce_array(const std::vector<range1d<IteratorTp>>& partitions, ReductionO
     reduce.execute(partitions, op, executor, Null());
 }
 
-template<typename RangeTp, typename ReduceOpTp, typename ExecutorTp>
-ResultHolder<typename ReduceOpTp::result_type>
-parallel_reduce(const RangeTp& range, const ReduceOpTp& reduction_op, ExecutorTp& executor){
+namespace detail
+{
+
+/// \brief Accumulator of a task. Every accumulator occupies its own
+/// cache line so that tasks writing their results do not false share
+template<typename ValueTp>
+struct alignas(64) padded_accumulator
+{
+    ValueTp value;
+};
+
+/// \brief Task that maps the indices of its partition to values and
+/// reduces them locally. The result is written once in the accumulator
+template<typename PartitionTp, typename MapTp, typename ReduceOpTp>
+class map_reduce_task: public TaskBase
+{
+
+public:
+
+    typedef typename ReduceOpTp::value_type value_type;
+
+    /// \brief Constructor
+    map_reduce_task(uint_t id, const PartitionTp& partition, const MapTp& map,
+                    padded_accumulator<value_type>& accumulator);
+
+protected:
+
+    /// \brief Override base class run method
+    virtual void run()override final;
+
+    /// \brief The indices the task works on
+    PartitionTp partition_;
+
+    /// \brief The map applied on every index
+    const MapTp& map_;
+
+    /// \brief Where the result of the task is written
+    padded_accumulator<value_type>* accumulator_;
+};
+
+template<typename PartitionTp, typename MapTp, typename ReduceOpTp>
+map_reduce_task<PartitionTp, MapTp, ReduceOpTp>::map_reduce_task(uint_t id, const PartitionTp& partition, const MapTp& map,
+                                                                 padded_accumulator<value_type>& accumulator)
+    :
+    TaskBase(id),
+    partition_(partition),
+    map_(map),
+    accumulator_(&accumulator)
+{}
+
+template<typename PartitionTp, typename MapTp, typename ReduceOpTp>
+void
+map_reduce_task<PartitionTp, MapTp, ReduceOpTp>::run(){
+
+    value_type result = ReduceOpTp::identity();
+
+    auto begin = partition_.begin();
+    auto end   = partition_.end();
+
+    for(; begin != end; ++begin){
+        ReduceOpTp::local_join(map_(begin), result);
+    }
+
+    accumulator_->value = result;
+}
+
+/// \brief Combine the accumulators pairwise in log2(n) levels. The result
+/// ends up in the first accumulator. The combination order does not depend on
+/// the timing of the tasks so the result is reproducible for a given number of tasks
+template<typename ReduceOpTp, typename ValueTp>
+void
+tree_combine(std::vector<padded_accumulator<ValueTp>>& accumulators){
+
+    const uint_t n = accumulators.size();
+
+    for(uint_t stride = 1; stride < n; stride *= 2){
+        for(uint_t i = 0; i + stride < n; i += 2*stride){
+            ReduceOpTp::local_join(accumulators[i + stride].value, accumulators[i].value);
+        }
+    }
+}
+
+}
+
+/// \brief Reduce the values map(i) for every index i in the partitions of
+/// the given range using the given reduction operation. The reduction
+/// operation should provide the static functions identity() and local_join(value, result)
+/// see reduction_operations.h. Every task reduces its partition in a
+/// local variable and the task results are combined as a tree. Use FusedReduction
+/// to perform several reductions in one pass over the data
+template<typename RangeTp, typename MapTp, typename ReduceOpTp, typename ExecutorTp, typename Options>
+ResultHolder<typename ReduceOpTp::value_type>
+parallel_reduce(const RangeTp& range, const MapTp& map, const ReduceOpTp& /*reduction_op*/,
+                ExecutorTp& executor, const Options& options){
 
     if(!range.has_partitions()){
         throw InvalidPartitionedObject("The given range does not have partitions");
@@ -140,6 +232,33 @@ parallel_reduce(const RangeTp& range, const ReduceOpTp& reduction_op, ExecutorTp
                                        std::to_string(range.n_partitions())+" should be: "+
                                        std::to_string(executor.n_processing_elements()));
     }
+
+    typedef typename ReduceOpTp::value_type value_type;
+    typedef detail::map_reduce_task<typename RangeTp::partition_type, MapTp, ReduceOpTp> task_type;
+
+    std::vector<detail::padded_accumulator<value_type>> accumulators(executor.n_processing_elements());
+
+    ExecutionPlan<task_type, ExecutorTp> plan(executor, [&range, &map, &accumulators](uint_t t){
+        return std::make_unique<task_type>(t, range.get_partition(t), map, accumulators[t]);
+    });
+
+    const auto& executed = plan.execute(options);
+
+    if(!executed.is_result_valid()){
+        return ResultHolder<value_type>(ReduceOpTp::identity(), false);
+    }
+
+    detail::tree_combine<ReduceOpTp>(accumulators);
+    return ResultHolder<value_type>(std::move(accumulators[0].value), true);
+}
+
+/// \brief Reduce the elements of the given range using the given reduction operation
+template<typename RangeTp, typename ReduceOpTp, typename ExecutorTp>
+ResultHolder<typename ReduceOpTp::value_type>
+parallel_reduce(const RangeTp& range, const ReduceOpTp& reduction_op, ExecutorTp& executor){
+
+    auto map = [&range](uint_t i){return range[i];};
+    return parallel_reduce(range, map, reduction_op, executor, typename ExecutorTp::default_options_t());
 }
 
 
@@ -0,0 +1,96 @@
+#ifndef COUNT_DOWN_LATCH_H
+#define COUNT_DOWN_LATCH_H
+
+#include "kernel/base/types.h"
+#include <boost/core/noncopyable.hpp>
+
+#include <mutex>
+#include <condition_variable>
+
+namespace kernel
+{
+
+/// \brief A single use synchronization point. Threads that call wait()
+/// block until count_down() has been called as many times as the count
+/// the latch has been initialized with. Similar to C++20 std::latch
+class CountDownLatch: private boost::noncopyable
+{
+
+public:
+
+    /// \brief Constructor. Initialize the latch with the given count
+    explicit CountDownLatch(uint_t count);
+
+    /// \brief Decrement the count by one. When the count reaches zero
+    /// all the waiting threads are released
+    void count_down();
+
+    /// \brief Block the calling thread until the count reaches zero
+    void wait()const;
+
+    /// \brief Returns true if the count has reached zero. Does not block
+    bool try_wait()const;
+
+    /// \brief Reset the count. Should not be called whilst
+    /// there are threads waiting on the latch
+    void reset(uint_t count);
+
+private:
+
+    /// \brief The current count
+    uint_t count_;
+
+    mutable std::mutex mutex_;
+    mutable std::condition_variable cond_;
+};
+
+inline
+CountDownLatch::CountDownLatch(uint_t count)
+    :
+    count_(count),
+    mutex_(),
+    cond_()
+{}
+
+inline
+void
+CountDownLatch::count_down(){
+
+    std::lock_guard<std::mutex> lk(mutex_);
+
+    if(count_ == 0){
+        return;
+    }
+
+    if(--count_ == 0){
+        cond_.notify_all();
+    }
+}
+
+inline
+void
+CountDownLatch::wait()const{
+
+    std::unique_lock<std::mutex> lk(mutex_);
+    cond_.wait(lk, [this]{ return count_ == 0;});
+}
+
+inline
+bool
+CountDownLatch::try_wait()const{
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    return count_ == 0;
+}
+
+inline
+void
+CountDownLatch::reset(uint_t count){
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    count_ = count;
+}
+
+}
+
+#endif // COUNT_DOWN_LATCH_H
@@ -1,5 +1,6 @@
 #include "kernel/parallel/threading/kernel_thread.h"
 #include "kernel/parallel/threading/task_base.h"
+#include "kernel/parallel/threading/count_down_latch.h"
 
 namespace kernel
 {
@@ -7,14 +8,18 @@ namespace kernel
 namespace detail
 {
 
-kernel_thread::kernel_thread(uint_t id)
+kernel_thread::kernel_thread(uint_t id, uint_t n_idle_spins)
     :
       working_(false),
       started_(false),
       stop_(false),
+      signalled_(false),
+      parked_(false),
+      n_idle_spins_(n_idle_spins),
       id_(id),
       t_(),
-      tasks_()
+      tasks_(),
+      victims_()
  {}
 
 void
@@ -22,15 +27,23 @@ kernel_thread::do_work_(){
 
   typedef kernel_thread::task_type_ptr task_type_ptr;
 
+  // how many times we failed to find work in a row
+  uint_t n_misses = 0;
+
   //if the thread has not been told to stop
   //the try to get some work to do
   while(!stop_){
 
       task_type_ptr task = nullptr;
 
-      if(tasks_.pop(task)){
+      if(tasks_.pop(task) || steal_(task)){
 
               working_ = true;
+              n_misses = 0;
+
+              // the task may be destroyed by the thread
+              // waiting on the latch so get it first
+              CountDownLatch* latch = task->get_completion_latch();
 
               //the task may have children
               //in order to respect locality of data
@@ -40,15 +53,106 @@ kernel_thread::do_work_(){
               //}
               (*task)();
               working_ = false;
+
+              if(latch){
+                  latch->count_down();
+              }
       }
-      else{
+      else if(n_misses < n_idle_spins_){
 
               working_ = false;
+              n_misses++;
               std::this_thread::yield();
       }
+      else{
+
+              // spinning did not bring any work
+              // so block until we are woken up
+              park_();
+              n_misses = 0;
+      }
   }
 }
 
+void
+kernel_thread::park_(){
+
+    std::unique_lock<std::mutex> lk(park_mutex_);
+
+    // announce that we park before checking the queues. A
+    // peer that pushes a task after the check sees the flag
+    // and wakes us up. See push_task
+    parked_ = true;
+    park_cond_.wait(lk, [this]{return signalled_ || stop_ || !tasks_.empty() || victims_have_work_();});
+    parked_ = false;
+    signalled_ = false;
+}
+
+bool
+kernel_thread::victims_have_work_()const{
+
+    for(const auto* victim : victims_){
+        if(victim != this && victim->n_tasks() != 0){
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void
+kernel_thread::wake_parked_peer_(){
+
+    const uint_t n_victims = victims_.size();
+    for(uint_t v=0; v<n_victims; ++v){
+
+        auto* victim = victims_[(id_ + v + 1) % n_victims];
+
+        if(victim != this && victim->is_parked()){
+            victim->wake();
+            return;
+        }
+    }
+}
+
+void
+kernel_thread::wake(){
+
+    {
+        std::lock_guard<std::mutex> lk(park_mutex_);
+        signalled_ = true;
+    }
+
+    park_cond_.notify_one();
+}
+
+
+bool
+kernel_thread::steal_(kernel_thread::task_type_ptr& task){
+
+    if(victims_.empty()){
+        return false;
+    }
+
+    // start from the next thread so that idle
+    // threads do not all hit the same victim
+    const uint_t n_victims = victims_.size();
+    for(uint_t v=0; v<n_victims; ++v){
+
+        auto* victim = victims_[(id_ + v + 1) % n_victims];
+
+        if(victim == this){
+            continue;
+        }
+
+        if(victim->steal_task(task)){
+            return true;
+        }
+    }
+
+    return false;
+}
+
 
 void
 kernel_thread::start(){
@@ -74,6 +178,8 @@ kernel_thread::stop(){
     //tell the thread first to stop
     stop_ = true;
 
+    // the thread may be blocked waiting for work
+    wake();
     join();
 
     started_ = false;
@@ -83,6 +189,13 @@ kernel_thread::stop(){
 void
 kernel_thread::push_task(kernel_thread::task_type& task){
     tasks_.push_task(&task);
+    wake();
+
+    // this thread may be busy with a long task. With work
+    // stealing let a parked peer take the task instead
+    if(!victims_.empty()){
+        wake_parked_peer_();
+    }
 }
 
 void
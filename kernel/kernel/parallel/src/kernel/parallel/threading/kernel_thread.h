@@ -2,13 +2,15 @@
 #define PARFRAME_THREAD_H
 
 #include "kernel/base/types.h"
-#include "kernel/parallel/data_structs/task_queue.h"
+#include "kernel/parallel/data_structs/work_stealing_queue.h"
 #include <boost/core/noncopyable.hpp>
 
 #include <vector>
 #include <memory>
 #include <thread>
 #include <mutex>
+#include <atomic>
+#include <condition_variable>
 
 namespace kernel
 {
@@ -41,9 +43,12 @@ public:
     typedef task_type* task_type_ptr;
 
     /**
-     * ctor construct by passing the id of the thread
+     * ctor construct by passing the id of the thread.
+     * n_idle_spins is the number of times the thread polls
+     * for work, yielding in between, before it blocks waiting
+     * for a task to be pushed
      */
-    explicit kernel_thread(uint_t id);
+    explicit kernel_thread(uint_t id, uint_t n_idle_spins=64);
 
     /**
      * dtor wait until the thread finishes
@@ -85,12 +90,44 @@ public:
      */
     uint_t n_tasks()const{return tasks_.size();}
 
+    /**
+     * the pending tasks plus the task the thread is
+     * currently running, if any. A thread busy with a long
+     * task is therefore not seen as idle by the pool
+     */
+    uint_t load()const{return tasks_.size() + (working_ ? 1 : 0);}
+
+    /**
+     * set the threads this thread may steal tasks from
+     * when its own queue is empty. Passing an empty list
+     * disables work stealing. This should be called
+     * before start()
+     */
+    void set_victims(const std::vector<kernel_thread*>& victims){victims_ = victims;}
+
+    /**
+     * attempt to steal a task from the back of the queue
+     * of this thread. Returns false if there is nothing
+     * to steal
+     */
+    bool steal_task(task_type_ptr& task){return tasks_.steal(task);}
+
+    /**
+     * wake up the thread if it is blocked waiting for work
+     */
+    void wake();
+
+    /**
+     * true if the thread is blocked waiting for work
+     */
+    bool is_parked()const noexcept{return parked_;}
+
 private:
 
     /**
-     * flag indicating whether the thread is working
+     * flag indicating whether the thread is running a task
      */
-    bool working_;
+    std::atomic<bool> working_;
 
     /**
      * flag indicating whether the thread has been started
@@ -100,7 +137,23 @@ private:
     /**
      * flag indicating whether the thread has been stopped
      */
-    bool stop_;
+    std::atomic<bool> stop_;
+
+    /**
+     * flag indicating that the thread has been signalled
+     * whilst blocked waiting for work
+     */
+    bool signalled_;
+
+    /**
+     * flag indicating that the thread is blocked waiting for work
+     */
+    std::atomic<bool> parked_;
+
+    /**
+     * how many times to poll for work before blocking
+     */
+    uint_t n_idle_spins_;
 
     /**
      * the zero based index of the thread
@@ -111,10 +164,34 @@ private:
     std::thread t_;
 
     /// \brief The queue of thread tasks
-    TaskQueue<task_type> tasks_;
+    WorkStealingQueue<task_type> tasks_;
+
+    /// \brief The threads this thread steals from when idle
+    std::vector<kernel_thread*> victims_;
+
+    /// \brief Mutex and condition variable used to
+    /// block the thread when there is no work
+    std::mutex park_mutex_;
+    std::condition_variable park_cond_;
 
     /// \brief the function that actually does the work
     void do_work_();
+
+    /// \brief Block the thread until a task is pushed or
+    /// the thread is told to stop. A thread that steals also
+    /// wakes up when one of its victims has pending tasks
+    void park_();
+
+    /// \brief Returns true if one of the victims has pending tasks
+    bool victims_have_work_()const;
+
+    /// \brief Wake up one of the victims that is blocked waiting
+    /// for work so that it can steal the task just pushed
+    void wake_parked_peer_();
+
+    /// \brief Try to steal a task from one of the victims.
+    /// Victims are visited starting from the one next to this thread
+    bool steal_(task_type_ptr& task);
 };
 
 }//detail
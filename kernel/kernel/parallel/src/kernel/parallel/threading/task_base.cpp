@@ -14,7 +14,8 @@ TaskBase::TaskBase(uint_t id)
     :
     state_(TaskBase::TaskState::PENDING),
     id_(id),
-    name_(KernelConsts::dummy_string())
+    name_(KernelConsts::dummy_string()),
+    latch_(nullptr)
 {}
 
 TaskBase::~TaskBase()
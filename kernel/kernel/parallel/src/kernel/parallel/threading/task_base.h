@@ -10,6 +10,9 @@
 namespace kernel
 {
 
+/// forward declarations
+class CountDownLatch;
+
 /// \brief Base class for task execution. A task cannot be
 /// copied not copy assigned. It can only be moved
 class TaskBase: boost::noncopyable
@@ -59,6 +62,13 @@ public:
     /// \brief Set the name of the task
     void set_name(const std::string& name){name_ = name;}
 
+    /// \brief Set the latch that the executing thread counts down
+    /// once the task has been executed. Pass nullptr to detach the latch
+    void set_completion_latch(CountDownLatch* latch){latch_ = latch;}
+
+    /// \brief Returns the latch associated with the task. May be nullptr
+    CountDownLatch* get_completion_latch()const{return latch_;}
+
 protected:
 
     /// \brief Constructor
@@ -79,6 +89,10 @@ protected:
     /// for the task
     std::string name_;
 
+    /// \brief The latch to count down when the task
+    /// has been executed by a worker thread
+    CountDownLatch* latch_;
+
 };
 
 inline
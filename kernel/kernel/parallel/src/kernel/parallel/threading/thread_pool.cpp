@@ -15,6 +15,8 @@ next_thread_available_ (kernel::KernelConsts::invalid_size_type()),
 is_started_(false),
 is_closed_(true)
 {
+    options_.n_threads = n_threads_;
+
     // TODO: perhaps we could request the system
     // using std::thread::hardware_concurrency()
     // or having a default number of threads?
@@ -61,10 +63,30 @@ ThreadPool::start(){
         throw std::logic_error("Pool is already running. You need to stop is first");
     }
 
+    pool_.clear();
     pool_.reserve(options_.n_threads);
     for(uint_t t=0; t < options_.n_threads; ++t){
-        pool_.push_back( std::make_unique<detail::kernel_thread>(t) );
-        pool_[t]->start();
+        pool_.push_back( std::make_unique<detail::kernel_thread>(t, options_.n_idle_spins) );
+    }
+
+    // every thread may steal from every other thread.
+    // Victims must be known before the threads start
+    if(options_.schedule == ThreadPoolOptions::ScheduleType::WORK_STEALING &&
+       pool_.size() > 1){
+
+        std::vector<detail::kernel_thread*> victims;
+        victims.reserve(pool_.size());
+        for(auto& thread: pool_){
+            victims.push_back(thread.get());
+        }
+
+        for(auto& thread: pool_){
+            thread->set_victims(victims);
+        }
+    }
+
+    for(auto& thread: pool_){
+        thread->start();
     }
 
     is_started_ = true;
@@ -83,18 +105,43 @@ ThreadPool::add_task(TaskBase& task){
       throw std::logic_error("Thread pool is not started");
     }
 
+    // pass the task
+    pool_[select_thread_()]->push_task(task);
+
+    if(options_.msg_when_adding_tasks){
+        std::cout<<"MESSAGE:  Added task: "<<task.get_name()<<std::endl;
+    }
+}
+
+uint_t
+ThreadPool::select_thread_(){
+
     if(next_thread_available_ == kernel::KernelConsts::invalid_size_type() ||
        next_thread_available_ >= pool_.size()){
         next_thread_available_=0;
     }
 
-    // pass the task
-    pool_[next_thread_available_]->push_task(task);
-    next_thread_available_++;
+    uint_t selected = next_thread_available_++;
 
-    if(options_.msg_when_adding_tasks){
-        std::cout<<"MESSAGE:  Added task: "<<task.get_name()<<std::endl;
+    if(options_.schedule == ThreadPoolOptions::ScheduleType::WORK_STEALING){
+
+        // pick the thread with the fewest pending and running tasks.
+        // Start the search from the round robin candidate so that
+        // ties are broken in turn
+        uint_t min_load = pool_[selected]->load();
+        for(uint_t t=1; t<pool_.size() && min_load != 0; ++t){
+
+            const uint_t candidate = (selected + t) % pool_.size();
+            const uint_t load = pool_[candidate]->load();
+
+            if(load < min_load){
+                min_load = load;
+                selected = candidate;
+            }
+        }
     }
+
+    return selected;
 }
 
 void
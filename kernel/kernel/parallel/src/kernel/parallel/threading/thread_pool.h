@@ -4,6 +4,7 @@
 #include "kernel/base/types.h"
 #include "kernel/base/kernel_consts.h"
 #include "kernel/parallel/threading/task_uitilities.h"
+#include "kernel/parallel/threading/count_down_latch.h"
 
 #include <boost/core/noncopyable.hpp>
 
@@ -25,7 +26,20 @@ class kernel_thread;
 
 struct ThreadPoolOptions
 {
+   /// \brief An enumeration describing how tasks are distributed to
+   /// the worker threads. With ROUND_ROBIN tasks are assigned to the
+   /// threads in turn and every thread only executes the tasks it has been
+   /// assigned. With WORK_STEALING tasks are assigned to the least loaded
+   /// thread and idle threads steal pending tasks from the other threads
+   enum class ScheduleType{ROUND_ROBIN, WORK_STEALING};
+
    uint_t n_threads{1};
+   ScheduleType schedule{ScheduleType::ROUND_ROBIN};
+
+   /// \brief How many times an idle worker polls for work, yielding
+   /// in between, before it blocks waiting for a task to be added.
+   /// Use zero to block immediately
+   uint_t n_idle_spins{64};
    bool start_on_construction{true};
    bool msg_when_adding_tasks{false};
    bool msg_on_start_up{false};
@@ -67,7 +81,8 @@ public:
     /// \brief Allocate the given tasks for execution
     void add_tasks(const std::vector<std::unique_ptr<TaskBase>>& tasks);
 
-    /// \brief Execute the tasks with the given options
+    /// \brief Execute the tasks with the given options. The calling thread
+    /// blocks until all the tasks have been executed.
     /// Options aregument currently has no effect
     template<typename TaskTypePtr, typename Options>
     void execute(const std::vector<std::unique_ptr<TaskTypePtr>>& tasks, const Options& options = Null() );
@@ -84,6 +99,9 @@ public:
     /// \brief query the pool about the stop state
     bool is_closed()const{return is_closed_;}
 
+    /// \brief Returns the scheduling type the pool is using
+    ThreadPoolOptions::ScheduleType get_schedule_type()const{return options_.schedule;}
+
 private:
 
     typedef detail::kernel_thread thread_type;
@@ -102,6 +120,10 @@ private:
 
     /// \brief flag indicating if the pool is closed
     bool is_closed_;
+
+    /// \brief Returns the index of the thread that
+    /// should receive the next task
+    uint_t select_thread_();
 };
 
 
@@ -113,19 +135,34 @@ ThreadPool::execute(const std::vector<std::unique_ptr<TaskTypePtr>>& tasks, cons
         return;
     }
 
+    if(!is_started_){
+      throw std::logic_error("Thread pool is not started");
+    }
+
     for(uint_t t=0; t<tasks.size(); ++t){
 
         if(!tasks[t]){
             throw std::invalid_argument("Null Task Pointer in ThreadPool");
         }
+    }
+
+    // the workers count down the latch
+    // every time they finish one of the tasks
+    CountDownLatch latch(tasks.size());
 
+    for(uint_t t=0; t<tasks.size(); ++t){
+        tasks[t]->set_completion_latch(&latch);
         add_task(*(tasks[t].get()));
     }
 
     // if the tasks have not finished yet
-    // then the calling thread waits here
-    while(!taskutils::tasks_finished(tasks)){
-       std::this_thread::yield();
+    // then the calling thread blocks here
+    latch.wait();
+
+    // the latch goes out of scope so
+    // detach it from the tasks
+    for(uint_t t=0; t<tasks.size(); ++t){
+        tasks[t]->set_completion_latch(nullptr);
     }
 }
 
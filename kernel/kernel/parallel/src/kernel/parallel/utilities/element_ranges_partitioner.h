@@ -0,0 +1,85 @@
+#ifndef ELEMENT_RANGES_PARTITIONER_H
+#define ELEMENT_RANGES_PARTITIONER_H
+
+#include "kernel/base/types.h"
+#include "kernel/base/config.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/element_mesh_iterator.h"
+#include "kernel/discretization/mesh_predicates.h"
+
+#include <vector>
+#include <stdexcept>
+
+namespace kernel{
+namespace numerics {
+
+template<int dim> class Mesh;
+template<int dim> class Element;
+
+/// \brief Collect the active elements of the mesh into n_parts lists
+/// so that threaded kernels visit only their own elements instead of
+/// filtering the whole mesh by pid. If every active element carries a
+/// pid less than n_parts (e.g. after linear_mesh_partition) the pids
+/// are respected. Otherwise the active elements are split into n_parts
+/// contiguous chunks of (almost) equal size. Every active element
+/// appears in exactly one list
+template<int dim>
+void element_ranges_partition(const Mesh<dim>& mesh, uint_t n_parts,
+                              std::vector<std::vector<const Element<dim>*>>& ranges){
+
+    if(n_parts == 0){
+        throw std::invalid_argument("Cannot partition range into zero parts");
+    }
+
+    ranges.clear();
+    ranges.resize(n_parts);
+
+    ConstElementMeshIterator<Active, Mesh<dim>> filter(mesh);
+
+    uint_t total_work = 0;
+    bool use_pids = true;
+
+    for(auto itr = filter.begin(); itr != filter.end(); ++itr){
+
+        total_work++;
+        if((*itr)->get_pid() >= n_parts){
+            use_pids = false;
+        }
+    }
+
+    if(use_pids){
+
+        for(auto itr = filter.begin(); itr != filter.end(); ++itr){
+            ranges[(*itr)->get_pid()].push_back(*itr);
+        }
+
+        return;
+    }
+
+    // the first total_work % n_parts lists
+    // get one element more
+    const uint_t part_load = total_work/n_parts;
+    const uint_t remainder = total_work%n_parts;
+
+    for(uint_t p=0; p<n_parts; ++p){
+        ranges[p].reserve(part_load + 1);
+    }
+
+    uint_t part = 0;
+    for(auto itr = filter.begin(); itr != filter.end(); ++itr){
+
+        const uint_t capacity = part < remainder ? part_load + 1 : part_load;
+
+        if(ranges[part].size() == capacity && part < n_parts - 1){
+            part++;
+        }
+
+        ranges[part].push_back(*itr);
+    }
+}
+
+}
+}
+
+#endif // ELEMENT_RANGES_PARTITIONER_H
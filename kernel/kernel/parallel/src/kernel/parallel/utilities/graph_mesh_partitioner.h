@@ -0,0 +1,119 @@
+#ifndef GRAPH_MESH_PARTITIONER_H
+#define GRAPH_MESH_PARTITIONER_H
+
+#include "kernel/base/types.h"
+#include "kernel/base/config.h"
+#include "kernel/parallel/utilities/graph_partitioner.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/element_mesh_iterator.h"
+#include "kernel/discretization/mesh_predicates.h"
+
+#ifdef USE_LOG
+#include "kernel/utilities/logger.h"
+#include <chrono>
+#include <sstream>
+#endif
+
+#include <vector>
+#include <unordered_map>
+#include <stdexcept>
+
+namespace kernel{
+namespace numerics {
+
+template<int dim> class Mesh;
+
+/// \brief Build the element adjacency graph of the active elements
+/// in CSR format. Two elements are adjacent if they share a face.
+/// elements[i] is the element that corresponds to vertex i
+template<int dim>
+void element_adjacency_graph(const Mesh<dim>& mesh, std::vector<const Element<dim>*>& elements,
+                             std::vector<uint_t>& xadj, std::vector<uint_t>& adjncy){
+
+    elements.clear();
+    xadj.clear();
+    adjncy.clear();
+
+    ConstElementMeshIterator<Active, Mesh<dim>> filter(mesh);
+
+    std::unordered_map<const Element<dim>*, uint_t> vertex;
+    for(auto itr = filter.begin(); itr != filter.end(); ++itr){
+        vertex[*itr] = elements.size();
+        elements.push_back(*itr);
+    }
+
+    xadj.reserve(elements.size() + 1);
+    xadj.push_back(0);
+
+    for(const auto* element : elements){
+
+        for(uint_t n=0; n<element->n_neighbors(); ++n){
+
+            auto itr = vertex.find(element->neighbor_ptr(n));
+
+            // boundary faces and inactive neighbors
+            if(itr != vertex.end()){
+                adjncy.push_back(itr->second);
+            }
+        }
+
+        xadj.push_back(adjncy.size());
+    }
+}
+
+/// \brief Assigns the processor id for every active element in the
+/// given Mesh object with the multilevel GraphPartitioner. The parts
+/// have (almost) the same number of elements and few faces between
+/// elements of different parts. Returns the edge cut, i.e. the number
+/// of faces shared by different parts, and the imbalance of the partition
+template<int dim>
+GraphPartitionInfo graph_mesh_partition(Mesh<dim>& mesh, uint_t n_parts,
+                                        const GraphPartitionerConfig& config = GraphPartitionerConfig()){
+
+    if(n_parts == 0){
+        throw std::invalid_argument("Cannot partition range into zero parts");
+    }
+
+#ifdef USE_LOG
+    std::chrono::time_point<std::chrono::system_clock> start_timing = std::chrono::system_clock::now();
+#endif
+
+    std::vector<const Element<dim>*> elements;
+    std::vector<uint_t> xadj;
+    std::vector<uint_t> adjncy;
+    element_adjacency_graph(mesh, elements, xadj, adjncy);
+
+    if(elements.empty()){
+        throw std::invalid_argument("Cannot partition a mesh without active elements");
+    }
+
+    std::vector<uint_t> parts;
+    GraphPartitioner partitioner(config);
+    auto info = partitioner.partition(xadj, adjncy, n_parts, parts);
+
+    // the active elements are visited in the
+    // same order as in element_adjacency_graph
+    ElementMeshIterator<Active, Mesh<dim>> filter(mesh);
+
+    uint_t e = 0;
+    for(auto itr = filter.begin(); itr != filter.end(); ++itr, ++e){
+        (*itr)->set_pid(parts[e]);
+    }
+
+#ifdef USE_LOG
+    std::chrono::time_point<std::chrono::system_clock> end_timing = std::chrono::system_clock::now();
+    std::chrono::duration<real_t> dur = end_timing-start_timing;
+    std::ostringstream message;
+    message<<"graph_mesh_partition run time: "<<dur.count()<<" edge cut: "<<info.edge_cut
+           <<" imbalance: "<<info.imbalance;
+    Logger::log_info(message.str());
+#endif
+
+    return info;
+}
+
+}
+}
+
+#endif // GRAPH_MESH_PARTITIONER_H
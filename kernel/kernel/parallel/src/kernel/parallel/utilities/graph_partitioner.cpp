@@ -0,0 +1,680 @@
+#include "kernel/parallel/utilities/graph_partitioner.h"
+#include "kernel/base/kernel_consts.h"
+
+#include <algorithm>
+#include <numeric>
+#include <queue>
+#include <utility>
+#include <stdexcept>
+#include <string>
+#include <cstdint>
+#include <limits>
+
+namespace kernel
+{
+
+namespace{
+
+typedef std::int64_t gain_t;
+
+/// \brief Weight of the lighter side allowed by
+/// the tolerance. Heavy coarse vertices may make
+/// the tolerance unreachable so one vertex of slack
+/// is always allowed
+uint_t
+max_side_weight(uint_t target, real_t tolerance, uint_t max_vertex_weight){
+
+    const uint_t with_tolerance = static_cast<uint_t>(target*(1.0 + tolerance));
+    return std::max(with_tolerance, target + max_vertex_weight);
+}
+
+}
+
+std::ostream&
+GraphPartitionInfo::print(std::ostream& out)const{
+
+    out<<"# parts:   "<<n_parts<<std::endl;
+    out<<"Edge cut:  "<<edge_cut<<std::endl;
+    out<<"Imbalance: "<<imbalance<<std::endl;
+    return out;
+}
+
+GraphPartitioner::GraphPartitioner(const config_t& config)
+    :
+    config_(config)
+{}
+
+GraphPartitionInfo
+GraphPartitioner::partition(const std::vector<uint_t>& xadj, const std::vector<uint_t>& adjncy,
+                            uint_t n_parts, std::vector<uint_t>& parts)const{
+
+    if(n_parts == 0){
+        throw std::invalid_argument("Cannot partition a graph into zero parts");
+    }
+
+    if(xadj.size() < 2){
+        throw std::invalid_argument("Cannot partition an empty graph");
+    }
+
+    const uint_t n = xadj.size() - 1;
+
+    if(xadj[n] != adjncy.size()){
+        throw std::invalid_argument("Invalid CSR graph. The adjacency has size: "+std::to_string(adjncy.size())+
+                                    " but xadj ends at: "+std::to_string(xadj[n]));
+    }
+
+    Graph graph;
+    graph.xadj = xadj;
+    graph.adjncy = adjncy;
+    graph.adjwgt.assign(adjncy.size(), 1);
+    graph.vwgt.assign(n, 1);
+    graph.label.resize(n);
+    std::iota(graph.label.begin(), graph.label.end(), 0);
+    graph.total_weight = n;
+
+    parts.assign(n, 0);
+
+    if(n_parts > 1){
+
+        generator_t generator(config_.seed);
+        recursive_bisection(graph, n_parts, 0, parts, generator);
+        kway_refine(graph, n_parts, parts);
+    }
+
+    return partition_info(xadj, adjncy, n_parts, parts);
+}
+
+GraphPartitionInfo
+GraphPartitioner::partition_info(const std::vector<uint_t>& xadj, const std::vector<uint_t>& adjncy,
+                                 uint_t n_parts, const std::vector<uint_t>& parts){
+
+    GraphPartitionInfo info;
+    info.n_parts = n_parts;
+    info.part_weights.assign(n_parts, 0);
+
+    const uint_t n = parts.size();
+    uint_t cut = 0;
+
+    for(uint_t v=0; v<n; ++v){
+
+        info.part_weights[parts[v]] += 1;
+
+        for(uint_t i=xadj[v]; i<xadj[v + 1]; ++i){
+            if(parts[adjncy[i]] != parts[v]){
+                cut++;
+            }
+        }
+    }
+
+    // every edge is seen from both ends
+    info.edge_cut = cut/2;
+
+    const uint_t heaviest = *std::max_element(info.part_weights.begin(), info.part_weights.end());
+    info.imbalance = n == 0 ? 0.0 : static_cast<real_t>(heaviest*n_parts)/static_cast<real_t>(n);
+
+    return info;
+}
+
+void
+GraphPartitioner::recursive_bisection(const Graph& graph, uint_t n_parts, uint_t first_part,
+                                      std::vector<uint_t>& parts, generator_t& generator)const{
+
+    if(n_parts == 1 || graph.n_vertices() == 0){
+
+        for(uint_t v=0; v<graph.n_vertices(); ++v){
+            parts[graph.label[v]] = first_part;
+        }
+
+        return;
+    }
+
+    // uneven number of parts are split
+    // in proportion to the weight
+    const uint_t left_parts = n_parts/2;
+    const uint_t target_left = static_cast<uint_t>((static_cast<real_t>(graph.total_weight)*left_parts)/n_parts);
+
+    std::vector<uint_t> side;
+    multilevel_bisection(graph, target_left, side, generator);
+
+    Graph left;
+    extract_subgraph(graph, side, 0, left);
+    recursive_bisection(left, left_parts, first_part, parts, generator);
+
+    Graph right;
+    extract_subgraph(graph, side, 1, right);
+    recursive_bisection(right, n_parts - left_parts, first_part + left_parts, parts, generator);
+}
+
+void
+GraphPartitioner::multilevel_bisection(const Graph& graph, uint_t target_left,
+                                       std::vector<uint_t>& side, generator_t& generator)const{
+
+    // the hierarchy of coarse graphs and the
+    // maps from every level to the next coarser one
+    std::vector<Graph> levels;
+    std::vector<std::vector<uint_t>> cmaps;
+
+    const Graph* current = &graph;
+
+    while(current->n_vertices() > config_.coarsest_graph_size){
+
+        Graph coarse;
+        std::vector<uint_t> cmap;
+        coarsen(*current, coarse, cmap, generator);
+
+        // stop when the matching no longer shrinks the graph
+        if(20*coarse.n_vertices() > 19*current->n_vertices()){
+            break;
+        }
+
+        levels.push_back(std::move(coarse));
+        cmaps.push_back(std::move(cmap));
+        current = &levels.back();
+    }
+
+    initial_bisection(*current, target_left, side, generator);
+
+    // project back and refine on every level
+    for(uint_t l=levels.size(); l>0; --l){
+
+        const Graph& fine = l == 1 ? graph : levels[l - 2];
+        const auto& cmap = cmaps[l - 1];
+
+        std::vector<uint_t> fine_side(fine.n_vertices());
+        for(uint_t v=0; v<fine.n_vertices(); ++v){
+            fine_side[v] = side[cmap[v]];
+        }
+
+        side.swap(fine_side);
+        fm_refine(fine, target_left, side);
+    }
+}
+
+void
+GraphPartitioner::coarsen(const Graph& fine, Graph& coarse, std::vector<uint_t>& cmap,
+                          generator_t& generator)const{
+
+    const uint_t n = fine.n_vertices();
+    const uint_t unmatched = KernelConsts::invalid_size_type();
+
+    // do not create vertices that are too
+    // heavy to balance the coarsest graph
+    const uint_t max_vertex_weight = std::max<uint_t>(1, (3*fine.total_weight)/(2*config_.coarsest_graph_size));
+
+    std::vector<uint_t> match(n, unmatched);
+    std::vector<uint_t> visit(n);
+    std::iota(visit.begin(), visit.end(), 0);
+    std::shuffle(visit.begin(), visit.end(), generator);
+
+    // heavy edge matching
+    for(auto v : visit){
+
+        if(match[v] != unmatched){
+            continue;
+        }
+
+        uint_t best = v;
+        uint_t best_weight = 0;
+
+        for(uint_t i=fine.xadj[v]; i<fine.xadj[v + 1]; ++i){
+
+            const uint_t u = fine.adjncy[i];
+
+            if(match[u] == unmatched && u != v && fine.adjwgt[i] > best_weight &&
+               fine.vwgt[v] + fine.vwgt[u] <= max_vertex_weight){
+                best = u;
+                best_weight = fine.adjwgt[i];
+            }
+        }
+
+        match[v] = best;
+        match[best] = v;
+    }
+
+    cmap.assign(n, unmatched);
+    std::vector<uint_t> members;
+    members.reserve(2*n);
+
+    uint_t n_coarse = 0;
+    for(uint_t v=0; v<n; ++v){
+
+        if(cmap[v] != unmatched){
+            continue;
+        }
+
+        cmap[v] = n_coarse;
+        members.push_back(v);
+
+        if(match[v] != v){
+            cmap[match[v]] = n_coarse;
+        }
+
+        members.push_back(match[v]);
+        n_coarse++;
+    }
+
+    coarse.xadj.assign(1, 0);
+    coarse.xadj.reserve(n_coarse + 1);
+    coarse.adjncy.clear();
+    coarse.adjwgt.clear();
+    coarse.vwgt.assign(n_coarse, 0);
+    coarse.label.assign(n_coarse, unmatched);
+    coarse.total_weight = fine.total_weight;
+
+    // position of a coarse neighbor in the
+    // adjacency of the vertex being built
+    std::vector<uint_t> position(n_coarse, unmatched);
+
+    for(uint_t c=0; c<n_coarse; ++c){
+
+        const uint_t begin = coarse.adjncy.size();
+        const uint_t v1 = members[2*c];
+        const uint_t v2 = members[2*c + 1];
+
+        coarse.vwgt[c] = fine.vwgt[v1] + (v2 != v1 ? fine.vwgt[v2] : 0);
+
+        for(auto v : {v1, v2}){
+
+            for(uint_t i=fine.xadj[v]; i<fine.xadj[v + 1]; ++i){
+
+                const uint_t cu = cmap[fine.adjncy[i]];
+
+                if(cu == c){
+                    continue;
+                }
+
+                if(position[cu] == unmatched){
+                    position[cu] = coarse.adjncy.size();
+                    coarse.adjncy.push_back(cu);
+                    coarse.adjwgt.push_back(fine.adjwgt[i]);
+                }
+                else{
+                    coarse.adjwgt[position[cu]] += fine.adjwgt[i];
+                }
+            }
+
+            if(v2 == v1){
+                break;
+            }
+        }
+
+        for(uint_t i=begin; i<coarse.adjncy.size(); ++i){
+            position[coarse.adjncy[i]] = unmatched;
+        }
+
+        coarse.xadj.push_back(coarse.adjncy.size());
+    }
+}
+
+void
+GraphPartitioner::initial_bisection(const Graph& graph, uint_t target_left,
+                                    std::vector<uint_t>& side, generator_t& generator)const{
+
+    const uint_t n = graph.n_vertices();
+
+    std::uniform_int_distribution<uint_t> start_vertex(0, n - 1);
+    std::vector<uint_t> trial(n);
+    std::vector<bool> visited(n);
+    std::queue<uint_t> queue;
+
+    uint_t best_cut = KernelConsts::invalid_size_type();
+
+    for(uint_t t=0; t<std::max<uint_t>(1, config_.n_initial_tries); ++t){
+
+        // grow the left side in breadth first
+        // order until it reaches its target weight
+        std::fill(trial.begin(), trial.end(), 1);
+        std::fill(visited.begin(), visited.end(), false);
+
+        uint_t left_weight = 0;
+        uint_t next_seed = 0;
+        queue.push(start_vertex(generator));
+        visited[queue.front()] = true;
+
+        while(left_weight < target_left){
+
+            if(queue.empty()){
+
+                // the graph is not connected
+                while(next_seed < n && visited[next_seed]){
+                    next_seed++;
+                }
+
+                if(next_seed == n){
+                    break;
+                }
+
+                visited[next_seed] = true;
+                queue.push(next_seed);
+            }
+
+            const uint_t v = queue.front();
+            queue.pop();
+
+            trial[v] = 0;
+            left_weight += graph.vwgt[v];
+
+            for(uint_t i=graph.xadj[v]; i<graph.xadj[v + 1]; ++i){
+
+                const uint_t u = graph.adjncy[i];
+                if(!visited[u]){
+                    visited[u] = true;
+                    queue.push(u);
+                }
+            }
+        }
+
+        std::queue<uint_t>().swap(queue);
+
+        fm_refine(graph, target_left, trial);
+
+        const uint_t cut = bisection_cut(graph, trial);
+        if(cut < best_cut){
+            best_cut = cut;
+            side = trial;
+        }
+    }
+}
+
+void
+GraphPartitioner::fm_refine(const Graph& graph, uint_t target_left, std::vector<uint_t>& side)const{
+
+    const uint_t n = graph.n_vertices();
+    const uint_t max_vertex_weight = *std::max_element(graph.vwgt.begin(), graph.vwgt.end());
+
+    const uint_t targets[2] = {target_left, graph.total_weight - target_left};
+    const uint_t max_weights[2] = {max_side_weight(targets[0], config_.imbalance_tolerance, max_vertex_weight),
+                                   max_side_weight(targets[1], config_.imbalance_tolerance, max_vertex_weight)};
+
+    // stop a pass after this many moves without improvement
+    const uint_t max_bad_moves = std::max<uint_t>(50, n/100);
+
+    std::vector<gain_t> internal(n);
+    std::vector<gain_t> external(n);
+    std::vector<bool> locked(n);
+    std::vector<uint_t> moves;
+
+    typedef std::pair<gain_t, uint_t> entry_t;
+
+    for(uint_t pass=0; pass<config_.n_refinement_passes; ++pass){
+
+        uint_t weights[2] = {0, 0};
+        gain_t cut = 0;
+
+        std::priority_queue<entry_t> heaps[2];
+
+        for(uint_t v=0; v<n; ++v){
+
+            weights[side[v]] += graph.vwgt[v];
+            internal[v] = 0;
+            external[v] = 0;
+
+            for(uint_t i=graph.xadj[v]; i<graph.xadj[v + 1]; ++i){
+
+                if(side[graph.adjncy[i]] == side[v]){
+                    internal[v] += graph.adjwgt[i];
+                }
+                else{
+                    external[v] += graph.adjwgt[i];
+                }
+            }
+
+            cut += external[v];
+
+            if(external[v] > 0){
+                heaps[side[v]].push({external[v] - internal[v], v});
+            }
+        }
+
+        cut /= 2;
+
+        // a state is better if it violates the balance less
+        // or if it is as balanced and has a smaller cut
+        auto violation = [&weights, &max_weights](){
+            return (weights[0] > max_weights[0] ? weights[0] - max_weights[0] : 0) +
+                   (weights[1] > max_weights[1] ? weights[1] - max_weights[1] : 0);
+        };
+
+        const gain_t initial_cut = cut;
+        const uint_t initial_violation = violation();
+
+        gain_t best_cut = cut;
+        uint_t best_violation = initial_violation;
+        uint_t best_move = 0;
+
+        std::fill(locked.begin(), locked.end(), false);
+        moves.clear();
+
+        while(moves.size() - best_move < max_bad_moves){
+
+            // the best unlocked vertex of every side
+            // whose move does not overload the other side
+            uint_t candidates[2] = {n, n};
+
+            for(uint_t s=0; s<2; ++s){
+
+                while(!heaps[s].empty()){
+
+                    const auto [gain, v] = heaps[s].top();
+
+                    if(locked[v] || side[v] != s || gain != external[v] - internal[v]){
+                        heaps[s].pop();
+                        continue;
+                    }
+
+                    if(weights[1 - s] + graph.vwgt[v] <= max_weights[1 - s] || weights[s] > max_weights[s]){
+                        candidates[s] = v;
+                    }
+
+                    break;
+                }
+            }
+
+            uint_t from = 2;
+
+            if(weights[0] > max_weights[0] && candidates[0] != n){
+                from = 0;
+            }
+            else if(weights[1] > max_weights[1] && candidates[1] != n){
+                from = 1;
+            }
+            else if(candidates[0] != n && candidates[1] != n){
+
+                const gain_t gain0 = external[candidates[0]] - internal[candidates[0]];
+                const gain_t gain1 = external[candidates[1]] - internal[candidates[1]];
+                from = gain0 > gain1 || (gain0 == gain1 && weights[0] >= weights[1]) ? 0 : 1;
+            }
+            else if(candidates[0] != n){
+                from = 0;
+            }
+            else if(candidates[1] != n){
+                from = 1;
+            }
+
+            if(from == 2){
+                break;
+            }
+
+            const uint_t v = candidates[from];
+            const uint_t to = 1 - from;
+            heaps[from].pop();
+
+            cut -= external[v] - internal[v];
+            weights[from] -= graph.vwgt[v];
+            weights[to] += graph.vwgt[v];
+            side[v] = to;
+            locked[v] = true;
+            std::swap(internal[v], external[v]);
+            moves.push_back(v);
+
+            for(uint_t i=graph.xadj[v]; i<graph.xadj[v + 1]; ++i){
+
+                const uint_t u = graph.adjncy[i];
+                const gain_t w = graph.adjwgt[i];
+
+                if(side[u] == to){
+                    internal[u] += w;
+                    external[u] -= w;
+                }
+                else{
+                    internal[u] -= w;
+                    external[u] += w;
+                }
+
+                if(!locked[u] && external[u] > 0){
+                    heaps[side[u]].push({external[u] - internal[u], u});
+                }
+            }
+
+            const uint_t current_violation = violation();
+
+            if(current_violation < best_violation ||
+               (current_violation == best_violation && cut < best_cut)){
+
+                best_cut = cut;
+                best_violation = current_violation;
+                best_move = moves.size();
+            }
+        }
+
+        // undo the moves after the best state
+        for(uint_t m=moves.size(); m>best_move; --m){
+            side[moves[m - 1]] = 1 - side[moves[m - 1]];
+        }
+
+        if(best_violation == initial_violation && best_cut >= initial_cut){
+            break;
+        }
+    }
+}
+
+void
+GraphPartitioner::kway_refine(const Graph& graph, uint_t n_parts, std::vector<uint_t>& parts)const{
+
+    const uint_t n = graph.n_vertices();
+    const uint_t average = (graph.total_weight + n_parts - 1)/n_parts;
+    const uint_t max_weight = max_side_weight(average, config_.imbalance_tolerance, 1);
+
+    std::vector<uint_t> weights(n_parts, 0);
+    for(uint_t v=0; v<n; ++v){
+        weights[parts[v]] += graph.vwgt[v];
+    }
+
+    // the connectivity of a vertex to the parts of its neighbors
+    std::vector<gain_t> connectivity(n_parts, 0);
+    std::vector<uint_t> neighbor_parts;
+
+    for(uint_t pass=0; pass<config_.n_refinement_passes; ++pass){
+
+        uint_t n_moves = 0;
+
+        for(uint_t v=0; v<n; ++v){
+
+            const uint_t from = parts[v];
+            neighbor_parts.clear();
+
+            for(uint_t i=graph.xadj[v]; i<graph.xadj[v + 1]; ++i){
+
+                const uint_t p = parts[graph.adjncy[i]];
+                if(connectivity[p] == 0){
+                    neighbor_parts.push_back(p);
+                }
+
+                connectivity[p] += graph.adjwgt[i];
+            }
+
+            const gain_t internal = connectivity[from];
+            const bool overloaded = weights[from] > max_weight;
+
+            uint_t to = from;
+            gain_t best_gain = overloaded ? std::numeric_limits<gain_t>::min() : 0;
+
+            for(auto p : neighbor_parts){
+
+                if(p == from || weights[p] + graph.vwgt[v] > max_weight){
+                    continue;
+                }
+
+                const gain_t gain = connectivity[p] - internal;
+
+                // zero gain moves are taken only if they improve the balance
+                if(gain > best_gain || (overloaded && gain == best_gain) ||
+                   (gain == 0 && best_gain == 0 && to == from && weights[p] + graph.vwgt[v] < weights[from])){
+                    best_gain = gain;
+                    to = p;
+                }
+            }
+
+            for(auto p : neighbor_parts){
+                connectivity[p] = 0;
+            }
+
+            if(to != from){
+
+                parts[v] = to;
+                weights[from] -= graph.vwgt[v];
+                weights[to] += graph.vwgt[v];
+                n_moves++;
+            }
+        }
+
+        if(n_moves == 0){
+            break;
+        }
+    }
+}
+
+void
+GraphPartitioner::extract_subgraph(const Graph& graph, const std::vector<uint_t>& side,
+                                   uint_t which, Graph& sub){
+
+    const uint_t n = graph.n_vertices();
+    std::vector<uint_t> local(n, KernelConsts::invalid_size_type());
+
+    sub = Graph();
+    sub.xadj.push_back(0);
+
+    for(uint_t v=0; v<n; ++v){
+        if(side[v] == which){
+            local[v] = sub.vwgt.size();
+            sub.vwgt.push_back(graph.vwgt[v]);
+            sub.label.push_back(graph.label[v]);
+            sub.total_weight += graph.vwgt[v];
+        }
+    }
+
+    for(uint_t v=0; v<n; ++v){
+
+        if(side[v] != which){
+            continue;
+        }
+
+        for(uint_t i=graph.xadj[v]; i<graph.xadj[v + 1]; ++i){
+
+            const uint_t u = graph.adjncy[i];
+            if(side[u] == which){
+                sub.adjncy.push_back(local[u]);
+                sub.adjwgt.push_back(graph.adjwgt[i]);
+            }
+        }
+
+        sub.xadj.push_back(sub.adjncy.size());
+    }
+}
+
+uint_t
+GraphPartitioner::bisection_cut(const Graph& graph, const std::vector<uint_t>& side){
+
+    uint_t cut = 0;
+    for(uint_t v=0; v<graph.n_vertices(); ++v){
+        for(uint_t i=graph.xadj[v]; i<graph.xadj[v + 1]; ++i){
+            if(side[graph.adjncy[i]] != side[v]){
+                cut += graph.adjwgt[i];
+            }
+        }
+    }
+
+    return cut/2;
+}
+
+}
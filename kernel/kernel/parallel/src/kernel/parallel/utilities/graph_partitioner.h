@@ -0,0 +1,133 @@
+#ifndef GRAPH_PARTITIONER_H
+#define GRAPH_PARTITIONER_H
+
+#include "kernel/base/types.h"
+
+#include <vector>
+#include <random>
+#include <ostream>
+
+namespace kernel
+{
+
+/// \brief Configuration of the GraphPartitioner
+struct GraphPartitionerConfig
+{
+    /// \brief Coarsening stops when the graph
+    /// has fewer vertices than this
+    uint_t coarsest_graph_size{100};
+
+    /// \brief The number of graph growing attempts
+    /// for the bisection of the coarsest graph
+    uint_t n_initial_tries{4};
+
+    /// \brief Maximum number of refinement passes per level
+    uint_t n_refinement_passes{8};
+
+    /// \brief The allowed relative excess of the
+    /// heaviest part over the average part weight
+    real_t imbalance_tolerance{0.03};
+
+    /// \brief Seed for the random visiting orders
+    uint_t seed{42};
+};
+
+/// \brief Summary of a partition
+struct GraphPartitionInfo
+{
+    /// \brief The number of parts
+    uint_t n_parts{0};
+
+    /// \brief The number of edges whose
+    /// end points are in different parts
+    uint_t edge_cut{0};
+
+    /// \brief The weight of the heaviest part
+    /// over the average part weight
+    real_t imbalance{0.0};
+
+    /// \brief The weight of every part
+    std::vector<uint_t> part_weights;
+
+    /// \brief Print the information
+    std::ostream& print(std::ostream& out)const;
+};
+
+inline
+std::ostream& operator<<(std::ostream& out, const GraphPartitionInfo& info){
+    return info.print(out);
+}
+
+/// \brief Multilevel graph partitioner. The graph is split
+/// into k parts by recursive bisection. Every bisection
+/// coarsens the graph with heavy edge matching, bisects the
+/// coarsest graph by graph growing and refines the bisection
+/// with Fiduccia-Mattheyses passes while it is projected back.
+/// A final greedy k-way pass improves the cut on the input graph.
+/// The graph is given in CSR format. Every edge must be listed
+/// from both of its end points and there are no self loops
+class GraphPartitioner
+{
+
+public:
+
+    typedef GraphPartitionerConfig config_t;
+
+    /// \brief Constructor
+    explicit GraphPartitioner(const config_t& config = config_t());
+
+    /// \brief Partition the graph into n_parts. On return parts[v]
+    /// is the part of vertex v. Throws std::invalid_argument if
+    /// n_parts is zero or the graph is empty
+    GraphPartitionInfo partition(const std::vector<uint_t>& xadj, const std::vector<uint_t>& adjncy,
+                                 uint_t n_parts, std::vector<uint_t>& parts)const;
+
+    /// \brief Compute the information of the given partition
+    static GraphPartitionInfo partition_info(const std::vector<uint_t>& xadj, const std::vector<uint_t>& adjncy,
+                                             uint_t n_parts, const std::vector<uint_t>& parts);
+
+private:
+
+    /// \brief Weighted graph in CSR format.
+    /// label maps the vertices to the input graph
+    struct Graph
+    {
+        std::vector<uint_t> xadj;
+        std::vector<uint_t> adjncy;
+        std::vector<uint_t> adjwgt;
+        std::vector<uint_t> vwgt;
+        std::vector<uint_t> label;
+        uint_t total_weight{0};
+
+        uint_t n_vertices()const{return vwgt.size();}
+    };
+
+    typedef std::mt19937 generator_t;
+
+    void recursive_bisection(const Graph& graph, uint_t n_parts, uint_t first_part,
+                             std::vector<uint_t>& parts, generator_t& generator)const;
+
+    void multilevel_bisection(const Graph& graph, uint_t target_left,
+                              std::vector<uint_t>& side, generator_t& generator)const;
+
+    void coarsen(const Graph& fine, Graph& coarse, std::vector<uint_t>& cmap,
+                 generator_t& generator)const;
+
+    void initial_bisection(const Graph& graph, uint_t target_left,
+                           std::vector<uint_t>& side, generator_t& generator)const;
+
+    void fm_refine(const Graph& graph, uint_t target_left, std::vector<uint_t>& side)const;
+
+    void kway_refine(const Graph& graph, uint_t n_parts, std::vector<uint_t>& parts)const;
+
+    static void extract_subgraph(const Graph& graph, const std::vector<uint_t>& side,
+                                 uint_t which, Graph& sub);
+
+    static uint_t bisection_cut(const Graph& graph, const std::vector<uint_t>& side);
+
+    config_t config_;
+};
+
+}
+
+#endif // GRAPH_PARTITIONER_H
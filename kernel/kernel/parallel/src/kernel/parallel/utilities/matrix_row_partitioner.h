@@ -0,0 +1,80 @@
+#ifndef MATRIX_ROW_PARTITIONER_H
+#define MATRIX_ROW_PARTITIONER_H
+
+#include "kernel/base/types.h"
+#include "kernel/utilities/range_1d.h"
+
+#include <vector>
+#include <stdexcept>
+
+namespace kernel
+{
+
+/// \brief Returns the work associated with row r of the given matrix.
+/// For sparse matrices this is the number of nonzero entries of the row
+/// plus one to account for the row overhead. For dense matrices every row
+/// carries the same work
+template<typename MatTp>
+uint_t
+matrix_row_work(const MatTp& matrix, uint_t r){
+
+    if constexpr(blaze::IsSparseMatrix_v<MatTp>){
+        return matrix.nonZeros(r) + 1;
+    }
+    else{
+        return matrix.columns();
+    }
+}
+
+/// \brief Partition the rows of the given matrix into n_parts contiguous
+/// ranges so that every range carries approximately the same work as
+/// given by matrix_row_work(). For matrices with very uneven rows this
+/// balances the threads much better than partition_range() which splits
+/// the rows evenly. Partitions may be empty if the matrix has fewer rows than
+/// n_parts
+template<typename MatTp>
+void
+partition_matrix_rows(const MatTp& matrix, std::vector<range1d<uint_t>>& partitions, uint_t n_parts){
+
+    if(n_parts == 0){
+        throw std::invalid_argument("Cannot partition matrix rows into zero parts");
+    }
+
+    const uint_t n_rows = matrix.rows();
+
+    if(n_rows == 0){
+        throw std::invalid_argument("Cannot partition a matrix with zero rows");
+    }
+
+    partitions.clear();
+    partitions.reserve(n_parts);
+
+    uint_t total_work = 0;
+    for(uint_t r=0; r<n_rows; ++r){
+        total_work += matrix_row_work(matrix, r);
+    }
+
+    uint_t start = 0;
+    uint_t row = 0;
+    uint_t accumulated = 0;
+
+    for(uint_t p=0; p<n_parts-1; ++p){
+
+        // the cumulative work the first p+1 partitions should carry
+        const uint_t target = (total_work*(p + 1))/n_parts;
+
+        while(row < n_rows && accumulated < target){
+            accumulated += matrix_row_work(matrix, row);
+            ++row;
+        }
+
+        partitions.push_back(range1d<uint_t>(start, row));
+        start = row;
+    }
+
+    partitions.push_back(range1d<uint_t>(start, n_rows));
+}
+
+}
+
+#endif // MATRIX_ROW_PARTITIONER_H
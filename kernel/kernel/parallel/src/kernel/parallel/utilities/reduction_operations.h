@@ -5,6 +5,7 @@
 
 #include <thread>
 #include <utility>
+#include <tuple>
 
 namespace kernel
 {
@@ -19,6 +20,9 @@ public:
     typedef typename ResultHolder<T>::result_type result_type;
     using ResultHolder<T>::ResultHolder;
 
+    /// \brief The value that leaves any other value unchanged when joined
+    static value_type identity(){return value_type();}
+
     /// \brief Join the given value to the given result
     static void local_join(const value_type& val, value_type& rslt){rslt += val;}
 
@@ -44,6 +48,45 @@ Sum<T>::join(const Sum<T>& other){
     this->get_resource() += other.get_resource();
 }
 
+/**
+ * Several reductions performed in one pass over the data.
+ * The value type is a std::tuple with the value types of the
+ * given operations. The I-th element of the tuple is joined
+ * using the I-th operation. For example the dot product and the
+ * squared norm needed by CG can be computed with FusedReduction<Sum<real_t>, Sum<real_t>>
+ */
+template<typename... OpTps>
+class FusedReduction: public ResultHolder<std::tuple<typename OpTps::value_type...>>
+{
+
+public:
+
+    typedef typename ResultHolder<std::tuple<typename OpTps::value_type...>>::value_type value_type;
+    typedef typename ResultHolder<std::tuple<typename OpTps::value_type...>>::result_type result_type;
+    using ResultHolder<std::tuple<typename OpTps::value_type...>>::ResultHolder;
+
+    /// \brief The number of fused operations
+    static constexpr uint_t n_operations(){return sizeof...(OpTps);}
+
+    /// \brief The value that leaves any other value unchanged when joined
+    static value_type identity(){return value_type(OpTps::identity()...);}
+
+    /// \brief Join the given value to the given result
+    static void local_join(const value_type& val, value_type& rslt){
+        local_join_(val, rslt, std::index_sequence_for<OpTps...>());
+    }
+
+    /// \brief Join the value with the result held
+    void join(const value_type& value){local_join(value, this->get_resource());}
+
+private:
+
+    template<std::size_t... I>
+    static void local_join_(const value_type& val, value_type& rslt, std::index_sequence<I...>){
+        (std::tuple_element_t<I, std::tuple<OpTps...>>::local_join(std::get<I>(val), std::get<I>(rslt)), ...);
+    }
+};
+
 }
 
 #endif // REDUCTION_OPERATIONS_H
@@ -0,0 +1,129 @@
+#include "kernel/base/types.h"
+#include "kernel/utilities/csv_data_reader.h"
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
+#include <gtest/gtest.h>
+
+namespace{
+
+using kernel::uint_t;
+using kernel::real_t;
+using kernel::DynMat;
+using kernel::DynVec;
+using kernel::CSVDataReader;
+using kernel::CSVDataReaderConfig;
+
+const std::string FILE_NAME = "test_csv_data_reader.csv";
+
+void write_file(const std::string& contents){
+
+    std::ofstream file(FILE_NAME);
+    file<<contents;
+}
+
+}
+
+TEST(TestCSVDataReader, TestReadWithHeader) {
+
+    /***
+       * Test Scenario:    The application reads a CSV file with header, spaces,
+       *                   a trailing empty line and Windows line endings
+       * Expected Output:  The last column is the labels and the header names
+       *                   map to the feature columns
+     **/
+
+    write_file("x, y ,label\r\n1.5,2,3\r\n-4e-1, +5 ,6\r\n\r\n7,8,9.25\r\n\n");
+
+    DynMat<real_t> features;
+    DynVec<real_t> labels;
+    std::map<std::string, uint_t> columns;
+
+    CSVDataReader reader(FILE_NAME);
+    reader.read(features, labels, columns);
+
+    ASSERT_EQ(features.rows(), 3);
+    ASSERT_EQ(features.columns(), 2);
+    ASSERT_EQ(labels.size(), 3);
+
+    ASSERT_DOUBLE_EQ(features(0, 0), 1.5);
+    ASSERT_DOUBLE_EQ(features(1, 0), -0.4);
+    ASSERT_DOUBLE_EQ(features(1, 1), 5.0);
+    ASSERT_DOUBLE_EQ(labels[2], 9.25);
+
+    ASSERT_EQ(columns.size(), 2);
+    ASSERT_EQ(columns["x"], 0);
+    ASSERT_EQ(columns["y"], 1);
+
+    std::remove(FILE_NAME.c_str());
+}
+
+TEST(TestCSVDataReader, TestLabelColumnAndThreads) {
+
+    /***
+       * Test Scenario:    The application reads a file without header with the
+       *                   labels in the first column using several threads
+       * Expected Output:  The data are the same as the ones written
+     **/
+
+    const uint_t n_rows = 1000;
+    std::string contents;
+
+    for(uint_t r=0; r<n_rows; ++r){
+        contents += std::to_string(r) + ";" + std::to_string(2*r) + ";" + std::to_string(0.5*r) + "\n";
+    }
+
+    write_file(contents);
+
+    CSVDataReaderConfig config;
+    config.delimiter = ';';
+    config.has_header = false;
+    config.label_column = 0;
+    config.n_threads = 4;
+
+    DynMat<real_t> features;
+    DynVec<real_t> labels;
+    std::map<std::string, uint_t> columns;
+
+    CSVDataReader reader(FILE_NAME, config);
+    reader.read(features, labels, columns);
+
+    ASSERT_EQ(features.rows(), n_rows);
+    ASSERT_EQ(features.columns(), 2);
+    ASSERT_TRUE(columns.empty());
+    ASSERT_EQ(reader.n_bytes(), contents.size());
+
+    for(uint_t r=0; r<n_rows; ++r){
+        ASSERT_DOUBLE_EQ(labels[r], r);
+        ASSERT_DOUBLE_EQ(features(r, 0), 2.0*r);
+        ASSERT_DOUBLE_EQ(features(r, 1), 0.5*r);
+    }
+
+    std::remove(FILE_NAME.c_str());
+}
+
+TEST(TestCSVDataReader, TestInvalidFiles) {
+
+    /***
+       * Test Scenario:    The application reads a missing file, a file with a
+       *                   missing column, an extra column and a non-numeric value
+       * Expected Output:  std::logic_error is thrown
+     **/
+
+    DynMat<real_t> features;
+    DynVec<real_t> labels;
+    std::map<std::string, uint_t> columns;
+
+    std::remove(FILE_NAME.c_str());
+    ASSERT_THROW(CSVDataReader(FILE_NAME).read(features, labels, columns), std::logic_error);
+
+    for(auto contents : {"a,b,c\n1,2\n", "a,b,c\n1,2,3,4\n", "a,b,c\n1,x,3\n"}){
+
+        write_file(contents);
+        ASSERT_THROW(CSVDataReader(FILE_NAME).read(features, labels, columns), std::logic_error);
+    }
+
+    std::remove(FILE_NAME.c_str());
+}
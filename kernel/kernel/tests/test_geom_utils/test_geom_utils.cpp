@@ -47,3 +47,22 @@ TEST(TestGeomUtils, TestFindPointOnLineAtDeltaDistance_False) {
 
 
 
+
+TEST(TestGeomUtils, TestCrossProduct) {
+
+    /***
+       * Test Scenario:   The application computes the cross product of two 3D and two 2D points
+       * Expected Output: The cross product is computed and 2D points are treated as lying on z = 0
+     **/
+
+    auto result = kernel::cross_product(kernel::GeomPoint<3>({1.0, 0.0, 0.0}), kernel::GeomPoint<3>({0.0, 1.0, 0.0}));
+    ASSERT_DOUBLE_EQ(result[0], 0.0);
+    ASSERT_DOUBLE_EQ(result[1], 0.0);
+    ASSERT_DOUBLE_EQ(result[2], 1.0);
+
+    result = kernel::cross_product(kernel::GeomPoint<2>({2.0, 0.0}), kernel::GeomPoint<2>({1.0, 3.0}));
+    ASSERT_DOUBLE_EQ(result[0], 0.0);
+    ASSERT_DOUBLE_EQ(result[1], 0.0);
+    ASSERT_DOUBLE_EQ(result[2], 6.0);
+    ASSERT_DOUBLE_EQ(result.L2_norm(), 6.0);
+}
@@ -0,0 +1,67 @@
+#include "kernel/base/types.h"
+#include "kernel/maths/lp_metric.h"
+#include "kernel/maths/matrix_traits.h"
+
+#include <gtest/gtest.h>
+
+namespace{
+
+using kernel::uint_t;
+using kernel::real_t;
+using kernel::DynVec;
+using kernel::DynMat;
+
+typedef kernel::matrix_row_trait<DynMat<real_t>> row_trait;
+
+/// \brief Assert that the metric gives the same value for
+/// the rows of the matrix and for copies of the rows
+template<typename MetricTp>
+void assert_views_match_copies(const DynMat<real_t>& matrix){
+
+    MetricTp metric;
+
+    for(uint_t r=0; r + 1<matrix.rows(); ++r){
+
+        const auto view1 = row_trait::get_row_view(matrix, r);
+        const auto view2 = row_trait::get_row_view(matrix, r + 1);
+
+        DynVec<real_t> copy1(matrix.columns());
+        DynVec<real_t> copy2(matrix.columns());
+
+        for(uint_t c=0; c<matrix.columns(); ++c){
+            copy1[c] = matrix(r, c);
+            copy2[c] = matrix(r + 1, c);
+        }
+
+        ASSERT_DOUBLE_EQ(metric(view1, view2), metric(copy1, copy2));
+        ASSERT_DOUBLE_EQ(metric(view1, copy2), metric(copy1, copy2));
+    }
+}
+
+}
+
+/***
+ * Test Scenario:   The application computes the Lp distance of matrix rows using views and copies
+ *                  for every power with and without taking the root
+ * Expected Output:	The views give the same distance as the copies
+ **/
+
+TEST(TestLpMetric, TestViewsMatchCopies) {
+
+    DynMat<real_t> matrix(4, 5);
+
+    for(uint_t r=0; r<matrix.rows(); ++r){
+        for(uint_t c=0; c<matrix.columns(); ++c){
+            matrix(r, c) = static_cast<real_t>((r + 1)*(c + 2) % 7) - 3.0;
+        }
+    }
+
+    assert_views_match_copies<kernel::LpMetric<1, true>>(matrix);
+    assert_views_match_copies<kernel::LpMetric<1, false>>(matrix);
+    assert_views_match_copies<kernel::LpMetric<2, true>>(matrix);
+    assert_views_match_copies<kernel::LpMetric<2, false>>(matrix);
+    assert_views_match_copies<kernel::LpMetric<3, true>>(matrix);
+    assert_views_match_copies<kernel::LpMetric<3, false>>(matrix);
+    assert_views_match_copies<kernel::LpMetric<4, true>>(matrix);
+    assert_views_match_copies<kernel::LpMetric<4, false>>(matrix);
+}
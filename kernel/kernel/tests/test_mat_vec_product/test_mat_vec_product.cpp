@@ -0,0 +1,226 @@
+#include "kernel/parallel/parallel_algos/linear_algebra/matrix_vector_product.h"
+#include "kernel/parallel/utilities/matrix_row_partitioner.h"
+#include "kernel/parallel/utilities/partitioned_type.h"
+#include "kernel/parallel/utilities/array_partitioner.h"
+#include "kernel/parallel/threading/thread_pool.h"
+#include "kernel/base/types.h"
+
+#include <vector>
+#include <algorithm>
+#include <gtest/gtest.h>
+
+namespace{
+
+using kernel::uint_t;
+using kernel::real_t;
+using kernel::range1d;
+
+using DenseMatrix = kernel::PartitionedType<kernel::DynMat<real_t>>;
+using SparseMatrix = kernel::PartitionedType<kernel::SparseMatrix<real_t>>;
+using Vector = kernel::DynVec<real_t>;
+
+const uint_t N_THREADS = 4;
+
+}
+
+/***
+ * Test Scenario:   The application partitions the rows of a sparse matrix where the first row is full
+ * Expected Output:	The first partition holds only the full row and the partitions cover all rows
+ **/
+
+TEST(TestMatVecProduct, TestPartitionRowsByNonZeros) {
+
+    const uint_t N = 40;
+    SparseMatrix mat(N, N);
+
+    for(uint_t c=0; c<N; ++c){
+        mat.set(0, c, 1.0);
+    }
+
+    for(uint_t r=1; r<N; ++r){
+        mat.set(r, r, 1.0);
+    }
+
+    std::vector<range1d<uint_t>> partitions;
+    kernel::partition_matrix_rows(mat, partitions, N_THREADS);
+
+    ASSERT_EQ(partitions.size(), N_THREADS);
+    ASSERT_EQ(partitions.front().begin(), 0);
+    ASSERT_EQ(partitions.front().end(), 1);
+    ASSERT_EQ(partitions.back().end(), N);
+
+    for(uint_t p=1; p<partitions.size(); ++p){
+        ASSERT_EQ(partitions[p].begin(), partitions[p-1].end());
+    }
+}
+
+/***
+ * Test Scenario:   The application computes the product of a dense non-symmetric matrix with a vector twice
+ * Expected Output:	Both executions give the serial result
+ **/
+
+TEST(TestMatVecProduct, TestDenseProduct) {
+
+    const uint_t N = 37;
+    DenseMatrix mat(N, N);
+    Vector x(N);
+
+    for(uint_t r=0; r<N; ++r){
+        x[r] = static_cast<real_t>(r + 1);
+        for(uint_t c=0; c<N; ++c){
+            mat(r, c) = static_cast<real_t>(r + 2*c);
+        }
+    }
+
+    std::vector<range1d<uint_t>> partitions;
+    kernel::partition_matrix_rows(mat, partitions, N_THREADS);
+    mat.set_partitions(partitions);
+
+    kernel::ThreadPool pool(N_THREADS);
+    kernel::MatVecProduct<DenseMatrix, Vector> product(mat, x);
+
+    product.execute(pool, kernel::Null());
+    product.reexecute(pool, kernel::Null());
+
+    const auto& result = product.get().get_resource();
+    ASSERT_EQ(result.size(), N);
+
+    for(uint_t r=0; r<N; ++r){
+
+        real_t expected = 0.0;
+        for(uint_t c=0; c<N; ++c){
+            expected += mat(r, c)*x[c];
+        }
+
+        ASSERT_DOUBLE_EQ(result[r], expected);
+    }
+}
+
+/***
+ * Test Scenario:   The application computes the product of a sparse non-symmetric matrix with a vector twice
+ * Expected Output:	Both executions give the serial result
+ **/
+
+TEST(TestMatVecProduct, TestSparseProduct) {
+
+    const uint_t N = 50;
+    SparseMatrix mat(N, N);
+    Vector x(N);
+
+    for(uint_t r=0; r<N; ++r){
+
+        x[r] = static_cast<real_t>(r + 1);
+        mat.set(r, r, 4.0);
+
+        if(r + 1 < N){
+            mat.set(r, r + 1, -1.0);
+        }
+
+        if(r >= 3){
+            mat.set(r, r - 3, -2.0);
+        }
+    }
+
+    std::vector<range1d<uint_t>> partitions;
+    kernel::partition_matrix_rows(mat, partitions, N_THREADS);
+    mat.set_partitions(partitions);
+
+    kernel::ThreadPool pool(N_THREADS);
+    kernel::MatVecProduct<SparseMatrix, Vector> product(mat, x);
+
+    product.execute(pool, kernel::Null());
+    product.reexecute(pool, kernel::Null());
+
+    const auto& result = product.get().get_resource();
+    ASSERT_EQ(result.size(), N);
+
+    for(uint_t r=0; r<N; ++r){
+
+        real_t expected = 4.0*x[r];
+
+        if(r + 1 < N){
+            expected -= x[r + 1];
+        }
+
+        if(r >= 3){
+            expected -= 2.0*x[r - 3];
+        }
+
+        ASSERT_DOUBLE_EQ(result[r], expected);
+    }
+}
+
+/***
+ * Test Scenario:   The application computes the product of a sparse matrix whose first rows are full
+ *                  while the matrix carries partitions with an equal number of rows
+ * Expected Output:	The tasks work on partitions balanced by the nonzeros and the result is the serial one
+ **/
+
+TEST(TestMatVecProduct, TestSkewedSparseProduct) {
+
+    const uint_t N = 64;
+    const uint_t N_FULL = 2;
+    SparseMatrix mat(N, N);
+    Vector x(N);
+
+    for(uint_t r=0; r<N; ++r){
+
+        x[r] = static_cast<real_t>(r + 1);
+
+        if(r < N_FULL){
+            for(uint_t c=0; c<N; ++c){
+                mat.set(r, c, 1.0);
+            }
+        }
+        else{
+            mat.set(r, r, 2.0);
+        }
+    }
+
+    std::vector<range1d<uint_t>> partitions;
+    kernel::partition_range(0, N, partitions, N_THREADS);
+    mat.set_partitions(partitions);
+
+    kernel::ThreadPool pool(N_THREADS);
+    kernel::MatVecProduct<SparseMatrix, Vector> product(mat, x);
+
+    product.execute(pool, kernel::Null());
+
+    const auto& rows = product.row_partitions();
+    ASSERT_EQ(rows.size(), N_THREADS);
+    ASSERT_EQ(rows.front().begin(), 0);
+    ASSERT_EQ(rows.back().end(), N);
+
+    // the full rows carry half of the nonzeros so
+    // they should not share a task with many other rows
+    ASSERT_LE(rows.front().end(), N_FULL);
+
+    uint_t max_work = 0;
+    uint_t total_work = 0;
+    for(const auto& range : rows){
+
+        ASSERT_LE(range.begin(), range.end());
+
+        uint_t work = 0;
+        for(uint_t r=range.begin(); r<range.end(); ++r){
+            work += kernel::matrix_row_work(mat, r);
+        }
+
+        max_work = std::max(max_work, work);
+        total_work += work;
+    }
+
+    // no task does more than one full row above the average
+    ASSERT_LE(max_work, total_work/N_THREADS + N + 1);
+
+    product.reexecute(pool, kernel::Null());
+
+    const auto& result = product.get().get_resource();
+    const real_t full_row = static_cast<real_t>(N*(N + 1))/2.0;
+
+    for(uint_t r=0; r<N; ++r){
+
+        const real_t expected = r < N_FULL ? full_row : 2.0*x[r];
+        ASSERT_DOUBLE_EQ(result[r], expected);
+    }
+}
@@ -163,6 +163,45 @@ TEST(TestParallelFor, RunWithIdentityBody) {
 }
 
 
+/***
+ * Test Scenario:   The application creates a parallel_for execution plan and executes it several times
+ * Expected Output:	The tasks are created once and the body is applied on the range at every execution
+ **/
+
+TEST(TestParallelFor, ExecutePlanManyTimes) {
+
+    using kernel::uint_t;
+    using kernel::OMPExecutor;
+    using kernel::range1d;
+    using kernel::PartitionedType;
+
+    OMPExecutor pool(4);
+
+    std::vector<range1d<uint_t>> partitions;
+    uint_t n_threads = pool.get_n_threads();
+    kernel::partition_range(0, 100, partitions, n_threads);
+
+    PartitionedType<std::vector<uint_t>> vector(100, 0);
+    vector.set_partitions(partitions);
+
+    auto body = [](uint_t& item){item += 1;};
+    auto plan = kernel::make_parallel_for_plan(vector, body, pool);
+
+    ASSERT_EQ(plan.n_tasks(), n_threads);
+
+    const uint_t n_executions = 3;
+    for(uint_t i=0; i<n_executions; ++i){
+        ASSERT_TRUE(plan.execute(kernel::OMPOptions()).get().second);
+    }
+
+    ASSERT_EQ(plan.n_executions(), n_executions);
+
+    for(auto item: vector){
+        ASSERT_EQ(item, n_executions);
+    }
+}
+
+
 #endif
 
 
@@ -0,0 +1,89 @@
+#include "kernel/parallel/parallel_algos/parallel_reduce.h"
+#include "kernel/parallel/utilities/reduction_operations.h"
+#include "kernel/parallel/utilities/partitioned_type.h"
+#include "kernel/parallel/utilities/array_partitioner.h"
+#include "kernel/parallel/threading/thread_pool.h"
+#include "kernel/base/types.h"
+
+#include <vector>
+#include <tuple>
+#include <gtest/gtest.h>
+
+namespace{
+
+using kernel::uint_t;
+using kernel::real_t;
+using kernel::range1d;
+using kernel::PartitionedType;
+using Vector = PartitionedType<std::vector<real_t>>;
+
+const uint_t N_THREADS = 4;
+const uint_t N = 1001;
+
+}
+
+/***
+ * Test Scenario:   The application attempts to execute parallel_reduce with a range that is not partitioned
+ * Expected Output:	parallel_reduce throws InvalidPartitionedObject
+ **/
+
+TEST(TestParallelReduce, RunWithNoPartitions) {
+
+    kernel::ThreadPool pool(N_THREADS);
+    Vector x(N, 1.0);
+
+    ASSERT_THROW(kernel::parallel_reduce(x, kernel::Sum<real_t>(), pool), kernel::InvalidPartitionedObject);
+}
+
+/***
+ * Test Scenario:   The application sums the elements of a partitioned vector
+ * Expected Output:	The result is valid and equal to the serial sum
+ **/
+
+TEST(TestParallelReduce, RunSum) {
+
+    kernel::ThreadPool pool(N_THREADS);
+
+    std::vector<range1d<uint_t>> partitions;
+    kernel::partition_range(0, N, partitions, pool.get_n_threads());
+
+    Vector x(N, 0.0);
+    x.set_partitions(partitions);
+
+    for(uint_t i=0; i<N; ++i){
+        x[i] = static_cast<real_t>(i);
+    }
+
+    auto result = kernel::parallel_reduce(x, kernel::Sum<real_t>(), pool);
+
+    ASSERT_TRUE(result.is_result_valid());
+    ASSERT_DOUBLE_EQ(result.get_resource(), static_cast<real_t>(N*(N - 1)/2));
+}
+
+/***
+ * Test Scenario:   The application computes the dot product of two vectors and the squared norm
+ *                  of the first vector in one pass using FusedReduction
+ * Expected Output:	Both results are equal to the serial results
+ **/
+
+TEST(TestParallelReduce, RunFusedDotProductAndNorm) {
+
+    kernel::ThreadPool pool(N_THREADS);
+
+    std::vector<range1d<uint_t>> partitions;
+    kernel::partition_range(0, N, partitions, pool.get_n_threads());
+
+    Vector x(N, 2.0);
+    x.set_partitions(partitions);
+
+    std::vector<real_t> y(N, 3.0);
+
+    typedef kernel::FusedReduction<kernel::Sum<real_t>, kernel::Sum<real_t>> reduction_type;
+
+    auto map = [&x, &y](uint_t i){return std::make_tuple(x[i]*y[i], x[i]*x[i]);};
+    auto result = kernel::parallel_reduce(x, map, reduction_type(), pool, kernel::Null());
+
+    ASSERT_TRUE(result.is_result_valid());
+    ASSERT_DOUBLE_EQ(std::get<0>(result.get_resource()), 6.0*N);
+    ASSERT_DOUBLE_EQ(std::get<1>(result.get_resource()), 4.0*N);
+}
@@ -0,0 +1,95 @@
+#include "kernel/parallel/data_structs/task_queue.h"
+#include "kernel/parallel/data_structs/lockable_queue.h"
+#include "kernel/base/types.h"
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <gtest/gtest.h>
+
+namespace{
+
+using kernel::uint_t;
+
+struct DummyTask{};
+
+}
+
+/***
+ * Test Scenario:   The application creates a lock-free TaskQueue with a capacity that is not a power of two
+ * Expected Output:	The capacity is rounded up to the next power of two and the queue is empty
+ **/
+
+TEST(TestTaskQueue, TestLockFreeCapacity) {
+
+    kernel::TaskQueue<DummyTask, kernel::LockFreeQueueImpl> queue(100);
+    ASSERT_EQ(queue.capacity(), 128);
+    ASSERT_TRUE(queue.empty());
+    ASSERT_EQ(queue.pop(), nullptr);
+}
+
+/***
+ * Test Scenario:   The application fills a lock-free TaskQueue
+ * Expected Output:	try_push_task fails when the queue is full and tasks are popped in FIFO order
+ **/
+
+TEST(TestTaskQueue, TestLockFreePushPop) {
+
+    std::vector<DummyTask> tasks(4);
+    kernel::TaskQueue<DummyTask, kernel::LockFreeQueueImpl> queue(4);
+
+    for(auto& task: tasks){
+        queue.push_task(task);
+    }
+
+    ASSERT_EQ(queue.size(), 4);
+    ASSERT_FALSE(queue.try_push_task(&tasks[0]));
+
+    for(auto& task: tasks){
+        DummyTask* popped = nullptr;
+        ASSERT_TRUE(queue.pop(popped));
+        ASSERT_EQ(popped, &task);
+    }
+
+    ASSERT_TRUE(queue.empty());
+}
+
+/***
+ * Test Scenario:   Many producers and consumers use a lock-free LockableQueue concurrently
+ * Expected Output:	Every item pushed is popped exactly once
+ **/
+
+TEST(TestTaskQueue, TestLockFreeMultipleProducersConsumers) {
+
+    const uint_t n_threads = 4;
+    const uint_t n_items = 10000;
+
+    kernel::LockableQueue<uint_t, kernel::LockFreeQueueImpl> queue(64);
+    std::atomic<uint_t> sum(0);
+    std::vector<std::thread> threads;
+
+    for(uint_t t=0; t<n_threads; ++t){
+        threads.emplace_back([&queue, n_items](){
+            for(uint_t i=1; i<=n_items; ++i){
+                queue.push_item(i);
+            }
+        });
+    }
+
+    for(uint_t t=0; t<n_threads; ++t){
+        threads.emplace_back([&queue, &sum, n_items](){
+            uint_t local = 0;
+            for(uint_t i=0; i<n_items; ++i){
+                local += queue.pop_wait();
+            }
+            sum += local;
+        });
+    }
+
+    for(auto& thread: threads){
+        thread.join();
+    }
+
+    ASSERT_EQ(sum.load(), n_threads*n_items*(n_items + 1)/2);
+    ASSERT_TRUE(queue.empty());
+}
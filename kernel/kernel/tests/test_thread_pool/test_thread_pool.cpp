@@ -0,0 +1,226 @@
+#include "kernel/parallel/threading/thread_pool.h"
+#include "kernel/parallel/threading/kernel_thread.h"
+#include "kernel/parallel/threading/count_down_latch.h"
+#include "kernel/parallel/threading/simple_task.h"
+#include "kernel/base/types.h"
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <gtest/gtest.h>
+
+namespace{
+
+using kernel::uint_t;
+
+class CountTask: public kernel::SimpleTaskBase<kernel::Null>
+{
+public:
+
+    CountTask(uint_t id, std::atomic<uint_t>& counter, uint_t sleep_ms)
+        :
+          kernel::SimpleTaskBase<kernel::Null>(id),
+          counter_(counter),
+          sleep_ms_(sleep_ms)
+    {}
+
+protected:
+
+    virtual void run()override final{
+
+        if(sleep_ms_ != 0){
+            std::this_thread::sleep_for(std::chrono::milliseconds(sleep_ms_));
+        }
+
+        counter_++;
+    }
+
+private:
+
+    std::atomic<uint_t>& counter_;
+    uint_t sleep_ms_;
+};
+
+/// Records the thread that ran it and when it finished
+class TimedTask: public kernel::SimpleTaskBase<kernel::Null>
+{
+public:
+
+    TimedTask(uint_t id, uint_t sleep_ms)
+        :
+          kernel::SimpleTaskBase<kernel::Null>(id),
+          sleep_ms_(sleep_ms)
+    {}
+
+    std::thread::id thread_id()const{return thread_id_;}
+    std::chrono::steady_clock::time_point finished()const{return finished_;}
+
+protected:
+
+    virtual void run()override final{
+
+        thread_id_ = std::this_thread::get_id();
+        std::this_thread::sleep_for(std::chrono::milliseconds(sleep_ms_));
+        finished_ = std::chrono::steady_clock::now();
+    }
+
+private:
+
+    uint_t sleep_ms_;
+    std::thread::id thread_id_;
+    std::chrono::steady_clock::time_point finished_;
+};
+
+}
+
+/***
+ * Test Scenario:   The application constructs a pool by specifying the number of threads
+ * Expected Output:	The pool uses the given number of threads and ROUND_ROBIN scheduling
+ **/
+
+TEST(TestThreadPool, TestNumberOfThreads) {
+
+    kernel::ThreadPool pool(4);
+    ASSERT_EQ(pool.get_n_threads(), 4);
+    ASSERT_TRUE(pool.get_schedule_type() == kernel::ThreadPoolOptions::ScheduleType::ROUND_ROBIN);
+}
+
+/***
+ * Test Scenario:   The application executes a list of tasks with ROUND_ROBIN scheduling
+ * Expected Output:	All tasks are executed
+ **/
+
+TEST(TestThreadPool, TestExecuteRoundRobin) {
+
+    kernel::ThreadPoolOptions options;
+    options.n_threads = 4;
+
+    kernel::ThreadPool pool(options);
+
+    std::atomic<uint_t> counter(0);
+    std::vector<std::unique_ptr<CountTask>> tasks;
+    for(uint_t t=0; t<32; ++t){
+        tasks.push_back(std::make_unique<CountTask>(t, counter, 0));
+    }
+
+    pool.execute(tasks, kernel::Null());
+    ASSERT_EQ(counter.load(), 32);
+}
+
+/***
+ * Test Scenario:   The application executes a list of tasks with WORK_STEALING scheduling
+ *                  where the first thread is assigned a long running task
+ * Expected Output:	All tasks are executed and the pending tasks are not left behind the slow task
+ **/
+
+TEST(TestThreadPool, TestExecuteWorkStealing) {
+
+    kernel::ThreadPoolOptions options;
+    options.n_threads = 4;
+    options.schedule = kernel::ThreadPoolOptions::ScheduleType::WORK_STEALING;
+
+    kernel::ThreadPool pool(options);
+    ASSERT_TRUE(pool.get_schedule_type() == kernel::ThreadPoolOptions::ScheduleType::WORK_STEALING);
+
+    std::atomic<uint_t> counter(0);
+    std::vector<std::unique_ptr<CountTask>> tasks;
+
+    // one slow task followed by many cheap ones
+    tasks.push_back(std::make_unique<CountTask>(0, counter, 50));
+    for(uint_t t=1; t<64; ++t){
+        tasks.push_back(std::make_unique<CountTask>(t, counter, 1));
+    }
+
+    pool.execute(tasks, kernel::Null());
+    ASSERT_EQ(counter.load(), 64);
+
+    for(const auto& task: tasks){
+        ASSERT_TRUE(task->get_state() == kernel::TaskBase::TaskState::FINISHED);
+    }
+}
+
+/***
+ * Test Scenario:   The application executes one slow task followed by many short
+ *                  tasks with WORK_STEALING scheduling
+ * Expected Output:	The thread running the slow task is seen as loaded so the short tasks
+ *                  are run by the other threads and all finish before the slow task
+ **/
+
+TEST(TestThreadPool, TestWorkStealingSlowTask) {
+
+    kernel::ThreadPoolOptions options;
+    options.n_threads = 4;
+    options.schedule = kernel::ThreadPoolOptions::ScheduleType::WORK_STEALING;
+
+    kernel::ThreadPool pool(options);
+
+    std::vector<std::unique_ptr<TimedTask>> tasks;
+    tasks.push_back(std::make_unique<TimedTask>(0, 500));
+    for(uint_t t=1; t<64; ++t){
+        tasks.push_back(std::make_unique<TimedTask>(t, 1));
+    }
+
+    pool.execute(tasks, kernel::Null());
+
+    const auto slow_thread = tasks[0]->thread_id();
+    const auto slow_finished = tasks[0]->finished();
+
+    for(uint_t t=1; t<tasks.size(); ++t){
+        ASSERT_TRUE(tasks[t]->get_state() == kernel::TaskBase::TaskState::FINISHED);
+        ASSERT_NE(tasks[t]->thread_id(), slow_thread);
+        ASSERT_TRUE(tasks[t]->finished() < slow_finished);
+    }
+}
+
+/***
+ * Test Scenario:   Two work stealing threads that block immediately when idle. The second
+ *                  thread is parked when tasks are queued behind a slow task of the first thread
+ * Expected Output:	The parked thread is woken up, steals the queued tasks and finishes
+ *                  them before the slow task
+ **/
+
+TEST(TestThreadPool, TestParkedThreadSteals) {
+
+    kernel::detail::kernel_thread first(0, 0);
+    kernel::detail::kernel_thread second(1, 0);
+
+    std::vector<kernel::detail::kernel_thread*> victims = {&first, &second};
+    first.set_victims(victims);
+    second.set_victims(victims);
+
+    first.start();
+    second.start();
+
+    std::vector<std::unique_ptr<TimedTask>> tasks;
+    tasks.push_back(std::make_unique<TimedTask>(0, 500));
+    for(uint_t t=1; t<16; ++t){
+        tasks.push_back(std::make_unique<TimedTask>(t, 1));
+    }
+
+    kernel::CountDownLatch latch(tasks.size());
+    for(auto& task : tasks){
+        task->set_completion_latch(&latch);
+    }
+
+    first.push_task(*tasks[0]);
+
+    // let the idle thread park
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_TRUE(first.is_parked() || second.is_parked());
+
+    for(uint_t t=1; t<tasks.size(); ++t){
+        first.push_task(*tasks[t]);
+    }
+
+    latch.wait();
+
+    for(uint_t t=1; t<tasks.size(); ++t){
+        ASSERT_NE(tasks[t]->thread_id(), tasks[0]->thread_id());
+        ASSERT_TRUE(tasks[t]->finished() < tasks[0]->finished());
+    }
+
+    first.stop();
+    second.stop();
+}
@@ -0,0 +1,335 @@
+#include "kernel/utilities/csv_data_reader.h"
+#include "kernel/base/config.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace kernel
+{
+
+namespace{
+
+///
+/// \brief Read-only memory mapping of a file
+///
+class MappedFile: private boost::noncopyable
+{
+public:
+
+    explicit MappedFile(const std::string& file_name)
+        :
+          data_(nullptr),
+          size_(0)
+    {
+        const int fd = ::open(file_name.c_str(), O_RDONLY);
+
+        if(fd < 0){
+            throw std::logic_error("Failed to open file: " + file_name);
+        }
+
+        struct stat info;
+        if(::fstat(fd, &info) != 0){
+            ::close(fd);
+            throw std::logic_error("Failed to read the size of file: " + file_name);
+        }
+
+        size_ = static_cast<uint_t>(info.st_size);
+
+        if(size_ != 0){
+
+            void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if(data == MAP_FAILED){
+                ::close(fd);
+                throw std::logic_error("Failed to map file: " + file_name);
+            }
+
+            // the file is read once from the start to the end
+            ::madvise(data, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(data);
+        }
+
+        // the mapping stays valid after the descriptor is closed
+        ::close(fd);
+    }
+
+    ~MappedFile(){
+
+        if(data_){
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+    }
+
+    const char* begin()const{return data_;}
+    const char* end()const{return data_ + size_;}
+    uint_t size()const{return size_;}
+
+private:
+
+    const char* data_;
+    uint_t size_;
+};
+
+/// \brief Returns the position after the newline that ends
+/// the line containing pos or end if there is no newline
+const char* next_line(const char* pos, const char* end){
+
+    const void* newline = std::memchr(pos, '\n', end - pos);
+    return newline ? static_cast<const char*>(newline) + 1 : end;
+}
+
+/// \brief Call op(line_begin, line_end) for every non-empty
+/// line of [begin, end). The line end excludes "\r\n"
+template<typename Op>
+void for_each_line(const char* begin, const char* end, const Op& op){
+
+    while(begin < end){
+
+        const char* next = next_line(begin, end);
+        const char* line_end = next[-1] == '\n' ? next - 1 : next;
+
+        if(line_end > begin && line_end[-1] == '\r'){
+            --line_end;
+        }
+
+        if(line_end > begin){
+            op(begin, line_end);
+        }
+
+        begin = next;
+    }
+}
+
+const char* skip_spaces(const char* pos, const char* end){
+
+    while(pos < end && (*pos == ' ' || *pos == '\t')){
+        ++pos;
+    }
+
+    return pos;
+}
+
+/// \brief Split the header into the trimmed column names
+std::vector<std::string> split_header(const char* begin, const char* end, char delimiter){
+
+    std::vector<std::string> names;
+
+    while(true){
+
+        const void* found = std::memchr(begin, delimiter, end - begin);
+        const char* name_end = found ? static_cast<const char*>(found) : end;
+
+        const char* first = skip_spaces(begin, name_end);
+        const char* last = name_end;
+
+        while(last > first && (last[-1] == ' ' || last[-1] == '\t')){
+            --last;
+        }
+
+        if(last - first >= 2 && *first == '"' && last[-1] == '"'){
+            ++first;
+            --last;
+        }
+
+        names.emplace_back(first, last);
+
+        if(!found){
+            break;
+        }
+
+        begin = name_end + 1;
+    }
+
+    return names;
+}
+
+}
+
+CSVDataReader::CSVDataReader(const std::string& file_name, const CSVDataReaderConfig& config)
+    :
+      file_name_(file_name),
+      config_(config),
+      n_bytes_(0)
+{}
+
+void
+CSVDataReader::read(DynMat<real_t>& features, DynVec<real_t>& labels,
+                    std::map<std::string, uint_t>& columns)const{
+
+    MappedFile file(file_name_);
+    n_bytes_ = file.size();
+
+    const char* data_begin = file.begin();
+    const char* data_end = file.end();
+
+    // the number of columns is given by the
+    // header or by the first non-empty line
+    std::vector<std::string> names;
+    uint_t n_columns = 0;
+
+    if(config_.has_header){
+
+        for(; data_begin < data_end && names.empty(); ){
+
+            const char* next = next_line(data_begin, data_end);
+            const char* line_end = next;
+
+            while(line_end > data_begin && (line_end[-1] == '\n' || line_end[-1] == '\r')){
+                --line_end;
+            }
+
+            if(line_end > data_begin){
+                names = split_header(data_begin, line_end, config_.delimiter);
+            }
+
+            data_begin = next;
+        }
+
+        n_columns = names.size();
+    }
+    else if(data_begin < data_end){
+
+        const char* line_end = next_line(data_begin, data_end);
+        n_columns = std::count(data_begin, line_end, config_.delimiter) + 1;
+    }
+
+    columns.clear();
+
+    if(n_columns == 0){
+
+        features.resize(0, 0);
+        labels.resize(0);
+        return;
+    }
+
+    if(n_columns < 2){
+        throw std::logic_error("The file " + file_name_ + " should have at least two columns");
+    }
+
+    const uint_t label_column = config_.label_column == KernelConsts::invalid_size_type() ? n_columns - 1 : config_.label_column;
+
+    if(label_column >= n_columns){
+        throw std::logic_error("Label column " + std::to_string(label_column) +
+                               " not in the range of the " + std::to_string(n_columns) + " columns");
+    }
+
+    for(uint_t c=0; c<names.size(); ++c){
+        if(c != label_column){
+            columns[names[c]] = c < label_column ? c : c - 1;
+        }
+    }
+
+    // split the data in chunks at line boundaries
+    const uint_t n_chunks = std::max<uint_t>(config_.n_threads, 1);
+    const uint_t n_data_bytes = data_end - data_begin;
+    std::vector<const char*> chunks(n_chunks + 1, data_end);
+    chunks[0] = data_begin;
+
+    for(uint_t c=1; c<n_chunks; ++c){
+
+        const char* start = std::max(chunks[c - 1], data_begin + (c*n_data_bytes)/n_chunks);
+        chunks[c] = start == data_begin ? start : next_line(start - 1, data_end);
+    }
+
+    // the first row of every chunk
+    std::vector<uint_t> first_row(n_chunks + 1, 0);
+
+#if defined(USE_OPENMP)
+#pragma omp parallel for num_threads(n_chunks) schedule(static, 1)
+#endif
+    for(uint_t c=0; c<n_chunks; ++c){
+
+        uint_t n_rows = 0;
+        for_each_line(chunks[c], chunks[c + 1], [&n_rows](const char*, const char*){++n_rows;});
+        first_row[c + 1] = n_rows;
+    }
+
+    for(uint_t c=0; c<n_chunks; ++c){
+        first_row[c + 1] += first_row[c];
+    }
+
+    features.resize(first_row[n_chunks], n_columns - 1, false);
+    labels.resize(first_row[n_chunks], false);
+
+    std::vector<std::exception_ptr> errors(n_chunks);
+    const char delimiter = config_.delimiter;
+
+#if defined(USE_OPENMP)
+#pragma omp parallel for num_threads(n_chunks) schedule(static, 1)
+#endif
+    for(uint_t c=0; c<n_chunks; ++c){
+
+        try{
+
+            uint_t row = first_row[c];
+
+            for_each_line(chunks[c], chunks[c + 1], [&](const char* pos, const char* end){
+
+                uint_t feature = 0;
+
+                for(uint_t col=0; col<n_columns; ++col){
+
+                    pos = skip_spaces(pos, end);
+
+                    if(pos < end && *pos == '+'){
+                        ++pos;
+                    }
+
+                    real_t value = 0.0;
+                    const auto [ptr, ec] = std::from_chars(pos, end, value);
+
+                    if(ec != std::errc()){
+                        throw std::logic_error("Invalid value at row " + std::to_string(row) +
+                                               " column " + std::to_string(col) + " of file " + file_name_);
+                    }
+
+                    pos = skip_spaces(ptr, end);
+
+                    if(col == label_column){
+                        labels[row] = value;
+                    }
+                    else{
+                        features(row, feature++) = value;
+                    }
+
+                    if(col + 1 < n_columns){
+
+                        if(pos == end || *pos != delimiter){
+                            throw std::logic_error("Row " + std::to_string(row) + " of file " + file_name_ +
+                                                   " has less than " + std::to_string(n_columns) + " columns");
+                        }
+
+                        ++pos;
+                    }
+                }
+
+                if(pos != end){
+                    throw std::logic_error("Row " + std::to_string(row) + " of file " + file_name_ +
+                                           " has more than " + std::to_string(n_columns) + " columns");
+                }
+
+                ++row;
+            });
+        }
+        catch(...){
+            errors[c] = std::current_exception();
+        }
+    }
+
+    for(auto& error : errors){
+        if(error){
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+}
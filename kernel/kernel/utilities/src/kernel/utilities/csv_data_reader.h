@@ -0,0 +1,101 @@
+#ifndef CSV_DATA_READER_H
+#define CSV_DATA_READER_H
+
+#include "kernel/base/types.h"
+#include "kernel/base/kernel_consts.h"
+
+#include <boost/noncopyable.hpp>
+#include <string>
+#include <vector>
+#include <map>
+
+namespace kernel
+{
+
+///
+/// \brief The CSVDataReaderConfig struct. Helper struct
+/// that wraps parameters to be passed to the CSVDataReader class
+///
+struct CSVDataReaderConfig
+{
+    ///
+    /// \brief delimiter. The column delimiter
+    ///
+    char delimiter{','};
+
+    ///
+    /// \brief has_header. If true the first line
+    /// holds the names of the columns
+    ///
+    bool has_header{true};
+
+    ///
+    /// \brief label_column. The column that holds the labels.
+    /// The default is the last column
+    ///
+    uint_t label_column{KernelConsts::invalid_size_type()};
+
+    ///
+    /// \brief n_threads. The number of threads that parse the
+    /// file. More than one thread requires OpenMP
+    ///
+    uint_t n_threads{1};
+};
+
+///
+/// \brief The CSVDataReader class. Reads a numeric CSV file
+/// into a feature matrix and a label vector. The file is memory
+/// mapped and parsed in place: the lines are found with memchr,
+/// which the C library vectorizes, and the numbers are parsed with
+/// std::from_chars directly into the preallocated matrix. No string
+/// is created except for the header. The file is split in chunks at
+/// line boundaries. The rows of the chunks are counted first so that
+/// the chunks can be parsed independently, in parallel if n_threads > 1.
+/// It can be used as the FileReader of BlazeRegressionDataset::load_from_file
+///
+class CSVDataReader: private boost::noncopyable
+{
+public:
+
+    ///
+    /// \brief Constructor
+    ///
+    CSVDataReader(const std::string& file_name,
+                  const CSVDataReaderConfig& config=CSVDataReaderConfig());
+
+    ///
+    /// \brief Read the file. The label column goes to labels and the
+    /// other columns to features. columns maps the header names of the
+    /// feature columns to the column index in features. Throws
+    /// std::logic_error if the file cannot be opened, if a line has a
+    /// wrong number of columns or if a value is not a number
+    ///
+    void read(DynMat<real_t>& features, DynVec<real_t>& labels,
+              std::map<std::string, uint_t>& columns)const;
+
+    ///
+    /// \brief The size of the file in bytes. Valid after read()
+    ///
+    uint_t n_bytes()const{return n_bytes_;}
+
+private:
+
+    ///
+    /// \brief The filename to read
+    ///
+    const std::string file_name_;
+
+    ///
+    /// \brief The configuration of the reader
+    ///
+    const CSVDataReaderConfig config_;
+
+    ///
+    /// \brief The size of the file in bytes
+    ///
+    mutable uint_t n_bytes_;
+};
+
+}
+
+#endif // CSV_DATA_READER_H
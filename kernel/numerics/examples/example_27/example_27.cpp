@@ -0,0 +1,189 @@
+/**
+ * Benchmark the CompiledMesh view. The FV Laplace operator y = A x with the
+ * Gauss gradient fluxes is applied once by walking the Element and
+ * FaceElement pointers of a Mesh<2>, the way FVLaplaceAssemblyPolicy
+ * visits the cells, and once over the contiguous arrays of a CompiledMesh<2>.
+ * Both compute the same result.
+ */
+
+#include "kernel/base/types.h"
+#include "kernel/base/kernel_consts.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/compiled_mesh.h"
+#include "kernel/discretization/quad_mesh_generation.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/face_element.h"
+#include "kernel/discretization/node.h"
+#include "kernel/discretization/dof.h"
+#include "kernel/discretization/dof_manager.h"
+#include "kernel/geometry/geom_point.h"
+
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+
+namespace  {
+
+using kernel::uint_t;
+using kernel::real_t;
+using kernel::GeomPoint;
+using kernel::KernelConsts;
+using kernel::numerics::Mesh;
+using kernel::numerics::CompiledMesh;
+using kernel::numerics::FVDoFManager;
+using kernel::numerics::DoF;
+
+const std::vector<uint_t> N_CELLS_PER_SIDE = {100, 300, 1000};
+const uint_t N_REPETITIONS = 5;
+
+struct Variable
+{
+    std::string_view name()const{return "u";}
+};
+
+/// \brief Apply the operator by walking the mesh pointers
+void apply(const Mesh<2>& mesh, const FVDoFManager<2>& dof_manager,
+           const std::vector<real_t>& x, std::vector<real_t>& y){
+
+    std::vector<DoF> cell_dofs;
+    std::vector<DoF> neigh_dofs;
+
+    for(auto itr = mesh.elements_begin(); itr != mesh.elements_end(); ++itr){
+
+        const auto* elem = *itr;
+        dof_manager.get_dofs(*elem, cell_dofs);
+
+        const uint_t row = cell_dofs[0].id;
+        real_t sum = 0.0;
+
+        for(uint_t f=0; f<elem->n_faces(); ++f){
+
+            const auto& face = elem->get_face(f);
+            const real_t flux = face.volume()/face.owner_neighbor_distance();
+
+            if(face.on_boundary()){
+                sum += flux*x[row];
+                continue;
+            }
+
+            const auto& neighbor = face.is_owner(elem->get_id()) ? face.get_neighbor() : face.get_owner();
+            dof_manager.get_dofs(neighbor, neigh_dofs);
+            sum += flux*(x[row] - x[neigh_dofs[0].id]);
+        }
+
+        y[row] = sum;
+    }
+}
+
+/// \brief Apply the operator over the compiled arrays
+void apply(const CompiledMesh<2>& mesh, const std::vector<real_t>& x, std::vector<real_t>& y){
+
+    const auto& offsets = mesh.element_face_offsets();
+    const auto& faces = mesh.element_faces();
+    const auto& neighbors = mesh.element_neighbors();
+    const auto& areas = mesh.face_areas();
+    const auto& distances = mesh.face_owner_neighbor_distances();
+    const auto& dofs = mesh.element_dofs();
+
+    for(uint_t e=0; e<mesh.n_elements(); ++e){
+
+        const uint_t row = dofs[e];
+        real_t sum = 0.0;
+
+        for(uint_t i=offsets[e]; i<offsets[e + 1]; ++i){
+
+            const real_t flux = areas[faces[i]]/distances[faces[i]];
+            const uint_t neighbor = neighbors[i];
+
+            sum += neighbor == KernelConsts::invalid_size_type() ? flux*x[row]
+                                                                 : flux*(x[row] - x[dofs[neighbor]]);
+        }
+
+        y[row] = sum;
+    }
+}
+
+template<typename FunctionTp>
+real_t
+measure(const FunctionTp& function){
+
+    // warm up
+    function();
+
+    auto start = std::chrono::steady_clock::now();
+
+    for(uint_t r=0; r<N_REPETITIONS; ++r){
+        function();
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<real_t> time = end - start;
+    return time.count()/N_REPETITIONS;
+}
+
+}
+
+int main(){
+
+    try{
+
+        std::cout<<std::setw(12)<<"cells"
+                 <<std::setw(16)<<"compile (s)"
+                 <<std::setw(16)<<"pointers (s)"
+                 <<std::setw(16)<<"compiled (s)"
+                 <<std::setw(12)<<"speed up"<<std::endl;
+
+        for(auto n : N_CELLS_PER_SIDE){
+
+            Mesh<2> mesh;
+            kernel::numerics::build_quad_mesh(mesh, n, n, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+
+            FVDoFManager<2> dof_manager;
+            dof_manager.distribute_dofs(mesh, Variable());
+
+            auto start = std::chrono::steady_clock::now();
+            CompiledMesh<2> compiled(mesh, dof_manager);
+            auto end = std::chrono::steady_clock::now();
+            std::chrono::duration<real_t> compile_time = end - start;
+
+            std::vector<real_t> x(dof_manager.n_dofs());
+            for(uint_t i=0; i<x.size(); ++i){
+                x[i] = std::sin(static_cast<real_t>(i));
+            }
+
+            std::vector<real_t> y1(x.size(), 0.0);
+            std::vector<real_t> y2(x.size(), 0.0);
+
+            auto pointer_time = measure([&](){apply(mesh, dof_manager, x, y1);});
+            auto compiled_time = measure([&](){apply(compiled, x, y2);});
+
+            real_t error = 0.0;
+            for(uint_t i=0; i<x.size(); ++i){
+                error = std::max(error, std::fabs(y1[i] - y2[i]));
+            }
+
+            if(error > 1.0e-10){
+                std::cout<<"The results differ by: "<<error<<std::endl;
+            }
+
+            std::cout<<std::setw(12)<<n*n
+                     <<std::setw(16)<<compile_time.count()
+                     <<std::setw(16)<<pointer_time
+                     <<std::setw(16)<<compiled_time
+                     <<std::setw(12)<<pointer_time/compiled_time<<std::endl;
+        }
+    }
+    catch(std::exception& e){
+
+        std::cerr<<e.what()<<std::endl;
+    }
+    catch(...){
+
+        std::cerr<<"Unknown exception occured"<<std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,191 @@
+/**
+ * Strong scaling of the threaded FV assembly. The Laplace and the
+ * convection systems are assembled on the same mesh with
+ * FVLaplaceAssemblyPolicyThreaded and FVConvectionAssemblyPolicyThreaded
+ * using 1 to 32 threads. Every task assembles the rows of the elements
+ * of its own range so the tasks do not synchronize.
+ */
+
+#include "kernel/base/config.h"
+
+#if  defined(USE_TRILINOS) && defined(USE_FVM)
+
+#include "kernel/base/types.h"
+#include "kernel/base/kernel_consts.h"
+#include "kernel/geometry/geom_point.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/quad_mesh_generation.h"
+#include "kernel/numerics/pdes/fv_scalar_system.h"
+#include "kernel/numerics/fvm/fv_laplace_assemble_policy_threaded.h"
+#include "kernel/numerics/fvm/fv_convection_assemble_policy_threaded.h"
+#include "kernel/numerics/fvm/fv_grad_factory.h"
+#include "kernel/numerics/fvm/fv_grad_types.h"
+#include "kernel/numerics/fvm/fv_interpolation_factory.h"
+#include "kernel/numerics/fvm/fv_interpolation_types.h"
+#include "kernel/numerics/fvm/fv_ud_interpolation.h"
+#include "kernel/numerics/trilinos_solution_policy.h"
+#include "kernel/numerics/scalar_dirichlet_bc_function.h"
+#include "kernel/maths/functions/numeric_scalar_function.h"
+#include "kernel/maths/functions/numeric_vector_function.h"
+#include "kernel/parallel/utilities/linear_mesh_partitioner.h"
+#include "kernel/parallel/threading/thread_pool.h"
+
+#include <chrono>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+
+namespace  {
+
+using kernel::uint_t;
+using kernel::real_t;
+using kernel::GeomPoint;
+using kernel::ThreadPool;
+using kernel::numerics::Mesh;
+using kernel::numerics::ScalarFVSystem;
+using kernel::numerics::TrilinosSolutionPolicy;
+using kernel::numerics::FVLaplaceAssemblyPolicyThreaded;
+using kernel::numerics::FVConvectionAssemblyPolicyThreaded;
+using kernel::numerics::ScalarDirichletBCFunc;
+
+const uint_t N_CELLS_PER_SIDE = 1000;
+const std::vector<uint_t> N_THREADS = {1, 2, 4, 8, 16, 32};
+const uint_t N_REPETITIONS = 5;
+
+class RhsVals: public kernel::numerics::NumericScalarFunction<2>
+{
+public:
+
+    virtual real_t value(const GeomPoint<2>& /*input*/)const override final{return 1.0;}
+};
+
+class VelocityVals: public kernel::numerics::NumericVectorFunctionBase<2>
+{
+public:
+
+    virtual kernel::DynVec<real_t> value(const GeomPoint<2>& /*input*/)const override final
+    {return kernel::DynVec<real_t>(2, 1.0);}
+};
+
+template<typename SystemTp>
+real_t
+measure(SystemTp& system){
+
+    // the first assembly creates the matrix pattern
+    system.assemble_system();
+
+    auto start = std::chrono::steady_clock::now();
+
+    for(uint_t r=0; r<N_REPETITIONS; ++r){
+        system.assemble_system();
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<real_t> time = end - start;
+    return time.count()/N_REPETITIONS;
+}
+
+real_t
+laplace(Mesh<2>& mesh, ThreadPool& executor){
+
+    ScalarDirichletBCFunc<2> bc_func(0.0, mesh.n_boundaries());
+    RhsVals rhs;
+
+    ScalarFVSystem<2, FVLaplaceAssemblyPolicyThreaded<2, ThreadPool>, TrilinosSolutionPolicy> system("Laplace", "U", mesh);
+    system.set_boundary_function(bc_func);
+    system.set_rhs_function(rhs);
+
+    system.get_assembly_policy().build_gradient([](){
+        return kernel::numerics::FVGradFactory<2>::build(kernel::numerics::FVGradType::GAUSS);
+    });
+
+    system.get_assembly_policy().set_executor(executor);
+    system.distribute_dofs();
+
+    return measure(system);
+}
+
+real_t
+convection(Mesh<2>& mesh, ThreadPool& executor){
+
+    ScalarDirichletBCFunc<2> bc_func(0.0, mesh.n_boundaries());
+    RhsVals rhs;
+    VelocityVals velocity;
+
+    ScalarFVSystem<2, FVConvectionAssemblyPolicyThreaded<2, ThreadPool>, TrilinosSolutionPolicy> system("Convection", "U", mesh);
+    system.set_boundary_function(bc_func);
+    system.set_rhs_function(rhs);
+
+    system.get_assembly_policy().build_interpolate_scheme([](){
+        return kernel::numerics::FVInterpolationFactory<2>::build(kernel::numerics::FVInterpolationType::UD);
+    });
+
+    auto interpolation = system.get_assembly_policy().get_interpolation();
+    dynamic_cast<kernel::numerics::FVUDInterpolate<2>*>(interpolation.get())->set_velocity(velocity);
+
+    system.get_assembly_policy().set_executor(executor);
+    system.distribute_dofs();
+
+    return measure(system);
+}
+
+}
+
+int main(){
+
+    try{
+
+        Mesh<2> mesh;
+        kernel::numerics::build_quad_mesh(mesh, N_CELLS_PER_SIDE, N_CELLS_PER_SIDE,
+                                          GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+
+        std::cout<<"Number of elements: "<<mesh.n_elements()<<std::endl;
+        std::cout<<std::setw(10)<<"threads"
+                 <<std::setw(16)<<"laplace (s)"
+                 <<std::setw(12)<<"speed up"
+                 <<std::setw(18)<<"convection (s)"
+                 <<std::setw(12)<<"speed up"<<std::endl;
+
+        real_t laplace_serial = 0.0;
+        real_t convection_serial = 0.0;
+
+        for(auto n_threads : N_THREADS){
+
+            ThreadPool executor(n_threads);
+            kernel::numerics::linear_mesh_partition(mesh, n_threads);
+
+            auto laplace_time = laplace(mesh, executor);
+            auto convection_time = convection(mesh, executor);
+
+            if(n_threads == 1){
+                laplace_serial = laplace_time;
+                convection_serial = convection_time;
+            }
+
+            std::cout<<std::setw(10)<<n_threads
+                     <<std::setw(16)<<laplace_time
+                     <<std::setw(12)<<laplace_serial/laplace_time
+                     <<std::setw(18)<<convection_time
+                     <<std::setw(12)<<convection_serial/convection_time<<std::endl;
+        }
+    }
+    catch(std::exception& e){
+
+        std::cerr<<e.what()<<std::endl;
+    }
+    catch(...){
+
+        std::cerr<<"Unknown exception occured"<<std::endl;
+    }
+
+    return 0;
+}
+
+#else
+
+#include <iostream>
+int main(){
+    std::cout<<"This example requires Trilinos. Reconfigure kernellib such that it uses Trilinos"<<std::endl;
+    return 0;
+}
+#endif
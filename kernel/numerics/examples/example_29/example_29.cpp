@@ -0,0 +1,261 @@
+/**
+ * Effect of the mesh numbering on the FV Laplace system. A generated quad
+ * mesh and a copy with shuffled elements, which mimics the arbitrary order
+ * of an imported mesh, are renumbered with RCM, Hilbert and Morton orders.
+ * For every numbering the bandwidth of the matrix and the time of a
+ * Jacobi preconditioned CG solve over the CSR matrix are reported.
+ */
+
+#include "kernel/base/types.h"
+#include "kernel/base/kernel_consts.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/mesh_renumbering.h"
+#include "kernel/discretization/compiled_mesh.h"
+#include "kernel/discretization/quad_mesh_generation.h"
+#include "kernel/discretization/dof_manager.h"
+#include "kernel/geometry/geom_point.h"
+
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <numeric>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+
+namespace  {
+
+using kernel::uint_t;
+using kernel::real_t;
+using kernel::GeomPoint;
+using kernel::KernelConsts;
+using kernel::numerics::Mesh;
+using kernel::numerics::CompiledMesh;
+using kernel::numerics::FVDoFManager;
+using kernel::numerics::MeshRenumberingType;
+
+const uint_t N_CELLS_PER_SIDE = 500;
+const uint_t MAX_ITRS = 2000;
+const real_t TOLERANCE = 1.0e-8;
+
+struct Variable
+{
+    std::string_view name()const{return "u";}
+};
+
+struct CSRMatrix
+{
+    std::vector<uint_t> row_ptr;
+    std::vector<uint_t> columns;
+    std::vector<real_t> values;
+};
+
+/// \brief Assemble the FV Laplace matrix with
+/// zero Dirichlet conditions on all boundaries
+void assemble(const CompiledMesh<2>& mesh, CSRMatrix& matrix){
+
+    const uint_t n = mesh.n_elements();
+
+    matrix.row_ptr.assign(n + 1, 0);
+    matrix.columns.clear();
+    matrix.values.clear();
+
+    std::vector<uint_t> element_of_dof(n);
+    for(uint_t e=0; e<n; ++e){
+        element_of_dof[mesh.element_dof(e)] = e;
+    }
+
+    for(uint_t row=0; row<n; ++row){
+
+        const uint_t e = element_of_dof[row];
+        const uint_t diagonal = matrix.values.size();
+
+        matrix.columns.push_back(row);
+        matrix.values.push_back(0.0);
+
+        for(uint_t f=0; f<mesh.n_element_faces(e); ++f){
+
+            const uint_t face = mesh.element_face(e, f);
+            const real_t flux = mesh.face_area(face)/mesh.face_owner_neighbor_distance(face);
+            const uint_t neighbor = mesh.element_neighbor(e, f);
+
+            matrix.values[diagonal] += flux;
+
+            if(neighbor != KernelConsts::invalid_size_type()){
+                matrix.columns.push_back(mesh.element_dof(neighbor));
+                matrix.values.push_back(-flux);
+            }
+        }
+
+        matrix.row_ptr[row + 1] = matrix.values.size();
+    }
+}
+
+void multiply(const CSRMatrix& matrix, const std::vector<real_t>& x, std::vector<real_t>& y){
+
+    for(uint_t r=0; r<y.size(); ++r){
+
+        real_t sum = 0.0;
+        for(uint_t i=matrix.row_ptr[r]; i<matrix.row_ptr[r + 1]; ++i){
+            sum += matrix.values[i]*x[matrix.columns[i]];
+        }
+
+        y[r] = sum;
+    }
+}
+
+real_t dot(const std::vector<real_t>& a, const std::vector<real_t>& b){
+    return std::inner_product(a.begin(), a.end(), b.begin(), 0.0);
+}
+
+/// \brief Jacobi preconditioned CG. Returns the number of iterations
+uint_t solve(const CSRMatrix& matrix, const std::vector<real_t>& b, std::vector<real_t>& x){
+
+    const uint_t n = b.size();
+
+    std::vector<real_t> inv_diagonal(n);
+    for(uint_t r=0; r<n; ++r){
+        inv_diagonal[r] = 1.0/matrix.values[matrix.row_ptr[r]];
+    }
+
+    x.assign(n, 0.0);
+    std::vector<real_t> r(b);
+    std::vector<real_t> z(n);
+    std::vector<real_t> p(n);
+    std::vector<real_t> q(n);
+
+    for(uint_t i=0; i<n; ++i){
+        z[i] = inv_diagonal[i]*r[i];
+    }
+
+    p = z;
+    real_t rz = dot(r, z);
+    const real_t b_norm = std::sqrt(dot(b, b));
+
+    uint_t itr = 0;
+    for(; itr<MAX_ITRS; ++itr){
+
+        multiply(matrix, p, q);
+        const real_t alpha = rz/dot(p, q);
+
+        for(uint_t i=0; i<n; ++i){
+            x[i] += alpha*p[i];
+            r[i] -= alpha*q[i];
+        }
+
+        if(std::sqrt(dot(r, r)) < TOLERANCE*b_norm){
+            break;
+        }
+
+        for(uint_t i=0; i<n; ++i){
+            z[i] = inv_diagonal[i]*r[i];
+        }
+
+        const real_t rz_new = dot(r, z);
+        const real_t beta = rz_new/rz;
+        rz = rz_new;
+
+        for(uint_t i=0; i<n; ++i){
+            p[i] = z[i] + beta*p[i];
+        }
+    }
+
+    return itr;
+}
+
+void build_mesh(Mesh<2>& mesh, bool shuffle){
+
+    kernel::numerics::build_quad_mesh(mesh, N_CELLS_PER_SIDE, N_CELLS_PER_SIDE,
+                                      GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+
+    if(shuffle){
+
+        std::vector<uint_t> order(mesh.n_elements());
+        std::iota(order.begin(), order.end(), 0);
+        std::shuffle(order.begin(), order.end(), std::mt19937(42));
+        mesh.topology()->renumber_elements(order);
+    }
+}
+
+void run(const std::string& mesh_name, bool shuffle, const std::string& numbering_name,
+         const MeshRenumberingType* type){
+
+    Mesh<2> mesh;
+    build_mesh(mesh, shuffle);
+
+    auto start = std::chrono::steady_clock::now();
+    if(type){
+        kernel::numerics::renumber_mesh(mesh, *type);
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<real_t> renumber_time = end - start;
+
+    FVDoFManager<2> dof_manager;
+    dof_manager.distribute_dofs(mesh, Variable());
+
+    CompiledMesh<2> compiled(mesh, dof_manager);
+
+    CSRMatrix matrix;
+    assemble(compiled, matrix);
+
+    std::vector<real_t> b(dof_manager.n_dofs());
+    for(uint_t e=0; e<compiled.n_elements(); ++e){
+        b[compiled.element_dof(e)] = compiled.element_volume(e);
+    }
+
+    std::vector<real_t> x;
+
+    start = std::chrono::steady_clock::now();
+    auto n_itrs = solve(matrix, b, x);
+    end = std::chrono::steady_clock::now();
+    std::chrono::duration<real_t> solve_time = end - start;
+
+    std::cout<<std::setw(12)<<mesh_name
+             <<std::setw(12)<<numbering_name
+             <<std::setw(12)<<kernel::numerics::element_bandwidth(mesh)
+             <<std::setw(16)<<renumber_time.count()
+             <<std::setw(12)<<n_itrs
+             <<std::setw(14)<<solve_time.count()<<std::endl;
+}
+
+}
+
+int main(){
+
+    try{
+
+        std::cout<<"Number of elements: "<<N_CELLS_PER_SIDE*N_CELLS_PER_SIDE<<std::endl;
+        std::cout<<std::setw(12)<<"mesh"
+                 <<std::setw(12)<<"numbering"
+                 <<std::setw(12)<<"bandwidth"
+                 <<std::setw(16)<<"renumber (s)"
+                 <<std::setw(12)<<"iterations"
+                 <<std::setw(14)<<"solve (s)"<<std::endl;
+
+        const MeshRenumberingType rcm = MeshRenumberingType::RCM;
+        const MeshRenumberingType hilbert = MeshRenumberingType::HILBERT;
+        const MeshRenumberingType morton = MeshRenumberingType::MORTON;
+
+        for(auto shuffle : {false, true}){
+
+            const std::string mesh_name = shuffle ? "shuffled" : "generated";
+
+            run(mesh_name, shuffle, "none", nullptr);
+            run(mesh_name, shuffle, "rcm", &rcm);
+            run(mesh_name, shuffle, "hilbert", &hilbert);
+            run(mesh_name, shuffle, "morton", &morton);
+        }
+    }
+    catch(std::exception& e){
+
+        std::cerr<<e.what()<<std::endl;
+    }
+    catch(...){
+
+        std::cerr<<"Unknown exception occured"<<std::endl;
+    }
+
+    return 0;
+}
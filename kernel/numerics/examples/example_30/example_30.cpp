@@ -0,0 +1,134 @@
+/**
+ * Quality of the mesh partition. A generated quad mesh and a copy with
+ * shuffled elements, which mimics the arbitrary order of an imported mesh,
+ * are partitioned with linear_mesh_partition and with the multilevel
+ * graph_mesh_partition. For every number of parts the edge cut, i.e. the
+ * number of faces shared by elements of different parts, the imbalance
+ * and the partition time are reported. The edge cut is the number of
+ * ghost values exchanged per halo update in a distributed solve.
+ */
+
+#include "kernel/base/types.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/element_mesh_iterator.h"
+#include "kernel/discretization/mesh_predicates.h"
+#include "kernel/discretization/quad_mesh_generation.h"
+#include "kernel/parallel/utilities/linear_mesh_partitioner.h"
+#include "kernel/parallel/utilities/graph_mesh_partitioner.h"
+#include "kernel/parallel/utilities/graph_partitioner.h"
+#include "kernel/geometry/geom_point.h"
+
+#include <chrono>
+#include <random>
+#include <numeric>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+
+namespace  {
+
+using kernel::uint_t;
+using kernel::real_t;
+using kernel::GeomPoint;
+using kernel::GraphPartitioner;
+using kernel::GraphPartitionInfo;
+using kernel::numerics::Mesh;
+using kernel::numerics::Element;
+using kernel::numerics::ConstElementMeshIterator;
+using kernel::numerics::Active;
+
+const uint_t N_CELLS_PER_SIDE = 500;
+
+void build_mesh(Mesh<2>& mesh, bool shuffle){
+
+    kernel::numerics::build_quad_mesh(mesh, N_CELLS_PER_SIDE, N_CELLS_PER_SIDE,
+                                      GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+
+    if(shuffle){
+
+        std::vector<uint_t> order(mesh.n_elements());
+        std::iota(order.begin(), order.end(), 0);
+        std::shuffle(order.begin(), order.end(), std::mt19937(42));
+        mesh.topology()->renumber_elements(order);
+    }
+}
+
+/// \brief Compute the partition information from the element pids
+GraphPartitionInfo mesh_partition_info(const Mesh<2>& mesh, uint_t n_parts){
+
+    std::vector<const Element<2>*> elements;
+    std::vector<uint_t> xadj;
+    std::vector<uint_t> adjncy;
+    kernel::numerics::element_adjacency_graph(mesh, elements, xadj, adjncy);
+
+    std::vector<uint_t> parts(elements.size());
+    for(uint_t e=0; e<elements.size(); ++e){
+        parts[e] = elements[e]->get_pid();
+    }
+
+    return GraphPartitioner::partition_info(xadj, adjncy, n_parts, parts);
+}
+
+void run(Mesh<2>& mesh, const std::string& mesh_name, const std::string& partitioner_name, uint_t n_parts){
+
+    auto start = std::chrono::steady_clock::now();
+    if(partitioner_name == "linear"){
+        kernel::numerics::linear_mesh_partition(mesh, n_parts);
+    }
+    else{
+        kernel::numerics::graph_mesh_partition(mesh, n_parts);
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<real_t> time = end - start;
+
+    auto info = mesh_partition_info(mesh, n_parts);
+
+    std::cout<<std::setw(12)<<mesh_name
+             <<std::setw(12)<<partitioner_name
+             <<std::setw(8)<<n_parts
+             <<std::setw(12)<<info.edge_cut
+             <<std::setw(12)<<info.imbalance
+             <<std::setw(12)<<time.count()<<std::endl;
+}
+
+}
+
+int main(){
+
+    try{
+
+        std::cout<<"Number of elements: "<<N_CELLS_PER_SIDE*N_CELLS_PER_SIDE<<std::endl;
+        std::cout<<std::setw(12)<<"mesh"
+                 <<std::setw(12)<<"partitioner"
+                 <<std::setw(8)<<"parts"
+                 <<std::setw(12)<<"edge cut"
+                 <<std::setw(12)<<"imbalance"
+                 <<std::setw(12)<<"time (s)"<<std::endl;
+
+        for(auto shuffle : {false, true}){
+
+            const std::string mesh_name = shuffle ? "shuffled" : "generated";
+
+            Mesh<2> mesh;
+            build_mesh(mesh, shuffle);
+
+            for(uint_t n_parts : {4, 16, 64}){
+                run(mesh, mesh_name, "linear", n_parts);
+                run(mesh, mesh_name, "graph", n_parts);
+            }
+        }
+    }
+    catch(std::exception& e){
+
+        std::cerr<<e.what()<<std::endl;
+    }
+    catch(...){
+
+        std::cerr<<"Unknown exception occured"<<std::endl;
+    }
+
+    return 0;
+}
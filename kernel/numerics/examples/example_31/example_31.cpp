@@ -0,0 +1,335 @@
+/**
+ * Matrix-free vs assembled transient FV Laplace. The heat equation with
+ * unit source and zero Dirichlet conditions is advanced with backward
+ * Euler. The assembled mode rebuilds the CSR matrix on every time step as
+ * the FV systems do. The matrix-free mode assembles the face coefficients
+ * of FVMatrixFreeOperator once and only the rhs is assembled per step.
+ * Both modes solve with Jacobi preconditioned CG. The memory of the
+ * operator and the time per step are reported for several time steps.
+ */
+
+#include "kernel/base/config.h"
+
+#ifdef USE_FVM
+
+#include "kernel/base/types.h"
+#include "kernel/base/kernel_consts.h"
+#include "kernel/geometry/geom_point.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/face_element.h"
+#include "kernel/discretization/element_mesh_iterator.h"
+#include "kernel/discretization/mesh_predicates.h"
+#include "kernel/discretization/quad_mesh_generation.h"
+#include "kernel/discretization/dof_manager.h"
+#include "kernel/numerics/fvm/fv_matrix_free_operator.h"
+#include "kernel/numerics/fvm/fv_laplace_assemble_policy.h"
+#include "kernel/numerics/fvm/fv_gauss_grad.h"
+#include "kernel/numerics/fvm/fv_grad_factory.h"
+#include "kernel/numerics/fvm/fv_grad_types.h"
+#include "kernel/numerics/backward_euler_fv_time_assembly_policy.h"
+#include "kernel/numerics/scalar_dirichlet_bc_function.h"
+#include "kernel/numerics/krylov_solvers/matrix_free_krylov_solver.h"
+#include "kernel/numerics/krylov_solvers/krylov_solver_data.h"
+#include "kernel/maths/functions/numeric_scalar_function.h"
+
+#include <chrono>
+#include <string_view>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+
+namespace  {
+
+using kernel::uint_t;
+using kernel::real_t;
+using kernel::DynVec;
+using kernel::GeomPoint;
+using kernel::numerics::Mesh;
+using kernel::numerics::DoF;
+using kernel::numerics::FVDoFManager;
+using kernel::numerics::FVGaussGrad;
+using kernel::numerics::FVMatrixFreeOperator;
+using kernel::numerics::FVMatrixFreeVector;
+using kernel::numerics::FVLaplaceAssemblyPolicy;
+using kernel::numerics::BackwardEulerFVTimeAssemblyPolicy;
+using kernel::numerics::ScalarDirichletBCFunc;
+using kernel::numerics::MatrixFreeKrylovSolver;
+using kernel::numerics::KrylovSolverData;
+using kernel::numerics::KrylovSolverType;
+using kernel::numerics::PreconditionerType;
+using kernel::numerics::ConstElementMeshIterator;
+using kernel::numerics::Active;
+
+const uint_t N_CELLS_PER_SIDE = 300;
+const uint_t N_STEPS = 20;
+const std::vector<real_t> TIME_STEPS = {1.0e-5, 1.0e-4, 1.0e-3};
+
+struct Variable
+{
+    std::string_view name()const{return "u";}
+};
+
+class BCFunc: public ScalarDirichletBCFunc<2>
+{
+public:
+
+    BCFunc(uint_t n_boundaries)
+        :
+          ScalarDirichletBCFunc<2>(0.0, n_boundaries)
+    {}
+
+    using ScalarDirichletBCFunc<2>::value;
+    virtual real_t value(uint_t /*i*/, const GeomPoint<2>& /*input*/)const override final{return 0.0;}
+    virtual DynVec<real_t> coeffs()const override final{return DynVec<real_t>();}
+    virtual void update_coeffs(const DynVec<real_t>& /*params*/)override final{}
+};
+
+class RhsVals: public kernel::numerics::NumericScalarFunction<2>
+{
+public:
+
+    virtual real_t value(const GeomPoint<2>& /*input*/)const override final{return 1.0;}
+    virtual real_t value(uint_t /*i*/, const GeomPoint<2>& /*input*/)const override final{return 1.0;}
+    virtual DynVec<real_t> coeffs()const override final{return DynVec<real_t>();}
+    virtual void update_coeffs(const DynVec<real_t>& /*params*/)override final{}
+};
+
+/// \brief CSR matrix with the
+/// interface the Krylov solver needs
+struct CSRMatrix
+{
+    typedef FVMatrixFreeVector vector_t;
+
+    std::vector<uint_t> row_ptr;
+    std::vector<uint_t> columns;
+    std::vector<real_t> values;
+
+    uint_t m()const{return row_ptr.size() - 1;}
+
+    template<typename VectorType>
+    void apply(const VectorType& x, VectorType& y)const{
+
+        for(uint_t r=0; r<m(); ++r){
+
+            real_t sum = 0.0;
+            for(uint_t i=row_ptr[r]; i<row_ptr[r + 1]; ++i){
+                sum += values[i]*x[columns[i]];
+            }
+
+            y[r] = sum;
+        }
+    }
+
+    template<typename VectorType>
+    void diagonal(VectorType& d)const{
+
+        // the diagonal is the first entry of every row
+        for(uint_t r=0; r<m(); ++r){
+            d[r] = values[row_ptr[r]];
+        }
+    }
+
+    uint_t memory_usage()const{
+        return sizeof(uint_t)*(row_ptr.capacity() + columns.capacity()) + sizeof(real_t)*values.capacity();
+    }
+};
+
+/// \brief Assemble the backward Euler system of the
+/// heat equation as the assembled FV systems do
+void assemble(const Mesh<2>& mesh, const FVDoFManager<2>& dof_manager, real_t dt,
+              const FVMatrixFreeVector& old_solution, CSRMatrix& matrix, FVMatrixFreeVector& b){
+
+    const uint_t n = dof_manager.n_dofs();
+
+    matrix.row_ptr.assign(n + 1, 0);
+    matrix.columns.clear();
+    matrix.values.clear();
+    b.zero();
+
+    FVGaussGrad<2> grads;
+    std::vector<real_t> fluxes;
+    std::vector<DoF> dofs;
+
+    ConstElementMeshIterator<Active, Mesh<2>> filter(mesh);
+    for(auto itr = filter.begin(); itr != filter.end(); ++itr){
+
+        auto* element = *itr;
+
+        dof_manager.get_dofs(*element, dofs);
+        const uint_t row = dofs[0].id;
+        const real_t volume = element->volume();
+
+        grads.compute_gradients(*element, fluxes);
+
+        const uint_t diagonal = matrix.values.size();
+        matrix.columns.push_back(row);
+        matrix.values.push_back(volume/dt);
+
+        for(uint_t f=0; f<element->n_faces(); ++f){
+
+            matrix.values[diagonal] += fluxes[f];
+
+            if(!element->get_face(f).on_boundary()){
+
+                dof_manager.get_dofs(*element->neighbor_ptr(f), dofs);
+                matrix.columns.push_back(dofs[0].id);
+                matrix.values.push_back(-fluxes[f]);
+            }
+        }
+
+        b[row] = volume + old_solution[row]*volume/dt;
+        matrix.row_ptr[row + 1] = matrix.values.size() - diagonal;
+    }
+
+    // the rows are stored in the order of the elements
+    // which is the order of the dofs
+    for(uint_t r=0; r<n; ++r){
+        matrix.row_ptr[r + 1] += matrix.row_ptr[r];
+    }
+}
+
+KrylovSolverData solver_data(){
+
+    KrylovSolverData data;
+    data.n_iterations = 1000;
+    data.tolerance = 1.0e-8;
+    data.solver_type = KrylovSolverType::CG;
+    data.precondioner_type = PreconditionerType::JACOBI;
+    return data;
+}
+
+void run(const Mesh<2>& mesh, const FVDoFManager<2>& dof_manager, real_t dt){
+
+    const uint_t n = dof_manager.n_dofs();
+
+    // assembled mode
+    real_t assembled_time = 0.0;
+    uint_t assembled_memory = 0;
+    {
+        CSRMatrix matrix;
+        MatrixFreeKrylovSolver<CSRMatrix> solver(solver_data());
+
+        FVMatrixFreeVector x;
+        FVMatrixFreeVector b;
+        FVMatrixFreeVector old_solution;
+        x.init(n);
+        b.init(n);
+        old_solution.init(n);
+
+        auto start = std::chrono::steady_clock::now();
+
+        for(uint_t step=0; step<N_STEPS; ++step){
+
+            assemble(mesh, dof_manager, dt, old_solution, matrix, b);
+            solver.solve(matrix, x, b);
+            old_solution = x;
+        }
+
+        auto end = std::chrono::steady_clock::now();
+        assembled_time = std::chrono::duration<real_t>(end - start).count()/N_STEPS;
+        assembled_memory = matrix.memory_usage();
+    }
+
+    // matrix-free mode
+    real_t matrix_free_time = 0.0;
+    uint_t matrix_free_memory = 0;
+    {
+        BCFunc bc_func(mesh.n_boundaries());
+        RhsVals rhs;
+
+        BackwardEulerFVTimeAssemblyPolicy<2, FVLaplaceAssemblyPolicy<2>> stepper;
+        stepper.set_time_step(dt);
+
+        FVLaplaceAssemblyPolicy<2> policy;
+        policy.build_gradient([](){
+            return kernel::numerics::FVGradFactory<2>::build(kernel::numerics::FVGradType::GAUSS);
+        });
+
+        policy.set_dof_manager(dof_manager);
+        policy.set_boundary_function(bc_func);
+        policy.set_rhs_function(rhs);
+        policy.set_mesh(mesh);
+
+        FVMatrixFreeOperator<2> op;
+        op.init(n, n);
+
+        MatrixFreeKrylovSolver<FVMatrixFreeOperator<2>> solver(solver_data());
+
+        FVMatrixFreeVector x;
+        FVMatrixFreeVector b;
+        std::vector<FVMatrixFreeVector> old_solutions(1);
+        x.init(n);
+        b.init(n);
+        old_solutions[0].init(n);
+
+        auto start = std::chrono::steady_clock::now();
+
+        for(uint_t step=0; step<N_STEPS; ++step){
+
+            op.zero();
+            b.zero();
+
+            policy.assemble(op, x, b);
+            stepper.assemble(op, x, b, old_solutions);
+            solver.solve(op, x, b);
+            old_solutions[0] = x;
+        }
+
+        auto end = std::chrono::steady_clock::now();
+        matrix_free_time = std::chrono::duration<real_t>(end - start).count()/N_STEPS;
+        matrix_free_memory = op.memory_usage();
+    }
+
+    std::cout<<std::setw(10)<<dt
+             <<std::setw(18)<<assembled_memory/1024
+             <<std::setw(18)<<matrix_free_memory/1024
+             <<std::setw(18)<<assembled_time
+             <<std::setw(18)<<matrix_free_time<<std::endl;
+}
+
+}
+
+int main(){
+
+    try{
+
+        Mesh<2> mesh;
+        kernel::numerics::build_quad_mesh(mesh, N_CELLS_PER_SIDE, N_CELLS_PER_SIDE,
+                                          GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+
+        FVDoFManager<2> dof_manager;
+        dof_manager.distribute_dofs(mesh, Variable());
+
+        std::cout<<"Number of dofs: "<<dof_manager.n_dofs()<<" time steps: "<<N_STEPS<<std::endl;
+        std::cout<<std::setw(10)<<"dt"
+                 <<std::setw(18)<<"assembled (KB)"
+                 <<std::setw(18)<<"matrix-free (KB)"
+                 <<std::setw(18)<<"assembled (s)"
+                 <<std::setw(18)<<"matrix-free (s)"<<std::endl;
+
+        for(auto dt : TIME_STEPS){
+            run(mesh, dof_manager, dt);
+        }
+    }
+    catch(std::exception& e){
+
+        std::cerr<<e.what()<<std::endl;
+    }
+    catch(...){
+
+        std::cerr<<"Unknown exception occured"<<std::endl;
+    }
+
+    return 0;
+}
+#else
+
+#include <iostream>
+
+int main(){
+
+    std::cout<<"This example requires FVM. Reconfigure kernellib such that it uses FVM"<<std::endl;
+    return 0;
+}
+#endif
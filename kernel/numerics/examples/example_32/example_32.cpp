@@ -0,0 +1,153 @@
+/**
+ * Blaze Krylov solvers. The 5-point convection-diffusion system on a
+ * square grid is solved with every solver and preconditioner that
+ * BlazeKrylovSolver supports. The symmetric system (zero convection)
+ * is also solved with CG and IC(0) for an increasing number of threads.
+ * The number of iterations, the residual and the wall time are reported.
+ * Without preconditioner CGS and TFQMR are expected to stagnate on this
+ * system since the squared BiCG polynomial amplifies rounding errors.
+ */
+
+#include "kernel/base/types.h"
+#include "kernel/numerics/krylov_solvers/blaze_krylov_solver.h"
+#include "kernel/numerics/krylov_solvers/krylov_solver_data.h"
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+
+namespace  {
+
+using kernel::uint_t;
+using kernel::real_t;
+using kernel::DynVec;
+using kernel::SparseMatrix;
+using kernel::numerics::BlazeKrylovSolver;
+using kernel::numerics::KrylovSolverData;
+using kernel::numerics::KrylovSolverType;
+using kernel::numerics::PreconditionerType;
+
+const uint_t N = 200;
+const real_t CONVECTION = 0.1;
+const std::vector<uint_t> N_THREADS = {1, 2, 4};
+
+SparseMatrix<real_t> convection_diffusion(uint_t n, real_t convection){
+
+    const uint_t n_rows = n*n;
+    SparseMatrix<real_t> A(n_rows, n_rows);
+    A.reserve(5*n_rows);
+
+    for(uint_t j=0; j<n; ++j){
+        for(uint_t i=0; i<n; ++i){
+
+            const uint_t row = j*n + i;
+
+            if(j > 0){
+                A.append(row, row - n, -1.0);
+            }
+
+            if(i > 0){
+                A.append(row, row - 1, -1.0 - convection);
+            }
+
+            A.append(row, row, 4.0);
+
+            if(i < n - 1){
+                A.append(row, row + 1, -1.0 + convection);
+            }
+
+            if(j < n - 1){
+                A.append(row, row + n, -1.0);
+            }
+
+            A.finalize(row);
+        }
+    }
+
+    return A;
+}
+
+void run(const SparseMatrix<real_t>& A, KrylovSolverType solver_type,
+         PreconditionerType preconditioner_type, uint_t n_threads){
+
+    KrylovSolverData data;
+    data.n_iterations = 2000;
+    data.tolerance = 1.0e-8;
+    data.solver_type = solver_type;
+    data.precondioner_type = preconditioner_type;
+
+    BlazeKrylovSolver solver(data);
+    solver.set_n_threads(n_threads);
+
+    // a constant rhs is almost in the null space of the
+    // interior rows and makes CGS and TFQMR stagnate
+    DynVec<real_t> x(A.rows(), 0.0);
+    DynVec<real_t> b(A.rows(), 0.0);
+    for(uint_t i=0; i<b.size(); ++i){
+        b[i] = std::sin(static_cast<real_t>(i));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto result = solver.solve(A, x, b);
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout<<std::setw(10)<<kernel::numerics::krylov_solver_to_string(solver_type)
+             <<std::setw(14)<<kernel::numerics::preconditioner_to_string(preconditioner_type)
+             <<std::setw(10)<<n_threads
+             <<std::setw(12)<<result.num_iterations
+             <<std::setw(16)<<result.residual
+             <<std::setw(12)<<result.converged
+             <<std::setw(14)<<std::chrono::duration<real_t>(end - start).count()<<std::endl;
+}
+
+void print_header(){
+
+    std::cout<<std::setw(10)<<"solver"
+             <<std::setw(14)<<"precond"
+             <<std::setw(10)<<"threads"
+             <<std::setw(12)<<"iterations"
+             <<std::setw(16)<<"residual"
+             <<std::setw(12)<<"converged"
+             <<std::setw(14)<<"time (s)"<<std::endl;
+}
+
+}
+
+int main(){
+
+    try{
+
+        const auto A = convection_diffusion(N, CONVECTION);
+        std::cout<<"Convection-diffusion system with "<<A.rows()<<" rows"<<std::endl;
+        print_header();
+
+        for(auto solver_type : {KrylovSolverType::GMRES, KrylovSolverType::BICGSTAB,
+                                KrylovSolverType::CGS, KrylovSolverType::TFQMR}){
+            for(auto preconditioner_type : {PreconditionerType::INVALID_PREC, PreconditionerType::JACOBI,
+                                            PreconditionerType::ILU}){
+                run(A, solver_type, preconditioner_type, N_THREADS.back());
+            }
+        }
+
+        const auto L = convection_diffusion(N, 0.0);
+        std::cout<<std::endl<<"Laplace system with "<<L.rows()<<" rows"<<std::endl;
+        print_header();
+
+        for(auto n_threads : N_THREADS){
+            run(L, KrylovSolverType::CG, PreconditionerType::JACOBI, n_threads);
+            run(L, KrylovSolverType::CG, PreconditionerType::ICC, n_threads);
+        }
+    }
+    catch(std::exception& e){
+
+        std::cerr<<e.what()<<std::endl;
+    }
+    catch(...){
+
+        std::cerr<<"Unknown exception occured"<<std::endl;
+    }
+
+    return 0;
+}
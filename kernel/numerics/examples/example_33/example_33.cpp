@@ -0,0 +1,137 @@
+/**
+ * AMG preconditioned CG. The FV Laplace system with zero Dirichlet
+ * conditions is solved on a sequence of refined grids with CG and the
+ * Jacobi, IC(0) and smoothed aggregation AMG preconditioners. The
+ * iterations of Jacobi and IC(0) grow with the mesh size whereas the
+ * iterations of AMG stay almost the same. The setup and solve time and
+ * the AMG hierarchy of the finest grid are reported.
+ */
+
+#include "kernel/base/types.h"
+#include "kernel/numerics/krylov_solvers/blaze_krylov_solver.h"
+#include "kernel/numerics/krylov_solvers/krylov_solver_data.h"
+
+#include <chrono>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+
+namespace  {
+
+using kernel::uint_t;
+using kernel::real_t;
+using kernel::DynVec;
+using kernel::SparseMatrix;
+using kernel::numerics::BlazeKrylovSolver;
+using kernel::numerics::KrylovSolverData;
+using kernel::numerics::KrylovSolverType;
+using kernel::numerics::PreconditionerType;
+
+const std::vector<uint_t> N_CELLS_PER_SIDE = {64, 128, 256, 512};
+
+/// \brief The FV Laplace matrix on an n x n grid of unit
+/// squares with zero Dirichlet conditions on the boundary
+SparseMatrix<real_t> laplace(uint_t n){
+
+    const uint_t n_rows = n*n;
+    SparseMatrix<real_t> A(n_rows, n_rows);
+    A.reserve(5*n_rows);
+
+    for(uint_t j=0; j<n; ++j){
+        for(uint_t i=0; i<n; ++i){
+
+            const uint_t row = j*n + i;
+
+            // boundary faces contribute twice the
+            // flux of an interior face to the diagonal
+            real_t diagonal = 0.0;
+            diagonal += j > 0 ? 1.0 : 2.0;
+            diagonal += i > 0 ? 1.0 : 2.0;
+            diagonal += i < n - 1 ? 1.0 : 2.0;
+            diagonal += j < n - 1 ? 1.0 : 2.0;
+
+            if(j > 0){
+                A.append(row, row - n, -1.0);
+            }
+
+            if(i > 0){
+                A.append(row, row - 1, -1.0);
+            }
+
+            A.append(row, row, diagonal);
+
+            if(i < n - 1){
+                A.append(row, row + 1, -1.0);
+            }
+
+            if(j < n - 1){
+                A.append(row, row + n, -1.0);
+            }
+
+            A.finalize(row);
+        }
+    }
+
+    return A;
+}
+
+void run(const SparseMatrix<real_t>& A, PreconditionerType preconditioner_type, bool print_hierarchy){
+
+    KrylovSolverData data;
+    data.n_iterations = 5000;
+    data.tolerance = 1.0e-8;
+    data.solver_type = KrylovSolverType::CG;
+    data.precondioner_type = preconditioner_type;
+
+    BlazeKrylovSolver solver(data);
+
+    DynVec<real_t> x(A.rows(), 0.0);
+    DynVec<real_t> b(A.rows(), 1.0);
+
+    auto start = std::chrono::steady_clock::now();
+    auto result = solver.solve(A, x, b);
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout<<std::setw(10)<<A.rows()
+             <<std::setw(14)<<kernel::numerics::preconditioner_to_string(preconditioner_type)
+             <<std::setw(12)<<result.num_iterations
+             <<std::setw(16)<<result.residual
+             <<std::setw(14)<<std::chrono::duration<real_t>(end - start).count()<<std::endl;
+
+    if(print_hierarchy){
+        solver.amg_preconditioner().print(std::cout);
+    }
+}
+
+}
+
+int main(){
+
+    try{
+
+        std::cout<<std::setw(10)<<"rows"
+                 <<std::setw(14)<<"precond"
+                 <<std::setw(12)<<"iterations"
+                 <<std::setw(16)<<"residual"
+                 <<std::setw(14)<<"time (s)"<<std::endl;
+
+        for(auto n : N_CELLS_PER_SIDE){
+
+            const auto A = laplace(n);
+
+            run(A, PreconditionerType::JACOBI, false);
+            run(A, PreconditionerType::ICC, false);
+            run(A, PreconditionerType::AMG, n == N_CELLS_PER_SIDE.back());
+        }
+    }
+    catch(std::exception& e){
+
+        std::cerr<<e.what()<<std::endl;
+    }
+    catch(...){
+
+        std::cerr<<"Unknown exception occured"<<std::endl;
+    }
+
+    return 0;
+}
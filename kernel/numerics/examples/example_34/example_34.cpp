@@ -0,0 +1,142 @@
+/**
+ * Sparse direct solver. A sequence of convection-diffusion systems with the
+ * same sparsity pattern, as produced by implicit time stepping, is solved with
+ * the SparseDirectSolver. The first solve computes the AMD ordering and the
+ * symbolic analysis. The next solves reuse them together with the pivot
+ * sequence of the LU factorization. The number of nonzeros of the factors
+ * with the natural and the AMD ordering and the time of every phase are
+ * reported for refined grids.
+ */
+
+#include "kernel/base/types.h"
+#include "kernel/numerics/direct_solvers/sparse_direct_solver.h"
+
+#include <chrono>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+
+namespace  {
+
+using kernel::uint_t;
+using kernel::real_t;
+using kernel::DynVec;
+using kernel::SparseMatrix;
+using kernel::maths::solvers::SparseDirectSolver;
+using kernel::maths::solvers::SparseDirectSolverConfig;
+using kernel::maths::solvers::FillReducingOrdering;
+
+const std::vector<uint_t> N_CELLS_PER_SIDE = {32, 64, 128, 256};
+const uint_t N_STEPS = 10;
+
+/// \brief The backward Euler convection-diffusion matrix on an n x n grid.
+/// The time step changes the diagonal only so the pattern is fixed
+SparseMatrix<real_t> convection_diffusion(uint_t n, real_t dt){
+
+    const uint_t n_rows = n*n;
+    const real_t convection = 0.3;
+    SparseMatrix<real_t> A(n_rows, n_rows);
+    A.reserve(5*n_rows);
+
+    for(uint_t j=0; j<n; ++j){
+        for(uint_t i=0; i<n; ++i){
+
+            const uint_t row = j*n + i;
+
+            if(j > 0){
+                A.append(row, row - n, -1.0);
+            }
+
+            if(i > 0){
+                A.append(row, row - 1, -1.0 - convection);
+            }
+
+            A.append(row, row, 4.0 + 1.0/dt);
+
+            if(i < n - 1){
+                A.append(row, row + 1, -1.0 + convection);
+            }
+
+            if(j < n - 1){
+                A.append(row, row + n, -1.0);
+            }
+
+            A.finalize(row);
+        }
+    }
+
+    return A;
+}
+
+real_t seconds_since(std::chrono::steady_clock::time_point start){
+    return std::chrono::duration<real_t>(std::chrono::steady_clock::now() - start).count();
+}
+
+void run(uint_t n){
+
+    SparseDirectSolverConfig natural_config;
+    natural_config.ordering = FillReducingOrdering::NATURAL;
+    SparseDirectSolver natural(natural_config);
+    natural.factorize(convection_diffusion(n, 1.0));
+
+    SparseDirectSolver solver(SparseDirectSolverConfig{});
+
+    real_t first_solve = 0.0;
+    real_t next_solves = 0.0;
+
+    for(uint_t step=0; step<N_STEPS; ++step){
+
+        // the time step changes so the values change
+        const auto A = convection_diffusion(n, 1.0/(step + 1));
+        DynVec<real_t> x(A.rows(), 0.0);
+        DynVec<real_t> b(A.rows(), 1.0);
+
+        auto start = std::chrono::steady_clock::now();
+        solver.solve(A, x, b);
+
+        if(step == 0){
+            first_solve = seconds_since(start);
+        }
+        else{
+            next_solves += seconds_since(start);
+        }
+    }
+
+    std::cout<<std::setw(10)<<n*n
+             <<std::setw(16)<<natural.n_factor_nonzeros()
+             <<std::setw(14)<<solver.n_factor_nonzeros()
+             <<std::setw(14)<<first_solve
+             <<std::setw(14)<<next_solves/(N_STEPS - 1)
+             <<std::setw(10)<<solver.n_analyses()
+             <<std::setw(10)<<solver.n_refactorizations()<<std::endl;
+}
+
+}
+
+int main(){
+
+    try{
+
+        std::cout<<std::setw(10)<<"rows"
+                 <<std::setw(16)<<"nnz natural"
+                 <<std::setw(14)<<"nnz AMD"
+                 <<std::setw(14)<<"first (s)"
+                 <<std::setw(14)<<"next (s)"
+                 <<std::setw(10)<<"analyses"
+                 <<std::setw(10)<<"refactor"<<std::endl;
+
+        for(auto n : N_CELLS_PER_SIDE){
+            run(n);
+        }
+    }
+    catch(std::exception& e){
+
+        std::cerr<<e.what()<<std::endl;
+    }
+    catch(...){
+
+        std::cerr<<"Unknown exception occured"<<std::endl;
+    }
+
+    return 0;
+}
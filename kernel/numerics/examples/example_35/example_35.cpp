@@ -0,0 +1,193 @@
+/**
+ * Fixed sparsity pattern for transient FV assembly. The backward Euler
+ * system of the heat equation is assembled for 1000 time steps into a
+ * TrilinosEpetraMatrix. The rebuild mode initializes the matrix on every
+ * step so the entries are inserted and the CSR structure is built again.
+ * The fixed pattern mode computes the pattern once from the dofs and the
+ * element-face adjacency and the steps write the values in place as
+ * FVScalarTimedSystem does. The old solution is kept constant as only the
+ * assembly is timed. The mean and the maximum assembly time per step are
+ * reported.
+ */
+
+#include "kernel/base/config.h"
+
+#if defined(USE_FVM) && defined(USE_TRILINOS)
+
+#include "kernel/base/types.h"
+#include "kernel/geometry/geom_point.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/quad_mesh_generation.h"
+#include "kernel/discretization/dof_manager.h"
+#include "kernel/maths/trilinos_epetra_matrix.h"
+#include "kernel/maths/trilinos_epetra_vector.h"
+#include "kernel/numerics/fvm/fv_laplace_assemble_policy.h"
+#include "kernel/numerics/fvm/fv_grad_factory.h"
+#include "kernel/numerics/fvm/fv_grad_types.h"
+#include "kernel/numerics/backward_euler_fv_time_assembly_policy.h"
+#include "kernel/numerics/scalar_dirichlet_bc_function.h"
+#include "kernel/maths/functions/numeric_scalar_function.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string_view>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+
+namespace  {
+
+using kernel::uint_t;
+using kernel::real_t;
+using kernel::DynVec;
+using kernel::GeomPoint;
+using kernel::numerics::Mesh;
+using kernel::numerics::FVDoFManager;
+using kernel::numerics::TrilinosEpetraMatrix;
+using kernel::numerics::TrilinosEpetraVector;
+using kernel::numerics::FVLaplaceAssemblyPolicy;
+using kernel::numerics::BackwardEulerFVTimeAssemblyPolicy;
+using kernel::numerics::ScalarDirichletBCFunc;
+
+const uint_t N_CELLS_PER_SIDE = 100;
+const uint_t N_STEPS = 1000;
+const real_t DT = 1.0e-3;
+
+struct Variable
+{
+    std::string_view name()const{return "u";}
+};
+
+class BCFunc: public ScalarDirichletBCFunc<2>
+{
+public:
+
+    BCFunc(uint_t n_boundaries)
+        :
+          ScalarDirichletBCFunc<2>(0.0, n_boundaries)
+    {}
+
+    using ScalarDirichletBCFunc<2>::value;
+    virtual real_t value(uint_t /*i*/, const GeomPoint<2>& /*input*/)const override final{return 0.0;}
+    virtual DynVec<real_t> coeffs()const override final{return DynVec<real_t>();}
+    virtual void update_coeffs(const DynVec<real_t>& /*params*/)override final{}
+};
+
+class RhsVals: public kernel::numerics::NumericScalarFunction<2>
+{
+public:
+
+    virtual real_t value(const GeomPoint<2>& /*input*/)const override final{return 1.0;}
+    virtual real_t value(uint_t /*i*/, const GeomPoint<2>& /*input*/)const override final{return 1.0;}
+    virtual DynVec<real_t> coeffs()const override final{return DynVec<real_t>();}
+    virtual void update_coeffs(const DynVec<real_t>& /*params*/)override final{}
+};
+
+typedef BackwardEulerFVTimeAssemblyPolicy<2, FVLaplaceAssemblyPolicy<2>> stepper_t;
+
+void run(const Mesh<2>& mesh, const FVDoFManager<2>& dof_manager, bool fixed_pattern){
+
+    const uint_t n = dof_manager.n_dofs();
+
+    BCFunc bc_func(mesh.n_boundaries());
+    RhsVals rhs;
+
+    stepper_t stepper;
+    stepper.set_time_step(DT);
+    stepper.get_assembly_polcy().build_gradient([](){
+        return kernel::numerics::FVGradFactory<2>::build(kernel::numerics::FVGradType::GAUSS);
+    });
+
+    stepper.set_dof_manager(dof_manager);
+    stepper.set_boundary_function(bc_func);
+    stepper.set_rhs_function(rhs);
+    stepper.set_mesh(mesh);
+
+    TrilinosEpetraMatrix matrix;
+    TrilinosEpetraVector x;
+    TrilinosEpetraVector b;
+    std::vector<TrilinosEpetraVector> old_solutions(1);
+    x.init(n, false);
+    b.init(n, false);
+    old_solutions[0].init(n, false);
+
+    if(fixed_pattern){
+
+        std::vector<std::vector<uint_t>> pattern;
+        dof_manager.sparsity_pattern(mesh, pattern);
+        matrix.init(n, n, pattern);
+    }
+
+    real_t total = 0.0;
+    real_t worst = 0.0;
+
+    for(uint_t step=0; step<N_STEPS; ++step){
+
+        auto start = std::chrono::steady_clock::now();
+
+        if(fixed_pattern){
+            matrix.zero();
+        }
+        else{
+            matrix.init(n, n, 6);
+        }
+
+        b.zero();
+        stepper.assemble(matrix, x, b, old_solutions);
+
+        matrix.fill_completed();
+        b.compress();
+
+        auto end = std::chrono::steady_clock::now();
+        const real_t time = std::chrono::duration<real_t>(end - start).count();
+        total += time;
+        worst = std::max(worst, time);
+    }
+
+    std::cout<<std::setw(16)<<(fixed_pattern ? "fixed pattern" : "rebuild")
+             <<std::setw(18)<<total/N_STEPS
+             <<std::setw(18)<<worst<<std::endl;
+}
+
+}
+
+int main(){
+
+    try{
+
+        Mesh<2> mesh;
+        kernel::numerics::build_quad_mesh(mesh, N_CELLS_PER_SIDE, N_CELLS_PER_SIDE,
+                                          GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+
+        FVDoFManager<2> dof_manager;
+        dof_manager.distribute_dofs(mesh, Variable());
+
+        std::cout<<"Number of dofs: "<<dof_manager.n_dofs()<<" time steps: "<<N_STEPS<<std::endl;
+        std::cout<<std::setw(16)<<"mode"
+                 <<std::setw(18)<<"mean step (s)"
+                 <<std::setw(18)<<"max step (s)"<<std::endl;
+
+        run(mesh, dof_manager, false);
+        run(mesh, dof_manager, true);
+    }
+    catch(std::exception& e){
+
+        std::cerr<<e.what()<<std::endl;
+    }
+    catch(...){
+
+        std::cerr<<"Unknown exception occured"<<std::endl;
+    }
+
+    return 0;
+}
+#else
+
+#include <iostream>
+
+int main(){
+
+    std::cout<<"This example requires FVM and Trilinos. Reconfigure kernellib such that it uses FVM and Trilinos"<<std::endl;
+    return 0;
+}
+#endif
@@ -11,6 +11,13 @@
 #include "kernel/discretization/mesh_predicates.h"
 #include "kernel/discretization/element_mesh_iterator.h"
 
+#ifdef USE_FVM
+#include "kernel/numerics/fvm/fv_matrix_free_operator.h"
+#endif
+
+#include <vector>
+#include <stdexcept>
+
 #ifdef USE_TRILINOS
 #include "kernel/maths/trilinos_epetra_matrix.h"
 #include "kernel/maths/trilinos_epetra_vector.h"
@@ -57,6 +64,16 @@ public:
     void assemble_one_element(TrilinosEpetraMatrix& mat, TrilinosEpetraVector& x, TrilinosEpetraVector& b,
                               const std::vector<TrilinosEpetraVector>& old_solutions);
 
+#endif
+
+#ifdef USE_FVM
+
+    /// \brief Assemble the time term of the matrix-free operator.
+    /// The operator keeps volume/dt apart from the spatial terms
+    /// and only the rhs is assembled on every time step
+    void assemble(FVMatrixFreeOperator<dim>& mat, FVMatrixFreeVector& x, FVMatrixFreeVector& b,
+                  const std::vector<FVMatrixFreeVector>& old_solutions);
+
 #endif
 
     /// \brief Set the object that describes the dofs
@@ -121,7 +138,7 @@ BackwardEulerFVTimeAssemblyPolicy<dim,SpatialAssembly>::BackwardEulerFVTimeAssem
 template<int dim,typename SpatialAssembly>
 void
 BackwardEulerFVTimeAssemblyPolicy<dim, SpatialAssembly>::initialize_dofs(){
-    spatial_assembly_.initialze_dofs();
+    spatial_assembly_.initialize_dofs();
 }
 
 template<int dim,typename SpatialAssembly>
@@ -166,12 +183,39 @@ BackwardEulerFVTimeAssemblyPolicy<dim,
 
     std::vector<real_t> row_entries(dofs.size(), 0.0);
 
-    mat.set_entry(dofs[0].id, dofs[0].id, elem_volume/dt_);
+    mat.add_entry(dofs[0].id, dofs[0].id, elem_volume/dt_);
     auto old_sol = old_solutions[0][dofs[0].id];
     b.add(dofs[0].id, (old_sol*elem_volume)/dt_);
 }
 #endif
 
+#ifdef USE_FVM
+
+template<int dim,typename SpatialAssembly>
+void
+BackwardEulerFVTimeAssemblyPolicy<dim, SpatialAssembly>::assemble(FVMatrixFreeOperator<dim>& mat, FVMatrixFreeVector& /*x*/,
+                                                                  FVMatrixFreeVector& b,
+                                                                  const std::vector<FVMatrixFreeVector>& old_solutions){
+
+    if(old_solutions.empty()){
+        throw std::logic_error("Backward Euler needs the old solution vector");
+    }
+
+    if(!mat.is_assembled()){
+        throw std::logic_error("The spatial terms of the matrix-free operator are not assembled");
+    }
+
+    mat.set_time_step(dt_);
+
+    const auto& old_sol = old_solutions[0];
+
+    for(uint_t r=0; r<mat.m(); ++r){
+        b.add(r, (old_sol[r]*mat.row_volume(r))/dt_);
+    }
+}
+
+#endif
+
 }
 
 }
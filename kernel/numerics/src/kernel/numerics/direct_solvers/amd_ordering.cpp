@@ -0,0 +1,256 @@
+#include "kernel/numerics/direct_solvers/amd_ordering.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace kernel{
+namespace maths {
+namespace solvers {
+
+namespace{
+
+/// \brief The state of a node of the quotient graph
+enum class NodeStatus: char {VARIABLE, ELEMENT, ABSORBED};
+
+///
+/// \brief Doubly linked lists of the variables with the same approximate degree
+///
+class DegreeLists
+{
+public:
+
+    explicit DegreeLists(uint_t n)
+        :
+        head_(n, NONE),
+        next_(n, NONE),
+        prev_(n, NONE),
+        min_degree_(0)
+    {}
+
+    void insert(uint_t i, uint_t degree){
+
+        next_[i] = head_[degree];
+        prev_[i] = NONE;
+
+        if(head_[degree] != NONE){
+            prev_[head_[degree]] = i;
+        }
+
+        head_[degree] = i;
+        min_degree_ = std::min(min_degree_, degree);
+    }
+
+    void remove(uint_t i, uint_t degree){
+
+        if(prev_[i] != NONE){
+            next_[prev_[i]] = next_[i];
+        }
+        else{
+            head_[degree] = next_[i];
+        }
+
+        if(next_[i] != NONE){
+            prev_[next_[i]] = prev_[i];
+        }
+    }
+
+    /// \brief Returns a variable of minimum degree. There
+    /// should be at least one variable in the lists
+    uint_t min_degree_variable(){
+
+        while(head_[min_degree_] == NONE){
+            ++min_degree_;
+        }
+
+        return head_[min_degree_];
+    }
+
+private:
+
+    static constexpr uint_t NONE = std::numeric_limits<uint_t>::max();
+
+    std::vector<uint_t> head_;
+    std::vector<uint_t> next_;
+    std::vector<uint_t> prev_;
+    uint_t min_degree_;
+};
+
+}
+
+std::vector<uint_t>
+amd_ordering(uint_t n, const std::vector<uint_t>& row_ptr,
+             const std::vector<uint_t>& columns){
+
+    if(row_ptr.size() != n + 1 || row_ptr[n] != columns.size()){
+        throw std::logic_error("Invalid CSR arrays for the AMD ordering");
+    }
+
+    // the adjacency lists of the graph of A + A^T
+    // without the diagonal. After the first pivots they
+    // hold only the variables not covered by an element
+    std::vector<std::vector<uint_t>> variables(n);
+
+    for(uint_t r=0; r<n; ++r){
+        for(uint_t p=row_ptr[r]; p<row_ptr[r + 1]; ++p){
+
+            const uint_t c = columns[p];
+
+            if(c >= n){
+                throw std::logic_error("Column index out of range for the AMD ordering");
+            }
+
+            if(c != r){
+                variables[r].push_back(c);
+                variables[c].push_back(r);
+            }
+        }
+    }
+
+    for(auto& adjacency : variables){
+        std::sort(adjacency.begin(), adjacency.end());
+        adjacency.erase(std::unique(adjacency.begin(), adjacency.end()), adjacency.end());
+    }
+
+    // the elements adjacent to every variable and
+    // the variables of every element. An element is
+    // a pivot whose fill is represented implicitly
+    std::vector<std::vector<uint_t>> elements(n);
+    std::vector<std::vector<uint_t>> element_variables(n);
+    std::vector<NodeStatus> status(n, NodeStatus::VARIABLE);
+
+    std::vector<uint_t> degree(n);
+    DegreeLists lists(n);
+
+    for(uint_t i=0; i<n; ++i){
+        degree[i] = variables[i].size();
+        lists.insert(i, degree[i]);
+    }
+
+    // stamps avoid clearing the marker
+    // and the |L_e \ L_p| arrays at every pivot
+    std::vector<uint_t> mark(n, 0);
+    std::vector<uint_t> external(n, 0);
+    std::vector<uint_t> external_stamp(n, 0);
+
+    std::vector<uint_t> permutation;
+    permutation.reserve(n);
+
+    std::vector<uint_t> pivot_variables;
+
+    for(uint_t k=0; k<n; ++k){
+
+        const uint_t p = lists.min_degree_variable();
+        lists.remove(p, degree[p]);
+        permutation.push_back(p);
+
+        const uint_t stamp = k + 1;
+        mark[p] = stamp;
+
+        // the variables of the new element are the
+        // adjacent variables of the pivot together with the
+        // variables of its elements. The elements are absorbed
+        pivot_variables.clear();
+
+        for(auto v : variables[p]){
+            if(status[v] == NodeStatus::VARIABLE && mark[v] != stamp){
+                mark[v] = stamp;
+                pivot_variables.push_back(v);
+            }
+        }
+
+        for(auto e : elements[p]){
+
+            if(status[e] != NodeStatus::ELEMENT){
+                continue;
+            }
+
+            for(auto v : element_variables[e]){
+                if(status[v] == NodeStatus::VARIABLE && mark[v] != stamp){
+                    mark[v] = stamp;
+                    pivot_variables.push_back(v);
+                }
+            }
+
+            status[e] = NodeStatus::ABSORBED;
+            std::vector<uint_t>().swap(element_variables[e]);
+        }
+
+        status[p] = NodeStatus::ELEMENT;
+        std::vector<uint_t>().swap(variables[p]);
+        std::vector<uint_t>().swap(elements[p]);
+        element_variables[p] = pivot_variables;
+
+        // the absorbed elements are replaced by the new one and
+        // the variables covered by the new element are pruned
+        for(auto i : pivot_variables){
+
+            lists.remove(i, degree[i]);
+
+            auto& i_elements = elements[i];
+            i_elements.erase(std::remove_if(i_elements.begin(), i_elements.end(),
+                                            [&status](uint_t e){return status[e] != NodeStatus::ELEMENT;}),
+                             i_elements.end());
+            i_elements.push_back(p);
+
+            auto& i_variables = variables[i];
+            i_variables.erase(std::remove_if(i_variables.begin(), i_variables.end(),
+                                             [&status, &mark, stamp](uint_t v){
+                                                 return status[v] != NodeStatus::VARIABLE || mark[v] == stamp;}),
+                              i_variables.end());
+        }
+
+        // |L_e \ L_p| for every element e adjacent to the new element
+        for(auto i : pivot_variables){
+            for(auto e : elements[i]){
+
+                if(e == p){
+                    continue;
+                }
+
+                if(external_stamp[e] != stamp){
+                    external_stamp[e] = stamp;
+                    external[e] = element_variables[e].size();
+                }
+
+                --external[e];
+            }
+        }
+
+        // the approximate external degrees. An element whose
+        // variables are all in the new element is absorbed as well
+        const uint_t n_remaining = n - k - 1;
+        const uint_t n_pivot_variables = pivot_variables.size();
+
+        for(auto i : pivot_variables){
+
+            uint_t d = variables[i].size() + n_pivot_variables - 1;
+
+            for(auto e : elements[i]){
+
+                if(e == p || status[e] != NodeStatus::ELEMENT){
+                    continue;
+                }
+
+                if(external[e] == 0){
+                    status[e] = NodeStatus::ABSORBED;
+                    continue;
+                }
+
+                d += external[e];
+            }
+
+            d = std::min(d, degree[i] + n_pivot_variables - 1);
+            d = std::min(d, n_remaining - 1);
+
+            degree[i] = d;
+            lists.insert(i, d);
+        }
+    }
+
+    return permutation;
+}
+
+}
+}
+}
@@ -0,0 +1,29 @@
+#ifndef AMD_ORDERING_H
+#define AMD_ORDERING_H
+
+#include "kernel/base/types.h"
+
+#include <vector>
+
+namespace kernel{
+namespace maths {
+namespace solvers {
+
+///
+/// \brief amd_ordering. Computes an approximate minimum degree
+/// fill-reducing ordering of the n x n matrix given in CSR format.
+/// The ordering is computed on the graph of A + A^T so the pattern
+/// of A does not need to be symmetric. The elimination is simulated
+/// on the quotient graph with element absorption and the external
+/// degrees are approximated as in Amestoy, Davis and Duff.
+/// Returns the permutation p where p[k] is the row of A that is
+/// eliminated k-th. Throws std::logic_error if the CSR arrays are invalid
+///
+std::vector<uint_t> amd_ordering(uint_t n, const std::vector<uint_t>& row_ptr,
+                                 const std::vector<uint_t>& columns);
+
+}
+}
+}
+
+#endif // AMD_ORDERING_H
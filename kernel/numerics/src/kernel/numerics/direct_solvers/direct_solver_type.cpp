@@ -12,6 +12,8 @@ std::string solver_type_to_string(DirectSolverType type){
         return "SUPER_LU";
     case DirectSolverType::LU:
         return "LU";
+    case DirectSolverType::CHOLESKY:
+        return "CHOLESKY";
     }
 
     return "INVALID_TYPE";
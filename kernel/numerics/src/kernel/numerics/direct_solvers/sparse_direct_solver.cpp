@@ -0,0 +1,726 @@
+#include "kernel/numerics/direct_solvers/sparse_direct_solver.h"
+#include "kernel/numerics/direct_solvers/amd_ordering.h"
+#include "kernel/numerics/solvers/solver_package_type.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace kernel{
+namespace maths {
+namespace solvers {
+
+namespace{
+
+const uint_t NONE = std::numeric_limits<uint_t>::max();
+
+/// \brief The values of A in the CSR order of its pattern
+std::vector<real_t> csr_values(const SparseMatrix<real_t>& A){
+
+    std::vector<real_t> values;
+    values.reserve(A.nonZeros());
+
+    for(uint_t r=0; r<A.rows(); ++r){
+        for(auto it = A.cbegin(r); it != A.cend(r); ++it){
+            values.push_back(it->value());
+        }
+    }
+
+    return values;
+}
+
+///
+/// \brief The nonzero pattern of row k of the Cholesky factor
+/// of the permuted matrix. The pattern is returned in
+/// stack[top, n) in topological order and top is returned
+///
+uint_t ereach(uint_t k, uint_t row_begin, uint_t row_end,
+              const std::vector<uint_t>& columns,
+              const std::vector<uint_t>& inverse_permutation,
+              const std::vector<uint_t>& parent,
+              std::vector<uint_t>& stack, std::vector<uint_t>& path,
+              std::vector<uint_t>& mark){
+
+    const uint_t n = stack.size();
+    const uint_t stamp = k + 1;
+    uint_t top = n;
+    mark[k] = stamp;
+
+    for(uint_t p=row_begin; p<row_end; ++p){
+
+        uint_t i = inverse_permutation[columns[p]];
+
+        if(i > k){
+            continue;
+        }
+
+        // climb the elimination tree until a marked node
+        uint_t len = 0;
+        for(; mark[i] != stamp; i = parent[i]){
+            path[len++] = i;
+            mark[i] = stamp;
+        }
+
+        while(len > 0){
+            stack[--top] = path[--len];
+        }
+    }
+
+    return top;
+}
+
+}
+
+SparseDirectSolver::SparseDirectSolver(const SparseDirectSolverConfig& config)
+    :
+    DirectSolverBase<SparseMatrix<real_t>, DynVec<real_t>>(SolverPackageType::BLAZE),
+    config_(config),
+    analysis_(),
+    factors_()
+{
+    if(config_.dstype != DirectSolverType::LU &&
+       config_.dstype != DirectSolverType::CHOLESKY){
+        throw std::logic_error("SparseDirectSolver supports only LU and CHOLESKY. Type " +
+                               solver_type_to_string(config_.dstype) + " given");
+    }
+}
+
+void
+SparseDirectSolver::solve(const SparseDirectSolver::matrix_t& A,
+                          SparseDirectSolver::vector_t& x,
+                          const SparseDirectSolver::vector_t& b )const{
+
+    if(A.columns() != x.size()){
+        throw std::logic_error("Invalid Matrix-Vector size");
+    }
+
+    if(A.rows() != b.size()){
+        throw std::logic_error("Invalid rhs size");
+    }
+
+    factorize_(A);
+    solve(x, b);
+}
+
+void
+SparseDirectSolver::analyze(const SparseDirectSolver::matrix_t& A){
+    analyze_(A);
+}
+
+void
+SparseDirectSolver::factorize(const SparseDirectSolver::matrix_t& A){
+    factorize_(A);
+}
+
+uint_t
+SparseDirectSolver::n_factor_nonzeros()const{
+    return factors_.l_values.size() + factors_.u_values.size();
+}
+
+bool
+SparseDirectSolver::same_pattern_(const SparseDirectSolver::matrix_t& A)const{
+
+    if(!analysis_.analyzed || A.rows() != analysis_.n ||
+       A.columns() != analysis_.n || A.nonZeros() != analysis_.columns.size()){
+        return false;
+    }
+
+    for(uint_t r=0; r<A.rows(); ++r){
+
+        uint_t p = analysis_.row_ptr[r];
+
+        if(A.cend(r) - A.cbegin(r) != static_cast<std::ptrdiff_t>(analysis_.row_ptr[r + 1] - p)){
+            return false;
+        }
+
+        for(auto it = A.cbegin(r); it != A.cend(r); ++it, ++p){
+            if(it->index() != analysis_.columns[p]){
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void
+SparseDirectSolver::analyze_(const SparseDirectSolver::matrix_t& A)const{
+
+    if(A.rows() != A.columns()){
+        throw std::logic_error("SparseDirectSolver requires a square matrix");
+    }
+
+    const uint_t n = A.rows();
+
+    // the factors of the previous pattern are discarded
+    const uint_t n_factorizations = factors_.n_factorizations;
+    const uint_t n_refactorizations = factors_.n_refactorizations;
+    factors_ = Factors();
+    factors_.n_factorizations = n_factorizations;
+    factors_.n_refactorizations = n_refactorizations;
+
+    analysis_.analyzed = false;
+
+    analysis_.n = n;
+    analysis_.row_ptr.assign(n + 1, 0);
+    analysis_.columns.clear();
+    analysis_.columns.reserve(A.nonZeros());
+
+    for(uint_t r=0; r<n; ++r){
+        for(auto it = A.cbegin(r); it != A.cend(r); ++it){
+            analysis_.columns.push_back(it->index());
+        }
+
+        analysis_.row_ptr[r + 1] = analysis_.columns.size();
+    }
+
+    if(config_.ordering == FillReducingOrdering::AMD){
+        analysis_.permutation = amd_ordering(n, analysis_.row_ptr, analysis_.columns);
+    }
+    else{
+        analysis_.permutation.resize(n);
+        std::iota(analysis_.permutation.begin(), analysis_.permutation.end(), 0);
+    }
+
+    analysis_.inverse_permutation.resize(n);
+    for(uint_t k=0; k<n; ++k){
+        analysis_.inverse_permutation[analysis_.permutation[k]] = k;
+    }
+
+    if(config_.dstype == DirectSolverType::CHOLESKY){
+        cholesky_symbolic_();
+    }
+    else{
+        analysis_.parent.clear();
+        analysis_.l_col_ptr.clear();
+    }
+
+    analysis_.analyzed = true;
+    analysis_.n_analyses++;
+}
+
+void
+SparseDirectSolver::factorize_(const SparseDirectSolver::matrix_t& A)const{
+
+    if(!same_pattern_(A)){
+        analyze_(A);
+    }
+
+    if(config_.dstype == DirectSolverType::CHOLESKY){
+        cholesky_numeric_(A);
+        factors_.n_factorizations++;
+    }
+    else{
+        lu_numeric_(A);
+    }
+
+    factors_.factorized = true;
+}
+
+void
+SparseDirectSolver::cholesky_symbolic_()const{
+
+    const uint_t n = analysis_.n;
+    const auto& row_ptr = analysis_.row_ptr;
+    const auto& columns = analysis_.columns;
+    const auto& perm = analysis_.permutation;
+    const auto& iperm = analysis_.inverse_permutation;
+
+    // the elimination tree of the permuted matrix. Row k
+    // of the permuted matrix is row perm[k] of A and its
+    // entries left of the diagonal are those of column k
+    auto& parent = analysis_.parent;
+    parent.assign(n, NONE);
+    std::vector<uint_t> ancestor(n, NONE);
+
+    for(uint_t k=0; k<n; ++k){
+
+        const uint_t r = perm[k];
+
+        for(uint_t p=row_ptr[r]; p<row_ptr[r + 1]; ++p){
+
+            uint_t i = iperm[columns[p]];
+
+            // follow the path to the root of the
+            // subtree of i and compress it to k
+            while(i != NONE && i < k){
+
+                const uint_t next = ancestor[i];
+                ancestor[i] = k;
+
+                if(next == NONE){
+                    parent[i] = k;
+                }
+
+                i = next;
+            }
+        }
+    }
+
+    // the column counts of L from the row patterns
+    std::vector<uint_t> counts(n, 1);
+    std::vector<uint_t> stack(n);
+    std::vector<uint_t> path(n);
+    std::vector<uint_t> mark(n, 0);
+
+    for(uint_t k=0; k<n; ++k){
+
+        const uint_t r = perm[k];
+        const uint_t top = ereach(k, row_ptr[r], row_ptr[r + 1], columns,
+                                  iperm, parent, stack, path, mark);
+
+        for(uint_t t=top; t<n; ++t){
+            counts[stack[t]]++;
+        }
+    }
+
+    auto& l_col_ptr = analysis_.l_col_ptr;
+    l_col_ptr.assign(n + 1, 0);
+
+    for(uint_t k=0; k<n; ++k){
+        l_col_ptr[k + 1] = l_col_ptr[k] + counts[k];
+    }
+}
+
+void
+SparseDirectSolver::cholesky_numeric_(const SparseDirectSolver::matrix_t& A)const{
+
+    const uint_t n = analysis_.n;
+    const auto& row_ptr = analysis_.row_ptr;
+    const auto& columns = analysis_.columns;
+    const auto& perm = analysis_.permutation;
+    const auto& iperm = analysis_.inverse_permutation;
+    const auto values = csr_values(A);
+
+    factors_.l_col_ptr = analysis_.l_col_ptr;
+    factors_.l_rows.resize(factors_.l_col_ptr[n]);
+    factors_.l_values.resize(factors_.l_col_ptr[n]);
+
+    const auto& lp = factors_.l_col_ptr;
+    auto& li = factors_.l_rows;
+    auto& lx = factors_.l_values;
+
+    // the next free position of every column of L
+    std::vector<uint_t> fill(lp.begin(), lp.end() - 1);
+
+    std::vector<real_t> x(n, 0.0);
+    std::vector<uint_t> stack(n);
+    std::vector<uint_t> path(n);
+    std::vector<uint_t> mark(n, 0);
+
+    for(uint_t k=0; k<n; ++k){
+
+        const uint_t r = perm[k];
+        const uint_t top = ereach(k, row_ptr[r], row_ptr[r + 1], columns,
+                                  iperm, analysis_.parent, stack, path, mark);
+
+        for(uint_t p=row_ptr[r]; p<row_ptr[r + 1]; ++p){
+
+            const uint_t i = iperm[columns[p]];
+
+            if(i <= k){
+                x[i] = values[p];
+            }
+        }
+
+        real_t diagonal = x[k];
+        x[k] = 0.0;
+
+        // solve L(0:k-1, 0:k-1)*l = A(0:k-1, k) for row k of L
+        for(uint_t t=top; t<n; ++t){
+
+            const uint_t i = stack[t];
+            const real_t lki = x[i]/lx[lp[i]];
+            x[i] = 0.0;
+
+            for(uint_t p=lp[i] + 1; p<fill[i]; ++p){
+                x[li[p]] -= lx[p]*lki;
+            }
+
+            diagonal -= lki*lki;
+
+            const uint_t p = fill[i]++;
+            li[p] = k;
+            lx[p] = lki;
+        }
+
+        if(diagonal <= 0.0){
+            factors_.factorized = false;
+            throw std::logic_error("Matrix is not positive definite. Cholesky factorization failed at pivot " +
+                                   std::to_string(k));
+        }
+
+        const uint_t p = fill[k]++;
+        li[p] = k;
+        lx[p] = std::sqrt(diagonal);
+    }
+}
+
+void
+SparseDirectSolver::lu_numeric_(const SparseDirectSolver::matrix_t& A)const{
+
+    const uint_t n = analysis_.n;
+    const auto& q = analysis_.permutation;
+
+    // the column-wise copy of A
+    std::vector<uint_t> col_ptr(n + 1, 0);
+    std::vector<uint_t> rows(A.nonZeros());
+    std::vector<real_t> values(A.nonZeros());
+
+    for(auto c : analysis_.columns){
+        col_ptr[c + 1]++;
+    }
+
+    for(uint_t c=0; c<n; ++c){
+        col_ptr[c + 1] += col_ptr[c];
+    }
+
+    {
+        std::vector<uint_t> next(col_ptr.begin(), col_ptr.end() - 1);
+
+        for(uint_t r=0; r<n; ++r){
+            for(auto it = A.cbegin(r); it != A.cend(r); ++it){
+
+                const uint_t p = next[it->index()]++;
+                rows[p] = r;
+                values[p] = it->value();
+            }
+        }
+    }
+
+    // try to reuse the pivot sequence of the previous factors
+    if(factors_.factorized && lu_refactor_(col_ptr, rows, values)){
+        factors_.n_refactorizations++;
+        return;
+    }
+
+    factors_.factorized = false;
+
+    auto& lp = factors_.l_col_ptr;
+    auto& li = factors_.l_rows;
+    auto& lx = factors_.l_values;
+    auto& up = factors_.u_col_ptr;
+    auto& ui = factors_.u_rows;
+    auto& ux = factors_.u_values;
+    auto& pinv = factors_.pivot_of_row;
+
+    const uint_t capacity = std::max(li.size(), 4*rows.size() + n);
+
+    lp.assign(n + 1, 0);
+    up.assign(n + 1, 0);
+    li.clear();
+    lx.clear();
+    ui.clear();
+    ux.clear();
+    li.reserve(capacity);
+    lx.reserve(capacity);
+    ui.reserve(capacity);
+    ux.reserve(capacity);
+    pinv.assign(n, NONE);
+
+    std::vector<real_t> x(n, 0.0);
+    std::vector<uint_t> xi(n);
+    std::vector<uint_t> stack(n);
+    std::vector<uint_t> pstack(n);
+    std::vector<char> marked(n, 0);
+
+    for(uint_t k=0; k<n; ++k){
+
+        lp[k] = li.size();
+        up[k] = ui.size();
+
+        const uint_t col = q[k];
+
+        // the nonzero pattern of x = L\A(:, col) in
+        // xi[top, n) in topological order. The rows of
+        // L are still the rows of A at this point
+        uint_t top = n;
+
+        for(uint_t p=col_ptr[col]; p<col_ptr[col + 1]; ++p){
+
+            if(marked[rows[p]]){
+                continue;
+            }
+
+            // non-recursive depth first search
+            std::ptrdiff_t head = 0;
+            stack[0] = rows[p];
+
+            while(head >= 0){
+
+                const uint_t j = stack[head];
+                const uint_t jpiv = pinv[j];
+
+                if(!marked[j]){
+                    marked[j] = 1;
+                    pstack[head] = jpiv == NONE ? 0 : lp[jpiv] + 1;
+                }
+
+                const uint_t end = jpiv == NONE ? 0 : lp[jpiv + 1];
+                bool done = true;
+
+                for(uint_t c=pstack[head]; c<end; ++c){
+
+                    const uint_t i = li[c];
+
+                    if(marked[i]){
+                        continue;
+                    }
+
+                    pstack[head] = c + 1;
+                    stack[++head] = i;
+                    done = false;
+                    break;
+                }
+
+                if(done){
+                    --head;
+                    xi[--top] = j;
+                }
+            }
+        }
+
+        for(uint_t p=col_ptr[col]; p<col_ptr[col + 1]; ++p){
+            x[rows[p]] = values[p];
+        }
+
+        // the sparse triangular solve with the unit diagonal L
+        for(uint_t t=top; t<n; ++t){
+
+            const uint_t j = xi[t];
+            const uint_t jpiv = pinv[j];
+
+            if(jpiv == NONE){
+                continue;
+            }
+
+            for(uint_t c=lp[jpiv] + 1; c<lp[jpiv + 1]; ++c){
+                x[li[c]] -= lx[c]*x[j];
+            }
+        }
+
+        // the entries of the pivotal rows go to U.
+        // The pivot is the largest of the remaining entries
+        // unless the diagonal entry is large enough
+        uint_t ipiv = NONE;
+        real_t largest = -1.0;
+
+        for(uint_t t=top; t<n; ++t){
+
+            const uint_t i = xi[t];
+
+            if(pinv[i] == NONE){
+
+                if(std::abs(x[i]) > largest){
+                    largest = std::abs(x[i]);
+                    ipiv = i;
+                }
+            }
+            else{
+                ui.push_back(pinv[i]);
+                ux.push_back(x[i]);
+            }
+        }
+
+        if(ipiv == NONE || largest <= 0.0){
+
+            for(uint_t t=top; t<n; ++t){
+                marked[xi[t]] = 0;
+                x[xi[t]] = 0.0;
+            }
+
+            throw std::logic_error("Matrix is singular. LU factorization failed at column " +
+                                   std::to_string(k));
+        }
+
+        if(pinv[col] == NONE && marked[col] &&
+           std::abs(x[col]) >= config_.pivot_tolerance*largest){
+            ipiv = col;
+        }
+
+        const real_t pivot = x[ipiv];
+        ui.push_back(k);
+        ux.push_back(pivot);
+        pinv[ipiv] = k;
+
+        li.push_back(ipiv);
+        lx.push_back(1.0);
+
+        for(uint_t t=top; t<n; ++t){
+
+            const uint_t i = xi[t];
+
+            if(pinv[i] == NONE){
+                li.push_back(i);
+                lx.push_back(x[i]/pivot);
+            }
+
+            x[i] = 0.0;
+            marked[i] = 0;
+        }
+    }
+
+    lp[n] = li.size();
+    up[n] = ui.size();
+
+    // the rows of L in pivot order
+    for(auto& i : li){
+        i = pinv[i];
+    }
+
+    factors_.n_factorizations++;
+}
+
+bool
+SparseDirectSolver::lu_refactor_(const std::vector<uint_t>& col_ptr, const std::vector<uint_t>& rows,
+                                 const std::vector<real_t>& values)const{
+
+    const uint_t n = analysis_.n;
+    const auto& q = analysis_.permutation;
+    const auto& lp = factors_.l_col_ptr;
+    const auto& li = factors_.l_rows;
+    auto& lx = factors_.l_values;
+    const auto& up = factors_.u_col_ptr;
+    const auto& ui = factors_.u_rows;
+    auto& ux = factors_.u_values;
+    const auto& pinv = factors_.pivot_of_row;
+
+    // x is indexed by the pivot position. The entries of a column
+    // of U are stored in the order of the original triangular solve
+    std::vector<real_t> x(n, 0.0);
+
+    for(uint_t k=0; k<n; ++k){
+
+        const uint_t col = q[k];
+
+        for(uint_t p=col_ptr[col]; p<col_ptr[col + 1]; ++p){
+            x[pinv[rows[p]]] = values[p];
+        }
+
+        for(uint_t p=up[k]; p<up[k + 1] - 1; ++p){
+
+            const uint_t j = ui[p];
+            const real_t ujk = x[j];
+            x[j] = 0.0;
+            ux[p] = ujk;
+
+            for(uint_t c=lp[j] + 1; c<lp[j + 1]; ++c){
+                x[li[c]] -= lx[c]*ujk;
+            }
+        }
+
+        const real_t pivot = x[k];
+        x[k] = 0.0;
+
+        real_t largest = std::abs(pivot);
+        for(uint_t c=lp[k] + 1; c<lp[k + 1]; ++c){
+            largest = std::max(largest, std::abs(x[li[c]]));
+        }
+
+        if(pivot == 0.0 || std::abs(pivot) < config_.pivot_tolerance*largest){
+
+            for(uint_t c=lp[k] + 1; c<lp[k + 1]; ++c){
+                x[li[c]] = 0.0;
+            }
+
+            return false;
+        }
+
+        ux[up[k + 1] - 1] = pivot;
+
+        for(uint_t c=lp[k] + 1; c<lp[k + 1]; ++c){
+            lx[c] = x[li[c]]/pivot;
+            x[li[c]] = 0.0;
+        }
+    }
+
+    return true;
+}
+
+void
+SparseDirectSolver::solve(SparseDirectSolver::vector_t& x,
+                          const SparseDirectSolver::vector_t& b)const{
+
+    if(!factors_.factorized){
+        throw std::logic_error("SparseDirectSolver: the matrix has not been factorized");
+    }
+
+    const uint_t n = analysis_.n;
+
+    if(x.size() != n || b.size() != n){
+        throw std::logic_error("Invalid Matrix-Vector size");
+    }
+
+    const auto& lp = factors_.l_col_ptr;
+    const auto& li = factors_.l_rows;
+    const auto& lx = factors_.l_values;
+    const auto& perm = analysis_.permutation;
+
+    std::vector<real_t> y(n);
+
+    if(config_.dstype == DirectSolverType::CHOLESKY){
+
+        for(uint_t k=0; k<n; ++k){
+            y[k] = b[perm[k]];
+        }
+
+        // L*z = y
+        for(uint_t j=0; j<n; ++j){
+
+            y[j] /= lx[lp[j]];
+
+            for(uint_t p=lp[j] + 1; p<lp[j + 1]; ++p){
+                y[li[p]] -= lx[p]*y[j];
+            }
+        }
+
+        // L^T*w = z
+        for(uint_t j=n; j-- > 0; ){
+
+            for(uint_t p=lp[j] + 1; p<lp[j + 1]; ++p){
+                y[j] -= lx[p]*y[li[p]];
+            }
+
+            y[j] /= lx[lp[j]];
+        }
+    }
+    else{
+
+        const auto& up = factors_.u_col_ptr;
+        const auto& ui = factors_.u_rows;
+        const auto& ux = factors_.u_values;
+        const auto& pinv = factors_.pivot_of_row;
+
+        for(uint_t i=0; i<n; ++i){
+            y[pinv[i]] = b[i];
+        }
+
+        // L*z = P*b with the unit diagonal L
+        for(uint_t j=0; j<n; ++j){
+            for(uint_t p=lp[j] + 1; p<lp[j + 1]; ++p){
+                y[li[p]] -= lx[p]*y[j];
+            }
+        }
+
+        // U*w = z
+        for(uint_t j=n; j-- > 0; ){
+
+            y[j] /= ux[up[j + 1] - 1];
+
+            for(uint_t p=up[j]; p<up[j + 1] - 1; ++p){
+                y[ui[p]] -= ux[p]*y[j];
+            }
+        }
+    }
+
+    for(uint_t k=0; k<n; ++k){
+        x[perm[k]] = y[k];
+    }
+}
+
+}
+}
+}
@@ -0,0 +1,235 @@
+#ifndef SPARSE_DIRECT_SOLVER_H
+#define SPARSE_DIRECT_SOLVER_H
+
+#include "kernel/base/types.h"
+#include "kernel/numerics/direct_solvers/direct_solver_base.h"
+#include "kernel/numerics/direct_solvers/direct_solver_type.h"
+
+#include <vector>
+
+namespace kernel{
+namespace maths {
+namespace solvers {
+
+///
+/// \brief The FillReducingOrdering enum. The ordering
+/// applied to the matrix before the factorization
+///
+enum class FillReducingOrdering{NATURAL, AMD};
+
+///
+/// \brief The SparseDirectSolverConfig struct. Helper struct
+/// that wraps parameters to be passed to the SparseDirectSolver class
+///
+struct SparseDirectSolverConfig
+{
+
+    ///
+    /// \brief dstype. LU or CHOLESKY. CHOLESKY
+    /// requires a symmetric positive definite matrix
+    ///
+    DirectSolverType dstype{DirectSolverType::LU};
+
+    ///
+    /// \brief ordering. The fill-reducing ordering
+    ///
+    FillReducingOrdering ordering{FillReducingOrdering::AMD};
+
+    ///
+    /// \brief pivot_tolerance. The LU factorization keeps the diagonal
+    /// entry as pivot if its magnitude is at least pivot_tolerance times
+    /// the largest entry of the column. A refactorization that
+    /// violates this falls back to a new pivot sequence
+    ///
+    real_t pivot_tolerance{0.1};
+};
+
+///
+/// \brief The SparseDirectSolver class. Solves A*x=b for a sparse
+/// matrix with a sparse LU or Cholesky factorization. The solution
+/// is split in three phases:
+///
+/// - analyze() computes the fill-reducing ordering and the symbolic
+///   factorization. This depends only on the sparsity pattern of A.
+/// - factorize() computes the numeric factors. Calling it again for a
+///   matrix with the same pattern reuses the analysis. The LU
+///   factorization also reuses the pivot sequence and the patterns of
+///   the factors of the previous factorization when the pivots remain
+///   acceptable.
+/// - solve(x, b) uses the factors. It can be called for many right-hand sides.
+///
+/// solve(A, x, b) performs the three phases and analyzes the matrix only
+/// if its pattern differs from the analyzed one. This suits the repeated
+/// solves of systems with a fixed pattern, e.g. time stepping. The LU
+/// factorization is the left-looking algorithm of Gilbert and Peierls with
+/// threshold partial pivoting. The Cholesky factorization is the up-looking
+/// algorithm driven by the elimination tree. Both are serial
+///
+class SparseDirectSolver: public DirectSolverBase<SparseMatrix<real_t>, DynVec<real_t>>
+{
+public:
+
+    ///
+    /// \brief matrix_t The matrix type the solver is using
+    ///
+    typedef typename DirectSolverBase<SparseMatrix<real_t>, DynVec<real_t>>::matrix_t matrix_t;
+
+    ///
+    /// \brief vector_t The vector type the solver is using
+    ///
+    typedef typename DirectSolverBase<SparseMatrix<real_t>, DynVec<real_t>>::vector_t vector_t;
+
+    ///
+    /// \brief SparseDirectSolver Constructor. Throws std::logic_error
+    /// if the direct solver type is not LU or CHOLESKY
+    ///
+    explicit SparseDirectSolver(const SparseDirectSolverConfig& config);
+
+    ///
+    /// \brief solve. Solve the system Ax=b. The analysis is reused
+    /// if A has the pattern of the analyzed matrix. The analysis and
+    /// the factors are cached in the solver
+    ///
+    virtual void solve(const matrix_t& A, vector_t& x, const vector_t& b )const override final;
+
+    ///
+    /// \brief solve. Solve the system Ax=b with the
+    /// current factors. Throws std::logic_error if the
+    /// matrix has not been factorized
+    ///
+    void solve(vector_t& x, const vector_t& b)const;
+
+    ///
+    /// \brief analyze. Compute the ordering and the symbolic
+    /// factorization of A. Throws std::logic_error if A is not square
+    ///
+    void analyze(const matrix_t& A);
+
+    ///
+    /// \brief factorize. Compute the numeric factorization of A. A
+    /// is analyzed first if its pattern differs from the analyzed one.
+    /// Throws std::logic_error if A is singular or, for CHOLESKY,
+    /// not positive definite
+    ///
+    void factorize(const matrix_t& A);
+
+    ///
+    /// \brief is_analyzed. Returns true if a matrix has been analyzed
+    ///
+    bool is_analyzed()const{return analysis_.analyzed;}
+
+    ///
+    /// \brief is_factorized. Returns true if a matrix has been factorized
+    ///
+    bool is_factorized()const{return factors_.factorized;}
+
+    ///
+    /// \brief n_factor_nonzeros. The number of nonzeros of L + U, or of L for CHOLESKY
+    ///
+    uint_t n_factor_nonzeros()const;
+
+    ///
+    /// \brief permutation. The fill-reducing ordering of the rows and columns
+    ///
+    const std::vector<uint_t>& permutation()const{return analysis_.permutation;}
+
+    ///
+    /// \brief n_analyses. The number of symbolic analyses performed
+    ///
+    uint_t n_analyses()const{return analysis_.n_analyses;}
+
+    ///
+    /// \brief n_factorizations. The number of factorizations that
+    /// computed a new pivot sequence and new patterns of the factors
+    ///
+    uint_t n_factorizations()const{return factors_.n_factorizations;}
+
+    ///
+    /// \brief n_refactorizations. The number of factorizations that
+    /// reused the pivot sequence and the patterns of the previous factors
+    ///
+    uint_t n_refactorizations()const{return factors_.n_refactorizations;}
+
+private:
+
+    ///
+    /// \brief The result of the symbolic analysis
+    ///
+    struct Analysis
+    {
+        bool analyzed{false};
+        uint_t n{0};
+        uint_t n_analyses{0};
+
+        /// \brief The pattern of the analyzed matrix
+        std::vector<uint_t> row_ptr;
+        std::vector<uint_t> columns;
+
+        /// \brief The ordering and its inverse
+        std::vector<uint_t> permutation;
+        std::vector<uint_t> inverse_permutation;
+
+        /// \brief The elimination tree and the column
+        /// pointers of L. Used by the Cholesky factorization
+        std::vector<uint_t> parent;
+        std::vector<uint_t> l_col_ptr;
+    };
+
+    ///
+    /// \brief The numeric factors stored column-wise.
+    /// The diagonal is the first entry of a column of L
+    /// and the last entry of a column of U
+    ///
+    struct Factors
+    {
+        bool factorized{false};
+        uint_t n_factorizations{0};
+        uint_t n_refactorizations{0};
+
+        std::vector<uint_t> l_col_ptr;
+        std::vector<uint_t> l_rows;
+        std::vector<real_t> l_values;
+
+        std::vector<uint_t> u_col_ptr;
+        std::vector<uint_t> u_rows;
+        std::vector<real_t> u_values;
+
+        /// \brief The pivot position of every row of A in the LU factorization
+        std::vector<uint_t> pivot_of_row;
+    };
+
+    ///
+    /// \brief config_ Configuration of the solver
+    ///
+    SparseDirectSolverConfig config_;
+
+    ///
+    /// \brief analysis_ The symbolic analysis. Mutable as
+    /// it is a cache updated by solve(A, x, b)
+    ///
+    mutable Analysis analysis_;
+
+    ///
+    /// \brief factors_ The numeric factors. Mutable as
+    /// they are a cache updated by solve(A, x, b)
+    ///
+    mutable Factors factors_;
+
+    void analyze_(const matrix_t& A)const;
+    void factorize_(const matrix_t& A)const;
+    bool same_pattern_(const matrix_t& A)const;
+
+    void cholesky_symbolic_()const;
+    void cholesky_numeric_(const matrix_t& A)const;
+
+    void lu_numeric_(const matrix_t& A)const;
+    bool lu_refactor_(const std::vector<uint_t>& col_ptr, const std::vector<uint_t>& rows,
+                      const std::vector<real_t>& values)const;
+
+};
+
+}
+}
+}
+
+#endif // SPARSE_DIRECT_SOLVER_H
@@ -6,6 +6,7 @@
 
 #include "kernel/numerics/fvm/fv_convection_assemble_policy.h"
 #include "kernel/numerics/fvm/fv_interpolate_base.h"
+#include "kernel/numerics/fvm/fv_matrix_free_operator.h"
 
 #include "kernel/numerics/boundary_function_base.h"
 #include "kernel/numerics/boundary_conditions_type.h"
@@ -255,6 +256,99 @@ FVConvectionAssemblyPolicy<dim>::apply_boundary_conditions(const  std::vector<ui
 
 #endif
 
+template<int dim>
+void
+FVConvectionAssemblyPolicy<dim>::assemble(FVMatrixFreeOperator<dim>& mat, FVMatrixFreeVector& /*x*/, FVMatrixFreeVector& b ){
+
+    if(!mat.is_assembled()){
+
+        // loop over the elements
+        ConstElementMeshIterator<Active, Mesh<dim>> filter(*m_ptr_);
+
+        auto elem_itr = filter.begin();
+        auto elem_itr_e = filter.end();
+
+        for(; elem_itr != elem_itr_e; ++elem_itr){
+
+            auto* elem = *elem_itr;
+
+            reinit(*elem);
+            assemble_one_element(mat);
+        }
+
+        mat.fill_completed();
+    }
+
+    mat.add_source_terms(b);
+}
+
+template<int dim>
+void
+FVConvectionAssemblyPolicy<dim>::assemble_one_element(FVMatrixFreeOperator<dim>& mat){
+
+    const uint_t row = cell_dofs_[0].id;
+    mat.set_row_volume(row, elem_->volume());
+
+    std::map<uint_t, real_t> fluxes;
+    fluxes[row] = 0.0;
+
+    for(uint_t n=0; n<neigh_dofs_.size(); ++n){
+        fluxes[neigh_dofs_[n].id] = 0.0;
+    }
+
+    fv_interpolate_->compute_matrix_contributions(*elem_, fluxes);
+
+    mat.add_diagonal(row, fluxes[row]);
+
+    // index of the neighbor dofs
+    uint_t neigh_idx = 0;
+
+    for(uint_t f=0; f < elem_->n_faces(); ++f){
+
+        const auto& face = elem_->get_face(f);
+
+        if(!face.on_boundary()){
+
+            const uint_t col = neigh_dofs_[neigh_idx].id;
+            mat.add_face_entry(face.get_id(), row, col, fluxes[col]);
+            neigh_idx++;
+            continue;
+        }
+
+        if(boundary_func_ == nullptr){
+            continue;
+        }
+
+        BCType type = boundary_func_->bc_type(face.boundary_indicator());
+
+        switch(type){
+        case BCType::DIRICHLET:
+        {
+            real_t bc_val = boundary_func_->value(face.centroid());
+            mat.add_source(row, -fluxes_[f]*bc_val);
+            break;
+        }
+        case BCType::ZERO_DIRICHLET:
+        {
+            break;
+        }
+        case BCType::ZERO_NEUMANN:
+        {
+            mat.add_diagonal(row, fluxes_[f]);
+            break;
+        }
+        default:
+        {
+            throw std::logic_error("Invalid boundary condition type");
+        }
+        }
+    }
+
+    if(rhs_func_ != nullptr){
+        mat.add_source(row, rhs_func_->value(elem_->centroid())*elem_->volume());
+    }
+}
+
 template class FVConvectionAssemblyPolicy<1>;
 template class FVConvectionAssemblyPolicy<2>;
 template class FVConvectionAssemblyPolicy<3>;
@@ -8,6 +8,9 @@
 #include "kernel/base/types.h"
 #include "kernel/discretization/dof.h"
 
+#include <vector>
+#include <memory>
+
 namespace kernel{
 namespace numerics{
 
@@ -20,6 +23,9 @@ template<int dim> class BoundaryFunctionBase;
 template<int dim> class NumericScalarFunction;
 template<int dim> class NumericVectorFunctionBase;
 
+template<int dim> class FVMatrixFreeOperator;
+class FVMatrixFreeVector;
+
 #ifdef USE_TRILINOS
 class TrilinosEpetraMatrix;
 class TrilinosEpetraVector;
@@ -55,6 +61,15 @@ public:
 
 #endif
 
+    /// \brief Assemble the terms of the matrix-free operator. The
+    /// cached terms of the operator are assembled only when the
+    /// operator is not assembled. The source terms are added to b
+    void assemble(FVMatrixFreeOperator<dim>& mat, FVMatrixFreeVector& x, FVMatrixFreeVector& b );
+
+    /// \brief Add the contribution of one element to
+    /// the cached terms of the matrix-free operator
+    void assemble_one_element(FVMatrixFreeOperator<dim>& mat);
+
     /// \brief Compute the fluxes over the cell last
     /// reinitialized
     void compute_fluxes();
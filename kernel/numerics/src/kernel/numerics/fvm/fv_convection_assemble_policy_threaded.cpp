@@ -0,0 +1,126 @@
+#include "kernel/base/config.h"
+
+#ifdef USE_FVM
+
+#include "kernel/numerics/fvm/fv_convection_assemble_policy_threaded.h"
+#include "kernel/parallel/threading/thread_pool.h"
+#include "kernel/parallel/threading/openmp_executor.h"
+#include <exception>
+
+namespace kernel{
+namespace numerics{
+
+template<int dim, typename Executor>
+
+FVConvectionAssemblyPolicyThreaded<dim, Executor>::FVConvectionAssemblyPolicyThreaded()
+    :
+    fv_interpolate_(),
+    dof_manager_(nullptr),
+    boundary_func_(nullptr),
+    rhs_func_(nullptr),
+    volume_func_(nullptr),
+    m_ptr_(nullptr),
+    element_ranges_(),
+    tasks_(),
+    executor_(nullptr)
+{}
+
+template<int dim, typename Executor>
+void
+FVConvectionAssemblyPolicyThreaded<dim, Executor>::set_mesh(const Mesh<dim>& mesh){
+
+    m_ptr_ = &mesh;
+    element_ranges_.clear();
+}
+
+template<int dim, typename Executor>
+void
+FVConvectionAssemblyPolicyThreaded<dim, Executor>::set_executor(executot_t& executor){
+
+    executor_ = &executor;
+
+    // the number of tasks may have changed
+    element_ranges_.clear();
+    tasks_.clear();
+}
+
+template<int dim, typename Executor>
+void
+FVConvectionAssemblyPolicyThreaded<dim, Executor>::update_element_ranges(){
+
+    if(m_ptr_ == nullptr){
+        throw std::logic_error("Mesh pointer is not set");
+    }
+
+    if(executor_ == nullptr){
+        throw std::logic_error("Executor is not set");
+    }
+
+    element_ranges_partition(*m_ptr_, executor_->n_processing_elements(), element_ranges_);
+}
+
+
+#ifdef USE_TRILINOS
+
+template<int dim, typename Executor>
+void
+FVConvectionAssemblyPolicyThreaded<dim, Executor>::assemble(TrilinosEpetraMatrix& mat, TrilinosEpetraVector& x, TrilinosEpetraVector& b ){
+
+
+    if(m_ptr_ == nullptr){
+        throw std::logic_error("Mesh pointer is not set");
+    }
+
+    if(executor_ == nullptr){
+        throw std::logic_error("Executor is not set");
+    }
+
+    if(dof_manager_ == nullptr){
+        throw std::logic_error("DoF manager is not set");
+    }
+
+    if(element_ranges_.empty()){
+        update_element_ranges();
+    }
+
+    typedef AssembleTask<TrilinosEpetraMatrix, TrilinosEpetraVector> task_t;
+
+    if(tasks_.empty()){
+
+        tasks_.reserve(element_ranges_.size());
+
+        for(uint_t t=0; t<element_ranges_.size(); ++t){
+            tasks_.push_back(std::make_unique<task_t>(t, *this));
+        }
+    }
+    else{
+
+        for(uint_t t=0; t<tasks_.size(); ++t){
+            tasks_[t]->reschedule();
+        }
+    }
+
+    // the tasks are reused so the system
+    // may be different from the last call
+    for(uint_t t=0; t<tasks_.size(); ++t){
+        static_cast<task_t*>(tasks_[t].get())->set_data(mat, b, x);
+    }
+
+    /// this should block
+    executor_->execute(tasks_, typename Executor::default_options_t());
+
+}
+#endif
+
+template class FVConvectionAssemblyPolicyThreaded<1, ThreadPool>;
+template class FVConvectionAssemblyPolicyThreaded<2, ThreadPool>;
+//template class FVConvectionAssemblyPolicyThreaded<3, ThreadPool>;
+
+template class FVConvectionAssemblyPolicyThreaded<1, OMPExecutor>;
+template class FVConvectionAssemblyPolicyThreaded<2, OMPExecutor>;
+//template class FVConvectionAssemblyPolicyThreaded<3, OMPExecutor>;
+
+}
+}
+
+#endif
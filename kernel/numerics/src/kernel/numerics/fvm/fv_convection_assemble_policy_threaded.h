@@ -0,0 +1,440 @@
+#ifndef FV_CONVECTION_ASSEMBLE_POLICY_THREADED_H
+#define FV_CONVECTION_ASSEMBLE_POLICY_THREADED_H
+
+#include "kernel/base/config.h"
+
+#ifdef USE_FVM
+
+#include "kernel/base/types.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/face_element.h"
+#include "kernel/discretization/element_mesh_iterator.h"
+#include "kernel/discretization/mesh_predicates.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/dof.h"
+#include "kernel/discretization/dof_manager.h"
+#include "kernel/numerics/boundary_conditions_type.h"
+#include "kernel/numerics/boundary_function_base.h"
+#include "kernel/numerics/fvm/fv_interpolate_base.h"
+#include "kernel/maths/functions/numeric_scalar_function.h"
+
+#include "kernel/parallel/threading/simple_task.h"
+#include "kernel/parallel/utilities/element_ranges_partitioner.h"
+
+#ifdef USE_TRILINOS
+#include "kernel/maths/trilinos_epetra_matrix.h"
+#include "kernel/maths/trilinos_epetra_vector.h"
+#endif
+#include <vector>
+#include <string>
+#include <memory>
+
+
+namespace kernel {
+namespace numerics {
+
+/// forward declarations
+template<int dim> class FVInterpolateBase;
+template<int dim> class Element;
+template<int dim> class Mesh;
+template<int dim> class FVDoFManager;
+template<int dim> class BoundaryFunctionBase;
+template<int dim> class NumericScalarFunction;
+
+#ifdef USE_TRILINOS
+class TrilinosEpetraMatrix;
+class TrilinosEpetraVector;
+#endif
+
+/// \brief Policy that assembles convection terms
+/// on a user specified mesh using user specified
+/// interpolation scheme. Every task of the executor works on
+/// a list of elements that is computed once, see
+/// element_ranges_partition(). FV cells write only into
+/// the matrix row and the rhs entry of their own DoF so
+/// the tasks never write to the same row and no locking
+/// or coloring is needed.
+template<int dim, typename Executor>
+class FVConvectionAssemblyPolicyThreaded
+{
+public:
+
+    /// \brief The executor of the policy
+    typedef Executor executot_t;
+
+    /// \brief Constructor
+    FVConvectionAssemblyPolicyThreaded();
+
+#ifdef USE_TRILINOS
+
+    /// \brief Assemble the data
+    void assemble(TrilinosEpetraMatrix& mat, TrilinosEpetraVector& x, TrilinosEpetraVector& b );
+
+#endif
+
+    /// \brief Set the function that describes the boundary conditions
+    void set_boundary_function(const BoundaryFunctionBase<dim>& func){boundary_func_ = &func;}
+
+    /// \brief Set the function that describes the boundary conditions
+    void set_rhs_function(const NumericScalarFunction<dim>& func){rhs_func_ = &func;}
+
+    /// \brief Set the function that describes the boundary conditions
+    void set_volume_term_function(const NumericScalarFunction<dim>& func){volume_func_ = &func;}
+
+    /// \brief Set the object that describes the dofs
+    void set_dof_manager(const FVDoFManager<dim>& dof_manager){dof_manager_ = &dof_manager;}
+
+    /// \brief Set the mesh pointer. The element
+    /// ranges are recomputed at the next assembly
+    void set_mesh(const Mesh<dim>& mesh);
+
+    /// \brief Set the executor
+    void set_executor(executot_t& executor);
+
+    /// \brief Recompute the element ranges of the tasks. Call this
+    /// when the active elements or their pids change
+    void update_element_ranges();
+
+    /// \brief The elements the given task works on
+    const std::vector<const Element<dim>*>& get_element_range(uint_t t)const{return element_ranges_[t];}
+
+    /// \brief Return the interpolation pointer
+    std::shared_ptr<FVInterpolateBase<dim>> get_interpolation(){return fv_interpolate_;}
+
+    /// \brief Build the  interpolation scheme
+    template<typename Factory>
+    void build_interpolate_scheme(const Factory& factory);
+
+private:
+
+    template<typename MatrixTp, typename VectorTp>
+    struct AssembleTask;
+
+    /// \brief Pointer to the FV interpolation
+    std::shared_ptr<FVInterpolateBase<dim>> fv_interpolate_;
+
+    /// \brief The DoFManager that handles the dofs
+    const FVDoFManager<dim>* dof_manager_;
+
+    /// \brief The boundary function used
+    const BoundaryFunctionBase<dim>* boundary_func_;
+
+    /// \brief Pointer to the function object that describes the
+    /// rhs
+    const NumericScalarFunction<dim>* rhs_func_;
+
+    /// \brief Pointer to the function object that describes the
+    /// any volume terms to assemble
+    const NumericScalarFunction<dim>* volume_func_;
+
+    /// \brief The Mesh over which the policy is working
+    const Mesh<dim>* m_ptr_;
+
+    /// \brief The elements every task works on
+    std::vector<std::vector<const Element<dim>*>> element_ranges_;
+
+    /// \brief The tasks
+    std::vector<std::unique_ptr<TaskBase>> tasks_;
+
+    /// \brief Pointer to the executor
+    executot_t* executor_;
+};
+
+template<int dim, typename Executor>
+template<typename Factory>
+void
+FVConvectionAssemblyPolicyThreaded<dim, Executor>::build_interpolate_scheme(const Factory& factory){
+
+    fv_interpolate_ = factory();
+}
+
+template<int dim, typename Executor>
+template<typename MatrixTp, typename VectorTp>
+struct FVConvectionAssemblyPolicyThreaded<dim, Executor>::AssembleTask: public SimpleTaskBase<Null>
+{
+
+public:
+
+    typedef MatrixTp matrix_t;
+    typedef VectorTp vector_t;
+    typedef FVConvectionAssemblyPolicyThreaded<dim, Executor> policy_t;
+
+    /// \brief Constructor
+    AssembleTask(uint_t t, const policy_t& policy);
+
+    /// \brief Set the linear system the task assembles
+    void set_data(matrix_t& mat, vector_t& b, vector_t& x);
+
+    /// \brief Compute the fluxes over the cell last
+    /// reinitialized
+    void compute_fluxes();
+
+    /// \brief Apply the boundary conditions
+    void apply_boundary_conditions(const  std::vector<uint_t>& bfaces );
+
+    /// \brief assemble one element contribution
+    void assemble_one_element();
+
+    /// \brief Reinitialize the policy
+    void reinit(const Element<dim>& element);
+
+    /// \brief initialize dofs
+    void initialize_dofs();
+
+protected:
+
+    virtual void run()override final;
+
+    /// \brief The policy that owns the task
+    const policy_t* policy_;
+
+    /// \brief The matrix to assemble
+    matrix_t* mat_;
+
+    /// \brief The rhs
+    vector_t* b_;
+
+    /// \brief The solution
+    vector_t* x_;
+
+    /// \brief The element over which the policy is working
+    const Element<dim>* elem_;
+
+    /// \brief The dofs of the neighbors of the cell we do work on
+    std::vector<DoF> neigh_dofs_;
+
+    /// \brief The dofs of the cell
+    std::vector<DoF> cell_dofs_;
+
+    /// \brief The cell fluxes
+    std::vector<real_t> fluxes_;
+
+    /// \brief Scratch buffers reused for every element
+    std::vector<DoF> tmp_dofs_;
+    std::vector<real_t> row_entries_;
+    std::vector<uint_t> row_dofs_;
+    std::vector<uint_t> boundary_faces_;
+
+};
+
+template<int dim, typename Executor>
+template<typename MatrixTp, typename VectorTp>
+FVConvectionAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>::AssembleTask(uint_t t, const policy_t& policy)
+    :
+    SimpleTaskBase<Null>(t),
+    policy_(&policy),
+    mat_(nullptr),
+    b_(nullptr),
+    x_(nullptr),
+    elem_(nullptr),
+    neigh_dofs_(),
+    cell_dofs_(),
+    fluxes_(),
+    tmp_dofs_(),
+    row_entries_(),
+    row_dofs_(),
+    boundary_faces_()
+{
+    // enough for the faces of a hexahedron. The
+    // buffers grow if an element has more faces
+    const uint_t n_faces = 2*dim + 2;
+
+    neigh_dofs_.reserve(n_faces);
+    fluxes_.reserve(n_faces);
+    row_dofs_.reserve(n_faces + 1);
+    row_entries_.reserve(n_faces + 1);
+    boundary_faces_.reserve(n_faces);
+}
+
+template<int dim, typename Executor>
+template<typename MatrixTp, typename VectorTp>
+void
+FVConvectionAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>::set_data(matrix_t& mat, vector_t& b, vector_t& x){
+
+    mat_ = &mat;
+    b_ = &b;
+    x_ = &x;
+}
+
+
+template<int dim, typename Executor>
+template<typename MatrixTp, typename VectorTp>
+void
+FVConvectionAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>::run(){
+
+    const auto& elements = policy_->element_ranges_[this->get_id()];
+
+    for(const auto* elem : elements){
+
+        reinit(*elem);
+        assemble_one_element();
+    }
+}
+
+template<int dim, typename Executor>
+template<typename MatrixTp, typename VectorTp>
+void
+FVConvectionAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>::reinit(const Element<dim>& element){
+
+    elem_ = &element;
+    initialize_dofs();
+    compute_fluxes();
+}
+
+template<int dim, typename Executor>
+template<typename MatrixTp, typename VectorTp>
+void
+FVConvectionAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>::initialize_dofs(){
+
+
+    policy_->dof_manager_->get_dofs(*elem_, cell_dofs_);
+
+    if(cell_dofs_.empty()){
+        throw std::logic_error("Cell without dofs is used");
+    }
+
+    if (cell_dofs_[0].id == KernelConsts::invalid_size_type()) {
+        throw std::logic_error("Invalid DoF index");
+    }
+
+    neigh_dofs_.clear();
+
+    // get the dofs off the neighbors
+    for(uint_t neigh=0; neigh<elem_->n_neighbors(); ++neigh){
+
+        auto* neigh_elem = elem_->neighbor_ptr(neigh);
+
+        if(neigh_elem){
+
+            policy_->dof_manager_->get_dofs(*neigh_elem, tmp_dofs_);
+
+            if(tmp_dofs_.empty()){
+                throw std::logic_error("Cell without dofs is used");
+            }
+
+            if (tmp_dofs_[0].id == KernelConsts::invalid_size_type()) {
+                throw std::logic_error("Invalid DoF index");
+            }
+
+            neigh_dofs_.push_back(tmp_dofs_[0]);
+        }
+    }
+}
+
+
+template<int dim, typename Executor>
+template<typename MatrixTp, typename VectorTp>
+void
+FVConvectionAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>::compute_fluxes(){
+
+    if(!policy_->fv_interpolate_){
+        throw  std::logic_error("FV interpolation pointer has not been set");
+    }
+
+    policy_->fv_interpolate_->compute_fluxes(*elem_, fluxes_);
+}
+
+template<int dim, typename Executor>
+template<typename MatrixTp, typename VectorTp>
+void
+FVConvectionAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>::apply_boundary_conditions(const  std::vector<uint_t>& bfaces ){
+
+    const auto* boundary_func = policy_->boundary_func_;
+
+    for(uint_t f=0; f<bfaces.size(); ++f){
+
+        auto& face = elem_->get_face(bfaces[f]);
+
+        //get the boundary condition type
+        BCType type = boundary_func->bc_type(face.boundary_indicator());
+        uint_t var_dof = cell_dofs_[0].id;
+        auto flux = fluxes_[bfaces[f]];
+
+        switch(type){
+
+        case BCType::DIRICHLET:
+        {
+            real_t bc_val = boundary_func->value(face.centroid());
+
+            //add to the rhs vector
+            b_->add(var_dof, -flux*bc_val);
+            break;
+        }
+        case BCType::ZERO_DIRICHLET:
+        {
+            // the rhs contribution is zero
+            break;
+        }
+        case BCType::ZERO_NEUMANN:
+        {
+            mat_->add_entry(var_dof, var_dof, flux);
+            break;
+        }
+        default:
+        {
+            throw std::logic_error("Invalid boundary condition type");
+        }
+        }
+    }
+}
+
+template<int dim, typename Executor>
+template<typename MatrixTp, typename VectorTp>
+void
+FVConvectionAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>::assemble_one_element(){
+
+    auto n_dofs = cell_dofs_.size() + neigh_dofs_.size();
+
+    row_dofs_.resize(n_dofs);
+
+    // the indices of the faces local to the
+    // elment that lie on the boundary
+    boundary_faces_.clear();
+
+    //the first dof is the row we work on
+    row_dofs_[0] = cell_dofs_[0].id;
+
+    for(uint_t n=0; n<neigh_dofs_.size(); ++n){
+      row_dofs_[n+1] = neigh_dofs_[n].id;
+    }
+
+    // entry 0 is the diagonal and entry n + 1 belongs to neighbor n
+    policy_->fv_interpolate_->compute_matrix_contributions(*elem_, row_entries_);
+
+    for(uint_t f=0; f < elem_->n_faces(); ++f){
+
+        const auto& face = elem_->get_face(f);
+
+        if(face.on_boundary()){
+            boundary_faces_.push_back(f);
+        }
+    }
+
+    // only the row of this cell is touched
+    mat_->set_entry(row_dofs_[0], row_dofs_[0], row_entries_[0]);
+
+    // the neighbor dofs skip the missing neighbors
+    uint_t idx = 1;
+    for(uint_t n=0; n<elem_->n_neighbors(); ++n){
+        if(elem_->neighbor_ptr(n)){
+            mat_->set_entry(row_dofs_[0], row_dofs_[idx++], row_entries_[n + 1]);
+        }
+    }
+
+    real_t rhs_val = 0.0;
+    if(policy_->rhs_func_ != nullptr){
+        rhs_val = policy_->rhs_func_->value(elem_->centroid());
+    }
+
+    b_->add(cell_dofs_[0].id, rhs_val*elem_->volume());
+
+    if(!boundary_faces_.empty() && policy_->boundary_func_ != nullptr){
+        apply_boundary_conditions(boundary_faces_);
+    }
+}
+
+}
+
+}
+#endif
+#endif // FV_CONVECTION_ASSEMBLE_POLICY_THREADED_H
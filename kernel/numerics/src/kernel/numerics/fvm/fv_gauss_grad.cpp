@@ -6,6 +6,7 @@
 #include "kernel/numerics/fvm/fv_grad_types.h"
 #include "kernel/discretization/element.h"
 #include "kernel/discretization/face_element.h"
+#include "kernel/discretization/mesh.h"
 
 
 namespace kernel{
@@ -14,18 +15,28 @@ namespace numerics {
 template<int dim>
 FVGaussGrad<dim>::FVGaussGrad()
     :
-      FVGradBase<dim>(FVGradType::GAUSS)
+      FVGradBase<dim>(FVGradType::GAUSS),
+      mesh_(nullptr),
+      mesh_version_(0),
+      elements_(),
+      offsets_(),
+      coeffs_()
 {}
 
 template<int dim>
 void
 FVGaussGrad<dim>::compute_gradients(const Element<dim>& elem, std::vector<real_t>& values)const{
 
-    {
-        std::vector<real_t> empty;
-        values.swap(empty);
+    const uint_t id = elem.get_id();
+
+    // the id alone may belong to an element of another mesh
+    if(id < elements_.size() && elements_[id] == &elem){
+
+        values.assign(coeffs_.begin() + offsets_[id], coeffs_.begin() + offsets_[id + 1]);
+        return;
     }
 
+    values.clear();
     values.reserve(elem.n_faces());
 
     for(uint_t f=0; f<elem.n_faces(); ++f){
@@ -35,6 +46,68 @@ FVGaussGrad<dim>::compute_gradients(const Element<dim>& elem, std::vector<real_t
     }
 }
 
+template<int dim>
+void
+FVGaussGrad<dim>::update_geometric_cache(const Mesh<dim>& mesh){
+
+    if(mesh_ == &mesh && mesh_version_ == mesh.version()){
+        return;
+    }
+
+    invalidate_geometric_cache();
+
+    // the elements are indexed by their id
+    offsets_.assign(mesh.n_elements() + 1, 0);
+    elements_.assign(mesh.n_elements(), nullptr);
+
+    auto itr = mesh.elements_begin();
+    auto itr_e = mesh.elements_end();
+
+    for(; itr != itr_e; ++itr){
+
+        if(*itr){
+            elements_[(*itr)->get_id()] = *itr;
+            offsets_[(*itr)->get_id() + 1] = (*itr)->n_faces();
+        }
+    }
+
+    for(uint_t e=0; e<mesh.n_elements(); ++e){
+        offsets_[e + 1] += offsets_[e];
+    }
+
+    coeffs_.resize(offsets_.back());
+
+    for(itr = mesh.elements_begin(); itr != itr_e; ++itr){
+
+        if(!*itr){
+            continue;
+        }
+
+        const auto& elem = **itr;
+        uint_t slot = offsets_[elem.get_id()];
+
+        for(uint_t f=0; f<elem.n_faces(); ++f){
+
+            auto& face = elem.get_face(f);
+            coeffs_[slot++] = face.volume()/face.owner_neighbor_distance();
+        }
+    }
+
+    mesh_ = &mesh;
+    mesh_version_ = mesh.version();
+}
+
+template<int dim>
+void
+FVGaussGrad<dim>::invalidate_geometric_cache(){
+
+    mesh_ = nullptr;
+    mesh_version_ = 0;
+    elements_.clear();
+    offsets_.clear();
+    coeffs_.clear();
+}
+
 template class FVGaussGrad<1>;
 template class FVGaussGrad<2>;
 template class FVGaussGrad<3>;
@@ -20,13 +20,43 @@ public:
     /// \brief Constructor
     FVGaussGrad();
 
-    /// \brief Compute the gradients for the given element
+    /// \brief Compute the gradients for the given element. The
+    /// coefficients are copied from the geometric cache if it has
+    /// been built for the mesh the element belongs to and computed
+    /// from the faces otherwise
     virtual void compute_gradients(const Element<dim>& elem, std::vector<real_t>& values)const override;
 
     /// \brief Returns true if the a approximation
     /// uses some sort of correction
     virtual bool is_corrected()const override{return false;}
 
+    /// \brief Build the table of the face coefficients
+    /// area/distance of all the elements of the mesh. The table
+    /// is rebuilt only if the mesh or its version has changed
+    virtual void update_geometric_cache(const Mesh<dim>& mesh)override;
+
+    /// \brief Discard the geometric cache
+    void invalidate_geometric_cache();
+
+    /// \brief Returns true if the geometric cache is built
+    bool has_geometric_cache()const{return mesh_ != nullptr;}
+
+private:
+
+    /// \brief The mesh and its version the cache was built for.
+    /// Mesh versions are unique across meshes
+    const Mesh<dim>* mesh_;
+    uint_t mesh_version_;
+
+    /// \brief The cached elements indexed by their id. An element
+    /// is served from the cache only if it is the one stored here
+    std::vector<const Element<dim>*> elements_;
+
+    /// \brief The coefficients of the faces of element e are
+    /// stored contiguously at [offsets_[e], offsets_[e + 1])
+    std::vector<uint_t> offsets_;
+    std::vector<real_t> coeffs_;
+
 };
 
 }
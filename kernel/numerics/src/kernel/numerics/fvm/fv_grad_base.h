@@ -14,6 +14,7 @@ namespace numerics{
 
 /// forward declarations
 template<int dim> class Element;
+template<int dim> class Mesh;
 
 /// \brief Base class for deriving rules for
 /// gradient approximations
@@ -33,6 +34,12 @@ public:
     /// uses some sort of correction
     virtual bool is_corrected()const=0;
 
+    /// \brief Compute the data of the approximation that depend
+    /// only on the geometry of the given mesh. The assembly policies
+    /// call it before every assembly loop so it should be cheap if
+    /// the mesh has not changed. The default does nothing
+    virtual void update_geometric_cache(const Mesh<dim>& /*mesh*/){}
+
     /// \brief Returns the type of the approximation
     FVGradType type()const{return type_;}
 
@@ -3,6 +3,7 @@
 #ifdef USE_FVM
 
 #include "kernel/numerics/fvm/fv_interpolate_base.h"
+#include "kernel/discretization/element.h"
 
 namespace kernel{
 namespace numerics{
@@ -17,6 +18,26 @@ template<int dim>
 FVInterpolateBase<dim>::~FVInterpolateBase()
 {}
 
+template<int dim>
+void
+FVInterpolateBase<dim>::compute_matrix_contributions(const Element<dim>& element, std::vector<real_t>& values)const{
+
+    std::map<uint_t, real_t> entries;
+    compute_matrix_contributions(element, entries);
+
+    values.assign(element.n_neighbors() + 1, 0.0);
+    values[0] = entries[element.get_id()];
+
+    for(uint_t n=0; n<element.n_neighbors(); ++n){
+
+        const auto* neighbor = element.neighbor_ptr(n);
+
+        if(neighbor){
+            values[n + 1] = entries[neighbor->get_id()];
+        }
+    }
+}
+
 
 template class FVInterpolateBase<1>;
 template class FVInterpolateBase<2>;
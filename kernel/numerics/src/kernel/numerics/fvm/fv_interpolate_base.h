@@ -9,6 +9,7 @@
 #include "kernel/numerics/fvm/fv_interpolation_types.h"
 
 #include <map>
+#include <vector>
 
 namespace kernel {
 namespace numerics{
@@ -31,6 +32,12 @@ public:
     /// that should be used on the given element
     virtual void compute_matrix_contributions(const Element<dim>& element, std::map<uint_t, real_t>&)const=0;
 
+    /// \brief Returns the matrix contributions of the given element in a flat
+    /// buffer of size n_neighbors() + 1. The first entry is the diagonal and entry
+    /// n + 1 the coefficient of the neighbor n of the element. This avoids building
+    /// a map for every element. The default implementation converts the map version
+    virtual void compute_matrix_contributions(const Element<dim>& element, std::vector<real_t>& values)const;
+
     /// \brief Returns the type of the approximation
     FVInterpolationType type()const{return type_;}
 
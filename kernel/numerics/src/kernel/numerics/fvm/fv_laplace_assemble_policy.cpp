@@ -4,6 +4,7 @@
 
 #include "kernel/numerics/fvm/fv_laplace_assemble_policy.h"
 #include "kernel/numerics/fvm/fv_grad_base.h"
+#include "kernel/numerics/fvm/fv_matrix_free_operator.h"
 #include "kernel/numerics/boundary_function_base.h"
 #include "kernel/numerics/boundary_conditions_type.h"
 #include "kernel/discretization/dof_manager.h"
@@ -95,6 +96,21 @@ FVLaplaceAssemblyPolicy<dim>::compute_fluxes(){
     fv_grads_->compute_gradients(*elem_, fluxes_);
 }
 
+template<int dim>
+void
+FVLaplaceAssemblyPolicy<dim>::update_geometric_cache(){
+
+    if(!fv_grads_){
+        throw  std::logic_error("FV gradient pointer has not been set");
+    }
+
+    if(!m_ptr_){
+        throw  std::logic_error("Mesh pointer has not been set");
+    }
+
+    fv_grads_->update_geometric_cache(*m_ptr_);
+}
+
 template<int dim>
 void
 FVLaplaceAssemblyPolicy<dim>::reinit(const Element<dim>& element){
@@ -121,6 +137,8 @@ template<int dim>
 void
 FVLaplaceAssemblyPolicy<dim>::assemble(TrilinosEpetraMatrix& mat, TrilinosEpetraVector& x, TrilinosEpetraVector& b ){
 
+    update_geometric_cache();
+
     // loop over the elements
     ConstElementMeshIterator<Active, Mesh<dim>> filter(*m_ptr_);
 
@@ -243,6 +261,87 @@ FVLaplaceAssemblyPolicy<dim>::apply_boundary_conditions(const  std::vector<uint_
 
 #endif
 
+template<int dim>
+void
+FVLaplaceAssemblyPolicy<dim>::assemble(FVMatrixFreeOperator<dim>& mat, FVMatrixFreeVector& /*x*/, FVMatrixFreeVector& b ){
+
+    if(!mat.is_assembled()){
+
+        update_geometric_cache();
+
+        // loop over the elements
+        ConstElementMeshIterator<Active, Mesh<dim>> filter(*m_ptr_);
+
+        auto elem_itr = filter.begin();
+        auto elem_itr_e = filter.end();
+
+        for(; elem_itr != elem_itr_e; ++elem_itr){
+
+            auto* elem = *elem_itr;
+
+            reinit(*elem);
+            assemble_one_element(mat);
+        }
+
+        mat.fill_completed();
+    }
+
+    mat.add_source_terms(b);
+}
+
+template<int dim>
+void
+FVLaplaceAssemblyPolicy<dim>::assemble_one_element(FVMatrixFreeOperator<dim>& mat){
+
+    const uint_t row = cell_dofs_[0].id;
+    mat.set_row_volume(row, elem_->volume());
+
+    // index of the neighbor dofs
+    uint_t neigh_idx = 0;
+
+    for(uint_t f=0; f < elem_->n_faces(); ++f){
+
+        const auto& face = elem_->get_face(f);
+        real_t qval = qvals_.empty() ? 1.0 : qvals_[f];
+
+        if(!face.on_boundary()){
+
+            mat.add_diagonal(row, qval*fluxes_[f]);
+            mat.add_face_entry(face.get_id(), row, neigh_dofs_[neigh_idx].id, -qval*fluxes_[f]);
+            neigh_idx++;
+            continue;
+        }
+
+        if(boundary_func_ == nullptr){
+            continue;
+        }
+
+        BCType type = boundary_func_->bc_type(face.boundary_indicator());
+
+        if(type == BCType::DIRICHLET || type == BCType::ZERO_DIRICHLET){
+
+            real_t bc_val = boundary_func_->value(face.centroid());
+            mat.add_source(row, bc_val*fluxes_[f]);
+            mat.add_diagonal(row, qval*fluxes_[f]);
+        }
+        else if (type == BCType::NEUMANN) {
+
+            auto gradient = boundary_func_->gradients(face.centroid());
+            auto normal_vector = face.normal_vector();
+            normal_vector /= norm(normal_vector);
+            mat.add_source(row, dot(normal_vector , gradient));
+        }
+    }
+
+    if(volume_func_){
+        mat.add_diagonal(row, volume_func_->value(elem_->centroid())*elem_->volume());
+    }
+
+    if(rhs_func_ != nullptr){
+        mat.add_source(row, rhs_func_->value(elem_->centroid())*elem_->volume());
+    }
+}
+
 template class FVLaplaceAssemblyPolicy<1>;
 template class FVLaplaceAssemblyPolicy<2>;
 template class FVLaplaceAssemblyPolicy<3>;
@@ -10,6 +10,7 @@
 
 #include <vector>
 #include <string>
+#include <memory>
 
 namespace kernel {
 namespace numerics {
@@ -22,6 +23,9 @@ template<int dim> class FVDoFManager;
 template<int dim> class BoundaryFunctionBase;
 template<int dim> class NumericScalarFunction;
 
+template<int dim> class FVMatrixFreeOperator;
+class FVMatrixFreeVector;
+
 #ifdef USE_TRILINOS
 class TrilinosEpetraMatrix;
 class TrilinosEpetraVector;
@@ -58,10 +62,24 @@ public:
 
 #endif
 
+    /// \brief Assemble the terms of the matrix-free operator. The
+    /// cached terms of the operator are assembled only when the
+    /// operator is not assembled. The source terms are added to b
+    void assemble(FVMatrixFreeOperator<dim>& mat, FVMatrixFreeVector& x, FVMatrixFreeVector& b );
+
+    /// \brief Add the contribution of one element to
+    /// the cached terms of the matrix-free operator
+    void assemble_one_element(FVMatrixFreeOperator<dim>& mat);
+
     /// \brief Compute the fluxes over the cell last
     /// reinitialized
     void compute_fluxes();
 
+    /// \brief Build the geometric data of the gradient scheme
+    /// for the mesh. Called at the start of every assembly. It is
+    /// cheap if the mesh has not changed since the last call
+    void update_geometric_cache();
+
     /// \brief Set the function that describes the boundary conditions
     void set_boundary_function(const BoundaryFunctionBase<dim>& func){boundary_func_ = &func;}
 
@@ -20,10 +20,59 @@ FVLaplaceAssemblyPolicyThreaded<dim, Executor>::FVLaplaceAssemblyPolicyThreaded(
     rhs_func_(nullptr),
     volume_func_(nullptr),
     m_ptr_(nullptr),
+    element_ranges_(),
     tasks_(),
     executor_(nullptr)
 {}
 
+template<int dim, typename Executor>
+void
+FVLaplaceAssemblyPolicyThreaded<dim, Executor>::set_mesh(const Mesh<dim>& mesh){
+
+    m_ptr_ = &mesh;
+    element_ranges_.clear();
+}
+
+template<int dim, typename Executor>
+void
+FVLaplaceAssemblyPolicyThreaded<dim, Executor>::set_executor(executot_t& executor){
+
+    executor_ = &executor;
+
+    // the number of tasks may have changed
+    element_ranges_.clear();
+    tasks_.clear();
+}
+
+template<int dim, typename Executor>
+void
+FVLaplaceAssemblyPolicyThreaded<dim, Executor>::update_element_ranges(){
+
+    if(m_ptr_ == nullptr){
+        throw std::logic_error("Mesh pointer is not set");
+    }
+
+    if(executor_ == nullptr){
+        throw std::logic_error("Executor is not set");
+    }
+
+    element_ranges_partition(*m_ptr_, executor_->n_processing_elements(), element_ranges_);
+}
+
+template<int dim, typename Executor>
+void
+FVLaplaceAssemblyPolicyThreaded<dim, Executor>::update_geometric_cache(){
+
+    if(m_ptr_ == nullptr){
+        throw std::logic_error("Mesh pointer is not set");
+    }
+
+    if(!fv_grads_){
+        throw std::logic_error("FV gradient pointer has not been set");
+    }
+
+    fv_grads_->update_geometric_cache(*m_ptr_);
+}
 
 #ifdef USE_TRILINOS
 
@@ -40,24 +89,37 @@ FVLaplaceAssemblyPolicyThreaded<dim, Executor>::assemble(TrilinosEpetraMatrix& m
         throw std::logic_error("Executor is not set");
     }
 
-    if(tasks_.empty()){
+    if(dof_manager_ == nullptr){
+        throw std::logic_error("DoF manager is not set");
+    }
 
-        typedef FVLaplaceAssemblyPolicyThreaded<dim, Executor>::AssembleTask<TrilinosEpetraMatrix, TrilinosEpetraVector> task_t;
+    if(element_ranges_.empty()){
+        update_element_ranges();
+    }
 
-        tasks_.reserve(executor_->n_processing_elements());
+    update_geometric_cache();
 
-        for(uint_t t=0; t<executor_->n_processing_elements(); ++t){
-            tasks_.push_back(std::make_unique<task_t>(t, mat, b, x, fv_grads_, *dof_manager_,
-                                                      *m_ptr_, boundary_func_, rhs_func_, volume_func_));
-        }
+    typedef AssembleTask<TrilinosEpetraMatrix, TrilinosEpetraVector> task_t;
 
+    if(tasks_.empty()){
+
+        tasks_.reserve(element_ranges_.size());
+
+        for(uint_t t=0; t<element_ranges_.size(); ++t){
+            tasks_.push_back(std::make_unique<task_t>(t, *this));
+        }
     }
     else{
 
         for(uint_t t=0; t<tasks_.size(); ++t){
             tasks_[t]->reschedule();
         }
+    }
 
+    // the tasks are reused so the system
+    // may be different from the last call
+    for(uint_t t=0; t<tasks_.size(); ++t){
+        static_cast<task_t*>(tasks_[t].get())->set_data(mat, b, x);
     }
 
     /// this should block
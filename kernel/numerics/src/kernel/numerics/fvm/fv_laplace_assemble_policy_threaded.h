@@ -19,6 +19,7 @@
 #include "kernel/maths/functions/numeric_scalar_function.h"
 
 #include "kernel/parallel/threading/simple_task.h"
+#include "kernel/parallel/utilities/element_ranges_partitioner.h"
 
 #ifdef USE_TRILINOS
 #include "kernel/maths/trilinos_epetra_matrix.h"
@@ -47,8 +48,12 @@ class TrilinosEpetraVector;
 
 /// \brief Policy that assembles Laplaces terms
 /// on a user specified mesh using user specified
-/// gradient scheme
-
+/// gradient scheme. Every task of the executor works on
+/// a list of elements that is computed once, see
+/// element_ranges_partition(). FV cells write only into
+/// the matrix row and the rhs entry of their own DoF so
+/// the tasks never write to the same row and no locking
+/// or coloring is needed.
 template<int dim, typename Executor>
 class FVLaplaceAssemblyPolicyThreaded
 {
@@ -79,11 +84,24 @@ public:
     /// \brief Set the object that describes the dofs
     void set_dof_manager(const FVDoFManager<dim>& dof_manager){dof_manager_ = &dof_manager;}
 
-    /// \brief Set the mesh pointer
-    void set_mesh(const Mesh<dim>& mesh){m_ptr_ = &mesh;}
+    /// \brief Set the mesh pointer. The element
+    /// ranges are recomputed at the next assembly
+    void set_mesh(const Mesh<dim>& mesh);
 
     /// \brief Set the executor
-    void set_executor(executot_t& executor){executor_ = &executor;}
+    void set_executor(executot_t& executor);
+
+    /// \brief Recompute the element ranges of the tasks. Call this
+    /// when the active elements or their pids change
+    void update_element_ranges();
+
+    /// \brief Build the geometric data of the gradient scheme for
+    /// the mesh. Called by assemble() before the tasks are executed
+    /// so the tasks only read the cache
+    void update_geometric_cache();
+
+    /// \brief The elements the given task works on
+    const std::vector<const Element<dim>*>& get_element_range(uint_t t)const{return element_ranges_[t];}
 
     /// \brief Build the  gradient scheme
     template<typename Factory>
@@ -114,6 +132,9 @@ private:
     /// \brief The Mesh over which the policy is working
     const Mesh<dim>* m_ptr_;
 
+    /// \brief The elements every task works on
+    std::vector<std::vector<const Element<dim>*>> element_ranges_;
+
     /// \brief The tasks
     std::vector<std::unique_ptr<TaskBase>> tasks_;
 
@@ -138,14 +159,13 @@ public:
 
     typedef MatrixTp matrix_t;
     typedef VectorTp vector_t;
+    typedef FVLaplaceAssemblyPolicyThreaded<dim, Executor> policy_t;
 
     /// \brief Constructor
-    AssembleTask(uint_t t, matrix_t& mat, vector_t& b, vector_t& x,
-                 std::shared_ptr<FVGradBase<dim>> fv_grads, const FVDoFManager<dim>& dof_manager,
-                 const Mesh<dim>& mesh,
-                 const BoundaryFunctionBase<dim>* boundary_func,
-                 const NumericScalarFunction<dim>* rhs_func,
-                 const NumericScalarFunction<dim>* vol_func);
+    AssembleTask(uint_t t, const policy_t& policy);
+
+    /// \brief Set the linear system the task assembles
+    void set_data(matrix_t& mat, vector_t& b, vector_t& x);
 
     /// \brief Compute the fluxes over the cell last
     /// reinitialized
@@ -167,34 +187,17 @@ protected:
 
     virtual void run()override final;
 
+    /// \brief The policy that owns the task
+    const policy_t* policy_;
+
     /// \brief The matrix to assemble
-    MatrixTp& mat_;
+    matrix_t* mat_;
 
     /// \brief The rhs
-    VectorTp& b_;
+    vector_t* b_;
 
     /// \brief The solution
-    VectorTp& x_;
-
-    /// \brief Pointer to the FV gradient approximation
-    std::shared_ptr<FVGradBase<dim>> fv_grads_;
-
-    /// \brief The DoFManager that handles the dofs
-    const FVDoFManager<dim>* dof_manager_;
-
-    /// \brief The boundary function used
-    const BoundaryFunctionBase<dim>* boundary_func_;
-
-    /// \brief Pointer to the function object that describes the
-    /// rhs
-    const NumericScalarFunction<dim>* rhs_func_;
-
-    /// \brief Pointer to the function object that describes the
-    /// any volume terms to assemble
-    const NumericScalarFunction<dim>* volume_func_;
-
-    /// \brief The Mesh over which the policy is working
-    const Mesh<dim>* m_ptr_;
+    vector_t* x_;
 
     /// \brief The element over which the policy is working
     const Element<dim>* elem_;
@@ -211,49 +214,63 @@ protected:
     /// \brief The cell fluxes
     std::vector<real_t> fluxes_;
 
+    /// \brief Scratch buffers reused for every element
+    std::vector<DoF> tmp_dofs_;
+    std::vector<real_t> row_entries_;
+    std::vector<uint_t> row_dofs_;
+    std::vector<uint_t> boundary_faces_;
+
 };
 
 template<int dim, typename Executor>
 template<typename MatrixTp, typename VectorTp>
-FVLaplaceAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>::AssembleTask(uint_t t, matrix_t& mat, vector_t& b, vector_t& x,
-                                                                                              std::shared_ptr<FVGradBase<dim>> fv_grads, const FVDoFManager<dim>& dof_manager,
-                                                                                              const Mesh<dim>& mesh,
-                                                                                              const BoundaryFunctionBase<dim>* boundary_func,
-                                                                                              const NumericScalarFunction<dim>* rhs_func,
-                                                                                              const NumericScalarFunction<dim>* vol_func)
+FVLaplaceAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>::AssembleTask(uint_t t, const policy_t& policy)
     :
     SimpleTaskBase<Null>(t),
-    mat_(mat),
-    b_(b),
-    x_(x),
-    fv_grads_(fv_grads),
-    dof_manager_(&dof_manager),
-    m_ptr_(&mesh),
-    boundary_func_(boundary_func),
-    rhs_func_(rhs_func),
-    volume_func_(vol_func),
+    policy_(&policy),
+    mat_(nullptr),
+    b_(nullptr),
+    x_(nullptr),
     elem_(nullptr),
     qvals_(),
     neigh_dofs_(),
     cell_dofs_(),
-    fluxes_()
-{}
-
+    fluxes_(),
+    tmp_dofs_(),
+    row_entries_(),
+    row_dofs_(),
+    boundary_faces_()
+{
+    // enough for the faces of a hexahedron. The
+    // buffers grow if an element has more faces
+    const uint_t n_faces = 2*dim + 2;
+
+    neigh_dofs_.reserve(n_faces);
+    fluxes_.reserve(n_faces);
+    row_entries_.reserve(n_faces + 1);
+    row_dofs_.reserve(n_faces + 1);
+    boundary_faces_.reserve(n_faces);
+}
 
 template<int dim, typename Executor>
 template<typename MatrixTp, typename VectorTp>
 void
-FVLaplaceAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>::run(){
+FVLaplaceAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>::set_data(matrix_t& mat, vector_t& b, vector_t& x){
 
-    // loop over the elements
-    ConstElementMeshIterator<ActiveOnProc, Mesh<dim>> filter(*m_ptr_);
+    mat_ = &mat;
+    b_ = &b;
+    x_ = &x;
+}
 
-    auto elem_itr = filter.begin(this->get_id());
-    auto elem_itr_e = filter.end(this->get_id());
 
-    for(; elem_itr != elem_itr_e; ++elem_itr){
+template<int dim, typename Executor>
+template<typename MatrixTp, typename VectorTp>
+void
+FVLaplaceAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>::run(){
+
+    const auto& elements = policy_->element_ranges_[this->get_id()];
 
-        auto* elem = *elem_itr;
+    for(const auto* elem : elements){
 
         reinit(*elem);
         assemble_one_element();
@@ -276,7 +293,7 @@ void
 FVLaplaceAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>::initialize_dofs(){
 
 
-    dof_manager_->get_dofs(*elem_, cell_dofs_);
+    policy_->dof_manager_->get_dofs(*elem_, cell_dofs_);
 
     if(cell_dofs_.empty()){
         throw std::logic_error("Cell without dofs is used");
@@ -287,8 +304,6 @@ FVLaplaceAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>:
     }
 
     neigh_dofs_.clear();
-    neigh_dofs_.reserve(elem_->n_neighbors());
-
 
     // get the dofs off the neighbors
     for(uint_t neigh=0; neigh<elem_->n_neighbors(); ++neigh){
@@ -297,19 +312,17 @@ FVLaplaceAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>:
 
         if(neigh_elem){
 
-            std::vector<DoF> tmp;
-
-            dof_manager_->get_dofs(*neigh_elem, tmp);
+            policy_->dof_manager_->get_dofs(*neigh_elem, tmp_dofs_);
 
-            if(tmp.empty()){
+            if(tmp_dofs_.empty()){
                 throw std::logic_error("Cell without dofs is used");
             }
 
-            if (tmp[0].id == KernelConsts::invalid_size_type()) {
+            if (tmp_dofs_[0].id == KernelConsts::invalid_size_type()) {
                 throw std::logic_error("Invalid DoF index");
             }
 
-            neigh_dofs_.push_back(tmp[0]);
+            neigh_dofs_.push_back(tmp_dofs_[0]);
         }
     }
 }
@@ -320,11 +333,11 @@ template<typename MatrixTp, typename VectorTp>
 void
 FVLaplaceAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>::compute_fluxes(){
 
-    if(!fv_grads_){
+    if(!policy_->fv_grads_){
         throw  std::logic_error("FV gradient pointer has not been set");
     }
 
-    fv_grads_->compute_gradients(*elem_, fluxes_);
+    policy_->fv_grads_->compute_gradients(*elem_, fluxes_);
 }
 
 template<int dim, typename Executor>
@@ -332,35 +345,35 @@ template<typename MatrixTp, typename VectorTp>
 void
 FVLaplaceAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>::apply_boundary_conditions(const  std::vector<uint_t>& bfaces ){
 
-    bool added=false;
+    const auto* boundary_func = policy_->boundary_func_;
 
     for(uint_t f=0; f<bfaces.size(); ++f){
 
         auto& face = elem_->get_face(bfaces[f]);
 
         //get the boundary condition type
-        BCType type = boundary_func_->bc_type(face.boundary_indicator());
+        BCType type = boundary_func->bc_type(face.boundary_indicator());
 
         if(type == BCType::DIRICHLET || type == BCType::ZERO_DIRICHLET)
         {
-            real_t bc_val = boundary_func_->value(face.centroid());
+            real_t bc_val = boundary_func->value(face.centroid());
             uint_t var_dof = cell_dofs_[0].id;
             real_t qval = qvals_.empty() ? 1.0 : qvals_[bfaces[f]];
 
             //add the boundary condition type
-            b_.add(var_dof, bc_val*fluxes_[bfaces[f]]);
+            b_->add(var_dof, bc_val*fluxes_[bfaces[f]]);
             auto flux_val = fluxes_[bfaces[f]];
 
             //add to the diagonal of the matrix
-            mat_.add_entry(var_dof, var_dof, qval*flux_val);
+            mat_->add_entry(var_dof, var_dof, qval*flux_val);
 
         }//Dirichlet
         else if (type == BCType::NEUMANN) {
 
-            auto gradient = boundary_func_->gradients(face.centroid());
+            auto gradient = boundary_func->gradients(face.centroid());
             auto normal_comp = dot(gradient, face.normal_vector());
             uint_t var_dof = cell_dofs_[0].id;
-            b_.add(var_dof, normal_comp);
+            b_->add(var_dof, normal_comp);
         }
         else if(type == BCType::ZERO_NEUMANN){
             // nothing to do here.
@@ -375,19 +388,18 @@ FVLaplaceAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>:
 
     auto n_dofs = cell_dofs_.size() + neigh_dofs_.size();
 
-    std::vector<real_t> row_entries(n_dofs, 0.0);
-    std::vector<uint_t> row_dofs(n_dofs);
+    row_entries_.assign(n_dofs, 0.0);
+    row_dofs_.resize(n_dofs);
 
     // the indices of the faces local to the
     // elment that lie on the boundary
-    std::vector<uint_t> boundary_faces;
-    boundary_faces.reserve(elem_->n_faces());
+    boundary_faces_.clear();
 
     //the first dof is the row we work on
-    row_dofs[0] = cell_dofs_[0].id;
+    row_dofs_[0] = cell_dofs_[0].id;
 
     for(uint_t n=0; n<neigh_dofs_.size(); ++n){
-      row_dofs[n+1] = neigh_dofs_[n].id;
+      row_dofs_[n+1] = neigh_dofs_[n].id;
     }
 
     //a dummy index to start counting from 1
@@ -401,34 +413,35 @@ FVLaplaceAssemblyPolicyThreaded<dim, Executor>::AssembleTask<MatrixTp,VectorTp>:
           //for every face we add to the diagonal entry
           real_t qval = qvals_.empty() ? 1.0 : qvals_[f];
 
-          row_entries[0] += qval*fluxes_[f];
-          row_entries[dummy_idx] = -qval*fluxes_[f];
+          row_entries_[0] += qval*fluxes_[f];
+          row_entries_[dummy_idx] = -qval*fluxes_[f];
           dummy_idx++;
         }
         else{
 
-            boundary_faces.push_back(f);
+            boundary_faces_.push_back(f);
         }
     }
 
-    if(volume_func_){
-        row_entries[0] += volume_func_->value(elem_->centroid())*elem_->volume();
+    if(policy_->volume_func_){
+        row_entries_[0] += policy_->volume_func_->value(elem_->centroid())*elem_->volume();
     }
 
-    mat_.set_entry(row_dofs[0], row_dofs[0], row_entries[0]);
-    for(uint_t idx=1; idx<row_dofs.size(); ++idx){
-        mat_.set_entry(row_dofs[0], row_dofs[idx], row_entries[idx]);
+    // only the row of this cell is touched
+    mat_->set_entry(row_dofs_[0], row_dofs_[0], row_entries_[0]);
+    for(uint_t idx=1; idx<row_dofs_.size(); ++idx){
+        mat_->set_entry(row_dofs_[0], row_dofs_[idx], row_entries_[idx]);
     }
 
     real_t rhs_val = 0.0;
-    if(rhs_func_ != nullptr){
-        rhs_val = rhs_func_->value(elem_->centroid());
+    if(policy_->rhs_func_ != nullptr){
+        rhs_val = policy_->rhs_func_->value(elem_->centroid());
     }
 
-    b_.add(cell_dofs_[0].id, rhs_val*elem_->volume());
+    b_->add(cell_dofs_[0].id, rhs_val*elem_->volume());
 
-    if(!boundary_faces.empty() && boundary_func_ != nullptr){
-        apply_boundary_conditions(boundary_faces);
+    if(!boundary_faces_.empty() && policy_->boundary_func_ != nullptr){
+        apply_boundary_conditions(boundary_faces_);
     }
 }
 
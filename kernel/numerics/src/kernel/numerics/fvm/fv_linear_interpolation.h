@@ -35,6 +35,10 @@ public:
     /// that should be used on the given element
     virtual void compute_matrix_contributions(const Element<dim>& element,  std::map<uint_t, real_t>& values)const override{throw std::logic_error("Not implemented");}
 
+    /// \brief Returns the matrix contibutions
+    /// that should be used on the given element
+    virtual void compute_matrix_contributions(const Element<dim>& element,  std::vector<real_t>& values)const override{throw std::logic_error("Not implemented");}
+
 protected:
 
     /// \brief The weight used for the interpolation
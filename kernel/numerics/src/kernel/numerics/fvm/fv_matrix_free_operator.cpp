@@ -0,0 +1,215 @@
+#include "kernel/base/config.h"
+
+#ifdef USE_FVM
+
+#include "kernel/numerics/fvm/fv_matrix_free_operator.h"
+#include "kernel/base/kernel_consts.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace kernel{
+namespace numerics{
+
+FVMatrixFreeVector::FVMatrixFreeVector()
+    :
+      values_()
+{}
+
+void
+FVMatrixFreeVector::init(uint_t n, bool fast){
+
+    values_.resize(n, !fast);
+
+    if(!fast){
+        values_.reset();
+    }
+}
+
+void
+FVMatrixFreeVector::init(uint_t n, real_t val){
+
+    values_.resize(n, false);
+
+    for(uint_t i=0; i<n; ++i){
+        values_[i] = val;
+    }
+}
+
+void
+FVMatrixFreeVector::zero(){
+    values_.reset();
+}
+
+std::ostream&
+FVMatrixFreeVector::print(std::ostream& out)const{
+
+    for(uint_t i=0; i<values_.size(); ++i){
+        out<<i<<" "<<values_[i]<<std::endl;
+    }
+
+    return out;
+}
+
+template<int dim>
+FVMatrixFreeOperator<dim>::FVMatrixFreeOperator()
+    :
+      diagonal_(),
+      volumes_(),
+      source_(),
+      face_owners_(),
+      face_neighbors_(),
+      owner_coeffs_(),
+      neighbor_coeffs_(),
+      face_slots_(),
+      time_scale_(0.0),
+      assembled_(false),
+      symmetric_(false)
+{}
+
+template<int dim>
+void
+FVMatrixFreeOperator<dim>::init(uint_t m, uint_t n, uint_t /*n_entries_per_row*/){
+
+    if(m != n){
+        throw std::invalid_argument("A matrix-free FV operator should be square but m=" +
+                                    std::to_string(m) + " and n=" + std::to_string(n));
+    }
+
+    invalidate();
+
+    diagonal_.assign(m, 0.0);
+    volumes_.assign(m, 0.0);
+    source_.assign(m, 0.0);
+}
+
+template<int dim>
+void
+FVMatrixFreeOperator<dim>::invalidate(){
+
+    const uint_t n_rows = diagonal_.size();
+
+    diagonal_.assign(n_rows, 0.0);
+    volumes_.assign(n_rows, 0.0);
+    source_.assign(n_rows, 0.0);
+
+    face_owners_.clear();
+    face_neighbors_.clear();
+    owner_coeffs_.clear();
+    neighbor_coeffs_.clear();
+    face_slots_.clear();
+
+    assembled_ = false;
+    symmetric_ = false;
+}
+
+template<int dim>
+void
+FVMatrixFreeOperator<dim>::fill_completed(){
+
+    if(assembled_){
+        return;
+    }
+
+    // the face ids are needed only during the assembly
+    std::vector<uint_t> empty;
+    face_slots_.swap(empty);
+
+    symmetric_ = owner_coeffs_ == neighbor_coeffs_;
+
+    if(symmetric_){
+        std::vector<real_t> empty_coeffs;
+        neighbor_coeffs_.swap(empty_coeffs);
+    }
+
+    face_owners_.shrink_to_fit();
+    face_neighbors_.shrink_to_fit();
+    owner_coeffs_.shrink_to_fit();
+    neighbor_coeffs_.shrink_to_fit();
+
+    assembled_ = true;
+}
+
+template<int dim>
+void
+FVMatrixFreeOperator<dim>::add_face_entry(uint_t face_id, uint_t row, uint_t col, real_t val){
+
+    if(assembled_){
+        throw std::logic_error("The matrix-free FV operator is assembled. Call invalidate() first");
+    }
+
+    if(face_id >= face_slots_.size()){
+        face_slots_.resize(face_id + 1, KernelConsts::invalid_size_type());
+    }
+
+    auto& slot = face_slots_[face_id];
+
+    // the first side that visits the face
+    // becomes the owner
+    if(slot == KernelConsts::invalid_size_type()){
+
+        slot = face_owners_.size();
+        face_owners_.push_back(row);
+        face_neighbors_.push_back(col);
+        owner_coeffs_.push_back(val);
+        neighbor_coeffs_.push_back(0.0);
+        return;
+    }
+
+    if(face_owners_[slot] == row && face_neighbors_[slot] == col){
+        owner_coeffs_[slot] += val;
+    }
+    else if(face_owners_[slot] == col && face_neighbors_[slot] == row){
+        neighbor_coeffs_[slot] += val;
+    }
+    else{
+        throw std::logic_error("Face " + std::to_string(face_id) + " does not connect rows " +
+                               std::to_string(row) + " and " + std::to_string(col));
+    }
+}
+
+template<int dim>
+void
+FVMatrixFreeOperator<dim>::set_time_step(real_t dt){
+
+    if(dt < 0.0){
+        throw std::invalid_argument("The time step should not be negative");
+    }
+
+    time_scale_ = dt == 0.0 ? 0.0 : 1.0/dt;
+}
+
+template<int dim>
+uint_t
+FVMatrixFreeOperator<dim>::memory_usage()const{
+
+    return sizeof(real_t)*(diagonal_.capacity() + volumes_.capacity() + source_.capacity() +
+                           owner_coeffs_.capacity() + neighbor_coeffs_.capacity()) +
+           sizeof(uint_t)*(face_owners_.capacity() + face_neighbors_.capacity() + face_slots_.capacity());
+}
+
+template<int dim>
+std::ostream&
+FVMatrixFreeOperator<dim>::print(std::ostream& out)const{
+
+    for(uint_t r=0; r<diagonal_.size(); ++r){
+        out<<r<<" "<<r<<" "<<diagonal_[r] + time_scale_*volumes_[r]<<std::endl;
+    }
+
+    const auto& neighbor_coeffs = symmetric_ ? owner_coeffs_ : neighbor_coeffs_;
+
+    for(uint_t f=0; f<face_owners_.size(); ++f){
+        out<<face_owners_[f]<<" "<<face_neighbors_[f]<<" "<<owner_coeffs_[f]<<std::endl;
+        out<<face_neighbors_[f]<<" "<<face_owners_[f]<<" "<<neighbor_coeffs[f]<<std::endl;
+    }
+
+    return out;
+}
+
+template class FVMatrixFreeOperator<1>;
+template class FVMatrixFreeOperator<2>;
+template class FVMatrixFreeOperator<3>;
+
+}
+}
+#endif
@@ -0,0 +1,247 @@
+#ifndef FV_MATRIX_FREE_OPERATOR_H
+#define FV_MATRIX_FREE_OPERATOR_H
+
+#include "kernel/base/config.h"
+
+#ifdef USE_FVM
+
+#include "kernel/base/types.h"
+
+#include <vector>
+#include <ostream>
+
+namespace kernel {
+namespace numerics {
+
+/// \brief Vector used together with the FVMatrixFreeOperator.
+/// It exposes the interface the FV systems expect from
+/// the vector_t of a solution policy
+class FVMatrixFreeVector
+{
+public:
+
+    /// \brief Constructor
+    FVMatrixFreeVector();
+
+    /// \brief Initialize the vector with size n. If fast is false
+    /// the entries are initialized to zero
+    void init(uint_t n, bool fast=false);
+
+    /// \brief Initialize the vector with size n and all
+    /// entries equal to val
+    void init(uint_t n, real_t val);
+
+    /// \brief Set all the entries to zero
+    void zero();
+
+    /// \brief Nothing to communicate for this vector
+    void compress(){}
+
+    /// \brief Add val to the i-th entry
+    void add(uint_t i, real_t val){values_[i] += val;}
+
+    /// \brief The size of the vector
+    uint_t size()const{return values_.size();}
+
+    /// \brief Read access to the i-th entry
+    real_t operator[](uint_t i)const{return values_[i];}
+
+    /// \brief Read/write access to the i-th entry
+    real_t& operator[](uint_t i){return values_[i];}
+
+    /// \brief Read/write access to the underlying vector
+    DynVec<real_t>& get_vector(){return values_;}
+
+    /// \brief Read access to the underlying vector
+    const DynVec<real_t>& get_vector()const{return values_;}
+
+    /// \brief Print the vector
+    std::ostream& print(std::ostream& out)const;
+
+private:
+
+    DynVec<real_t> values_;
+};
+
+/// \brief Matrix-free representation of a FV operator. Instead of the
+/// matrix entries the operator keeps one coefficient for every side of
+/// an interior face (one per face if the operator is symmetric), the
+/// diagonal and the volume of every row. The
+/// product A*x is computed by a sweep over the faces. The cached terms
+/// depend only on the geometry and the coefficients of the problem.
+/// zero() does not discard them so that a transient run assembles
+/// them only once. Call invalidate() when any of them changes.
+/// The time term volume/dt is kept apart and changing the time step
+/// does not require a new assembly
+template<int dim>
+class FVMatrixFreeOperator
+{
+public:
+
+    typedef FVMatrixFreeVector vector_t;
+
+    /// \brief Constructor
+    FVMatrixFreeOperator();
+
+    /// \brief Initialize the operator for m rows. The operator is
+    /// square and n must be equal to m. n_entries_per_row is
+    /// accepted for compatibility with the assembled matrices
+    void init(uint_t m, uint_t n, uint_t n_entries_per_row=0);
+
+    /// \brief Initialize the operator for m rows. The sparsity
+    /// pattern is accepted for compatibility with the assembled matrices
+    void init(uint_t m, uint_t n, const std::vector<std::vector<uint_t>>& /*pattern*/){init(m, n);}
+
+    /// \brief Does not discard the cached terms. See
+    /// the class documentation
+    void zero(){}
+
+    /// \brief Discard all the cached terms. The
+    /// operator should be assembled again
+    void invalidate();
+
+    /// \brief Signal that the assembly of the cached terms is
+    /// complete. If the operator is symmetric only one
+    /// coefficient per face is kept
+    void fill_completed();
+
+    /// \brief Returns true if the cached terms are assembled
+    bool is_assembled()const{return assembled_;}
+
+    /// \brief Returns true if the assembled operator is symmetric
+    bool is_symmetric()const{return symmetric_;}
+
+    /// \brief Number of rows
+    uint_t m()const{return diagonal_.size();}
+
+    /// \brief Number of columns
+    uint_t n()const{return diagonal_.size();}
+
+    /// \brief Number of interior faces
+    uint_t n_faces()const{return face_owners_.size();}
+
+    /// \brief Add val to the diagonal of the given row
+    void add_diagonal(uint_t row, real_t val){diagonal_[row] += val;}
+
+    /// \brief Add val to the source term of the given row
+    void add_source(uint_t row, real_t val){source_[row] += val;}
+
+    /// \brief Set the volume of the element of the given row
+    void set_row_volume(uint_t row, real_t val){volumes_[row] = val;}
+
+    /// \brief Returns the volume of the element of the given row
+    real_t row_volume(uint_t row)const{return volumes_[row];}
+
+    /// \brief Add val to the entry (row, col) where row and col are
+    /// the two sides of the interior face with the given id. Throws
+    /// std::logic_error if the face was added with other rows
+    void add_face_entry(uint_t face_id, uint_t row, uint_t col, real_t val);
+
+    /// \brief Set the time step. The diagonal of every row is
+    /// increased by volume/dt. A zero dt removes the time term
+    void set_time_step(real_t dt);
+
+    /// \brief Add the source terms to b
+    template<typename VectorType>
+    void add_source_terms(VectorType& b)const;
+
+    /// \brief Compute y = A*x
+    template<typename VectorType>
+    void apply(const VectorType& x, VectorType& y)const;
+
+    /// \brief Compute y = A*x
+    void apply(const vector_t& x, vector_t& y)const{apply(x.get_vector(), y.get_vector());}
+
+    /// \brief Returns the diagonal of the operator
+    template<typename VectorType>
+    void diagonal(VectorType& d)const;
+
+    /// \brief Returns the memory in bytes the operator uses
+    uint_t memory_usage()const;
+
+    /// \brief Print the entries of the operator
+    std::ostream& print(std::ostream& out)const;
+
+private:
+
+    /// \brief The diagonal without the time term
+    std::vector<real_t> diagonal_;
+
+    /// \brief The volumes of the elements of the rows
+    std::vector<real_t> volumes_;
+
+    /// \brief The source terms
+    std::vector<real_t> source_;
+
+    /// \brief The rows of the two sides of the interior faces
+    std::vector<uint_t> face_owners_;
+    std::vector<uint_t> face_neighbors_;
+
+    /// \brief The entries (owner, neighbor) and (neighbor, owner)
+    std::vector<real_t> owner_coeffs_;
+    std::vector<real_t> neighbor_coeffs_;
+
+    /// \brief Maps the face ids to the interior faces
+    /// while the operator is assembled
+    std::vector<uint_t> face_slots_;
+
+    /// \brief 1/dt or zero
+    real_t time_scale_;
+
+    /// \brief Flag indicating that the cached terms are assembled
+    bool assembled_;
+
+    /// \brief Flag indicating that neighbor_coeffs_
+    /// is dropped because it equals owner_coeffs_
+    bool symmetric_;
+};
+
+template<int dim>
+template<typename VectorType>
+void
+FVMatrixFreeOperator<dim>::add_source_terms(VectorType& b)const{
+
+    for(uint_t r=0; r<source_.size(); ++r){
+        b[r] += source_[r];
+    }
+}
+
+template<int dim>
+template<typename VectorType>
+void
+FVMatrixFreeOperator<dim>::apply(const VectorType& x, VectorType& y)const{
+
+    const uint_t n_rows = diagonal_.size();
+
+    for(uint_t r=0; r<n_rows; ++r){
+        y[r] = (diagonal_[r] + time_scale_*volumes_[r])*x[r];
+    }
+
+    const uint_t n_interior_faces = face_owners_.size();
+    const real_t* neighbor_coeffs = symmetric_ ? owner_coeffs_.data() : neighbor_coeffs_.data();
+
+    for(uint_t f=0; f<n_interior_faces; ++f){
+
+        const uint_t owner = face_owners_[f];
+        const uint_t neighbor = face_neighbors_[f];
+
+        y[owner] += owner_coeffs_[f]*x[neighbor];
+        y[neighbor] += neighbor_coeffs[f]*x[owner];
+    }
+}
+
+template<int dim>
+template<typename VectorType>
+void
+FVMatrixFreeOperator<dim>::diagonal(VectorType& d)const{
+
+    for(uint_t r=0; r<diagonal_.size(); ++r){
+        d[r] = diagonal_[r] + time_scale_*volumes_[r];
+    }
+}
+
+}
+}
+
+#endif
+#endif // FV_MATRIX_FREE_OPERATOR_H
@@ -124,6 +124,61 @@ FVUDInterpolate<dim>::compute_matrix_contributions(const Element<dim>& element,
     }
 }
 
+template<int dim>
+void
+FVUDInterpolate<dim>::compute_matrix_contributions(const Element<dim>& element,
+                                                    std::vector<real_t>& values)const{
+
+    if(!velocity_){
+        throw std::logic_error("Velocity pointer is NULL");
+    }
+
+    values.assign(element.n_neighbors() + 1, 0.0);
+
+    // loop over the element faces
+    for(uint_t f=0; f<element.n_faces(); ++f){
+
+        auto& face = element.get_face(f);
+
+        if(face.on_boundary()){
+            continue;
+        }
+
+        auto flux = compute_flux(face);
+
+        if(face.is_owner(element.get_id())){
+
+            if(flux >= 0.0){
+                values[0] += flux;
+            }
+            else{
+                auto idx = element.which_neighbor_am_i(face.get_neighbor());
+
+                if(idx == KernelConsts::invalid_size_type()){
+                    throw std::logic_error("Invalid neighbor index computed");
+                }
+
+                values[idx + 1] += flux;
+            }
+        }
+        else{
+
+            if(flux >= 0.0){
+                auto idx = element.which_neighbor_am_i(face.get_owner());
+
+                if(idx == KernelConsts::invalid_size_type()){
+                    throw std::logic_error("Invalid neighbor index computed");
+                }
+
+                values[idx + 1] -= flux;
+            }
+            else{
+                values[0] -= flux;
+            }
+        }
+    }
+}
+
 template class FVUDInterpolate<1>;
 template class FVUDInterpolate<2>;
 template class FVUDInterpolate<3>;
@@ -35,6 +35,10 @@ public:
     /// that should be used on the given element
     virtual void compute_matrix_contributions(const Element<dim>& element,  std::map<uint_t, real_t>& values)const override;
 
+    /// \brief Returns the matrix contibutions of the given element
+    /// indexed by the local neighbor. Entry 0 is the diagonal
+    virtual void compute_matrix_contributions(const Element<dim>& element,  std::vector<real_t>& values)const override;
+
     /// \brief Compute the dot product of the
     /// velocity computed on the given face and
     /// the face normal vector
@@ -0,0 +1,893 @@
+#ifndef AMG_PRECONDITIONER_H
+#define AMG_PRECONDITIONER_H
+
+#include "kernel/base/config.h"
+#include "kernel/base/types.h"
+
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace kernel {
+namespace numerics {
+
+/// \brief Smoothed aggregation algebraic multigrid preconditioner.
+/// The setup groups the strongly connected rows of every level into
+/// aggregates, smooths the piecewise constant prolongator with one damped
+/// Jacobi step and forms the coarse operator as P^T*A*P. The coarsest level
+/// is solved with a dense LU factorization. apply() performs one V-cycle
+/// with damped Jacobi pre- and post-smoothing. The smoother and the
+/// residuals run over the rows with OpenMP. The same number of pre- and
+/// post-smoothing sweeps keeps the preconditioner symmetric so that it can
+/// be used with CG. The hierarchy is built from any CSR matrix so that
+/// both the Blaze and the Trilinos solvers can use it
+class AMGPreconditioner
+{
+public:
+
+    /// \brief Constructor
+    AMGPreconditioner();
+
+    /// \brief Build the hierarchy from A. Throws std::logic_error
+    /// if A is not square or a diagonal entry is zero
+    void build(const SparseMatrix<real_t>& A);
+
+    /// \brief Build the hierarchy from the n x n matrix given in CSR
+    /// format. Throws std::logic_error if a diagonal entry is zero
+    void build(uint_t n, const std::vector<uint_t>& row_ptr,
+               const std::vector<uint_t>& columns, const std::vector<real_t>& values);
+
+    /// \brief Compute z = M^{-1}r by one V-cycle
+    template<typename VectorType>
+    void apply(const VectorType& r, VectorType& z)const;
+
+    /// \brief Compute z = M^{-1}r by one V-cycle. The pointers
+    /// should point to at least size() entries
+    void apply(const real_t* r, real_t* z)const;
+
+    /// \brief The number of rows
+    uint_t size()const{return levels_.empty() ? 0 : levels_[0].A.n_rows;}
+
+    /// \brief The number of levels of the hierarchy
+    uint_t n_levels()const{return levels_.size();}
+
+    /// \brief The number of rows of the given level
+    uint_t level_size(uint_t l)const{return levels_[l].A.n_rows;}
+
+    /// \brief The sum of the nonzeros of all the levels
+    /// over the nonzeros of the finest level
+    real_t operator_complexity()const;
+
+    /// \brief Rows i and j are strongly connected if
+    /// a_ij^2 >= theta^2*|a_ii*a_jj|. The default is 0.08
+    void set_strength_threshold(real_t theta);
+
+    /// \brief The number of pre- and post-smoothing sweeps. The default is 2
+    void set_n_smoothing_sweeps(uint_t n_sweeps);
+
+    /// \brief The coarsening stops when a level has at most
+    /// this many rows. The default is 100
+    void set_max_coarse_size(uint_t n_rows);
+
+    /// \brief The maximum number of levels. The default is 10
+    void set_max_levels(uint_t n_levels);
+
+    /// \brief The number of threads the smoother uses.
+    /// Without OpenMP the smoother is serial
+    void set_n_threads(uint_t n_threads);
+
+    /// \brief Print the sizes of the levels
+    std::ostream& print(std::ostream& out)const;
+
+private:
+
+    /// \brief Matrix in CSR format
+    struct CSRMatrix
+    {
+        uint_t n_rows = 0;
+        uint_t n_cols = 0;
+        std::vector<uint_t> row_ptr;
+        std::vector<uint_t> columns;
+        std::vector<real_t> values;
+
+        uint_t nonZeros()const{return values.size();}
+    };
+
+    /// \brief The operators and the work vectors of a level
+    struct Level
+    {
+        CSRMatrix A;
+
+        /// \brief Prolongation to this level from the next
+        /// coarser level and its transpose
+        CSRMatrix P;
+        CSRMatrix R;
+
+        /// \brief The inverse diagonal scaled with
+        /// the damping factor of the smoother
+        std::vector<real_t> scaled_inv_diagonal;
+
+        std::vector<real_t> x;
+        std::vector<real_t> b;
+        std::vector<real_t> r;
+    };
+
+    real_t strength_threshold_;
+    uint_t n_sweeps_;
+    uint_t max_coarse_size_;
+    uint_t max_levels_;
+    uint_t n_threads_;
+
+    /// \brief The levels. The work vectors
+    /// change while applying the preconditioner
+    mutable std::vector<Level> levels_;
+
+    /// \brief LU factors of the coarsest operator
+    /// stored by rows and the row permutation
+    std::vector<real_t> coarse_lu_;
+    std::vector<uint_t> coarse_pivots_;
+
+    void build_hierarchy_(CSRMatrix&& A);
+
+    /// \brief Set the scaled inverse diagonal of the level and return
+    /// the Gershgorin bound of the spectral radius of D^{-1}A
+    real_t setup_smoother_(Level& level)const;
+
+    /// \brief Aggregate the rows of A. Returns the number of aggregates
+    uint_t aggregate_(const CSRMatrix& A, std::vector<uint_t>& aggregates)const;
+
+    /// \brief P = (I - omega*D^{-1}A)*P0 with P0 the piecewise
+    /// constant interpolation over the aggregates
+    void smoothed_prolongator_(const CSRMatrix& A, const std::vector<uint_t>& aggregates,
+                               uint_t n_aggregates, real_t omega, CSRMatrix& P)const;
+
+    void factorize_coarse_();
+
+    void solve_coarse_(std::vector<real_t>& x, const std::vector<real_t>& b)const;
+
+    void v_cycle_(uint_t l)const;
+
+    /// \brief Sweeps of damped Jacobi on the level. If zero_guess
+    /// is true x is assumed zero on entry
+    void smooth_(Level& level, bool zero_guess)const;
+
+    /// \brief r = b - A*x
+    void residual_(const CSRMatrix& A, const std::vector<real_t>& x,
+                   const std::vector<real_t>& b, std::vector<real_t>& r)const;
+
+    /// \brief y = A*x if add is false otherwise y += A*x
+    void multiply_(const CSRMatrix& A, const std::vector<real_t>& x,
+                   std::vector<real_t>& y, bool add)const;
+
+    static void transpose_(const CSRMatrix& A, CSRMatrix& At);
+
+    static void multiply_(const CSRMatrix& A, const CSRMatrix& B, CSRMatrix& C);
+
+};
+
+inline
+AMGPreconditioner::AMGPreconditioner()
+    :
+    strength_threshold_(0.08),
+    n_sweeps_(2),
+    max_coarse_size_(100),
+    max_levels_(10),
+#ifdef USE_OPENMP
+    n_threads_(omp_get_max_threads()),
+#else
+    n_threads_(1),
+#endif
+    levels_(),
+    coarse_lu_(),
+    coarse_pivots_()
+{}
+
+inline
+void
+AMGPreconditioner::set_strength_threshold(real_t theta){
+
+    if(theta < 0.0 || theta >= 1.0){
+        throw std::logic_error("Strength threshold should be in [0, 1)");
+    }
+
+    strength_threshold_ = theta;
+}
+
+inline
+void
+AMGPreconditioner::set_n_smoothing_sweeps(uint_t n_sweeps){
+
+    if(n_sweeps == 0){
+        throw std::logic_error("Number of smoothing sweeps should be positive");
+    }
+
+    n_sweeps_ = n_sweeps;
+}
+
+inline
+void
+AMGPreconditioner::set_max_coarse_size(uint_t n_rows){
+
+    if(n_rows == 0){
+        throw std::logic_error("Maximum coarse size should be positive");
+    }
+
+    max_coarse_size_ = n_rows;
+}
+
+inline
+void
+AMGPreconditioner::set_max_levels(uint_t n_levels){
+
+    if(n_levels == 0){
+        throw std::logic_error("Maximum number of levels should be positive");
+    }
+
+    max_levels_ = n_levels;
+}
+
+inline
+void
+AMGPreconditioner::set_n_threads(uint_t n_threads){
+
+    if(n_threads == 0){
+        throw std::logic_error("Number of threads should be positive");
+    }
+
+    n_threads_ = n_threads;
+}
+
+inline
+void
+AMGPreconditioner::build(const SparseMatrix<real_t>& A){
+
+    if(A.rows() != A.columns()){
+        throw std::logic_error("AMG preconditioner needs a square matrix");
+    }
+
+    CSRMatrix csr;
+    csr.n_rows = A.rows();
+    csr.n_cols = A.columns();
+    csr.row_ptr.assign(A.rows() + 1, 0);
+    csr.columns.reserve(A.nonZeros());
+    csr.values.reserve(A.nonZeros());
+
+    for(uint_t r=0; r<A.rows(); ++r){
+
+        for(auto it = A.cbegin(r); it != A.cend(r); ++it){
+            csr.columns.push_back(it->index());
+            csr.values.push_back(it->value());
+        }
+
+        csr.row_ptr[r + 1] = csr.columns.size();
+    }
+
+    build_hierarchy_(std::move(csr));
+}
+
+inline
+void
+AMGPreconditioner::build(uint_t n, const std::vector<uint_t>& row_ptr,
+                         const std::vector<uint_t>& columns, const std::vector<real_t>& values){
+
+    if(row_ptr.size() != n + 1 || columns.size() != values.size() || row_ptr[n] != values.size()){
+        throw std::logic_error("Invalid CSR arrays for the AMG preconditioner");
+    }
+
+    CSRMatrix csr;
+    csr.n_rows = n;
+    csr.n_cols = n;
+    csr.row_ptr = row_ptr;
+    csr.columns = columns;
+    csr.values = values;
+
+    build_hierarchy_(std::move(csr));
+}
+
+inline
+void
+AMGPreconditioner::build_hierarchy_(CSRMatrix&& A){
+
+    levels_.clear();
+    levels_.emplace_back();
+    levels_.back().A = std::move(A);
+
+    std::vector<uint_t> aggregates;
+
+    while(true){
+
+        Level& fine = levels_.back();
+        const real_t rho = setup_smoother_(fine);
+
+        fine.x.assign(fine.A.n_rows, 0.0);
+        fine.b.assign(fine.A.n_rows, 0.0);
+        fine.r.assign(fine.A.n_rows, 0.0);
+
+        if(fine.A.n_rows <= max_coarse_size_ || levels_.size() == max_levels_){
+            break;
+        }
+
+        const uint_t n_aggregates = aggregate_(fine.A, aggregates);
+
+        // stop if the coarsening stagnates
+        if(n_aggregates == 0 || 10*n_aggregates > 9*fine.A.n_rows){
+            break;
+        }
+
+        smoothed_prolongator_(fine.A, aggregates, n_aggregates, 4.0/(3.0*rho), fine.P);
+        transpose_(fine.P, fine.R);
+
+        CSRMatrix AP;
+        multiply_(fine.A, fine.P, AP);
+
+        CSRMatrix coarse;
+        multiply_(fine.R, AP, coarse);
+
+        // fine is invalidated here
+        levels_.emplace_back();
+        levels_.back().A = std::move(coarse);
+    }
+
+    factorize_coarse_();
+}
+
+inline
+real_t
+AMGPreconditioner::setup_smoother_(Level& level)const{
+
+    const CSRMatrix& A = level.A;
+    level.scaled_inv_diagonal.assign(A.n_rows, 0.0);
+
+    real_t rho = 0.0;
+
+    for(uint_t i=0; i<A.n_rows; ++i){
+
+        real_t diagonal = 0.0;
+        real_t row_sum = 0.0;
+
+        for(uint_t p=A.row_ptr[i]; p<A.row_ptr[i + 1]; ++p){
+
+            if(A.columns[p] == i){
+                diagonal += A.values[p];
+            }
+
+            row_sum += std::abs(A.values[p]);
+        }
+
+        if(diagonal == 0.0){
+            throw std::logic_error("Zero diagonal entry at row " + std::to_string(i) +
+                                   ". AMG preconditioner cannot be built");
+        }
+
+        level.scaled_inv_diagonal[i] = 1.0/diagonal;
+        rho = std::max(rho, row_sum/std::abs(diagonal));
+    }
+
+    // damped Jacobi with omega = 4/(3*rho(D^{-1}A))
+    const real_t omega = 4.0/(3.0*rho);
+    for(auto& d : level.scaled_inv_diagonal){
+        d *= omega;
+    }
+
+    return rho;
+}
+
+inline
+uint_t
+AMGPreconditioner::aggregate_(const CSRMatrix& A, std::vector<uint_t>& aggregates)const{
+
+    const uint_t n = A.n_rows;
+    const uint_t invalid = std::numeric_limits<uint_t>::max();
+    const real_t theta2 = strength_threshold_*strength_threshold_;
+
+    std::vector<real_t> diagonal(n, 0.0);
+    for(uint_t i=0; i<n; ++i){
+        for(uint_t p=A.row_ptr[i]; p<A.row_ptr[i + 1]; ++p){
+            if(A.columns[p] == i){
+                diagonal[i] += A.values[p];
+            }
+        }
+    }
+
+    auto is_strong = [&](uint_t i, uint_t p){
+        const uint_t j = A.columns[p];
+        return j != i && A.values[p]*A.values[p] >= theta2*std::abs(diagonal[i]*diagonal[j]);
+    };
+
+    aggregates.assign(n, invalid);
+    uint_t n_aggregates = 0;
+
+    // pass 1: a row whose strong neighbors are all free
+    // forms an aggregate with them
+    for(uint_t i=0; i<n; ++i){
+
+        if(aggregates[i] != invalid){
+            continue;
+        }
+
+        bool free_neighborhood = true;
+        bool has_strong = false;
+
+        for(uint_t p=A.row_ptr[i]; p<A.row_ptr[i + 1]; ++p){
+
+            if(is_strong(i, p)){
+
+                has_strong = true;
+
+                if(aggregates[A.columns[p]] != invalid){
+                    free_neighborhood = false;
+                    break;
+                }
+            }
+        }
+
+        // rows without strong connections
+        // form an aggregate on their own
+        if(!has_strong){
+            aggregates[i] = n_aggregates++;
+            continue;
+        }
+
+        if(!free_neighborhood){
+            continue;
+        }
+
+        aggregates[i] = n_aggregates;
+        for(uint_t p=A.row_ptr[i]; p<A.row_ptr[i + 1]; ++p){
+            if(is_strong(i, p)){
+                aggregates[A.columns[p]] = n_aggregates;
+            }
+        }
+
+        ++n_aggregates;
+    }
+
+    // pass 2: join the free rows to the aggregate
+    // of a neighbor aggregated in pass 1
+    const std::vector<uint_t> first_pass = aggregates;
+
+    for(uint_t i=0; i<n; ++i){
+
+        if(aggregates[i] != invalid){
+            continue;
+        }
+
+        real_t strongest = 0.0;
+
+        for(uint_t p=A.row_ptr[i]; p<A.row_ptr[i + 1]; ++p){
+
+            const uint_t j = A.columns[p];
+
+            if(is_strong(i, p) && first_pass[j] != invalid && std::abs(A.values[p]) > strongest){
+                strongest = std::abs(A.values[p]);
+                aggregates[i] = first_pass[j];
+            }
+        }
+    }
+
+    // pass 3: the remaining rows form aggregates
+    // with their free strong neighbors
+    for(uint_t i=0; i<n; ++i){
+
+        if(aggregates[i] != invalid){
+            continue;
+        }
+
+        aggregates[i] = n_aggregates;
+        for(uint_t p=A.row_ptr[i]; p<A.row_ptr[i + 1]; ++p){
+            if(is_strong(i, p) && aggregates[A.columns[p]] == invalid){
+                aggregates[A.columns[p]] = n_aggregates;
+            }
+        }
+
+        ++n_aggregates;
+    }
+
+    return n_aggregates;
+}
+
+inline
+void
+AMGPreconditioner::smoothed_prolongator_(const CSRMatrix& A, const std::vector<uint_t>& aggregates,
+                                         uint_t n_aggregates, real_t omega, CSRMatrix& P)const{
+
+    const uint_t n = A.n_rows;
+    const uint_t invalid = std::numeric_limits<uint_t>::max();
+
+    P.n_rows = n;
+    P.n_cols = n_aggregates;
+    P.row_ptr.assign(n + 1, 0);
+    P.columns.clear();
+    P.values.clear();
+
+    // the position of the aggregates in the current row of P
+    std::vector<uint_t> marker(n_aggregates, invalid);
+
+    for(uint_t i=0; i<n; ++i){
+
+        const uint_t start = P.columns.size();
+
+        real_t diagonal = 0.0;
+        for(uint_t p=A.row_ptr[i]; p<A.row_ptr[i + 1]; ++p){
+            if(A.columns[p] == i){
+                diagonal += A.values[p];
+            }
+        }
+
+        // P0(i, agg(i)) = 1
+        marker[aggregates[i]] = P.columns.size();
+        P.columns.push_back(aggregates[i]);
+        P.values.push_back(1.0);
+
+        // -omega*D^{-1}*A*P0
+        const real_t scale = -omega/diagonal;
+
+        for(uint_t p=A.row_ptr[i]; p<A.row_ptr[i + 1]; ++p){
+
+            const uint_t agg = aggregates[A.columns[p]];
+
+            if(marker[agg] == invalid){
+                marker[agg] = P.columns.size();
+                P.columns.push_back(agg);
+                P.values.push_back(0.0);
+            }
+
+            P.values[marker[agg]] += scale*A.values[p];
+        }
+
+        for(uint_t p=start; p<P.columns.size(); ++p){
+            marker[P.columns[p]] = invalid;
+        }
+
+        P.row_ptr[i + 1] = P.columns.size();
+    }
+}
+
+inline
+void
+AMGPreconditioner::transpose_(const CSRMatrix& A, CSRMatrix& At){
+
+    At.n_rows = A.n_cols;
+    At.n_cols = A.n_rows;
+    At.row_ptr.assign(A.n_cols + 1, 0);
+    At.columns.resize(A.nonZeros());
+    At.values.resize(A.nonZeros());
+
+    for(uint_t p=0; p<A.nonZeros(); ++p){
+        ++At.row_ptr[A.columns[p] + 1];
+    }
+
+    for(uint_t r=0; r<A.n_cols; ++r){
+        At.row_ptr[r + 1] += At.row_ptr[r];
+    }
+
+    std::vector<uint_t> next(At.row_ptr.begin(), At.row_ptr.end() - 1);
+
+    for(uint_t i=0; i<A.n_rows; ++i){
+        for(uint_t p=A.row_ptr[i]; p<A.row_ptr[i + 1]; ++p){
+
+            const uint_t pos = next[A.columns[p]]++;
+            At.columns[pos] = i;
+            At.values[pos] = A.values[p];
+        }
+    }
+}
+
+inline
+void
+AMGPreconditioner::multiply_(const CSRMatrix& A, const CSRMatrix& B, CSRMatrix& C){
+
+    const uint_t invalid = std::numeric_limits<uint_t>::max();
+
+    C.n_rows = A.n_rows;
+    C.n_cols = B.n_cols;
+    C.row_ptr.assign(A.n_rows + 1, 0);
+    C.columns.clear();
+    C.values.clear();
+
+    // the position of the columns in the current row of C
+    std::vector<uint_t> marker(B.n_cols, invalid);
+
+    for(uint_t i=0; i<A.n_rows; ++i){
+
+        const uint_t start = C.columns.size();
+
+        for(uint_t p=A.row_ptr[i]; p<A.row_ptr[i + 1]; ++p){
+
+            const uint_t k = A.columns[p];
+            const real_t a_ik = A.values[p];
+
+            for(uint_t q=B.row_ptr[k]; q<B.row_ptr[k + 1]; ++q){
+
+                const uint_t j = B.columns[q];
+
+                if(marker[j] == invalid){
+                    marker[j] = C.columns.size();
+                    C.columns.push_back(j);
+                    C.values.push_back(0.0);
+                }
+
+                C.values[marker[j]] += a_ik*B.values[q];
+            }
+        }
+
+        for(uint_t p=start; p<C.columns.size(); ++p){
+            marker[C.columns[p]] = invalid;
+        }
+
+        C.row_ptr[i + 1] = C.columns.size();
+    }
+}
+
+inline
+void
+AMGPreconditioner::factorize_coarse_(){
+
+    const CSRMatrix& A = levels_.back().A;
+    const uint_t n = A.n_rows;
+
+    coarse_lu_.assign(n*n, 0.0);
+    coarse_pivots_.resize(n);
+
+    real_t max_entry = 0.0;
+
+    for(uint_t i=0; i<n; ++i){
+
+        coarse_pivots_[i] = i;
+
+        for(uint_t p=A.row_ptr[i]; p<A.row_ptr[i + 1]; ++p){
+            coarse_lu_[i*n + A.columns[p]] += A.values[p];
+            max_entry = std::max(max_entry, std::abs(A.values[p]));
+        }
+    }
+
+    // LU with partial pivoting
+    for(uint_t k=0; k<n; ++k){
+
+        uint_t pivot_row = k;
+        for(uint_t i=k + 1; i<n; ++i){
+            if(std::abs(coarse_lu_[i*n + k]) > std::abs(coarse_lu_[pivot_row*n + k])){
+                pivot_row = i;
+            }
+        }
+
+        if(pivot_row != k){
+
+            for(uint_t j=0; j<n; ++j){
+                std::swap(coarse_lu_[k*n + j], coarse_lu_[pivot_row*n + j]);
+            }
+
+            std::swap(coarse_pivots_[k], coarse_pivots_[pivot_row]);
+        }
+
+        // the coarse operator of a problem with pure Neumann
+        // conditions is singular. The zero pivot is replaced so
+        // that the constant component is left untouched
+        if(std::abs(coarse_lu_[k*n + k]) <= std::numeric_limits<real_t>::epsilon()*max_entry*n){
+            coarse_lu_[k*n + k] = max_entry;
+        }
+
+        const real_t pivot = coarse_lu_[k*n + k];
+
+        for(uint_t i=k + 1; i<n; ++i){
+
+            const real_t l_ik = coarse_lu_[i*n + k]/pivot;
+            coarse_lu_[i*n + k] = l_ik;
+
+            if(l_ik == 0.0){
+                continue;
+            }
+
+            for(uint_t j=k + 1; j<n; ++j){
+                coarse_lu_[i*n + j] -= l_ik*coarse_lu_[k*n + j];
+            }
+        }
+    }
+}
+
+inline
+void
+AMGPreconditioner::solve_coarse_(std::vector<real_t>& x, const std::vector<real_t>& b)const{
+
+    const uint_t n = x.size();
+
+    for(uint_t i=0; i<n; ++i){
+
+        real_t sum = b[coarse_pivots_[i]];
+        for(uint_t j=0; j<i; ++j){
+            sum -= coarse_lu_[i*n + j]*x[j];
+        }
+
+        x[i] = sum;
+    }
+
+    for(uint_t i=n; i-- > 0; ){
+
+        real_t sum = x[i];
+        for(uint_t j=i + 1; j<n; ++j){
+            sum -= coarse_lu_[i*n + j]*x[j];
+        }
+
+        x[i] = sum/coarse_lu_[i*n + i];
+    }
+}
+
+inline
+void
+AMGPreconditioner::multiply_(const CSRMatrix& A, const std::vector<real_t>& x,
+                             std::vector<real_t>& y, bool add)const{
+
+    const uint_t n = A.n_rows;
+
+#ifdef USE_OPENMP
+#pragma omp parallel for num_threads(n_threads_) schedule(static)
+#endif
+    for(uint_t i=0; i<n; ++i){
+
+        real_t sum = add ? y[i] : 0.0;
+        for(uint_t p=A.row_ptr[i]; p<A.row_ptr[i + 1]; ++p){
+            sum += A.values[p]*x[A.columns[p]];
+        }
+
+        y[i] = sum;
+    }
+}
+
+inline
+void
+AMGPreconditioner::residual_(const CSRMatrix& A, const std::vector<real_t>& x,
+                             const std::vector<real_t>& b, std::vector<real_t>& r)const{
+
+    const uint_t n = A.n_rows;
+
+#ifdef USE_OPENMP
+#pragma omp parallel for num_threads(n_threads_) schedule(static)
+#endif
+    for(uint_t i=0; i<n; ++i){
+
+        real_t sum = b[i];
+        for(uint_t p=A.row_ptr[i]; p<A.row_ptr[i + 1]; ++p){
+            sum -= A.values[p]*x[A.columns[p]];
+        }
+
+        r[i] = sum;
+    }
+}
+
+inline
+void
+AMGPreconditioner::smooth_(Level& level, bool zero_guess)const{
+
+    const uint_t n = level.A.n_rows;
+    uint_t sweep = 0;
+
+    // with a zero initial guess the first sweep is x = omega*D^{-1}b
+    if(zero_guess){
+
+#ifdef USE_OPENMP
+#pragma omp parallel for num_threads(n_threads_) schedule(static)
+#endif
+        for(uint_t i=0; i<n; ++i){
+            level.x[i] = level.scaled_inv_diagonal[i]*level.b[i];
+        }
+
+        sweep = 1;
+    }
+
+    for(; sweep<n_sweeps_; ++sweep){
+
+        residual_(level.A, level.x, level.b, level.r);
+
+#ifdef USE_OPENMP
+#pragma omp parallel for num_threads(n_threads_) schedule(static)
+#endif
+        for(uint_t i=0; i<n; ++i){
+            level.x[i] += level.scaled_inv_diagonal[i]*level.r[i];
+        }
+    }
+}
+
+inline
+void
+AMGPreconditioner::v_cycle_(uint_t l)const{
+
+    Level& level = levels_[l];
+
+    if(l + 1 == levels_.size()){
+        solve_coarse_(level.x, level.b);
+        return;
+    }
+
+    Level& coarse = levels_[l + 1];
+
+    smooth_(level, true);
+
+    residual_(level.A, level.x, level.b, level.r);
+    multiply_(level.R, level.r, coarse.b, false);
+
+    v_cycle_(l + 1);
+
+    multiply_(level.P, coarse.x, level.x, true);
+
+    smooth_(level, false);
+}
+
+inline
+void
+AMGPreconditioner::apply(const real_t* r, real_t* z)const{
+
+    if(levels_.empty()){
+        throw std::logic_error("AMG preconditioner is not built");
+    }
+
+    Level& finest = levels_[0];
+    std::copy(r, r + finest.A.n_rows, finest.b.begin());
+
+    v_cycle_(0);
+
+    std::copy(finest.x.begin(), finest.x.end(), z);
+}
+
+template<typename VectorType>
+void
+AMGPreconditioner::apply(const VectorType& r, VectorType& z)const{
+
+    if(levels_.empty()){
+        throw std::logic_error("AMG preconditioner is not built");
+    }
+
+    Level& finest = levels_[0];
+    for(uint_t i=0; i<finest.A.n_rows; ++i){
+        finest.b[i] = r[i];
+    }
+
+    v_cycle_(0);
+
+    for(uint_t i=0; i<finest.A.n_rows; ++i){
+        z[i] = finest.x[i];
+    }
+}
+
+inline
+real_t
+AMGPreconditioner::operator_complexity()const{
+
+    if(levels_.empty()){
+        return 0.0;
+    }
+
+    real_t total = 0.0;
+    for(const auto& level : levels_){
+        total += level.A.nonZeros();
+    }
+
+    return total/levels_[0].A.nonZeros();
+}
+
+inline
+std::ostream&
+AMGPreconditioner::print(std::ostream& out)const{
+
+    out<<"AMG levels: "<<levels_.size()<<std::endl;
+
+    for(uint_t l=0; l<levels_.size(); ++l){
+        out<<"Level "<<l<<" rows: "<<levels_[l].A.n_rows
+           <<" nonzeros: "<<levels_[l].A.nonZeros()<<std::endl;
+    }
+
+    out<<"Operator complexity: "<<operator_complexity()<<std::endl;
+    return out;
+}
+
+}
+}
+
+#endif // AMG_PRECONDITIONER_H
@@ -0,0 +1,1012 @@
+#ifndef BLAZE_KRYLOV_SOLVER_H
+#define BLAZE_KRYLOV_SOLVER_H
+
+#include "kernel/base/config.h"
+#include "kernel/base/types.h"
+#include "kernel/base/kernel_consts.h"
+#include "kernel/numerics/krylov_solvers/krylov_solver_type.h"
+#include "kernel/numerics/krylov_solvers/preconditioner_type.h"
+#include "kernel/numerics/krylov_solvers/krylov_solver_output.h"
+#include "kernel/numerics/krylov_solvers/krylov_solver_data.h"
+#include "kernel/numerics/krylov_solvers/jacobi_preconditioner.h"
+#include "kernel/numerics/krylov_solvers/ilu_preconditioner.h"
+#include "kernel/numerics/krylov_solvers/icc_preconditioner.h"
+#include "kernel/numerics/krylov_solvers/amg_preconditioner.h"
+#include "kernel/parallel/threading/thread_pool.h"
+#include "kernel/parallel/parallel_algos/execution_plan.h"
+#include "kernel/parallel/parallel_algos/parallel_reduce.h"
+#include "kernel/parallel/parallel_algos/linear_algebra/matrix_vector_product.h"
+#include "kernel/parallel/utilities/matrix_row_partitioner.h"
+#include "kernel/parallel/utilities/partitioned_type.h"
+#include "kernel/parallel/utilities/reduction_operations.h"
+#include "kernel/utilities/range_1d.h"
+
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace kernel{
+namespace numerics{
+
+///
+/// \brief Krylov solver on the Blaze SparseMatrix<real_t> and
+/// DynVec<real_t> types. It does not need Trilinos. Supports
+/// CG, GMRES(restart), BiCGSTAB, CGS and TFQMR with the Jacobi,
+/// ILU(0), IC(0) and AMG preconditioners or without preconditioner.
+/// The rows are split with partition_matrix_rows() so that every
+/// thread carries the same number of nonzeros. The matrix-vector
+/// products use mat_vec_product_rows() and the dot products use
+/// parallel_reduce() over these partitions on a ThreadPool. ILU(0) and
+/// IC(0) are applied serially. The residual reported is relative to the norm of b
+///
+class BlazeKrylovSolver
+{
+
+public:
+
+    typedef SparseMatrix<real_t> matrix_t;
+    typedef DynVec<real_t> vector_t;
+    typedef KrylovSolverResult output_t;
+
+    /// \brief Constructor. Uses Jacobi preconditioned CG
+    BlazeKrylovSolver();
+
+    /// \brief construct by passing in the preconditioner and solver types
+    explicit BlazeKrylovSolver(const KrylovSolverData& data);
+
+    /// set the solver iterations
+    void set_solver_iterations(uint_t nitrs){data_.n_iterations = nitrs;}
+
+    /// set the solver tolerance
+    void set_solver_tolerance(real_t tol){data_.tolerance = tol;}
+
+    /// set the data of the solver. Throws std::logic_error
+    /// if the solver or the preconditioner is not supported
+    void set_solver_data(const KrylovSolverData& data);
+
+    /// \brief Set the number of Krylov vectors GMRES
+    /// keeps before it restarts. The default is 30
+    void set_gmres_restart(uint_t restart);
+
+    /// \brief Set the number of threads the kernels use.
+    /// The thread pool is rebuilt at the next solve()
+    void set_n_threads(uint_t n_threads);
+
+    /// \brief The number of threads the kernels use
+    uint_t n_threads()const{return n_threads_;}
+
+    /// \brief Read/write access to the AMG preconditioner
+    /// in order to change its parameters before solve()
+    AMGPreconditioner& amg_preconditioner(){return amg_;}
+
+    /// \brief Solve the given system. Throws std::logic_error
+    /// if the sizes of A, x and b do not match
+    output_t solve(const matrix_t& A, vector_t& x, const vector_t& b);
+
+private:
+
+    /// \brief the data the solver is using
+    KrylovSolverData data_;
+
+    /// \brief Number of Krylov vectors for GMRES
+    uint_t restart_;
+
+    /// \brief Number of threads the kernels use
+    uint_t n_threads_;
+
+    /// \brief The rows of the system partitioned by their nonzeros
+    PartitionedType<range1d<uint_t>> rows_;
+
+    /// \brief The task that calls the current body on its row partition
+    struct partition_task;
+
+    /// \brief The threads the kernels run on
+    std::unique_ptr<ThreadPool> pool_;
+
+    /// \brief One task per thread created once per solve()
+    std::unique_ptr<ExecutionPlan<partition_task, ThreadPool>> plan_;
+
+    /// \brief The body the tasks of the plan call
+    mutable std::function<void(uint_t, uint_t)> body_;
+
+    /// \brief The preconditioners
+    JacobiPreconditioner jacobi_;
+    ILUPreconditioner ilu_;
+    ICCPreconditioner icc_;
+    AMGPreconditioner amg_;
+
+    void check_data_()const;
+
+    /// \brief Build the preconditioner the solver is using
+    void build_preconditioner_(const matrix_t& A);
+
+    /// \brief z = M^{-1}r
+    void precondition_(const vector_t& r, vector_t& z)const;
+
+    /// \brief Build the row partitions, the thread pool and the
+    /// execution plan for the given matrix
+    void build_plan_(const matrix_t& A);
+
+    /// \brief Call body(begin, end) for every row partition
+    template<typename BodyType>
+    void for_each_partition_(const BodyType& body)const;
+
+    /// \brief y = A*x
+    void spmv_(const matrix_t& A, const vector_t& x, vector_t& y)const;
+
+    /// \brief r = b - A*x
+    void residual_(const matrix_t& A, const vector_t& x, const vector_t& b, vector_t& r)const;
+
+    /// \brief The dot product of a and b. The partial sums
+    /// of the partitions are combined as a tree so that the result
+    /// does not depend on the scheduling of the threads
+    real_t dot_(const vector_t& a, const vector_t& b)const;
+
+    /// \brief The dot products a*b and a*c in one pass over a
+    std::tuple<real_t, real_t> dot2_(const vector_t& a, const vector_t& b, const vector_t& c)const;
+
+    /// \brief y = a*x + b*y
+    void axpby_(real_t a, const vector_t& x, real_t b, vector_t& y)const;
+
+    void cg_(const matrix_t& A, vector_t& x, const vector_t& b,
+             uint_t n_itrs, real_t tol, output_t& result)const;
+
+    void gmres_(const matrix_t& A, vector_t& x, const vector_t& b,
+                uint_t n_itrs, real_t tol, output_t& result)const;
+
+    void bicgstab_(const matrix_t& A, vector_t& x, const vector_t& b,
+                   uint_t n_itrs, real_t tol, output_t& result)const;
+
+    void cgs_(const matrix_t& A, vector_t& x, const vector_t& b,
+              uint_t n_itrs, real_t tol, output_t& result)const;
+
+    void tfqmr_(const matrix_t& A, vector_t& x, const vector_t& b,
+                uint_t n_itrs, real_t tol, output_t& result)const;
+
+};
+
+inline
+BlazeKrylovSolver::BlazeKrylovSolver()
+    :
+     data_{0, std::numeric_limits<real_t>::max(), PreconditionerType::JACOBI, KrylovSolverType::CG},
+     restart_(30),
+#ifdef USE_OPENMP
+     n_threads_(omp_get_max_threads()),
+#else
+     n_threads_(1),
+#endif
+     rows_(),
+     pool_(),
+     plan_(),
+     body_(),
+     jacobi_(),
+     ilu_(),
+     icc_(),
+     amg_()
+{}
+
+inline
+BlazeKrylovSolver::BlazeKrylovSolver(const KrylovSolverData& data)
+    :
+     BlazeKrylovSolver()
+{
+    data_ = data;
+    check_data_();
+}
+
+inline
+void
+BlazeKrylovSolver::set_solver_data(const KrylovSolverData& data){
+
+    data_ = data;
+    check_data_();
+}
+
+inline
+void
+BlazeKrylovSolver::set_gmres_restart(uint_t restart){
+
+    if(restart == 0){
+        throw std::logic_error("GMRES restart should be positive");
+    }
+
+    restart_ = restart;
+}
+
+inline
+void
+BlazeKrylovSolver::set_n_threads(uint_t n_threads){
+
+    if(n_threads == 0){
+        throw std::logic_error("Number of threads should be positive");
+    }
+
+    n_threads_ = n_threads;
+}
+
+inline
+void
+BlazeKrylovSolver::check_data_()const{
+
+    if(data_.solver_type == KrylovSolverType::INVALID_SOLVER){
+        throw std::logic_error("Solver " + krylov_solver_to_string(data_.solver_type) +
+                               " is not supported by the Blaze Krylov solver");
+    }
+
+    if(data_.precondioner_type == PreconditionerType::LU){
+        throw std::logic_error("Preconditioner " + preconditioner_to_string(data_.precondioner_type) +
+                               " is not supported by the Blaze Krylov solver");
+    }
+}
+
+inline
+BlazeKrylovSolver::output_t
+BlazeKrylovSolver::solve(const matrix_t& A, vector_t& x, const vector_t& b){
+
+    if(A.rows() != A.columns() || A.rows() != b.size() || A.rows() != x.size()){
+        throw std::logic_error("Invalid sizes. Matrix " + std::to_string(A.rows()) + "x" +
+                               std::to_string(A.columns()) + " x size " + std::to_string(x.size()) +
+                               " b size " + std::to_string(b.size()));
+    }
+
+    std::chrono::time_point<std::chrono::system_clock> start, end;
+    start = std::chrono::system_clock::now();
+
+    output_t result;
+    result.solver_type = data_.solver_type;
+    result.precondioner_type = data_.precondioner_type;
+
+    const uint_t n_itrs = data_.n_iterations == 0 ? A.rows() : data_.n_iterations;
+    const real_t tol = data_.tolerance == std::numeric_limits<real_t>::max() ? KernelConsts::tolerance() : data_.tolerance;
+
+    result.tolerance = tol;
+    result.residual = 0.0;
+    result.num_iterations = 0;
+
+    if(A.rows() == 0){
+        result.converged = true;
+        return result;
+    }
+
+    build_plan_(A);
+    build_preconditioner_(A);
+
+    switch(data_.solver_type){
+
+        case KrylovSolverType::CG:
+            cg_(A, x, b, n_itrs, tol, result);
+            break;
+        case KrylovSolverType::GMRES:
+            gmres_(A, x, b, n_itrs, tol, result);
+            break;
+        case KrylovSolverType::BICGSTAB:
+            bicgstab_(A, x, b, n_itrs, tol, result);
+            break;
+        case KrylovSolverType::CGS:
+            cgs_(A, x, b, n_itrs, tol, result);
+            break;
+        case KrylovSolverType::TFQMR:
+            tfqmr_(A, x, b, n_itrs, tol, result);
+            break;
+        default:
+            throw std::logic_error("Solver " + krylov_solver_to_string(data_.solver_type) +
+                                   " is not supported by the Blaze Krylov solver");
+    }
+
+    end = std::chrono::system_clock::now();
+    result.total_time = std::chrono::duration_cast<std::chrono::seconds>(end - start);
+
+    return result;
+}
+
+inline
+void
+BlazeKrylovSolver::build_preconditioner_(const matrix_t& A){
+
+    switch(data_.precondioner_type){
+
+        case PreconditionerType::JACOBI:
+            jacobi_.build(A);
+            break;
+        case PreconditionerType::ILU:
+            ilu_.build(A);
+            break;
+        case PreconditionerType::ICC:
+            icc_.build(A);
+            break;
+        case PreconditionerType::AMG:
+            amg_.set_n_threads(n_threads_);
+            amg_.build(A);
+            break;
+        default:
+            break;
+    }
+}
+
+inline
+void
+BlazeKrylovSolver::precondition_(const vector_t& r, vector_t& z)const{
+
+    switch(data_.precondioner_type){
+
+        case PreconditionerType::JACOBI:
+            jacobi_.apply(r, z);
+            break;
+        case PreconditionerType::ILU:
+            ilu_.apply(r, z);
+            break;
+        case PreconditionerType::ICC:
+            icc_.apply(r, z);
+            break;
+        case PreconditionerType::AMG:
+            amg_.apply(r, z);
+            break;
+        default:
+            for_each_partition_([&](uint_t begin, uint_t end){
+                for(uint_t i=begin; i<end; ++i){
+                    z[i] = r[i];
+                }
+            });
+            break;
+    }
+}
+
+struct BlazeKrylovSolver::partition_task: public TaskBase
+{
+    partition_task(uint_t id, range1d<uint_t> rows, const std::function<void(uint_t, uint_t)>& body)
+        :
+     TaskBase(id),
+     rows_(rows),
+     body_(&body)
+    {}
+
+protected:
+
+    virtual void run()override final{(*body_)(rows_.begin(), rows_.end());}
+
+    // the rows this task works on
+    range1d<uint_t> rows_;
+
+    // the body the solver currently applies
+    const std::function<void(uint_t, uint_t)>* body_;
+};
+
+inline
+void
+BlazeKrylovSolver::build_plan_(const matrix_t& A){
+
+    if(!pool_ || pool_->get_n_threads() != n_threads_){
+        plan_.reset();
+        pool_ = std::make_unique<ThreadPool>(n_threads_);
+    }
+
+    std::vector<range1d<uint_t>> partitions;
+    partition_matrix_rows(A, partitions, n_threads_);
+
+    rows_.set_range(0, A.rows());
+    rows_.set_partitions(partitions);
+
+    plan_ = std::make_unique<ExecutionPlan<partition_task, ThreadPool>>(*pool_, [this](uint_t t){
+        return std::make_unique<partition_task>(t, rows_.get_partition(t), body_);
+    });
+}
+
+template<typename BodyType>
+void
+BlazeKrylovSolver::for_each_partition_(const BodyType& body)const{
+
+    body_ = std::cref(body);
+    const auto& result = plan_->execute(Null());
+
+    if(!result.is_result_valid()){
+        throw std::logic_error("A task of the Blaze Krylov solver did not finish");
+    }
+}
+
+inline
+void
+BlazeKrylovSolver::spmv_(const matrix_t& A, const vector_t& x, vector_t& y)const{
+
+    for_each_partition_([&](uint_t begin, uint_t end){
+        mat_vec_product_rows(A, x, y, begin, end);
+    });
+}
+
+inline
+void
+BlazeKrylovSolver::residual_(const matrix_t& A, const vector_t& x, const vector_t& b, vector_t& r)const{
+
+    for_each_partition_([&](uint_t begin, uint_t end){
+
+        mat_vec_product_rows(A, x, r, begin, end);
+
+        for(uint_t row=begin; row<end; ++row){
+            r[row] = b[row] - r[row];
+        }
+    });
+}
+
+inline
+real_t
+BlazeKrylovSolver::dot_(const vector_t& a, const vector_t& b)const{
+
+    auto map = [&a, &b](uint_t i){return a[i]*b[i];};
+    auto result = parallel_reduce(rows_, map, Sum<real_t>(), *pool_, Null());
+
+    if(!result.is_result_valid()){
+        throw std::logic_error("A task of the Blaze Krylov solver did not finish");
+    }
+
+    return result.get_resource();
+}
+
+inline
+std::tuple<real_t, real_t>
+BlazeKrylovSolver::dot2_(const vector_t& a, const vector_t& b, const vector_t& c)const{
+
+    typedef FusedReduction<Sum<real_t>, Sum<real_t>> reduction_type;
+
+    auto map = [&a, &b, &c](uint_t i){return std::make_tuple(a[i]*b[i], a[i]*c[i]);};
+    auto result = parallel_reduce(rows_, map, reduction_type(), *pool_, Null());
+
+    if(!result.is_result_valid()){
+        throw std::logic_error("A task of the Blaze Krylov solver did not finish");
+    }
+
+    return result.get_resource();
+}
+
+inline
+void
+BlazeKrylovSolver::axpby_(real_t a, const vector_t& x, real_t b, vector_t& y)const{
+
+    for_each_partition_([&](uint_t begin, uint_t end){
+        for(uint_t i=begin; i<end; ++i){
+            y[i] = a*x[i] + b*y[i];
+        }
+    });
+}
+
+inline
+void
+BlazeKrylovSolver::cg_(const matrix_t& A, vector_t& x, const vector_t& b,
+                       uint_t n_itrs, real_t tol, output_t& result)const{
+
+    const uint_t n = b.size();
+
+    vector_t r(n, 0.0);
+    vector_t z(n, 0.0);
+    vector_t p(n, 0.0);
+    vector_t q(n, 0.0);
+
+    const real_t b_norm = std::sqrt(dot_(b, b));
+    const real_t scale = b_norm == 0.0 ? 1.0 : 1.0/b_norm;
+
+    residual_(A, x, b, r);
+    result.residual = std::sqrt(dot_(r, r))*scale;
+
+    if(result.residual <= tol){
+        result.converged = true;
+        return;
+    }
+
+    precondition_(r, z);
+    axpby_(1.0, z, 0.0, p);
+
+    real_t rz = dot_(r, z);
+
+    for(uint_t itr=0; itr<n_itrs; ++itr){
+
+        spmv_(A, p, q);
+        const real_t alpha = rz/dot_(p, q);
+
+        axpby_(alpha, p, 1.0, x);
+        axpby_(-alpha, q, 1.0, r);
+
+        result.num_iterations = itr + 1;
+        result.residual = std::sqrt(dot_(r, r))*scale;
+
+        if(result.residual <= tol){
+            result.converged = true;
+            return;
+        }
+
+        precondition_(r, z);
+
+        const real_t rz_new = dot_(r, z);
+        const real_t beta = rz_new/rz;
+        rz = rz_new;
+
+        // p = z + beta*p
+        axpby_(1.0, z, beta, p);
+    }
+}
+
+inline
+void
+BlazeKrylovSolver::gmres_(const matrix_t& A, vector_t& x, const vector_t& b,
+                          uint_t n_itrs, real_t tol, output_t& result)const{
+
+    const uint_t n = b.size();
+    const uint_t m = restart_;
+
+    // the Krylov basis and the Hessenberg matrix stored by columns
+    std::vector<vector_t> V(m + 1, vector_t(n, 0.0));
+    std::vector<real_t> H((m + 1)*m, 0.0);
+    std::vector<real_t> cs(m, 0.0);
+    std::vector<real_t> sn(m, 0.0);
+    std::vector<real_t> g(m + 1, 0.0);
+    std::vector<real_t> y(m, 0.0);
+
+    vector_t r(n, 0.0);
+    vector_t z(n, 0.0);
+    vector_t w(n, 0.0);
+
+    const real_t b_norm = std::sqrt(dot_(b, b));
+    const real_t scale = b_norm == 0.0 ? 1.0 : 1.0/b_norm;
+
+    residual_(A, x, b, r);
+    real_t beta = std::sqrt(dot_(r, r));
+    result.residual = beta*scale;
+
+    if(result.residual <= tol){
+        result.converged = true;
+        return;
+    }
+
+    uint_t itr = 0;
+
+    while(itr < n_itrs){
+
+        axpby_(1.0/beta, r, 0.0, V[0]);
+        std::fill(g.begin(), g.end(), 0.0);
+        g[0] = beta;
+
+        uint_t k = 0;
+        bool breakdown = false;
+
+        // right preconditioning so that the least
+        // squares residual is the true residual
+        for(uint_t j=0; j<m && itr<n_itrs; ++j){
+
+            precondition_(V[j], z);
+            spmv_(A, z, w);
+
+            // modified Gram-Schmidt
+            for(uint_t i=0; i<=j; ++i){
+                const real_t h = dot_(w, V[i]);
+                H[j*(m + 1) + i] = h;
+                axpby_(-h, V[i], 1.0, w);
+            }
+
+            const real_t h_next = std::sqrt(dot_(w, w));
+            H[j*(m + 1) + j + 1] = h_next;
+
+            // apply the previous rotations to the new column
+            for(uint_t i=0; i<j; ++i){
+                const real_t tmp = cs[i]*H[j*(m + 1) + i] + sn[i]*H[j*(m + 1) + i + 1];
+                H[j*(m + 1) + i + 1] = -sn[i]*H[j*(m + 1) + i] + cs[i]*H[j*(m + 1) + i + 1];
+                H[j*(m + 1) + i] = tmp;
+            }
+
+            const real_t h_jj = H[j*(m + 1) + j];
+            const real_t denom = std::sqrt(h_jj*h_jj + h_next*h_next);
+            cs[j] = denom == 0.0 ? 1.0 : h_jj/denom;
+            sn[j] = denom == 0.0 ? 0.0 : h_next/denom;
+
+            H[j*(m + 1) + j] = cs[j]*h_jj + sn[j]*h_next;
+            H[j*(m + 1) + j + 1] = 0.0;
+
+            g[j + 1] = -sn[j]*g[j];
+            g[j] = cs[j]*g[j];
+
+            ++itr;
+            k = j + 1;
+            result.num_iterations = itr;
+            result.residual = std::abs(g[j + 1])*scale;
+
+            if(result.residual <= tol){
+                break;
+            }
+
+            // the Krylov space is invariant and the
+            // solution is exact in this space
+            if(h_next == 0.0){
+                breakdown = true;
+                break;
+            }
+
+            axpby_(1.0/h_next, w, 0.0, V[j + 1]);
+        }
+
+        // solve the upper triangular system H*y = g
+        for(uint_t i=k; i-- > 0; ){
+
+            real_t sum = g[i];
+            for(uint_t l=i + 1; l<k; ++l){
+                sum -= H[l*(m + 1) + i]*y[l];
+            }
+
+            y[i] = H[i*(m + 1) + i] == 0.0 ? 0.0 : sum/H[i*(m + 1) + i];
+        }
+
+        // x += M^{-1}*V*y
+        for_each_partition_([&](uint_t begin, uint_t end){
+            for(uint_t row=begin; row<end; ++row){
+
+                real_t sum = 0.0;
+                for(uint_t i=0; i<k; ++i){
+                    sum += y[i]*V[i][row];
+                }
+
+                w[row] = sum;
+            }
+        });
+
+        precondition_(w, z);
+        axpby_(1.0, z, 1.0, x);
+
+        residual_(A, x, b, r);
+        beta = std::sqrt(dot_(r, r));
+        result.residual = beta*scale;
+
+        if(result.residual <= tol){
+            result.converged = true;
+            return;
+        }
+
+        if(breakdown){
+            return;
+        }
+    }
+}
+
+inline
+void
+BlazeKrylovSolver::bicgstab_(const matrix_t& A, vector_t& x, const vector_t& b,
+                             uint_t n_itrs, real_t tol, output_t& result)const{
+
+    const uint_t n = b.size();
+
+    vector_t r(n, 0.0);
+    vector_t r_hat(n, 0.0);
+    vector_t p(n, 0.0);
+    vector_t p_hat(n, 0.0);
+    vector_t s(n, 0.0);
+    vector_t s_hat(n, 0.0);
+    vector_t v(n, 0.0);
+    vector_t t(n, 0.0);
+
+    const real_t b_norm = std::sqrt(dot_(b, b));
+    const real_t scale = b_norm == 0.0 ? 1.0 : 1.0/b_norm;
+
+    residual_(A, x, b, r);
+    axpby_(1.0, r, 0.0, r_hat);
+
+    result.residual = std::sqrt(dot_(r, r))*scale;
+
+    if(result.residual <= tol){
+        result.converged = true;
+        return;
+    }
+
+    real_t rho = 1.0;
+    real_t alpha = 1.0;
+    real_t omega = 1.0;
+
+    for(uint_t itr=0; itr<n_itrs; ++itr){
+
+        const real_t rho_new = dot_(r_hat, r);
+
+        // breakdown
+        if(rho_new == 0.0){
+            return;
+        }
+
+        const real_t beta = (rho_new/rho)*(alpha/omega);
+        rho = rho_new;
+
+        // p = r + beta*(p - omega*v)
+        for_each_partition_([&](uint_t begin, uint_t end){
+            for(uint_t i=begin; i<end; ++i){
+                p[i] = r[i] + beta*(p[i] - omega*v[i]);
+            }
+        });
+
+        precondition_(p, p_hat);
+        spmv_(A, p_hat, v);
+        alpha = rho/dot_(r_hat, v);
+
+        // s = r - alpha*v
+        for_each_partition_([&](uint_t begin, uint_t end){
+            for(uint_t i=begin; i<end; ++i){
+                s[i] = r[i] - alpha*v[i];
+            }
+        });
+
+        result.num_iterations = itr + 1;
+
+        const real_t s_norm = std::sqrt(dot_(s, s))*scale;
+        if(s_norm <= tol){
+
+            axpby_(alpha, p_hat, 1.0, x);
+            result.residual = s_norm;
+            result.converged = true;
+            return;
+        }
+
+        precondition_(s, s_hat);
+        spmv_(A, s_hat, t);
+        const auto [ts, tt] = dot2_(t, s, t);
+        omega = ts/tt;
+
+        for_each_partition_([&](uint_t begin, uint_t end){
+            for(uint_t i=begin; i<end; ++i){
+                x[i] += alpha*p_hat[i] + omega*s_hat[i];
+                r[i] = s[i] - omega*t[i];
+            }
+        });
+
+        result.residual = std::sqrt(dot_(r, r))*scale;
+
+        if(result.residual <= tol){
+            result.converged = true;
+            return;
+        }
+
+        if(omega == 0.0){
+            return;
+        }
+    }
+}
+
+inline
+void
+BlazeKrylovSolver::cgs_(const matrix_t& A, vector_t& x, const vector_t& b,
+                        uint_t n_itrs, real_t tol, output_t& result)const{
+
+    const uint_t n = b.size();
+
+    vector_t r(n, 0.0);
+    vector_t r_tilde(n, 0.0);
+    vector_t u(n, 0.0);
+    vector_t p(n, 0.0);
+    vector_t q(n, 0.0);
+    vector_t p_hat(n, 0.0);
+    vector_t u_hat(n, 0.0);
+    vector_t v_hat(n, 0.0);
+
+    const real_t b_norm = std::sqrt(dot_(b, b));
+    const real_t scale = b_norm == 0.0 ? 1.0 : 1.0/b_norm;
+
+    residual_(A, x, b, r);
+    axpby_(1.0, r, 0.0, r_tilde);
+
+    result.residual = std::sqrt(dot_(r, r))*scale;
+
+    if(result.residual <= tol){
+        result.converged = true;
+        return;
+    }
+
+    real_t rho_old = 1.0;
+
+    for(uint_t itr=0; itr<n_itrs; ++itr){
+
+        const real_t rho = dot_(r_tilde, r);
+
+        // breakdown
+        if(rho == 0.0){
+            return;
+        }
+
+        if(itr == 0){
+            axpby_(1.0, r, 0.0, u);
+            axpby_(1.0, u, 0.0, p);
+        }
+        else{
+
+            const real_t beta = rho/rho_old;
+
+            // u = r + beta*q, p = u + beta*(q + beta*p)
+            for_each_partition_([&](uint_t begin, uint_t end){
+                for(uint_t i=begin; i<end; ++i){
+                    u[i] = r[i] + beta*q[i];
+                    p[i] = u[i] + beta*(q[i] + beta*p[i]);
+                }
+            });
+        }
+
+        rho_old = rho;
+
+        precondition_(p, p_hat);
+        spmv_(A, p_hat, v_hat);
+
+        const real_t alpha = rho/dot_(r_tilde, v_hat);
+
+        // q = u - alpha*v_hat and u_hat = u + q
+        for_each_partition_([&](uint_t begin, uint_t end){
+            for(uint_t i=begin; i<end; ++i){
+                q[i] = u[i] - alpha*v_hat[i];
+                v_hat[i] = u[i] + q[i];
+            }
+        });
+
+        precondition_(v_hat, u_hat);
+        axpby_(alpha, u_hat, 1.0, x);
+
+        // r = r - alpha*A*u_hat
+        spmv_(A, u_hat, v_hat);
+        axpby_(-alpha, v_hat, 1.0, r);
+
+        result.num_iterations = itr + 1;
+        result.residual = std::sqrt(dot_(r, r))*scale;
+
+        if(result.residual <= tol){
+            result.converged = true;
+            return;
+        }
+
+        // CGS squares the BiCG polynomial and
+        // the residual may overflow
+        if(!std::isfinite(result.residual)){
+            return;
+        }
+    }
+}
+
+inline
+void
+BlazeKrylovSolver::tfqmr_(const matrix_t& A, vector_t& x, const vector_t& b,
+                          uint_t n_itrs, real_t tol, output_t& result)const{
+
+    const uint_t n = b.size();
+
+    // the algorithm runs on A*M^{-1}. The vectors y are in the
+    // preconditioned space and y_hat = M^{-1}y. The direction d
+    // is kept as M^{-1}d so that it updates x directly
+    vector_t r(n, 0.0);
+    vector_t r_tilde(n, 0.0);
+    vector_t w(n, 0.0);
+    vector_t y1(n, 0.0);
+    vector_t y2(n, 0.0);
+    vector_t y_hat(n, 0.0);
+    vector_t u1(n, 0.0);
+    vector_t u2(n, 0.0);
+    vector_t v(n, 0.0);
+    vector_t d(n, 0.0);
+
+    const real_t b_norm = std::sqrt(dot_(b, b));
+    const real_t scale = b_norm == 0.0 ? 1.0 : 1.0/b_norm;
+
+    residual_(A, x, b, r);
+
+    result.residual = std::sqrt(dot_(r, r))*scale;
+
+    if(result.residual <= tol){
+        result.converged = true;
+        return;
+    }
+
+    axpby_(1.0, r, 0.0, r_tilde);
+    axpby_(1.0, r, 0.0, w);
+    axpby_(1.0, r, 0.0, y1);
+
+    precondition_(y1, y_hat);
+    spmv_(A, y_hat, u1);
+    axpby_(1.0, u1, 0.0, v);
+
+    real_t tau = std::sqrt(dot_(r, r));
+    real_t theta = 0.0;
+    real_t eta = 0.0;
+    real_t rho = dot_(r_tilde, r);
+
+    uint_t itr = 0;
+
+    while(itr < n_itrs){
+
+        const real_t sigma = dot_(r_tilde, v);
+
+        // breakdown
+        if(sigma == 0.0 || rho == 0.0){
+            return;
+        }
+
+        const real_t alpha = rho/sigma;
+
+        for(uint_t j=0; j<2 && itr<n_itrs; ++j){
+
+            // y_hat holds M^{-1}*y1 when j is zero
+            vector_t& u = j == 0 ? u1 : u2;
+
+            if(j == 1){
+
+                // y2 = y1 - alpha*v and u2 = A*M^{-1}*y2
+                for_each_partition_([&](uint_t begin, uint_t end){
+                    for(uint_t i=begin; i<end; ++i){
+                        y2[i] = y1[i] - alpha*v[i];
+                    }
+                });
+
+                precondition_(y2, y_hat);
+                spmv_(A, y_hat, u2);
+            }
+
+            axpby_(-alpha, u, 1.0, w);
+
+            // d = y + (theta^2*eta/alpha)*d
+            axpby_(1.0, y_hat, theta*theta*eta/alpha, d);
+
+            theta = std::sqrt(dot_(w, w))/tau;
+
+            // w is the CGS residual and may overflow
+            if(!std::isfinite(theta)){
+                residual_(A, x, b, r);
+                result.residual = std::sqrt(dot_(r, r))*scale;
+                return;
+            }
+
+            const real_t c = 1.0/std::sqrt(1.0 + theta*theta);
+            tau *= theta*c;
+            eta = c*c*alpha;
+
+            axpby_(eta, d, 1.0, x);
+
+            ++itr;
+            result.num_iterations = itr;
+
+            // tau*sqrt(m + 1) bounds the residual. Compute
+            // the true residual only when the bound is small
+            if(tau*std::sqrt(static_cast<real_t>(itr + 1))*scale <= tol){
+
+                residual_(A, x, b, r);
+                result.residual = std::sqrt(dot_(r, r))*scale;
+
+                if(result.residual <= tol){
+                    result.converged = true;
+                    return;
+                }
+            }
+        }
+
+        const real_t rho_new = dot_(r_tilde, w);
+        const real_t beta = rho_new/rho;
+        rho = rho_new;
+
+        // y1 = w + beta*y2
+        for_each_partition_([&](uint_t begin, uint_t end){
+            for(uint_t i=begin; i<end; ++i){
+                y1[i] = w[i] + beta*y2[i];
+            }
+        });
+
+        precondition_(y1, y_hat);
+        spmv_(A, y_hat, u1);
+
+        // v = u1 + beta*(u2 + beta*v)
+        for_each_partition_([&](uint_t begin, uint_t end){
+            for(uint_t i=begin; i<end; ++i){
+                v[i] = u1[i] + beta*(u2[i] + beta*v[i]);
+            }
+        });
+    }
+
+    residual_(A, x, b, r);
+    result.residual = std::sqrt(dot_(r, r))*scale;
+}
+
+}
+}
+
+#endif // BLAZE_KRYLOV_SOLVER_H
@@ -0,0 +1,148 @@
+#ifndef ICC_PRECONDITIONER_H
+#define ICC_PRECONDITIONER_H
+
+#include "kernel/base/types.h"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace kernel {
+namespace numerics {
+
+/// \brief Incomplete Cholesky factorization with zero fill-in, IC(0).
+/// Only the lower triangle of A is read and A is assumed symmetric
+/// positive definite. The factor L is stored row-wise in the pattern
+/// of the lower triangle with the diagonal as the last entry of every row
+class ICCPreconditioner
+{
+public:
+
+    /// \brief Build the factorization of A. Throws std::logic_error
+    /// if A is not square, a row does not store its diagonal or
+    /// a non-positive pivot is encountered
+    void build(const SparseMatrix<real_t>& A);
+
+    /// \brief Compute z = (LL^T)^{-1}r
+    template<typename VectorType>
+    void apply(const VectorType& r, VectorType& z)const;
+
+    /// \brief The number of rows
+    uint_t size()const{return row_ptr_.empty() ? 0 : row_ptr_.size() - 1;}
+
+private:
+
+    std::vector<uint_t> row_ptr_;
+    std::vector<uint_t> columns_;
+    std::vector<real_t> values_;
+};
+
+inline
+void
+ICCPreconditioner::build(const SparseMatrix<real_t>& A){
+
+    if(A.rows() != A.columns()){
+        throw std::logic_error("IC(0) preconditioner needs a square matrix");
+    }
+
+    const uint_t n = A.rows();
+    const uint_t invalid = std::numeric_limits<uint_t>::max();
+
+    row_ptr_.assign(n + 1, 0);
+    columns_.clear();
+    values_.clear();
+
+    for(uint_t r=0; r<n; ++r){
+
+        for(auto it = A.cbegin(r); it != A.cend(r) && it->index() <= r; ++it){
+            columns_.push_back(it->index());
+            values_.push_back(it->value());
+        }
+
+        if(columns_.size() == row_ptr_[r] || columns_.back() != r){
+            throw std::logic_error("Row " + std::to_string(r) +
+                                   " does not store its diagonal. IC(0) preconditioner cannot be built");
+        }
+
+        row_ptr_[r + 1] = columns_.size();
+    }
+
+    // the position of the columns of the current row
+    std::vector<uint_t> marker(n, invalid);
+
+    for(uint_t i=0; i<n; ++i){
+
+        const uint_t diagonal = row_ptr_[i + 1] - 1;
+
+        for(uint_t p=row_ptr_[i]; p<diagonal; ++p){
+
+            const uint_t k = columns_[p];
+
+            // l_ik = (a_ik - sum_{j<k} l_ij*l_kj)/l_kk. The entries
+            // of row i before p are already computed and marked
+            real_t sum = values_[p];
+            for(uint_t q=row_ptr_[k]; q<row_ptr_[k + 1] - 1; ++q){
+
+                const uint_t pos = marker[columns_[q]];
+                if(pos != invalid){
+                    sum -= values_[pos]*values_[q];
+                }
+            }
+
+            values_[p] = sum/values_[row_ptr_[k + 1] - 1];
+            marker[k] = p;
+        }
+
+        real_t pivot = values_[diagonal];
+        for(uint_t p=row_ptr_[i]; p<diagonal; ++p){
+            pivot -= values_[p]*values_[p];
+            marker[columns_[p]] = invalid;
+        }
+
+        if(pivot <= 0.0){
+            throw std::logic_error("Non-positive pivot at row " + std::to_string(i) +
+                                   ". IC(0) preconditioner cannot be built");
+        }
+
+        values_[diagonal] = std::sqrt(pivot);
+    }
+}
+
+template<typename VectorType>
+void
+ICCPreconditioner::apply(const VectorType& r, VectorType& z)const{
+
+    const uint_t n = size();
+
+    // forward substitution with L
+    for(uint_t i=0; i<n; ++i){
+
+        const uint_t diagonal = row_ptr_[i + 1] - 1;
+
+        real_t sum = r[i];
+        for(uint_t p=row_ptr_[i]; p<diagonal; ++p){
+            sum -= values_[p]*z[columns_[p]];
+        }
+
+        z[i] = sum/values_[diagonal];
+    }
+
+    // backward substitution with L^T. L is stored
+    // by rows so the columns of L^T are scattered
+    for(uint_t i=n; i-- > 0; ){
+
+        const uint_t diagonal = row_ptr_[i + 1] - 1;
+        z[i] /= values_[diagonal];
+
+        for(uint_t p=row_ptr_[i]; p<diagonal; ++p){
+            z[columns_[p]] -= values_[p]*z[i];
+        }
+    }
+}
+
+}
+}
+
+#endif // ICC_PRECONDITIONER_H
@@ -0,0 +1,159 @@
+#ifndef ILU_PRECONDITIONER_H
+#define ILU_PRECONDITIONER_H
+
+#include "kernel/base/types.h"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace kernel {
+namespace numerics {
+
+/// \brief Incomplete LU factorization with zero fill-in, ILU(0).
+/// The factors L (unit lower) and U are stored in a copy of the
+/// sparsity pattern of A. Every row of A should store its diagonal
+class ILUPreconditioner
+{
+public:
+
+    /// \brief Build the factorization of A. Throws std::logic_error
+    /// if A is not square, a row does not store its diagonal or
+    /// a zero pivot is encountered
+    void build(const SparseMatrix<real_t>& A);
+
+    /// \brief Compute z = (LU)^{-1}r
+    template<typename VectorType>
+    void apply(const VectorType& r, VectorType& z)const;
+
+    /// \brief The number of rows
+    uint_t size()const{return diagonal_ptr_.size();}
+
+private:
+
+    std::vector<uint_t> row_ptr_;
+    std::vector<uint_t> columns_;
+    std::vector<real_t> values_;
+
+    /// \brief The position of the diagonal of every row
+    std::vector<uint_t> diagonal_ptr_;
+};
+
+inline
+void
+ILUPreconditioner::build(const SparseMatrix<real_t>& A){
+
+    if(A.rows() != A.columns()){
+        throw std::logic_error("ILU(0) preconditioner needs a square matrix");
+    }
+
+    const uint_t n = A.rows();
+    const uint_t invalid = std::numeric_limits<uint_t>::max();
+
+    row_ptr_.assign(n + 1, 0);
+    diagonal_ptr_.assign(n, invalid);
+    columns_.clear();
+    values_.clear();
+    columns_.reserve(A.nonZeros());
+    values_.reserve(A.nonZeros());
+
+    for(uint_t r=0; r<n; ++r){
+
+        for(auto it = A.cbegin(r); it != A.cend(r); ++it){
+
+            if(it->index() == r){
+                diagonal_ptr_[r] = columns_.size();
+            }
+
+            columns_.push_back(it->index());
+            values_.push_back(it->value());
+        }
+
+        if(diagonal_ptr_[r] == invalid){
+            throw std::logic_error("Row " + std::to_string(r) +
+                                   " does not store its diagonal. ILU(0) preconditioner cannot be built");
+        }
+
+        row_ptr_[r + 1] = columns_.size();
+    }
+
+    // the position of the columns of the current row
+    std::vector<uint_t> marker(n, invalid);
+
+    for(uint_t i=0; i<n; ++i){
+
+        for(uint_t p=row_ptr_[i]; p<row_ptr_[i + 1]; ++p){
+            marker[columns_[p]] = p;
+        }
+
+        // the columns of a row are sorted so the entries
+        // of L come before the diagonal
+        for(uint_t p=row_ptr_[i]; p<diagonal_ptr_[i]; ++p){
+
+            const uint_t k = columns_[p];
+            const real_t pivot = values_[diagonal_ptr_[k]];
+
+            if(pivot == 0.0){
+                throw std::logic_error("Zero pivot at row " + std::to_string(k) +
+                                       ". ILU(0) preconditioner cannot be built");
+            }
+
+            const real_t l_ik = values_[p]/pivot;
+            values_[p] = l_ik;
+
+            // update the entries of row i that are in the pattern
+            for(uint_t q=diagonal_ptr_[k] + 1; q<row_ptr_[k + 1]; ++q){
+
+                const uint_t pos = marker[columns_[q]];
+                if(pos != invalid){
+                    values_[pos] -= l_ik*values_[q];
+                }
+            }
+        }
+
+        for(uint_t p=row_ptr_[i]; p<row_ptr_[i + 1]; ++p){
+            marker[columns_[p]] = invalid;
+        }
+
+        if(values_[diagonal_ptr_[i]] == 0.0){
+            throw std::logic_error("Zero pivot at row " + std::to_string(i) +
+                                   ". ILU(0) preconditioner cannot be built");
+        }
+    }
+}
+
+template<typename VectorType>
+void
+ILUPreconditioner::apply(const VectorType& r, VectorType& z)const{
+
+    const uint_t n = diagonal_ptr_.size();
+
+    // forward substitution with the unit lower factor
+    for(uint_t i=0; i<n; ++i){
+
+        real_t sum = r[i];
+        for(uint_t p=row_ptr_[i]; p<diagonal_ptr_[i]; ++p){
+            sum -= values_[p]*z[columns_[p]];
+        }
+
+        z[i] = sum;
+    }
+
+    // backward substitution with the upper factor
+    for(uint_t i=n; i-- > 0; ){
+
+        real_t sum = z[i];
+        for(uint_t p=diagonal_ptr_[i] + 1; p<row_ptr_[i + 1]; ++p){
+            sum -= values_[p]*z[columns_[p]];
+        }
+
+        z[i] = sum/values_[diagonal_ptr_[i]];
+    }
+}
+
+}
+}
+
+#endif // ILU_PRECONDITIONER_H
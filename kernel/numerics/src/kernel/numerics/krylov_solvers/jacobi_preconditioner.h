@@ -0,0 +1,92 @@
+#ifndef JACOBI_PRECONDITIONER_H
+#define JACOBI_PRECONDITIONER_H
+
+#include "kernel/base/types.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace kernel {
+namespace numerics {
+
+/// \brief Diagonal (Jacobi) preconditioner. It needs only
+/// the diagonal of the operator and therefore works with
+/// matrix-free operators. The operator should expose
+/// m() and diagonal(VectorType&)
+class JacobiPreconditioner
+{
+public:
+
+    /// \brief Build the preconditioner from the diagonal of A.
+    /// Throws std::logic_error if a diagonal entry is zero
+    template<typename OperatorType>
+    void build(const OperatorType& A);
+
+    /// \brief Build the preconditioner from the diagonal of
+    /// the assembled matrix A. Throws std::logic_error if a
+    /// diagonal entry is zero or not stored
+    void build(const SparseMatrix<real_t>& A);
+
+    /// \brief Compute z = D^{-1}r
+    template<typename VectorType>
+    void apply(const VectorType& r, VectorType& z)const;
+
+    /// \brief The number of rows
+    uint_t size()const{return inv_diagonal_.size();}
+
+private:
+
+    DynVec<real_t> inv_diagonal_;
+};
+
+template<typename OperatorType>
+void
+JacobiPreconditioner::build(const OperatorType& A){
+
+    inv_diagonal_.resize(A.m(), false);
+    A.diagonal(inv_diagonal_);
+
+    for(uint_t r=0; r<inv_diagonal_.size(); ++r){
+
+        if(std::abs(inv_diagonal_[r]) == 0.0){
+            throw std::logic_error("Zero diagonal entry at row " + std::to_string(r) +
+                                   ". Jacobi preconditioner cannot be built");
+        }
+
+        inv_diagonal_[r] = 1.0/inv_diagonal_[r];
+    }
+}
+
+inline
+void
+JacobiPreconditioner::build(const SparseMatrix<real_t>& A){
+
+    inv_diagonal_.resize(A.rows(), false);
+
+    for(uint_t r=0; r<inv_diagonal_.size(); ++r){
+
+        auto it = A.find(r, r);
+
+        if(it == A.end(r) || std::abs(it->value()) == 0.0){
+            throw std::logic_error("Zero diagonal entry at row " + std::to_string(r) +
+                                   ". Jacobi preconditioner cannot be built");
+        }
+
+        inv_diagonal_[r] = 1.0/it->value();
+    }
+}
+
+template<typename VectorType>
+void
+JacobiPreconditioner::apply(const VectorType& r, VectorType& z)const{
+
+    for(uint_t i=0; i<inv_diagonal_.size(); ++i){
+        z[i] = inv_diagonal_[i]*r[i];
+    }
+}
+
+}
+}
+
+#endif // JACOBI_PRECONDITIONER_H
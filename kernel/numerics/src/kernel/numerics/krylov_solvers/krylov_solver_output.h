@@ -8,7 +8,7 @@
 namespace kernel {
 namespace numerics {
 
-struct KrylovSolverResult
+struct KrylovSolverResult: public IterativeAlgorithmResult
 {
     ///
     /// \brief The type of the preconditioner the solver is using
@@ -24,10 +24,6 @@ struct KrylovSolverResult
     /// the algorithm on the given stream
     std::ostream& print(std::ostream& out)const;
 
-private:
-
-    IterativeAlgorithmResult result_;
-
 };
 
 inline
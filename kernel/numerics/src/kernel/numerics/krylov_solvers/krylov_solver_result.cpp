@@ -8,7 +8,7 @@ KrylovSolverResult::print(std::ostream& out)const{
 
     out<<"Solver: "<<krylov_solver_to_string(solver_type)<<std::endl;
     out<<"Preconditioner: "<<preconditioner_to_string(precondioner_type)<<std::endl;
-    result_.print(out);
+    IterativeAlgorithmResult::print(out);
     return out;
 }
 
@@ -0,0 +1,347 @@
+#ifndef MATRIX_FREE_KRYLOV_SOLVER_H
+#define MATRIX_FREE_KRYLOV_SOLVER_H
+
+#include "kernel/base/types.h"
+#include "kernel/base/kernel_consts.h"
+#include "kernel/numerics/krylov_solvers/krylov_solver_type.h"
+#include "kernel/numerics/krylov_solvers/preconditioner_type.h"
+#include "kernel/numerics/krylov_solvers/krylov_solver_output.h"
+#include "kernel/numerics/krylov_solvers/krylov_solver_data.h"
+#include "kernel/numerics/krylov_solvers/jacobi_preconditioner.h"
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace kernel{
+namespace numerics{
+
+///
+/// \brief Krylov solver that accesses the operator only through
+/// y = A*x and its diagonal. Supports CG for symmetric operators and
+/// BiCGSTAB otherwise, with or without the Jacobi preconditioner.
+/// Preconditioners that need the matrix entries are not supported.
+/// OperatorType should expose m(), diagonal(DynVec<real_t>&),
+/// apply(const DynVec<real_t>&, DynVec<real_t>&) and the vector_t
+/// typedef. vector_t should expose get_vector()
+///
+template<typename OperatorType>
+class MatrixFreeKrylovSolver
+{
+
+public:
+
+    typedef OperatorType operator_t;
+    typedef typename operator_t::vector_t vector_t;
+    typedef KrylovSolverResult output_t;
+
+    /// \brief Constructor. Uses Jacobi preconditioned CG
+    MatrixFreeKrylovSolver();
+
+    /// \brief construct by passing in the preconditioner and solver types
+    explicit MatrixFreeKrylovSolver(const KrylovSolverData& data);
+
+    /// set the solver iterations
+    void set_solver_iterations(uint_t nitrs){data_.n_iterations = nitrs;}
+
+    /// set the solver tolerance
+    void set_solver_tolerance(real_t tol){data_.tolerance = tol;}
+
+    /// set the data of the solver. Throws std::logic_error
+    /// if the solver or the preconditioner is not supported
+    void set_solver_data(const KrylovSolverData& data);
+
+    /// \brief Solve the given system
+    output_t solve(const operator_t& A, vector_t& x, const vector_t& b);
+
+private:
+
+    /// \brief the data the solver is using
+    KrylovSolverData data_;
+
+    /// \brief The preconditioner
+    JacobiPreconditioner preconditioner_;
+
+    void check_data_()const;
+
+    /// \brief z = M^{-1}r
+    void precondition_(const DynVec<real_t>& r, DynVec<real_t>& z)const;
+
+    void cg_(const operator_t& A, DynVec<real_t>& x, const DynVec<real_t>& b,
+             uint_t n_itrs, real_t tol, output_t& result)const;
+
+    void bicgstab_(const operator_t& A, DynVec<real_t>& x, const DynVec<real_t>& b,
+                   uint_t n_itrs, real_t tol, output_t& result)const;
+
+    static real_t dot_(const DynVec<real_t>& a, const DynVec<real_t>& b);
+
+};
+
+template<typename OperatorType>
+MatrixFreeKrylovSolver<OperatorType>::MatrixFreeKrylovSolver()
+    :
+     data_{0, std::numeric_limits<real_t>::max(), PreconditionerType::JACOBI, KrylovSolverType::CG},
+     preconditioner_()
+{}
+
+template<typename OperatorType>
+MatrixFreeKrylovSolver<OperatorType>::MatrixFreeKrylovSolver(const KrylovSolverData& data)
+    :
+     data_(data),
+     preconditioner_()
+{
+    check_data_();
+}
+
+template<typename OperatorType>
+void
+MatrixFreeKrylovSolver<OperatorType>::set_solver_data(const KrylovSolverData& data){
+
+    data_ = data;
+    check_data_();
+}
+
+template<typename OperatorType>
+void
+MatrixFreeKrylovSolver<OperatorType>::check_data_()const{
+
+    if(data_.solver_type != KrylovSolverType::CG &&
+       data_.solver_type != KrylovSolverType::BICGSTAB){
+        throw std::logic_error("Solver " + krylov_solver_to_string(data_.solver_type) +
+                               " is not supported by the matrix-free solver");
+    }
+
+    if(data_.precondioner_type != PreconditionerType::JACOBI &&
+       data_.precondioner_type != PreconditionerType::INVALID_PREC){
+        throw std::logic_error("Preconditioner " + preconditioner_to_string(data_.precondioner_type) +
+                               " needs the matrix entries and is not supported by the matrix-free solver");
+    }
+}
+
+template<typename OperatorType>
+typename MatrixFreeKrylovSolver<OperatorType>::output_t
+MatrixFreeKrylovSolver<OperatorType>::solve(const operator_t& A, vector_t& x, const vector_t& b){
+
+    std::chrono::time_point<std::chrono::system_clock> start, end;
+    start = std::chrono::system_clock::now();
+
+    output_t result;
+    result.solver_type = data_.solver_type;
+    result.precondioner_type = data_.precondioner_type;
+
+    const uint_t n_itrs = data_.n_iterations == 0 ? A.m() : data_.n_iterations;
+    const real_t tol = data_.tolerance == std::numeric_limits<real_t>::max() ? KernelConsts::tolerance() : data_.tolerance;
+
+    result.tolerance = tol;
+
+    if(data_.precondioner_type == PreconditionerType::JACOBI){
+        preconditioner_.build(A);
+    }
+
+    if(data_.solver_type == KrylovSolverType::CG){
+        cg_(A, x.get_vector(), b.get_vector(), n_itrs, tol, result);
+    }
+    else{
+        bicgstab_(A, x.get_vector(), b.get_vector(), n_itrs, tol, result);
+    }
+
+    end = std::chrono::system_clock::now();
+    result.total_time = std::chrono::duration_cast<std::chrono::seconds>(end - start);
+
+    return result;
+}
+
+template<typename OperatorType>
+void
+MatrixFreeKrylovSolver<OperatorType>::precondition_(const DynVec<real_t>& r, DynVec<real_t>& z)const{
+
+    if(data_.precondioner_type == PreconditionerType::JACOBI){
+        preconditioner_.apply(r, z);
+        return;
+    }
+
+    for(uint_t i=0; i<r.size(); ++i){
+        z[i] = r[i];
+    }
+}
+
+template<typename OperatorType>
+real_t
+MatrixFreeKrylovSolver<OperatorType>::dot_(const DynVec<real_t>& a, const DynVec<real_t>& b){
+
+    real_t sum = 0.0;
+    for(uint_t i=0; i<a.size(); ++i){
+        sum += a[i]*b[i];
+    }
+
+    return sum;
+}
+
+template<typename OperatorType>
+void
+MatrixFreeKrylovSolver<OperatorType>::cg_(const operator_t& A, DynVec<real_t>& x, const DynVec<real_t>& b,
+                                          uint_t n_itrs, real_t tol, output_t& result)const{
+
+    const uint_t n = b.size();
+
+    DynVec<real_t> r(n, 0.0);
+    DynVec<real_t> z(n, 0.0);
+    DynVec<real_t> p(n, 0.0);
+    DynVec<real_t> q(n, 0.0);
+
+    // the residual relative to the norm of b
+    const real_t b_norm = std::sqrt(dot_(b, b));
+    const real_t scale = b_norm == 0.0 ? 1.0 : 1.0/b_norm;
+
+    A.apply(x, q);
+    for(uint_t i=0; i<n; ++i){
+        r[i] = b[i] - q[i];
+    }
+
+    result.residual = std::sqrt(dot_(r, r))*scale;
+    result.num_iterations = 0;
+
+    if(result.residual <= tol){
+        result.converged = true;
+        return;
+    }
+
+    precondition_(r, z);
+    for(uint_t i=0; i<n; ++i){
+        p[i] = z[i];
+    }
+
+    real_t rz = dot_(r, z);
+
+    for(uint_t itr=0; itr<n_itrs; ++itr){
+
+        A.apply(p, q);
+        const real_t alpha = rz/dot_(p, q);
+
+        for(uint_t i=0; i<n; ++i){
+            x[i] += alpha*p[i];
+            r[i] -= alpha*q[i];
+        }
+
+        result.num_iterations = itr + 1;
+        result.residual = std::sqrt(dot_(r, r))*scale;
+
+        if(result.residual <= tol){
+            result.converged = true;
+            return;
+        }
+
+        precondition_(r, z);
+
+        const real_t rz_new = dot_(r, z);
+        const real_t beta = rz_new/rz;
+        rz = rz_new;
+
+        for(uint_t i=0; i<n; ++i){
+            p[i] = z[i] + beta*p[i];
+        }
+    }
+}
+
+template<typename OperatorType>
+void
+MatrixFreeKrylovSolver<OperatorType>::bicgstab_(const operator_t& A, DynVec<real_t>& x, const DynVec<real_t>& b,
+                                                uint_t n_itrs, real_t tol, output_t& result)const{
+
+    const uint_t n = b.size();
+
+    DynVec<real_t> r(n, 0.0);
+    DynVec<real_t> r_hat(n, 0.0);
+    DynVec<real_t> p(n, 0.0);
+    DynVec<real_t> p_hat(n, 0.0);
+    DynVec<real_t> s(n, 0.0);
+    DynVec<real_t> s_hat(n, 0.0);
+    DynVec<real_t> v(n, 0.0);
+    DynVec<real_t> t(n, 0.0);
+
+    const real_t b_norm = std::sqrt(dot_(b, b));
+    const real_t scale = b_norm == 0.0 ? 1.0 : 1.0/b_norm;
+
+    A.apply(x, v);
+    for(uint_t i=0; i<n; ++i){
+        r[i] = b[i] - v[i];
+        r_hat[i] = r[i];
+        v[i] = 0.0;
+    }
+
+    result.residual = std::sqrt(dot_(r, r))*scale;
+    result.num_iterations = 0;
+
+    if(result.residual <= tol){
+        result.converged = true;
+        return;
+    }
+
+    real_t rho = 1.0;
+    real_t alpha = 1.0;
+    real_t omega = 1.0;
+
+    for(uint_t itr=0; itr<n_itrs; ++itr){
+
+        const real_t rho_new = dot_(r_hat, r);
+
+        // breakdown
+        if(rho_new == 0.0){
+            return;
+        }
+
+        const real_t beta = (rho_new/rho)*(alpha/omega);
+        rho = rho_new;
+
+        for(uint_t i=0; i<n; ++i){
+            p[i] = r[i] + beta*(p[i] - omega*v[i]);
+        }
+
+        precondition_(p, p_hat);
+        A.apply(p_hat, v);
+        alpha = rho/dot_(r_hat, v);
+
+        for(uint_t i=0; i<n; ++i){
+            s[i] = r[i] - alpha*v[i];
+        }
+
+        result.num_iterations = itr + 1;
+
+        if(std::sqrt(dot_(s, s))*scale <= tol){
+
+            for(uint_t i=0; i<n; ++i){
+                x[i] += alpha*p_hat[i];
+            }
+
+            result.residual = std::sqrt(dot_(s, s))*scale;
+            result.converged = true;
+            return;
+        }
+
+        precondition_(s, s_hat);
+        A.apply(s_hat, t);
+        omega = dot_(t, s)/dot_(t, t);
+
+        for(uint_t i=0; i<n; ++i){
+            x[i] += alpha*p_hat[i] + omega*s_hat[i];
+            r[i] = s[i] - omega*t[i];
+        }
+
+        result.residual = std::sqrt(dot_(r, r))*scale;
+
+        if(result.residual <= tol){
+            result.converged = true;
+            return;
+        }
+
+        if(omega == 0.0){
+            return;
+        }
+    }
+}
+
+}
+}
+
+#endif // MATRIX_FREE_KRYLOV_SOLVER_H
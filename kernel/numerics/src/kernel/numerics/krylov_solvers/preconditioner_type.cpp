@@ -13,6 +13,8 @@ std::string preconditioner_to_string(PreconditionerType type){
         return "ILU";
     case PreconditionerType::JACOBI:
         return "JACOBI";
+    case PreconditionerType::AMG:
+        return "AMG";
     }
 
     return "INVALID_PREC";
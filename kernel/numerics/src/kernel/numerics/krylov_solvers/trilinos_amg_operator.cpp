@@ -0,0 +1,85 @@
+#include "kernel/numerics/krylov_solvers/trilinos_amg_operator.h"
+
+#ifdef USE_TRILINOS
+
+#include <stdexcept>
+#include <vector>
+
+namespace kernel{
+namespace numerics{
+
+TrilinosAMGOperator::TrilinosAMGOperator()
+    :
+    Epetra_Operator(),
+    matrix_(nullptr),
+    amg_()
+{}
+
+void
+TrilinosAMGOperator::build(const Epetra_CrsMatrix& A){
+
+    if(A.Comm().NumProc() != 1){
+        throw std::logic_error("TrilinosAMGOperator supports only serial matrices");
+    }
+
+    matrix_ = &A;
+
+    const uint_t n = A.NumMyRows();
+
+    std::vector<uint_t> row_ptr(n + 1, 0);
+    std::vector<uint_t> columns;
+    std::vector<real_t> values;
+    columns.reserve(A.NumMyNonzeros());
+    values.reserve(A.NumMyNonzeros());
+
+    for(uint_t r=0; r<n; ++r){
+
+        int n_entries = 0;
+        double* row_values = nullptr;
+        int* row_indices = nullptr;
+
+        A.ExtractMyRowView(r, n_entries, row_values, row_indices);
+
+        // with a serial communicator the local
+        // column indices are the global ones
+        for(int i=0; i<n_entries; ++i){
+            columns.push_back(row_indices[i]);
+            values.push_back(row_values[i]);
+        }
+
+        row_ptr[r + 1] = columns.size();
+    }
+
+    amg_.build(n, row_ptr, columns, values);
+}
+
+int
+TrilinosAMGOperator::Apply(const Epetra_MultiVector& X, Epetra_MultiVector& Y)const{
+
+    if(!matrix_){
+        return -1;
+    }
+
+    return matrix_->Apply(X, Y);
+}
+
+int
+TrilinosAMGOperator::ApplyInverse(const Epetra_MultiVector& X, Epetra_MultiVector& Y)const{
+
+    if(!matrix_ || X.NumVectors() != Y.NumVectors()){
+        return -1;
+    }
+
+    // X and Y may be the same object. The V-cycle
+    // copies the input before writing the output
+    for(int v=0; v<X.NumVectors(); ++v){
+        amg_.apply(X[v], Y[v]);
+    }
+
+    return 0;
+}
+
+}
+}
+
+#endif
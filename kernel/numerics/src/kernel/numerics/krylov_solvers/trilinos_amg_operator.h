@@ -0,0 +1,76 @@
+#ifndef TRILINOS_AMG_OPERATOR_H
+#define TRILINOS_AMG_OPERATOR_H
+
+#include "kernel/base/config.h"
+
+#ifdef USE_TRILINOS
+
+#include "kernel/base/types.h"
+#include "kernel/numerics/krylov_solvers/amg_preconditioner.h"
+
+#include <Epetra_Operator.h>
+#include <Epetra_CrsMatrix.h>
+#include <Epetra_MultiVector.h>
+#include <Epetra_Map.h>
+#include <Epetra_Comm.h>
+
+namespace kernel{
+namespace numerics{
+
+///
+/// \brief Exposes the AMGPreconditioner to AztecOO.
+/// ApplyInverse() performs one V-cycle. The matrix
+/// should be distributed with Epetra_SerialComm
+///
+class TrilinosAMGOperator: public Epetra_Operator
+{
+
+public:
+
+    /// \brief Constructor
+    TrilinosAMGOperator();
+
+    /// \brief Build the AMG hierarchy from the given matrix.
+    /// The matrix should outlive the operator
+    void build(const Epetra_CrsMatrix& A);
+
+    /// \brief Read/write access to the AMG preconditioner
+    AMGPreconditioner& get_preconditioner(){return amg_;}
+
+    /// \brief Transpose is not supported. Returns -1 if use_transpose is true
+    virtual int SetUseTranspose(bool use_transpose)override final{return use_transpose ? -1 : 0;}
+
+    /// \brief Y = A*X
+    virtual int Apply(const Epetra_MultiVector& X, Epetra_MultiVector& Y)const override final;
+
+    /// \brief Y = M^{-1}*X with one V-cycle per vector
+    virtual int ApplyInverse(const Epetra_MultiVector& X, Epetra_MultiVector& Y)const override final;
+
+    virtual double NormInf()const override final{return 0.0;}
+
+    virtual const char* Label()const override final{return "kernel::numerics::TrilinosAMGOperator";}
+
+    virtual bool UseTranspose()const override final{return false;}
+
+    virtual bool HasNormInf()const override final{return false;}
+
+    virtual const Epetra_Comm& Comm()const override final{return matrix_->Comm();}
+
+    virtual const Epetra_Map& OperatorDomainMap()const override final{return matrix_->OperatorDomainMap();}
+
+    virtual const Epetra_Map& OperatorRangeMap()const override final{return matrix_->OperatorRangeMap();}
+
+private:
+
+    /// \brief The matrix the hierarchy is built from
+    const Epetra_CrsMatrix* matrix_;
+
+    /// \brief The preconditioner
+    AMGPreconditioner amg_;
+};
+
+}
+}
+
+#endif
+#endif // TRILINOS_AMG_OPERATOR_H
@@ -42,6 +42,11 @@ TrilinosKrylovSolver::set_preconditioner()
         linear_solver_.SetAztecOption(AZ_subdomain_solve, AZ_lu);
       break;
 
+    case PreconditionerType::AMG:
+        // the operator is set in solve() once the matrix is known
+        linear_solver_.SetAztecOption(AZ_precond, AZ_none);
+      break;
+
     default:
         linear_solver_.SetAztecOption(AZ_precond, AZ_dom_decomp);
         linear_solver_.SetAztecOption(AZ_subdomain_solve, AZ_ilu);
@@ -118,8 +123,6 @@ TrilinosKrylovSolver::solve(const TrilinosEpetraMatrix& A, TrilinosEpetraVector&
    start = std::chrono::system_clock::now();
    KrylovSolverResult result;
 
-   result.nprocs = 1;
-   result.nthreads = 1;
    result.solver_type = data_.solver_type;
    result.precondioner_type = data_.precondioner_type;
 
@@ -139,13 +142,28 @@ TrilinosKrylovSolver::solve(const TrilinosEpetraMatrix& A, TrilinosEpetraVector&
    Epetra_Vector * esol = x.get_vector();
    Epetra_Vector * erhs = const_cast<TrilinosEpetraVector&>(b).get_vector();
 
-   linear_solver_.Iterate(emat, esol, erhs, data_.n_iterations, data_.tolerance);
+   if(data_.precondioner_type == PreconditionerType::AMG){
+
+       // the user matrix should be set before the preconditioner
+       // operator otherwise AztecOO uses the matrix as the preconditioner
+       amg_.build(*emat);
+       linear_solver_.SetUserMatrix(emat);
+       linear_solver_.SetLHS(esol);
+       linear_solver_.SetRHS(erhs);
+       linear_solver_.SetPrecOperator(&amg_);
+       linear_solver_.Iterate(data_.n_iterations, data_.tolerance);
+   }
+   else{
+       linear_solver_.Iterate(emat, esol, erhs, data_.n_iterations, data_.tolerance);
+   }
 
    end = std::chrono::system_clock::now();
 
-   result.runtime = end-start;
-   result.niterations = linear_solver_.NumIters();
+   result.total_time = std::chrono::duration_cast<std::chrono::seconds>(end-start);
+   result.num_iterations = linear_solver_.NumIters();
    result.residual = linear_solver_.TrueResidual();
+   result.tolerance = data_.tolerance;
+   result.converged = linear_solver_.GetAztecStatus()[AZ_why] == AZ_normal;
 
 
   // return the # of its. and the final residual norm.
@@ -11,6 +11,7 @@
 #include "kernel/numerics/krylov_solvers/preconditioner_type.h"
 #include "kernel/numerics/krylov_solvers/krylov_solver_output.h"
 #include "kernel/numerics/krylov_solvers/krylov_solver_data.h"
+#include "kernel/numerics/krylov_solvers/trilinos_amg_operator.h"
 
 // Trilinos include files.
 #include <AztecOO.h>
@@ -73,13 +74,18 @@ private:
   /// \brief Iplement the Krylov solver by using Trilinos::AztecOO
   AztecOO  linear_solver_;
 
+  /// \brief The AMG preconditioner. AztecOO does not provide
+  /// AMG so it is passed in as a user preconditioner
+  TrilinosAMGOperator amg_;
+
 };
 
 inline
 TrilinosKrylovSolver::TrilinosKrylovSolver()
                             :
                             data_(),
-                            linear_solver_()
+                            linear_solver_(),
+                            amg_()
                             {} 
                             
 
@@ -87,7 +93,8 @@ inline
 TrilinosKrylovSolver::TrilinosKrylovSolver(const KrylovSolverData& data)
                             :
                            data_(data),
-                           linear_solver_()
+                           linear_solver_(),
+                           amg_()
 {
     set_preconditioner();
     set_krylov_solver();
@@ -0,0 +1,39 @@
+#ifndef MATRIX_FREE_SOLUTION_POLICY_H
+#define MATRIX_FREE_SOLUTION_POLICY_H
+
+#include "kernel/base/config.h"
+
+#ifdef USE_FVM
+
+namespace kernel {
+namespace numerics {
+
+/// forward declarations
+template<int dim> class FVMatrixFreeOperator;
+class FVMatrixFreeVector;
+template<typename OperatorType> class MatrixFreeKrylovSolver;
+struct KrylovSolverResult;
+
+///
+/// \brief A solution policy should
+/// expose the type of the matrix and vector
+/// data structures as well as the solver type.
+/// With this policy the FV systems do not store
+/// the system matrix. They cache the face coefficients
+/// of the operator and solve with a matrix-free
+/// Krylov solver and the Jacobi preconditioner
+///
+template<int dim>
+struct FVMatrixFreeSolutionPolicy
+{
+    typedef FVMatrixFreeOperator<dim> matrix_t;
+    typedef FVMatrixFreeVector vector_t;
+    typedef MatrixFreeKrylovSolver<FVMatrixFreeOperator<dim>> solver_t;
+    typedef KrylovSolverResult solver_output_t;
+};
+
+}
+}
+
+#endif
+#endif // MATRIX_FREE_SOLUTION_POLICY_H
@@ -24,6 +24,11 @@ GDConfig::GDConfig(const std::map<std::string, std::any>& options)
         learning_rate = std::any_cast<real_t>(itr->second);
     }
 
+    itr = options.find("batch_size");
+    if(itr != options.end()){
+        batch_size = std::any_cast<uint_t>(itr->second);
+    }
+
     itr = options.find("verbose");
 
     if(itr != options.end()){
@@ -36,6 +41,7 @@ GDConfig::reset(const GDConfig& control){
 
     this->kernel::IterativeAlgorithmController::reset(control);
     learning_rate = control.learning_rate;
+    batch_size = control.batch_size;
 }
 
 }
@@ -29,12 +29,23 @@ struct GDConfig: public kernel::IterativeAlgorithmController
     ///
     real_t learning_rate;
 
+    ///
+    /// \brief The number of examples in a mini-batch. SGD updates
+    /// the parameters once per example when this is 0 or 1. The step
+    /// is learning_rate times the gradient the function returns for
+    /// the batch. For SSELoss this is the sum over the examples, not
+    /// the mean, so the usable learning rate shrinks as the batch grows.
+    /// MSELoss and CategoricalCrossEntropy average over the batch
+    ///
+    uint_t batch_size;
+
     ///
     /// \brief Constructor
     ///
     explicit GDConfig( uint_t max_num_itrs,
                        real_t tolerance=kernel::KernelConsts::tolerance(),
-                       real_t eta=GDConfig::DEFAULT_LEARNING_RATE );
+                       real_t eta=GDConfig::DEFAULT_LEARNING_RATE,
+                       uint_t batch_size=1 );
 
     ///
     /// \brief Constructor
@@ -49,10 +60,11 @@ struct GDConfig: public kernel::IterativeAlgorithmController
 };
 
 inline
-GDConfig::GDConfig( uint_t max_num_itrs, real_t tolerance, real_t eta_ )
+GDConfig::GDConfig( uint_t max_num_itrs, real_t tolerance, real_t eta_, uint_t batch_size_ )
     :
 kernel::IterativeAlgorithmController(max_num_itrs,  tolerance),
-learning_rate(eta_)
+learning_rate(eta_),
+batch_size(batch_size_)
 {}
 
 
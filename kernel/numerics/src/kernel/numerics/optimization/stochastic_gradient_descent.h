@@ -15,14 +15,48 @@
 #include <iostream>
 #include <vector>
 #include <limits>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
 
 namespace kernel {
 namespace numerics{
 namespace opt {
 
+namespace detail
+{
+
+///
+/// \brief The return type of FunctionTp::batch_gradients
+///
+template<typename DatasetTp, typename FunctionTp>
+using batch_gradients_t = decltype(std::declval<const FunctionTp&>().batch_gradients(std::declval<const DatasetTp&>(),
+                                                                                    uint_t(), uint_t(),
+                                                                                    std::declval<DynVec<real_t>&>()));
+
+///
+/// \brief has_batch_gradients. True if FunctionTp exposes
+/// batch_gradients(dataset, begin, end, gradients) that computes
+/// the error and the gradients of a block of examples in one call
+///
+template<typename DatasetTp, typename FunctionTp, typename=void>
+struct has_batch_gradients: std::false_type
+{};
+
+template<typename DatasetTp, typename FunctionTp>
+struct has_batch_gradients<DatasetTp, FunctionTp, std::void_t<batch_gradients_t<DatasetTp, FunctionTp>>>: std::true_type
+{};
+
+}
+
 ///
 /// \brief The SGD class. Vanilla implementation of stochastic gradient descent
-/// optimization algorithm
+/// optimization algorithm. When GDConfig::batch_size is larger than one the
+/// parameters are updated once per mini-batch of consecutive examples. If the
+/// function exposes batch_gradients (e.g. cengine::ml::SSELoss) the gradients
+/// of a mini-batch are computed in one call otherwise the gradients of
+/// the examples in the batch are added up. See GDConfig::batch_size for
+/// the scale of the batch gradients
 ///
 template<typename DatasetTp, typename FunctionTp>
 class SGD: public OptimizerBase<DatasetTp, FunctionTp>
@@ -88,6 +122,12 @@ private:
     /// \return
     ///
     output_t do_solve_(const data_set_t& mat, function_t& h);
+
+    ///
+    /// \brief Make one pass over the examples updating the parameters
+    /// once per mini-batch. Returns the total error of the pass
+    ///
+    real_t mini_batch_epoch_(const data_set_t& mat, function_t& h);
 };
 
 template<typename DatasetTp, typename FunctionTp>
@@ -136,22 +176,29 @@ SGD<DatasetTp, FunctionTp>::do_solve_(const data_set_t& mat, function_t& h){
 
         // total error for iteration
         auto total_error = 0.0;
-        for(uint_t exidx = 0; exidx < mat.n_examples(); ++ exidx){
 
-            auto [row, label] = mat[exidx];
-            auto error = h.error_at(row, label);
+        if(input_.batch_size > 1){
+            total_error = mini_batch_epoch_(mat, h);
+        }
+        else{
 
-            // get the gradients with respect to the coefficients
-            auto j_grad = h.param_gradient_at(row, label);
-            auto coeffs = h.parameters();
+            for(uint_t exidx = 0; exidx < mat.n_examples(); ++ exidx){
 
-            for(uint_t c=0; c<coeffs.size(); ++c){
-               coeffs[c] += -input_.learning_rate*j_grad[c];
-            }
+                auto [row, label] = mat[exidx];
+                auto error = h.error_at(row, label);
+
+                // get the gradients with respect to the coefficients
+                auto j_grad = h.param_gradient_at(row, label);
+                auto coeffs = h.parameters();
 
-            // reset again the coeffs
-            h.update_parameters(coeffs);
-            total_error += error;
+                for(uint_t c=0; c<coeffs.size(); ++c){
+                   coeffs[c] += -input_.learning_rate*j_grad[c];
+                }
+
+                // reset again the coeffs
+                h.update_parameters(coeffs);
+                total_error += error;
+            }
         }
 
         real_t error = std::fabs(previous_error - total_error);
@@ -183,6 +230,48 @@ SGD<DatasetTp, FunctionTp>::do_solve_(const data_set_t& mat, function_t& h){
     return info;
 }
 
+template<typename DatasetTp, typename FunctionTp>
+real_t
+SGD<DatasetTp, FunctionTp>::mini_batch_epoch_(const data_set_t& mat, function_t& h){
+
+    auto total_error = 0.0;
+    DynVec<real_t> j_grads;
+
+    for(uint_t begin = 0; begin < mat.n_examples(); begin += input_.batch_size){
+
+        const uint_t end = std::min(begin + input_.batch_size, mat.n_examples());
+
+        if constexpr(detail::has_batch_gradients<data_set_t, function_t>::value){
+            total_error += h.batch_gradients(mat, begin, end, j_grads);
+        }
+        else{
+
+            j_grads = DynVec<real_t>(h.n_parameters(), 0.0);
+
+            for(uint_t exidx = begin; exidx < end; ++ exidx){
+
+                auto [row, label] = mat[exidx];
+                total_error += h.error_at(row, label);
+
+                auto grad = h.param_gradient_at(row, label);
+                for(uint_t c=0; c<grad.size(); ++c){
+                    j_grads[c] += grad[c];
+                }
+            }
+        }
+
+        auto coeffs = h.parameters();
+
+        for(uint_t c=0; c<coeffs.size(); ++c){
+           coeffs[c] += -input_.learning_rate*j_grads[c];
+        }
+
+        h.update_parameters(coeffs);
+    }
+
+    return total_error;
+}
+
 }
 }
 
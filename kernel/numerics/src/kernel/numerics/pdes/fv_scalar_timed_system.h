@@ -99,8 +99,13 @@ FVScalarTimedSystem<dim, TimeStepper, AssemblyPolicy, SolutionPolicy >::distribu
 
     this->dofs_manager_.distribute_dofs(*this->m_ptr_, this->var_);
 
+    // the symbolic phase. The mesh does not change so the
+    // pattern is fixed and the time steps write the values in place
+    std::vector<std::vector<uint_t>> pattern;
+    this->dofs_manager_.sparsity_pattern(*this->m_ptr_, pattern);
+
     // let's initialize the matrix and vector
-    this->matrix_.init(this->dofs_manager_.n_dofs(), this->dofs_manager_.n_dofs(), 6);
+    this->matrix_.init(this->dofs_manager_.n_dofs(), this->dofs_manager_.n_dofs(), pattern);
     this->solution_.init(this->dofs_manager_.n_dofs(), false);
     this->rhs_.init(this->dofs_manager_.n_dofs(), false);
 
@@ -116,10 +121,10 @@ template<int dim, typename TimeStepper, typename AssemblyPolicy, typename Soluti
 void
 FVScalarTimedSystem<dim, TimeStepper, AssemblyPolicy, SolutionPolicy >::assemble_system(){
 
-    // zero the system entries
+    // zero the system entries. The solution is kept
+    // as it is a good initial guess for the next step
     this->matrix_.zero();
     this->rhs_.zero();
-    this->solution_.zero();
 
     this->assembly_.set_dof_manager(this->dofs_manager_);
     stepper_.set_dof_manager(this->dofs_manager_);
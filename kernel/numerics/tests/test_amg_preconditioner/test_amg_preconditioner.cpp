@@ -0,0 +1,214 @@
+#include "kernel/base/types.h"
+#include "kernel/numerics/krylov_solvers/amg_preconditioner.h"
+#include "kernel/numerics/krylov_solvers/blaze_krylov_solver.h"
+#include "kernel/numerics/krylov_solvers/krylov_solver_data.h"
+
+#include <cmath>
+#include <vector>
+#include <gtest/gtest.h>
+
+namespace{
+
+using kernel::uint_t;
+using kernel::real_t;
+using kernel::DynVec;
+using kernel::SparseMatrix;
+using kernel::numerics::AMGPreconditioner;
+using kernel::numerics::BlazeKrylovSolver;
+using kernel::numerics::KrylovSolverData;
+using kernel::numerics::KrylovSolverType;
+using kernel::numerics::PreconditionerType;
+
+/// \brief The FV Laplace matrix on an n x n grid of unit
+/// squares with zero Dirichlet conditions on the boundary
+SparseMatrix<real_t> laplace(uint_t n){
+
+    const uint_t n_rows = n*n;
+    SparseMatrix<real_t> A(n_rows, n_rows);
+    A.reserve(5*n_rows);
+
+    for(uint_t j=0; j<n; ++j){
+        for(uint_t i=0; i<n; ++i){
+
+            const uint_t row = j*n + i;
+
+            // boundary faces contribute twice the
+            // flux of an interior face to the diagonal
+            real_t diagonal = 0.0;
+            diagonal += j > 0 ? 1.0 : 2.0;
+            diagonal += i > 0 ? 1.0 : 2.0;
+            diagonal += i < n - 1 ? 1.0 : 2.0;
+            diagonal += j < n - 1 ? 1.0 : 2.0;
+
+            if(j > 0){
+                A.append(row, row - n, -1.0);
+            }
+
+            if(i > 0){
+                A.append(row, row - 1, -1.0);
+            }
+
+            A.append(row, row, diagonal);
+
+            if(i < n - 1){
+                A.append(row, row + 1, -1.0);
+            }
+
+            if(j < n - 1){
+                A.append(row, row + n, -1.0);
+            }
+
+            A.finalize(row);
+        }
+    }
+
+    return A;
+}
+
+real_t relative_residual(const SparseMatrix<real_t>& A, const DynVec<real_t>& x, const DynVec<real_t>& b){
+
+    real_t r_norm = 0.0;
+    real_t b_norm = 0.0;
+
+    for(uint_t r=0; r<A.rows(); ++r){
+
+        real_t sum = b[r];
+        for(auto it = A.cbegin(r); it != A.cend(r); ++it){
+            sum -= it->value()*x[it->index()];
+        }
+
+        r_norm += sum*sum;
+        b_norm += b[r]*b[r];
+    }
+
+    return std::sqrt(r_norm/b_norm);
+}
+
+uint_t cg_iterations(uint_t n, PreconditionerType preconditioner){
+
+    auto A = laplace(n);
+    DynVec<real_t> x(A.rows(), 0.0);
+    DynVec<real_t> b(A.rows(), 1.0);
+
+    KrylovSolverData data;
+    data.n_iterations = 1000;
+    data.tolerance = 1.0e-8;
+    data.solver_type = KrylovSolverType::CG;
+    data.precondioner_type = preconditioner;
+
+    BlazeKrylovSolver solver(data);
+    auto result = solver.solve(A, x, b);
+
+    EXPECT_TRUE(result.converged);
+    EXPECT_LE(relative_residual(A, x, b), 1.0e-7);
+
+    return result.num_iterations;
+}
+
+}
+
+TEST(TestAMGPreconditioner, TestNonSquareMatrix) {
+
+    /***
+       * Test Scenario:    The application builds the preconditioner for a non-square matrix
+       * Expected Output:  std::logic_error is thrown
+     **/
+
+    SparseMatrix<real_t> A(3, 4);
+    AMGPreconditioner amg;
+    ASSERT_THROW(amg.build(A), std::logic_error);
+}
+
+TEST(TestAMGPreconditioner, TestCoarseLevelOnly) {
+
+    /***
+       * Test Scenario:    The application builds the preconditioner for a matrix
+       *                   smaller than the maximum coarse size
+       * Expected Output:  The hierarchy has one level and applying it solves the system
+     **/
+
+    auto A = laplace(6);
+    DynVec<real_t> b(A.rows(), 1.0);
+    DynVec<real_t> x(A.rows(), 0.0);
+
+    AMGPreconditioner amg;
+    amg.build(A);
+    amg.apply(b, x);
+
+    ASSERT_EQ(amg.n_levels(), 1);
+    ASSERT_NEAR(relative_residual(A, x, b), 0.0, 1.0e-12);
+}
+
+TEST(TestAMGPreconditioner, TestHierarchy) {
+
+    /***
+       * Test Scenario:    The application builds the hierarchy of the Laplace matrix
+       * Expected Output:  Every level is at least two times smaller than the finer one,
+       *                   the coarsest level has at most the maximum coarse size rows and
+       *                   the operator complexity is moderate
+     **/
+
+    auto A = laplace(64);
+
+    AMGPreconditioner amg;
+    amg.set_max_coarse_size(50);
+    amg.build(A);
+
+    ASSERT_GT(amg.n_levels(), 2);
+    ASSERT_EQ(amg.size(), A.rows());
+    ASSERT_LE(amg.level_size(amg.n_levels() - 1), 50);
+
+    for(uint_t l=1; l<amg.n_levels(); ++l){
+        ASSERT_LE(2*amg.level_size(l), amg.level_size(l - 1));
+    }
+
+    ASSERT_LT(amg.operator_complexity(), 2.0);
+}
+
+TEST(TestAMGPreconditioner, TestMeshIndependentIterations) {
+
+    /***
+       * Test Scenario:    The application solves the Laplace system with AMG preconditioned CG
+       *                   on meshes refined twice
+       * Expected Output:  The number of iterations stays almost the same whereas
+       *                   Jacobi preconditioned CG needs about twice the iterations per refinement
+     **/
+
+    const auto amg_coarse = cg_iterations(32, PreconditionerType::AMG);
+    const auto amg_fine = cg_iterations(128, PreconditionerType::AMG);
+    const auto jacobi_coarse = cg_iterations(32, PreconditionerType::JACOBI);
+    const auto jacobi_fine = cg_iterations(128, PreconditionerType::JACOBI);
+
+    ASSERT_LE(amg_fine, 25);
+    ASSERT_LE(amg_fine, amg_coarse + 5);
+    ASSERT_GE(jacobi_fine, 3*jacobi_coarse);
+}
+
+TEST(TestAMGPreconditioner, TestNonSymmetricSolver) {
+
+    /***
+       * Test Scenario:    The application solves the Laplace system with AMG preconditioned
+       *                   BiCGSTAB and GMRES
+       * Expected Output:  Both solvers converge
+     **/
+
+    auto A = laplace(64);
+    DynVec<real_t> b(A.rows(), 1.0);
+
+    for(auto solver_type : {KrylovSolverType::BICGSTAB, KrylovSolverType::GMRES}){
+
+        KrylovSolverData data;
+        data.n_iterations = 1000;
+        data.tolerance = 1.0e-8;
+        data.solver_type = solver_type;
+        data.precondioner_type = PreconditionerType::AMG;
+
+        BlazeKrylovSolver solver(data);
+
+        DynVec<real_t> x(A.rows(), 0.0);
+        auto result = solver.solve(A, x, b);
+
+        ASSERT_TRUE(result.converged);
+        ASSERT_LE(relative_residual(A, x, b), 1.0e-7);
+    }
+}
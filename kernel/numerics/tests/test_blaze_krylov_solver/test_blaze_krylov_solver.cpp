@@ -0,0 +1,259 @@
+#include "kernel/base/types.h"
+#include "kernel/numerics/krylov_solvers/blaze_krylov_solver.h"
+#include "kernel/numerics/krylov_solvers/ilu_preconditioner.h"
+#include "kernel/numerics/krylov_solvers/icc_preconditioner.h"
+#include "kernel/numerics/krylov_solvers/krylov_solver_data.h"
+
+#include <cmath>
+#include <vector>
+#include <gtest/gtest.h>
+
+namespace{
+
+using kernel::uint_t;
+using kernel::real_t;
+using kernel::DynVec;
+using kernel::SparseMatrix;
+using kernel::numerics::BlazeKrylovSolver;
+using kernel::numerics::ILUPreconditioner;
+using kernel::numerics::ICCPreconditioner;
+using kernel::numerics::KrylovSolverData;
+using kernel::numerics::KrylovSolverType;
+using kernel::numerics::PreconditionerType;
+
+const uint_t N = 20;
+
+/// \brief The 5-point convection-diffusion matrix on an N x N grid.
+/// With zero convection the matrix is the symmetric Laplacian
+SparseMatrix<real_t> convection_diffusion(uint_t n, real_t convection){
+
+    const uint_t n_rows = n*n;
+    SparseMatrix<real_t> A(n_rows, n_rows);
+    A.reserve(5*n_rows);
+
+    for(uint_t j=0; j<n; ++j){
+        for(uint_t i=0; i<n; ++i){
+
+            const uint_t row = j*n + i;
+
+            if(j > 0){
+                A.append(row, row - n, -1.0);
+            }
+
+            if(i > 0){
+                A.append(row, row - 1, -1.0 - convection);
+            }
+
+            A.append(row, row, 4.0);
+
+            if(i < n - 1){
+                A.append(row, row + 1, -1.0 + convection);
+            }
+
+            if(j < n - 1){
+                A.append(row, row + n, -1.0);
+            }
+
+            A.finalize(row);
+        }
+    }
+
+    return A;
+}
+
+real_t relative_residual(const SparseMatrix<real_t>& A, const DynVec<real_t>& x, const DynVec<real_t>& b){
+
+    real_t r_norm = 0.0;
+    real_t b_norm = 0.0;
+
+    for(uint_t r=0; r<A.rows(); ++r){
+
+        real_t sum = b[r];
+        for(auto it = A.cbegin(r); it != A.cend(r); ++it){
+            sum -= it->value()*x[it->index()];
+        }
+
+        r_norm += sum*sum;
+        b_norm += b[r]*b[r];
+    }
+
+    return std::sqrt(r_norm/b_norm);
+}
+
+KrylovSolverData solver_data(KrylovSolverType solver, PreconditionerType preconditioner, real_t tol=1.0e-10){
+
+    KrylovSolverData data;
+    data.n_iterations = 1000;
+    data.tolerance = tol;
+    data.solver_type = solver;
+    data.precondioner_type = preconditioner;
+    return data;
+}
+
+}
+
+TEST(TestBlazeKrylovSolver, TestUnsupportedPreconditioner) {
+
+    /***
+       * Test Scenario:    The application requests the LU preconditioner
+       * Expected Output:  std::logic_error is thrown
+     **/
+
+    ASSERT_THROW(BlazeKrylovSolver(solver_data(KrylovSolverType::CG, PreconditionerType::LU)), std::logic_error);
+}
+
+TEST(TestBlazeKrylovSolver, TestInvalidSizes) {
+
+    /***
+       * Test Scenario:    The application solves with a rhs of the wrong size
+       * Expected Output:  std::logic_error is thrown
+     **/
+
+    auto A = convection_diffusion(4, 0.0);
+    DynVec<real_t> x(A.rows(), 0.0);
+    DynVec<real_t> b(A.rows() + 1, 1.0);
+
+    BlazeKrylovSolver solver;
+    ASSERT_THROW(solver.solve(A, x, b), std::logic_error);
+}
+
+TEST(TestBlazeKrylovSolver, TestILUExactForTridiagonal) {
+
+    /***
+       * Test Scenario:    The application builds ILU(0) for a tridiagonal matrix
+       * Expected Output:  ILU(0) has no dropped fill-in so applying it solves the system
+     **/
+
+    const uint_t n = 10;
+    SparseMatrix<real_t> A(n, n);
+    A.reserve(3*n);
+
+    for(uint_t r=0; r<n; ++r){
+
+        if(r > 0){
+            A.append(r, r - 1, -1.0);
+        }
+
+        A.append(r, r, 3.0);
+
+        if(r < n - 1){
+            A.append(r, r + 1, -2.0);
+        }
+
+        A.finalize(r);
+    }
+
+    DynVec<real_t> b(n, 1.0);
+    DynVec<real_t> x(n, 0.0);
+
+    ILUPreconditioner ilu;
+    ilu.build(A);
+    ilu.apply(b, x);
+
+    ASSERT_EQ(ilu.size(), n);
+    ASSERT_NEAR(relative_residual(A, x, b), 0.0, 1.0e-12);
+}
+
+TEST(TestBlazeKrylovSolver, TestICCNotPositiveDefinite) {
+
+    /***
+       * Test Scenario:    The application builds IC(0) for a matrix with a negative diagonal
+       * Expected Output:  std::logic_error is thrown
+     **/
+
+    auto A = convection_diffusion(3, 0.0);
+    A.find(4, 4)->value() = -4.0;
+
+    ICCPreconditioner icc;
+    ASSERT_THROW(icc.build(A), std::logic_error);
+}
+
+TEST(TestBlazeKrylovSolver, TestSymmetricSolvers) {
+
+    /***
+       * Test Scenario:    The application solves the Laplacian with every solver
+       *                   and every preconditioner using two threads
+       * Expected Output:  Every combination converges to the requested tolerance
+     **/
+
+    auto A = convection_diffusion(N, 0.0);
+    DynVec<real_t> b(A.rows(), 1.0);
+
+    const std::vector<KrylovSolverType> solvers = {KrylovSolverType::CG, KrylovSolverType::GMRES,
+                                                   KrylovSolverType::BICGSTAB, KrylovSolverType::CGS,
+                                                   KrylovSolverType::TFQMR};
+
+    const std::vector<PreconditionerType> preconditioners = {PreconditionerType::INVALID_PREC, PreconditionerType::JACOBI,
+                                                             PreconditionerType::ILU, PreconditionerType::ICC};
+
+    for(auto solver_type : solvers){
+        for(auto preconditioner_type : preconditioners){
+
+            BlazeKrylovSolver solver(solver_data(solver_type, preconditioner_type));
+            solver.set_n_threads(2);
+
+            DynVec<real_t> x(A.rows(), 0.0);
+            auto result = solver.solve(A, x, b);
+
+            ASSERT_TRUE(result.converged);
+            ASSERT_LE(relative_residual(A, x, b), 1.0e-9);
+        }
+    }
+}
+
+TEST(TestBlazeKrylovSolver, TestNonSymmetricSolvers) {
+
+    /***
+       * Test Scenario:    The application solves a convection-diffusion system
+       *                   with the solvers for non-symmetric matrices
+       * Expected Output:  Every combination converges and ILU(0) needs fewer
+       *                   iterations than Jacobi
+     **/
+
+    auto A = convection_diffusion(N, 0.5);
+    DynVec<real_t> b(A.rows(), 1.0);
+
+    const std::vector<KrylovSolverType> solvers = {KrylovSolverType::GMRES, KrylovSolverType::BICGSTAB,
+                                                   KrylovSolverType::CGS, KrylovSolverType::TFQMR};
+
+    // the recursive residual of TFQMR drifts from the true
+    // residual near 1.0e-9 so a looser tolerance is used
+    for(auto solver_type : solvers){
+
+        BlazeKrylovSolver jacobi_solver(solver_data(solver_type, PreconditionerType::JACOBI, 1.0e-8));
+        BlazeKrylovSolver ilu_solver(solver_data(solver_type, PreconditionerType::ILU, 1.0e-8));
+
+        DynVec<real_t> x_jacobi(A.rows(), 0.0);
+        DynVec<real_t> x_ilu(A.rows(), 0.0);
+
+        auto jacobi_result = jacobi_solver.solve(A, x_jacobi, b);
+        auto ilu_result = ilu_solver.solve(A, x_ilu, b);
+
+        ASSERT_TRUE(jacobi_result.converged);
+        ASSERT_TRUE(ilu_result.converged);
+        ASSERT_LE(relative_residual(A, x_jacobi, b), 1.0e-7);
+        ASSERT_LE(relative_residual(A, x_ilu, b), 1.0e-7);
+        ASSERT_LT(ilu_result.num_iterations, jacobi_result.num_iterations);
+    }
+}
+
+TEST(TestBlazeKrylovSolver, TestGMRESRestart) {
+
+    /***
+       * Test Scenario:    The application solves with GMRES restarted every 5 iterations
+       * Expected Output:  The solver converges after more than 5 iterations
+     **/
+
+    auto A = convection_diffusion(N, 0.5);
+    DynVec<real_t> b(A.rows(), 1.0);
+    DynVec<real_t> x(A.rows(), 0.0);
+
+    BlazeKrylovSolver solver(solver_data(KrylovSolverType::GMRES, PreconditionerType::JACOBI));
+    solver.set_gmres_restart(5);
+
+    auto result = solver.solve(A, x, b);
+
+    ASSERT_TRUE(result.converged);
+    ASSERT_GT(result.num_iterations, 5);
+    ASSERT_LE(relative_residual(A, x, b), 1.0e-9);
+}
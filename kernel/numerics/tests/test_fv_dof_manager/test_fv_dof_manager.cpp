@@ -1,11 +1,23 @@
 #include "kernel/base/types.h"
 #include "kernel/discretization/dof_object.h"
+#include "kernel/discretization/dof_manager.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/quad_mesh_generation.h"
+#include "kernel/geometry/geom_point.h"
 
+#include <algorithm>
+#include <string_view>
 #include <vector>
 #include <gtest/gtest.h>
 
 namespace{
 
+/// \brief Minimal variable to distribute DoFs
+struct Variable
+{
+    std::string_view name()const{return "u";}
+};
+
 }
 
 TEST(TestDoFObject, TestDefaultInitialization) {
@@ -77,6 +89,53 @@ TEST(TestDotProduct, TestReInsertDof) {
     }
 }
 
+TEST(TestFVDoFManager, TestSparsityPattern) {
+
+    /***
+       * Test Scenario:   The application computes the sparsity pattern of a 4x3 quad mesh
+       * Expected Output: Every row holds the sorted dofs of the element and its face
+       *                  neighbors. Corner, edge and interior rows have 3, 4 and 5 entries
+     **/
+
+    using kernel::uint_t;
+    using kernel::GeomPoint;
+    using kernel::numerics::Mesh;
+    using kernel::numerics::FVDoFManager;
+
+    const uint_t nx = 4;
+    const uint_t ny = 3;
+
+    Mesh<2> mesh;
+    kernel::numerics::build_quad_mesh(mesh, nx, ny, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+
+    FVDoFManager<2> dof_manager;
+    dof_manager.distribute_dofs(mesh, Variable());
 
+    std::vector<std::vector<uint_t>> pattern;
+    dof_manager.sparsity_pattern(mesh, pattern);
 
+    ASSERT_EQ(pattern.size(), nx*ny);
 
+    uint_t n_entries = 0;
+
+    for(uint_t r=0; r<pattern.size(); ++r){
+
+        const auto& row = pattern[r];
+
+        ASSERT_TRUE(std::is_sorted(row.begin(), row.end()));
+        ASSERT_TRUE(std::find(row.begin(), row.end(), r) != row.end());
+        ASSERT_GE(row.size(), 3);
+        ASSERT_LE(row.size(), 5);
+
+        // the pattern is symmetric
+        for(auto c : row){
+            ASSERT_TRUE(std::find(pattern[c].begin(), pattern[c].end(), r) != pattern[c].end());
+        }
+
+        n_entries += row.size();
+    }
+
+    // every interior face couples two rows
+    const uint_t n_interior_faces = (nx - 1)*ny + nx*(ny - 1);
+    ASSERT_EQ(n_entries, nx*ny + 2*n_interior_faces);
+}
@@ -0,0 +1,145 @@
+#include "kernel/base/config.h"
+
+#ifdef USE_FVM
+
+#include "kernel/base/types.h"
+#include "kernel/geometry/geom_point.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/quad_mesh_generation.h"
+#include "kernel/numerics/fvm/fv_gauss_grad.h"
+
+#include <memory>
+#include <numeric>
+#include <vector>
+#include <gtest/gtest.h>
+
+namespace{
+
+using kernel::uint_t;
+using kernel::real_t;
+using kernel::GeomPoint;
+using kernel::numerics::Mesh;
+using kernel::numerics::FVGaussGrad;
+
+/// \brief Compare the cached coefficients of every
+/// element with the ones computed from the faces
+void assert_cache_is_exact(const Mesh<2>& mesh, const FVGaussGrad<2>& cached){
+
+    FVGaussGrad<2> direct;
+    std::vector<real_t> expected;
+    std::vector<real_t> values;
+
+    for(uint_t e=0; e<mesh.n_elements(); ++e){
+
+        direct.compute_gradients(*mesh.element(e), expected);
+        cached.compute_gradients(*mesh.element(e), values);
+
+        ASSERT_EQ(values.size(), expected.size());
+
+        for(uint_t f=0; f<values.size(); ++f){
+            ASSERT_DOUBLE_EQ(values[f], expected[f]);
+        }
+    }
+}
+
+}
+
+TEST(TestFVGaussGrad, TestGeometricCache) {
+
+    /***
+       * Test Scenario:    The application builds the geometric cache on a
+       *                   non-uniform quad mesh
+       * Expected Output:  The cached coefficients equal the ones computed from the faces
+     **/
+
+    Mesh<2> mesh;
+    kernel::numerics::build_quad_mesh(mesh, 4, 3, GeomPoint<2>(0.0), GeomPoint<2>({2.0, 1.0}));
+
+    FVGaussGrad<2> grads;
+    ASSERT_FALSE(grads.has_geometric_cache());
+
+    grads.update_geometric_cache(mesh);
+    ASSERT_TRUE(grads.has_geometric_cache());
+
+    assert_cache_is_exact(mesh, grads);
+}
+
+TEST(TestFVGaussGrad, TestCacheInvalidation) {
+
+    /***
+       * Test Scenario:    The application renumbers the elements of the mesh
+       *                   after the geometric cache is built and updates the cache
+       * Expected Output:  The mesh version changes and the updated cache follows the new ids
+     **/
+
+    Mesh<2> mesh;
+    kernel::numerics::build_quad_mesh(mesh, 4, 3, GeomPoint<2>(0.0), GeomPoint<2>({2.0, 1.0}));
+
+    FVGaussGrad<2> grads;
+    grads.update_geometric_cache(mesh);
+
+    const uint_t version = mesh.version();
+
+    // swap a corner and an interior element
+    std::vector<uint_t> order(mesh.n_elements());
+    std::iota(order.begin(), order.end(), 0);
+    std::swap(order[0], order[5]);
+    mesh.topology()->renumber_elements(order);
+
+    ASSERT_NE(mesh.version(), version);
+
+    grads.update_geometric_cache(mesh);
+    assert_cache_is_exact(mesh, grads);
+
+    grads.invalidate_geometric_cache();
+    ASSERT_FALSE(grads.has_geometric_cache());
+}
+
+TEST(TestFVGaussGrad, TestMeshAtReusedAddress) {
+
+    /***
+       * Test Scenario:    The application builds the cache for a mesh, destroys the mesh
+       *                   and updates the cache with a different mesh that may live at the same address
+       * Expected Output:  The new mesh has a different version and the cache follows its geometry
+     **/
+
+    FVGaussGrad<2> grads;
+
+    auto mesh = std::make_unique<Mesh<2>>();
+    kernel::numerics::build_quad_mesh(*mesh, 4, 3, GeomPoint<2>(0.0), GeomPoint<2>({2.0, 1.0}));
+    grads.update_geometric_cache(*mesh);
+
+    const uint_t version = mesh->version();
+    mesh.reset();
+
+    mesh = std::make_unique<Mesh<2>>();
+    kernel::numerics::build_quad_mesh(*mesh, 4, 3, GeomPoint<2>(0.0), GeomPoint<2>({1.0, 3.0}));
+
+    ASSERT_NE(mesh->version(), version);
+
+    grads.update_geometric_cache(*mesh);
+    assert_cache_is_exact(*mesh, grads);
+}
+
+TEST(TestFVGaussGrad, TestElementOfAnotherMesh) {
+
+    /***
+       * Test Scenario:    The application builds the cache for one mesh and computes
+       *                   the gradients of the elements of another mesh with the same ids
+       * Expected Output:  The coefficients are computed from the faces of the other mesh
+     **/
+
+    Mesh<2> mesh;
+    kernel::numerics::build_quad_mesh(mesh, 4, 3, GeomPoint<2>(0.0), GeomPoint<2>({2.0, 1.0}));
+
+    Mesh<2> other;
+    kernel::numerics::build_quad_mesh(other, 4, 3, GeomPoint<2>(0.0), GeomPoint<2>({1.0, 3.0}));
+
+    FVGaussGrad<2> grads;
+    grads.update_geometric_cache(mesh);
+
+    assert_cache_is_exact(other, grads);
+}
+
+#endif
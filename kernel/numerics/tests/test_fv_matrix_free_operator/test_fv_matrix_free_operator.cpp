@@ -0,0 +1,374 @@
+#include "kernel/base/config.h"
+
+#ifdef USE_FVM
+
+#include "kernel/base/types.h"
+#include "kernel/base/kernel_consts.h"
+#include "kernel/geometry/geom_point.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/quad_mesh_generation.h"
+#include "kernel/discretization/dof_manager.h"
+#include "kernel/discretization/compiled_mesh.h"
+#include "kernel/numerics/fvm/fv_matrix_free_operator.h"
+#include "kernel/numerics/fvm/fv_laplace_assemble_policy.h"
+#include "kernel/numerics/fvm/fv_grad_factory.h"
+#include "kernel/numerics/fvm/fv_grad_types.h"
+#include "kernel/numerics/scalar_dirichlet_bc_function.h"
+#include "kernel/numerics/krylov_solvers/matrix_free_krylov_solver.h"
+#include "kernel/numerics/krylov_solvers/krylov_solver_data.h"
+#include "kernel/maths/functions/numeric_scalar_function.h"
+
+#include <cmath>
+#include <random>
+#include <string_view>
+#include <vector>
+#include <gtest/gtest.h>
+
+namespace{
+
+using kernel::uint_t;
+using kernel::real_t;
+using kernel::DynVec;
+using kernel::GeomPoint;
+using kernel::KernelConsts;
+using kernel::numerics::Mesh;
+using kernel::numerics::CompiledMesh;
+using kernel::numerics::FVDoFManager;
+using kernel::numerics::FVMatrixFreeOperator;
+using kernel::numerics::FVMatrixFreeVector;
+using kernel::numerics::FVLaplaceAssemblyPolicy;
+using kernel::numerics::ScalarDirichletBCFunc;
+using kernel::numerics::MatrixFreeKrylovSolver;
+using kernel::numerics::KrylovSolverData;
+using kernel::numerics::KrylovSolverType;
+using kernel::numerics::PreconditionerType;
+
+const uint_t N = 8;
+
+struct Variable
+{
+    std::string_view name()const{return "u";}
+};
+
+class BCFunc: public ScalarDirichletBCFunc<2>
+{
+public:
+
+    BCFunc()
+        :
+          ScalarDirichletBCFunc<2>(0.0, 4)
+    {}
+
+    using ScalarDirichletBCFunc<2>::value;
+    virtual real_t value(uint_t /*i*/, const GeomPoint<2>& /*point*/)const override final{return 0.0;}
+    virtual DynVec<real_t> coeffs()const override final{return DynVec<real_t>();}
+    virtual void update_coeffs(const DynVec<real_t>& /*params*/)override final{}
+};
+
+class RhsVals: public kernel::numerics::NumericScalarFunction<2>
+{
+public:
+
+    virtual real_t value(const GeomPoint<2>& /*point*/)const override final{return 1.0;}
+    virtual real_t value(uint_t /*i*/, const GeomPoint<2>& /*point*/)const override final{return 1.0;}
+    virtual DynVec<real_t> coeffs()const override final{return DynVec<real_t>();}
+    virtual void update_coeffs(const DynVec<real_t>& /*params*/)override final{}
+};
+
+/// \brief Laplace operator with zero Dirichlet
+/// conditions and unit source over an N x N mesh
+struct LaplaceProblem
+{
+    Mesh<2> mesh;
+    FVDoFManager<2> dof_manager;
+    BCFunc bc_func;
+    RhsVals rhs;
+    FVLaplaceAssemblyPolicy<2> policy;
+    FVMatrixFreeOperator<2> op;
+    FVMatrixFreeVector x;
+    FVMatrixFreeVector b;
+
+    LaplaceProblem()
+    {
+        kernel::numerics::build_quad_mesh(mesh, N, N, GeomPoint<2>(0.0), GeomPoint<2>(1.0));
+        dof_manager.distribute_dofs(mesh, Variable());
+
+        policy.build_gradient([](){
+            return kernel::numerics::FVGradFactory<2>::build(kernel::numerics::FVGradType::GAUSS);
+        });
+
+        policy.set_dof_manager(dof_manager);
+        policy.set_boundary_function(bc_func);
+        policy.set_rhs_function(rhs);
+        policy.set_mesh(mesh);
+
+        op.init(dof_manager.n_dofs(), dof_manager.n_dofs(), 6);
+        x.init(dof_manager.n_dofs());
+        b.init(dof_manager.n_dofs());
+    }
+};
+
+/// \brief y = A*x with the FV Laplace matrix computed
+/// directly from the geometry of the mesh
+void reference_apply(const CompiledMesh<2>& mesh, const FVMatrixFreeVector& x, FVMatrixFreeVector& y){
+
+    for(uint_t e=0; e<mesh.n_elements(); ++e){
+
+        const uint_t row = mesh.element_dof(e);
+        real_t sum = 0.0;
+
+        for(uint_t f=0; f<mesh.n_element_faces(e); ++f){
+
+            const uint_t face = mesh.element_face(e, f);
+            const real_t flux = mesh.face_area(face)/mesh.face_owner_neighbor_distance(face);
+            const uint_t neighbor = mesh.element_neighbor(e, f);
+
+            sum += flux*x[row];
+
+            if(neighbor != KernelConsts::invalid_size_type()){
+                sum -= flux*x[mesh.element_dof(neighbor)];
+            }
+        }
+
+        y[row] = sum;
+    }
+}
+
+real_t residual_norm(const FVMatrixFreeOperator<2>& op, const FVMatrixFreeVector& x, const FVMatrixFreeVector& b){
+
+    FVMatrixFreeVector y;
+    y.init(b.size());
+    op.apply(x, y);
+
+    real_t sum = 0.0;
+    for(uint_t i=0; i<b.size(); ++i){
+        sum += (y[i] - b[i])*(y[i] - b[i]);
+    }
+
+    return std::sqrt(sum);
+}
+
+}
+
+TEST(TestFVMatrixFreeOperator, TestNonSquareInit) {
+
+    /***
+       * Test Scenario:    The application initializes the operator with m != n
+       * Expected Output:  std::invalid_argument is thrown
+     **/
+
+    FVMatrixFreeOperator<2> op;
+    ASSERT_THROW(op.init(4, 5), std::invalid_argument);
+}
+
+TEST(TestFVMatrixFreeOperator, TestInvalidFaceEntry) {
+
+    /***
+       * Test Scenario:    The application adds an entry for a face that connects other rows
+       * Expected Output:  std::logic_error is thrown
+     **/
+
+    FVMatrixFreeOperator<2> op;
+    op.init(3, 3);
+    op.add_face_entry(0, 0, 1, -1.0);
+    op.add_face_entry(0, 1, 0, -1.0);
+    ASSERT_THROW(op.add_face_entry(0, 2, 1, -1.0), std::logic_error);
+}
+
+TEST(TestFVMatrixFreeOperator, TestApplyLaplace) {
+
+    /***
+       * Test Scenario:    The application assembles the matrix-free Laplace operator
+       *                   and applies it to a random vector
+       * Expected Output:  A*x and the rhs are the same as those of the assembled matrix
+     **/
+
+    LaplaceProblem problem;
+    problem.policy.assemble(problem.op, problem.x, problem.b);
+
+    ASSERT_TRUE(problem.op.is_assembled());
+    ASSERT_TRUE(problem.op.is_symmetric());
+
+    // 2N(N-1) interior faces
+    ASSERT_EQ(problem.op.n_faces(), 2*N*(N - 1));
+
+    CompiledMesh<2> compiled(problem.mesh, problem.dof_manager);
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<real_t> distribution(-1.0, 1.0);
+
+    FVMatrixFreeVector x;
+    x.init(problem.op.m());
+    for(uint_t i=0; i<x.size(); ++i){
+        x[i] = distribution(generator);
+    }
+
+    FVMatrixFreeVector y;
+    FVMatrixFreeVector y_ref;
+    y.init(problem.op.m());
+    y_ref.init(problem.op.m());
+
+    problem.op.apply(x, y);
+    reference_apply(compiled, x, y_ref);
+
+    for(uint_t i=0; i<y.size(); ++i){
+        ASSERT_NEAR(y[i], y_ref[i], 1.0e-10);
+    }
+
+    for(uint_t e=0; e<compiled.n_elements(); ++e){
+        ASSERT_NEAR(problem.b[compiled.element_dof(e)], compiled.element_volume(e), 1.0e-12);
+    }
+}
+
+TEST(TestFVMatrixFreeOperator, TestCachedTerms) {
+
+    /***
+       * Test Scenario:    The application assembles the operator twice as in two time steps
+       * Expected Output:  The cached terms are reused and only the rhs is assembled again
+     **/
+
+    LaplaceProblem problem;
+    problem.policy.assemble(problem.op, problem.x, problem.b);
+
+    const uint_t n_faces = problem.op.n_faces();
+
+    FVMatrixFreeVector d1;
+    d1.init(problem.op.m());
+    problem.op.diagonal(d1);
+
+    problem.op.zero();
+    problem.b.zero();
+    problem.policy.assemble(problem.op, problem.x, problem.b);
+
+    FVMatrixFreeVector d2;
+    d2.init(problem.op.m());
+    problem.op.diagonal(d2);
+
+    ASSERT_EQ(problem.op.n_faces(), n_faces);
+
+    for(uint_t i=0; i<d1.size(); ++i){
+        ASSERT_DOUBLE_EQ(d1[i], d2[i]);
+        ASSERT_DOUBLE_EQ(problem.b[i], 1.0/(N*N));
+    }
+}
+
+TEST(TestFVMatrixFreeOperator, TestTimeStep) {
+
+    /***
+       * Test Scenario:    The application sets the time step of the operator
+       * Expected Output:  The diagonal is increased by volume/dt
+     **/
+
+    LaplaceProblem problem;
+    problem.policy.assemble(problem.op, problem.x, problem.b);
+
+    FVMatrixFreeVector d;
+    FVMatrixFreeVector d_dt;
+    d.init(problem.op.m());
+    d_dt.init(problem.op.m());
+
+    problem.op.diagonal(d);
+    problem.op.set_time_step(0.5);
+    problem.op.diagonal(d_dt);
+
+    for(uint_t i=0; i<d.size(); ++i){
+        ASSERT_NEAR(d_dt[i] - d[i], problem.op.row_volume(i)/0.5, 1.0e-12);
+    }
+
+    ASSERT_THROW(problem.op.set_time_step(-1.0), std::invalid_argument);
+}
+
+TEST(TestFVMatrixFreeOperator, TestJacobiCG) {
+
+    /***
+       * Test Scenario:    The application solves the Laplace problem with the
+       *                   matrix-free Jacobi preconditioned CG
+       * Expected Output:  The solver converges and the residual is small
+     **/
+
+    LaplaceProblem problem;
+    problem.policy.assemble(problem.op, problem.x, problem.b);
+
+    KrylovSolverData data;
+    data.n_iterations = 1000;
+    data.tolerance = 1.0e-10;
+    data.solver_type = KrylovSolverType::CG;
+    data.precondioner_type = PreconditionerType::JACOBI;
+
+    MatrixFreeKrylovSolver<FVMatrixFreeOperator<2>> solver(data);
+    auto result = solver.solve(problem.op, problem.x, problem.b);
+
+    ASSERT_TRUE(result.converged);
+    ASSERT_LE(residual_norm(problem.op, problem.x, problem.b), 1.0e-9);
+}
+
+TEST(TestFVMatrixFreeOperator, TestBiCGSTAB) {
+
+    /***
+       * Test Scenario:    The application solves a non-symmetric upwind convection-diffusion
+       *                   problem over a chain of cells with the matrix-free BiCGSTAB
+       * Expected Output:  The solver converges and the residual is small
+     **/
+
+    const uint_t n = 50;
+
+    FVMatrixFreeOperator<1> op;
+    op.init(n, n);
+
+    for(uint_t r=0; r<n; ++r){
+        op.set_row_volume(r, 1.0);
+        op.add_diagonal(r, 3.0);
+    }
+
+    // face f connects cells f and f+1
+    for(uint_t f=0; f<n - 1; ++f){
+        op.add_face_entry(f, f, f + 1, -1.0);
+        op.add_face_entry(f, f + 1, f, -2.0);
+    }
+
+    op.fill_completed();
+    ASSERT_FALSE(op.is_symmetric());
+
+    FVMatrixFreeVector x;
+    FVMatrixFreeVector b;
+    x.init(n);
+    b.init(n, 1.0);
+
+    KrylovSolverData data;
+    data.n_iterations = 200;
+    data.tolerance = 1.0e-10;
+    data.solver_type = KrylovSolverType::BICGSTAB;
+    data.precondioner_type = PreconditionerType::JACOBI;
+
+    MatrixFreeKrylovSolver<FVMatrixFreeOperator<1>> solver(data);
+    auto result = solver.solve(op, x, b);
+
+    ASSERT_TRUE(result.converged);
+
+    FVMatrixFreeVector y;
+    y.init(n);
+    op.apply(x, y);
+
+    for(uint_t i=0; i<n; ++i){
+        ASSERT_NEAR(y[i], 1.0, 1.0e-8);
+    }
+}
+
+TEST(TestFVMatrixFreeOperator, TestUnsupportedPreconditioner) {
+
+    /***
+       * Test Scenario:    The application uses the ILU preconditioner with the matrix-free solver
+       * Expected Output:  std::logic_error is thrown
+     **/
+
+    KrylovSolverData data;
+    data.n_iterations = 100;
+    data.tolerance = 1.0e-8;
+    data.solver_type = KrylovSolverType::CG;
+    data.precondioner_type = PreconditionerType::ILU;
+
+    MatrixFreeKrylovSolver<FVMatrixFreeOperator<2>> solver;
+    ASSERT_THROW(solver.set_solver_data(data), std::logic_error);
+}
+
+#endif
@@ -0,0 +1,88 @@
+#include "kernel/base/config.h"
+
+#ifdef USE_FVM
+
+#include "kernel/base/types.h"
+#include "kernel/geometry/geom_point.h"
+#include "kernel/discretization/mesh.h"
+#include "kernel/discretization/element.h"
+#include "kernel/discretization/quad_mesh_generation.h"
+#include "kernel/maths/functions/numeric_vector_function.h"
+#include "kernel/numerics/fvm/fv_ud_interpolation.h"
+
+#include <map>
+#include <vector>
+#include <gtest/gtest.h>
+
+namespace{
+
+using kernel::uint_t;
+using kernel::real_t;
+using kernel::DynVec;
+using kernel::GeomPoint;
+using kernel::numerics::Mesh;
+using kernel::numerics::FVUDInterpolate;
+
+/// \brief A rotating velocity field so that the
+/// faces carry both inflow and outflow
+class RotatingVelocity: public kernel::numerics::NumericVectorFunctionBase<2>
+{
+public:
+
+    virtual output_t value(const GeomPoint<2>& input)const override{
+
+        DynVec<real_t> velocity(2);
+        velocity[0] = 0.5 - input[1];
+        velocity[1] = input[0] - 1.0;
+        return velocity;
+    }
+
+    virtual output_t value(uint_t, const GeomPoint<2>& input)const override{return value(input);}
+    virtual DynVec<real_t> coeffs()const override{return DynVec<real_t>();}
+    virtual void update_coeffs(const DynVec<real_t>&)override{}
+};
+
+}
+
+TEST(TestFVUDInterpolate, TestFlatMatrixContributions) {
+
+    /***
+       * Test Scenario:    The application computes the matrix contributions of every
+       *                   element into a flat buffer and into a map
+       * Expected Output:  The diagonal and the neighbor entries of both agree
+     **/
+
+    Mesh<2> mesh;
+    kernel::numerics::build_quad_mesh(mesh, 4, 3, GeomPoint<2>(0.0), GeomPoint<2>({2.0, 1.0}));
+
+    RotatingVelocity velocity;
+    FVUDInterpolate<2> interpolate(velocity);
+
+    std::vector<real_t> values;
+
+    for(uint_t e=0; e<mesh.n_elements(); ++e){
+
+        const auto& element = *mesh.element(e);
+
+        std::map<uint_t, real_t> entries;
+        interpolate.compute_matrix_contributions(element, entries);
+        interpolate.compute_matrix_contributions(element, values);
+
+        ASSERT_EQ(values.size(), element.n_neighbors() + 1);
+        ASSERT_DOUBLE_EQ(values[0], entries[element.get_id()]);
+
+        for(uint_t n=0; n<element.n_neighbors(); ++n){
+
+            const auto* neighbor = element.neighbor_ptr(n);
+
+            if(neighbor){
+                ASSERT_DOUBLE_EQ(values[n + 1], entries[neighbor->get_id()]);
+            }
+            else{
+                ASSERT_DOUBLE_EQ(values[n + 1], 0.0);
+            }
+        }
+    }
+}
+
+#endif
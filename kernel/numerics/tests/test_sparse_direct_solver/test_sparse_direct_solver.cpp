@@ -0,0 +1,309 @@
+#include "kernel/base/types.h"
+#include "kernel/numerics/direct_solvers/sparse_direct_solver.h"
+#include "kernel/numerics/direct_solvers/amd_ordering.h"
+#include "kernel/numerics/direct_solvers/direct_solver_type.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <gtest/gtest.h>
+
+namespace{
+
+using kernel::uint_t;
+using kernel::real_t;
+using kernel::DynVec;
+using kernel::SparseMatrix;
+using kernel::maths::solvers::SparseDirectSolver;
+using kernel::maths::solvers::SparseDirectSolverConfig;
+using kernel::maths::solvers::DirectSolverType;
+using kernel::maths::solvers::FillReducingOrdering;
+using kernel::maths::solvers::amd_ordering;
+
+/// \brief The 5-point convection-diffusion matrix on an n x n grid.
+/// With zero convection the matrix is the symmetric Laplacian
+SparseMatrix<real_t> convection_diffusion(uint_t n, real_t convection, real_t diagonal=4.0){
+
+    const uint_t n_rows = n*n;
+    SparseMatrix<real_t> A(n_rows, n_rows);
+    A.reserve(5*n_rows);
+
+    for(uint_t j=0; j<n; ++j){
+        for(uint_t i=0; i<n; ++i){
+
+            const uint_t row = j*n + i;
+
+            if(j > 0){
+                A.append(row, row - n, -1.0);
+            }
+
+            if(i > 0){
+                A.append(row, row - 1, -1.0 - convection);
+            }
+
+            A.append(row, row, diagonal);
+
+            if(i < n - 1){
+                A.append(row, row + 1, -1.0 + convection);
+            }
+
+            if(j < n - 1){
+                A.append(row, row + n, -1.0);
+            }
+
+            A.finalize(row);
+        }
+    }
+
+    return A;
+}
+
+real_t relative_residual(const SparseMatrix<real_t>& A, const DynVec<real_t>& x, const DynVec<real_t>& b){
+
+    real_t r_norm = 0.0;
+    real_t b_norm = 0.0;
+
+    for(uint_t r=0; r<A.rows(); ++r){
+
+        real_t sum = b[r];
+        for(auto it = A.cbegin(r); it != A.cend(r); ++it){
+            sum -= it->value()*x[it->index()];
+        }
+
+        r_norm += sum*sum;
+        b_norm += b[r]*b[r];
+    }
+
+    return std::sqrt(r_norm/b_norm);
+}
+
+DynVec<real_t> rhs(uint_t n){
+
+    DynVec<real_t> b(n);
+    for(uint_t i=0; i<n; ++i){
+        b[i] = std::sin(static_cast<real_t>(i + 1));
+    }
+
+    return b;
+}
+
+SparseDirectSolverConfig config(DirectSolverType type,
+                                FillReducingOrdering ordering=FillReducingOrdering::AMD){
+
+    SparseDirectSolverConfig data;
+    data.dstype = type;
+    data.ordering = ordering;
+    return data;
+}
+
+}
+
+TEST(TestSparseDirectSolver, TestUnsupportedType) {
+
+    /***
+       * Test Scenario:    The application requests the SUPER_LU solver
+       * Expected Output:  std::logic_error is thrown
+     **/
+
+    ASSERT_THROW(SparseDirectSolver(config(DirectSolverType::SUPER_LU)), std::logic_error);
+}
+
+TEST(TestSparseDirectSolver, TestNonSquareMatrix) {
+
+    /***
+       * Test Scenario:    The application analyzes a non-square matrix
+       * Expected Output:  std::logic_error is thrown
+     **/
+
+    SparseMatrix<real_t> A(3, 4);
+    SparseDirectSolver solver(config(DirectSolverType::LU));
+    ASSERT_THROW(solver.analyze(A), std::logic_error);
+}
+
+TEST(TestSparseDirectSolver, TestAMDReducesFill) {
+
+    /***
+       * Test Scenario:    The application factorizes the Laplace matrix with
+       *                   the natural and the AMD ordering
+       * Expected Output:  The AMD ordering is a permutation and the Cholesky factor
+       *                   has much less nonzeros than with the natural ordering
+     **/
+
+    auto A = convection_diffusion(40, 0.0);
+
+    SparseDirectSolver natural(config(DirectSolverType::CHOLESKY, FillReducingOrdering::NATURAL));
+    SparseDirectSolver amd(config(DirectSolverType::CHOLESKY));
+
+    natural.factorize(A);
+    amd.factorize(A);
+
+    auto sorted = amd.permutation();
+    std::sort(sorted.begin(), sorted.end());
+
+    for(uint_t i=0; i<sorted.size(); ++i){
+        ASSERT_EQ(sorted[i], i);
+    }
+
+    ASSERT_LT(2*amd.n_factor_nonzeros(), natural.n_factor_nonzeros());
+}
+
+TEST(TestSparseDirectSolver, TestAMDInvalidPattern) {
+
+    /***
+       * Test Scenario:    The application orders a pattern with a column out of range
+       * Expected Output:  std::logic_error is thrown
+     **/
+
+    std::vector<uint_t> row_ptr = {0, 1, 2};
+    std::vector<uint_t> columns = {0, 2};
+    ASSERT_THROW(amd_ordering(2, row_ptr, columns), std::logic_error);
+}
+
+TEST(TestSparseDirectSolver, TestCholesky) {
+
+    /***
+       * Test Scenario:    The application solves the Laplace system with the Cholesky solver
+       * Expected Output:  The residual is at round-off level
+     **/
+
+    auto A = convection_diffusion(30, 0.0);
+    auto b = rhs(A.rows());
+    DynVec<real_t> x(A.rows(), 0.0);
+
+    SparseDirectSolver solver(config(DirectSolverType::CHOLESKY));
+    solver.solve(A, x, b);
+
+    ASSERT_LE(relative_residual(A, x, b), 1.0e-12);
+}
+
+TEST(TestSparseDirectSolver, TestCholeskyNotPositiveDefinite) {
+
+    /***
+       * Test Scenario:    The application factorizes an indefinite matrix with the Cholesky solver
+       * Expected Output:  std::logic_error is thrown
+     **/
+
+    auto A = convection_diffusion(5, 0.0, -4.0);
+    SparseDirectSolver solver(config(DirectSolverType::CHOLESKY));
+    ASSERT_THROW(solver.factorize(A), std::logic_error);
+}
+
+TEST(TestSparseDirectSolver, TestLU) {
+
+    /***
+       * Test Scenario:    The application solves a non-symmetric system with the LU solver
+       *                   for both orderings and two right-hand sides
+       * Expected Output:  The residuals are at round-off level
+     **/
+
+    auto A = convection_diffusion(30, 0.4);
+
+    for(auto ordering : {FillReducingOrdering::NATURAL, FillReducingOrdering::AMD}){
+
+        SparseDirectSolver solver(config(DirectSolverType::LU, ordering));
+        solver.factorize(A);
+
+        auto b = rhs(A.rows());
+        DynVec<real_t> x(A.rows(), 0.0);
+        solver.solve(x, b);
+        ASSERT_LE(relative_residual(A, x, b), 1.0e-12);
+
+        DynVec<real_t> ones(A.rows(), 1.0);
+        solver.solve(x, ones);
+        ASSERT_LE(relative_residual(A, x, ones), 1.0e-12);
+    }
+}
+
+TEST(TestSparseDirectSolver, TestLUPivoting) {
+
+    /***
+       * Test Scenario:    The application solves a system with zeros on the diagonal
+       * Expected Output:  The LU solver pivots and the residual is at round-off level
+     **/
+
+    // a cyclic shift of a diagonally dominant matrix
+    const uint_t n = 50;
+    SparseMatrix<real_t> A(n, n);
+    A.reserve(3*n);
+
+    for(uint_t r=0; r<n; ++r){
+
+        const uint_t c = (r + 1) % n;
+        const uint_t next = (r + 2) % n;
+
+        if(next < c){
+            A.append(r, next, -1.0);
+            A.append(r, c, 4.0);
+        }
+        else{
+            A.append(r, c, 4.0);
+            A.append(r, next, -1.0);
+        }
+
+        A.finalize(r);
+    }
+
+    auto b = rhs(n);
+    DynVec<real_t> x(n, 0.0);
+
+    SparseDirectSolver solver(config(DirectSolverType::LU));
+    solver.solve(A, x, b);
+
+    ASSERT_LE(relative_residual(A, x, b), 1.0e-12);
+}
+
+TEST(TestSparseDirectSolver, TestSingularMatrix) {
+
+    /***
+       * Test Scenario:    The application factorizes a matrix with a zero row
+       * Expected Output:  std::logic_error is thrown
+     **/
+
+    SparseMatrix<real_t> A(3, 3);
+    A.reserve(4);
+    A.append(0, 0, 1.0);
+    A.append(0, 2, 1.0);
+    A.finalize(0);
+    A.finalize(1);
+    A.append(2, 2, 1.0);
+    A.finalize(2);
+
+    SparseDirectSolver solver(config(DirectSolverType::LU));
+    ASSERT_THROW(solver.factorize(A), std::logic_error);
+    ASSERT_FALSE(solver.is_factorized());
+}
+
+TEST(TestSparseDirectSolver, TestReuseAnalysis) {
+
+    /***
+       * Test Scenario:    The application solves a sequence of systems with the same
+       *                   pattern and changing values and then a system with a new pattern
+       * Expected Output:  The analysis and the pivot sequence are reused for the same pattern,
+       *                   a new pattern is analyzed again and all the solutions are accurate
+     **/
+
+    SparseDirectSolver solver(config(DirectSolverType::LU));
+
+    for(uint_t step=0; step<5; ++step){
+
+        auto A = convection_diffusion(20, 0.1*step, 4.0 + step);
+        auto b = rhs(A.rows());
+        DynVec<real_t> x(A.rows(), 0.0);
+
+        solver.solve(A, x, b);
+        ASSERT_LE(relative_residual(A, x, b), 1.0e-12);
+    }
+
+    ASSERT_EQ(solver.n_analyses(), 1);
+    ASSERT_EQ(solver.n_factorizations(), 1);
+    ASSERT_EQ(solver.n_refactorizations(), 4);
+
+    auto A = convection_diffusion(21, 0.1);
+    auto b = rhs(A.rows());
+    DynVec<real_t> x(A.rows(), 0.0);
+
+    solver.solve(A, x, b);
+    ASSERT_LE(relative_residual(A, x, b), 1.0e-12);
+    ASSERT_EQ(solver.n_analyses(), 2);
+    ASSERT_EQ(solver.n_factorizations(), 2);
+}